@@ -0,0 +1,167 @@
+/** @file checkpoint.h
+ * Contains the classes used to write and read simulation checkpoints.
+ *
+ * A checkpoint is a versioned binary file written with streaming I/O. In a
+ * parallel simulation each LP writes its own file. The file starts with a header
+ * (magic number, format version, LP id), followed by the kernel state (clocks and
+ * scheduler), followed by the state of each local component in the order of
+ * component id. Each block of data is preceded by a section tag so that a mismatch
+ * between the checkpointed system and the restoring system is detected early.
+ *
+ * Components that want their state saved override Component::checkpoint() and
+ * Component::restore(). Both functions must read and write exactly the same data
+ * in the same order.
+ */
+
+#ifndef MANIFOLD_KERNEL_CHECKPOINT_H
+#define MANIFOLD_KERNEL_CHECKPOINT_H
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "common-defs.h"
+
+namespace manifold {
+namespace kernel {
+
+//! Magic number at the start of every checkpoint file: "MFCK".
+static const uint32_t CHECKPOINT_MAGIC = 0x4d46434b;
+
+//! Increase this whenever the layout of any checkpointed data changes, kernel or
+//! model, so that older checkpoints are rejected instead of restored as garbage.
+//!   1: initial format.
+//!   2: CaffDRAM Channel saves its data bus state; Rank saves refresh, activation
+//!      window and power-down state.
+//!   3: mcp-cache L2_cache saves the prefetched-line flag of each hash entry.
+static const uint32_t CHECKPOINT_VERSION = 3;
+
+
+//! Returns the name of the checkpoint file of the given LP.
+inline std::string Checkpoint_file_name(const char* prefix, LpId_t lp)
+{
+    std::ostringstream name;
+    name << prefix << ".lp" << lp << ".ckpt";
+    return name.str();
+}
+
+
+//! @class CheckpointOut checkpoint.h
+//! Output stream for a checkpoint file.
+class CheckpointOut {
+public:
+    CheckpointOut(const char* fname, LpId_t lp) : m_out(fname, std::ios::out | std::ios::binary)
+    {
+        if(!m_out) {
+	    std::cerr << "Checkpoint: cannot open " << fname << " for writing." << std::endl;
+	    exit(1);
+	}
+	write(CHECKPOINT_MAGIC);
+	write(CHECKPOINT_VERSION);
+	write(lp);
+    }
+
+    //! Write a value of a type that has no pointers.
+    template<typename T>
+    void write(const T& data)
+    {
+        m_out.write((const char*)&data, sizeof(T));
+    }
+
+    void write_string(const std::string& s)
+    {
+        uint32_t len = s.size();
+	write(len);
+	m_out.write(s.data(), len);
+    }
+
+    //! Mark the beginning of a block of data; the reader must call expect_section()
+    //! with the same tag.
+    void begin_section(const std::string& tag) { write_string(tag); }
+
+    bool good() const { return m_out.good(); }
+
+private:
+    std::ofstream m_out;
+};
+
+
+
+//! @class CheckpointIn checkpoint.h
+//! Input stream for a checkpoint file.
+class CheckpointIn {
+public:
+    CheckpointIn(const char* fname, LpId_t lp) : m_in(fname, std::ios::in | std::ios::binary)
+    {
+        if(!m_in) {
+	    std::cerr << "Checkpoint: cannot open " << fname << " for reading." << std::endl;
+	    exit(1);
+	}
+	uint32_t magic, version;
+	LpId_t file_lp;
+	read(magic);
+	read(version);
+	read(file_lp);
+	if(magic != CHECKPOINT_MAGIC) {
+	    std::cerr << "Checkpoint: " << fname << " is not a checkpoint file." << std::endl;
+	    exit(1);
+	}
+	if(version != CHECKPOINT_VERSION) {
+	    std::cerr << "Checkpoint: " << fname << " has version " << version
+	              << "; version " << CHECKPOINT_VERSION << " expected." << std::endl;
+	    exit(1);
+	}
+	if(file_lp != lp) {
+	    std::cerr << "Checkpoint: " << fname << " was written by LP " << file_lp
+	              << "; it cannot be restored in LP " << lp << "." << std::endl;
+	    exit(1);
+	}
+    }
+
+    template<typename T>
+    void read(T& data)
+    {
+        m_in.read((char*)&data, sizeof(T));
+	if(!m_in) {
+	    std::cerr << "Checkpoint: unexpected end of file." << std::endl;
+	    exit(1);
+	}
+    }
+
+    void read_string(std::string& s)
+    {
+        uint32_t len;
+	read(len);
+	s.resize(len);
+	if(len > 0)
+	    m_in.read(&s[0], len);
+	if(!m_in) {
+	    std::cerr << "Checkpoint: unexpected end of file." << std::endl;
+	    exit(1);
+	}
+    }
+
+    //! Check that the next block of data was written with begin_section(tag).
+    void expect_section(const std::string& tag)
+    {
+        std::string s;
+	read_string(s);
+	if(s != tag) {
+	    std::cerr << "Checkpoint: section " << tag << " expected, but " << s
+	              << " found. The system being restored must be identical to the one checkpointed." << std::endl;
+	    exit(1);
+	}
+    }
+
+private:
+    std::ifstream m_in;
+};
+
+
+} //namespace kernel
+} //namespace manifold
+
+#endif //MANIFOLD_KERNEL_CHECKPOINT_H
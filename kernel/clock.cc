@@ -6,6 +6,7 @@
 
 #include "clock.h"
 #include "manifold.h"
+#include "checkpoint.h"
 
 using namespace std;
 
@@ -151,7 +152,7 @@ void Clock::ProcessThisTick()
           if (ev->time > thisTick) break; // Not time for this event
           assert(ev->time==thisTick);
           // Process the event
-          ev->CallHandler();
+          KERNEL_PROFILE_CALL(ev->GetProfileEntry(), PROF_TICK_EVENT, ev->CallHandler());
           // Delete the event
           delete ev;
           // Remove from queue
@@ -176,7 +177,7 @@ void Clock::ProcessThisTick()
       if (ev->rising && !nextRising) continue;
       assert(ev->time==nextTick);
       // Process the event
-      ev->CallHandler();
+      KERNEL_PROFILE_CALL(ev->GetProfileEntry(), PROF_TICK_EVENT, ev->CallHandler());
 
       #ifdef STATS
       if(nextRising)
@@ -269,6 +270,65 @@ void Clock :: terminate()
 }
 
 
+size_t Clock :: checkpoint(CheckpointOut& out)
+{
+    out.begin_section("clock");
+    out.write(freq);
+    out.write(period);
+    out.write(nextRising);
+    out.write(nextTick);
+    out.write(current_time);
+
+    size_t pending = events.size();
+    for(size_t i=0; i<calendar.size(); i++) {
+        for(size_t j=0; j<calendar[i].size(); j++) {
+	    if(calendar[i][j] != nil)
+	        pending++;
+	}
+    }
+    return pending;
+}
+
+
+void Clock :: restore(CheckpointIn& in)
+{
+    in.expect_section("clock");
+    Ticks_t oldTick = nextTick;
+
+    in.read(freq);
+    in.read(period);
+    in.read(nextRising);
+    in.read(nextTick);
+    in.read(current_time);
+
+    //Events already scheduled were scheduled relative to the old tick count. Remove
+    //them and insert them again so they are relative to the restored tick count.
+    EventVec_t pending;
+    for(size_t i=0; i<calendar.size(); i++) {
+        for(size_t j=0; j<calendar[i].size(); j++) {
+            if(calendar[i][j] != nil)
+                pending.push_back(calendar[i][j]);
+        }
+        calendar[i].clear();
+    }
+    for(EventMap_t::iterator it = events.begin(); it != events.end(); ++it) {
+        TickEventBase* ev = (*it).second;
+        ev->time = ev->time / 2; //the map uses half ticks; the edge is in ev->rising.
+        pending.push_back(ev);
+    }
+    events.clear();
+
+    for(size_t i=0; i<pending.size(); i++) {
+        TickEventBase* ev = pending[i];
+        ev->time -= oldTick;
+        //A rising edge event due now would be missed if the restored clock is at the falling edge.
+        if(ev->time == 0 && ev->rising && !nextRising)
+            ev->time = 1;
+        Insert(ev);
+    }
+}
+
+
 void Clock :: disableAll()
 {
   for(list<tickObjBase*>::iterator iter=tickObjs.begin(); iter!=tickObjs.end(); ++iter) {
@@ -320,7 +380,8 @@ Clock_stat_engine::Clock_stat_engine () : Stat_engine(),
 queued_events("queued events", ""),
 rising_calendar_events("rising calendar events", ""),
 falling_calendar_events("failing calengar events", ""),
-registered_events("registered events", "")
+registered_events("registered events", ""),
+in_warmup(false)
 {
 }
 
@@ -355,10 +416,23 @@ void Clock_stat_engine::clear_stats()
 
 void Clock_stat_engine::start_warmup () 
 {
+    in_warmup = true;
+    warmup_queued_events = queued_events.get_value();
+    warmup_rising_calendar_events = rising_calendar_events.get_value();
+    warmup_falling_calendar_events = falling_calendar_events.get_value();
+    warmup_registered_events = registered_events.get_value();
 }
 
+//! Events processed during the warmup are not counted.
 void Clock_stat_engine::end_warmup () 
 {
+    if(!in_warmup)
+        return;
+    in_warmup = false;
+    queued_events = warmup_queued_events;
+    rising_calendar_events = warmup_rising_calendar_events;
+    falling_calendar_events = warmup_falling_calendar_events;
+    registered_events = warmup_registered_events;
 }
 
 void Clock_stat_engine::save_samples () 
@@ -383,6 +457,23 @@ Time_t DVFSClock::NextTickTime() const
 }
 
 
+size_t DVFSClock :: checkpoint(CheckpointOut& out)
+{
+    size_t pending = Clock :: checkpoint(out);
+    out.write(m_lastChangeTick);
+    out.write(m_lastChangeTime);
+    return pending;
+}
+
+
+void DVFSClock :: restore(CheckpointIn& in)
+{
+    Clock :: restore(in);
+    in.read(m_lastChangeTick);
+    in.read(m_lastChangeTime);
+}
+
+
 void DVFSClock :: set_frequency(double f) throw (MultipleFreqChangeException)
 {
     if(nextTick != m_lastChangeTick) {
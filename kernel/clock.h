@@ -15,6 +15,7 @@
 
 #include "common-defs.h"
 #include "manifold-decl.h"
+#include "profiler.h"
 
 namespace manifold {
 namespace kernel {
@@ -41,6 +42,11 @@ class tickObjBase
  void         Disable() {enabled = false;}
 
  bool         enabled;
+
+#ifdef KERNEL_PROFILE
+ //! Profile entry of the registered object.
+ Profile_entry* prof;
+#endif
 };
 
 
@@ -52,20 +58,29 @@ class tickObj : public tickObjBase {
  public:
 
  //! @arg \c o Object registered with the clock.
- tickObj(OBJ* o) : obj(o), risingFunct(0), fallingFunct(0) {}
+ tickObj(OBJ* o) : obj(o), risingFunct(0), fallingFunct(0)
+  {
+#ifdef KERNEL_PROFILE
+    prof = Profiler::Entry(o, typeid(OBJ));
+#endif
+  }
 
  //! @arg \c o Object registered with the clock.
  //! @arg \c r Pointer to rising function that will be called on tick.
  //! @arg \c f Pointer to falling function that will be called on tick.
  tickObj(OBJ* o, void (OBJ::*r)(void), void (OBJ::*f)(void))
   : obj(o), risingFunct(r), fallingFunct(f)
-  {}
+  {
+#ifdef KERNEL_PROFILE
+    prof = Profiler::Entry(o, typeid(OBJ));
+#endif
+  }
 
  //! Calls rising clk callback function on object registered with clock.
  void CallRisingTick()
   {
     if (risingFunct) {
-      (obj->*risingFunct)();
+      KERNEL_PROFILE_CALL(prof, PROF_RISING, (obj->*risingFunct)());
     }
   }
 
@@ -74,7 +89,7 @@ class tickObj : public tickObjBase {
   {
     if (fallingFunct)
       {
-        (obj->*fallingFunct)();
+        KERNEL_PROFILE_CALL(prof, PROF_FALLING, (obj->*fallingFunct)());
       }
   }
 
@@ -92,6 +107,8 @@ class tickObj : public tickObjBase {
 
 // Stats engine
 class Clock_stat_engine;
+class CheckpointOut;
+class CheckpointIn;
 
 class MultipleFreqChangeException //we do not allow a clock to change frequency multiple times in a single cycle
 { //empty class
@@ -169,9 +186,21 @@ class Clock
 
 
   void print_stats(std::ostream& out);
+  Clock_stat_engine* get_stats() { return stats; }
 
   void terminate();
 
+  //! Saves the tick counter, time and frequency of the clock.
+  //! Pending events cannot be saved, since they hold pointers to handlers
+  //! and their arguments; the number of pending events is returned so the
+  //! caller can warn about it.
+  virtual size_t checkpoint(CheckpointOut&);
+
+  //! Restores the state saved by checkpoint(). Events that have been scheduled
+  //! on this clock before restore() is called are moved forward by the restored
+  //! tick count, i.e., their times are taken as relative to the restored time.
+  virtual void restore(CheckpointIn&);
+
   template <typename O>
   void register_output_predictor(O* obj, void(O::*rising)(void));
 
@@ -319,6 +348,14 @@ class Clock_stat_engine : public Stat_engine
         void start_warmup();
         void end_warmup();
         void save_samples();
+
+    private:
+        //values of the event counters when the warmup started; restored when it ends.
+        bool in_warmup;
+        manifold::kernel::counter_t warmup_queued_events;
+        manifold::kernel::counter_t warmup_rising_calendar_events;
+        manifold::kernel::counter_t warmup_falling_calendar_events;
+        manifold::kernel::counter_t warmup_registered_events;
 };
 
 
@@ -384,6 +421,9 @@ public:
 
     void set_frequency(double f) throw (MultipleFreqChangeException);
 
+    size_t checkpoint(CheckpointOut&);
+    void restore(CheckpointIn&);
+
 private:
     Ticks_t m_lastChangeTick; //tick when frequency last changed.
     Time_t m_lastChangeTime; //time (seconds) of the rising edge when frequency last changed.
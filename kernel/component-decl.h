@@ -23,6 +23,8 @@ namespace manifold {
 namespace kernel {
 
 class Component;
+class CheckpointOut;
+class CheckpointIn;
 
 //! \class ComponentLpMapping component-decl.h
 //!  Stores the logical process id for each
@@ -149,6 +151,13 @@ public:
       return inLinks[inputIndex]->getClock();
   }
 
+  //! Save the state of the component. Components that support checkpointing
+  //! override this and restore(). The default saves nothing.
+  virtual void checkpoint(CheckpointOut&) {}
+
+  //! Restore the state saved by checkpoint().
+  virtual void restore(CheckpointIn&) {}
+
 
   //#################
   // Static functions
@@ -263,6 +272,12 @@ public:
   //!  @arg Component name
   static LpId_t GetComponentLP(const std::string& name);
 
+  //! Call checkpoint() on all components of this LP, in the order of component id.
+  static void CheckpointAll(CheckpointOut&);
+
+  //! Call restore() on all components of this LP, in the order of component id.
+  static void RestoreAll(CheckpointIn&);
+
 
 protected:
   
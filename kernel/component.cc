@@ -3,10 +3,12 @@
 
 #include <vector>
 #include <map>
+#include <sstream>
 
 #include "common-defs.h"
 #include "manifold.h"
 #include "component.h"
+#include "checkpoint.h"
 
 using namespace std;
 
@@ -82,6 +84,30 @@ LpId_t Component::GetComponentLP(const string& name)
   return AllComponents[AllNames[name]].lp;
 }
 
+void Component::CheckpointAll(CheckpointOut& out)
+{
+  for (size_t i = 0; i < AllComponents.size(); i++)
+    {
+      if (AllComponents[i].component == 0) continue; // Not in this LP
+      ostringstream tag;
+      tag << "component " << i;
+      out.begin_section(tag.str());
+      AllComponents[i].component->checkpoint(out);
+    }
+}
+
+void Component::RestoreAll(CheckpointIn& in)
+{
+  for (size_t i = 0; i < AllComponents.size(); i++)
+    {
+      if (AllComponents[i].component == 0) continue; // Not in this LP
+      ostringstream tag;
+      tag << "component " << i;
+      in.expect_section(tag.str());
+      AllComponents[i].component->restore(in);
+    }
+}
+
 #ifndef NO_MPI
 void Component::Recv_remote(int inputIndex, Ticks_t sendTick, Ticks_t recvTick,
                    Time_t sendTime, Time_t recvTime, unsigned char* data, int len)
@@ -89,7 +115,8 @@ void Component::Recv_remote(int inputIndex, Ticks_t sendTick, Ticks_t recvTick,
     LinkInputBase* input = inLinks[inputIndex];
     assert(input != 0);
 
-    input->Recv(recvTick, recvTime, data, len);
+    KERNEL_PROFILE_CALL(Profiler::Entry(this, typeid(*this)), PROF_REMOTE_RECV,
+                        input->Recv(recvTick, recvTime, data, len));
 
     //remote_input_notify(recvTick, input->get_data(), inputIndex);
 
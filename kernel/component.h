@@ -293,7 +293,8 @@ void Component::Recv_remote(int inputIndex, Ticks_t sendTick, Ticks_t recvTick,
     LinkInputBase* input = inLinks[inputIndex];
     assert(input != 0);
 
-    input->Recv(recvTick, recvTime, data);
+    KERNEL_PROFILE_CALL(Profiler::Entry(this, typeid(*this)), PROF_REMOTE_RECV,
+                        input->Recv(recvTick, recvTime, data));
 }
 #endif //#ifndef NO_MPI
 
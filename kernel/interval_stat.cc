@@ -0,0 +1,167 @@
+// Implementation of interval statistics
+
+#include <stdlib.h>
+#include <iostream>
+
+#include "interval_stat.h"
+#include "clock.h"
+#include "component.h"
+
+using namespace std;
+
+namespace manifold {
+namespace kernel {
+
+Interval_stat::Interval_stat(Clock* clk, Ticks_t interval, const char* fname, unsigned buffer_rows) :
+    m_clk(clk), m_interval(interval), m_countdown(interval), m_fname(fname), m_file(0),
+    m_header_written(false), m_buffer_rows(buffer_rows), m_buffer(0), m_rows(0), m_total_rows(0)
+{
+    if(interval == 0 || buffer_rows == 0) {
+        cerr << "Interval_stat: interval and buffer size must be at least 1." << endl;
+	exit(1);
+    }
+    m_file = fopen(fname, "wb");
+    if(m_file == 0) {
+        cerr << "Interval_stat: cannot open " << fname << endl;
+	exit(1);
+    }
+    add_column("tick", ISTAT_UINT64, SRC_FUNC, 0, 0);
+    add_column("time", ISTAT_DOUBLE, SRC_FUNC, 0, 0);
+    Clock::Register(*clk, this, &Interval_stat::tick, (void(Interval_stat::*)(void))0);
+}
+
+
+Interval_stat::~Interval_stat()
+{
+    close();
+    delete[] m_buffer;
+}
+
+
+void Interval_stat::add_counter(const char* name, const uint64_t* counter)
+{
+    add_column(name, ISTAT_UINT64, SRC_UINT64, (void*)counter, 0);
+}
+
+void Interval_stat::add_counter(const char* name, const unsigned* counter)
+{
+    add_column(name, ISTAT_UINT64, SRC_UNSIGNED, (void*)counter, 0);
+}
+
+void Interval_stat::add_counter(const char* name, const double* counter)
+{
+    add_column(name, ISTAT_DOUBLE, SRC_DOUBLE, (void*)counter, 0);
+}
+
+
+void Interval_stat::add_column(const char* name, Interval_stat_type_t type, Source_t src, void* ptr,
+                               uint64_t (*func)(void*))
+{
+    if(m_buffer) {
+        cerr << "Interval_stat: " << name << " is registered after the first snapshot." << endl;
+	exit(1);
+    }
+    Column col;
+    col.name = name;
+    col.type = type;
+    col.src = src;
+    col.ptr = ptr;
+    col.func = func;
+    m_columns.push_back(col);
+}
+
+
+void Interval_stat::tick()
+{
+    if(--m_countdown == 0) {
+        snapshot();
+	m_countdown = m_interval;
+    }
+}
+
+
+void Interval_stat::snapshot()
+{
+    if(m_file == 0) //closed
+        return;
+    if(m_buffer == 0)
+        m_buffer = new uint64_t[m_columns.size() * m_buffer_rows];
+
+    uint64_t* row = m_buffer + m_rows;
+    double now = m_clk->NowTime();
+    row[0] = m_clk->NowTicks();
+    row[m_buffer_rows] = To_bits(now);
+    for(unsigned c=2; c<m_columns.size(); c++) {
+        const Column& col = m_columns[c];
+	uint64_t v;
+	switch(col.src) {
+	    case SRC_UINT64:
+	        v = *(const uint64_t*)col.ptr;
+		break;
+	    case SRC_UNSIGNED:
+	        v = *(const unsigned*)col.ptr;
+		break;
+	    case SRC_DOUBLE:
+		memcpy(&v, col.ptr, sizeof(v));
+		break;
+	    default:
+	        v = col.func(col.ptr);
+		break;
+	}
+	row[c * m_buffer_rows] = v;
+    }
+    m_total_rows++;
+
+    if(++m_rows == m_buffer_rows)
+        flush();
+}
+
+
+void Interval_stat::write_header()
+{
+    uint32_t head[4] = { INTERVAL_STAT_MAGIC, INTERVAL_STAT_VERSION, INTERVAL_STAT_BYTE_ORDER,
+                         (uint32_t)m_columns.size() };
+    uint64_t interval = m_interval;
+    fwrite(head, sizeof(head), 1, m_file);
+    fwrite(&interval, sizeof(interval), 1, m_file);
+    for(unsigned c=0; c<m_columns.size(); c++) {
+        uint32_t desc[2] = { (uint32_t)m_columns[c].type, (uint32_t)m_columns[c].name.size() };
+	fwrite(desc, sizeof(desc), 1, m_file);
+	fwrite(m_columns[c].name.data(), 1, desc[1], m_file);
+    }
+    m_header_written = true;
+}
+
+
+void Interval_stat::flush()
+{
+    if(m_file == 0)
+        return;
+    if(!m_header_written)
+        write_header();
+    if(m_rows > 0) {
+	uint32_t rows = m_rows;
+	fwrite(&rows, sizeof(rows), 1, m_file);
+	for(unsigned c=0; c<m_columns.size(); c++)
+	    fwrite(m_buffer + c * m_buffer_rows, sizeof(uint64_t), m_rows, m_file);
+	m_rows = 0;
+    }
+    if(ferror(m_file)) {
+        cerr << "Interval_stat: error writing " << m_fname << endl;
+	exit(1);
+    }
+}
+
+
+void Interval_stat::close()
+{
+    if(m_file == 0)
+        return;
+    flush();
+    fclose(m_file);
+    m_file = 0;
+}
+
+
+} //namespace kernel
+} //namespace manifold
@@ -0,0 +1,181 @@
+/** @file interval_stat.h
+ * Contains the classes used for interval (time-series) statistics.
+ *
+ * The statistics in stat.h only give totals at the end of the simulation. An
+ * Interval_stat records the values of a set of counters every N ticks of a
+ * clock, so phase behavior and transients can be seen.
+ *
+ * Components register their counters once, before the simulation starts. On each
+ * snapshot, the current values are copied into a preallocated columnar buffer
+ * (one column per counter, plus the tick and the time). When the buffer is full,
+ * each column is written to the file with a single fwrite; nothing is formatted
+ * during the simulation.
+ *
+ * File format (native byte order):
+ *   - header: magic, version, byte order mark, number of columns, interval, then
+ *     for each column its type and name. Column 0 is the tick and column 1 the
+ *     time in seconds, which differ in ratio if the clock frequency changes.
+ *   - blocks: number of rows, then for each column that many 8-byte values.
+ *
+ * Interval_stat_reader reads the file offline; util/istat converts it to CSV.
+ * Counters are recorded as they are, i.e., usually cumulative; the reader can
+ * return the increment over each interval instead.
+ */
+
+#ifndef MANIFOLD_KERNEL_INTERVAL_STAT_H
+#define MANIFOLD_KERNEL_INTERVAL_STAT_H
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <limits>
+#include <stdint.h>
+
+#include "component-decl.h"
+
+namespace manifold {
+namespace kernel {
+
+class Clock;
+template<typename T> class Persistent_stat;
+
+
+static const uint32_t INTERVAL_STAT_MAGIC = 0x5453494d; // "MIST"
+static const uint32_t INTERVAL_STAT_VERSION = 1;
+static const uint32_t INTERVAL_STAT_BYTE_ORDER = 0x01020304;
+
+//! Type of the values of a column in the file.
+enum Interval_stat_type_t { ISTAT_UINT64, ISTAT_INT64, ISTAT_DOUBLE };
+
+
+//! @class Interval_stat interval_stat.h
+//! Takes a snapshot of the registered counters every interval ticks of a clock.
+//! The first snapshot is taken on the interval-th tick after construction.
+class Interval_stat : public Component {
+public:
+    Interval_stat(Clock* clk, Ticks_t interval, const char* fname, unsigned buffer_rows = 1024);
+    ~Interval_stat();
+
+    //! Register a counter. The counter is read at each snapshot, so it must stay
+    //! valid until close() is called. All counters must be registered before the
+    //! first snapshot.
+    void add_counter(const char* name, const uint64_t* counter);
+    void add_counter(const char* name, const unsigned* counter);
+    void add_counter(const char* name, const double* counter);
+
+    //! Register a Persistent_stat; its value is read with get_value().
+    template<typename T>
+    void add_stat(const char* name, Persistent_stat<T>* stat)
+    {
+        add_column(name, Column_type(T()), SRC_FUNC, stat, &Interval_stat::Stat_bits<T>);
+    }
+
+    void tick();
+
+    //! Take a snapshot now, e.g., at the end of the simulation.
+    void snapshot();
+
+    //! Write the buffered rows to the file.
+    void flush();
+
+    //! Flush and close the file. Called by the destructor if not called before.
+    void close();
+
+    unsigned get_num_columns() const { return m_columns.size(); }
+    uint64_t get_num_rows() const { return m_total_rows; }
+
+#ifdef KERNEL_UTEST
+public:
+#else
+private:
+#endif
+    //! How a column is read.
+    enum Source_t { SRC_UINT64, SRC_UNSIGNED, SRC_DOUBLE, SRC_FUNC };
+
+    struct Column {
+        std::string name;
+	Interval_stat_type_t type;
+	Source_t src;
+	void* ptr;
+	uint64_t (*func)(void*); //SRC_FUNC: returns the bits of the value
+    };
+
+    void add_column(const char* name, Interval_stat_type_t type, Source_t src, void* ptr,
+                    uint64_t (*func)(void*));
+    void write_header();
+
+    template<typename T>
+    static Interval_stat_type_t Column_type(T)
+    {
+        return std::numeric_limits<T>::is_signed ? ISTAT_INT64 : ISTAT_UINT64;
+    }
+    static Interval_stat_type_t Column_type(double) { return ISTAT_DOUBLE; }
+    static Interval_stat_type_t Column_type(float) { return ISTAT_DOUBLE; }
+
+    template<typename T>
+    static uint64_t To_bits(T v) { return (uint64_t)(int64_t)v; }
+    static uint64_t To_bits(uint64_t v) { return v; }
+    static uint64_t To_bits(unsigned v) { return v; }
+    static uint64_t To_bits(double v) { uint64_t b; memcpy(&b, &v, sizeof(b)); return b; }
+    static uint64_t To_bits(float v) { return To_bits((double)v); }
+
+    template<typename T>
+    static uint64_t Stat_bits(void* p) { return To_bits(((Persistent_stat<T>*)p)->get_value()); }
+
+    Clock* m_clk;
+    const Ticks_t m_interval;
+    Ticks_t m_countdown; //ticks to the next snapshot
+    std::string m_fname;
+    FILE* m_file;
+    bool m_header_written;
+
+    std::vector<Column> m_columns; //column 0 is the tick, column 1 the time
+    const unsigned m_buffer_rows;
+    uint64_t* m_buffer; //column c, row r is at m_buffer[c * m_buffer_rows + r]
+    unsigned m_rows; //rows in the buffer
+    uint64_t m_total_rows;
+};
+
+
+//! @class Interval_stat_reader interval_stat.h
+//! Reads a file written by Interval_stat, one row at a time.
+class Interval_stat_reader {
+public:
+    Interval_stat_reader(const char* fname);
+    ~Interval_stat_reader();
+
+    unsigned get_num_columns() const { return m_names.size(); }
+    const std::string& get_name(unsigned c) const { return m_names[c]; }
+    Interval_stat_type_t get_type(unsigned c) const { return m_types[c]; }
+    uint64_t get_interval() const { return m_interval; }
+
+    //! Read the next row; the values are converted to double. If delta is true,
+    //! integer counters other than the tick are returned as the increment since
+    //! the previous row. Returns false at the end of the file.
+    bool next(std::vector<double>& row, bool delta = false);
+
+    //! Read the next row as the raw 8-byte values.
+    bool next_raw(std::vector<uint64_t>& row);
+
+private:
+    bool load_block();
+    double value(unsigned c, uint64_t bits) const;
+
+    FILE* m_file;
+    std::vector<std::string> m_names;
+    std::vector<Interval_stat_type_t> m_types;
+    uint64_t m_interval;
+
+    std::vector<uint64_t> m_block; //columnar, as in the writer
+    unsigned m_block_rows;
+    unsigned m_row; //next row in the block
+    std::vector<uint64_t> m_prev; //previous row, for delta
+    bool m_have_prev;
+};
+
+
+} //namespace kernel
+} //namespace manifold
+
+#endif //MANIFOLD_KERNEL_INTERVAL_STAT_H
@@ -0,0 +1,131 @@
+// Offline reader of the files written by Interval_stat. Doesn't depend on the
+// rest of the kernel, so it can be linked into standalone tools.
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+#include "interval_stat.h"
+
+using namespace std;
+
+namespace manifold {
+namespace kernel {
+
+Interval_stat_reader::Interval_stat_reader(const char* fname) :
+    m_file(0), m_interval(0), m_block_rows(0), m_row(0), m_have_prev(false)
+{
+    m_file = fopen(fname, "rb");
+    if(m_file == 0) {
+        cerr << "Interval_stat_reader: cannot open " << fname << endl;
+	exit(1);
+    }
+
+    uint32_t head[4];
+    if(fread(head, sizeof(head), 1, m_file) != 1 || head[0] != INTERVAL_STAT_MAGIC) {
+        cerr << "Interval_stat_reader: " << fname << " is not an interval statistics file." << endl;
+	exit(1);
+    }
+    if(head[2] != INTERVAL_STAT_BYTE_ORDER) {
+        cerr << "Interval_stat_reader: " << fname << " was written on a machine of different byte order." << endl;
+	exit(1);
+    }
+    if(head[1] != INTERVAL_STAT_VERSION) {
+        cerr << "Interval_stat_reader: " << fname << " has unsupported version " << head[1] << endl;
+	exit(1);
+    }
+    bool ok = fread(&m_interval, sizeof(m_interval), 1, m_file) == 1;
+    for(uint32_t c=0; ok && c<head[3]; c++) {
+        uint32_t desc[2];
+	ok = fread(desc, sizeof(desc), 1, m_file) == 1 && desc[0] <= ISTAT_DOUBLE;
+	if(ok) {
+	    string name(desc[1], ' ');
+	    ok = desc[1] == 0 || fread(&name[0], 1, desc[1], m_file) == desc[1];
+	    m_types.push_back((Interval_stat_type_t)desc[0]);
+	    m_names.push_back(name);
+	}
+    }
+    if(!ok) {
+        cerr << "Interval_stat_reader: " << fname << " has a corrupted header." << endl;
+	exit(1);
+    }
+    m_prev.resize(m_names.size());
+}
+
+
+Interval_stat_reader::~Interval_stat_reader()
+{
+    if(m_file)
+        fclose(m_file);
+}
+
+
+bool Interval_stat_reader::load_block()
+{
+    uint32_t rows;
+    if(fread(&rows, sizeof(rows), 1, m_file) != 1)
+        return false;
+    m_block.resize((size_t)rows * m_names.size());
+    if(rows > 0 && fread(&m_block[0], sizeof(uint64_t), m_block.size(), m_file) != m_block.size()) {
+        cerr << "Interval_stat_reader: the file is truncated." << endl;
+	return false;
+    }
+    m_block_rows = rows;
+    m_row = 0;
+    return true;
+}
+
+
+bool Interval_stat_reader::next_raw(vector<uint64_t>& row)
+{
+    while(m_row == m_block_rows) {
+        if(!load_block())
+	    return false;
+    }
+    row.resize(m_names.size());
+    for(unsigned c=0; c<row.size(); c++)
+        row[c] = m_block[c * m_block_rows + m_row];
+    m_row++;
+    return true;
+}
+
+
+double Interval_stat_reader::value(unsigned c, uint64_t bits) const
+{
+    switch(m_types[c]) {
+        case ISTAT_INT64:
+	    return (double)(int64_t)bits;
+        case ISTAT_DOUBLE: {
+	    double d;
+	    memcpy(&d, &bits, sizeof(d));
+	    return d;
+	}
+	default:
+	    return (double)bits;
+    }
+}
+
+
+bool Interval_stat_reader::next(vector<double>& row, bool delta)
+{
+    vector<uint64_t> raw;
+    if(!next_raw(raw))
+        return false;
+
+    row.resize(raw.size());
+    for(unsigned c=0; c<raw.size(); c++) {
+        if(delta && c > 1 && m_types[c] != ISTAT_DOUBLE)
+	    //counters start at 0, so the first row is its own increment; a counter that
+	    //was cleared gives a negative increment
+	    row[c] = (double)(int64_t)(raw[c] - (m_have_prev ? m_prev[c] : 0));
+	else
+	    row[c] = value(c, raw[c]);
+    }
+    m_prev = raw;
+    m_have_prev = true;
+    return true;
+}
+
+
+} //namespace kernel
+} //namespace manifold
@@ -112,6 +112,20 @@ public:
 
     static void print_stats(std::ostream& out);
 
+    //! Save the state of the clocks, the scheduler and all local components in
+    //! the file <prefix>.lp<rank>.ckpt. Pending events are not saved; a warning
+    //! is printed if there are any. Checkpoints should therefore be taken when the
+    //! system is drained, e.g., after functional warmup, and Stop events must be
+    //! scheduled again after restore.
+    //!  @arg Prefix of the checkpoint file name.
+    static void Checkpoint(const char* prefix);
+
+    //! Restore the state saved by Checkpoint(). The system must be built exactly
+    //! as when the checkpoint was taken. Events scheduled before Restore() is
+    //! called are taken as relative to the restored time.
+    //!  @arg Prefix of the checkpoint file name.
+    static void Restore(const char* prefix);
+
   // There are some variations of the required API.
   // First specifies latency in units of clock ticks for the default clock
   // This the common case and should be used most of the time.
@@ -1,6 +1,7 @@
 #ifndef MANIFOLD_KERNEL_MANIFOLD_EVENT_H
 #define MANIFOLD_KERNEL_MANIFOLD_EVENT_H
 #include "common-defs.h"
+#include "profiler.h"
 
 namespace manifold {
 namespace kernel {
@@ -31,6 +32,13 @@ class TickEventBase
   /** Virtual function, all subclasses must implement CallHandler
    */
   virtual void CallHandler() = 0;
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the handler; static handlers are
+   *  profiled per event type.
+   */
+  virtual Profile_entry* GetProfileEntry() { return Profiler::Entry(0, typeid(*this)); }
+#endif
   
  public:
  
@@ -112,6 +120,12 @@ public:
   /** Calls the callback function when the event is processed.
    */
   void CallHandler();
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the object the handler is called on.
+   */
+  Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T, typename OBJ>
@@ -155,6 +169,12 @@ public:
   /** Calls the callback function when the event is processed.
    */
   void CallHandler();
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the object the handler is called on.
+   */
+  Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T, typename OBJ, typename U1, typename T1>
@@ -205,6 +225,12 @@ public:
   /** Calls the callback function when the event is processed.
    */
   void CallHandler();
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the object the handler is called on.
+   */
+  Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T, typename OBJ, 
@@ -262,6 +288,12 @@ public:
    /** Calls the callback function when the event is processed.
     */ 
    void CallHandler();
+
+#ifdef KERNEL_PROFILE
+   /** Returns the profile entry of the object the handler is called on.
+    */
+   Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T,  typename OBJ,
@@ -325,6 +357,12 @@ public:
    /** Calls the callback function when the event is processed.
     */  
    void CallHandler();
+
+#ifdef KERNEL_PROFILE
+   /** Returns the profile entry of the object the handler is called on.
+    */
+   Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T,  typename OBJ,
@@ -584,6 +622,13 @@ class EventBase
   /** Virtual function, all subclasses must implement CallHandler
    */   
   virtual void CallHandler() = 0;
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the handler; static handlers are
+   *  profiled per event type.
+   */
+  virtual Profile_entry* GetProfileEntry() { return Profiler::Entry(0, typeid(*this)); }
+#endif
   
  public:
  
@@ -649,6 +694,12 @@ public:
   /** Calls the callback function when the event is processed.
    */ 
   void CallHandler();
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the object the handler is called on.
+   */
+  Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T, typename OBJ>
@@ -691,6 +742,12 @@ public:
   /** Calls the callback function when the event is processed.
    */ 
   void CallHandler();
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the object the handler is called on.
+   */
+  Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T, typename OBJ, typename U1, typename T1>
@@ -740,6 +797,12 @@ public:
   /** Calls the callback function when the event is processed.
    */ 
   void CallHandler();
+
+#ifdef KERNEL_PROFILE
+  /** Returns the profile entry of the object the handler is called on.
+   */
+  Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T, typename OBJ, 
@@ -796,6 +859,12 @@ public:
    /** Calls the callback function when the event is processed.
     */ 
    void CallHandler();
+
+#ifdef KERNEL_PROFILE
+   /** Returns the profile entry of the object the handler is called on.
+    */
+   Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T,  typename OBJ,
@@ -858,6 +927,12 @@ public:
    /** Calls the callback function when the event is processed.
     */ 
    void CallHandler();
+
+#ifdef KERNEL_PROFILE
+   /** Returns the profile entry of the object the handler is called on.
+    */
+   Profile_entry* GetProfileEntry() { return Profiler::Entry(obj, typeid(OBJ)); }
+#endif
 };
 
 template <typename T,  typename OBJ,
@@ -9,6 +9,7 @@
 #include "messenger.h"
 #endif
 #include "clock.h"
+#include "checkpoint.h"
 
 namespace manifold {
 namespace kernel {
@@ -202,7 +203,13 @@ void Manifold::Init(int argc, char** argv, SchedulerType t,SyncAlg::SyncAlgType_
 //====================================================================
 void Manifold::Finalize()
 {
+#ifdef KERNEL_PROFILE
+  Profiler::Report(std::cout);
+#endif
 #ifndef NO_MPI
+  //merged synchronization report of all LPs; all LPs have the same kind of scheduler
+  if(TheScheduler && TheScheduler->get_sync_stat())
+      TheScheduler->get_sync_stat()->report(std::cout);
   TheMessenger.finalize();
 #endif
 }
@@ -212,7 +219,16 @@ void Manifold::Finalize()
 //====================================================================
 void Manifold::Run()
 {
+#ifndef NO_MPI
+    Sync_stat* sync_stat = TheScheduler->get_sync_stat();
+    if(sync_stat)
+        sync_stat->begin_run();
+#endif
     TheScheduler->Run();
+#ifndef NO_MPI
+    if(sync_stat)
+        sync_stat->end_run();
+#endif
 }
 
 
@@ -307,6 +323,55 @@ void Manifold :: print_stats(std::ostream& out)
 
 
 
+//====================================================================
+//====================================================================
+void Manifold :: Checkpoint(const char* prefix)
+{
+    std::string fname = Checkpoint_file_name(prefix, GetRank());
+    CheckpointOut out(fname.c_str(), GetRank());
+
+    size_t pending = TheScheduler->checkpoint(out);
+    Clock::ClockVec_t& clocks = Clock :: GetClocks();
+    out.write((uint32_t)clocks.size());
+    for(unsigned i=0; i<clocks.size(); i++) {
+        pending += clocks[i]->checkpoint(out);
+    }
+    Component :: CheckpointAll(out);
+
+    if(!out.good()) {
+        std::cerr << "Checkpoint: error writing " << fname << std::endl;
+	exit(1);
+    }
+    if(pending > 0) {
+        std::cerr << "WARNING: " << pending << " pending events are not saved in checkpoint " << fname << std::endl;
+    }
+}
+
+
+//====================================================================
+//====================================================================
+void Manifold :: Restore(const char* prefix)
+{
+    std::string fname = Checkpoint_file_name(prefix, GetRank());
+    CheckpointIn in(fname.c_str(), GetRank());
+
+    TheScheduler->restore(in);
+    Clock::ClockVec_t& clocks = Clock :: GetClocks();
+    uint32_t nclocks;
+    in.read(nclocks);
+    if(nclocks != clocks.size()) {
+        std::cerr << "Checkpoint: " << fname << " has " << nclocks << " clocks, but "
+	          << clocks.size() << " clocks are created." << std::endl;
+	exit(1);
+    }
+    for(unsigned i=0; i<clocks.size(); i++) {
+        clocks[i]->restore(in);
+    }
+    Component :: RestoreAll(in);
+}
+
+
+
 //##############################################################################
 // Below are functions for unit test
 //##############################################################################
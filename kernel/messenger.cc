@@ -16,6 +16,8 @@ namespace kernel {
 //====================================================================
 Messenger :: Messenger()
 {
+    m_numNullSent = 0;
+    m_numNullReceived = 0;
 }
 
 //====================================================================
@@ -523,7 +525,9 @@ void Messenger :: resize_send_buffer(int size)
 void Messenger :: print_stats(std::ostream& out)
 {
     out << "  messages sent: " << m_numSent << endl
-        << "  messages received: " << m_numReceived
+        << "  messages received: " << m_numReceived << endl
+        << "  null messages sent: " << m_numNullSent << endl
+        << "  null messages received: " << m_numNullReceived
 	<< endl;
 }
 
@@ -539,6 +543,7 @@ NullMsg_t* Messenger::RecvPendingNullMsg()
     {
       msg=*it;
       nullMsgQueue.erase(it);
+      m_numNullReceived++;
       return &msg;
     }
   }
@@ -547,7 +552,10 @@ NullMsg_t* Messenger::RecvPendingNullMsg()
   while(MPI::COMM_WORLD.Iprobe(MPI::ANY_SOURCE, TAG_NULLMSG))
   {
     MPI::COMM_WORLD.Recv(&msg, sizeof(msg), MPI::BYTE, MPI::ANY_SOURCE, TAG_NULLMSG);
-    if(msg.txCnt<=m_rxcount[msg.src]) return &msg;
+    if(msg.txCnt<=m_rxcount[msg.src]) {
+      m_numNullReceived++;
+      return &msg;
+    }
     else nullMsgQueue.push_back(msg);
   }
 
@@ -558,6 +566,7 @@ void Messenger::SendNullMsg(NullMsg_t* msg)
 {
   msg->txCnt=m_txcount[msg->dst];
   MPI::COMM_WORLD.Send(msg, sizeof(NullMsg_t), MPI::BYTE, msg->dst, TAG_NULLMSG);
+  m_numNullSent++;
 }
 
 
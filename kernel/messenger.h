@@ -38,6 +38,12 @@ public:
     //! Return the number of messages received.
     int get_numReceived() const { return m_numReceived; }
 
+    //! Return the number of null messages sent.
+    uint64_t get_numNullSent() const { return m_numNullSent; }
+
+    //! Return the number of null messages received.
+    uint64_t get_numNullReceived() const { return m_numNullReceived; }
+
     //! Enter a synchronization barrier.
     void barrier();
 
@@ -109,6 +115,8 @@ private:
     int m_nodeSize;
     int m_numSent; //number of sent messages.
     int m_numReceived; //number of received messages.
+    uint64_t m_numNullSent; //number of sent null messages.
+    uint64_t m_numNullReceived; //number of received null messages.
     Message_s m_msg; // message holder; avoid allocating/deallocating all the time
 
     unsigned char* m_recv_buf;
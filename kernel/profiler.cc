@@ -0,0 +1,195 @@
+// Implementation of the kernel profiler
+
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+
+#include "profiler.h"
+
+using namespace std;
+
+namespace manifold {
+namespace kernel {
+
+vector<Profiler::Slot> Profiler::m_slots;
+vector<Profile_entry*> Profiler::m_entries;
+
+struct Type_less {
+    bool operator()(const type_info* a, const type_info* b) const { return a->before(*b); }
+};
+
+//! Number of objects of each type, to number the instances.
+static map<const type_info*, unsigned, Type_less> Type_count;
+
+
+static inline size_t Slot_hash(const void* obj, const type_info* type)
+{
+    uint64_t h = (uint64_t)(uintptr_t)obj ^ ((uint64_t)(uintptr_t)type << 1);
+    h *= 0x9e3779b97f4a7c15ULL;
+    return (size_t)(h >> 20);
+}
+
+
+Profile_entry* Profiler::Entry(const void* obj, const type_info& type)
+{
+    if(m_slots.empty())
+        Grow();
+
+    size_t mask = m_slots.size() - 1;
+    size_t i = Slot_hash(obj, &type) & mask;
+    while(m_slots[i].entry) {
+        if(m_slots[i].obj == obj && (m_slots[i].type == &type || *m_slots[i].type == type))
+	    return m_slots[i].entry;
+	i = (i + 1) & mask;
+    }
+
+    Profile_entry* e = new Profile_entry;
+    e->obj = obj;
+    e->type = &type;
+    e->instance = Type_count[&type]++;
+    m_entries.push_back(e);
+
+    m_slots[i].obj = obj;
+    m_slots[i].type = &type;
+    m_slots[i].entry = e;
+    if(m_entries.size() * 2 > m_slots.size())
+        Grow();
+    return e;
+}
+
+
+//! Double the hash table and reinsert all entries.
+void Profiler::Grow()
+{
+    size_t size = m_slots.empty() ? 1024 : m_slots.size() * 2;
+    Slot empty = { 0, 0, 0 };
+    m_slots.assign(size, empty);
+    for(unsigned j=0; j<m_entries.size(); j++) {
+        Profile_entry* e = m_entries[j];
+	size_t i = Slot_hash(e->obj, e->type) & (size - 1);
+	while(m_slots[i].entry)
+	    i = (i + 1) & (size - 1);
+	m_slots[i].obj = e->obj;
+	m_slots[i].type = e->type;
+	m_slots[i].entry = e;
+    }
+}
+
+
+void Profiler::Clear()
+{
+    for(unsigned j=0; j<m_entries.size(); j++)
+        delete m_entries[j];
+    m_entries.clear();
+    m_slots.clear();
+    Type_count.clear();
+}
+
+
+uint64_t Profiler::Now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+
+string Profiler::Type_name(const type_info& type)
+{
+#ifdef __GNUC__
+    int status;
+    char* name = abi::__cxa_demangle(type.name(), 0, 0, &status);
+    if(status == 0 && name) {
+        string s(name);
+	free(name);
+	return s;
+    }
+#endif
+    return type.name();
+}
+
+
+static bool Entry_greater(const Profile_entry* a, const Profile_entry* b)
+{
+    return a->total_cycles() > b->total_cycles();
+}
+
+
+static void Print_header(ostream& out)
+{
+    out << setw(14) << "cycles" << setw(7) << "%" << setw(12) << "calls" << setw(10) << "cyc/call"
+        << setw(14) << "rising" << setw(14) << "falling" << setw(14) << "tick_ev"
+        << setw(14) << "timed_ev" << setw(14) << "remote" << "  name" << endl;
+}
+
+
+static void Print_entry(ostream& out, const Profile_entry& e, uint64_t total, const string& name)
+{
+    uint64_t cycles = e.total_cycles();
+    uint64_t calls = 0;
+    for(int k=0; k<PROF_NUM_KINDS; k++)
+        calls += e.calls[k];
+
+    out << setw(14) << cycles
+        << setw(7) << fixed << setprecision(2) << (total ? 100.0 * cycles / total : 0.0)
+        << setw(12) << calls
+        << setw(10) << setprecision(0) << (calls ? (double)cycles / calls : 0.0);
+    for(int k=0; k<PROF_NUM_KINDS; k++)
+        out << setw(14) << e.cycles[k];
+    out << "  " << name << endl;
+    out.unsetf(ios::fixed);
+    out << setprecision(6);
+}
+
+
+void Profiler::Report(ostream& out, unsigned max_objects)
+{
+    uint64_t total = 0;
+    for(unsigned j=0; j<m_entries.size(); j++)
+        total += m_entries[j]->total_cycles();
+
+    //sum the entries of each type
+    map<string, Profile_entry> types;
+    for(unsigned j=0; j<m_entries.size(); j++) {
+        const Profile_entry* e = m_entries[j];
+        Profile_entry& t = types[Type_name(*e->type)];
+	for(int k=0; k<PROF_NUM_KINDS; k++) {
+	    t.calls[k] += e->calls[k];
+	    t.cycles[k] += e->cycles[k];
+	}
+    }
+    vector<pair<uint64_t, string> > by_type;
+    for(map<string, Profile_entry>::iterator it = types.begin(); it != types.end(); ++it)
+        by_type.push_back(make_pair(it->second.total_cycles(), it->first));
+    sort(by_type.rbegin(), by_type.rend());
+
+    out << "Kernel profile: " << total << " cycles in handlers" << endl;
+    out << "  by type:" << endl;
+    Print_header(out);
+    for(unsigned i=0; i<by_type.size(); i++)
+        Print_entry(out, types[by_type[i].second], total, by_type[i].second);
+
+    vector<Profile_entry*> sorted(m_entries);
+    stable_sort(sorted.begin(), sorted.end(), Entry_greater);
+    unsigned n = min((unsigned)sorted.size(), max_objects);
+    out << "  top " << n << " of " << sorted.size() << " objects:" << endl;
+    Print_header(out);
+    for(unsigned i=0; i<n; i++) {
+        const Profile_entry* e = sorted[i];
+	ostringstream name;
+	name << Type_name(*e->type);
+	if(e->obj)
+	    name << "[" << e->instance << "]";
+        Print_entry(out, *e, total, name.str());
+    }
+}
+
+
+} //namespace kernel
+} //namespace manifold
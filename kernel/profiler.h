@@ -0,0 +1,130 @@
+/** @file profiler.h
+ * Contains the kernel profiler.
+ *
+ * When the kernel and the models are compiled with -DKERNEL_PROFILE, the kernel
+ * counts the calls of every handler and the time spent in them, measured with
+ * the cycle counter, for each object and for each object type. The time is split
+ * into rising-edge ticks, falling-edge ticks, clock events, timed events and
+ * receipt of messages from other LPs. A table sorted by time is printed by
+ * Manifold::Finalize().
+ *
+ * Without KERNEL_PROFILE, KERNEL_PROFILE_CALL(entry, kind, call) is just call,
+ * and the entry expression is not evaluated, so there is no overhead.
+ */
+
+#ifndef MANIFOLD_KERNEL_PROFILER_H
+#define MANIFOLD_KERNEL_PROFILER_H
+
+#include <iostream>
+#include <typeinfo>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace manifold {
+namespace kernel {
+
+enum Profile_kind_t {
+    PROF_RISING,       //rising edge tick handlers
+    PROF_FALLING,      //falling edge tick handlers
+    PROF_TICK_EVENT,   //events scheduled on a clock
+    PROF_TIMED_EVENT,  //events scheduled in time
+    PROF_REMOTE_RECV,  //messages received from other LPs
+    PROF_NUM_KINDS
+};
+
+
+//! Calls and cycles of the handlers of one object.
+struct Profile_entry {
+    Profile_entry() : obj(0), type(0), instance(0)
+    {
+        for(int i=0; i<PROF_NUM_KINDS; i++) {
+	    calls[i] = 0;
+	    cycles[i] = 0;
+	}
+    }
+
+    void add(Profile_kind_t kind, uint64_t c) { calls[kind]++; cycles[kind] += c; }
+
+    uint64_t total_cycles() const
+    {
+        uint64_t t = 0;
+	for(int i=0; i<PROF_NUM_KINDS; i++)
+	    t += cycles[i];
+	return t;
+    }
+
+    const void* obj; //0 for static handlers
+    const std::type_info* type;
+    unsigned instance; //objects of the same type are numbered in order of first use
+    uint64_t calls[PROF_NUM_KINDS];
+    uint64_t cycles[PROF_NUM_KINDS];
+};
+
+
+//! @class Profiler profiler.h
+//! Holds the profile entries of all objects in this LP.
+class Profiler {
+public:
+    //! Return the entry of the given object and type, creating it if needed.
+    //! Each handler object should look up its entry once and keep it.
+    static Profile_entry* Entry(const void* obj, const std::type_info& type);
+
+    //! Current value of the cycle counter.
+    static inline uint64_t Now()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+        uint32_t lo, hi;
+	__asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+	return ((uint64_t)hi << 32) | lo;
+#else
+        return Now_ns();
+#endif
+    }
+
+    //! Print the entries per type and the max_objects most expensive objects,
+    //! sorted by cycles.
+    static void Report(std::ostream& out, unsigned max_objects = 20);
+
+    //! Remove all entries; previously returned entries become invalid.
+    static void Clear();
+
+    //! Demangled name of the type.
+    static std::string Type_name(const std::type_info& type);
+
+#ifdef KERNEL_UTEST
+public:
+#else
+private:
+#endif
+    static uint64_t Now_ns();
+    static void Grow();
+
+    struct Slot {
+        const void* obj;
+	const std::type_info* type;
+	Profile_entry* entry;
+    };
+
+    static std::vector<Slot> m_slots; //open-addressing hash table; size is a power of 2
+    static std::vector<Profile_entry*> m_entries; //in order of creation
+};
+
+
+#ifdef KERNEL_PROFILE
+#define KERNEL_PROFILE_CALL(entry, kind, call) \
+    do { \
+        manifold::kernel::Profile_entry* prof_entry__ = (entry); \
+        uint64_t prof_start__ = manifold::kernel::Profiler::Now(); \
+        call; \
+        prof_entry__->add(kind, manifold::kernel::Profiler::Now() - prof_start__); \
+    } while(0)
+#else
+#define KERNEL_PROFILE_CALL(entry, kind, call) call
+#endif
+
+
+} //namespace kernel
+} //namespace manifold
+
+#endif //MANIFOLD_KERNEL_PROFILER_H
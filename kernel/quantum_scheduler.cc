@@ -414,6 +414,10 @@ void Quantum_Scheduler::Run()
 	        break;
         }
         else {
+	    #ifdef STATS
+	    double t_start = Sync_stat::Wall_time();
+	    #endif
+
 	    //enter barrier
 	    enterBarrier();
 
@@ -423,10 +427,21 @@ void Quantum_Scheduler::Run()
 
 	    TheMessenger.barrier();
 
+	    #ifdef STATS
+	    double t_wait = Sync_stat::Wall_time() - t_start;
+	    #endif
+
 	    processPendingMsg();
 
 	    next_barrier += m_init_quantum;
+
+	    #ifdef STATS
+	    t_start = Sync_stat::Wall_time();
+	    #endif
 	    TheMessenger.barrier();
+	    #ifdef STATS
+	    m_syncAlg->get_sync_stat().quantum_barrier(t_wait + Sync_stat::Wall_time() - t_start);
+	    #endif
         }
 
         quantum_handle_incoming_messages();
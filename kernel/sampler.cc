@@ -0,0 +1,244 @@
+// Implementation of the sampler for sampled simulation
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "sampler.h"
+#include "clock.h"
+#include "component.h"
+#include "manifold.h"
+#include "stat_engine.h"
+
+using namespace std;
+
+namespace manifold {
+namespace kernel {
+
+Sampler::Sampler(Clock* clk, const Sampler_settings& settings) :
+    m_settings(settings), m_z(Z_value(settings.confidence)), m_clk(clk),
+    m_phase(START), m_phase_start(0), m_quiet(0), m_sample_start_cycle(0),
+    m_functional_insts(0)
+{
+    if(settings.measure_len == 0) {
+        cerr << "Sampler: the measured interval must be at least 1 instruction." << endl;
+	exit(1);
+    }
+    Clock::Register(*clk, this, &Sampler::tick, (void(Sampler::*)(void))0);
+}
+
+
+void Sampler::add_core(Sampled_core* core)
+{
+    m_cores.push_back(core);
+    m_core_ipc_sum.push_back(0);
+}
+
+void Sampler::add_component(Sampled* comp)
+{
+    m_comps.push_back(comp);
+}
+
+void Sampler::add_stat_engine(Stat_engine* engine)
+{
+    m_engines.push_back(engine);
+}
+
+
+//! Returns the z value of the two-sided confidence interval of the given level.
+double Sampler::Z_value(double confidence)
+{
+    const double levels[] = {0.9, 0.95, 0.99, 0.997};
+    const double z[] = {1.645, 1.960, 2.576, 2.968};
+    for(int i=0; i<4; i++) {
+        if(fabs(confidence - levels[i]) < 1e-6)
+	    return z[i];
+    }
+    cerr << "Sampler: confidence must be 0.9, 0.95, 0.99 or 0.997." << endl;
+    exit(1);
+}
+
+
+uint64_t Sampler::get_retired()
+{
+    uint64_t retired = 0;
+    for(unsigned i=0; i<m_cores.size(); i++)
+        retired += m_cores[i]->get_retired();
+    return retired;
+}
+
+void Sampler::set_functional(bool functional)
+{
+    for(unsigned i=0; i<m_cores.size(); i++)
+        m_cores[i]->set_functional(functional);
+    for(unsigned i=0; i<m_comps.size(); i++)
+        m_comps[i]->set_functional(functional);
+}
+
+bool Sampler::is_drained()
+{
+    for(unsigned i=0; i<m_cores.size(); i++)
+        if(!m_cores[i]->is_drained())
+	    return false;
+    for(unsigned i=0; i<m_comps.size(); i++)
+        if(!m_comps[i]->is_drained())
+	    return false;
+    return true;
+}
+
+void Sampler::start_warmup()
+{
+    for(unsigned i=0; i<m_engines.size(); i++)
+        m_engines[i]->start_warmup();
+}
+
+
+void Sampler::begin_sample()
+{
+    for(unsigned i=0; i<m_engines.size(); i++)
+        m_engines[i]->end_warmup();
+
+    m_sample_start_cycle = m_clk->NowTicks();
+    m_core_start.resize(m_cores.size());
+    for(unsigned i=0; i<m_cores.size(); i++)
+        m_core_start[i] = m_cores[i]->get_retired();
+}
+
+
+void Sampler::end_sample()
+{
+    Ticks_t cycles = m_clk->NowTicks() - m_sample_start_cycle;
+    if(cycles == 0)
+        cycles = 1;
+
+    uint64_t insts = 0;
+    for(unsigned i=0; i<m_cores.size(); i++) {
+        uint64_t core_insts = m_cores[i]->get_retired() - m_core_start[i];
+	m_core_ipc_sum[i] += (double)core_insts / cycles;
+	insts += core_insts;
+    }
+    m_sample_ipc.push_back((double)insts / cycles);
+
+    for(unsigned i=0; i<m_engines.size(); i++) {
+        m_engines[i]->save_samples();
+        m_engines[i]->start_warmup();
+    }
+}
+
+
+void Sampler::tick()
+{
+    uint64_t retired = get_retired();
+
+    switch(m_phase) {
+        case START:
+	    start_warmup();
+	    m_phase_start = retired;
+	    if(m_settings.functional_len > 0) {
+	        set_functional(true);
+		m_phase = FUNCTIONAL;
+	    }
+	    else
+		m_phase = WARMUP;
+	    break;
+
+        case FUNCTIONAL:
+	    if(retired - m_phase_start >= m_settings.functional_len) {
+	        m_functional_insts += retired - m_phase_start;
+	        set_functional(false);
+		m_phase_start = retired;
+		m_phase = WARMUP;
+	    }
+	    break;
+
+        case WARMUP:
+	    if(retired - m_phase_start >= m_settings.warmup_len) {
+	        begin_sample();
+		m_phase_start = retired;
+		m_phase = MEASURE;
+	    }
+	    break;
+
+        case MEASURE:
+	    if(retired - m_phase_start >= m_settings.measure_len) {
+	        end_sample();
+		m_phase_start = retired;
+		if(m_settings.max_samples > 0 && m_sample_ipc.size() >= m_settings.max_samples) {
+		    m_phase = DONE;
+		    Manifold::Terminate();
+		}
+		else if(m_settings.functional_len > 0) {
+		    for(unsigned i=0; i<m_cores.size(); i++)
+			m_cores[i]->set_fetch_stalled(true);
+		    m_quiet = 0;
+		    m_phase = DRAIN;
+		}
+		else
+		    m_phase = WARMUP;
+	    }
+	    break;
+
+        case DRAIN:
+	    if(is_drained())
+	        m_quiet++;
+	    else
+	        m_quiet = 0;
+	    if(m_quiet >= m_settings.drain_quiet) {
+		for(unsigned i=0; i<m_cores.size(); i++)
+		    m_cores[i]->set_fetch_stalled(false);
+	        set_functional(true);
+		m_phase_start = retired;
+		m_phase = FUNCTIONAL;
+	    }
+	    break;
+
+        case DONE:
+	    break;
+    }
+}
+
+
+void Sampler::print_stats(ostream& out)
+{
+    unsigned n = m_sample_ipc.size();
+
+    out << "Sampled simulation:" << endl;
+    out << "  functional= " << m_settings.functional_len << " warmup= " << m_settings.warmup_len
+        << " measure= " << m_settings.measure_len << " (instructions)" << endl;
+    out << "  samples= " << n << endl;
+    out << "  instructions: functional= " << m_functional_insts
+        << " detailed= " << get_retired() - m_functional_insts << endl;
+    if(n == 0)
+        return;
+
+    double sum = 0;
+    for(unsigned i=0; i<n; i++)
+        sum += m_sample_ipc[i];
+    double mean = sum / n;
+
+    double sq_sum = 0;
+    for(unsigned i=0; i<n; i++)
+        sq_sum += (m_sample_ipc[i] - mean) * (m_sample_ipc[i] - mean);
+    double stddev = (n > 1) ? sqrt(sq_sum / (n - 1)) : 0;
+    double cov = (mean > 0) ? stddev / mean : 0;
+    double half_width = m_z * stddev / sqrt((double)n);
+
+    out << "  IPC: mean= " << mean << " stddev= " << stddev << " CoV= " << cov << endl;
+    out << "  " << m_settings.confidence * 100 << "% confidence interval: " << mean << " +- " << half_width;
+    if(mean > 0)
+        out << " (+- " << half_width / mean * 100 << "%)";
+    out << endl;
+    if(n > 1) {
+	//number of samples for a confidence interval of +-3% of the mean
+	double needed = (m_z * cov / 0.03) * (m_z * cov / 0.03);
+	out << "  samples needed for +-3%: " << (unsigned long)ceil(needed) << endl;
+    }
+    else
+        out << "  at least 2 samples are needed for a confidence interval." << endl;
+
+    for(unsigned i=0; i<m_cores.size(); i++)
+        out << "  core " << i << " mean IPC= " << m_core_ipc_sum[i] / n << endl;
+}
+
+
+} //namespace kernel
+} //namespace manifold
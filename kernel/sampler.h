@@ -0,0 +1,138 @@
+/** @file sampler.h
+ * Contains the classes used for sampled simulation.
+ *
+ * In sampled simulation (as in SMARTS), the simulated program is divided into
+ * three kinds of intervals that repeat until the end of the simulation:
+ *   - functional: instructions are retired without timing; caches are warmed up
+ *     functionally;
+ *   - warmup: detailed simulation whose statistics are discarded, to warm up the
+ *     state that is not warmed functionally (pipelines, queues, MSHRs, network);
+ *   - measure: detailed simulation; each measured interval is one sample.
+ * The lengths of the intervals are given in instructions (uops) retired by all
+ * cores together. Before switching back to functional mode after a sample, the
+ * cores stop fetching and the system is drained.
+ *
+ * The sampler reports the IPC of each sample and the confidence interval of the
+ * mean IPC. All sampled components must be in the same LP as the sampler.
+ */
+
+#ifndef MANIFOLD_KERNEL_SAMPLER_H
+#define MANIFOLD_KERNEL_SAMPLER_H
+
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+#include "component-decl.h"
+
+namespace manifold {
+namespace kernel {
+
+class Clock;
+class Stat_engine;
+
+
+//! @class Sampled sampler.h
+//! Interface of components whose mode is switched by the sampler.
+class Sampled {
+public:
+    virtual ~Sampled() {}
+
+    //! Switch between functional (true) and detailed (false) mode.
+    virtual void set_functional(bool functional) = 0;
+
+    //! Return true if the component has no outstanding requests, so that it can be
+    //! switched to functional mode.
+    virtual bool is_drained() = 0;
+};
+
+
+//! @class Sampled_core sampler.h
+//! Interface of processor cores. The sampler counts the retired instructions of
+//! the cores to decide when to switch modes.
+class Sampled_core : public Sampled {
+public:
+    //! Return the number of instructions retired so far, in either mode.
+    virtual uint64_t get_retired() = 0;
+
+    //! A stalled core doesn't fetch new instructions; used to drain the system.
+    virtual void set_fetch_stalled(bool stalled) = 0;
+};
+
+
+struct Sampler_settings {
+    Sampler_settings() : functional_len(0), warmup_len(0), measure_len(0), max_samples(0),
+                         confidence(0.95), drain_quiet(100) {}
+
+    uint64_t functional_len; //instructions retired functionally between samples
+    uint64_t warmup_len; //instructions retired in detailed warmup before each sample
+    uint64_t measure_len; //instructions in each sample
+    unsigned max_samples; //simulation is terminated after this many samples; 0 for no limit
+    double confidence; //confidence level of the reported interval: 0.9, 0.95, 0.99 or 0.997
+    unsigned drain_quiet; //number of cycles all components must stay drained before the
+                          //switch to functional mode; covers messages still in the network
+};
+
+
+//! @class Sampler sampler.h
+//! The sampler is ticked by a clock and switches the registered components
+//! between functional and detailed mode.
+//!
+//! Registered stat engines are told to start warming up at the beginning of the
+//! simulation and after each sample, and to end warming up at the beginning of
+//! each sample, so their statistics only cover the samples.
+class Sampler : public Component {
+public:
+    Sampler(Clock* clk, const Sampler_settings& settings);
+
+    void add_core(Sampled_core* core);
+    void add_component(Sampled* comp);
+    void add_stat_engine(Stat_engine* engine);
+
+    void tick();
+
+    void print_stats(std::ostream& out);
+
+    enum Phase_t { START, FUNCTIONAL, WARMUP, MEASURE, DRAIN, DONE };
+
+    Phase_t get_phase() const { return m_phase; }
+    unsigned get_num_samples() const { return m_sample_ipc.size(); }
+
+#ifdef KERNEL_UTEST
+public:
+#else
+private:
+#endif
+    uint64_t get_retired();
+    void set_functional(bool functional);
+    bool is_drained();
+    void start_warmup();
+    void begin_sample();
+    void end_sample();
+    static double Z_value(double confidence);
+
+    const Sampler_settings m_settings;
+    const double m_z;
+    Clock* m_clk;
+
+    std::vector<Sampled_core*> m_cores;
+    std::vector<Sampled*> m_comps;
+    std::vector<Stat_engine*> m_engines;
+
+    Phase_t m_phase;
+    uint64_t m_phase_start; //retired instructions at the start of the phase
+    unsigned m_quiet; //cycles the system has been drained
+
+    Ticks_t m_sample_start_cycle;
+    std::vector<uint64_t> m_core_start; //retired instructions of each core at the start of the sample
+
+    std::vector<double> m_sample_ipc; //aggregate IPC of each sample
+    std::vector<double> m_core_ipc_sum; //sum of per-core IPC over the samples
+    uint64_t m_functional_insts;
+};
+
+
+} //namespace kernel
+} //namespace manifold
+
+#endif //MANIFOLD_KERNEL_SAMPLER_H
@@ -9,6 +9,7 @@
 
 #include "clock.h"
 #include "component.h"
+#include "checkpoint.h"
 
 using namespace std;
 
@@ -37,6 +38,7 @@ void Scheduler :: print_stats(ostream& out)
     #ifndef NO_MPI
     if(m_syncAlg) { //in parallel sim, if NP==1, then sequential algo is used and m_syncAlg is 0
 	m_syncAlg->PrintStats(out);
+	m_syncAlg->get_sync_stat().print(out);
 	TheMessenger.print_stats(out);
     }
     #endif
@@ -50,6 +52,30 @@ void Scheduler :: terminate()
 }
 
 
+size_t Scheduler :: checkpoint(CheckpointOut& out)
+{
+    out.begin_section("scheduler");
+    out.write(m_simTime);
+    return m_timedEvents.size();
+}
+
+
+void Scheduler :: restore(CheckpointIn& in)
+{
+    in.expect_section("scheduler");
+    Time_t oldTime = m_simTime;
+    in.read(m_simTime);
+
+    //Re-insert events already scheduled so their times are relative to the restored time.
+    EventSet_t pending;
+    pending.swap(m_timedEvents);
+    for(EventSet_t::iterator it = pending.begin(); it != pending.end(); ++it) {
+        (*it)->time += m_simTime - oldTime;
+	m_timedEvents.insert(*it);
+    }
+}
+
+
 #ifndef NO_MPI
 void Scheduler::UpdateLookahead(Time_t delay, LpId_t src, LpId_t dst)
 {
@@ -258,7 +284,7 @@ void Seq_TimedScheduler::Run()
             assert(nextEvent->time>=m_simTime);
             m_simTime = nextEvent->time;
             // Call the event handler
-            nextEvent->CallHandler();
+            KERNEL_PROFILE_CALL(nextEvent->GetProfileEntry(), PROF_TIMED_EVENT, nextEvent->CallHandler());
             // Remove the event from the pending list
             m_timedEvents.erase(m_timedEvents.begin());
             // And delete the event
@@ -292,7 +318,7 @@ void Seq_MixedScheduler::Run()
             }
             else { // Process timed event
                 // Call the event handler
-                nextEvent->CallHandler();
+                KERNEL_PROFILE_CALL(nextEvent->GetProfileEntry(), PROF_TIMED_EVENT, nextEvent->CallHandler());
                 // Remove the event from the pending list
                 m_timedEvents.erase(m_timedEvents.begin());
                 // And delete the event
@@ -400,7 +426,7 @@ void LBTS_TimedScheduler::Run()
             assert(nextEvent->time>=m_simTime);
             m_simTime = nextEvent->time;
             // Call the event handler
-            nextEvent->CallHandler();
+            KERNEL_PROFILE_CALL(nextEvent->GetProfileEntry(), PROF_TIMED_EVENT, nextEvent->CallHandler());
             // Remove the event from the pending list
             m_timedEvents.erase(m_timedEvents.begin());
             // And delete the event
@@ -461,7 +487,7 @@ void LBTS_MixedScheduler::Run()
             }
             else { // Process timed event
                 // Call the event handler
-                nextEvent->CallHandler();
+                KERNEL_PROFILE_CALL(nextEvent->GetProfileEntry(), PROF_TIMED_EVENT, nextEvent->CallHandler());
                 // Remove the event from the pending list
                 m_timedEvents.erase(m_timedEvents.begin());
                 // And delete the event
@@ -769,7 +795,7 @@ void CMB_TimedScheduler::Run()
             assert(nextEvent->time>=m_simTime);
             m_simTime = nextEvent->time;
             // Call the event handler
-            nextEvent->CallHandler();
+            KERNEL_PROFILE_CALL(nextEvent->GetProfileEntry(), PROF_TIMED_EVENT, nextEvent->CallHandler());
             // Remove the event from the pending list
             m_timedEvents.erase(m_timedEvents.begin());
             // And delete the event
@@ -831,7 +857,7 @@ void CMB_MixedScheduler::Run()
             }
             else { // Process timed event
                 // Call the event handler
-                nextEvent->CallHandler();
+                KERNEL_PROFILE_CALL(nextEvent->GetProfileEntry(), PROF_TIMED_EVENT, nextEvent->CallHandler());
                 // Remove the event from the pending list
                 m_timedEvents.erase(m_timedEvents.begin());
                 // And delete the event
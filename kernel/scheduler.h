@@ -27,6 +27,8 @@ public:
 };
 
 class Scheduler_stat_engine;
+class CheckpointOut;
+class CheckpointIn;
 
 
 
@@ -49,6 +51,13 @@ public:
 
     virtual void print_stats(std::ostream&);
 
+    //! Saves the simulation time. Returns the number of pending timed events, which
+    //! cannot be saved.
+    size_t checkpoint(CheckpointOut&);
+    //! Restores the simulation time. Timed events scheduled before restore() is
+    //! called are moved forward by the restored time.
+    void restore(CheckpointIn&);
+
 #ifdef KERNEL_UTEST
     void unhalt() { m_halted = false; m_simTime = 0; }
 #endif
@@ -58,6 +67,8 @@ public:
     std::vector<LpId_t>& get_predecessors() { return predecessors; }
     std::vector<LpId_t>& get_successors() { return successors; }
     const SyncAlg* const get_syncAlg() { return m_syncAlg; }
+    //! Return the synchronization statistics; 0 in sequential simulation.
+    Sync_stat* get_sync_stat() { return m_syncAlg ? &m_syncAlg->get_sync_stat() : 0; }
 #endif
     /**
      * Takes the given LP and appends it to the list of neighbors that might send message
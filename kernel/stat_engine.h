@@ -17,9 +17,13 @@ public:
     virtual void print_stats(ostream & out) = 0;
     virtual void clear_stats() = 0;
 
-    //TODO remove start_warmup, end_warmup, save_samples, commit_stats, rollback_stats?
+    //! The following are called by the Sampler in sampled simulation (see sampler.h).
+    //! Statistics collected between start_warmup() and end_warmup() are not part of
+    //! the samples and should be discarded. start_warmup() is called at the start of
+    //! the simulation and after each sample; end_warmup() at the start of each sample.
     virtual void start_warmup() = 0;
     virtual void end_warmup() = 0;
+    //! Called at the end of each sample, before start_warmup().
     virtual void save_samples() = 0;
 };
 
@@ -0,0 +1,252 @@
+// Implementation of the synchronization statistics
+
+#ifndef NO_MPI
+
+#include <time.h>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "sync_stat.h"
+#include "messenger.h"
+
+using namespace std;
+
+namespace manifold {
+namespace kernel {
+
+
+Sync_stat::Sync_stat()
+{
+    m_n_lps = TheMessenger.get_node_size();
+
+    m_run_start = 0;
+    m_run_time = 0;
+
+    m_blocked = false;
+    m_block_start = 0;
+    m_blocked_time = 0;
+    m_blocked_episodes = 0;
+    m_unsafe_checks = 0;
+    m_sum_lag = 0;
+    m_max_lag = 0;
+
+    m_eit_hist.resize(m_n_lps * ADVANCE_BINS, 0);
+    m_eot_hist.resize(m_n_lps * ADVANCE_BINS, 0);
+
+    m_lbts_rounds = 0;
+    m_lbts_granted = 0;
+    m_lbts_time = 0;
+
+    m_barriers = 0;
+    m_barrier_time = 0;
+}
+
+
+double Sync_stat::Wall_time()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+void Sync_stat::begin_run()
+{
+    m_run_start = Wall_time();
+}
+
+
+void Sync_stat::end_run()
+{
+    //an LP that exits the main loop while blocked was blocked until now
+    if(m_blocked) {
+        m_blocked_time += Wall_time() - m_block_start;
+	m_blocked = false;
+    }
+    m_run_time += Wall_time() - m_run_start;
+}
+
+
+static const char* const Bin_names[Sync_stat::ADVANCE_BINS] = {
+    "<1/8", "<1/4", "<1/2", "<1", "<2", "<4", "<8", ">=8"
+};
+
+
+static void Print_hist_header(ostream& out, const char* label)
+{
+    out << setw(12) << label;
+    for(int b=0; b<Sync_stat::ADVANCE_BINS; b++)
+        out << setw(10) << Bin_names[b];
+    out << endl;
+}
+
+
+//! Print one row of a histogram; rows without samples are skipped.
+static void Print_hist_row(ostream& out, int src, int dst, const double* hist)
+{
+    double n = 0;
+    for(int b=0; b<Sync_stat::ADVANCE_BINS; b++)
+        n += hist[b];
+    if(n == 0)
+        return;
+    ostringstream channel;
+    channel << src << "->" << dst;
+    out << setw(12) << channel.str();
+    for(int b=0; b<Sync_stat::ADVANCE_BINS; b++)
+        out << setw(10) << (uint64_t)hist[b];
+    out << endl;
+}
+
+
+void Sync_stat::print(ostream& out)
+{
+    out << "  sync run time (s): " << m_run_time << endl
+        << "  sync blocked time (s): " << m_blocked_time << endl
+        << "  sync blocked episodes: " << m_blocked_episodes << endl
+        << "  sync unsafe checks: " << m_unsafe_checks << endl
+        << "  sync avg lag: " << (m_blocked_episodes ? m_sum_lag / m_blocked_episodes : 0)
+        << "  max lag: " << m_max_lag << endl;
+    if(m_lbts_rounds)
+        out << "  LBTS rounds: " << m_lbts_rounds << "  granted: " << m_lbts_granted
+	    << "  time (s): " << m_lbts_time << endl;
+    if(m_barriers)
+        out << "  quantum barriers: " << m_barriers << "  time (s): " << m_barrier_time << endl;
+}
+
+
+void Sync_stat::pack(vector<double>& v)
+{
+    v.assign(F_NUM_FIELDS + 2 * m_n_lps * ADVANCE_BINS, 0);
+    v[F_RUN_TIME] = m_run_time;
+    v[F_BLOCKED_TIME] = m_blocked_time;
+    v[F_BLOCKED_EPISODES] = m_blocked_episodes;
+    v[F_UNSAFE_CHECKS] = m_unsafe_checks;
+    v[F_SUM_LAG] = m_sum_lag;
+    v[F_MAX_LAG] = m_max_lag;
+    v[F_REAL_SENT] = TheMessenger.get_numSent();
+    v[F_REAL_RECV] = TheMessenger.get_numReceived();
+    v[F_NULL_SENT] = TheMessenger.get_numNullSent();
+    v[F_NULL_RECV] = TheMessenger.get_numNullReceived();
+    v[F_LBTS_ROUNDS] = m_lbts_rounds;
+    v[F_LBTS_GRANTED] = m_lbts_granted;
+    v[F_LBTS_TIME] = m_lbts_time;
+    v[F_BARRIERS] = m_barriers;
+    v[F_BARRIER_TIME] = m_barrier_time;
+    for(unsigned i=0; i<m_eit_hist.size(); i++) {
+        v[F_NUM_FIELDS + i] = m_eit_hist[i];
+        v[F_NUM_FIELDS + m_eit_hist.size() + i] = m_eot_hist[i];
+    }
+}
+
+
+void Sync_stat::Merge(const vector<double>& all, int n_lps, vector<double>& total)
+{
+    const unsigned size = all.size() / n_lps;
+    total.assign(F_NUM_FIELDS, 0);
+    for(int lp=0; lp<n_lps; lp++) {
+        const double* f = &all[lp * size];
+	for(int i=0; i<F_NUM_FIELDS; i++) {
+	    if(i == F_MAX_LAG)
+	        total[i] = max(total[i], f[i]);
+	    else
+	        total[i] += f[i];
+	}
+    }
+}
+
+
+void Sync_stat::report(ostream& out)
+{
+    vector<double> mine;
+    pack(mine);
+    const unsigned size = mine.size();
+    vector<double> all(size * m_n_lps);
+    TheMessenger.allGather((char*)&mine[0], size * sizeof(double), (char*)&all[0]);
+
+    if(TheMessenger.get_node_id() == 0)
+        Print_report(out, all, m_n_lps);
+}
+
+
+void Sync_stat::Print_report(ostream& out, const vector<double>& all, int n_lps)
+{
+    const unsigned size = all.size() / n_lps;
+
+    out << "=== Synchronization (all LPs) ===" << endl;
+    out << setw(5) << "LP" << setw(10) << "run(s)" << setw(11) << "blocked(s)" << setw(9) << "blocked%"
+        << setw(10) << "episodes" << setw(12) << "avg_lag" << setw(12) << "real_tx" << setw(12) << "real_rx"
+        << setw(12) << "null_tx" << setw(12) << "null_rx" << setw(10) << "null/real"
+        << setw(10) << "lbts" << setw(10) << "lbts_ok" << setw(10) << "lbts(s)"
+        << setw(10) << "barriers" << setw(11) << "barrier(s)" << endl;
+
+    vector<double> total;
+    Merge(all, n_lps, total);
+    double max_blocked = 0;
+    double min_blocked = 0;
+    for(int lp=0; lp<=n_lps; lp++) {
+        const double* f;
+	if(lp < n_lps) {
+	    f = &all[lp * size];
+	    double blocked = f[F_RUN_TIME] > 0 ? f[F_BLOCKED_TIME] / f[F_RUN_TIME] : 0;
+	    if(lp == 0 || blocked > max_blocked)
+	        max_blocked = blocked;
+	    if(lp == 0 || blocked < min_blocked)
+	        min_blocked = blocked;
+	    out << setw(5) << lp;
+	}
+	else {
+	    f = &total[0];
+	    out << setw(5) << "all";
+	}
+	out << fixed << setprecision(3)
+	    << setw(10) << f[F_RUN_TIME] << setw(11) << f[F_BLOCKED_TIME]
+	    << setw(8) << setprecision(1) << (f[F_RUN_TIME] > 0 ? 100 * f[F_BLOCKED_TIME] / f[F_RUN_TIME] : 0) << "%"
+	    << setw(10) << setprecision(0) << f[F_BLOCKED_EPISODES];
+	out.unsetf(ios::fixed);
+	out << setprecision(4)
+	    << setw(12) << (f[F_BLOCKED_EPISODES] ? f[F_SUM_LAG] / f[F_BLOCKED_EPISODES] : 0)
+	    << fixed << setprecision(0)
+	    << setw(12) << f[F_REAL_SENT] << setw(12) << f[F_REAL_RECV]
+	    << setw(12) << f[F_NULL_SENT] << setw(12) << f[F_NULL_RECV]
+	    << setw(10) << setprecision(2) << (f[F_REAL_SENT] > 0 ? f[F_NULL_SENT] / f[F_REAL_SENT] : 0)
+	    << setw(10) << setprecision(0) << f[F_LBTS_ROUNDS] << setw(10) << f[F_LBTS_GRANTED]
+	    << setw(10) << setprecision(3) << f[F_LBTS_TIME]
+	    << setw(10) << setprecision(0) << f[F_BARRIERS]
+	    << setw(11) << setprecision(3) << f[F_BARRIER_TIME] << endl;
+	out.unsetf(ios::fixed);
+	out << setprecision(6);
+    }
+    out << "  blocked%: min " << 100 * min_blocked << "  max " << 100 * max_blocked
+        << "  max lag: " << total[F_MAX_LAG] << endl;
+
+    //histograms; the EIT of channel src->dst is recorded by dst, the EOT by src
+    const unsigned hist_size = n_lps * ADVANCE_BINS;
+    bool any = false;
+    for(int lp=0; lp<n_lps && !any; lp++)
+        for(unsigned i=0; i<2 * hist_size; i++)
+	    if(all[lp * size + F_NUM_FIELDS + i] != 0) {
+	        any = true;
+		break;
+	    }
+    if(!any)
+        return;
+
+    out << "  EIT advance per null message received, in units of lookahead:" << endl;
+    Print_hist_header(out, "src->dst");
+    for(int dst=0; dst<n_lps; dst++)
+        for(int src=0; src<n_lps; src++)
+	    Print_hist_row(out, src, dst, &all[dst * size + F_NUM_FIELDS + src * ADVANCE_BINS]);
+
+    out << "  EOT advance per null message sent, in units of lookahead:" << endl;
+    Print_hist_header(out, "src->dst");
+    for(int src=0; src<n_lps; src++)
+        for(int dst=0; dst<n_lps; dst++)
+	    Print_hist_row(out, src, dst, &all[src * size + F_NUM_FIELDS + hist_size + dst * ADVANCE_BINS]);
+}
+
+
+} //namespace kernel
+} //namespace manifold
+
+#endif //!NO_MPI
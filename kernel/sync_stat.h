@@ -0,0 +1,177 @@
+/** @file sync_stat.h
+ * Contains the synchronization statistics of parallel simulation.
+ *
+ * Each LP records how long it waits for the synchronization algorithm and why:
+ *   - blocked time: wall-clock time from the first failed safe-to-process check
+ *     until the next successful one, and the number of such episodes. The lag is
+ *     how far the requested time is ahead of the safe horizon when it blocks.
+ *   - CMB: histograms of how far each null message advances the EIT of its input
+ *     channel and the EOT of its output channel, in units of the lookahead of the
+ *     channel. Many small advances mean the lookahead is too small.
+ *   - LBTS: all-gather rounds, the rounds that granted a new time, and the time
+ *     spent in them.
+ *   - Quantum: number of barriers and the time spent in them.
+ * The message counts come from the Messenger.
+ *
+ * Sync_stat::report() gathers the statistics of all LPs and prints a merged
+ * table on LP 0; it is called by Manifold::Finalize(). The statistics are only
+ * collected when the kernel is compiled with -DSTATS.
+ */
+
+#ifndef MANIFOLD_KERNEL_SYNC_STAT_H
+#define MANIFOLD_KERNEL_SYNC_STAT_H
+
+#ifndef NO_MPI
+
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+#include "common-defs.h"
+
+namespace manifold {
+namespace kernel {
+
+
+//! @class Sync_stat sync_stat.h
+//! Synchronization statistics of one LP.
+class Sync_stat {
+public:
+    //! Advance histogram bins, in units of lookahead: <1/8, <1/4, <1/2, <1, <2, <4, <8, >=8.
+    enum { ADVANCE_BINS = 8 };
+
+    Sync_stat();
+
+    //! Wall-clock time in seconds.
+    static double Wall_time();
+
+    //! Called by Manifold::Run() around the main loop.
+    void begin_run();
+    void end_run();
+
+    //! Record the result of a safe-to-process check.
+    //! @param horizon The time up to which it is safe to process events.
+    void safe_check(bool safe, Time_t requestTime, Time_t horizon)
+    {
+        if(safe) {
+	    if(m_blocked) {
+		m_blocked_time += Wall_time() - m_block_start;
+		m_blocked = false;
+	    }
+	}
+	else {
+	    m_unsafe_checks++;
+	    if(!m_blocked) {
+		m_blocked = true;
+		m_block_start = Wall_time();
+		m_blocked_episodes++;
+		Time_t lag = requestTime - horizon;
+		m_sum_lag += lag;
+		if(lag > m_max_lag)
+		    m_max_lag = lag;
+	    }
+	}
+    }
+
+    //! A null message from src advanced the EIT of the channel src->this LP.
+    void eit_advance(LpId_t src, Time_t advance, Time_t lookahead)
+    {
+        m_eit_hist[src * ADVANCE_BINS + Advance_bin(advance, lookahead)]++;
+    }
+
+    //! A null message to dst advanced the EOT of the channel this LP->dst.
+    void eot_advance(LpId_t dst, Time_t advance, Time_t lookahead)
+    {
+        m_eot_hist[dst * ADVANCE_BINS + Advance_bin(advance, lookahead)]++;
+    }
+
+    //! An LBTS all-gather round that took wait seconds.
+    void lbts_round(bool granted, double wait)
+    {
+        m_lbts_rounds++;
+	if(granted)
+	    m_lbts_granted++;
+	m_lbts_time += wait;
+    }
+
+    //! A quantum barrier that took wait seconds; it also counts as blocked time.
+    void quantum_barrier(double wait)
+    {
+        m_barriers++;
+	m_barrier_time += wait;
+	m_blocked_time += wait;
+    }
+
+    //! Print the statistics of this LP.
+    void print(std::ostream& out);
+
+    //! Gather the statistics of all LPs and print them on LP 0. This is a
+    //! collective call; all LPs must call it.
+    void report(std::ostream& out);
+
+#ifdef KERNEL_UTEST
+public:
+#else
+private:
+#endif
+    //! Fields of the summary gathered by report().
+    enum {
+	F_RUN_TIME, F_BLOCKED_TIME, F_BLOCKED_EPISODES, F_UNSAFE_CHECKS, F_SUM_LAG, F_MAX_LAG,
+	F_REAL_SENT, F_REAL_RECV, F_NULL_SENT, F_NULL_RECV,
+	F_LBTS_ROUNDS, F_LBTS_GRANTED, F_LBTS_TIME, F_BARRIERS, F_BARRIER_TIME,
+	F_NUM_FIELDS
+    };
+
+    static int Advance_bin(Time_t advance, Time_t lookahead)
+    {
+        if(lookahead <= 0)
+	    return ADVANCE_BINS - 1;
+	double r = advance / lookahead * 8; //bin 0 is < 1/8
+	int bin = 0;
+	while(bin < ADVANCE_BINS - 1 && r >= 1) {
+	    r /= 2;
+	    bin++;
+	}
+	return bin;
+    }
+
+    void pack(std::vector<double>& v);
+
+    //! Merge the packed fields of n_lps LPs, as gathered by report(), into total:
+    //! the maximum for F_MAX_LAG and the sum for the other fields.
+    static void Merge(const std::vector<double>& all, int n_lps, std::vector<double>& total);
+
+    //! Print the table of report() from the packed statistics of n_lps LPs.
+    static void Print_report(std::ostream& out, const std::vector<double>& all, int n_lps);
+
+    int m_n_lps;
+
+    double m_run_start;
+    double m_run_time;
+
+    bool m_blocked;
+    double m_block_start;
+    double m_blocked_time;
+    uint64_t m_blocked_episodes;
+    uint64_t m_unsafe_checks;
+    double m_sum_lag;
+    double m_max_lag;
+
+    std::vector<uint64_t> m_eit_hist; //ADVANCE_BINS per source LP
+    std::vector<uint64_t> m_eot_hist; //ADVANCE_BINS per destination LP
+
+    uint64_t m_lbts_rounds;
+    uint64_t m_lbts_granted;
+    double m_lbts_time;
+
+    uint64_t m_barriers;
+    double m_barrier_time;
+};
+
+
+} //namespace kernel
+} //namespace manifold
+
+#endif //!NO_MPI
+
+#endif //MANIFOLD_KERNEL_SYNC_STAT_H
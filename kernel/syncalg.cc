@@ -82,6 +82,9 @@ bool LbtsSyncAlg::isSafeToProcess(double requestTime)
     static LBTS_Msg* LBTS = new LBTS_Msg[TheMessenger.get_node_size()];
 
     if(requestTime <= m_grantedTime) {
+	#ifdef STATS
+	m_sync_stat.safe_check(true, requestTime, m_grantedTime);
+	#endif
         return true;
     }
     else {
@@ -92,10 +95,15 @@ bool LbtsSyncAlg::isSafeToProcess(double requestTime)
 	int nodeId = TheMessenger.get_node_id();
 	LBTS[nodeId] = lbts_msg;
 
+	#ifdef STATS
+	double t_start = Sync_stat::Wall_time();
+	#endif
+
 	TheMessenger.allGather((char*)&(lbts_msg), sizeof(LBTS_Msg), (char*)LBTS);
 
 	#ifdef STATS
 	m_stats_LBTS_sync++;
+	double t_wait = Sync_stat::Wall_time() - t_start;
 	#endif
 	//MPI_Allgather(&(LBTS[nodeId]), sizeof(LBTS_MSG), MPI_BYTE, LBTS, 
 	//		sizeof(LBTS_MSG), MPI_BYTE, MPI_COMM_WORLD);
@@ -117,12 +125,21 @@ bool LbtsSyncAlg::isSafeToProcess(double requestTime)
 	    if(m_grantedTime < 0) //for termination detection.
 		Manifold :: get_scheduler()->Stop(); //set halted to true
 
+	    #ifdef STATS
+	    m_sync_stat.lbts_round(true, t_wait);
+	    m_sync_stat.safe_check(requestTime <= m_grantedTime, requestTime, m_grantedTime);
+	    #endif
+
 	    if(requestTime <= m_grantedTime)
 		return true;
 	    else
 		return false;
         }
 	else {
+	    #ifdef STATS
+	    m_sync_stat.lbts_round(false, t_wait);
+	    m_sync_stat.safe_check(false, requestTime, m_grantedTime);
+	    #endif
 	    return false;
 	}
     }
@@ -264,7 +281,12 @@ bool CmbSyncAlg::isSafeToProcess(double requestTime)
 	    // We have a message, let's update:
 	    Time_t oldEit=m_eits[msg->src];
 	    Time_t newEit=msg->t;
-	    if(newEit>oldEit) m_eits[msg->src]=newEit;
+	    if(newEit>oldEit) {
+		m_eits[msg->src]=newEit;
+		#ifdef STATS
+		m_sync_stat.eit_advance(msg->src, newEit - oldEit, m_lookahead->GetLookahead(msg->src, Manifold::GetRank()));
+		#endif
+	    }
 
 	    #ifdef FORECAST_NULL
 	    Ticks_t oldforecast = m_in_forecast_ticks[msg->src];
@@ -304,6 +326,10 @@ bool CmbSyncAlg::isSafeToProcess(double requestTime)
         null_msg_wasted_recv_time += t_diff;
 #endif
 
+#ifdef STATS
+    m_sync_stat.safe_check(requestTime <= m_min_null, requestTime, m_min_null);
+#endif
+
 //cout << "min null= " << m_min_null << " reqTime= " << requestTime << endl;
   if(requestTime <= m_min_null) {
 //cout << "min null= " << m_min_null << " reqTime= " << requestTime << "  safe" << endl;
@@ -349,6 +375,7 @@ void CmbSyncAlg :: send_null_msgs()
 	    delete msg;
 	    #ifdef STATS
 	    stats_sent_null[(*succs)[i]]++;
+	    m_sync_stat.eot_advance((*succs)[i], newEot - oldEot, m_lookahead->GetLookahead(src, (*succs)[i]));
 	    #endif
 	}
     }
@@ -393,6 +420,7 @@ void CmbSyncAlg :: send_null_msgs(Clock* clk)
 	    delete msg;
 	    #ifdef STATS
 	    stats_sent_null[(*succs)[i]]++;
+	    m_sync_stat.eot_advance((*succs)[i], newEot - oldEot, m_lookahead->GetLookahead(src, (*succs)[i]));
 	    #endif
 	}
     }
@@ -427,7 +455,12 @@ bool CmbSyncAlg :: isSafeToProcess_send_null(double requestTime)
 	    // We have a message, let's update:
 	    Time_t oldEit=m_eits[msg->src];
 	    Time_t newEit=msg->t;
-	    if(newEit>oldEit) m_eits[msg->src]=newEit;
+	    if(newEit>oldEit) {
+		m_eits[msg->src]=newEit;
+		#ifdef STATS
+		m_sync_stat.eit_advance(msg->src, newEit - oldEit, m_lookahead->GetLookahead(msg->src, Manifold::GetRank()));
+		#endif
+	    }
 	    #ifdef STATS
 	    stats_received_null[msg->src]++;
 	    #endif
@@ -463,10 +496,15 @@ bool CmbSyncAlg :: isSafeToProcess_send_null(double requestTime)
 	    delete msg;
 	    #ifdef STATS
 	    stats_sent_null[(*succs)[i]]++;
+	    m_sync_stat.eot_advance((*succs)[i], newEot - oldEot, m_lookahead->GetLookahead(src, (*succs)[i]));
 	    #endif
 	}
     }
 
+    #ifdef STATS
+    m_sync_stat.safe_check(result, requestTime, earliestLocalEvent);
+    #endif
+
     // Last, but not least: return result:
     return result;
 
@@ -497,7 +535,12 @@ bool CmbSyncAlg :: isSafeToProcess_send_null_if_safe(double requestTime)
 	    // We have a message, let's update:
 	    Time_t oldEit=m_eits[msg->src];
 	    Time_t newEit=msg->t;
-	    if(newEit>oldEit) m_eits[msg->src]=newEit;
+	    if(newEit>oldEit) {
+		m_eits[msg->src]=newEit;
+		#ifdef STATS
+		m_sync_stat.eit_advance(msg->src, newEit - oldEit, m_lookahead->GetLookahead(msg->src, Manifold::GetRank()));
+		#endif
+	    }
 	    #ifdef STATS
 	    stats_received_null[msg->src]++;
 	    #endif
@@ -512,6 +555,9 @@ bool CmbSyncAlg :: isSafeToProcess_send_null_if_safe(double requestTime)
 	if(itTime<earliestLocalEvent) {
 	    earliestLocalEvent=itTime;
 	    result=false; // We now already know that the min EIT is smaller than requestTime
+	    #ifdef STATS
+	    m_sync_stat.safe_check(result, requestTime, earliestLocalEvent);
+	    #endif
 	    return result;
 	}
     }
@@ -534,10 +580,15 @@ bool CmbSyncAlg :: isSafeToProcess_send_null_if_safe(double requestTime)
 	    delete msg;
 	    #ifdef STATS
 	    stats_sent_null[(*succs)[i]]++;
+	    m_sync_stat.eot_advance((*succs)[i], newEot - oldEot, m_lookahead->GetLookahead(src, (*succs)[i]));
 	    #endif
 	}
     }
 
+    #ifdef STATS
+    m_sync_stat.safe_check(result, requestTime, earliestLocalEvent);
+    #endif
+
     // Last, but not least: return result:
     return result;
 
@@ -639,6 +690,7 @@ void CmbSyncAlg :: send_null_msgs_with_forecast(Clock* clk)
             delete msg;
 	    #ifdef STATS
 	    stats_sent_null[succ]++;
+	    m_sync_stat.eot_advance(succ, min_newEot - oldEot, m_lookahead->GetLookahead(src, succ));
 	    #endif
 	    useful_update = true;
 #if 0
@@ -729,6 +781,7 @@ void CmbSyncAlg :: send_null_msgs_with_forecast_2(Clock* clk)
 	    delete msg;
 	    #ifdef STATS
 	    stats_sent_null[succ]++;
+	    m_sync_stat.eot_advance(succ, newEot - oldEot, m_lookahead->GetLookahead(src, succ));
 	    #endif
 //cout.precision(10);
 //cout << "NULLNULL " << " send null " << newEot << " to " << succ << " @ " << Manifold::NowTicks() << " rising= " << Clock::Master().nextRising << "  min_null= " << m_min_null << " forecast= " << forecast << "  in fcast= " << m_in_forecast_ticks[succ] << endl;
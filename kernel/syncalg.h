@@ -13,6 +13,7 @@
 #include "common-defs.h"
 #include "messenger.h"
 #include "lookahead.h"
+#include "sync_stat.h"
 
 namespace manifold {
 namespace kernel {
@@ -61,9 +62,12 @@ public:
         m_lookahead->print();
     }
 
+    Sync_stat& get_sync_stat() { return m_sync_stat; }
+
 protected:
     Lookahead* m_lookahead;
     OutputTS* m_outputTS;
+    Sync_stat m_sync_stat;
 };
 
 
@@ -0,0 +1,145 @@
+/**
+This program tests Manifold::Checkpoint() and Manifold::Restore().
+*/
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "manifold.h"
+#include "component.h"
+#include "checkpoint.h"
+
+using namespace std;
+using namespace manifold::kernel;
+
+
+//####################################################################
+// helper classes
+//####################################################################
+
+//! A component that counts rising edges and saves the count in checkpoints.
+class MyCounter : public Component {
+public:
+    MyCounter() : m_count(0), m_handlerTick(0) {}
+
+    void rising() { m_count++; }
+    void falling() {}
+
+    void handler() { m_handlerTick = Manifold::NowTicks(); }
+
+    void checkpoint(CheckpointOut& out) { out.write(m_count); }
+    void restore(CheckpointIn& in) { in.read(m_count); }
+
+    int m_count;
+    Ticks_t m_handlerTick;
+};
+
+
+
+//####################################################################
+//####################################################################
+class CheckpointTest : public CppUnit::TestFixture {
+    private:
+	static Clock MasterClock;  //clock has to be global or static.
+	enum { MASTER_CLOCK_HZ = 10 };
+
+    public:
+	//! Run a simulation for some ticks and take a checkpoint; reset the kernel, restore
+	//! the checkpoint and verify the clock and the component are back in the saved state.
+	void test_restore_0()
+	{
+	    Manifold::Reset(Manifold::TICKED);
+	    CompId_t cid = Component::Create<MyCounter>(0);
+	    MyCounter* counter = Component::GetComponent<MyCounter>(cid);
+	    Clock::Register(MasterClock, counter, &MyCounter::rising, &MyCounter::falling);
+
+	    const Ticks_t STOP = 20 + random() % 100;
+	    Manifold::StopAt(STOP);
+	    Manifold::Run();
+
+	    const Ticks_t savedTick = MasterClock.NowTicks();
+	    const int savedCount = counter->m_count;
+	    Manifold::Checkpoint("CheckpointTest");
+
+	    Manifold::Reset(Manifold::TICKED);
+	    counter->m_count = 0;
+	    CPPUNIT_ASSERT_EQUAL(Ticks_t(0), MasterClock.NowTicks());
+
+	    Manifold::Restore("CheckpointTest");
+
+	    CPPUNIT_ASSERT_EQUAL(savedTick, MasterClock.NowTicks());
+	    CPPUNIT_ASSERT_EQUAL(savedCount, counter->m_count);
+
+	    Clock::Unregister(MasterClock, counter);
+	    remove(Checkpoint_file_name("CheckpointTest", 0).c_str());
+	}
+
+	//! Events scheduled before Restore() are relative to the restored time.
+	void test_restore_1()
+	{
+	    Manifold::Reset(Manifold::TICKED);
+	    CompId_t cid = Component::Create<MyCounter>(0);
+	    MyCounter* counter = Component::GetComponent<MyCounter>(cid);
+	    counter->set_clock(MasterClock);
+
+	    const Ticks_t STOP = 20 + random() % 100;
+	    Manifold::StopAt(STOP);
+	    Manifold::Run();
+
+	    const Ticks_t savedTick = MasterClock.NowTicks();
+	    Manifold::Checkpoint("CheckpointTest");
+
+	    Manifold::Reset(Manifold::TICKED);
+
+	    const Ticks_t WHEN = 5;
+	    Manifold::Schedule(WHEN, &MyCounter::handler, counter);
+	    Manifold::StopAt(WHEN + 1);
+
+	    Manifold::Restore("CheckpointTest");
+	    Manifold::Run();
+
+	    //the restored clock may be at the falling edge; then a rising edge event is
+	    //moved forward by at most one tick.
+	    CPPUNIT_ASSERT(counter->m_handlerTick >= savedTick + WHEN);
+	    CPPUNIT_ASSERT(counter->m_handlerTick <= savedTick + WHEN + 1);
+
+	    remove(Checkpoint_file_name("CheckpointTest", 0).c_str());
+	}
+
+
+
+        /**
+	 * Build a test suite.
+	 */
+	static CppUnit::Test* suite()
+	{
+	    CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("CheckpointTest");
+
+	    mySuite->addTest(new CppUnit::TestCaller<CheckpointTest>("test_restore_0", &CheckpointTest::test_restore_0));
+	    mySuite->addTest(new CppUnit::TestCaller<CheckpointTest>("test_restore_1", &CheckpointTest::test_restore_1));
+
+	    return mySuite;
+	}
+};
+
+
+Clock CheckpointTest::MasterClock(MASTER_CLOCK_HZ);
+
+
+int main()
+{
+    srandom(time(0));
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( CheckpointTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+}
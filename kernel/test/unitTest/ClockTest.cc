@@ -636,6 +636,37 @@ class ClockTest : public CppUnit::TestFixture {
 
 
 
+	//======================================================================
+	//======================================================================
+        //! @brief Test the warmup of Clock_stat_engine
+	//!
+	//! Events counted between start_warmup() and end_warmup() are discarded:
+	//! every counter is back to its value when the warmup started.
+	void testStatWarmup_0()
+	{
+	    Clock_stat_engine stats;
+	    stats.queued_events = 1;
+	    stats.rising_calendar_events = 2;
+	    stats.falling_calendar_events = 3;
+	    stats.registered_events = 4;
+
+	    stats.start_warmup();
+	    for(int i=random() % 10 + 1; i>0; i--) {
+		stats.queued_events++;
+		stats.rising_calendar_events++;
+		stats.falling_calendar_events++;
+		stats.registered_events++;
+	    }
+	    stats.end_warmup();
+
+	    CPPUNIT_ASSERT_EQUAL((counter_t)1, stats.queued_events.get_value());
+	    CPPUNIT_ASSERT_EQUAL((counter_t)2, stats.rising_calendar_events.get_value());
+	    CPPUNIT_ASSERT_EQUAL((counter_t)3, stats.falling_calendar_events.get_value());
+	    CPPUNIT_ASSERT_EQUAL((counter_t)4, stats.registered_events.get_value());
+	}
+
+
+
 
 
 
@@ -659,6 +690,8 @@ class ClockTest : public CppUnit::TestFixture {
 	    mySuite->addTest(new CppUnit::TestCaller<ClockTest>("testUnregister_0", &ClockTest::testUnregister_0));
 	    mySuite->addTest(new CppUnit::TestCaller<ClockTest>("testUnregister_1", &ClockTest::testUnregister_1));
 	    mySuite->addTest(new CppUnit::TestCaller<ClockTest>("testUnregister_2", &ClockTest::testUnregister_2));
+
+	    mySuite->addTest(new CppUnit::TestCaller<ClockTest>("testStatWarmup_0", &ClockTest::testStatWarmup_0));
 	    return mySuite;
 	}
 };
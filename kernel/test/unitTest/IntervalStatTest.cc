@@ -0,0 +1,185 @@
+/**
+This program tests Interval_stat and Interval_stat_reader.
+*/
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "manifold.h"
+#include "component.h"
+#include "interval_stat.h"
+#include "stat.h"
+
+using namespace std;
+using namespace manifold::kernel;
+
+
+//####################################################################
+// helper classes
+//####################################################################
+
+//! A component that updates its counters on each tick.
+class MyCounter : public Component {
+public:
+    MyCounter() : m_u64(0), m_u32(0), m_dbl(0), m_stat("stat", "") {}
+
+    void rising()
+    {
+        m_u64 += 3;
+	m_u32 += 1;
+	m_dbl += 0.5;
+	m_stat++;
+    }
+
+    uint64_t m_u64;
+    unsigned m_u32;
+    double m_dbl;
+    Persistent_stat<unsigned> m_stat;
+};
+
+
+
+//####################################################################
+//####################################################################
+class IntervalStatTest : public CppUnit::TestFixture {
+    private:
+	static Clock MasterClock;  //clock has to be global or static.
+	enum { MASTER_CLOCK_HZ = 10 };
+
+    public:
+	//! Snapshots are taken every interval ticks, and the reader returns the same
+	//! values, across several blocks.
+	void test_snapshot_0()
+	{
+	    Manifold::Reset(Manifold::TICKED);
+	    CompId_t cid = Component::Create<MyCounter>(0);
+	    MyCounter* counter = Component::GetComponent<MyCounter>(cid);
+	    Clock::Register(MasterClock, counter, &MyCounter::rising, (void(MyCounter::*)(void))0);
+
+	    const Ticks_t INTERVAL = 1 + random() % 10;
+	    const unsigned ROWS = 1 + random() % 5;
+	    char fname[] = "/tmp/IntervalStatTestXXXXXX";
+	    close(mkstemp(fname));
+	    CompId_t sid = Component::Create<Interval_stat>(0, &MasterClock, INTERVAL, fname, ROWS);
+	    Interval_stat* istat = Component::GetComponent<Interval_stat>(sid);
+	    istat->add_counter("u64", &counter->m_u64);
+	    istat->add_counter("u32", &counter->m_u32);
+	    istat->add_counter("dbl", &counter->m_dbl);
+	    istat->add_stat("stat", &counter->m_stat);
+
+	    Manifold::StopAt(100);
+	    Manifold::Run();
+	    uint64_t rows = istat->get_num_rows();
+	    istat->close();
+
+	    CPPUNIT_ASSERT(rows > 0);
+
+	    Interval_stat_reader reader(fname);
+	    CPPUNIT_ASSERT_EQUAL(6U, reader.get_num_columns());
+	    CPPUNIT_ASSERT_EQUAL(string("tick"), reader.get_name(0));
+	    CPPUNIT_ASSERT_EQUAL(string("time"), reader.get_name(1));
+	    CPPUNIT_ASSERT_EQUAL(string("u64"), reader.get_name(2));
+	    CPPUNIT_ASSERT_EQUAL(string("stat"), reader.get_name(5));
+	    CPPUNIT_ASSERT_EQUAL(ISTAT_DOUBLE, reader.get_type(4));
+	    CPPUNIT_ASSERT_EQUAL(ISTAT_UINT64, reader.get_type(5));
+	    CPPUNIT_ASSERT_EQUAL((uint64_t)INTERVAL, reader.get_interval());
+
+	    vector<double> row;
+	    uint64_t n = 0;
+	    double last_tick = -1;
+	    double last_time = 0;
+	    while(reader.next(row)) {
+		if(n > 0) {
+		    CPPUNIT_ASSERT_DOUBLES_EQUAL(last_tick + INTERVAL, row[0], 1e-9);
+		    CPPUNIT_ASSERT_DOUBLES_EQUAL(last_time + (double)INTERVAL / MASTER_CLOCK_HZ, row[1], 1e-9);
+		}
+		last_tick = row[0];
+		last_time = row[1];
+		//the counter has ticked tick+1 times
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3 * (row[0] + 1), row[2], 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(row[0] + 1, row[3], 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5 * (row[0] + 1), row[4], 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(row[0] + 1, row[5], 1e-9);
+		n++;
+	    }
+	    CPPUNIT_ASSERT_EQUAL(rows, n);
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(INTERVAL - 1, (Ticks_t)last_tick % INTERVAL, 1e-9);
+
+	    unlink(fname);
+	    Clock::Unregister(MasterClock, counter);
+	    Clock::Unregister(MasterClock, istat);
+	}
+
+	//! With delta, integer counters are returned as the increment over the
+	//! interval; the tick, time and doubles are not.
+	void test_delta_0()
+	{
+	    Manifold::Reset(Manifold::TICKED);
+	    CompId_t cid = Component::Create<MyCounter>(0);
+	    MyCounter* counter = Component::GetComponent<MyCounter>(cid);
+	    Clock::Register(MasterClock, counter, &MyCounter::rising, (void(MyCounter::*)(void))0);
+
+	    const Ticks_t INTERVAL = 5;
+	    char fname[] = "/tmp/IntervalStatTestXXXXXX";
+	    close(mkstemp(fname));
+	    CompId_t sid = Component::Create<Interval_stat>(0, &MasterClock, INTERVAL, fname, 2U);
+	    Interval_stat* istat = Component::GetComponent<Interval_stat>(sid);
+	    istat->add_counter("u64", &counter->m_u64);
+	    istat->add_counter("dbl", &counter->m_dbl);
+
+	    Manifold::StopAt(50);
+	    Manifold::Run();
+	    istat->close();
+
+	    Interval_stat_reader reader(fname);
+	    vector<double> row;
+	    int n = 0;
+	    while(reader.next(row, true)) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * INTERVAL, row[2], 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5 * (row[0] + 1), row[3], 1e-9);
+		n++;
+	    }
+	    CPPUNIT_ASSERT(n >= 9);
+
+	    unlink(fname);
+	    Clock::Unregister(MasterClock, counter);
+	    Clock::Unregister(MasterClock, istat);
+	}
+
+
+
+        /**
+	 * Build a test suite.
+	 */
+	static CppUnit::Test* suite()
+	{
+	    CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("IntervalStatTest");
+
+	    mySuite->addTest(new CppUnit::TestCaller<IntervalStatTest>("test_snapshot_0", &IntervalStatTest::test_snapshot_0));
+	    mySuite->addTest(new CppUnit::TestCaller<IntervalStatTest>("test_delta_0", &IntervalStatTest::test_delta_0));
+
+	    return mySuite;
+	}
+};
+
+
+Clock IntervalStatTest::MasterClock(MASTER_CLOCK_HZ);
+
+
+int main()
+{
+    srandom(time(0));
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( IntervalStatTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+}
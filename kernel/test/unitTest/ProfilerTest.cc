@@ -0,0 +1,150 @@
+/**
+This program tests the kernel profiler.
+*/
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <stdlib.h>
+#include <sstream>
+#include <vector>
+
+#include "profiler.h"
+
+using namespace std;
+using namespace manifold::kernel;
+
+
+//####################################################################
+// helper classes
+//####################################################################
+
+class MyRouter {
+    int m_dummy;
+};
+
+class MyCache {
+    int m_dummy;
+};
+
+
+
+//####################################################################
+//####################################################################
+class ProfilerTest : public CppUnit::TestFixture {
+    public:
+	//! The same object and type always gives the same entry; objects of the
+	//! same type are numbered in order.
+	void test_Entry_0()
+	{
+	    Profiler::Clear();
+	    MyRouter r0, r1;
+	    MyCache c0;
+
+	    Profile_entry* e0 = Profiler::Entry(&r0, typeid(MyRouter));
+	    Profile_entry* e1 = Profiler::Entry(&r1, typeid(MyRouter));
+	    Profile_entry* e2 = Profiler::Entry(&c0, typeid(MyCache));
+	    CPPUNIT_ASSERT(e0 != e1);
+	    CPPUNIT_ASSERT(e0 != e2);
+	    CPPUNIT_ASSERT_EQUAL(e0, Profiler::Entry(&r0, typeid(MyRouter)));
+	    CPPUNIT_ASSERT_EQUAL(e2, Profiler::Entry(&c0, typeid(MyCache)));
+	    CPPUNIT_ASSERT_EQUAL(0U, e0->instance);
+	    CPPUNIT_ASSERT_EQUAL(1U, e1->instance);
+	    CPPUNIT_ASSERT_EQUAL(0U, e2->instance);
+	    //same address, different type
+	    CPPUNIT_ASSERT(e0 != Profiler::Entry(&r0, typeid(MyCache)));
+	}
+
+	//! Entries stay the same when the table grows.
+	void test_Entry_1()
+	{
+	    Profiler::Clear();
+	    const int N = 5000 + random() % 5000;
+	    vector<MyRouter> routers(N);
+	    vector<Profile_entry*> entries(N);
+	    for(int i=0; i<N; i++)
+		entries[i] = Profiler::Entry(&routers[i], typeid(MyRouter));
+	    for(int i=0; i<N; i++) {
+		CPPUNIT_ASSERT_EQUAL(entries[i], Profiler::Entry(&routers[i], typeid(MyRouter)));
+		CPPUNIT_ASSERT_EQUAL((unsigned)i, entries[i]->instance);
+	    }
+	    CPPUNIT_ASSERT_EQUAL((size_t)N, Profiler::m_entries.size());
+	}
+
+	//! The report lists the types and objects by decreasing cycles.
+	void test_Report_0()
+	{
+	    Profiler::Clear();
+	    MyRouter r0, r1;
+	    MyCache c0;
+	    Profiler::Entry(&r0, typeid(MyRouter))->add(PROF_RISING, 100);
+	    Profiler::Entry(&r1, typeid(MyRouter))->add(PROF_TICK_EVENT, 300);
+	    Profiler::Entry(&c0, typeid(MyCache))->add(PROF_FALLING, 1000);
+
+	    Profile_entry* e = Profiler::Entry(&r1, typeid(MyRouter));
+	    CPPUNIT_ASSERT_EQUAL((uint64_t)1, e->calls[PROF_TICK_EVENT]);
+	    CPPUNIT_ASSERT_EQUAL((uint64_t)300, e->total_cycles());
+
+	    ostringstream out;
+	    Profiler::Report(out);
+	    string s = out.str();
+	    CPPUNIT_ASSERT(s.find("1400 cycles") != string::npos);
+
+	    //by type: MyCache (1000) before MyRouter (400)
+	    size_t by_type = s.find("by type");
+	    size_t objects = s.find("objects:");
+	    CPPUNIT_ASSERT(by_type < objects);
+	    size_t cache = s.find("MyCache", by_type);
+	    size_t router = s.find("MyRouter", by_type);
+	    CPPUNIT_ASSERT(cache < router && router < objects);
+	    CPPUNIT_ASSERT(s.find("400", by_type) < objects);
+
+	    //objects: MyCache[0], MyRouter[1], MyRouter[0]
+	    size_t c = s.find("MyCache[0]", objects);
+	    size_t r1_pos = s.find("MyRouter[1]", objects);
+	    size_t r0_pos = s.find("MyRouter[0]", objects);
+	    CPPUNIT_ASSERT(c != string::npos && r1_pos != string::npos && r0_pos != string::npos);
+	    CPPUNIT_ASSERT(c < r1_pos && r1_pos < r0_pos);
+	}
+
+	//! The cycle counter doesn't go backward.
+	void test_Now_0()
+	{
+	    uint64_t t0 = Profiler::Now();
+	    uint64_t t1 = Profiler::Now();
+	    CPPUNIT_ASSERT(t1 >= t0);
+	}
+
+
+
+        /**
+	 * Build a test suite.
+	 */
+	static CppUnit::Test* suite()
+	{
+	    CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("ProfilerTest");
+
+	    mySuite->addTest(new CppUnit::TestCaller<ProfilerTest>("test_Entry_0", &ProfilerTest::test_Entry_0));
+	    mySuite->addTest(new CppUnit::TestCaller<ProfilerTest>("test_Entry_1", &ProfilerTest::test_Entry_1));
+	    mySuite->addTest(new CppUnit::TestCaller<ProfilerTest>("test_Report_0", &ProfilerTest::test_Report_0));
+	    mySuite->addTest(new CppUnit::TestCaller<ProfilerTest>("test_Now_0", &ProfilerTest::test_Now_0));
+
+	    return mySuite;
+	}
+};
+
+
+int main()
+{
+    srandom(time(0));
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( ProfilerTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+}
@@ -0,0 +1,255 @@
+/**
+This program tests the Sampler.
+*/
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <stdlib.h>
+
+#include "manifold.h"
+#include "component.h"
+#include "sampler.h"
+#include "stat_engine.h"
+
+using namespace std;
+using namespace manifold::kernel;
+
+
+//####################################################################
+// helper classes
+//####################################################################
+
+//! A core that retires DETAILED_IPC instructions per tick in detailed mode, and
+//! FUNCTIONAL_IPC per tick in functional mode.
+class MyCore : public Component, public Sampled_core {
+public:
+    enum { DETAILED_IPC = 2, FUNCTIONAL_IPC = 100 };
+
+    MyCore() : m_retired(0), m_functional(false), m_stalled(false) {}
+
+    void rising()
+    {
+        if(m_functional)
+	    m_retired += FUNCTIONAL_IPC;
+	else if(!m_stalled)
+	    m_retired += DETAILED_IPC;
+    }
+
+    void set_functional(bool functional) { m_functional = functional; }
+    bool is_drained() { return true; }
+    uint64_t get_retired() { return m_retired; }
+    void set_fetch_stalled(bool stalled) { m_stalled = stalled; }
+
+    uint64_t m_retired;
+    bool m_functional;
+    bool m_stalled;
+};
+
+
+//! A component that is drained only when told so.
+class MyCache : public Sampled {
+public:
+    MyCache() : m_functional(false), m_drained(true) {}
+
+    void set_functional(bool functional) { m_functional = functional; }
+    bool is_drained() { return m_drained; }
+
+    bool m_functional;
+    bool m_drained;
+};
+
+
+//! Registered after the sampler; records the phase and the core state after each
+//! tick. The cache is drained wait ticks after the first drain phase is seen.
+class MyWatcher : public Component {
+public:
+    MyWatcher(Sampler* sampler, MyCore* core, MyCache* cache, int wait) :
+        m_sampler(sampler), m_core(core), m_cache(cache), m_wait(wait), m_drain_ticks(0) {}
+
+    void rising()
+    {
+        m_phases.push_back(m_sampler->get_phase());
+	m_stalled.push_back(m_core->m_stalled);
+	m_functional.push_back(m_core->m_functional);
+	if(m_sampler->get_phase() == Sampler::DRAIN && ++m_drain_ticks == m_wait)
+	    m_cache->m_drained = true;
+    }
+
+    Sampler* m_sampler;
+    MyCore* m_core;
+    MyCache* m_cache;
+    int m_wait;
+    int m_drain_ticks;
+    vector<Sampler::Phase_t> m_phases;
+    vector<bool> m_stalled;
+    vector<bool> m_functional;
+};
+
+
+//! A stat engine that counts how its warmup functions are called.
+class MyStatEngine : public Stat_engine {
+public:
+    MyStatEngine() : m_start(0), m_end(0), m_save(0) {}
+
+    void global_stat_merge(Stat_engine*) {}
+    void print_stats(ostream&) {}
+    void clear_stats() {}
+
+    void start_warmup() { m_start++; }
+    void end_warmup() { m_end++; }
+    void save_samples() { m_save++; }
+
+    int m_start;
+    int m_end;
+    int m_save;
+};
+
+
+
+//####################################################################
+//####################################################################
+class SamplerTest : public CppUnit::TestFixture {
+    private:
+	static Clock MasterClock;  //clock has to be global or static.
+	enum { MASTER_CLOCK_HZ = 10 };
+
+    public:
+	//! With 2 cores of the same IPC, every sample has twice the IPC of a core. The
+	//! simulation is terminated after max_samples; the stat engines are told about
+	//! each warmup and sample.
+	void test_tick_0()
+	{
+	    Manifold::Reset(Manifold::TICKED);
+	    MyCore* cores[2];
+	    for(int i=0; i<2; i++) {
+		CompId_t cid = Component::Create<MyCore>(0);
+		cores[i] = Component::GetComponent<MyCore>(cid);
+		Clock::Register(MasterClock, cores[i], &MyCore::rising, (void(MyCore::*)(void))0);
+	    }
+
+	    Sampler_settings settings;
+	    settings.functional_len = 1000;
+	    settings.warmup_len = 40;
+	    settings.measure_len = 200;
+	    settings.max_samples = 3;
+	    settings.drain_quiet = 1;
+	    CompId_t sid = Component::Create<Sampler>(0, &MasterClock, settings);
+	    Sampler* sampler = Component::GetComponent<Sampler>(sid);
+	    MyCache cache;
+	    MyStatEngine engine;
+	    for(int i=0; i<2; i++)
+		sampler->add_core(cores[i]);
+	    sampler->add_component(&cache);
+	    sampler->add_stat_engine(&engine);
+
+	    Manifold::StopAt(10000);
+	    Manifold::Run();
+
+	    CPPUNIT_ASSERT_EQUAL(Sampler::DONE, sampler->get_phase());
+	    CPPUNIT_ASSERT_EQUAL(3U, sampler->get_num_samples());
+	    for(unsigned i=0; i<sampler->m_sample_ipc.size(); i++)
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 * MyCore::DETAILED_IPC, sampler->m_sample_ipc[i], 1e-9);
+	    CPPUNIT_ASSERT_EQUAL(4, engine.m_start);
+	    CPPUNIT_ASSERT_EQUAL(3, engine.m_end);
+	    CPPUNIT_ASSERT_EQUAL(3, engine.m_save);
+	    //the functional phases are cut short only by the last tick of the core
+	    CPPUNIT_ASSERT(sampler->m_functional_insts >= 3 * settings.functional_len);
+	    CPPUNIT_ASSERT(sampler->m_functional_insts < 3 * (settings.functional_len + 2 * MyCore::FUNCTIONAL_IPC));
+
+	    for(int i=0; i<2; i++)
+		Clock::Unregister(MasterClock, cores[i]);
+	    Clock::Unregister(MasterClock, sampler);
+	}
+
+	//! After a sample, the cores stop fetching, and the switch to functional mode
+	//! waits until all components have been drained for drain_quiet cycles.
+	void test_tick_1()
+	{
+	    Manifold::Reset(Manifold::TICKED);
+	    CompId_t cid = Component::Create<MyCore>(0);
+	    MyCore* core = Component::GetComponent<MyCore>(cid);
+	    Clock::Register(MasterClock, core, &MyCore::rising, (void(MyCore::*)(void))0);
+
+	    Sampler_settings settings;
+	    settings.functional_len = 1000;
+	    settings.measure_len = 10;
+	    settings.drain_quiet = 5 + random() % 10;
+	    CompId_t sid = Component::Create<Sampler>(0, &MasterClock, settings);
+	    Sampler* sampler = Component::GetComponent<Sampler>(sid);
+	    MyCache cache;
+	    sampler->add_core(core);
+	    sampler->add_component(&cache);
+	    cache.m_drained = false;
+
+	    const int WAIT = 50;
+	    CompId_t wid = Component::Create<MyWatcher>(0, sampler, core, &cache, WAIT);
+	    MyWatcher* watcher = Component::GetComponent<MyWatcher>(wid);
+	    Clock::Register(MasterClock, watcher, &MyWatcher::rising, (void(MyWatcher::*)(void))0);
+
+	    Manifold::StopAt(200);
+	    Manifold::Run();
+
+	    const vector<Sampler::Phase_t>& phases = watcher->m_phases;
+	    int drain = 0;
+	    while(drain < (int)phases.size() && phases[drain] != Sampler::DRAIN)
+		drain++;
+	    int functional = drain + WAIT - 1 + settings.drain_quiet;
+	    CPPUNIT_ASSERT(functional < (int)phases.size());
+
+	    for(int i=drain; i<functional; i++) {
+		CPPUNIT_ASSERT_EQUAL(Sampler::DRAIN, phases[i]);
+		CPPUNIT_ASSERT_EQUAL(true, watcher->m_stalled[i]);
+		CPPUNIT_ASSERT_EQUAL(false, watcher->m_functional[i]);
+	    }
+	    CPPUNIT_ASSERT_EQUAL(Sampler::FUNCTIONAL, phases[functional]);
+	    CPPUNIT_ASSERT_EQUAL(false, watcher->m_stalled[functional]);
+	    CPPUNIT_ASSERT_EQUAL(true, watcher->m_functional[functional]);
+
+	    Clock::Unregister(MasterClock, core);
+	    Clock::Unregister(MasterClock, sampler);
+	    Clock::Unregister(MasterClock, watcher);
+	}
+
+	//! The z value of the confidence interval.
+	void test_Z_value_0()
+	{
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.960, Sampler::Z_value(0.95), 1e-9);
+	    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.576, Sampler::Z_value(0.99), 1e-9);
+	}
+
+
+
+        /**
+	 * Build a test suite.
+	 */
+	static CppUnit::Test* suite()
+	{
+	    CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("SamplerTest");
+
+	    mySuite->addTest(new CppUnit::TestCaller<SamplerTest>("test_tick_0", &SamplerTest::test_tick_0));
+	    mySuite->addTest(new CppUnit::TestCaller<SamplerTest>("test_tick_1", &SamplerTest::test_tick_1));
+	    mySuite->addTest(new CppUnit::TestCaller<SamplerTest>("test_Z_value_0", &SamplerTest::test_Z_value_0));
+
+	    return mySuite;
+	}
+};
+
+
+Clock SamplerTest::MasterClock(MASTER_CLOCK_HZ);
+
+
+int main()
+{
+    srandom(time(0));
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( SamplerTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+}
@@ -0,0 +1,171 @@
+/**
+This program tests the merging and printing of the synchronization statistics.
+*/
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <stdlib.h>
+#include <time.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sync_stat.h"
+
+using namespace std;
+using namespace manifold::kernel;
+
+
+//####################################################################
+// helper functions
+//####################################################################
+
+//! Size of the packed statistics of one LP.
+static unsigned Packed_size(int n_lps)
+{
+    return Sync_stat::F_NUM_FIELDS + 2 * n_lps * Sync_stat::ADVANCE_BINS;
+}
+
+//! The line of out that starts with prefix, or "" if there is none.
+static string Find_line(const string& out, const string& prefix)
+{
+    istringstream in(out);
+    string line;
+    while(getline(in, line))
+        if(line.compare(0, prefix.size(), prefix) == 0)
+	    return line;
+    return "";
+}
+
+
+
+//####################################################################
+//####################################################################
+class SyncStatTest : public CppUnit::TestFixture {
+    public:
+	//! Merge() sums every field of all LPs, except the max lag, which is the
+	//! largest of the LPs.
+	void test_Merge_0()
+	{
+	    const int N_LPS = random() % 8 + 2;
+	    const unsigned size = Packed_size(N_LPS);
+	    vector<double> all(size * N_LPS);
+	    for(unsigned i=0; i<all.size(); i++)
+	        all[i] = random() % 1000;
+
+	    vector<double> total;
+	    Sync_stat::Merge(all, N_LPS, total);
+
+	    CPPUNIT_ASSERT_EQUAL((unsigned)Sync_stat::F_NUM_FIELDS, (unsigned)total.size());
+	    for(int i=0; i<Sync_stat::F_NUM_FIELDS; i++) {
+	        double expected = 0;
+		for(int lp=0; lp<N_LPS; lp++) {
+		    double f = all[lp * size + i];
+		    if(i == Sync_stat::F_MAX_LAG)
+		        expected = (lp == 0 || f > expected) ? f : expected;
+		    else
+		        expected += f;
+		}
+		CPPUNIT_ASSERT_EQUAL(expected, total[i]);
+	    }
+	}
+
+	//! The report prints the max lag of all LPs, not their sum, and the "all" row
+	//! has the summed counts.
+	void test_Print_report_0()
+	{
+	    const int N_LPS = 2;
+	    const unsigned size = Packed_size(N_LPS);
+	    vector<double> all(size * N_LPS, 0);
+	    all[Sync_stat::F_RUN_TIME] = 10;
+	    all[Sync_stat::F_BLOCKED_EPISODES] = 3;
+	    all[Sync_stat::F_SUM_LAG] = 9;
+	    all[Sync_stat::F_MAX_LAG] = 5;
+	    all[size + Sync_stat::F_RUN_TIME] = 10;
+	    all[size + Sync_stat::F_BLOCKED_EPISODES] = 4;
+	    all[size + Sync_stat::F_SUM_LAG] = 12;
+	    all[size + Sync_stat::F_MAX_LAG] = 7;
+
+	    ostringstream out;
+	    Sync_stat::Print_report(out, all, N_LPS);
+
+	    string line = Find_line(out.str(), "  blocked%:");
+	    CPPUNIT_ASSERT(line.find("max lag: 7") != string::npos);
+
+	    //LP, run(s), blocked(s), blocked%, episodes, avg_lag
+	    istringstream row(Find_line(out.str(), "  all"));
+	    string lp, run, blocked, pct;
+	    double episodes, avg_lag;
+	    row >> lp >> run >> blocked >> pct >> episodes >> avg_lag;
+	    CPPUNIT_ASSERT_EQUAL(string("all"), lp);
+	    CPPUNIT_ASSERT_EQUAL(7.0, episodes);
+	    CPPUNIT_ASSERT_EQUAL(3.0, avg_lag);
+
+	    //no histogram without samples
+	    CPPUNIT_ASSERT_EQUAL(string(""), Find_line(out.str(), "  EIT"));
+	}
+
+	//! Histogram rows are printed only for the channels with samples; the EIT of
+	//! channel src->dst is recorded by dst.
+	void test_Print_report_1()
+	{
+	    const int N_LPS = 3;
+	    const unsigned size = Packed_size(N_LPS);
+	    vector<double> all(size * N_LPS, 0);
+	    const int SRC = 2;
+	    const int DST = 1;
+	    const int BIN = random() % Sync_stat::ADVANCE_BINS;
+	    all[DST * size + Sync_stat::F_NUM_FIELDS + SRC * Sync_stat::ADVANCE_BINS + BIN] = 42;
+
+	    ostringstream out;
+	    Sync_stat::Print_report(out, all, N_LPS);
+
+	    CPPUNIT_ASSERT(Find_line(out.str(), "  EIT") != "");
+	    istringstream in(out.str());
+	    string line;
+	    int rows = 0;
+	    while(getline(in, line)) {
+	        istringstream row(line);
+		string channel;
+		row >> channel;
+		if(channel.find("->") == string::npos || channel == "src->dst")
+		    continue;
+		rows++;
+		CPPUNIT_ASSERT_EQUAL(string("2->1"), channel);
+		for(int b=0; b<Sync_stat::ADVANCE_BINS; b++) {
+		    unsigned long n;
+		    row >> n;
+		    CPPUNIT_ASSERT_EQUAL((unsigned long)(b == BIN ? 42 : 0), n);
+		}
+	    }
+	    CPPUNIT_ASSERT_EQUAL(1, rows); //only in the EIT histogram
+	}
+
+	static CppUnit::Test* suite()
+	{
+	    CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("SyncStatTest");
+
+	    mySuite->addTest(new CppUnit::TestCaller<SyncStatTest>("test_Merge_0", &SyncStatTest::test_Merge_0));
+	    mySuite->addTest(new CppUnit::TestCaller<SyncStatTest>("test_Print_report_0", &SyncStatTest::test_Print_report_0));
+	    mySuite->addTest(new CppUnit::TestCaller<SyncStatTest>("test_Print_report_1", &SyncStatTest::test_Print_report_1));
+
+	    return mySuite;
+	}
+};
+
+
+int main()
+{
+    srandom(time(0));
+
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( SyncStatTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+}
@@ -18,6 +18,9 @@ fi
 
 FAIL=0
 
+eval ./CheckpointTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 eval ./ClockTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
@@ -27,6 +30,9 @@ if [ $? -ne 0 ]; then FAIL=1; fi
 eval ./dvfsTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
+eval ./IntervalStatTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 eval ./LinkTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
@@ -51,6 +57,15 @@ if [ $? -ne 0 ]; then FAIL=1; fi
 eval mpirun -np 2 ./MessengerTest_big_data1 $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
+eval ./ProfilerTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
+eval ./SamplerTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
+eval ./SyncStatTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 eval ./tickObjTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
@@ -1,4 +1,5 @@
 #include "L1_cache.h"
+#include "L2_cache.h"
 #include "kernel/manifold.h"
 #include "debug.h"
 
@@ -67,17 +68,49 @@ L1_cache::L1_cache (int nid, const cache_settings& parameters, const L1_cache_se
     stats_stall_buffer_max_size = 0;
     stats_table_occupancy = 0;
     stats_table_empty_cycles = 0;
+    stats_functional_accesses = 0;
+    stats_prefetch_issued = 0;
+    stats_prefetch_useful = 0;
+    stats_prefetch_late = 0;
+    stats_prefetch_useless = 0;
+    stats_prefetch_throttled = 0;
+    m_stat_engine.add(&stats_cycles);
+    m_stat_engine.add(&stats_processor_read_requests);
+    m_stat_engine.add(&stats_processor_write_requests);
+    m_stat_engine.add(&stats_hits);
+    m_stat_engine.add(&stats_misses);
+    m_stat_engine.add(&stats_MSHR_STALLs);
+    m_stat_engine.add(&stats_PREV_PEND_STALLs);
+    m_stat_engine.add(&stats_LRU_BUSY_STALLs);
+    m_stat_engine.add(&stats_TRANS_STALLs);
+    m_stat_engine.add(&stats_stall_buffer_max_size);
+    m_stat_engine.add(&stats_table_occupancy);
+    m_stat_engine.add(&stats_table_empty_cycles);
+    m_stat_engine.add(&stats_prefetch_issued);
+    m_stat_engine.add(&stats_prefetch_useful);
+    m_stat_engine.add(&stats_prefetch_late);
+    m_stat_engine.add(&stats_prefetch_useless);
+    m_stat_engine.add(&stats_prefetch_throttled);
+
+    m_prefetcher = Prefetcher :: Create(parameters.block_size, settings.prefetch);
+    m_prefetch_mshr_reserve = settings.prefetch.mshr_reserve;
+    m_prefetched.resize(my_table->get_num_entries(), (paddr_t)NO_LINE);
 
 #ifdef MCP_CACHE_COUNTERS
     cache_counter = new L1_counter_t();
 #endif
+
+    FunctionalWarmup :: Register_l1(node_id, this);
 }
 
 
 L1_cache::~L1_cache (void)
 {
+   FunctionalWarmup :: Unregister_l1(node_id, this);
+
    delete my_table;
    delete mshr;
+   delete m_prefetcher;
 
 #ifdef MCP_CACHE_COUNTERS
    if (cache_counter != NULL)
@@ -138,6 +171,8 @@ void L1_cache :: tick()
 	m_proc_requests.pop_front();
 	process_processor_request(req, true);
     }
+    if(!m_prefetch_candidates.empty())
+        issue_prefetches();
 
     //stats
     stats_cycles++;
@@ -155,6 +190,9 @@ void L1_cache :: process_processor_request (cache_req *request, bool first)
 
     DBG_L1_CACHE_TICK_ID( cerr,  "###### " << " process_processor_request():  addr= " <<hex<< request->addr <<dec<< ((request->op_type==OpMemLd) ? " LD" : " ST") << "\n" );
 
+    if(first && m_prefetcher && request->preqWrapper)
+        train_prefetcher(request);
+
     /** This code may be modified in the future to enable parallel events while transient (read while waiting for previous read-unblock).  For the time being, just assume no parallel events for a single address */
     if (mshr->has_match(request->addr))
     {
@@ -278,6 +316,9 @@ void L1_cache::L1_algorithm (hash_entry *e, cache_req *request, bool first)
 
     assert(mcp_stalled_req[client->getClientID()] == 0);
 
+    if(request->preqWrapper) //a demand request; the line no longer counts as prefetched.
+        m_prefetched[mshr_map[e->get_idx()]->get_idx()] = NO_LINE;
+
     mcp_state[client->getClientID()] = PROCESSING_LOWER;
 
     if (request->op_type == OpMemLd) {
@@ -341,6 +382,11 @@ void L1_cache :: start_eviction (hash_entry* mshr_entry, cache_req *request)
 
     assert(mshr->has_match(victim->get_line_addr()) == false); //victim shouldn't have an mshr entry.
 
+    if(m_prefetched[victim->get_idx()] == victim->get_line_addr()) {
+        stats_prefetch_useless++;
+	m_prefetched[victim->get_idx()] = NO_LINE;
+    }
+
     ClientInterface* client = clients[victim->get_idx()];
     
     assert(client->HaveEvictP() == false);
@@ -585,8 +631,199 @@ void L1_cache :: c_evict_notify(ClientInterface* client)
 
 
 
+
+
+//====================================================================
+// Functional warmup
+//====================================================================
+
+//! Process a processor access in functional mode. Tag array, LRU and coherence
+//! state of this cache and the home L2 (and the peers the home L2 must invalidate
+//! or downgrade) are updated directly. No message is sent and no MSHR is used.
+void L1_cache :: functional_access(paddr_t addr, bool write)
+{
+    assert(mshr->has_match(addr) == false); //caches must be idle when warmup is enabled.
+
+    hash_entry* hash_table_entry = my_table->get_entry(addr);
+
+    if(hash_table_entry == 0) {
+	hash_table_entry = my_table->reserve_block_for(addr);
+	if(hash_table_entry == 0) {
+	    functional_evict(my_table->get_replacement_entry(addr));
+	    hash_table_entry = my_table->reserve_block_for(addr);
+	    assert(hash_table_entry);
+	}
+    }
+
+    ClientInterface* client = clients[hash_table_entry->get_idx()];
+
+    if(client->functional_access(write) == false) {
+	paddr_t line_addr = hash_table_entry->get_line_addr();
+	L2_cache* home = FunctionalWarmup :: Get_l2(l2_map->lookup(line_addr));
+	bool exclusive = home->functional_request(line_addr, node_id, write);
+	client->functional_fill(write, exclusive);
+    }
+}
+
+
+//! Called by the home L2 in functional mode to invalidate or downgrade a line.
+//! @return  true if the line was dirty.
+bool L1_cache :: functional_demand(paddr_t addr, bool downgrade)
+{
+    hash_entry* hash_table_entry = my_table->get_entry(addr);
+    if(hash_table_entry == 0) //line was evicted silently.
+        return false;
+
+    assert(mshr->has_match(addr) == false);
+
+    ClientInterface* client = clients[hash_table_entry->get_idx()];
+    if(downgrade)
+	return client->functional_downgrade();
+    else
+	return client->functional_invalidate();
+}
+
+
+void L1_cache :: functional_evict(hash_entry* victim)
+{
+    ClientInterface* client = clients[victim->get_idx()];
+    assert(client->req_pending() == false);
+
+    paddr_t line_addr = victim->get_line_addr();
+
+    if(client->functional_evict()) {
+	FunctionalWarmup :: Get_l2(l2_map->lookup(line_addr))->functional_put(line_addr, node_id);
+    }
+}
+
+
+
+//====================================================================
+// Prefetching
+//====================================================================
+
+//! Train the prefetcher with a demand request when it's processed the first time.
+//! Misses and first hits on prefetched lines trigger prefetches.
+void L1_cache :: train_prefetcher(cache_req* request)
+{
+    paddr_t line_addr = my_table->get_line_addr(request->addr);
+    bool trigger = true;
+
+    hash_entry* hash_table_entry = my_table->get_entry(line_addr);
+    if(hash_table_entry) {
+        trigger = false;
+	if(m_prefetched[hash_table_entry->get_idx()] == line_addr) {
+	    m_prefetched[hash_table_entry->get_idx()] = NO_LINE;
+	    stats_prefetch_useful++;
+	    trigger = true;
+#ifdef MCP_CACHE_COUNTERS
+            cache_counter->DL1.prefetch.read += 1;
+#endif
+	}
+    }
+
+    m_prefetcher->train(request->addr, request->pc, trigger, m_prefetch_candidates);
+}
+
+
+//! Issue the candidates proposed by the prefetcher. Lines that are present, in flight
+//! or wanted by a stalled request are skipped, and so are lines that would stall for
+//! lack of a victim. A prefetch is a load without a processor request; it takes the
+//! same path through the coherence protocol as a demand load.
+void L1_cache :: issue_prefetches()
+{
+    for(unsigned i=0; i<m_prefetch_candidates.size(); i++) {
+        if(mshr->get_occupancy() + m_prefetch_mshr_reserve >= (unsigned)mshr->get_num_entries()) {
+	    stats_prefetch_throttled += m_prefetch_candidates.size() - i;
+	    break;
+	}
+
+        paddr_t line_addr = my_table->get_line_addr(m_prefetch_candidates[i]);
+	if(my_table->has_match(line_addr) || mshr->has_match(line_addr) || stall_buffer_has_match(line_addr))
+	    continue;
+	if(!my_table->can_allocate_for(line_addr) &&
+	   clients[my_table->get_replacement_entry(line_addr)->get_idx()]->req_pending())
+	    continue;
+
+	cache_req* req = new cache_req;
+	req->addr = line_addr;
+	req->op_type = OpMemLd;
+	req->preqWrapper = 0;
+	req->pc = 0;
+
+	stats_prefetch_issued++;
+#ifdef MCP_CACHE_COUNTERS
+        cache_counter->DL1.prefetch.search += 1;
+#endif
+	process_processor_request(req, true);
+    }
+    m_prefetch_candidates.clear();
+}
+
+
+
+//====================================================================
+// sampled simulation
+//====================================================================
+
+//! Functional warmup is global; all caches switch it together.
+void L1_cache :: set_functional(bool functional)
+{
+    if(functional)
+        FunctionalWarmup :: Enable();
+    else
+        FunctionalWarmup :: Disable();
+}
+
+
+//! Drained when the cache could be checkpointed.
+bool L1_cache :: is_drained()
+{
+    return mshr->get_occupancy() == 0 && stalled_client_req_buffer.size() == 0 &&
+           m_proc_requests.size() == 0 && m_net_requests.size() == 0 &&
+           m_downstream_output_buffer.size() == 0;
+}
+
+
+
+//====================================================================
+// checkpoint
+//====================================================================
+
+//! Saves the tag array, LRU order, client states and credits. MSHR entries, stalled
+//! requests and buffered messages all refer to messages in flight, which cannot be
+//! saved; so they must all be empty.
+void L1_cache :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    assert(mshr->get_occupancy() == 0 && mshr_map.size() == 0);
+    assert(stalled_client_req_buffer.size() == 0);
+    assert(m_proc_requests.size() == 0 && m_net_requests.size() == 0);
+    assert(m_downstream_output_buffer.size() == 0);
+
+    out.write(node_id);
+    my_table->checkpoint(out);
+    for(unsigned i=0; i<clients.size(); i++)
+        clients[i]->checkpoint(out);
+    out.write(m_downstream_credits);
+}
+
+
+void L1_cache :: restore(manifold::kernel::CheckpointIn& in)
+{
+    int nid;
+    in.read(nid);
+    assert(nid == node_id);
+    my_table->restore(in);
+    for(unsigned i=0; i<clients.size(); i++)
+        clients[i]->restore(in);
+    in.read(m_downstream_credits);
+}
+
+
+
 void L1_cache::stall (cache_req *request, stall_type_t stall_msg)
 {
+    assert(request->preqWrapper); //prefetches are only issued if they won't stall
     Stall_buffer_entry e;
     e.req = request;
     e.type = stall_msg;
@@ -611,6 +848,18 @@ bool L1_cache :: stall_buffer_has_match(paddr_t addr)
 //! Reply to processor for LOAD.
 void L1_cache::read_reply (cache_req *request)
 {
+    if(request->preqWrapper == 0) { //a prefetch; there is no processor request to reply to.
+	paddr_t line_addr = my_table->get_line_addr(request->addr);
+	if(stall_buffer_has_match(line_addr)) { //a demand request is already waiting for the line
+	    stats_prefetch_useful++;
+	    stats_prefetch_late++;
+	}
+	else
+	    m_prefetched[my_table->get_entry(line_addr)->get_idx()] = line_addr;
+        delete request;
+	return;
+    }
+
     DBG_L1_CACHE_ID(cerr, " read reply to processor,  addr= " <<hex<< request->addr <<dec<< "\n");
 
     request->preqWrapper->SendTick(this, PORT_PROC, my_table->get_hit_time());
@@ -641,8 +890,7 @@ void L1_cache :: send_msg_to_peer_or_l2(Coh_msg* msg)
     pkt->type = COH_MSG;
     pkt->src = node_id;
     pkt->dst = msg->dst_id;
-    *((Coh_msg*)(pkt->data)) = *msg;
-    pkt->data_size = sizeof(Coh_msg);
+    pkt->set_data(*msg);
     delete msg;
 
     assert(my_table->get_lookup_time() > 0);
@@ -672,8 +920,7 @@ void L1_cache :: send_credit_downstream()
 {
     DBG_L1_CACHE_ID(cerr, " sending credit.\n");
 
-    NetworkPacket* pkt = new NetworkPacket;
-    pkt->type = CREDIT_MSG;
+    NetworkPacket* pkt = NetworkPacket::Create_credit(CREDIT_MSG);
     Send(PORT_L2, pkt);
 }
 
@@ -752,6 +999,17 @@ void L1_cache :: print_stats(std::ostream& out)
 	<< "    cycles = " << stats_cycles << endl
 	<< "    hash table avg occupancy = " << avg_occup << " (" << avg_occup / (my_table->get_size() / my_table->get_block_size()) * 100 << "%)" << endl
 	<< "    hash table empty cycles= " << stats_table_empty_cycles << endl;
+    if(stats_functional_accesses > 0)
+        out << "    functional warmup accesses= " << stats_functional_accesses << endl;
+    if(m_prefetcher) {
+        unsigned demand_misses = stats_processor_read_requests + stats_processor_write_requests - stats_hits;
+        out << "    Prefetcher = " << m_prefetcher->get_name() << endl
+	    << "    Prefetches issued= " << stats_prefetch_issued << " useful= " << stats_prefetch_useful
+	    << " (late= " << stats_prefetch_late << ") useless= " << stats_prefetch_useless
+	    << " throttled= " << stats_prefetch_throttled << endl
+	    << "    Prefetch accuracy= " << (stats_prefetch_issued ? (double)stats_prefetch_useful / stats_prefetch_issued : 0)
+	    << " coverage= " << (demand_misses + stats_prefetch_useful ? (double)stats_prefetch_useful / (demand_misses + stats_prefetch_useful) : 0) << endl;
+    }
 }
 
 
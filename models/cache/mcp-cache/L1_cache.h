@@ -5,6 +5,7 @@
 #include "cache_types.h"
 #include "coherence/ClientInterface.h"
 #include "kernel/component.h"
+#include "kernel/sampler.h"
 #include "hash_table.h"
 #include "MemoryControllerMap.h"
 #include "cache_req.h"
@@ -13,6 +14,8 @@
 #include "uarch/networkPacket.h"
 
 #include "cache-counters.h"
+#include "functional_warmup.h"
+#include "prefetcher.h"
 
 namespace manifold {
 namespace mcp_cache_namespace {
@@ -22,10 +25,18 @@ public:
     manifold::uarch::DestMap* l2_map;
     unsigned mshr_sz; //mshr size
     int downstream_credits;
+    prefetch_settings prefetch; //no prefetching by default
 };
 
 
-class L1_cache : public manifold::kernel::Component {
+//! PC of the instruction that made a processor request, for PC-indexed prefetchers.
+//! This default is for request types that don't carry the PC. A processor model can
+//! provide a Get_pc() overload for its request type in the type's namespace.
+template<typename T>
+inline paddr_t Get_pc(const T*) { return 0; }
+
+
+class L1_cache : public manifold::kernel::Component, public manifold::kernel::Sampled {
 public:
 
     hash_table *my_table;
@@ -51,8 +62,10 @@ public:
 	//may receive multiple credits, or one msg one credit
         //assert(m_net_requests.size() == 0);
 	m_net_requests.push_back(pkt);
-        Coh_msg* msg = (Coh_msg*)(pkt->data);
 #ifdef MCP_CACHE_COUNTERS
+        if(pkt->type == CREDIT_MSG) //credits have no payload
+            return;
+        Coh_msg* msg = (Coh_msg*)(pkt->data);
         if(msg->rw == 0) {
             cache_counter->DL1.read += 1;
             cache_counter->DL1.search += 1;
@@ -80,6 +93,20 @@ public:
 
     hash_entry* get_hash_entry_by_idx(unsigned idx) { return hash_entries[idx]; }
 
+    //functional warmup
+    void functional_access(paddr_t addr, bool write);
+    bool functional_demand(paddr_t addr, bool downgrade);
+
+    //sampled simulation; the functional mode is functional warmup.
+    void set_functional(bool functional);
+    bool is_drained();
+    //the Sampler discards the stats counted during warmup through this engine.
+    Cache_stat_engine* get_stat_engine() { return &m_stat_engine; }
+
+    //checkpoint; the cache must be idle, i.e., MSHRs and buffers are empty.
+    void checkpoint(manifold::kernel::CheckpointOut&);
+    void restore(manifold::kernel::CheckpointIn&);
+
     void print_stats(std::ostream&);
 
     static void Set_msg_types(int coh, int credit)
@@ -114,6 +141,12 @@ private:
     //! called when client enters stable state while processing a request from processor.
     void c_notify(hash_entry* mshr_entry, ClientInterface* client);
 
+    void functional_evict(hash_entry* victim);
+
+    //prefetching
+    void train_prefetcher(cache_req* request);
+    void issue_prefetches();
+
 
     //debug
     void print_mshr();
@@ -183,6 +216,14 @@ protected:
     std::list<manifold::kernel::Ticks_t> m_credit_out_ticks;
     std::list<manifold::kernel::Ticks_t> m_msg_out_ticks;
 
+    //prefetching
+    Prefetcher* m_prefetcher; //0 if prefetching is off
+    int m_prefetch_mshr_reserve;
+    std::vector<paddr_t> m_prefetch_candidates; //lines proposed by the prefetcher in this tick
+    static const paddr_t NO_LINE = 1; //never a line address
+    std::vector<paddr_t> m_prefetched; //for each hash entry, the line if it was brought in by a
+                                       //prefetch and hasn't been used yet; NO_LINE otherwise
+
     //stats
     unsigned long stats_cycles;
     unsigned stats_processor_read_requests;
@@ -196,12 +237,26 @@ protected:
     unsigned stats_stall_buffer_max_size;
     unsigned long stats_table_occupancy; //accumulated hash table occupancy
     unsigned stats_table_empty_cycles;
+    unsigned stats_functional_accesses; //processor requests handled in functional warmup mode
+    unsigned stats_prefetch_issued;
+    unsigned stats_prefetch_useful; //prefetched lines used by a demand request
+    unsigned stats_prefetch_late; //useful prefetches still in flight when the demand request came
+    unsigned stats_prefetch_useless; //prefetched lines evicted without being used
+    unsigned stats_prefetch_throttled; //candidates dropped because too few MSHRs were free
+    Cache_stat_engine m_stat_engine; //all of the above except stats_functional_accesses
 };
 
 
 template<typename T>
 void L1_cache :: handle_processor_request(int, T* request)
 {
+    if(FunctionalWarmup :: Is_enabled()) {
+        stats_functional_accesses++;
+	functional_access(request->get_addr(), !request->is_read());
+	SendTick(PORT_PROC, request, my_table->get_hit_time());
+	return;
+    }
+
     //stats
     if(stalled_client_req_buffer.size() > stats_stall_buffer_max_size)
 	stats_stall_buffer_max_size = stalled_client_req_buffer.size();
@@ -234,6 +289,7 @@ void L1_cache :: handle_processor_request(int, T* request)
     req->addr = request->get_addr();
     req->op_type = (request->is_read()) ? OpMemLd : OpMemSt;
     req->preqWrapper = new GenericPreqWrapper<T>(request);
+    req->pc = Get_pc(request);
 
     //might receive multiple processor requests at the same tick.
     //assert(m_proc_requests.size() == 0);
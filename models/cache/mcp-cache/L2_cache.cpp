@@ -1,5 +1,6 @@
 #include <assert.h>
 #include "L2_cache.h"
+#include "L1_cache.h"
 #include "kernel/manifold.h"
 #include "debug.h"
 
@@ -54,17 +55,49 @@ L2_cache :: L2_cache (int nid, const cache_settings& parameters, const L2_cache_
     stats_table_empty_cycles = 0;
     stats_mshr_occupancy = 0;
     stats_mshr_empty_cycles = 0;
+    stats_prefetch_issued = 0;
+    stats_prefetch_useful = 0;
+    stats_prefetch_late = 0;
+    stats_prefetch_useless = 0;
+    stats_prefetch_throttled = 0;
+    m_stat_engine.add(&stats_cycles);
+    m_stat_engine.add(&stats_num_reqs);
+    m_stat_engine.add(&stats_miss);
+    m_stat_engine.add(&stats_MSHR_STALLs);
+    m_stat_engine.add(&stats_PREV_PEND_STALLs);
+    m_stat_engine.add(&stats_LRU_BUSY_STALLs);
+    m_stat_engine.add(&stats_TRANS_STALLs);
+    m_stat_engine.add(&stats_stall_buffer_max_size);
+    m_stat_engine.add(&stats_table_occupancy);
+    m_stat_engine.add(&stats_table_empty_cycles);
+    m_stat_engine.add(&stats_mshr_occupancy);
+    m_stat_engine.add(&stats_mshr_empty_cycles);
+    m_stat_engine.add(&stats_prefetch_issued);
+    m_stat_engine.add(&stats_prefetch_useful);
+    m_stat_engine.add(&stats_prefetch_late);
+    m_stat_engine.add(&stats_prefetch_useless);
+    m_stat_engine.add(&stats_prefetch_throttled);
+
+    m_prefetcher = Prefetcher :: Create(parameters.block_size, settings.prefetch);
+    m_prefetch_mshr_reserve = settings.prefetch.mshr_reserve;
+    m_prefetched.resize(my_table->get_num_entries(), (paddr_t)NO_LINE);
+    m_prefetch_buffer_size = settings.prefetch.buffer_size;
 
 #ifdef MCP_CACHE_COUNTERS
       cache_counter = new L2_counter_t();
 #endif
+
+    FunctionalWarmup :: Register_l2(node_id, this);
 }
 
 
 L2_cache::~L2_cache (void)
 {
+   FunctionalWarmup :: Unregister_l2(node_id, this);
+
    delete my_table;
    delete mshr;
+   delete m_prefetcher;
 
 #ifdef MCP_CACHE_COUNTERS
    if (cache_counter != NULL)
@@ -128,7 +161,13 @@ void L2_cache :: process_incoming_coh(Coh_msg* request)
 	if(stalled_client_req_buffer.size() > stats_stall_buffer_max_size)
 	    stats_stall_buffer_max_size = stalled_client_req_buffer.size();
 
+	if(m_prefetcher && !managers[0]->is_invalidation_request(request))
+	    train_prefetcher(request);
+
         process_client_request(request, true);
+
+	if(!m_prefetch_candidates.empty())
+	    issue_prefetches();
     }
     else {
         assert(request->type == Coh_msg :: COH_RPLY);
@@ -150,6 +189,13 @@ void L2_cache :: process_mem_resp (Mem_msg *request)
 	hash_entry* mshr_entry = mshr->get_entry(request->addr);
 	assert(mshr_entry);
 
+	if(mshr_map[mshr_entry->get_idx()] == 0) { //a prefetch for the prefetch buffer
+	    put_in_prefetch_buffer(my_table->get_line_addr(request->addr));
+	    release_mshr_entry(mshr_entry);
+	    delete request;
+	    return;
+	}
+
 	ManagerInterface* manager = managers[mshr_map[mshr_entry->get_idx()]->get_idx()];
 	Coh_msg* stalled_req = mcp_stalled_req[manager->getManagerID()];
 	mcp_stalled_req[manager->getManagerID()] = 0;
@@ -229,6 +275,13 @@ void L2_cache::process_client_request (Coh_msg* request, bool first)
 	    return;
 	}
 
+	if(request->type == Coh_msg :: COH_PREFETCH && m_prefetch_buffer_size > 0) {
+	    //the line goes to the prefetch buffer, so the MSHR is not paired with a hash entry.
+	    get_from_memory(request);
+	    delete request;
+	    return;
+	}
+
 
         /** Check if an invalid block exists already or the LRU block can begin eviction. */
 	hash_table_entry = my_table->reserve_block_for (request->addr);
@@ -243,7 +296,16 @@ void L2_cache::process_client_request (Coh_msg* request, bool first)
 	    ManagerInterface* victim_manager = managers[victim->get_idx()];
 
 
-	    if (victim_manager->req_pending() == false && mcp_stalled_req[victim_manager->getManagerID()] == 0)
+	    if (m_prefetched[victim->get_idx()] == victim->get_line_addr())
+	    {
+	        //An unused prefetched line has no lower client, so it is simply dropped.
+		drop_prefetched_line(victim);
+		hash_table_entry = my_table->reserve_block_for (request->addr);
+		assert(hash_table_entry);
+		mshr_map[mshr_entry->get_idx()] = hash_table_entry;
+		L2_algorithm (mshr_entry, request);
+	    }
+	    else if (victim_manager->req_pending() == false && mcp_stalled_req[victim_manager->getManagerID()] == 0)
 	    {
 	    //The 2nd part of the if statement is necessary because a manager could be in I state and waiting for
 	    //data from memory.
@@ -319,7 +381,25 @@ void L2_cache::L2_algorithm (hash_entry* mshr_entry, Coh_msg* request)
     ManagerInterface* manager = managers[mshr_map[mshr_entry->get_idx()]->get_idx()];
     assert(mcp_stalled_req[manager->getManagerID()] == 0);
 
-    if(mshr_entry->get_have_data())
+    if(!mshr_entry->get_have_data() && take_from_prefetch_buffer(request->addr))
+        mshr_entry->set_have_data(true);
+
+    if(mshr_entry->get_have_data() && request->type == Coh_msg :: COH_PREFETCH)
+    {
+        //the prefetched line is in the cache now, with no lower client.
+	paddr_t line_addr = my_table->get_line_addr(request->addr);
+	hash_entry* hash_table_entry = mshr_map[mshr_entry->get_idx()];
+	update_hash_entry(hash_table_entry, mshr_entry);
+	if(stall_buffer_has_match(line_addr)) { //an L1 request is already waiting for the line
+	    stats_prefetch_useful++;
+	    stats_prefetch_late++;
+	}
+	else //compared with the entry's line address, which differs from line_addr in mode 1
+	    m_prefetched[hash_table_entry->get_idx()] = hash_table_entry->get_line_addr();
+	delete request;
+	release_mshr_entry(mshr_entry);
+    }
+    else if(mshr_entry->get_have_data())
     {
         if(manager->process_lower_client_request(request, true)) {
 	    if(my_table->get_entry(request->addr)) {
@@ -335,7 +415,8 @@ void L2_cache::L2_algorithm (hash_entry* mshr_entry, Coh_msg* request)
     }
     else
     {
-        stats_miss++;
+        if(request->type != Coh_msg :: COH_PREFETCH)
+	    stats_miss++;
         get_from_memory(request);
 	mcp_stalled_req[manager->getManagerID()] = request; //necessary for wakeup when response comes back.
     }
@@ -415,11 +496,11 @@ void L2_cache :: m_notify(ManagerInterface* manager)
 	    //my_table->update_lru(req->u.coh.addr);
         }
 
+	hash_entry* mshr_entry = mshr->get_entry(req->addr);
+
 	delete mcp_stalled_req[manager->getManagerID()];
 	mcp_stalled_req[manager->getManagerID()] = 0;
 
-	hash_entry* mshr_entry = mshr->get_entry(req->addr);
-
 	update_hash_entry(mshr_map[mshr_entry->get_idx()], mshr_entry); //write hash_entry back.
 	//mshr_map[mshr_entry->get_idx()] = 0; //cannot do this because the mapping is still used
 					       //inside release_mshr_entry().
@@ -461,8 +542,285 @@ void L2_cache :: m_evict_notify(ManagerInterface* manager)
 
 
 
+
+
+//====================================================================
+// Functional warmup
+//====================================================================
+
+//! Process a request from lower client src in functional mode. The line is allocated
+//! if necessary (data is assumed to come from memory), and the lower clients
+//! the manager would send DEMAND_I, FWD_E or FWD_S to are updated directly.
+//! @return  true if the requestor is granted exclusive permission.
+bool L2_cache :: functional_request(paddr_t addr, int src, bool write)
+{
+    assert(mshr->has_match(addr) == false); //caches must be idle when warmup is enabled.
+
+    hash_entry* hash_table_entry = my_table->get_entry(addr);
+
+    if(hash_table_entry == 0) {
+	hash_table_entry = my_table->reserve_block_for(addr);
+	if(hash_table_entry == 0) {
+	    functional_evict(my_table->get_replacement_entry(addr));
+	    hash_table_entry = my_table->reserve_block_for(addr);
+	    assert(hash_table_entry);
+	}
+	hash_table_entry->set_have_data(true);
+    }
+    //the line has a lower client now, so it can no longer be dropped as an unused prefetch.
+    m_prefetched[hash_table_entry->get_idx()] = NO_LINE;
+
+    ManagerInterface* manager = managers[hash_table_entry->get_idx()];
+    assert(manager->req_pending() == false);
+
+    vector<int> invalidates;
+    int downgrade;
+    bool exclusive = manager->functional_request(src, write, invalidates, downgrade);
+
+    //Invalidated owner passes the data, dirty or not, to the requestor.
+    for(unsigned i=0; i<invalidates.size(); i++)
+	FunctionalWarmup :: Get_l1(invalidates[i])->functional_demand(addr, false);
+
+    if(downgrade != -1) {
+	if(FunctionalWarmup :: Get_l1(downgrade)->functional_demand(addr, true))
+	    hash_table_entry->set_dirty(true); //client writeback
+    }
+
+    return exclusive;
+}
+
+
+//! Lower client src evicts a line in functional mode. If no client holds the line
+//! anymore, the line is dropped, as in timing mode. Dirty data is not written back
+//! since memory is not modeled functionally.
+void L2_cache :: functional_put(paddr_t addr, int src)
+{
+    hash_entry* hash_table_entry = my_table->get_entry(addr);
+    assert(hash_table_entry);
+
+    ManagerInterface* manager = managers[hash_table_entry->get_idx()];
+    if(manager->functional_put(src)) {
+	m_prefetched[hash_table_entry->get_idx()] = NO_LINE;
+	hash_table_entry->invalidate();
+    }
+}
+
+
+void L2_cache :: functional_evict(hash_entry* victim)
+{
+    ManagerInterface* manager = managers[victim->get_idx()];
+    assert(manager->req_pending() == false && mcp_stalled_req[manager->getManagerID()] == 0);
+
+    paddr_t line_addr = victim->get_line_addr();
+
+    vector<int> holders;
+    manager->functional_evict(holders);
+
+    for(unsigned i=0; i<holders.size(); i++)
+	FunctionalWarmup :: Get_l1(holders[i])->functional_demand(line_addr, false);
+
+    m_prefetched[victim->get_idx()] = NO_LINE;
+    victim->invalidate();
+}
+
+
+
+//====================================================================
+// Prefetching
+//====================================================================
+
+//! Train the prefetcher with an L1 request when it arrives. Misses and first uses
+//! of prefetched lines trigger prefetches.
+void L2_cache :: train_prefetcher(Coh_msg* request)
+{
+    paddr_t line_addr = my_table->get_line_addr(request->addr);
+    bool trigger = true;
+
+    hash_entry* hash_table_entry = my_table->get_entry(line_addr);
+    if(hash_table_entry) {
+        trigger = false;
+	if(m_prefetched[hash_table_entry->get_idx()] == hash_table_entry->get_line_addr()) {
+	    m_prefetched[hash_table_entry->get_idx()] = NO_LINE;
+	    stats_prefetch_useful++;
+	    trigger = true;
+#ifdef MCP_CACHE_COUNTERS
+            cache_counter->DL2.prefetch.read += 1;
+#endif
+	}
+    }
+
+    m_prefetcher->train(request->addr, 0, trigger, m_prefetch_candidates);
+}
+
+
+//! Issue the candidates proposed by the prefetcher. Lines that are present, in flight
+//! or wanted by a stalled request are skipped, and so are lines that would stall for
+//! lack of a victim. A prefetch is processed like an L1 request, except that no lower
+//! client is involved.
+void L2_cache :: issue_prefetches()
+{
+    for(unsigned i=0; i<m_prefetch_candidates.size(); i++) {
+        if(mshr->get_occupancy() + m_prefetch_mshr_reserve >= (unsigned)mshr->get_num_entries()) {
+	    stats_prefetch_throttled += m_prefetch_candidates.size() - i;
+	    break;
+	}
+
+        paddr_t line_addr = my_table->get_line_addr(m_prefetch_candidates[i]);
+	if(my_table->has_match(line_addr) || mshr->has_match(line_addr) || stall_buffer_has_match(line_addr) ||
+	   in_prefetch_buffer(line_addr))
+	    continue;
+	if(m_prefetch_buffer_size == 0 && !my_table->can_allocate_for(line_addr)) {
+	    hash_entry* victim = my_table->get_replacement_entry(line_addr);
+	    ManagerInterface* victim_manager = managers[victim->get_idx()];
+	    if(m_prefetched[victim->get_idx()] != victim->get_line_addr() &&
+	       (victim_manager->req_pending() || mcp_stalled_req[victim_manager->getManagerID()] != 0))
+		continue;
+	}
+
+	Coh_msg* req = new Coh_msg;
+	req->type = Coh_msg :: COH_PREFETCH;
+	req->addr = line_addr;
+	req->forward_id = -1;
+	req->msg = -1;
+	req->rw = 0;
+	req->src_id = node_id;
+	req->src_port = 0;
+	req->dst_id = node_id;
+	req->dst_port = 0;
+
+	stats_prefetch_issued++;
+#ifdef MCP_CACHE_COUNTERS
+        cache_counter->DL2.prefetch.search += 1;
+#endif
+	process_client_request(req, true);
+    }
+    m_prefetch_candidates.clear();
+}
+
+
+void L2_cache :: drop_prefetched_line(hash_entry* victim)
+{
+    assert(managers[victim->get_idx()]->req_pending() == false);
+    assert(victim->is_dirty() == false);
+
+    m_prefetched[victim->get_idx()] = NO_LINE;
+    victim->invalidate();
+    stats_prefetch_useless++;
+}
+
+
+bool L2_cache :: in_prefetch_buffer(paddr_t line_addr)
+{
+    for(std::list<paddr_t>::iterator it = m_prefetch_buffer.begin(); it != m_prefetch_buffer.end(); ++it) {
+        if(*it == line_addr)
+	    return true;
+    }
+    return false;
+}
+
+
+//! If the line is in the prefetch buffer, remove it and return true.
+bool L2_cache :: take_from_prefetch_buffer(paddr_t addr)
+{
+    paddr_t line_addr = my_table->get_line_addr(addr);
+    for(std::list<paddr_t>::iterator it = m_prefetch_buffer.begin(); it != m_prefetch_buffer.end(); ++it) {
+        if(*it == line_addr) {
+	    m_prefetch_buffer.erase(it);
+	    stats_prefetch_useful++;
+#ifdef MCP_CACHE_COUNTERS
+            cache_counter->DL2.prefetch.read += 1;
+#endif
+	    return true;
+	}
+    }
+    return false;
+}
+
+
+void L2_cache :: put_in_prefetch_buffer(paddr_t line_addr)
+{
+    assert(m_prefetch_buffer_size > 0);
+
+    if(stall_buffer_has_match(line_addr)) //an L1 request is already waiting for the line
+        stats_prefetch_late++;
+
+    if(m_prefetch_buffer.size() == m_prefetch_buffer_size) {
+        m_prefetch_buffer.pop_front();
+	stats_prefetch_useless++;
+    }
+    m_prefetch_buffer.push_back(line_addr);
+#ifdef MCP_CACHE_COUNTERS
+    cache_counter->DL2.prefetch.write += 1;
+#endif
+}
+
+
+
+//====================================================================
+// sampled simulation
+//====================================================================
+
+//! Functional warmup is global; all caches switch it together.
+void L2_cache :: set_functional(bool functional)
+{
+    if(functional)
+        FunctionalWarmup :: Enable();
+    else
+        FunctionalWarmup :: Disable();
+}
+
+
+//! Drained when the cache could be checkpointed.
+bool L2_cache :: is_drained()
+{
+    return mshr->get_occupancy() == 0 && stalled_client_req_buffer.size() == 0 &&
+           m_downstream_output_buffer.size() == 0;
+}
+
+
+
+//====================================================================
+// checkpoint
+//====================================================================
+
+//! Saves the tag array, LRU order, directory (manager) states and credits. MSHRs
+//! and buffers must be empty.
+void L2_cache :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    assert(mshr->get_occupancy() == 0 && mshr_map.size() == 0);
+    assert(stalled_client_req_buffer.size() == 0);
+    assert(m_downstream_output_buffer.size() == 0);
+
+    out.write(node_id);
+    my_table->checkpoint(out);
+    for(unsigned i=0; i<managers.size(); i++)
+        managers[i]->checkpoint(out);
+    //Unused prefetched lines must be known since they are evicted differently. The
+    //prefetch buffer is not saved.
+    for(unsigned i=0; i<m_prefetched.size(); i++)
+        out.write(m_prefetched[i]);
+    out.write(m_downstream_credits);
+}
+
+
+void L2_cache :: restore(manifold::kernel::CheckpointIn& in)
+{
+    int nid;
+    in.read(nid);
+    assert(nid == node_id);
+    my_table->restore(in);
+    for(unsigned i=0; i<managers.size(); i++)
+        managers[i]->restore(in);
+    for(unsigned i=0; i<m_prefetched.size(); i++)
+        in.read(m_prefetched[i]);
+    in.read(m_downstream_credits);
+}
+
+
+
 void L2_cache::stall (Coh_msg *request, stall_type_t stall_msg)
 {
+    assert(request->type != Coh_msg :: COH_PREFETCH); //prefetches are only issued if they won't stall
     //stalled_client_req_buffer.push_back (std::make_pair (request, stall_msg));
     Stall_buffer_entry e;
     e.req = request;
@@ -498,8 +856,7 @@ void L2_cache::get_from_memory (Coh_msg *request)
     pkt->type = MEM_MSG;
     pkt->src = node_id;
     pkt->dst = req.dst_id;
-    *((Mem_msg*)(pkt->data)) = req;
-    pkt->data_size = sizeof(Mem_msg);
+    pkt->set_data(req);
 
     DBG_L2_CACHE_ID(cerr,  " get from memory node " << req.dst_id << " for 0x" << hex << req.addr << dec << endl);
 
@@ -529,8 +886,7 @@ void L2_cache::dirty_to_memory (paddr_t addr)
     pkt->type = MEM_MSG;
     pkt->src = node_id;
     pkt->dst = req.dst_id;
-    *((Mem_msg*)(pkt->data)) = req;
-    pkt->data_size = sizeof(Mem_msg);
+    pkt->set_data(req);
 
     Clock* clk = m_clk;
     if(m_clk == 0)
@@ -556,8 +912,7 @@ void L2_cache :: send_msg_to_l1(Coh_msg* msg)
     pkt->type = COH_MSG;
     pkt->src = node_id;
     pkt->dst = msg->dst_id;
-    *((Coh_msg*)(pkt->data)) = *msg;
-    pkt->data_size = sizeof(Coh_msg);
+    pkt->set_data(*msg);
 
     DBG_L2_CACHE_ID(cerr,  " sending msg= " << msg->msg << " to L1 node= " << msg->dst_id << " fwd= " << msg->forward_id << endl);
 
@@ -609,8 +964,7 @@ void L2_cache :: send_credit_downstream()
 {
     DBG_L2_CACHE_ID(cerr, " sending credit.\n");
 
-    NetworkPacket* pkt = new NetworkPacket;
-    pkt->type = CREDIT_MSG;
+    NetworkPacket* pkt = NetworkPacket::Create_credit(CREDIT_MSG);
     Send(PORT_L1, pkt);
 }
 
@@ -750,6 +1104,17 @@ void L2_cache :: print_stats(std::ostream& out)
 	    << "    hash table avg occupancy = " << avg_occup << " (" << avg_occup / (my_table->get_size() / my_table->get_block_size()) * 100 << "%)" << endl
 	    << "    hash table empty cycles= " << stats_table_empty_cycles << endl;
     }
+    if(m_prefetcher) {
+        out << "    Prefetcher = " << m_prefetcher->get_name();
+	if(m_prefetch_buffer_size > 0)
+	    out << " (prefetch buffer of " << m_prefetch_buffer_size << " lines)";
+	out << endl
+	    << "    Prefetches issued= " << stats_prefetch_issued << " useful= " << stats_prefetch_useful
+	    << " (late= " << stats_prefetch_late << ") useless= " << stats_prefetch_useless
+	    << " throttled= " << stats_prefetch_throttled << endl
+	    << "    Prefetch accuracy= " << (stats_prefetch_issued ? (double)stats_prefetch_useful / stats_prefetch_issued : 0)
+	    << " coverage= " << (stats_miss + stats_prefetch_useful ? (double)stats_prefetch_useful / (stats_miss + stats_prefetch_useful) : 0) << endl;
+    }
 }
 
 
@@ -5,6 +5,7 @@
 #include "cache_types.h"
 #include "coherence/ManagerInterface.h"
 #include "kernel/component.h"
+#include "kernel/sampler.h"
 #include "hash_table.h"
 #include "MemoryControllerMap.h"
 #include "coh_mem_req.h"
@@ -12,6 +13,8 @@
 #include "uarch/DestMap.h"
 
 #include "cache-counters.h"
+#include "functional_warmup.h"
+#include "prefetcher.h"
 
 using namespace std;
 
@@ -24,11 +27,12 @@ public:
     manifold::uarch::DestMap* mc_map;
     unsigned mshr_sz; //mshr size
     int downstream_credits;
+    prefetch_settings prefetch; //no prefetching by default
 };
 
 
 
-class L2_cache : public manifold::kernel::Component {
+class L2_cache : public manifold::kernel::Component, public manifold::kernel::Sampled {
 public:
     enum {PORT_L1=0};
 
@@ -55,6 +59,20 @@ public:
 
     hash_entry* get_hash_entry_by_idx(unsigned idx) { return hash_entries[idx]; }
 
+    //functional warmup
+    bool functional_request(paddr_t addr, int src, bool write);
+    void functional_put(paddr_t addr, int src);
+
+    //sampled simulation; the functional mode is functional warmup.
+    void set_functional(bool functional);
+    bool is_drained();
+    //the Sampler discards the stats counted during warmup through this engine.
+    Cache_stat_engine* get_stat_engine() { return &m_stat_engine; }
+
+    //checkpoint; the cache must be idle, i.e., MSHRs and buffers are empty.
+    void checkpoint(manifold::kernel::CheckpointOut&);
+    void restore(manifold::kernel::CheckpointIn&);
+
     void print_stats(std::ostream&);
 
     static void Set_msg_types(int coh, int mem, int credit)
@@ -84,6 +102,16 @@ private:
 
     void release_mshr_entry(hash_entry* mshr_entry);
 
+    void functional_evict(hash_entry* victim);
+
+    //prefetching
+    void train_prefetcher(Coh_msg* request);
+    void issue_prefetches();
+    void drop_prefetched_line(hash_entry* victim);
+    bool in_prefetch_buffer(paddr_t line_addr);
+    bool take_from_prefetch_buffer(paddr_t addr);
+    void put_in_prefetch_buffer(paddr_t line_addr);
+
     //debug
     void print_mshr();
     void print_stall_buffer();
@@ -139,6 +167,19 @@ protected:
     std::list<manifold::kernel::Ticks_t> m_credit_out_ticks;
     std::list<manifold::kernel::Ticks_t> m_msg_out_ticks;
 
+    //prefetching
+    //A prefetched line is either put in the cache, where it has no lower client (manager in
+    //I state) until an L1 asks for it, or in the prefetch buffer if buffer_size > 0. Lines
+    //in the buffer are clean and not cached by any L1, so the buffer needs no coherence.
+    Prefetcher* m_prefetcher; //0 if prefetching is off
+    int m_prefetch_mshr_reserve;
+    std::vector<paddr_t> m_prefetch_candidates; //lines proposed by the prefetcher for this request
+    static const paddr_t NO_LINE = 1; //never a line address
+    std::vector<paddr_t> m_prefetched; //for each hash entry, its get_line_addr() if it was brought in by a
+                                       //prefetch and hasn't been used yet; NO_LINE otherwise
+    unsigned m_prefetch_buffer_size;
+    std::list<paddr_t> m_prefetch_buffer; //in FIFO order
+
     //stats
     unsigned long stats_cycles;
     unsigned stats_num_reqs; //number of L1 requests
@@ -152,6 +193,12 @@ protected:
     unsigned stats_table_empty_cycles;
     unsigned long stats_mshr_occupancy; //accumulated mshr occupancy
     unsigned stats_mshr_empty_cycles;
+    unsigned stats_prefetch_issued;
+    unsigned stats_prefetch_useful; //prefetched lines requested by an L1
+    unsigned stats_prefetch_late; //prefetches still in flight when an L1 requested the line
+    unsigned stats_prefetch_useless; //prefetched lines evicted without being used
+    unsigned stats_prefetch_throttled; //candidates dropped because too few MSHRs were free
+    Cache_stat_engine m_stat_engine; //all of the above
 };
 
 
@@ -170,11 +217,14 @@ void L2_cache :: handle_incoming (int, manifold::uarch::NetworkPacket* pkt)
     if(pkt->type == COH_MSG) {
         Coh_msg* coh = new Coh_msg;
 	*coh = *((Coh_msg*)pkt->data);
+#ifdef MCP_CACHE_COUNTERS
+	const int rw = coh->rw; //coh may be deleted by process_incoming_coh()
+#endif
 	process_incoming_coh(coh);
 #ifdef MCP_CACHE_COUNTERS
         cache_counter->DL2.read_tag += 1;
         cache_counter->DL2.search += 1;
-        if (coh->rw == 1) { //write
+        if (rw == 1) { //write
             cache_counter->DL2.write_tag += 1;
             cache_counter->DL2.write += 1;
         } else
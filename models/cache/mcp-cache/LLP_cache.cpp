@@ -101,8 +101,7 @@ void LLP_cache :: send_msg_to_peer_or_l2(Coh_msg* msg)
 	pkt->src_port = msg->src_port;
 	pkt->dst = msg->dst_id;
 	pkt->dst_port = msg->dst_port;
-	*((Coh_msg*)(pkt->data)) = *msg;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*msg);
 	delete msg;
 
 	assert(my_table->get_lookup_time() > 0);
@@ -79,8 +79,7 @@ void LLS_cache :: send_msg_to_l1(Coh_msg* msg)
 	pkt->src_port = LLP_cache :: LLS_ID;
 	pkt->dst = msg->dst_id;
 	pkt->dst_port = msg->dst_port;
-	*((Coh_msg*)(pkt->data)) = *msg;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*msg);
 	delete msg;
 
 	manifold::kernel::Manifold::ScheduleClock(my_table->get_lookup_time(), *m_clk, &LLS_cache::add_to_output_buffer, this, pkt);
@@ -110,8 +109,7 @@ void LLS_cache::get_from_memory (Coh_msg *request)
     pkt->dst = req.dst_id;
     pkt->dst_port = 0;
 
-    *((Mem_msg*)(pkt->data)) = req;
-    pkt->data_size = sizeof(Mem_msg);
+    pkt->set_data(req);
 
     manifold::kernel::Manifold::ScheduleClock(my_table->get_lookup_time(), *m_clk, &LLS_cache::add_to_output_buffer, this, pkt);
     #ifdef FORECAST_NULL
@@ -140,8 +138,7 @@ void LLS_cache::dirty_to_memory (paddr_t addr)
     pkt->dst = req.dst_id;
     pkt->dst_port = 0;
 
-    *((Mem_msg*)(pkt->data)) = req;
-    pkt->data_size = sizeof(Coh_msg);
+    pkt->set_data(req);
 
 
     manifold::kernel::Manifold::ScheduleClock(my_table->get_lookup_time(), *m_clk, &LLS_cache::add_to_output_buffer, this, pkt);
@@ -42,7 +42,8 @@ class cache_req {
    public:
       paddr_t addr;
       mem_optype_t op_type; 
-      PreqWrapperBase* preqWrapper; //wrapper of processor request.
+      PreqWrapperBase* preqWrapper; //wrapper of processor request; 0 for a prefetch made by the cache.
+      paddr_t pc; //PC of the instruction; 0 if unknown.
 
       cache_req();  //for deserialization
 };
@@ -34,7 +34,7 @@ struct Mem_msg {
 
 //! directory-based coherence protocol message
 struct Coh_msg {
-    enum {COH_REQ, COH_RPLY};
+    enum {COH_REQ, COH_RPLY, COH_PREFETCH}; //COH_PREFETCH is made by an L2 for itself and never sent.
 
     char type;
     paddr_t addr;
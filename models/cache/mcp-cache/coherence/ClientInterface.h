@@ -2,6 +2,7 @@
 #define CLIENTINTERFACE_H
 
 #include <stdint.h>
+#include "kernel/checkpoint.h"
 
 
 namespace manifold {
@@ -60,6 +61,22 @@ class ClientInterface
         /** Called by the Manager to complete preivous SupplyInvalidate demand.  Supplies data packet and signifies realm invalidation has completed */
         virtual void SupplyInvalidateAck() = 0;
 
+        //Functional warmup. The following change the client state directly without sending messages.
+        /** Processor access in functional mode. Returns true if the access can be completed with the current permissions. */
+        virtual bool functional_access(bool write) = 0;
+        /** Called after the manager has granted the line in functional mode; exclusive is true if the client is the only holder. */
+        virtual void functional_fill(bool write, bool exclusive) = 0;
+        /** Evicts the line in functional mode. Returns true if the manager must be notified. */
+        virtual bool functional_evict() = 0;
+        /** Manager demands invalidation in functional mode. Returns true if the client had dirty data. */
+        virtual bool functional_invalidate() = 0;
+        /** Manager demands downgrade to read-only in functional mode. Returns true if the client had dirty data. */
+        virtual bool functional_downgrade() = 0;
+
+        /** Saves the client state; the client must be in a stable state. */
+        virtual void checkpoint(manifold::kernel::CheckpointOut&) = 0;
+        virtual void restore(manifold::kernel::CheckpointIn&) = 0;
+
 
     protected:
         /** ID of the client */
@@ -202,6 +202,102 @@ bool MESI_client :: req_pending()
 
 
 
+
+//====================================================================
+// Functional warmup. The transitions below are the ones the client
+// makes in timing mode once all messages of a transaction have been
+// exchanged, without any race conditions.
+//====================================================================
+
+//! @return  true if the access can be completed without the manager.
+bool MESI_client :: functional_access(bool write)
+{
+    switch(state) {
+        case MESI_C_I:
+	    return false;
+        case MESI_C_S:
+	    return !write; //a store requires an upgrade.
+        case MESI_C_E:
+	    if(write)
+	        transition_to_m();
+	    return true;
+        case MESI_C_M:
+	    return true;
+	default:
+	    invalid_state();
+	    assert(0);
+	    return false;
+    }
+}
+
+
+//! @param \c exclusive  True if manager grants the line exclusively (GRANT_E_DATA, CC_E_DATA or CC_M_DATA).
+void MESI_client :: functional_fill(bool write, bool exclusive)
+{
+    if(exclusive) {
+	if(write)
+	    transition_to_m(); //a store in E goes to M.
+	else
+	    transition_to_e();
+    }
+    else {
+        assert(!write);
+	transition_to_s();
+    }
+}
+
+
+//! @return  true if the manager must be notified. Lines in S are evicted silently.
+bool MESI_client :: functional_evict()
+{
+    assert(req_pending() == false);
+    bool notify = (state == MESI_C_E || state == MESI_C_M);
+    if(state != MESI_C_I)
+	transition_to_i();
+    return notify;
+}
+
+
+//! Processes DEMAND_I or FWD_E in functional mode.
+//! @return  true if the line is dirty.
+bool MESI_client :: functional_invalidate()
+{
+    assert(req_pending() == false);
+    bool dirty = (state == MESI_C_M);
+    if(state != MESI_C_I)
+	transition_to_i();
+    return dirty;
+}
+
+
+//! Processes FWD_S in functional mode.
+//! @return  true if the line is dirty, i.e., the client would send a WRITEBACK.
+bool MESI_client :: functional_downgrade()
+{
+    assert(state == MESI_C_E || state == MESI_C_M);
+    bool dirty = (state == MESI_C_M);
+    transition_to_s();
+    return dirty;
+}
+
+
+//! Only stable states can be saved; transient states imply messages in flight.
+void MESI_client :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    assert(state == MESI_C_I || state == MESI_C_S || state == MESI_C_E || state == MESI_C_M);
+    out.write(state);
+}
+
+
+void MESI_client :: restore(manifold::kernel::CheckpointIn& in)
+{
+    in.read(state);
+    assert(state == MESI_C_I || state == MESI_C_S || state == MESI_C_E || state == MESI_C_M);
+}
+
+
+
+
 //! @param \c fwdID  The ID of the client to forward msg to. If no forward, can be any value.
 void MESI_client::process(int msg, int fwdID)
 {
@@ -45,6 +45,16 @@ class MESI_client : public ClientInterface
         /** Called by the Manager to complete previous SupplyInvalidate demand.  Supplies data packet and signifies realm invalidation has completed */
         void SupplyInvalidateAck();
 
+        //functional warmup
+        bool functional_access(bool write);
+        void functional_fill(bool write, bool exclusive);
+        bool functional_evict();
+        bool functional_invalidate();
+        bool functional_downgrade();
+
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
 
     protected:
 	//! @param \c req  Whether it's an initial request or a reply.
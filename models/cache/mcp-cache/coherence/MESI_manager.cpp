@@ -95,6 +95,134 @@ bool MESI_manager :: req_pending()
 
 
 
+//====================================================================
+// Functional warmup. The transitions below are the ones the manager
+// makes in timing mode once all messages of a transaction have been
+// exchanged, without any race conditions.
+//====================================================================
+
+//! @param \c src  The requesting client.
+//! @param \c write  True for a store (I_to_E); false for a load (I_to_S).
+//! @param \c invalidates  Clients that must be invalidated (DEMAND_I or FWD_E).
+//! @param \c downgrade  Client that must be downgraded (FWD_S); -1 if none.
+//! @return  true if the requestor is granted exclusive permission.
+bool MESI_manager :: functional_request(int src, bool write, std::vector<int>& invalidates, int& downgrade)
+{
+    downgrade = -1;
+
+    switch(state) {
+        case MESI_MNG_I: //both I_to_E and I_to_S get GRANT_E_DATA
+	    owner = src;
+	    transition_to_e();
+	    return true;
+        case MESI_MNG_E:
+            assert(owner != -1);
+	    assert(owner != src);
+	    if(write) { //FWD_E; owner passes the data to the requestor.
+	        invalidates.push_back(owner);
+		owner = src;
+		return true;
+	    }
+	    else { //FWD_S
+		downgrade = owner;
+		sharersList.set(owner);
+		sharersList.set(src);
+		owner = -1;
+		transition_to_s();
+		return false;
+	    }
+        case MESI_MNG_S:
+	    if(write) {
+		sharersList.reset(src); //don't invalidate requestor if it's a sharer.
+		sharersList.ones(invalidates);
+		sharersList.clear();
+		owner = src;
+		transition_to_e();
+		return true;
+	    }
+	    else {
+		sharersList.set(src);
+		return false;
+	    }
+	default:
+	    printf("Invalid state %d for functional request\n", state);
+	    assert(0);
+	    return false;
+    }
+}
+
+
+//! @return  true if no client holds the line anymore. The manager's owner is
+//! responsible for dropping the line; invalidate() is not called.
+bool MESI_manager :: functional_put(int src)
+{
+    if(state == MESI_MNG_E && owner == src) {
+        owner = -1;
+	state = MESI_MNG_I;
+	return true;
+    }
+    //A stale sharer; the manager is not notified of evictions in S.
+    return false;
+}
+
+
+//! All holders of the line are returned in holders. The manager's owner is
+//! responsible for invalidating the holders and dropping the line; invalidate()
+//! is not called.
+void MESI_manager :: functional_evict(std::vector<int>& holders)
+{
+    switch(state) {
+        case MESI_MNG_I:
+	    break;
+        case MESI_MNG_E:
+	    holders.push_back(owner);
+	    break;
+        case MESI_MNG_S:
+	    sharersList.ones(holders);
+	    break;
+	default:
+	    printf("Invalid state %d for functional eviction\n", state);
+	    assert(0);
+	    break;
+    }
+    owner = -1;
+    sharersList.clear();
+    state = MESI_MNG_I;
+}
+
+
+//! Only stable states can be saved; transient states imply messages in flight.
+void MESI_manager :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    assert(state == MESI_MNG_I || state == MESI_MNG_E || state == MESI_MNG_S);
+    out.write(state);
+    out.write(owner);
+    std::vector<int> ones;
+    if(state == MESI_MNG_S)
+        sharersList.ones(ones);
+    out.write((int)ones.size());
+    for(size_t i=0; i<ones.size(); i++)
+        out.write(ones[i]);
+}
+
+
+void MESI_manager :: restore(manifold::kernel::CheckpointIn& in)
+{
+    in.read(state);
+    assert(state == MESI_MNG_I || state == MESI_MNG_E || state == MESI_MNG_S);
+    in.read(owner);
+    sharersList.clear();
+    int n;
+    in.read(n);
+    for(int i=0; i<n; i++) {
+        int sharer;
+	in.read(sharer);
+	sharersList.set(sharer);
+    }
+}
+
+
+
 
 void MESI_manager :: process(int msg_type, int src_id)
 {
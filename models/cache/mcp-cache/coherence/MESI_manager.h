@@ -43,6 +43,14 @@ class MESI_manager : public ManagerInterface
 
 	bool IsRequestComplete();
 
+        //functional warmup
+        bool functional_request(int src, bool write, std::vector<int>& invalidates, int& downgrade);
+        bool functional_put(int src);
+        void functional_evict(std::vector<int>& holders);
+
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
 
 #ifndef MCP_CACHE_UTEST
     protected:
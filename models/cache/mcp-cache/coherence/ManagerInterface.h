@@ -2,6 +2,8 @@
 #define MANAGERINTERFACE_H
 
 #include <stdint.h>
+#include <vector>
+#include "kernel/checkpoint.h"
 
 
 namespace manifold {
@@ -49,6 +51,21 @@ class ManagerInterface
         /** Called from the client to complete previous GetEvict request. Supplies data packet and signifies paired client is now invalid */
         virtual void GrantEvict() = 0;
 
+        //Functional warmup. The following change the manager state directly without sending messages.
+        /** Lower client src requests the line in functional mode. The clients that must be invalidated are
+	    added to invalidates, and downgrade is set to the client that must be downgraded (-1 if none).
+	    Returns true if the requestor is granted exclusive permission. */
+        virtual bool functional_request(int src, bool write, std::vector<int>& invalidates, int& downgrade) = 0;
+        /** Lower client src evicts the line in functional mode. Returns true if no client holds the line anymore,
+	    in which case the line can be dropped. */
+        virtual bool functional_put(int src) = 0;
+        /** Evicts the line in functional mode; the lower clients holding the line are added to holders. */
+        virtual void functional_evict(std::vector<int>& holders) = 0;
+
+        /** Saves the manager state; the manager must be in a stable state. */
+        virtual void checkpoint(manifold::kernel::CheckpointOut&) = 0;
+        virtual void restore(manifold::kernel::CheckpointIn&) = 0;
+
 
     protected:
         int id;
@@ -0,0 +1,99 @@
+#include "functional_warmup.h"
+
+#include <assert.h>
+#include <iostream>
+
+using namespace std;
+
+namespace manifold {
+namespace mcp_cache_namespace {
+
+
+bool FunctionalWarmup :: s_enabled = false;
+map<int, L1_cache*> FunctionalWarmup :: s_l1s;
+map<int, L2_cache*> FunctionalWarmup :: s_l2s;
+
+
+void FunctionalWarmup :: Register_l1(int node_id, L1_cache* l1)
+{
+    s_l1s[node_id] = l1;
+}
+
+void FunctionalWarmup :: Register_l2(int node_id, L2_cache* l2)
+{
+    s_l2s[node_id] = l2;
+}
+
+//! A cache is only removed if it is the one registered for the node; this allows
+//! multiple caches with the same node id to be created and destroyed, as in unit tests.
+void FunctionalWarmup :: Unregister_l1(int node_id, L1_cache* l1)
+{
+    map<int, L1_cache*>::iterator it = s_l1s.find(node_id);
+    if(it != s_l1s.end() && (*it).second == l1)
+        s_l1s.erase(it);
+}
+
+void FunctionalWarmup :: Unregister_l2(int node_id, L2_cache* l2)
+{
+    map<int, L2_cache*>::iterator it = s_l2s.find(node_id);
+    if(it != s_l2s.end() && (*it).second == l2)
+        s_l2s.erase(it);
+}
+
+
+L1_cache* FunctionalWarmup :: Get_l1(int node_id)
+{
+    map<int, L1_cache*>::iterator it = s_l1s.find(node_id);
+    if(it == s_l1s.end()) {
+        cerr << "Functional warmup: L1 cache of node " << node_id << " not found; all caches must be in the same LP." << endl;
+	assert(0);
+    }
+    return (*it).second;
+}
+
+L2_cache* FunctionalWarmup :: Get_l2(int node_id)
+{
+    map<int, L2_cache*>::iterator it = s_l2s.find(node_id);
+    if(it == s_l2s.end()) {
+        cerr << "Functional warmup: L2 cache of node " << node_id << " not found; all caches must be in the same LP." << endl;
+	assert(0);
+    }
+    return (*it).second;
+}
+
+
+void Cache_stat_engine :: clear_stats()
+{
+    for(unsigned i=0; i<m_counters.size(); i++)
+        *m_counters[i] = 0;
+    for(unsigned i=0; i<m_long_counters.size(); i++)
+        *m_long_counters[i] = 0;
+}
+
+void Cache_stat_engine :: start_warmup()
+{
+    in_warmup = true;
+    m_warmup_counters.resize(m_counters.size());
+    for(unsigned i=0; i<m_counters.size(); i++)
+        m_warmup_counters[i] = *m_counters[i];
+    m_warmup_long_counters.resize(m_long_counters.size());
+    for(unsigned i=0; i<m_long_counters.size(); i++)
+        m_warmup_long_counters[i] = *m_long_counters[i];
+}
+
+//! Accesses made during the warmup are not counted.
+void Cache_stat_engine :: end_warmup()
+{
+    if(!in_warmup)
+        return;
+    in_warmup = false;
+    for(unsigned i=0; i<m_counters.size(); i++)
+        *m_counters[i] = m_warmup_counters[i];
+    for(unsigned i=0; i<m_long_counters.size(); i++)
+        *m_long_counters[i] = m_warmup_long_counters[i];
+}
+
+
+} //namespace mcp_cache_namespace
+} //namespace manifold
+
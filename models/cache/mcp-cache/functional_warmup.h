@@ -0,0 +1,86 @@
+#ifndef MANIFOLD_MCP_CACHE_FUNCTIONAL_WARMUP_H
+#define MANIFOLD_MCP_CACHE_FUNCTIONAL_WARMUP_H
+
+#include <map>
+#include <vector>
+#include "kernel/stat_engine.h"
+
+namespace manifold {
+namespace mcp_cache_namespace {
+
+class L1_cache;
+class L2_cache;
+
+
+//! Functional warmup support.
+//!
+//! When functional warmup is enabled, processor requests arriving at an L1 (or LLP) cache
+//! update the tag arrays, LRU order and the client/manager coherence state of all caches
+//! directly, by calling into the L2 (or LLS) cache that is the home of the line. No network
+//! messages or credits are sent, and no MSHRs are used. Since coherence state never leaves
+//! the stable states in functional mode, warmup can be turned off at any time and detailed
+//! simulation continues with the warmed-up state.
+//!
+//! Since the home cache is called directly, all caches must be in the same LP. Caches
+//! register themselves when they are created.
+//!
+//! Functional warmup should only be enabled when the caches are idle, i.e., there are no
+//! outstanding requests in the MSHRs.
+class FunctionalWarmup {
+public:
+    static void Enable() { s_enabled = true; }
+    static void Disable() { s_enabled = false; }
+    static bool Is_enabled() { return s_enabled; }
+
+    static void Register_l1(int node_id, L1_cache* l1);
+    static void Register_l2(int node_id, L2_cache* l2);
+    static void Unregister_l1(int node_id, L1_cache* l1);
+    static void Unregister_l2(int node_id, L2_cache* l2);
+
+    //! Returns the L1 cache of the given node.
+    static L1_cache* Get_l1(int node_id);
+    //! Returns the L2 cache of the given node.
+    static L2_cache* Get_l2(int node_id);
+
+private:
+    static bool s_enabled;
+    static std::map<int, L1_cache*> s_l1s;
+    static std::map<int, L2_cache*> s_l2s;
+};
+
+
+//! Stat engine of a cache in sampled simulation.
+//!
+//! The counters of L1_cache and L2_cache are plain members. The cache registers them
+//! here, and the ones counted between start_warmup() and end_warmup(), i.e., in functional
+//! and detailed warmup, are discarded, so print_stats() only reports the samples.
+class Cache_stat_engine : public manifold::kernel::Stat_engine {
+public:
+    Cache_stat_engine() : in_warmup(false) {}
+
+    void add(unsigned* counter) { m_counters.push_back(counter); }
+    void add(unsigned long* counter) { m_long_counters.push_back(counter); }
+
+    void global_stat_merge(manifold::kernel::Stat_engine*) {}
+    void print_stats(std::ostream&) {} //the cache prints its own stats
+    void clear_stats();
+
+    void start_warmup();
+    void end_warmup();
+    void save_samples() {}
+
+private:
+    std::vector<unsigned*> m_counters;
+    std::vector<unsigned long*> m_long_counters;
+
+    //values of the counters when the warmup started; restored when it ends.
+    bool in_warmup;
+    std::vector<unsigned> m_warmup_counters;
+    std::vector<unsigned long> m_warmup_long_counters;
+};
+
+
+} //namespace mcp_cache_namespace
+} //namespace manifold
+
+#endif //MANIFOLD_MCP_CACHE_FUNCTIONAL_WARMUP_H
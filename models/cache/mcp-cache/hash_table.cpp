@@ -2,6 +2,7 @@
 #include <iostream>
 #include <math.h>
 #include <string.h>
+#include <stdlib.h>
 
 #include "hash_table.h"
 
@@ -310,7 +311,6 @@ bool hash_table::has_match(paddr_t addr)
 }
 
 
-#if 0
 bool hash_table::can_allocate_for (paddr_t addr)
 {
     hash_set *hs = my_sets[get_index (addr)];
@@ -327,7 +327,6 @@ bool hash_table::can_allocate_for (paddr_t addr)
 
     return false;
 }
-#endif
 
 
 
@@ -381,3 +380,70 @@ void hash_table :: update_lru(paddr_t addr)
 }
 
 
+//! hash_set: checkpoint
+//!
+//! Entries are saved in LRU order, MRU first.
+void hash_set :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    for(list<hash_entry *>::iterator it = set_entries.begin(); it != set_entries.end(); ++it)
+    {
+        out.write((*it)->idx);
+        out.write((*it)->tag);
+        out.write((*it)->free);
+        out.write((*it)->have_data);
+        out.write((*it)->dirty);
+    }
+}
+
+
+void hash_set :: restore(manifold::kernel::CheckpointIn& in)
+{
+    list<hash_entry *> entries;
+    entries.swap(set_entries);
+
+    for(int i=0; i<assoc; i++) {
+        unsigned idx;
+	in.read(idx);
+
+	list<hash_entry *>::iterator it = entries.begin();
+	while(it != entries.end() && (*it)->idx != idx)
+	    ++it;
+	assert(it != entries.end());
+
+	hash_entry* entry = *it;
+	entries.erase(it);
+	in.read(entry->tag);
+	in.read(entry->free);
+	in.read(entry->have_data);
+	in.read(entry->dirty);
+	set_entries.push_back(entry);
+    }
+}
+
+
+void hash_table :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    out.begin_section("hash_table");
+    out.write(sets);
+    out.write(assoc);
+    out.write(occupancy);
+    for(map<paddr_t, hash_set*>::iterator it=my_sets.begin(); it != my_sets.end(); ++it)
+        (*it).second->checkpoint(out);
+}
+
+
+void hash_table :: restore(manifold::kernel::CheckpointIn& in)
+{
+    in.expect_section("hash_table");
+    int n_sets, n_assoc;
+    in.read(n_sets);
+    in.read(n_assoc);
+    if(n_sets != sets || n_assoc != assoc) {
+        cerr << "Checkpoint: hash table has " << n_sets << " sets of " << n_assoc
+	     << " entries; expecting " << sets << " sets of " << assoc << " entries." << endl;
+	exit(1);
+    }
+    in.read(occupancy);
+    for(map<paddr_t, hash_set*>::iterator it=my_sets.begin(); it != my_sets.end(); ++it)
+        (*it).second->restore(in);
+}
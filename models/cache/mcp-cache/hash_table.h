@@ -7,6 +7,7 @@
 #include <assert.h>
 
 #include "cache_req.h"
+#include "kernel/checkpoint.h"
 
 #include <iostream>
 
@@ -67,6 +68,9 @@ class hash_set {
       hash_table* get_table() { return my_table; }
       unsigned get_index() { return index; }
 
+      void checkpoint(manifold::kernel::CheckpointOut&);
+      void restore(manifold::kernel::CheckpointIn&);
+
       //debug
       void dbg_print(std::ostream&);
 
@@ -123,6 +127,10 @@ class hash_table {
 
       void update_lru (paddr_t addr);
 
+      //! Save/restore tags, valid and dirty bits and LRU order of all entries.
+      void checkpoint(manifold::kernel::CheckpointOut&);
+      void restore(manifold::kernel::CheckpointIn&);
+
       unsigned get_occupancy() { return occupancy; }
       void increase_occupancy() { occupancy++; }
       void decrease_occupancy()
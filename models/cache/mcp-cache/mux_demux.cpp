@@ -47,8 +47,7 @@ cerr.flush();
 
 void MuxDemux :: send_credit_downstream()
 {
-    NetworkPacket* pkt = new NetworkPacket;
-    pkt->type = CREDIT_MSG_TYPE;
+    NetworkPacket* pkt = NetworkPacket::Create_credit(CREDIT_MSG_TYPE);
     Send(PORT_NET, pkt);
 //cout << "OOOOOOOOOOOOOOOOOOOOOOOOOO, @ " << m_clk.NowTicks() << " mux send credit\n";
 //cout.flush();
@@ -0,0 +1,201 @@
+#include "prefetcher.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+using namespace std;
+
+namespace manifold {
+namespace mcp_cache_namespace {
+
+
+Prefetcher* Prefetcher :: Create(int block_size, const prefetch_settings& settings)
+{
+    assert(settings.degree > 0 && settings.mshr_reserve >= 0 && settings.buffer_size >= 0);
+
+    switch(settings.type) {
+        case PREFETCH_NONE:
+	    return 0;
+        case PREFETCH_NEXT_LINE:
+	    return new Next_line_prefetcher(block_size, settings);
+        case PREFETCH_STRIDE:
+	    return new Stride_prefetcher(block_size, settings);
+        case PREFETCH_STREAM:
+	    return new Stream_prefetcher(block_size, settings);
+	default:
+	    assert(0);
+	    return 0;
+    }
+}
+
+
+prefetcher_type_t Prefetcher :: Parse_type(const char* name)
+{
+    if(strcmp(name, "none") == 0)
+        return PREFETCH_NONE;
+    else if(strcmp(name, "next_line") == 0)
+        return PREFETCH_NEXT_LINE;
+    else if(strcmp(name, "stride") == 0)
+        return PREFETCH_STRIDE;
+    else if(strcmp(name, "stream") == 0)
+        return PREFETCH_STREAM;
+
+    cerr << "Unknown prefetcher " << name << "; must be none, next_line, stride or stream." << endl;
+    exit(1);
+}
+
+
+
+//====================================================================
+// next line
+//====================================================================
+void Next_line_prefetcher :: train(paddr_t addr, paddr_t pc, bool trigger, vector<paddr_t>& candidates)
+{
+    if(!trigger)
+        return;
+
+    paddr_t line = get_line(addr);
+    for(int i=1; i<=m_settings.degree; i++)
+        candidates.push_back((line + i) * m_block_size);
+}
+
+
+
+//====================================================================
+// stride
+//====================================================================
+Stride_prefetcher :: Stride_prefetcher(int block_size, const prefetch_settings& settings) :
+    Prefetcher(block_size, settings)
+{
+    assert(settings.table_size > 0);
+    m_table.resize(settings.table_size);
+}
+
+
+//! The table is trained by all accesses, not only by triggers, since a strided
+//! instruction usually hits in most of the lines it touches.
+void Stride_prefetcher :: train(paddr_t addr, paddr_t pc, bool trigger, vector<paddr_t>& candidates)
+{
+    paddr_t key = (pc != 0) ? pc : (addr >> 12);
+    Entry& e = m_table[key % m_table.size()];
+
+    if(!e.valid || e.tag != key) {
+        e.valid = true;
+	e.tag = key;
+	e.last_addr = addr;
+	e.stride = 0;
+	e.confidence = 0;
+	return;
+    }
+
+    int64_t stride = (int64_t)(addr - e.last_addr);
+    if(stride == 0)
+        return;
+
+    if(stride == e.stride) {
+        if(e.confidence < CONF_MAX)
+	    e.confidence++;
+    }
+    else {
+        if(e.confidence > 0)
+	    e.confidence--;
+	if(e.confidence == 0)
+	    e.stride = stride;
+    }
+    e.last_addr = addr;
+
+    if(e.confidence < CONF_THRESHOLD)
+        return;
+
+    paddr_t line = get_line(addr);
+    paddr_t last = line;
+    for(int i=1; i<=m_settings.degree; i++) {
+        paddr_t l = get_line(addr + e.stride * i);
+	if(l != last && l != line) //strides smaller than a line give the same line more than once
+	    candidates.push_back(l * m_block_size);
+	last = l;
+    }
+}
+
+
+
+//====================================================================
+// stream
+//====================================================================
+Stream_prefetcher :: Stream_prefetcher(int block_size, const prefetch_settings& settings) :
+    Prefetcher(block_size, settings), m_time(0)
+{
+    assert(settings.table_size > 0 && settings.distance > 0);
+    m_trackers.resize(settings.table_size);
+}
+
+
+void Stream_prefetcher :: train(paddr_t addr, paddr_t pc, bool trigger, vector<paddr_t>& candidates)
+{
+    if(!trigger)
+        return;
+
+    m_time++;
+    paddr_t line = get_line(addr);
+
+    Tracker* t = 0;
+    for(unsigned i=0; i<m_trackers.size(); i++) {
+        if(m_trackers[i].valid) {
+	    int64_t d = (int64_t)(line - m_trackers[i].last_line);
+	    if(d <= m_settings.distance && d >= -m_settings.distance) {
+	        t = &m_trackers[i];
+		break;
+	    }
+	}
+    }
+
+    if(t == 0) { //start a new stream in the least recently used tracker
+        t = &m_trackers[0];
+	for(unsigned i=1; i<m_trackers.size() && t->valid; i++) {
+	    if(!m_trackers[i].valid || m_trackers[i].lru < t->lru)
+	        t = &m_trackers[i];
+	}
+	t->valid = true;
+	t->last_line = line;
+	t->next_line = line;
+	t->dir = 0;
+	t->confidence = 0;
+	t->lru = m_time;
+	return;
+    }
+
+    if(line == t->last_line)
+        return;
+
+    int dir = (line > t->last_line) ? 1 : -1;
+    if(dir == t->dir)
+        t->confidence++;
+    else {
+        t->dir = dir;
+	t->confidence = 1;
+    }
+    t->last_line = line;
+    t->lru = m_time;
+
+    if(t->confidence < CONF_THRESHOLD)
+        return;
+
+    if((int64_t)(t->next_line - line) * dir <= 0) //demand has caught up with the prefetches
+        t->next_line = line + dir;
+
+    for(int i=0; i<m_settings.degree; i++) {
+        if((int64_t)(t->next_line - line) * dir > m_settings.distance)
+	    break;
+	if(dir < 0 && t->next_line == 0)
+	    break;
+	candidates.push_back(t->next_line * m_block_size);
+	t->next_line += dir;
+    }
+}
+
+
+
+} //namespace mcp_cache_namespace
+} //namespace manifold
@@ -0,0 +1,142 @@
+#ifndef MANIFOLD_MCPCACHE_PREFETCHER_H
+#define MANIFOLD_MCPCACHE_PREFETCHER_H
+
+#include <vector>
+#include "cache_req.h"
+
+namespace manifold {
+namespace mcp_cache_namespace {
+
+typedef enum {
+    PREFETCH_NONE = 0,
+    PREFETCH_NEXT_LINE,
+    PREFETCH_STRIDE,
+    PREFETCH_STREAM
+} prefetcher_type_t;
+
+
+struct prefetch_settings {
+    prefetch_settings() : type(PREFETCH_NONE), degree(1), distance(4), table_size(64), mshr_reserve(2), buffer_size(0) {}
+
+    prefetcher_type_t type;
+    int degree; //max number of lines prefetched per trigger
+    int distance; //stream: how many lines ahead of the demand stream prefetches may run
+    int table_size; //stride: entries in the PC-indexed table; stream: number of stream trackers
+    int mshr_reserve; //a prefetch is only issued if more than this number of MSHRs are free
+    int buffer_size; //L2/LLS only: if > 0, prefetched lines are held in a prefetch buffer of this
+                     //many lines instead of being put in the cache.
+};
+
+
+
+//! Base class of the hardware prefetchers. The cache calls train() for each demand
+//! access, and the prefetcher returns the lines it would like prefetched. Whether a
+//! candidate is actually prefetched is decided by the cache: lines that are already
+//! present or in flight are skipped, and no prefetch is issued unless enough MSHRs
+//! are free.
+class Prefetcher {
+public:
+    Prefetcher(int block_size, const prefetch_settings& settings) : m_block_size(block_size), m_settings(settings) {}
+    virtual ~Prefetcher() {}
+
+    //! @param \c addr  Address of the demand access.
+    //! @param \c pc  PC of the instruction that made the access; 0 if unknown.
+    //! @param \c trigger  True if the access missed, or is the first hit on a prefetched line.
+    //! @param \c candidates  Line addresses to prefetch are appended to this.
+    virtual void train(paddr_t addr, paddr_t pc, bool trigger, std::vector<paddr_t>& candidates) = 0;
+
+    virtual const char* get_name() const = 0;
+
+    //! Returns 0 if the type is PREFETCH_NONE.
+    static Prefetcher* Create(int block_size, const prefetch_settings& settings);
+    //! Converts "none", "next_line", "stride" or "stream" to a prefetcher type.
+    static prefetcher_type_t Parse_type(const char* name);
+
+protected:
+    paddr_t get_line(paddr_t addr) const { return addr / m_block_size; } //line number, not address
+
+    const int m_block_size;
+    const prefetch_settings m_settings;
+};
+
+
+
+//! On a trigger for line X, prefetch lines X+1 to X+degree.
+class Next_line_prefetcher : public Prefetcher {
+public:
+    Next_line_prefetcher(int block_size, const prefetch_settings& settings) : Prefetcher(block_size, settings) {}
+
+    void train(paddr_t addr, paddr_t pc, bool trigger, std::vector<paddr_t>& candidates);
+    const char* get_name() const { return "next_line"; }
+};
+
+
+
+//! A table indexed by PC remembers the last address and stride of each load or
+//! store instruction. Once the same stride is seen twice in a row, each access by
+//! the instruction prefetches the lines up to degree strides ahead. Caches that
+//! don't know the PC (e.g., L2) index the table with the 4KB region of the address.
+class Stride_prefetcher : public Prefetcher {
+public:
+    Stride_prefetcher(int block_size, const prefetch_settings& settings);
+
+    void train(paddr_t addr, paddr_t pc, bool trigger, std::vector<paddr_t>& candidates);
+    const char* get_name() const { return "stride"; }
+
+#ifdef MCP_CACHE_UTEST
+public:
+#else
+private:
+#endif
+    enum { CONF_MAX = 3, CONF_THRESHOLD = 1 };
+
+    struct Entry {
+	Entry() : tag(0), last_addr(0), stride(0), confidence(0), valid(false) {}
+	paddr_t tag;
+	paddr_t last_addr;
+	int64_t stride;
+	int confidence;
+	bool valid;
+    };
+    std::vector<Entry> m_table;
+};
+
+
+
+//! Stream trackers follow triggers to nearby lines (within distance lines of the
+//! previous one) in either direction. Once two steps of a stream have gone in the
+//! same direction, each trigger prefetches up to degree lines, staying at most
+//! distance lines ahead of the demand access.
+class Stream_prefetcher : public Prefetcher {
+public:
+    Stream_prefetcher(int block_size, const prefetch_settings& settings);
+
+    void train(paddr_t addr, paddr_t pc, bool trigger, std::vector<paddr_t>& candidates);
+    const char* get_name() const { return "stream"; }
+
+#ifdef MCP_CACHE_UTEST
+public:
+#else
+private:
+#endif
+    enum { CONF_THRESHOLD = 2 };
+
+    struct Tracker {
+	Tracker() : last_line(0), next_line(0), dir(0), confidence(0), lru(0), valid(false) {}
+	paddr_t last_line; //last line of the stream that was accessed
+	paddr_t next_line; //next line to prefetch
+	int dir; //+1 or -1; 0 if not known yet
+	int confidence;
+	uint64_t lru; //time of last use
+	bool valid;
+    };
+    std::vector<Tracker> m_trackers;
+    uint64_t m_time;
+};
+
+
+
+} //namespace mcp_cache_namespace
+} //namespace manifold
+
+#endif //MANIFOLD_MCPCACHE_PREFETCHER_H
@@ -508,8 +508,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + 10 + HT_LOOKUP;
@@ -557,8 +556,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + 10;
@@ -609,8 +607,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + 10;
@@ -677,8 +674,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -730,8 +726,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
@@ -784,8 +779,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
@@ -840,8 +834,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -893,8 +886,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -946,8 +938,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -998,8 +989,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1067,8 +1057,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1142,8 +1131,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1156,8 +1144,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1211,8 +1198,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1225,8 +1211,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1279,8 +1264,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1293,8 +1277,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1348,8 +1331,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1362,8 +1344,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1663,8 +1644,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1830,8 +1810,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1902,8 +1881,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1953,8 +1931,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2005,8 +1982,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2203,8 +2179,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = reply;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(reply);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2333,8 +2308,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2397,8 +2371,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2580,8 +2553,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2789,8 +2761,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = resp;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(resp);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2804,8 +2775,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = resp2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(resp2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2878,8 +2848,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2976,8 +2945,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -3096,8 +3064,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -3196,8 +3163,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -3295,8 +3261,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -3395,8 +3360,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -3492,8 +3456,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -3590,8 +3553,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -3658,8 +3620,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -3728,8 +3689,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -3744,8 +3704,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = umreq2;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(umreq2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + 50;
@@ -3804,8 +3763,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
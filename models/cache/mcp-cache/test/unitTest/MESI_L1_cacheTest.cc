@@ -256,6 +256,41 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! @brief Test the stat engine: a load during the warmup is not counted.
+    //!
+    //! Empty cache; start_warmup() is called on the stat engine, then a load with
+    //! a random address misses; after end_warmup() the request and cycle
+    //! counters have their values from before the warmup.
+    void test_stat_engine_warmup_0()
+    {
+	const unsigned long ADDR = random();
+	Proc_req* preq = new Proc_req(0, NODE_ID, ADDR, Proc_req::LOAD);
+
+	const unsigned long cycles = m_cachep->stats_cycles;
+	m_cachep->get_stat_engine()->start_warmup();
+
+	Manifold::unhalt();
+	Ticks_t When = 1;
+	Manifold::Schedule(When, &MockProc::send_creq, m_procp, preq);
+	Ticks_t scheduledAt = When + MasterClock.NowTicks();
+
+	Manifold::StopAt(scheduledAt + PROC_CACHE + HT_LOOKUP + 10);
+	Manifold::Run();
+
+	//the load was processed
+	CPPUNIT_ASSERT_EQUAL(1u, m_cachep->stats_processor_read_requests);
+	CPPUNIT_ASSERT(m_cachep->stats_cycles > cycles);
+
+	m_cachep->get_stat_engine()->end_warmup();
+
+	CPPUNIT_ASSERT_EQUAL(0u, m_cachep->stats_processor_read_requests);
+	CPPUNIT_ASSERT_EQUAL(cycles, m_cachep->stats_cycles);
+    }
+
+
+
     //======================================================================
     //======================================================================
     //! @brief Test handle_processor_request(): load hit
@@ -614,8 +649,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -707,8 +741,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -798,8 +831,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
@@ -890,8 +922,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
@@ -983,8 +1014,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1075,8 +1105,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1167,8 +1196,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1257,8 +1285,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1363,8 +1390,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1473,8 +1499,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1487,8 +1512,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1559,8 +1583,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1573,8 +1596,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1644,8 +1666,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1658,8 +1679,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -1734,8 +1754,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -1748,8 +1767,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -2159,8 +2177,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -2399,8 +2416,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = req2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 50;
@@ -2512,8 +2528,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2580,8 +2595,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2649,8 +2663,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -2863,8 +2876,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = reply;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(reply);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -3005,8 +3017,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -3083,8 +3094,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -3276,8 +3286,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 10;
@@ -3495,8 +3504,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = resp;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(resp);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 10;
@@ -3510,8 +3518,7 @@ public:
 	NetworkPacket* mgrPkt2 = new NetworkPacket;
 	mgrPkt2->type = m_cachep->COH_MSG;
 	mgrPkt2->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt2->data)) = resp2;
-	mgrPkt2->data_size = sizeof(Coh_msg);
+	mgrPkt2->set_data(resp2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt2);
 	When += PROC_CACHE + 10;
@@ -3589,8 +3596,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -3702,8 +3708,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -3841,8 +3846,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -3982,8 +3986,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -4122,8 +4125,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -4263,8 +4265,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 	When += PROC_CACHE + 50;
@@ -4401,8 +4402,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -4539,8 +4539,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -4647,8 +4646,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -4744,8 +4742,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -4813,8 +4810,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -4829,8 +4825,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = umreq2;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(umreq2);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, ownerPkt);
 	When += PROC_CACHE + 50;
@@ -4929,8 +4924,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = umreq;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(umreq);
 
 	Manifold::Schedule(When, &MockLower::send_pkt, m_lowerp, mgrPkt);
 
@@ -4989,6 +4983,7 @@ public:
 	/*
 	*/
 	mySuite->addTest(new CppUnit::TestCaller<MESI_L1_cacheTest>("test_handle_processor_request_load_l1_I_0", &MESI_L1_cacheTest::test_handle_processor_request_load_l1_I_0));
+	mySuite->addTest(new CppUnit::TestCaller<MESI_L1_cacheTest>("test_stat_engine_warmup_0", &MESI_L1_cacheTest::test_stat_engine_warmup_0));
 	mySuite->addTest(new CppUnit::TestCaller<MESI_L1_cacheTest>("test_handle_processor_request_load_l1_ESM_0", &MESI_L1_cacheTest::test_handle_processor_request_load_l1_ESM_0));
 	mySuite->addTest(new CppUnit::TestCaller<MESI_L1_cacheTest>("test_handle_processor_request_store_l1_I_0", &MESI_L1_cacheTest::test_handle_processor_request_store_l1_I_0));
 	mySuite->addTest(new CppUnit::TestCaller<MESI_L1_cacheTest>("test_handle_processor_request_store_l1_M_0", &MESI_L1_cacheTest::test_handle_processor_request_store_l1_M_0));
@@ -196,8 +196,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -244,8 +243,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//manually put the ADDR in the hash table, and set the manager state to E.
 	m_cachep->my_table->reserve_block_for(ADDR);
@@ -321,8 +319,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -376,8 +373,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -443,8 +439,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -516,8 +511,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -573,8 +567,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -592,8 +585,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -663,8 +655,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -682,8 +673,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -697,8 +687,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -768,8 +757,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -787,8 +775,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + 10;
@@ -802,8 +789,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 	When += L1_L2 + 10;
@@ -867,8 +853,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -885,8 +870,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + 10;
@@ -942,8 +926,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -960,8 +943,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1029,8 +1011,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1047,8 +1028,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1128,8 +1108,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1147,8 +1126,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -1163,8 +1141,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1245,8 +1222,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1265,8 +1241,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -1281,8 +1256,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1344,8 +1318,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1362,8 +1335,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1425,8 +1397,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1444,8 +1415,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1540,8 +1510,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1558,8 +1527,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + 2*HT_LOOKUP + 10;
@@ -1657,8 +1625,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1675,8 +1642,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + 2*HT_LOOKUP + 10;
@@ -1782,8 +1748,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1801,8 +1766,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -1885,8 +1849,7 @@ public:
 
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -1906,8 +1869,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1987,8 +1949,7 @@ public:
 
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -2008,8 +1969,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2024,8 +1984,7 @@ public:
 	NetworkPacket* l1rply = new NetworkPacket;
 	l1rply->type = L2_cache :: COH_MSG;
 	l1rply->src = SOURCE_ID;
-	*((Coh_msg*)(l1rply->data)) = reply;
-	l1rply->data_size = sizeof(Coh_msg);
+	l1rply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1rply);
 	When += L1_L2 + 2*HT_LOOKUP + 10;
@@ -2073,8 +2032,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2097,8 +2055,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2146,8 +2103,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2170,8 +2126,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2185,8 +2140,7 @@ public:
 	NetworkPacket* l1rply = new NetworkPacket;
 	l1rply->type = L2_cache :: COH_MSG;
 	//l1rply->src = SOURCE_ID;
-	*((Coh_msg*)(l1rply->data)) = reply;
-	l1rply->data_size = sizeof(Coh_msg);
+	l1rply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1rply);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2266,8 +2220,7 @@ public:
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
 	    //l1pkt->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -2282,8 +2235,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt); //this would LRU_BUSY_STALL
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2360,8 +2312,7 @@ public:
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
 	    //l1pkt->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -2377,8 +2328,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt); //this would LRU_BUSY_STALL
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2393,8 +2343,7 @@ public:
 	NetworkPacket* l1rply = new NetworkPacket;
 	l1rply->type = L2_cache :: COH_MSG;
 	//l1rply->src = SOURCE_ID;
-	*((Coh_msg*)(l1rply->data)) = reply;
-	l1rply->data_size = sizeof(Coh_msg);
+	l1rply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1rply);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2482,8 +2431,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2504,8 +2452,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + 10;
@@ -2595,8 +2542,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2617,8 +2563,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2633,8 +2578,7 @@ public:
 	NetworkPacket* l1reply = new NetworkPacket;
 	l1reply->type = L2_cache :: COH_MSG;
 	//l1ply->src = SOURCE_ID;
-	*((Coh_msg*)(l1reply->data)) = reply;
-	l1reply->data_size = sizeof(Coh_msg);
+	l1reply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1reply);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2649,8 +2593,7 @@ public:
 	NetworkPacket* l1reply2 = new NetworkPacket;
 	l1reply2->type = L2_cache :: COH_MSG;
 	//l1ply2->src = SOURCE_ID;
-	*((Coh_msg*)(l1reply2->data)) = reply2;
-	l1reply2->data_size = sizeof(Coh_msg);
+	l1reply2->set_data(reply2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1reply2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2738,8 +2681,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -2756,8 +2698,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -2773,8 +2714,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -2849,8 +2789,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -2867,8 +2806,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -2885,8 +2823,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -2959,8 +2896,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -2977,8 +2913,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -2994,8 +2929,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3069,8 +3003,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3087,8 +3020,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3105,8 +3037,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3217,8 +3148,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3235,8 +3165,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3252,8 +3181,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3270,8 +3198,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
@@ -3381,8 +3308,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3399,8 +3325,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3416,8 +3341,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3434,8 +3358,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
@@ -3534,8 +3457,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for requestor to send 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3551,8 +3473,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SHARERS_ID[0];
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3568,8 +3489,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SHARERS_ID[i];
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -3585,8 +3505,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3602,8 +3521,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
@@ -3704,8 +3622,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for requestor to send 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3721,8 +3638,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SHARERS_ID[0];
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3738,8 +3654,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SHARERS_ID[0];
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -3755,8 +3670,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3772,8 +3686,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
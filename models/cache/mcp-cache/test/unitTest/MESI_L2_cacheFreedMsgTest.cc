@@ -0,0 +1,346 @@
+//! This program tests that MESI_L2_cache does not use a Coh_msg after deleting
+//! it. Global operator new/delete are replaced so that freed memory is filled
+//! with a pattern; a read of a deleted message then gets the pattern instead of
+//! the stale value that the allocator usually leaves behind.
+//!
+//!                    --------
+//!                   | MockL1 |
+//!                    --------
+//!                         | NetworkPacket
+//!                  ---------------
+//!                 | MESI_L2_cache |
+//!                  ---------------
+
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <vector>
+#include <new>
+#include "MESI_L2_cache.h"
+#include "coherence/MESI_manager.h"
+
+#include "kernel/manifold-decl.h"
+#include "kernel/manifold.h"
+#include "kernel/component.h"
+
+using namespace std;
+using namespace manifold::kernel;
+using namespace manifold::uarch;
+using namespace manifold::mcp_cache_namespace;
+
+
+//####################################################################
+// Poisoning allocator: each block is preceded by its size, and is filled
+// with FREED_BYTE when deleted.
+//####################################################################
+static const size_t HEADER = 16; //keeps the malloc alignment
+static const unsigned char FREED_BYTE = 0xdd;
+
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+    char* p = (char*)malloc(size + HEADER);
+    if(p == 0)
+	throw std::bad_alloc();
+    *(size_t*)p = size;
+    return p + HEADER;
+}
+
+void operator delete(void* ptr) throw()
+{
+    if(ptr == 0)
+	return;
+    char* p = (char*)ptr - HEADER;
+    memset(ptr, FREED_BYTE, *(size_t*)p);
+    free(p);
+}
+
+
+
+//####################################################################
+// helper classes
+//####################################################################
+
+//! This class emulates an L1 and a memory controller.
+class MockL1 : public manifold::kernel::Component {
+public:
+    enum {OUT=0};
+    enum {IN=0};
+    void send_req(NetworkPacket* pkt)
+    {
+	Send(OUT, pkt);
+    }
+
+    void handle_incoming(int, NetworkPacket* pkt)
+    {
+        if(pkt->type == L2_cache :: MEM_MSG) {
+	    Mem_msg* msg = (Mem_msg*)(pkt->data);
+	    if(msg->op_type == OpMemLd)
+		Send(OUT, pkt);
+	    else
+	        delete pkt;
+	}
+	else if(pkt->type == L2_cache :: COH_MSG) {
+	    m_cache_resps.push_back(*pkt);
+	    delete pkt;
+	}
+	else {
+	    assert(pkt->type == L2_cache :: CREDIT_MSG);
+	    delete pkt;
+	}
+    }
+    vector<NetworkPacket>& get_cache_resps() { return m_cache_resps; }
+private:
+    vector<NetworkPacket> m_cache_resps;
+};
+
+
+
+
+//! This mapping maps any address to the same id, which is initialized
+//! in construction.
+class MyMcMap1 : public DestMap {
+public:
+    MyMcMap1(int x) : m_mcid(x) {}
+    int lookup(paddr_t addr) { return m_mcid; }
+private:
+    const int m_mcid;
+};
+
+
+const int NODE_ID = 7;
+const int MC_ID = 8;
+
+//####################################################################
+//! Class MESI_L2_cacheFreedMsgTest tests MESI_L2_cache with the poisoning allocator.
+//####################################################################
+class MESI_L2_cacheFreedMsgTest : public CppUnit::TestFixture {
+private:
+    static const int HT_SIZE = 0x1 << 14; //2^14 = 16k;
+    static const int HT_ASSOC = 4;
+    static const int HT_BLOCK_SIZE = 32;
+    static const int HT_HIT = 2;
+    static const int HT_LOOKUP = 11;
+
+    static const unsigned MSHR_SIZE = 8;
+
+    //latencies
+    static const Ticks_t L1_L2 = 1;
+
+    MESI_L2_cache* m_cachep;
+    MockL1* m_l1p;
+
+    NetworkPacket* make_pkt(const Coh_msg& msg)
+    {
+	NetworkPacket* pkt = new NetworkPacket;
+	pkt->type = L2_cache :: COH_MSG;
+	pkt->src = msg.src_id;
+	pkt->set_data(msg);
+	return pkt;
+    }
+
+public:
+    static Clock MasterClock;  //clock has to be global or static.
+    enum { MASTER_CLOCK_HZ = 10 };
+
+    //! Initialization function. Inherited from the CPPUnit framework.
+    void setUp()
+    {
+	cache_settings parameters;
+	parameters.name = "testCache";
+	parameters.size = HT_SIZE;
+	parameters.assoc = HT_ASSOC;
+	parameters.block_size = HT_BLOCK_SIZE;
+	parameters.hit_time = HT_HIT;
+	parameters.lookup_time = HT_LOOKUP;
+	parameters.replacement_policy = RP_LRU;
+
+
+        //create a MockL1, a MESI_L2_cache.
+	CompId_t l1Id = Component :: Create<MockL1>(0);
+	m_l1p = Component::GetComponent<MockL1>(l1Id);
+
+        const int COH = 123;
+        const int MEM = 456;
+        const int CREDIT = 789;
+	L2_cache :: Set_msg_types(COH, MEM, CREDIT);
+
+	L2_cache_settings settings;
+	settings.mc_map = new MyMcMap1(MC_ID); //all addresses map to mc MC_ID
+	settings.mshr_sz = MSHR_SIZE;
+	settings.downstream_credits = 30;
+	CompId_t cacheId = Component :: Create<MESI_L2_cache>(0, NODE_ID, parameters, settings);
+	m_cachep = Component::GetComponent<MESI_L2_cache>(cacheId);
+
+        //connect the components
+	//L1 to L2
+	Manifold::Connect(l1Id, MockL1::OUT, &MockL1::handle_incoming,
+	                  cacheId, L2_cache::PORT_L1, &L2_cache::handle_incoming<Mem_msg>,
+			  MasterClock, MasterClock, L1_L2, L1_L2);
+    }
+
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test m_notify(): the stalled request is deleted after its MSHR
+    //! entry is found.
+    //!
+    //! Manager in E; a load from another client makes the manager forward the
+    //! request to the owner and stall it. The owner's MESI_CM_CLEAN and the
+    //! client's MESI_CM_UNBLOCK_S complete the request through m_notify(), which
+    //! deletes the stalled request. Verify the MSHR entry is released and the
+    //! manager ends in S; reading the address of the deleted request would find
+    //! no MSHR entry.
+    void test_m_notify_0()
+    {
+	const paddr_t ADDR = random();
+	const int SOURCE_ID = random() % 1024;
+
+	//manually put the ADDR in the hash table, and set the manager state to E.
+	m_cachep->my_table->reserve_block_for(ADDR);
+	hash_entry* entry = m_cachep->my_table->get_entry(ADDR);
+	CPPUNIT_ASSERT(entry != 0);
+	entry->have_data = true;
+
+	MESI_manager* manager = dynamic_cast<MESI_manager*>(m_cachep->managers[entry->get_idx()]);
+	manager->state = MESI_MNG_E;
+	int OWNER_ID;
+	do {
+	    OWNER_ID = random() % 1024;
+        } while(OWNER_ID == SOURCE_ID || OWNER_ID == NODE_ID);
+	manager->owner = OWNER_ID;
+
+	Coh_msg req;
+	req.type = Coh_msg :: COH_REQ;
+	req.addr = ADDR;
+	req.msg = MESI_CM_I_to_S;
+	req.src_id = SOURCE_ID;
+	req.rw = 0;
+
+	Coh_msg clean;
+	clean.type = Coh_msg :: COH_RPLY;
+	clean.addr = ADDR;
+	clean.msg = MESI_CM_CLEAN;
+	clean.src_id = SOURCE_ID;
+
+	Coh_msg unblock;
+	unblock.type = Coh_msg :: COH_RPLY;
+	unblock.addr = ADDR;
+	unblock.msg = MESI_CM_UNBLOCK_S;
+	unblock.src_id = SOURCE_ID;
+
+	Manifold::unhalt();
+	Ticks_t When = 1;
+	Manifold::Schedule(When, &MockL1::send_req, m_l1p, make_pkt(req));
+	When += L1_L2 + HT_LOOKUP + 10;
+	Manifold::Schedule(When, &MockL1::send_req, m_l1p, make_pkt(clean));
+	When += L1_L2 + HT_LOOKUP + 10;
+	Manifold::Schedule(When, &MockL1::send_req, m_l1p, make_pkt(unblock));
+	When += L1_L2 + HT_LOOKUP + 10;
+
+	Manifold::StopAt(When);
+	Manifold::Run();
+
+	//the manager forwarded the request to the owner
+	vector<NetworkPacket>& cresps = m_l1p->get_cache_resps();
+	CPPUNIT_ASSERT_EQUAL(1, (int)cresps.size());
+	CPPUNIT_ASSERT_EQUAL((int)MESI_MC_FWD_S, ((Coh_msg*)(cresps[0].data))->msg);
+
+	//the request is complete and its MSHR entry released
+	CPPUNIT_ASSERT(m_cachep->mcp_stalled_req[manager->getManagerID()] == 0);
+	CPPUNIT_ASSERT_EQUAL(false, m_cachep->mshr->has_match(ADDR));
+	CPPUNIT_ASSERT_EQUAL(true, m_cachep->my_table->has_match(ADDR));
+	CPPUNIT_ASSERT_EQUAL(MESI_MNG_S, manager->state);
+	CPPUNIT_ASSERT_EQUAL(true, manager->sharersList.get(SOURCE_ID));
+	CPPUNIT_ASSERT_EQUAL(true, manager->sharersList.get(OWNER_ID));
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test handle_incoming(): the access counters use the rw field of the
+    //! message before process_incoming_coh() deletes it.
+    //!
+    //! Send a MESI_CM_M_to_I writeback for a line not in L2 and a load request;
+    //! the writeback is ignored and deleted at once. Verify the writeback is
+    //! counted as a write, and the load and its memory response as reads.
+    void test_handle_incoming_counters_0()
+    {
+	const paddr_t ADDR = random();
+	const int SOURCE_ID = random() % 1024;
+
+	CPPUNIT_ASSERT_EQUAL(false, m_cachep->my_table->has_match(ADDR));
+	m_cachep->cache_counter->reset();
+
+	Coh_msg wb;
+	wb.type = Coh_msg :: COH_REQ;
+	wb.addr = ADDR;
+	wb.msg = MESI_CM_M_to_I;
+	wb.src_id = SOURCE_ID;
+	wb.rw = 1;
+
+	Coh_msg req;
+	req.type = Coh_msg :: COH_REQ;
+	req.addr = ADDR + 0x10000;
+	req.msg = MESI_CM_I_to_S;
+	req.src_id = SOURCE_ID;
+	req.rw = 0;
+
+	Manifold::unhalt();
+	Ticks_t When = 1;
+	Manifold::Schedule(When, &MockL1::send_req, m_l1p, make_pkt(wb));
+	When += L1_L2 + HT_LOOKUP + 10;
+	Manifold::Schedule(When, &MockL1::send_req, m_l1p, make_pkt(req));
+	When += L1_L2 + HT_LOOKUP + 10;
+
+	Manifold::StopAt(When);
+	Manifold::Run();
+
+	//the writeback is ignored
+	CPPUNIT_ASSERT_EQUAL(false, m_cachep->my_table->has_match(ADDR));
+
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, m_cachep->cache_counter->DL2.write);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, m_cachep->cache_counter->DL2.write_tag);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)2, m_cachep->cache_counter->DL2.read);
+    }
+
+
+
+
+    //! Build a test suite.
+    static CppUnit::Test* suite()
+    {
+	CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("MESI_L2_cacheFreedMsgTest");
+
+	mySuite->addTest(new CppUnit::TestCaller<MESI_L2_cacheFreedMsgTest>("test_m_notify_0", &MESI_L2_cacheFreedMsgTest::test_m_notify_0));
+	mySuite->addTest(new CppUnit::TestCaller<MESI_L2_cacheFreedMsgTest>("test_handle_incoming_counters_0", &MESI_L2_cacheFreedMsgTest::test_handle_incoming_counters_0));
+
+	return mySuite;
+    }
+};
+
+
+Clock MESI_L2_cacheFreedMsgTest :: MasterClock(MESI_L2_cacheFreedMsgTest :: MASTER_CLOCK_HZ);
+
+int main()
+{
+    Manifold :: Init();
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( MESI_L2_cacheFreedMsgTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+
+}
+
+
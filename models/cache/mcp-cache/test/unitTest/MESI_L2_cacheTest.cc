@@ -189,8 +189,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -290,8 +289,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -377,8 +375,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -456,8 +453,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -560,8 +556,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -654,8 +649,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -741,8 +735,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -760,8 +753,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -871,8 +863,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 
 	Manifold::unhalt();
@@ -890,8 +881,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -905,8 +895,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -996,8 +985,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1015,8 +1003,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1030,8 +1017,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1116,8 +1102,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1134,8 +1119,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1214,8 +1198,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1232,8 +1215,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1339,8 +1321,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1357,8 +1338,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1456,8 +1436,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1475,8 +1454,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -1491,8 +1469,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1603,8 +1580,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1623,8 +1599,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -1639,8 +1614,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1732,8 +1706,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1750,8 +1723,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1833,8 +1805,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1852,8 +1823,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1968,8 +1938,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -1986,8 +1955,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	//after the eviction, L2 processes the original request: a mem read and then send MC_GRANT_E_DATA
@@ -2125,8 +2093,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -2143,8 +2110,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	//after eviction, 2 mem ops and MC_GRANT_E_DATA
@@ -2295,8 +2261,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
@@ -2314,8 +2279,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -2440,8 +2404,7 @@ public:
 
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -2461,8 +2424,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2537,8 +2499,7 @@ public:
 
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -2558,8 +2519,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2574,8 +2534,7 @@ public:
 	NetworkPacket* l1rply = new NetworkPacket;
 	l1rply->type = L2_cache :: COH_MSG;
 	l1rply->src = SOURCE_ID;
-	*((Coh_msg*)(l1rply->data)) = reply;
-	l1rply->data_size = sizeof(Coh_msg);
+	l1rply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1rply);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2623,8 +2582,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2647,8 +2605,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2692,8 +2649,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2716,8 +2672,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2731,8 +2686,7 @@ public:
 	NetworkPacket* l1rply = new NetworkPacket;
 	l1rply->type = L2_cache :: COH_MSG;
 	//l1rply->src = SOURCE_ID;
-	*((Coh_msg*)(l1rply->data)) = reply;
-	l1rply->data_size = sizeof(Coh_msg);
+	l1rply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1rply);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2806,8 +2760,7 @@ public:
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
 	    //l1pkt->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -2822,8 +2775,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt); //this would LRU_BUSY_STALL
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2900,8 +2852,7 @@ public:
 	    NetworkPacket* l1pkt = new NetworkPacket;
 	    l1pkt->type = L2_cache :: COH_MSG;
 	    //l1pkt->src = SOURCE_ID;
-	    *((Coh_msg*)(l1pkt->data)) = req;
-	    l1pkt->data_size = sizeof(Coh_msg);
+	    l1pkt->set_data(req);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	}
@@ -2917,8 +2868,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt); //this would LRU_BUSY_STALL
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -2933,8 +2883,7 @@ public:
 	NetworkPacket* l1rply = new NetworkPacket;
 	l1rply->type = L2_cache :: COH_MSG;
 	//l1rply->src = SOURCE_ID;
-	*((Coh_msg*)(l1rply->data)) = reply;
-	l1rply->data_size = sizeof(Coh_msg);
+	l1rply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1rply);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -3022,8 +2971,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -3044,8 +2992,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -3136,8 +3083,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	//l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -3158,8 +3104,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	//l1pkt2->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -3174,8 +3119,7 @@ public:
 	NetworkPacket* l1reply = new NetworkPacket;
 	l1reply->type = L2_cache :: COH_MSG;
 	//l1ply->src = SOURCE_ID;
-	*((Coh_msg*)(l1reply->data)) = reply;
-	l1reply->data_size = sizeof(Coh_msg);
+	l1reply->set_data(reply);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1reply);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -3190,8 +3134,7 @@ public:
 	NetworkPacket* l1reply2 = new NetworkPacket;
 	l1reply2->type = L2_cache :: COH_MSG;
 	//l1ply2->src = SOURCE_ID;
-	*((Coh_msg*)(l1reply2->data)) = reply2;
-	l1reply2->data_size = sizeof(Coh_msg);
+	l1reply2->set_data(reply2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1reply2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -3281,8 +3224,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3299,8 +3241,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3316,8 +3257,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3410,8 +3350,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3428,8 +3367,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3446,8 +3384,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3539,8 +3476,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3557,8 +3493,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3574,8 +3509,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3667,8 +3601,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3685,8 +3618,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3703,8 +3635,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3833,8 +3764,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -3851,8 +3781,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -3868,8 +3797,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -3886,8 +3814,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
@@ -4038,8 +3965,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for the MockProc to send the req
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -4056,8 +3982,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -4073,8 +3998,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = OWNER_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -4091,8 +4015,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
@@ -4233,8 +4156,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for requestor to send 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -4250,8 +4172,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SHARERS_ID[0];
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -4267,8 +4188,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SHARERS_ID[i];
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -4284,8 +4204,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -4301,8 +4220,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
@@ -4437,8 +4355,7 @@ public:
 	NetworkPacket* l1pkt = new NetworkPacket;
 	l1pkt->type = L2_cache :: COH_MSG;
 	l1pkt->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt->data)) = req;
-	l1pkt->data_size = sizeof(Coh_msg);
+	l1pkt->set_data(req);
 
 	//schedule for requestor to send 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt);
@@ -4454,8 +4371,7 @@ public:
 	NetworkPacket* l1pkt2 = new NetworkPacket;
 	l1pkt2->type = L2_cache :: COH_MSG;
 	l1pkt2->src = SHARERS_ID[0];
-	*((Coh_msg*)(l1pkt2->data)) = req2;
-	l1pkt2->data_size = sizeof(Coh_msg);
+	l1pkt2->set_data(req2);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 
@@ -4471,8 +4387,7 @@ public:
 	    NetworkPacket* l1pkt2 = new NetworkPacket;
 	    l1pkt2->type = L2_cache :: COH_MSG;
 	    l1pkt2->src = SHARERS_ID[0];
-	    *((Coh_msg*)(l1pkt2->data)) = req2;
-	    l1pkt2->data_size = sizeof(Coh_msg);
+	    l1pkt2->set_data(req2);
 
 	    Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt2);
 	}
@@ -4488,8 +4403,7 @@ public:
 	NetworkPacket* l1pkt3 = new NetworkPacket;
 	l1pkt3->type = L2_cache :: COH_MSG;
 	l1pkt3->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt3->data)) = req3;
-	l1pkt3->data_size = sizeof(Coh_msg);
+	l1pkt3->set_data(req3);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt3);
 
@@ -4505,8 +4419,7 @@ public:
 	NetworkPacket* l1pkt4 = new NetworkPacket;
 	l1pkt4->type = L2_cache :: COH_MSG;
 	l1pkt4->src = SOURCE_ID;
-	*((Coh_msg*)(l1pkt4->data)) = req4;
-	l1pkt4->data_size = sizeof(Coh_msg);
+	l1pkt4->set_data(req4);
 
 	Manifold::Schedule(When, &MockL1::send_req, m_l1p, l1pkt4);
 
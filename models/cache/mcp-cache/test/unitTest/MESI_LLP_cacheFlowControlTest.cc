@@ -870,8 +870,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -912,8 +911,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -961,8 +959,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1024,8 +1021,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1081,8 +1077,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1132,8 +1127,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1184,8 +1178,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1246,8 +1239,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1302,8 +1294,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 
 	When += 10;
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1354,8 +1345,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 	When += 10;
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1406,8 +1396,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1467,8 +1456,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
@@ -1525,8 +1513,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1577,8 +1564,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1630,8 +1616,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1745,8 +1730,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1793,8 +1777,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1842,8 +1825,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1902,8 +1884,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1958,8 +1939,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -2006,8 +1986,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -2056,8 +2035,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -2117,8 +2095,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -2173,8 +2150,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2224,8 +2200,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2276,8 +2251,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2389,8 +2363,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2440,8 +2413,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2493,8 +2465,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2624,8 +2595,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2685,8 +2655,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2748,8 +2717,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2903,8 +2871,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3029,8 +2996,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3157,8 +3123,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3217,8 +3182,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3280,8 +3244,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3417,8 +3380,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3478,8 +3440,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3539,8 +3500,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = *req2;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4043,8 +4003,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4164,8 +4123,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4455,8 +4413,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4576,8 +4533,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4678,8 +4634,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4755,8 +4710,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4833,8 +4787,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5065,8 +5018,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *reply;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5246,8 +5198,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5333,8 +5284,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5549,8 +5499,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5804,8 +5753,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *resp;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*resp);
 	    delete resp;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5824,8 +5772,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *resp2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*resp2);
 	    delete resp2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5924,8 +5871,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6037,8 +5983,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6177,8 +6122,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6297,8 +6241,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6417,8 +6360,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6538,8 +6480,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6655,8 +6596,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6772,8 +6712,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6859,8 +6798,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6947,8 +6885,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -6966,8 +6903,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq2);
 	    delete umreq2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -7044,8 +6980,7 @@ cout << "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n";
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -763,8 +763,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -868,8 +867,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -973,8 +971,7 @@ public:
 	NetworkPacket* mgrPkt = new NetworkPacket;
 	mgrPkt->type = m_cachep->COH_MSG;
 	mgrPkt->dst = NODE_ID;
-	*((Coh_msg*)(mgrPkt->data)) = req;
-	mgrPkt->data_size = sizeof(Coh_msg);
+	mgrPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1081,8 +1078,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1190,8 +1186,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1295,8 +1290,7 @@ public:
 	NetworkPacket* ownerPkt = new NetworkPacket;
 	ownerPkt->type = m_cachep->COH_MSG;
 	ownerPkt->dst = NODE_ID;
-	*((Coh_msg*)(ownerPkt->data)) = req;
-	ownerPkt->data_size = sizeof(Coh_msg);
+	ownerPkt->set_data(req);
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, ownerPkt);
 	When += PROC_CACHE + HT_LOOKUP + 10;
 
@@ -1403,8 +1397,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1514,8 +1507,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1641,8 +1633,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1777,8 +1768,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1868,8 +1858,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -1960,8 +1949,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2095,8 +2083,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2604,8 +2591,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -2892,8 +2878,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3055,8 +3040,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3141,8 +3125,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3228,8 +3211,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3460,8 +3442,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *reply;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3607,8 +3588,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3723,8 +3703,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -3954,8 +3933,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4178,8 +4156,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *resp;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*resp);
 	    delete resp;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4198,8 +4175,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *resp2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*resp2);
 	    delete resp2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4281,8 +4257,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4409,8 +4384,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *req;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4577,8 +4551,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4761,8 +4734,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -4944,8 +4916,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5129,8 +5100,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5312,8 +5282,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5495,8 +5464,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5648,8 +5616,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5761,8 +5728,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5780,8 +5746,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq2;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq2);
 	    delete umreq2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
@@ -5890,8 +5855,7 @@ public:
 	    NetworkPacket* mgrPkt = new NetworkPacket;
 	    mgrPkt->type = m_cachep->COH_MSG;
 	    mgrPkt->dst = NODE_ID;
-	    *((Coh_msg*)(mgrPkt->data)) = *umreq;
-	    mgrPkt->data_size = sizeof(Coh_msg);
+	    mgrPkt->set_data(*umreq);
 	    delete umreq;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, mgrPkt);
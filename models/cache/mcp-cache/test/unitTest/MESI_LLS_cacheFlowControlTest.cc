@@ -321,8 +321,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -451,8 +450,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -525,8 +523,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -665,8 +662,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -791,8 +787,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -920,8 +915,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -996,8 +990,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1160,8 +1153,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1257,8 +1249,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1408,8 +1399,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1427,8 +1417,7 @@ public:
 	pkt2->src_port = LLP_cache :: LLP_ID;
 	pkt2->dst = NODE_ID;
 	pkt2->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt2->data)) = *req;
-	pkt2->data_size = sizeof(Coh_msg);
+	pkt2->set_data(*req);
 	delete req;
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt2);
 	When += L1_L2 + HT_LOOKUP + 10;
@@ -1571,8 +1560,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1590,8 +1578,7 @@ public:
 	pkt2->src_port = LLP_cache :: LLP_ID;
 	pkt2->dst = NODE_ID;
 	pkt2->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt2->data)) = *req2;
-	pkt2->data_size = sizeof(Coh_msg);
+	pkt2->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt2);
@@ -1609,8 +1596,7 @@ public:
 	pkt3->src_port = LLP_cache :: LLP_ID;
 	pkt3->dst = NODE_ID;
 	pkt3->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt3->data)) = *req3;
-	pkt3->data_size = sizeof(Coh_msg);
+	pkt3->set_data(*req3);
 	delete req3;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt3);
@@ -1692,8 +1678,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1720,8 +1705,7 @@ public:
 	pkt3->src_port = LLP_cache :: LLP_ID;
 	pkt3->dst = NODE_ID;
 	pkt3->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt3->data)) = *req3;
-	pkt3->data_size = sizeof(Coh_msg);
+	pkt3->set_data(*req3);
 	delete req3;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt3);
@@ -1813,8 +1797,7 @@ public:
 	pkt2->src_port = LLP_cache :: LLP_ID;
 	pkt2->dst = NODE_ID;
 	pkt2->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt2->data)) = *req2;
-	pkt2->data_size = sizeof(Coh_msg);
+	pkt2->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt2);
@@ -1910,8 +1893,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1929,8 +1911,7 @@ public:
 	pkt2->src_port = LLP_cache :: LLP_ID;
 	pkt2->dst = NODE_ID;
 	pkt2->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt2->data)) = *req2;
-	pkt2->data_size = sizeof(Coh_msg);
+	pkt2->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt2);
@@ -1948,8 +1929,7 @@ public:
 	pkt3->src_port = LLP_cache :: LLP_ID;
 	pkt3->dst = NODE_ID;
 	pkt3->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt3->data)) = *req3;
-	pkt3->data_size = sizeof(Coh_msg);
+	pkt3->set_data(*req3);
 	delete req3;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt3);
@@ -2032,8 +2012,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2060,8 +2039,7 @@ public:
 	pkt3->src_port = LLP_cache :: LLP_ID;
 	pkt3->dst = NODE_ID;
 	pkt3->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt3->data)) = *req3;
-	pkt3->data_size = sizeof(Coh_msg);
+	pkt3->set_data(*req3);
 	delete req3;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt3);
@@ -2155,8 +2133,7 @@ public:
 	pkt2->src_port = LLP_cache :: LLP_ID;
 	pkt2->dst = NODE_ID;
 	pkt2->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt2->data)) = *req2;
-	pkt2->data_size = sizeof(Coh_msg);
+	pkt2->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt2);
@@ -2242,8 +2219,7 @@ public:
 	pkt->src_port = LLP_cache :: LLP_ID;
 	pkt->dst = NODE_ID;
 	pkt->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt->data)) = *req;
-	pkt->data_size = sizeof(Coh_msg);
+	pkt->set_data(*req);
 	delete req;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2261,8 +2237,7 @@ public:
 	pkt2->src_port = LLP_cache :: LLP_ID;
 	pkt2->dst = NODE_ID;
 	pkt2->dst_port = LLP_cache :: LLS_ID;
-	*((Coh_msg*)(pkt2->data)) = *req2;
-	pkt2->data_size = sizeof(Coh_msg);
+	pkt2->set_data(*req2);
 	delete req2;
 
 	Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt2);
@@ -2410,8 +2385,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2430,8 +2404,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2585,8 +2558,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2605,8 +2577,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2690,8 +2661,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2710,8 +2680,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2900,8 +2869,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2921,8 +2889,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2942,8 +2909,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3047,8 +3013,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3068,8 +3033,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
 	    }
@@ -3089,8 +3053,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3202,8 +3165,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3319,8 +3281,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3340,8 +3301,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3361,8 +3321,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3473,8 +3432,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3497,8 +3455,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3518,8 +3475,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3636,8 +3592,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3725,8 +3680,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3745,8 +3699,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3894,8 +3847,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3914,8 +3866,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4102,8 +4053,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4125,8 +4075,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4258,8 +4207,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4281,8 +4229,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4432,8 +4379,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4456,8 +4402,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4592,8 +4537,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4623,8 +4567,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4745,8 +4688,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4776,8 +4718,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4801,8 +4742,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4883,8 +4823,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4919,8 +4858,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4996,8 +4934,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5032,8 +4969,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5056,8 +4992,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5193,8 +5128,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5310,8 +5244,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5432,8 +5365,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5465,8 +5397,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5594,8 +5525,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5627,8 +5557,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5652,8 +5581,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5677,8 +5605,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply2);
 	    delete reply2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5795,8 +5722,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5820,8 +5746,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5845,8 +5770,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5978,8 +5902,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6003,8 +5926,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6029,8 +5951,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6132,8 +6053,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6157,8 +6077,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6182,8 +6101,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6286,8 +6204,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6311,8 +6228,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6337,8 +6253,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6476,8 +6391,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6501,8 +6415,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6526,8 +6439,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6552,8 +6464,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req4;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req4);
 	    delete req4;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6692,8 +6603,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6717,8 +6627,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6742,8 +6651,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6768,8 +6676,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req4;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req4);
 	    delete req4;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6898,8 +6805,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6922,8 +6828,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6948,8 +6853,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6973,8 +6877,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -6998,8 +6901,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req5;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req5);
 	    delete req5;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -7137,8 +7039,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -7161,8 +7062,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -7187,8 +7087,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -7212,8 +7111,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -7237,8 +7135,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req5;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req5);
 	    delete req5;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
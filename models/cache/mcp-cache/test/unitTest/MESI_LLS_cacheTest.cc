@@ -323,8 +323,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -449,8 +448,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -556,8 +554,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -655,8 +652,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -782,8 +778,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -900,8 +895,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1009,8 +1003,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1152,8 +1145,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1175,8 +1167,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1198,8 +1189,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1319,8 +1309,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1342,8 +1331,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1365,8 +1353,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1479,8 +1466,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1502,8 +1488,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1609,8 +1594,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1632,8 +1616,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1770,8 +1753,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1793,8 +1775,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1917,8 +1898,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1941,8 +1921,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -1965,8 +1944,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2128,8 +2106,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2152,8 +2129,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2176,8 +2152,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2314,8 +2289,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2337,8 +2311,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2444,8 +2417,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2467,8 +2439,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2611,8 +2582,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2634,8 +2604,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2798,8 +2767,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -2821,8 +2789,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3008,8 +2975,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3032,8 +2998,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3213,8 +3178,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3244,8 +3208,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3326,8 +3289,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3357,8 +3319,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3382,8 +3343,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3445,8 +3405,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3481,8 +3440,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3539,8 +3497,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3575,8 +3532,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3599,8 +3555,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3698,8 +3653,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3801,8 +3755,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3909,8 +3862,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -3940,8 +3892,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4041,8 +3992,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4072,8 +4022,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4097,8 +4046,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply);
 	    delete reply;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4122,8 +4070,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *reply2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*reply2);
 	    delete reply2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4225,8 +4172,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4250,8 +4196,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4275,8 +4220,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4395,8 +4339,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4420,8 +4363,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4446,8 +4388,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4565,8 +4506,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4590,8 +4530,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4615,8 +4554,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4734,8 +4672,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4759,8 +4696,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4785,8 +4721,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4941,8 +4876,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4966,8 +4900,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -4991,8 +4924,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5017,8 +4949,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req4;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req4);
 	    delete req4;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5209,8 +5140,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5234,8 +5164,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5259,8 +5188,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5285,8 +5213,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req4;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req4);
 	    delete req4;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5474,8 +5401,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5498,8 +5424,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5525,8 +5450,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5550,8 +5474,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5575,8 +5498,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req5;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req5);
 	    delete req5;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5782,8 +5704,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req);
 	    delete req;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5806,8 +5727,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req2;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req2);
 	    delete req2;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5832,8 +5752,7 @@ public:
 		pkt->src_port = LLP_cache :: LLP_ID;
 		pkt->dst = NODE_ID;
 		pkt->dst_port = LLP_cache :: LLS_ID;
-		*((Coh_msg*)(pkt->data)) = *req2;
-		pkt->data_size = sizeof(Coh_msg);
+		pkt->set_data(*req2);
 		delete req2;
 
 		Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5857,8 +5776,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req3;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req3);
 	    delete req3;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
@@ -5882,8 +5800,7 @@ public:
 	    pkt->src_port = LLP_cache :: LLP_ID;
 	    pkt->dst = NODE_ID;
 	    pkt->dst_port = LLP_cache :: LLS_ID;
-	    *((Coh_msg*)(pkt->data)) = *req5;
-	    pkt->data_size = sizeof(Coh_msg);
+	    pkt->set_data(*req5);
 	    delete req5;
 
 	    Manifold::Schedule(When, &MockMux::send_pkt, m_muxp, pkt);
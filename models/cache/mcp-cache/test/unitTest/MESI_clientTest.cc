@@ -369,6 +369,50 @@ public:
 
     }
 
+
+    //======================================================================
+    //======================================================================
+    //! Test functional warmup: no message is sent and the client ends up in the
+    //! stable state it would reach in timing mode.
+    void testFunctional()
+    {
+        //I: load miss, granted exclusively
+        client->transition_to_i();
+        CPPUNIT_ASSERT_EQUAL(false, client->functional_access(false));
+        client->functional_fill(false, true);
+        CPPUNIT_ASSERT(MESI_C_E == client->state);
+
+        //E: store hits and goes to M silently
+        CPPUNIT_ASSERT_EQUAL(true, client->functional_access(true));
+        CPPUNIT_ASSERT(MESI_C_M == client->state);
+
+        //M: downgrade returns dirty
+        CPPUNIT_ASSERT_EQUAL(true, client->functional_downgrade());
+        CPPUNIT_ASSERT(MESI_C_S == client->state);
+
+        //S: load hits; store needs an upgrade
+        CPPUNIT_ASSERT_EQUAL(true, client->functional_access(false));
+        CPPUNIT_ASSERT_EQUAL(false, client->functional_access(true));
+        CPPUNIT_ASSERT(MESI_C_S == client->state);
+        client->functional_fill(true, true);
+        CPPUNIT_ASSERT(MESI_C_M == client->state);
+
+        //eviction from M notifies manager; from S it is silent.
+        CPPUNIT_ASSERT_EQUAL(true, client->functional_evict());
+        CPPUNIT_ASSERT(MESI_C_I == client->state);
+        client->functional_fill(false, false);
+        CPPUNIT_ASSERT(MESI_C_S == client->state);
+        CPPUNIT_ASSERT_EQUAL(false, client->functional_evict());
+        CPPUNIT_ASSERT(MESI_C_I == client->state);
+
+        //invalidation in E is clean
+        client->transition_to_e();
+        CPPUNIT_ASSERT_EQUAL(false, client->functional_invalidate());
+        CPPUNIT_ASSERT(MESI_C_I == client->state);
+
+        CPPUNIT_ASSERT_EQUAL(0, (int)((My_MESI_client*)client)->get_messages().size()); //no msg sent
+    }
+
     //! Build a test suite.
     static CppUnit::Test* suite()
     {
@@ -384,6 +428,7 @@ public:
         mySuite->addTest(new CppUnit::TestCaller<MESI_clientTest>("test EI State", &MESI_clientTest::testEIState));
         mySuite->addTest(new CppUnit::TestCaller<MESI_clientTest>("test MI State", &MESI_clientTest::testMIState));
         mySuite->addTest(new CppUnit::TestCaller<MESI_clientTest>("test SE State", &MESI_clientTest::testSEState));
+        mySuite->addTest(new CppUnit::TestCaller<MESI_clientTest>("test functional", &MESI_clientTest::testFunctional));
         return mySuite;
     }
 };
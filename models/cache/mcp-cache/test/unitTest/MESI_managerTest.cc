@@ -448,6 +448,75 @@ public:
     }
 
 
+
+    //======================================================================
+    //======================================================================
+    //! Test functional warmup: no message is sent and the manager ends up in the
+    //! stable state it would reach in timing mode.
+    void testFunctional()
+    {
+        int C0 = random() % 1024;
+	int C1;
+	while((C1 = random() % 1024) == C0);
+	int C2;
+	while((C2 = random() % 1024) == C0 || C2 == C1);
+
+	vector<int> invalidates;
+	int downgrade;
+
+        //I: a load is granted exclusively
+        manager->transition_to_i();
+	((My_MESI_manager*)manager)->clear(); //transition_to_i() calls invalidate()
+	CPPUNIT_ASSERT_EQUAL(true, manager->functional_request(C0, false, invalidates, downgrade));
+        CPPUNIT_ASSERT(MESI_MNG_E == manager->state);
+        CPPUNIT_ASSERT_EQUAL(C0, manager->owner);
+        CPPUNIT_ASSERT_EQUAL(0, (int)invalidates.size());
+        CPPUNIT_ASSERT_EQUAL(-1, downgrade);
+
+        //E: a load downgrades the owner
+	CPPUNIT_ASSERT_EQUAL(false, manager->functional_request(C1, false, invalidates, downgrade));
+        CPPUNIT_ASSERT(MESI_MNG_S == manager->state);
+        CPPUNIT_ASSERT_EQUAL(C0, downgrade);
+        CPPUNIT_ASSERT_EQUAL(true, manager->sharersList.get(C0));
+        CPPUNIT_ASSERT_EQUAL(true, manager->sharersList.get(C1));
+
+        //S: a load adds a sharer
+	CPPUNIT_ASSERT_EQUAL(false, manager->functional_request(C2, false, invalidates, downgrade));
+        CPPUNIT_ASSERT(MESI_MNG_S == manager->state);
+        CPPUNIT_ASSERT_EQUAL(3, manager->sharersList.count());
+
+        //S: a store invalidates all other sharers
+	CPPUNIT_ASSERT_EQUAL(true, manager->functional_request(C0, true, invalidates, downgrade));
+        CPPUNIT_ASSERT(MESI_MNG_E == manager->state);
+        CPPUNIT_ASSERT_EQUAL(C0, manager->owner);
+        CPPUNIT_ASSERT_EQUAL(2, (int)invalidates.size());
+        CPPUNIT_ASSERT_EQUAL(0, manager->sharersList.count());
+
+        //E: a store invalidates the owner
+	invalidates.clear();
+	CPPUNIT_ASSERT_EQUAL(true, manager->functional_request(C1, true, invalidates, downgrade));
+        CPPUNIT_ASSERT(MESI_MNG_E == manager->state);
+        CPPUNIT_ASSERT_EQUAL(C1, manager->owner);
+        CPPUNIT_ASSERT_EQUAL(1, (int)invalidates.size());
+        CPPUNIT_ASSERT_EQUAL(C0, invalidates[0]);
+
+        //put from a non-owner is ignored; put from the owner releases the line.
+	CPPUNIT_ASSERT_EQUAL(false, manager->functional_put(C0));
+	CPPUNIT_ASSERT_EQUAL(true, manager->functional_put(C1));
+        CPPUNIT_ASSERT(MESI_MNG_I == manager->state);
+
+        //eviction returns the holders
+	manager->functional_request(C0, false, invalidates, downgrade);
+	vector<int> holders;
+	manager->functional_evict(holders);
+        CPPUNIT_ASSERT(MESI_MNG_I == manager->state);
+        CPPUNIT_ASSERT_EQUAL(1, (int)holders.size());
+        CPPUNIT_ASSERT_EQUAL(C0, holders[0]);
+
+        CPPUNIT_ASSERT_EQUAL(0, (int)((My_MESI_manager*)manager)->get_messages().size()); //no msg sent
+        CPPUNIT_ASSERT_EQUAL(false, ((My_MESI_manager*)manager)->get_invalidate_called());
+    }
+
     //! Build a test suite.
     static CppUnit::Test* suite()
     {
@@ -465,6 +534,7 @@ public:
         mySuite->addTest(new CppUnit::TestCaller<MESI_managerTest>("test SS State", &MESI_managerTest::testSSState));
         mySuite->addTest(new CppUnit::TestCaller<MESI_managerTest>("test SI EVICT State", &MESI_managerTest::testSIEVICTState));
         mySuite->addTest(new CppUnit::TestCaller<MESI_managerTest>("test SIE State", &MESI_managerTest::testSIEState));
+        mySuite->addTest(new CppUnit::TestCaller<MESI_managerTest>("test functional", &MESI_managerTest::testFunctional));
 	/*
 	*/
         return mySuite;
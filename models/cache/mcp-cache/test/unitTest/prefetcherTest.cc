@@ -0,0 +1,265 @@
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include "prefetcher.h"
+
+using namespace std;
+using namespace manifold::mcp_cache_namespace;
+
+
+//####################################################################
+//! Class prefetcherTest is the unit test class for the prefetchers.
+//####################################################################
+class prefetcherTest : public CppUnit::TestFixture {
+    private:
+	static const int BLOCK_SIZE = 32;
+
+	static paddr_t random_line_addr()
+	{
+	    //keep away from 0 so lines below the address exist.
+	    return (paddr_t)(random() % 0x100000 + 0x1000) * BLOCK_SIZE;
+	}
+
+    public:
+
+        //======================================================================
+        //======================================================================
+	//! @brief Test Create()
+	//!
+	//! No prefetcher is created for PREFETCH_NONE; otherwise the requested one is.
+	void test_Create_0()
+	{
+	    prefetch_settings settings;
+	    CPPUNIT_ASSERT(Prefetcher :: Create(BLOCK_SIZE, settings) == 0);
+
+	    const prefetcher_type_t types[] = {PREFETCH_NEXT_LINE, PREFETCH_STRIDE, PREFETCH_STREAM};
+	    const char* names[] = {"next_line", "stride", "stream"};
+	    for(int i=0; i<3; i++) {
+		settings.type = types[i];
+		Prefetcher* pf = Prefetcher :: Create(BLOCK_SIZE, settings);
+		CPPUNIT_ASSERT(pf != 0);
+		CPPUNIT_ASSERT(strcmp(names[i], pf->get_name()) == 0);
+		CPPUNIT_ASSERT_EQUAL(types[i], Prefetcher :: Parse_type(names[i]));
+		delete pf;
+	    }
+	    CPPUNIT_ASSERT_EQUAL(PREFETCH_NONE, Prefetcher :: Parse_type("none"));
+	}
+
+
+
+        //======================================================================
+        //======================================================================
+	//! @brief Test next line prefetcher
+	//!
+	//! Nothing is proposed unless the access is a trigger; a trigger proposes the
+	//! next degree lines.
+	void test_next_line_0()
+	{
+	    prefetch_settings settings;
+	    settings.type = PREFETCH_NEXT_LINE;
+	    settings.degree = random() % 4 + 1;
+	    Prefetcher* pf = Prefetcher :: Create(BLOCK_SIZE, settings);
+
+	    paddr_t addr = random_line_addr() + random() % BLOCK_SIZE;
+	    vector<paddr_t> candidates;
+
+	    pf->train(addr, 0, false, candidates);
+	    CPPUNIT_ASSERT_EQUAL(0, (int)candidates.size());
+
+	    pf->train(addr, 0, true, candidates);
+	    CPPUNIT_ASSERT_EQUAL(settings.degree, (int)candidates.size());
+	    paddr_t line_addr = addr - addr % BLOCK_SIZE;
+	    for(int i=0; i<settings.degree; i++)
+		CPPUNIT_ASSERT_EQUAL(line_addr + (i+1)*BLOCK_SIZE, candidates[i]);
+
+	    delete pf;
+	}
+
+
+
+        //======================================================================
+        //======================================================================
+	//! @brief Test stride prefetcher
+	//!
+	//! The same stride seen twice by an instruction proposes the lines up to degree
+	//! strides ahead, whether or not the access is a trigger.
+	void test_stride_0()
+	{
+	    prefetch_settings settings;
+	    settings.type = PREFETCH_STRIDE;
+	    settings.degree = 2;
+	    Prefetcher* pf = Prefetcher :: Create(BLOCK_SIZE, settings);
+
+	    const paddr_t pc = 0x400123;
+	    const paddr_t stride = 8 * BLOCK_SIZE;
+	    paddr_t addr = random_line_addr();
+	    vector<paddr_t> candidates;
+
+	    pf->train(addr, pc, true, candidates);
+	    pf->train(addr + stride, pc, false, candidates);
+	    CPPUNIT_ASSERT_EQUAL(0, (int)candidates.size());
+
+	    pf->train(addr + 2*stride, pc, false, candidates);
+	    CPPUNIT_ASSERT_EQUAL(2, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr + 3*stride, candidates[0]);
+	    CPPUNIT_ASSERT_EQUAL(addr + 4*stride, candidates[1]);
+
+	    //an access by another instruction doesn't disturb the stream.
+	    candidates.clear();
+	    pf->train(random_line_addr(), pc + 4, true, candidates);
+	    pf->train(addr + 3*stride, pc, false, candidates);
+	    CPPUNIT_ASSERT_EQUAL(2, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr + 4*stride, candidates[0]);
+	    CPPUNIT_ASSERT_EQUAL(addr + 5*stride, candidates[1]);
+
+	    delete pf;
+	}
+
+
+
+        //======================================================================
+        //======================================================================
+	//! @brief Test stride prefetcher
+	//!
+	//! With strides smaller than a line, each line is proposed only once and the line
+	//! being accessed is not proposed.
+	void test_stride_1()
+	{
+	    prefetch_settings settings;
+	    settings.type = PREFETCH_STRIDE;
+	    settings.degree = 4;
+	    Prefetcher* pf = Prefetcher :: Create(BLOCK_SIZE, settings);
+
+	    const paddr_t pc = 0x400200;
+	    const paddr_t stride = BLOCK_SIZE / 4;
+	    paddr_t addr = random_line_addr();
+	    vector<paddr_t> candidates;
+
+	    pf->train(addr, pc, true, candidates);
+	    pf->train(addr + stride, pc, false, candidates);
+	    pf->train(addr + 2*stride, pc, false, candidates);
+	    //addr+3*stride is in the same line; addr+4*stride to addr+6*stride are in the next line.
+	    CPPUNIT_ASSERT_EQUAL(1, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr + BLOCK_SIZE, candidates[0]);
+
+	    delete pf;
+	}
+
+
+
+        //======================================================================
+        //======================================================================
+	//! @brief Test stream prefetcher
+	//!
+	//! An ascending stream of triggers is detected after two steps; prefetches then
+	//! continue where the previous ones stopped, up to distance lines ahead.
+	void test_stream_0()
+	{
+	    prefetch_settings settings;
+	    settings.type = PREFETCH_STREAM;
+	    settings.degree = 2;
+	    settings.distance = 4;
+	    Prefetcher* pf = Prefetcher :: Create(BLOCK_SIZE, settings);
+
+	    paddr_t addr = random_line_addr();
+	    vector<paddr_t> candidates;
+
+	    pf->train(addr, 0, true, candidates);
+	    pf->train(addr + BLOCK_SIZE, 0, true, candidates);
+	    pf->train(addr + BLOCK_SIZE, 0, false, candidates); //not a trigger
+	    CPPUNIT_ASSERT_EQUAL(0, (int)candidates.size());
+
+	    pf->train(addr + 2*BLOCK_SIZE, 0, true, candidates);
+	    CPPUNIT_ASSERT_EQUAL(2, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr + 3*BLOCK_SIZE, candidates[0]);
+	    CPPUNIT_ASSERT_EQUAL(addr + 4*BLOCK_SIZE, candidates[1]);
+
+	    candidates.clear();
+	    pf->train(addr + 3*BLOCK_SIZE, 0, true, candidates);
+	    CPPUNIT_ASSERT_EQUAL(2, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr + 5*BLOCK_SIZE, candidates[0]);
+	    CPPUNIT_ASSERT_EQUAL(addr + 6*BLOCK_SIZE, candidates[1]);
+
+	    candidates.clear();
+	    pf->train(addr + 4*BLOCK_SIZE, 0, true, candidates);
+	    CPPUNIT_ASSERT_EQUAL(2, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr + 7*BLOCK_SIZE, candidates[0]);
+	    CPPUNIT_ASSERT_EQUAL(addr + 8*BLOCK_SIZE, candidates[1]);
+
+	    //the stream is already 3 lines ahead, so only 1 more line is allowed.
+	    candidates.clear();
+	    pf->train(addr + 5*BLOCK_SIZE, 0, true, candidates);
+	    CPPUNIT_ASSERT_EQUAL(1, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr + 9*BLOCK_SIZE, candidates[0]);
+
+	    delete pf;
+	}
+
+
+
+        //======================================================================
+        //======================================================================
+	//! @brief Test stream prefetcher
+	//!
+	//! Descending streams are detected too, and separate streams use separate trackers.
+	void test_stream_1()
+	{
+	    prefetch_settings settings;
+	    settings.type = PREFETCH_STREAM;
+	    settings.degree = 1;
+	    settings.distance = 4;
+	    Prefetcher* pf = Prefetcher :: Create(BLOCK_SIZE, settings);
+
+	    paddr_t addr1 = random_line_addr();
+	    paddr_t addr2 = addr1 + 1000 * BLOCK_SIZE;
+	    vector<paddr_t> candidates;
+
+	    for(int i=0; i<3; i++) {
+		pf->train(addr1 - i*BLOCK_SIZE, 0, true, candidates);
+		pf->train(addr2 + i*BLOCK_SIZE, 0, true, candidates);
+	    }
+	    CPPUNIT_ASSERT_EQUAL(2, (int)candidates.size());
+	    CPPUNIT_ASSERT_EQUAL(addr1 - 3*BLOCK_SIZE, candidates[0]);
+	    CPPUNIT_ASSERT_EQUAL(addr2 + 3*BLOCK_SIZE, candidates[1]);
+
+	    delete pf;
+	}
+
+
+
+	//! Build a test suite.
+	static CppUnit::Test* suite()
+	{
+	    CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("prefetcherTest");
+
+	    mySuite->addTest(new CppUnit::TestCaller<prefetcherTest>("test_Create_0", &prefetcherTest::test_Create_0));
+	    mySuite->addTest(new CppUnit::TestCaller<prefetcherTest>("test_next_line_0", &prefetcherTest::test_next_line_0));
+	    mySuite->addTest(new CppUnit::TestCaller<prefetcherTest>("test_stride_0", &prefetcherTest::test_stride_0));
+	    mySuite->addTest(new CppUnit::TestCaller<prefetcherTest>("test_stride_1", &prefetcherTest::test_stride_1));
+	    mySuite->addTest(new CppUnit::TestCaller<prefetcherTest>("test_stream_0", &prefetcherTest::test_stream_0));
+	    mySuite->addTest(new CppUnit::TestCaller<prefetcherTest>("test_stream_1", &prefetcherTest::test_stream_1));
+
+	    return mySuite;
+	}
+};
+
+
+
+int main()
+{
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( prefetcherTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+
+}
+
@@ -45,6 +45,9 @@ if [ $? -ne 0 ]; then FAIL=1; fi
 eval ./MESI_L2_cacheTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
+eval ./MESI_L2_cacheFreedMsgTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 eval ./MESI_LLP_cacheFlowControlTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
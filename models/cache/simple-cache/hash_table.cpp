@@ -15,60 +15,162 @@ namespace simple_cache {
 
 
 // mshr_entry: Constructor
-mshr_entry::mshr_entry (Cache_req *request)
+mshr_entry::mshr_entry ()
 {
-   creq = request;
+   line = 0;
+   valid = false;
 }
 
 
 
+//! mshr_table: Constructor
+//!
+//! @param \c offset_bits  Number of block offset bits; the low bits of a line address
+//! are 0 and are not used by the hash.
+mshr_table::mshr_table (int ob) : slots(16), offset_bits(ob)
+{
+   num_entries = 0;
+   num_requests = 0;
+}
 
 
-//! hash_entry: Constructor
+//! mshr_table: home_slot
 //!
-//! This is a single cache line
-//! associated with one set within the cache. Contains pointers back
-//! to the parent table and parent set, the address tag associated with
-//! this line, and valid/dirty bits to indicate status.
-hash_entry::hash_entry (hash_table *table, hash_set *set, paddr_t tag, bool valid)
-{
-   this->my_table = table;
-   this->my_set = set;
-   this->tag = tag;
-   this->valid = valid;
-   this->dirty = false;
+//! Fibonacci hashing of the line number.
+unsigned mshr_table::home_slot (paddr_t line) const
+{
+   return (unsigned)(((line >> offset_bits) * 0x9e3779b97f4a7c15ULL) >> 32) & (slots.size() - 1);
 }
 
 
-//! hash_set: Constructor
+//! mshr_table: insert
 //!
-//! This is a set of cache lines, the number
-//! of which is determined by the cache's associativity. Contains a pointer
-//! back to the parent table, the associativity factor, and a list of pointers
-//! to the hash_entries it owns.
-hash_set::hash_set (hash_table *table)
+//! Add a request for the line; requests for the same line share an entry and are
+//! kept in arrival order.
+//! @return True if there's already an entry for the line.
+bool mshr_table::insert (paddr_t line, Cache_req* request)
 {
-    my_table = table;
-    assoc = table->get_assoc();
+   num_requests++;
+
+   mshr_entry* entry = lookup (line);
+   if (entry)
+   {
+      entry->waiters.push_back (request);
+      return true;
+   }
+
+   if (2 * (num_entries + 1) > slots.size())
+      grow ();
+
+   unsigned i = home_slot (line);
+   while (slots[i].valid)
+      i = (i + 1) & (slots.size() - 1);
+
+   slots[i].line = line;
+   slots[i].valid = true;
+   slots[i].waiters.push_back (request);
+   num_entries++;
+   return false;
+}
+
+
+//! mshr_table: lookup
+//!
+//! Return the entry of the line, or NULL if there's none.
+mshr_entry* mshr_table::lookup (paddr_t line)
+{
+   for (unsigned i = home_slot (line); slots[i].valid; i = (i + 1) & (slots.size() - 1))
+   {
+      if (slots[i].line == line)
+         return &slots[i];
+   }
+   return 0;
+}
+
+
+//! mshr_table: remove
+//!
+//! Remove an entry together with its waiters. The entries after it in the same
+//! cluster are shifted back so that lookups never need tombstones.
+void mshr_table::remove (mshr_entry* entry)
+{
+   const unsigned mask = slots.size() - 1;
+   unsigned i = entry - &slots[0];
+
+   assert (slots[i].valid);
+   num_requests -= slots[i].waiters.size();
+   num_entries--;
+
+   for (unsigned j = (i + 1) & mask; slots[j].valid; j = (j + 1) & mask)
+   {
+      const unsigned k = home_slot (slots[j].line);
+      //move slot j to the hole at i unless its home slot is cyclically in (i, j]
+      if (((j - k) & mask) >= ((j - i) & mask))
+      {
+         slots[i].line = slots[j].line;
+         slots[i].waiters.swap (slots[j].waiters);
+         i = j;
+      }
+   }
 
-    // initialize the hash_entry list - all entries initialized to tag
-    // 0x0 and marked invalid
-    set_entries.clear();
-    for (int i = 0; i < assoc; i++)
-        set_entries.push_front(new hash_entry (table, this, 0x0, false));
+   slots[i].valid = false;
+   slots[i].waiters.clear();
 }
 
 
-hash_set::~hash_set (void)
+//! mshr_table: grow
+//!
+//! Double the number of slots and re-insert the entries.
+void mshr_table::grow ()
 {
-   while (!set_entries.empty ())
+   std::vector<mshr_entry> old (2 * slots.size());
+   old.swap (slots);
+
+   const unsigned mask = slots.size() - 1;
+   for (unsigned j = 0; j < old.size(); j++)
    {
-      delete set_entries.back();
-      set_entries.pop_back();
+      if (!old[j].valid)
+         continue;
+      unsigned i = home_slot (old[j].line);
+      while (slots[i].valid)
+         i = (i + 1) & mask;
+      slots[i].line = old[j].line;
+      slots[i].valid = true;
+      slots[i].waiters.swap (old[j].waiters);
    }
 }
 
 
+
+
+
+//! hash_entry: Constructor
+//!
+//! This is a single cache line. Contains the address tag associated with
+//! this line, valid/dirty bits to indicate status, and when it was last used.
+hash_entry::hash_entry ()
+{
+   this->tag = 0;
+   this->last_access = 0;
+   this->valid = false;
+   this->dirty = false;
+}
+
+
+//! hash_set: Constructor
+//!
+//! This is a set of cache lines, the number
+//! of which is determined by the cache's associativity. Contains a pointer
+//! back to the parent table, the associativity factor, and an array of
+//! the hash_entries it owns.
+hash_set::hash_set (hash_table *table) : set_entries(table->get_assoc())
+{
+    my_table = table;
+    assoc = table->get_assoc();
+    access_count = 0;
+}
+
+
 //! Calls get_entry to determine whether the request is a hit or miss. If get_entry
 //! returns NULL, we have a miss. Otherwise, we have a hit and we update the LRU
 //! status of the member entries.
@@ -88,46 +190,50 @@ bool hash_set::process_request (paddr_t addr)
 //! hash_set: get_entry
 //!
 //! Loops through each entry in the set to see if there's a tag match. Return NULL
-//! if there's no match. Otherwise, return a pointer to the matching entry.
+//! if there's no match. Otherwise, return a pointer to the matching entry; if more
+//! than one match, the most recently used.
 hash_entry* hash_set::get_entry (paddr_t tag)
 {
-   list<hash_entry *>::iterator it;
+   hash_entry* found = 0;
 
-   for (it = set_entries.begin(); it != set_entries.end(); it++)
+   for (int i = 0; i < assoc; i++)
    {
-      if ((tag == (*it)->tag) && (*it)->valid)
-      {
-         return *it;
-      }
+      hash_entry* e = &set_entries[i];
+      if ((tag == e->tag) && e->valid && (!found || e->last_access > found->last_access))
+         found = e;
    }
 
-   return 0;
+   return found;
 }
 
-//! hash_set: replace_entry
+//! hash_set: get_replacement_entry
 //!
-//! Replaces a line in the set with a tag; Place the entry
-//! at the front of the list so that it's ranked as MRU.
-void hash_set::replace_entry (paddr_t new_tag)
+//! Return the least recently used entry. Entries that have never been filled
+//! are older than all others.
+hash_entry* hash_set::get_replacement_entry (void)
 {
-    hash_entry* victim = set_entries.back();
-    set_entries.pop_back();
-    victim->tag = new_tag;
-    victim->valid = true;
-    victim->dirty = false;
-    set_entries.push_front(victim);
+   hash_entry* victim = &set_entries[0];
 
-}
+   for (int i = 1; i < assoc; i++)
+   {
+      if (set_entries[i].last_access < victim->last_access)
+         victim = &set_entries[i];
+   }
 
+   return victim;
+}
 
-//! hash_set: update_lru
+//! hash_set: replace_entry
 //!
-//! On a hit, move this entry to the front of the list to indicate
-//! MRU status.
-void hash_set::update_lru (hash_entry *entry)
+//! Replaces the LRU line in the set with a tag and mark
+//! the entry as MRU.
+void hash_set::replace_entry (paddr_t new_tag)
 {
-   set_entries.remove (entry);
-   set_entries.push_front (entry);
+    hash_entry* victim = get_replacement_entry();
+    victim->tag = new_tag;
+    victim->valid = true;
+    victim->dirty = false;
+    update_lru (victim);
 }
 
 
@@ -164,49 +270,12 @@ hash_table::hash_table (int sz, int as, int block, int hit, int lookup)
     offset_mask = ~0x0;
     offset_mask = offset_mask << num_offset_bits;
 
-    for (int i = 0; i < sets; i++)
-        my_sets[i] = new hash_set (this);
-
+    my_sets.assign (sets, hash_set (this));
 }
 
 
 hash_table::~hash_table (void)
 {
-   for (int i = 0; i < sets; i++)
-      delete my_sets[i];
-   my_sets.clear();
-}
-
-//! hash_table: get_tag
-//!
-//! Mask out the tag bits from the address and return the tag.
-paddr_t hash_table::get_tag (paddr_t addr)
-{
-   return (addr & tag_mask);
-}
-
-//! hash_table: get_index
-//!
-//! Mask out the index bits from the address and return the index.
-paddr_t hash_table::get_index (paddr_t addr)
-{
-   return ((addr & index_mask) >> num_offset_bits);
-}
-
-//! hash_table: get_line_addr
-//!
-//! Mask out the offset bits from the address and return the tag plus index.
-paddr_t hash_table::get_line_addr (paddr_t addr)
-{
-   return (addr & offset_mask);
-}
-
-//! hash_table: get_set
-//!
-//! Return a pointer to the set addressed.
-hash_set* hash_table::get_set (paddr_t addr)
-{
-   return my_sets[get_index (addr)];
 }
 
 //! hash_table: get_entry
@@ -214,7 +283,7 @@ hash_set* hash_table::get_set (paddr_t addr)
 //! Return a pointer to the cache line addressed.
 hash_entry* hash_table::get_entry (paddr_t addr)
 {
-   return my_sets[get_index (addr)]->get_entry (get_tag (addr));
+   return my_sets[get_index (addr)].get_entry (get_tag (addr));
 }
 
 
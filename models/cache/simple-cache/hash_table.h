@@ -1,8 +1,7 @@
 #ifndef MANIFOLD_SIMPLE_CACHE_HASH_TABLE_H_
 #define MANIFOLD_SIMPLE_CACHE_HASH_TABLE_H_
 
-#include <list>
-#include <map>
+#include <vector>
 #include <stdint.h>
 
 
@@ -17,21 +16,50 @@ class hash_table;
 
 class Cache_req;
 
+//! An outstanding load miss: the line address and the requests waiting for it,
+//! oldest first.
 class mshr_entry {
 public:
-    mshr_entry (Cache_req *request);
+    mshr_entry ();
 
-    Cache_req *creq;
+    paddr_t line;
+    bool valid;
+    std::vector<Cache_req*> waiters;
+};
+
+
+//! The MSHR: an open-addressed hash table of mshr_entry keyed by line address, so
+//! finding the entry of a line doesn't depend on the number of outstanding misses.
+class mshr_table {
+public:
+    mshr_table (int offset_bits);
+
+    bool insert (paddr_t line, Cache_req* request);
+    mshr_entry* lookup (paddr_t line);
+    void remove (mshr_entry* entry);
+
+    //! Number of requests in the MSHR, including those merged into an earlier miss.
+    unsigned size () const { return num_requests; }
+
+#ifndef SIMPLE_CACHE_UTEST
+private:
+#endif
+    unsigned home_slot (paddr_t line) const;
+    void grow ();
+
+    std::vector<mshr_entry> slots; //size is a power of 2
+    const int offset_bits;
+    unsigned num_entries; //valid slots
+    unsigned num_requests;
 };
 
 
 class hash_entry {
    public:
-      hash_entry (hash_table *table, hash_set *set, paddr_t tag, bool valid);
+      hash_entry ();
 
-      hash_table *my_table;
-      hash_set *my_set;
       paddr_t tag;
+      uint64_t last_access; //value of the set's access counter when last used; 0 if never
       bool valid;
       bool dirty;
 };
@@ -39,21 +67,21 @@ class hash_entry {
 class hash_set {
    public:
       hash_set (hash_table *table);
-      ~hash_set (void);
 
       bool process_request (paddr_t addr);
       hash_entry* get_entry (paddr_t tag);
       void replace_entry (paddr_t addr);
-      //hash_entry* get_replacement_entry (void);
+      hash_entry* get_replacement_entry (void);
 
 #ifndef SIMPLE_CACHE_UTEST
    private:
 #endif
-      void update_lru (hash_entry *entry);
+      void update_lru (hash_entry *entry) { entry->last_access = ++access_count; }
 
       hash_table *my_table;
       int assoc;
-      std::list<hash_entry *> set_entries;
+      uint64_t access_count; //incremented on every hit and fill
+      std::vector<hash_entry> set_entries;
 };
 
 
@@ -70,9 +98,9 @@ class hash_table {
       int get_index_bits() const { return num_index_bits; }
       int get_offset_bits() const { return num_offset_bits; }
       paddr_t get_tag_mask() const { return tag_mask; }
-      paddr_t get_tag (paddr_t addr);
-      paddr_t get_index (paddr_t addr);
-      paddr_t get_line_addr (paddr_t addr);
+      paddr_t get_tag (paddr_t addr) const { return addr & tag_mask; }
+      paddr_t get_index (paddr_t addr) const { return (addr & index_mask) >> num_offset_bits; }
+      paddr_t get_line_addr (paddr_t addr) const { return addr & offset_mask; }
 
       bool process_request (paddr_t addr);
       void process_response (paddr_t addr);
@@ -80,7 +108,7 @@ class hash_table {
 #ifndef SIMPLE_CACHE_UTEST
    private:
 #endif
-      hash_set* get_set (paddr_t addr);
+      hash_set* get_set (paddr_t addr) { return &my_sets[get_index (addr)]; }
       hash_entry* get_entry (paddr_t addr);
 
       int size;
@@ -97,8 +125,7 @@ class hash_table {
       paddr_t index_mask;
       paddr_t offset_mask;
 
-      std::map<paddr_t, hash_set *> my_sets;
-      //std::list<mshr_entry *> mshr_buffer;
+      std::vector<hash_set> my_sets; //indexed by set index
 };
 
 } //namespace simple_cache
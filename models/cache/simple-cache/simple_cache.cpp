@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <math.h>
 #include "kernel/component.h"
 #include "simple_cache.h"
 
@@ -30,6 +31,7 @@ namespace manifold {
 namespace simple_cache {
 
 simple_cache::simple_cache(int nid, const char* name, const Simple_cache_parameters& parameters, const Simple_cache_init& init) :
+    m_mshr((int) log2 (parameters.block_size)),
     m_node_id(nid),
     m_name(name),
     m_IS_FIRST_LEVEL(init.first_level), m_IS_LAST_LEVEL(init.last_level)
@@ -171,24 +173,13 @@ void simple_cache :: write_hit(Cache_req* creq)
 
 
 
-//! Create an MSHR entry for the request.
+//! Put the request in the MSHR.
 //! @return True if there's already an entry for the same line in the MSHR.
 bool simple_cache::insert_mshr_entry (Cache_req *request)
 {
     assert(request->op_type == OpMemLd);
 
-    bool found = false;
-    list<mshr_entry *>::iterator it;
-    for (it = m_mshr.begin(); it != m_mshr.end(); it++)
-    {
-	if (my_table->get_line_addr ((*it)->creq->addr) == my_table->get_line_addr (request->addr)) {
-	    found = true;
-	    break;
-        }
-    }
-
-    m_mshr.push_back (new mshr_entry(request));
-    return found;
+    return m_mshr.insert (my_table->get_line_addr (request->addr), request);
 }
 
 
@@ -215,20 +206,18 @@ void simple_cache::handle_response (int port, Mem_req *mreq)
 }
 
 
+//! Reply to all requests waiting for the line, in the order they arrived.
 void simple_cache::free_mshr_entries (paddr_t addr)
 {
-    list<mshr_entry *>::iterator it = m_mshr.begin();
-
-    while ( it != m_mshr.end() ) {
-        if (my_table->get_line_addr ((*it)->creq->addr) == my_table->get_line_addr (addr)) {
-	    //For load response, we need to process replacement, MSHR, etc. Therefore, there should be a delay.
-	    reply_to_lower((*it)->creq, my_table->get_hit_time());
-            delete (*it);
-            it = m_mshr.erase (it); //erase() returns the iterator pointing to the next element
-        }
-        else
-            ++it;
+    mshr_entry* entry = m_mshr.lookup (my_table->get_line_addr (addr));
+    if (entry == 0)
+        return;
+
+    for (unsigned i = 0; i < entry->waiters.size(); i++) {
+	//For load response, we need to process replacement, MSHR, etc. Therefore, there should be a delay.
+	reply_to_lower(entry->waiters[i], my_table->get_hit_time());
     }
+    m_mshr.remove (entry);
 }
 
 
@@ -48,7 +48,7 @@ public:
 protected:
 #endif
     hash_table *my_table;
-    std::list<mshr_entry*> m_mshr;
+    mshr_table m_mshr;
 
     const int m_node_id;
     const char* m_name;
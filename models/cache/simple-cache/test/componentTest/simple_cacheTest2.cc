@@ -214,8 +214,10 @@ public:
 
         //verify MSHR
 	CPPUNIT_ASSERT_EQUAL(1, int(m_cachep->m_mshr.size()));
-	CPPUNIT_ASSERT_EQUAL(addr, m_cachep->m_mshr.front()->creq->addr);
-	GenericPreqWrapper<CacheReq>* wrapper = dynamic_cast<GenericPreqWrapper<CacheReq>*>(m_cachep->m_mshr.front()->creq->preqWrapper);
+	mshr_entry* mentry = m_cachep->m_mshr.lookup(m_cachep->my_table->get_line_addr(addr));
+	CPPUNIT_ASSERT(mentry != 0);
+	CPPUNIT_ASSERT_EQUAL(addr, mentry->waiters.front()->addr);
+	GenericPreqWrapper<CacheReq>* wrapper = dynamic_cast<GenericPreqWrapper<CacheReq>*>(mentry->waiters.front()->preqWrapper);
 	CPPUNIT_ASSERT(creq == wrapper->preq);
 
         //verify the sink gets a req.
@@ -1178,8 +1180,10 @@ public:
 
         //verify MSHR
 	CPPUNIT_ASSERT_EQUAL(1 + num_loads, int(m_cachep->m_mshr.size()));
-	CPPUNIT_ASSERT_EQUAL(addr, m_cachep->m_mshr.front()->creq->addr);
-	GenericPreqWrapper<CacheReq>* wrapper = dynamic_cast<GenericPreqWrapper<CacheReq>*>(m_cachep->m_mshr.front()->creq->preqWrapper);
+	mshr_entry* mentry = m_cachep->m_mshr.lookup(m_cachep->my_table->get_line_addr(addr));
+	CPPUNIT_ASSERT(mentry != 0);
+	CPPUNIT_ASSERT_EQUAL(addr, mentry->waiters.front()->addr);
+	GenericPreqWrapper<CacheReq>* wrapper = dynamic_cast<GenericPreqWrapper<CacheReq>*>(mentry->waiters.front()->preqWrapper);
 	CPPUNIT_ASSERT(creq == wrapper->preq);
 
         //verify the sink gets req.
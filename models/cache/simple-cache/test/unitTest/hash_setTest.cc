@@ -7,6 +7,8 @@
 
 #include <iostream>
 #include <set>
+#include <vector>
+#include <algorithm>
 #include <stdlib.h>
 #include "hash_table.h"
 
@@ -38,6 +40,18 @@ public:
 	m_table = new hash_table(size, assoc, block_size, hit_time, lookup_time);
     }
 
+    //! Return the entries of the set from the most to the least recently used.
+    static vector<hash_entry*> lru_order(hash_set* myset)
+    {
+	vector<hash_entry*> entries;
+	for(unsigned i=0; i<myset->set_entries.size(); i++)
+	    entries.push_back(&myset->set_entries[i]);
+	sort(entries.begin(), entries.end(), more_recent);
+	return entries;
+    }
+
+    static bool more_recent(const hash_entry* a, const hash_entry* b) { return a->last_access > b->last_access; }
+
     void mySetUp2(int assoc)
     {
 	int size = 0x1 << (random() % 10 + 13); //8K to 4M
@@ -63,9 +77,9 @@ public:
 	    CPPUNIT_ASSERT_EQUAL(assocs[i], (int)myset->set_entries.size());
 
 	    //check all hash entries
-	    for(list<hash_entry*>::iterator it = myset->set_entries.begin(); it != myset->set_entries.end();
+	    for(vector<hash_entry>::iterator it = myset->set_entries.begin(); it != myset->set_entries.end();
 		      ++it) {
-		hash_entry* entry = *it;
+		hash_entry* entry = &(*it);
 		CPPUNIT_ASSERT_EQUAL(false, entry->valid);
 		CPPUNIT_ASSERT_EQUAL(false, entry->dirty);
 	    }
@@ -166,7 +180,7 @@ public:
 	    myset->replace_entry(tags[i]);
 	}
 
-	CPPUNIT_ASSERT_EQUAL(tags[0], myset->set_entries.back()->tag);
+	CPPUNIT_ASSERT_EQUAL(tags[0], myset->get_replacement_entry()->tag);
 
 	delete myset;
 	delete m_table;
@@ -213,10 +227,9 @@ public:
 	    myset->replace_entry(tags[i]);
 	}
 
-	int i=0;
-	for(std::list<hash_entry*>::iterator it=myset->set_entries.begin();
-	                              it != myset->set_entries.end(); ++it, ++i) {
-	    CPPUNIT_ASSERT_EQUAL(tags[Ntags-1-i], (*it)->tag);
+	vector<hash_entry*> entries = lru_order(myset);
+	for(int i=0; i<assoc; i++) {
+	    CPPUNIT_ASSERT_EQUAL(tags[Ntags-1-i], entries[i]->tag);
 	}
 
 
@@ -276,7 +289,7 @@ public:
 	myset->update_lru(e);
 
 	//verify the one we just picked is in the front
-	CPPUNIT_ASSERT_EQUAL(tags[Ntags-assoc+idx], myset->set_entries.front()->tag);
+	CPPUNIT_ASSERT_EQUAL(tags[Ntags-assoc+idx], lru_order(myset).front()->tag);
 
 	delete myset;
 	delete m_table;
@@ -384,7 +397,7 @@ public:
 	CPPUNIT_ASSERT(true == myset->process_request(tags[Ntags-assoc+idx]));
 
 	//in addition, the one we just picked is in the front
-	CPPUNIT_ASSERT_EQUAL(tags[Ntags-assoc+idx], myset->set_entries.front()->tag);
+	CPPUNIT_ASSERT_EQUAL(tags[Ntags-assoc+idx], lru_order(myset).front()->tag);
 
 	delete myset;
 	delete m_table;
@@ -0,0 +1,142 @@
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <stdlib.h>
+#include "hash_table.h"
+#include "cache_req.h"
+
+//using namespace manifold::kernel;
+using namespace std;
+using namespace manifold::simple_cache;
+
+//####################################################################
+// helper classes
+//####################################################################
+
+
+
+
+//####################################################################
+//! Class mshr_tableTest is the unit test class for class mshr_table.
+//####################################################################
+class mshr_tableTest : public CppUnit::TestFixture {
+private:
+    static const int OFFSET_BITS = 6;
+
+public:
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test insert() and lookup()
+    //!
+    //! Create an mshr_table; insert N requests to random lines; verify insert() returns
+    //! true iff the line has been inserted before, and lookup() returns the requests of
+    //! each line in the order they were inserted.
+    void test_insert_0()
+    {
+	mshr_table mshr(OFFSET_BITS);
+
+	map<paddr_t, vector<Cache_req*> > expected;
+	const int N = 1000;
+	vector<Cache_req> reqs(N);
+
+	for(int i=0; i<N; i++) {
+	    paddr_t line = (random() % 300) << OFFSET_BITS; //some lines get more than one request
+	    reqs[i].addr = line + random() % (0x1 << OFFSET_BITS);
+	    bool prev = expected.find(line) != expected.end();
+	    CPPUNIT_ASSERT_EQUAL(prev, mshr.insert(line, &reqs[i]));
+	    expected[line].push_back(&reqs[i]);
+	}
+	CPPUNIT_ASSERT_EQUAL((unsigned)N, mshr.size());
+
+	for(map<paddr_t, vector<Cache_req*> >::iterator it = expected.begin(); it != expected.end(); ++it) {
+	    mshr_entry* entry = mshr.lookup(it->first);
+	    CPPUNIT_ASSERT(entry != 0);
+	    CPPUNIT_ASSERT(it->second == entry->waiters);
+	}
+
+	//a line that's not there
+	CPPUNIT_ASSERT(0 == mshr.lookup(301 << OFFSET_BITS));
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test remove()
+    //!
+    //! Create an mshr_table; randomly insert requests and remove lines N times, keeping
+    //! enough lines in the table for many collisions; verify after each step that size()
+    //! is correct and lookup() finds every line in the table with its requests.
+    void test_remove_0()
+    {
+	mshr_table mshr(OFFSET_BITS);
+
+	map<paddr_t, vector<Cache_req*> > expected;
+	unsigned num_reqs = 0;
+	const int N = 20000;
+	vector<Cache_req> reqs(N);
+
+	for(int i=0; i<N; i++) {
+	    paddr_t line = (random() % 200) << OFFSET_BITS;
+	    if(expected.find(line) == expected.end() && expected.size() > 0 && random() % 2 == 0) {
+	        //remove a random line in the table
+		map<paddr_t, vector<Cache_req*> >::iterator it = expected.begin();
+		advance(it, random() % expected.size());
+		mshr_entry* entry = mshr.lookup(it->first);
+		CPPUNIT_ASSERT(entry != 0);
+		num_reqs -= it->second.size();
+		mshr.remove(entry);
+		CPPUNIT_ASSERT(0 == mshr.lookup(it->first));
+		expected.erase(it);
+	    }
+	    else {
+		mshr.insert(line, &reqs[i]);
+		expected[line].push_back(&reqs[i]);
+		num_reqs++;
+	    }
+
+	    CPPUNIT_ASSERT_EQUAL(num_reqs, mshr.size());
+	    for(map<paddr_t, vector<Cache_req*> >::iterator it = expected.begin(); it != expected.end(); ++it) {
+		mshr_entry* entry = mshr.lookup(it->first);
+		CPPUNIT_ASSERT(entry != 0);
+		CPPUNIT_ASSERT(it->second == entry->waiters);
+	    }
+	}
+    }
+
+
+
+
+    //! Build a test suite.
+    static CppUnit::Test* suite()
+    {
+	CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("mshr_tableTest");
+
+	mySuite->addTest(new CppUnit::TestCaller<mshr_tableTest>("test_insert_0", &mshr_tableTest::test_insert_0));
+	mySuite->addTest(new CppUnit::TestCaller<mshr_tableTest>("test_remove_0", &mshr_tableTest::test_remove_0));
+
+	return mySuite;
+    }
+};
+
+
+
+int main()
+{
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( mshr_tableTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+
+}
+
@@ -24,6 +24,9 @@ if [ $? -ne 0 ]; then FAIL=1; fi
 eval ./hash_tableTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
+eval ./mshr_tableTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 
 exit $FAIL
 
@@ -230,6 +230,20 @@ power_t ENERGYLIB_INTSIM::get_runtime_power(double time_tick, double period, cou
   return runtime_power;
 }
 
+bool ENERGYLIB_INTSIM::get_power_coefficients(power_coefficients_t &coefficients)
+{
+  energy_t unit_energy = get_unit_energy();
+
+  // same as get_runtime_power()
+  coefficients.reset();
+  coefficients.read = unit_energy.read;
+  coefficients.write = unit_energy.write;
+  coefficients.baseline = unit_energy.baseline*clock_frequency;
+  coefficients.leakage = unit_energy.leakage*clock_frequency;
+
+  return true;
+}
+
 double ENERGYLIB_INTSIM::get_area(void)
 {
   return param->A;
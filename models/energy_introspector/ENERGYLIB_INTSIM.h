@@ -40,6 +40,7 @@ namespace EI {
     virtual power_t get_runtime_power(double time_tick, double period, counters_t counters);
     virtual double get_area(void);
     virtual void update_variable(string variable, void *value);
+    virtual bool get_power_coefficients(power_coefficients_t &coefficients);
     
   private:
     double energy_scaling;
@@ -1791,6 +1791,23 @@ double ENERGYLIB_MCPAT::get_leakage_power(double time_tick, double period)
   return leakage_power;
 }
 
+bool ENERGYLIB_MCPAT::get_power_coefficients(power_coefficients_t &coefficients)
+{
+  energy_t unit_energy = get_unit_energy();
+
+  // same as get_runtime_power()
+  coefficients.reset();
+  coefficients.baseline_access = unit_energy.baseline;
+  coefficients.search = unit_energy.search;
+  coefficients.read = unit_energy.read;
+  coefficients.write = unit_energy.write;
+  coefficients.read_tag = unit_energy.read_tag;
+  coefficients.write_tag = unit_energy.write_tag;
+  coefficients.leakage = unit_energy.leakage*clock_frequency;
+
+  return true;
+}
+
 
 double ENERGYLIB_MCPAT::get_area(void)
 {
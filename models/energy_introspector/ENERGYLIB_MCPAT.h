@@ -73,6 +73,7 @@ namespace EI {
     virtual double get_leakage_power(double time_tick, double period);
     virtual double get_area(void);
     virtual void update_variable(string variable, void *value);
+    virtual bool get_power_coefficients(power_coefficients_t &coefficients);
     
   private:
     int energy_model;
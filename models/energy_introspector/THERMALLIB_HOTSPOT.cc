@@ -451,6 +451,39 @@ THERMALLIB_HOTSPOT::THERMALLIB_HOTSPOT(string component_name, parameters_t *para
     for(int i = 0; i < EXTRA; i++)
       temperature[i+NL*flp->n_units] = thermal_config.init_temp;
   }
+
+  // the steady-state grid model can be solved by red-black SOR instead of HotSpot's multigrid
+  sor_solver = NULL;
+  sor_ready = false;
+  sor_validate = false;
+  sor_validate_threshold = 0.0;
+
+  set_variable(option,parameters_package,"grid_solver","hotspot");
+  if(!stricmp(option,"sor"))
+  {
+    if((model->type != GRID_MODEL)||(thermal_analysis != STEADY_STATE_ANALYSIS)||model->config->model_secondary)
+      EI_WARNING("HotSpot","grid_solver sor supports only the steady-state grid model without the secondary path -- using HotSpot solver");
+    else
+    {
+      double sor_omega, sor_tolerance;
+      int sor_max_iterations;
+      set_variable(sor_omega,parameters_package,"sor_omega",1.95);
+      set_variable(sor_tolerance,parameters_package,"sor_tolerance",DELTA);
+      set_variable(sor_max_iterations,parameters_package,"sor_max_iterations",100000);
+      if((sor_omega <= 0.0)||(sor_omega >= 2.0))
+        EI_ERROR("HotSpot","sor_omega should be between 0 and 2");
+      if((sor_tolerance <= 0.0)||(sor_max_iterations <= 0))
+        EI_ERROR("HotSpot","sor_tolerance and sor_max_iterations should be greater than zero");
+
+      set_variable(option,parameters_package,"sor_validate","false");
+      sor_validate = stricmp(option,"false");
+      set_variable(sor_validate_threshold,parameters_package,"sor_validate_threshold",0.01);
+
+      sor_solver = new hotspot_sor_solver_t(model->grid,sor_omega,sor_tolerance,sor_max_iterations);
+    }
+  }
+  else if(stricmp(option,"hotspot"))
+    EI_ERROR("HotSpot","unknown grid_solver "+option);
 }
 
 
@@ -656,7 +689,236 @@ void THERMALLIB_HOTSPOT::compute_temperature(double time_tick, double period)
 
   if(thermal_analysis == TRANSIENT_ANALYSIS)  
     compute_temp(model,power,temperature,model->config->sampling_intvl);
+  else if(sor_ready) // warm-started from the previous solution
+  {
+    sor_solver->solve(power,temperature);
+
+    if(sor_validate)
+    {
+      // HotSpot solver overwrites last_steady, from which the next SOR solve starts.
+      grid_model_t *grid = model->grid;
+      int size = grid->n_layers*grid->rows*grid->cols+EXTRA;
+      vector<double> sor_solution(grid->last_steady->cuboid[0][0],grid->last_steady->cuboid[0][0]+size);
+      double *reference = hotspot_vector(model);
+
+      steady_state_temp(model,power,reference);
+
+      double max_diff = 0.0;
+      for(int i = 0; i < grid->total_n_blocks+EXTRA; i++)
+        if(fabs(temperature[i]-reference[i]) > max_diff)
+          max_diff = fabs(temperature[i]-reference[i]);
+
+      copy(sor_solution.begin(),sor_solution.end(),grid->last_steady->cuboid[0][0]);
+      free_dvector(reference);
+
+      if(max_diff > sor_validate_threshold)
+      {
+        char warning_message[128];
+        sprintf(warning_message,"SOR solution differs from HotSpot solver by %lfK at time %lf",max_diff,time_tick);
+        EI_WARNING("HotSpot",warning_message);
+      }
+    }
+  }
   else
+  {
     steady_state_temp(model,power,temperature);
+    sor_ready = (sor_solver != NULL);
+  }
+}
+
+
+hotspot_sor_solver_t::hotspot_sor_solver_t(grid_model_t *grid_model, double sor_omega, double sor_tolerance, int sor_max_iterations) :
+  grid(grid_model),
+  omega(sor_omega),
+  tolerance(sor_tolerance),
+  max_iterations(sor_max_iterations)
+{
+  nl = grid->n_layers;
+  nr = grid->rows;
+  nc = grid->cols;
+  row_pitch = nc+2;
+  layer_pitch = (nr+2)*row_pitch;
+  spidx = nl-DEFAULT_PACK_LAYERS+LAYER_SP;
+  hsidx = nl-DEFAULT_PACK_LAYERS+LAYER_SINK;
+
+  // same conductances as single_iteration_steady_grid()
+  layer_t *l = grid->layers;
+  for(int n = 0; n < nl; n++)
+  {
+    gx.push_back(1.0/l[n].rx);
+    gy.push_back(1.0/l[n].ry);
+    ga.push_back((n > 0)?(1.0/l[n-1].rz):0.0);
+    gb.push_back((n < nl-1)?(1.0/l[n].rz):0.0);
+  }
+
+  // halo cells stay zero
+  int size = (nl+2)*layer_pitch;
+  if(posix_memalign((void**)&t,64,size*sizeof(double))||posix_memalign((void**)&src,64,size*sizeof(double))
+     ||posix_memalign((void**)&inv_diag,64,size*sizeof(double)))
+    EI_ERROR("HotSpot","cannot allocate the SOR grid");
+  memset(t,0,size*sizeof(double));
+  memset(src,0,size*sizeof(double));
+  memset(inv_diag,0,size*sizeof(double));
+
+  package_RC_t *pk = &grid->pack;
+  for(int n = 0; n < nl; n++)
+  {
+    for(int i = 0; i < nr; i++)
+    {
+      for(int j = 0; j < nc; j++)
+      {
+        double diag = ((i > 0)+(i < nr-1))*gy[n]+((j > 0)+(j < nc-1))*gx[n]+ga[n]+gb[n];
+
+        // edge cells of the spreader and heatsink are connected to the package nodes
+        if((n == spidx)||(n == hsidx))
+        {
+          double r1_x = (n == spidx)?pk->r_sp1_x:pk->r_hs1_x;
+          double r1_y = (n == spidx)?pk->r_sp1_y:pk->r_hs1_y;
+          diag += ((i == 0)+(i == nr-1))/(l[n].ry/2.0+nc*r1_y);
+          diag += ((j == 0)+(j == nc-1))/(l[n].rx/2.0+nr*r1_x);
+        }
+        // heatsink is connected to the ambient
+        if(n == hsidx)
+          diag += 1.0/l[n].rz;
+
+        inv_diag[index(n,i,j)] = 1.0/diag;
+      }
+    }
+  }
+
+  p = new_grid_model_vector(grid);
+}
+
+
+hotspot_sor_solver_t::~hotspot_sor_solver_t()
+{
+  free(t);
+  free(src);
+  free(inv_diag);
+  free_grid_model_vector(p);
+}
+
+
+int hotspot_sor_solver_t::solve(double *power, double *temperature)
+{
+  grid_model_vector_t *v = grid->last_steady;
+
+  // package nodes have no power
+  set_internal_power_grid(grid,power);
+  xlate_vector_b2g(grid,power,p,V_POWER);
+
+  // start from the previous solution
+  for(int n = 0; n < nl; n++)
+  {
+    for(int i = 0; i < nr; i++)
+    {
+      memcpy(&t[index(n,i,0)],v->cuboid[n][i],nc*sizeof(double));
+      memcpy(&src[index(n,i,0)],p->cuboid[n][i],nc*sizeof(double));
+      if(n == hsidx)
+        for(int j = 0; j < nc; j++)
+          src[index(n,i,j)] += grid->config.ambient/grid->layers[n].rz;
+    }
+  }
+  update_edge_source();
+
+  int iteration = 0;
+  double delta;
+  do
+  {
+    double red_delta = sweep(0);
+    double black_delta = sweep(1);
+    delta = MAX(red_delta,black_delta);
+
+    // package nodes are updated with the edge cells of the spreader and heatsink
+    for(int k = 0; k < 2; k++)
+    {
+      int n = k?hsidx:spidx;
+      memcpy(v->cuboid[n][0],&t[index(n,0,0)],nc*sizeof(double));
+      memcpy(v->cuboid[n][nr-1],&t[index(n,nr-1,0)],nc*sizeof(double));
+      for(int i = 1; i < nr-1; i++)
+      {
+        v->cuboid[n][i][0] = t[index(n,i,0)];
+        v->cuboid[n][i][nc-1] = t[index(n,i,nc-1)];
+      }
+    }
+    double pack_delta = single_iteration_steady_pack(grid,p,v);
+    delta = MAX(delta,pack_delta);
+    update_edge_source();
+  } while((delta >= tolerance)&&(++iteration < max_iterations));
+
+  if(iteration == max_iterations)
+    EI_WARNING("HotSpot","SOR solver did not converge within sor_max_iterations");
+
+  for(int n = 0; n < nl; n++)
+    for(int i = 0; i < nr; i++)
+      memcpy(v->cuboid[n][i],&t[index(n,i,0)],nc*sizeof(double));
+
+  xlate_temp_g2b(grid,temperature,v);
+
+  return iteration;
+}
+
+
+// Updates the cells of one color. Neighbors of a cell have the other color, so the
+// rows can be updated in parallel.
+double hotspot_sor_solver_t::sweep(int color)
+{
+  double max_delta = 0.0;
+
+#ifdef _OPENMP
+  #pragma omp parallel for schedule(static) reduction(max:max_delta)
+#endif
+  for(int row = 0; row < nl*nr; row++)
+  {
+    int n = row/nr;
+    int i = row%nr;
+    const double cx = gx[n], cy = gy[n], ca = ga[n], cb = gb[n];
+    const int rp = row_pitch, lp = layer_pitch;
+    const int end = index(n,i,nc);
+
+    for(int k = index(n,i,(n+i+color)&1); k < end; k += 2)
+    {
+      double new_t = (src[k]+cy*(t[k-rp]+t[k+rp])+cx*(t[k-1]+t[k+1])+ca*t[k-lp]+cb*t[k+lp])*inv_diag[k];
+      double delta = omega*(new_t-t[k]);
+      t[k] += delta;
+      if(fabs(delta) > max_delta)
+        max_delta = fabs(delta);
+    }
+  }
+
+  return max_delta;
+}
+
+
+// Sources of the spreader and heatsink edge cells include the package node temperatures.
+void hotspot_sor_solver_t::update_edge_source(void)
+{
+  layer_t *l = grid->layers;
+  package_RC_t *pk = &grid->pack;
+  double *extra = grid->last_steady->extra;
+
+  for(int k = 0; k < 2; k++)
+  {
+    int n = k?hsidx:spidx;
+    double g_y = 1.0/(l[n].ry/2.0+nc*(k?pk->r_hs1_y:pk->r_sp1_y));
+    double g_x = 1.0/(l[n].rx/2.0+nr*(k?pk->r_hs1_x:pk->r_sp1_x));
+    double t_n = extra[k?SINK_C_N:SP_N], t_s = extra[k?SINK_C_S:SP_S];
+    double t_e = extra[k?SINK_C_E:SP_E], t_w = extra[k?SINK_C_W:SP_W];
+    double ambient = k?(grid->config.ambient/l[n].rz):0.0;
+
+    for(int i = 0; i < nr; i++)
+    {
+      bool edge_row = (i == 0)||(i == nr-1)||(nc == 1);
+      for(int j = 0; j < nc; j += edge_row?1:(nc-1))
+      {
+        double s = p->cuboid[n][i][j]+ambient;
+        if(i == 0) s += g_y*t_n;
+        if(i == nr-1) s += g_y*t_s;
+        if(j == nc-1) s += g_x*t_e;
+        if(j == 0) s += g_x*t_w;
+        src[index(n,i,j)] = s;
+      }
+    }
+  }
 }
 
@@ -35,11 +35,42 @@ extern "C" {
 
 namespace EI {
 
+  // Red-black SOR solver for the steady-state temperatures of the HotSpot grid model.
+  // The grid is stored in contiguous aligned arrays with a halo of zero cells, so the
+  // inner loop has no boundary checks. Each solve is warm-started from the previous
+  // solution in grid->last_steady and leaves its solution there.
+  class hotspot_sor_solver_t
+  {
+  public:
+    hotspot_sor_solver_t(grid_model_t *grid_model, double sor_omega, double sor_tolerance, int sor_max_iterations);
+    ~hotspot_sor_solver_t();
+
+    // returns the number of iterations
+    int solve(double *power, double *temperature);
+
+  private:
+    grid_model_t *grid;
+    double omega, tolerance;
+    int max_iterations;
+
+    int nl, nr, nc; // layers, rows, columns
+    int row_pitch, layer_pitch; // including the halo
+    int spidx, hsidx; // spreader and heatsink layers
+    vector<double> gx, gy, ga, gb; // conductances to the east/west, north/south, above and below
+    double *t, *src, *inv_diag; // padded grid
+
+    grid_model_vector_t *p; // grid power
+
+    int index(int n, int i, int j) { return (n+1)*layer_pitch+(i+1)*row_pitch+(j+1); }
+    double sweep(int color);
+    void update_edge_source(void);
+  };
+
   class THERMALLIB_HOTSPOT : public thermal_library_t
   {
   public:
     THERMALLIB_HOTSPOT(string component_name, parameters_t *parameters, energy_introspector_t *ei);
-    ~THERMALLIB_HOTSPOT() {}
+    ~THERMALLIB_HOTSPOT() { delete sor_solver; }
     
     virtual void compute_temperature(double time_tick, double period);
     virtual grid_t<double> get_thermal_grid(void);
@@ -57,6 +88,11 @@ namespace EI {
     
     double *temperature, *power;
 
+    hotspot_sor_solver_t *sor_solver; // replaces HotSpot's steady-state solver after the first solve
+    bool sor_ready;
+    bool sor_validate; // compare each solution with HotSpot's solver
+    double sor_validate_threshold;
+
     int thermal_analysis;
     enum HOTSPOT_THERMAL_ANALYSIS
     {
@@ -213,4 +213,7 @@ void debug_print_grid(grid_model_t *model);
 blist_t ***new_b2gmap(int rows, int cols);
 void populate_default_layers(grid_model_t *model, flp_t *flp_default);
 void append_package_layers(grid_model_t *model);
+void set_internal_power_grid(grid_model_t *model, double *power);
+double single_iteration_steady_pack(grid_model_t *model, grid_model_vector_t *power,
+									grid_model_vector_t *temp);
 #endif
@@ -143,6 +143,35 @@ namespace EI {
   };
   
   
+  // runtime power w.r.t the access counters:
+  // power = baseline + leakage + sum(per-access energy * counter)/period
+  class power_coefficients_t
+  {
+  public:
+    power_coefficients_t() { reset(); }
+
+    // per-access energy in unit of joule
+    double baseline_access; // baseline energy per read or write access
+    double search; // module entry search energy
+    double read; // module read energy (data+tag)
+    double write; // module write energy (data+tag)
+    double read_tag; // tag array read energy
+    double write_tag; // tag array write energy
+
+    // access-independent power in unit of watt
+    double baseline; // baseline dynamic power
+    double leakage; // leakage power
+
+    void reset()
+    {
+      baseline_access = 0.0;
+      search = 0.0; read = 0.0; write = 0.0;
+      read_tag = 0.0; write_tag = 0.0;
+      baseline = 0.0; leakage = 0.0;
+    }
+  };
+  
+  
   class grid_index_t
   {
   public:
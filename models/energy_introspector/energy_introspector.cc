@@ -730,6 +730,9 @@ void energy_introspector_t::post_config(parameters_t *parameters)
         EI_ERROR("EI","pseudo sensor "+p_sensor_it->name+" monitors invalid data");
     }
   }
+  
+  // snapshot per-access energy and resolve queues for compute_power() by handle
+  compile_module_handles();
 }
 
 // leakagee computation
@@ -931,6 +934,193 @@ void energy_introspector_t::compute_power\
   }
 }
 
+void energy_introspector_t::compile_module_handles(void)
+{
+  module_handle.clear();
+  power_coefficients.clear();
+  
+  for(map<string,pseudo_module_t>::iterator module_it = module.begin();
+      module_it != module.end(); module_it++)
+  {
+    pseudo_module_handle_t handle;
+    handle.module = &module_it->second;
+    handle.name = &module_it->first;
+    handle.power = module_it->second.queue.get_runtime_queue<power_t>("power");
+    
+    map<string,pseudo_partition_t>::iterator partition_it = partition.find(module_it->second.partition);
+    
+    if(partition_it != partition.end())
+    {
+      handle.partition_name = &partition_it->first;
+      handle.partition_power = partition_it->second.queue.get_runtime_queue<power_t>("power");
+      
+      map<string,pseudo_package_t>::iterator package_it = package.find(partition_it->second.package);
+      
+      if(package_it != package.end())
+      {
+        handle.package_name = &package_it->first;
+        handle.package_power = package_it->second.queue.get_runtime_queue<power_t>("power");
+      }
+    }
+    
+    module_it->second.handle = module_handle.size();
+    module_handle.push_back(handle);
+    power_coefficients.push_back(power_coefficients_t());
+    update_power_coefficients(module_it->second.handle);
+  }
+}
+
+// re-snapshot the coefficients after the energy library is updated
+void energy_introspector_t::update_power_coefficients(int handle)
+{
+  if((handle < 0)||(handle >= (int)module_handle.size()))
+    return;
+  
+  pseudo_module_handle_t &entry = module_handle[handle];
+  
+  if(entry.module->energy_library)
+    entry.has_coefficients = entry.module->energy_library->get_power_coefficients(power_coefficients[handle]);
+}
+
+int energy_introspector_t::get_module_handle(string module_name)
+{
+  map<string,pseudo_module_t>::iterator module_it = module.find(module_name);
+  
+  if((module_it == module.end())||(module_it->second.handle < 0))
+  {
+    EI_WARNING("EI","cannot find pseudo module "+module_name+" in get_module_handle()");
+    return -1;
+  }
+  
+  return module_it->second.handle;
+}
+
+power_t energy_introspector_t::get_runtime_power\
+(int handle, double time_tick, double period, const counters_t &counters)
+{
+  if(!module_handle[handle].has_coefficients)
+    return module_handle[handle].module->energy_library->get_runtime_power(time_tick,period,counters);
+  
+  const power_coefficients_t &coefficients = power_coefficients[handle];
+  double scale = 1.0/period; // conversion from energy to power
+  power_t power;
+  
+  power.baseline = coefficients.baseline\
+  +coefficients.baseline_access*(double)(counters.read+counters.write)*scale;
+  power.search = coefficients.search*(double)counters.search*scale;
+  power.read = coefficients.read*(double)counters.read*scale;
+  power.write = coefficients.write*(double)counters.write*scale;
+  power.read_tag = coefficients.read_tag*(double)counters.read_tag*scale;
+  power.write_tag = coefficients.write_tag*(double)counters.write_tag*scale;
+  power.leakage = coefficients.leakage;
+  power.get_total();
+  
+  return power;
+}
+
+// store the module power and accumulate it to the partition and package power;
+// same as compute_power() by name, without the queue lookups
+void energy_introspector_t::deliver_power\
+(double time_tick, double period, pseudo_module_handle_t &handle, power_t &power)
+{
+  runtime_queue_t<power_t> *rtq = handle.power;
+  
+  if(!rtq)
+  {
+    EI_WARNING("queue","cannot find the runtime queue power in push()");
+    return;
+  }
+  if((time_tick-rtq->head > max_trunc)&&(rtq->tail-time_tick > max_trunc))
+    EI_WARNING("queue","a new data power overlaps the queue data range in push()");
+  rtq->push(time_tick,period,power);
+  
+  if(!handle.partition_power)
+    return;
+  
+  rtq = handle.partition_power;
+  
+  if((time_tick-rtq->tail > max_trunc)||(rtq->head-time_tick > max_trunc))
+  {
+    char message[256];
+    sprintf(message,"pulling data power at %lf out of the queue range [%lf:%lf]",time_tick,rtq->head,rtq->tail);
+    EI_WARNING("queue",string(message));
+  }
+  power_t partition_power = rtq->pull(time_tick);
+  partition_power = partition_power + power;
+  
+  if(rtq->is_synchronous(time_tick,period))
+    rtq->update(time_tick,period,partition_power);
+  else
+    EI_WARNING("EI","pseudo module "+*handle.name+" power is asynchronous to pseudo partition "+*handle.partition_name+" power; partition power is not updated");
+  
+  if(!handle.package_power)
+    return;
+  
+  rtq = handle.package_power;
+  
+  if((time_tick-rtq->tail > max_trunc)||(rtq->head-time_tick > max_trunc))
+  {
+    char message[256];
+    sprintf(message,"pulling data power at %lf out of the queue range [%lf:%lf]",time_tick,rtq->head,rtq->tail);
+    EI_WARNING("queue",string(message));
+  }
+  power_t package_power = rtq->pull(time_tick);
+  package_power = package_power + power;
+  
+  if(rtq->is_synchronous(time_tick,period))
+    rtq->update(time_tick,period,package_power);
+  else
+    EI_WARNING("EI","pseudo module "+*handle.name+" power is asynchronous to pseudo package "+*handle.package_name+" power; package power is not updated");
+}
+
+// energy computation by module handle
+void energy_introspector_t::compute_power\
+(double time_tick, double period, int module_handle_index, const counters_t &counters)
+{
+  if((module_handle_index < 0)||(module_handle_index >= (int)module_handle.size())||(period == 0.0))
+  {
+    EI_WARNING("EI","cannot compute power for pseudo module handle; handle is invalid or sampling period is 0");
+    return; // exit without energy computation
+  }
+  
+  pseudo_module_handle_t &handle = module_handle[module_handle_index];
+  
+  if(handle.module->energy_library != NULL)
+  {
+    power_t power = get_runtime_power(module_handle_index,time_tick,period,counters);
+    deliver_power(time_tick,period,handle,power);
+  }
+}
+
+// batched energy computation; the power of all modules is computed before any queue is updated
+void energy_introspector_t::compute_power\
+(double time_tick, double period, int num_modules, const int *module_handles, const counters_t *counters)
+{
+  if(period == 0.0)
+  {
+    EI_WARNING("EI","cannot compute power for pseudo module handles; sampling period is 0");
+    return; // exit without energy computation
+  }
+  
+  handle_power.resize(num_modules);
+  
+  for(int i = 0; i < num_modules; i++)
+  {
+    int handle = module_handles[i];
+    if((handle >= 0)&&(handle < (int)module_handle.size())&&module_handle[handle].module->energy_library)
+      handle_power[i] = get_runtime_power(handle,time_tick,period,counters[i]);
+  }
+  
+  for(int i = 0; i < num_modules; i++)
+  {
+    int handle = module_handles[i];
+    if((handle < 0)||(handle >= (int)module_handle.size()))
+      EI_WARNING("EI","cannot compute power for pseudo module handle; handle is invalid");
+    else if(module_handle[handle].module->energy_library)
+      deliver_power(time_tick,period,module_handle[handle],handle_power[i]);
+  }
+}
+
 #define MAX_TEMP 0
 #define MIN_TEMP 1
 #define AVG_TEMP 2
@@ -1085,6 +1275,7 @@ void energy_introspector_t::compute_temperature(double time_tick, double period,
 
           //EI_DEBUG("updating pseudo module "+module_it->first+" unit energy (leakage feedback)");
           module_it->second.energy_library->update_variable("temperature",&new_temperature);
+          update_power_coefficients(module_it->second.handle);
 
           compute_leakage(time_tick,period,module_it->first); // compute leakage power
 
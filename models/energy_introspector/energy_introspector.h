@@ -23,6 +23,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "definitions.h"
 #include "parameters.h"
@@ -51,11 +52,12 @@ namespace EI {
   class pseudo_module_t : public pseudo_component_t
   {
   public:
-    pseudo_module_t() : energy_library(NULL) {}
+    pseudo_module_t() : energy_library(NULL), handle(-1) {}
     ~pseudo_module_t() { queue.reset(); }
     
     energy_library_t *energy_library; // pointer to energy library
     string partition; // partition name
+    int handle; // index to the module handles; -1 before post_config
   };
   
   
@@ -105,6 +107,27 @@ namespace EI {
   };
   
   
+  template <typename T> class runtime_queue_t;
+  
+  // per-module state resolved at post_config for compute_power() by handle
+  class pseudo_module_handle_t
+  {
+  public:
+    pseudo_module_handle_t() : module(NULL), name(NULL), power(NULL),\
+    partition_name(NULL), partition_power(NULL), package_name(NULL), package_power(NULL),\
+    has_coefficients(false) {}
+    
+    pseudo_module_t *module;
+    const string *name; // pseudo module name
+    runtime_queue_t<power_t> *power; // module power queue
+    const string *partition_name;
+    runtime_queue_t<power_t> *partition_power; // NULL if no partition
+    const string *package_name;
+    runtime_queue_t<power_t> *package_power; // NULL if no package
+    bool has_coefficients; // runtime power is computed from the coefficient table
+  };
+  
+  
   class energy_introspector_t
   {
   private:
@@ -122,6 +145,16 @@ namespace EI {
     void pre_config(parameters_t *parameters);
     void post_config(parameters_t *parameters);
     
+    // compiled compute_power() by module handle
+    vector<pseudo_module_handle_t> module_handle;
+    vector<power_coefficients_t> power_coefficients; // indexed by module handle
+    vector<power_t> handle_power; // scratch for batched compute_power()
+    
+    void compile_module_handles(void);
+    void update_power_coefficients(int handle);
+    power_t get_runtime_power(int handle, double time_tick, double period, const counters_t &counters);
+    void deliver_power(double time_tick, double period, pseudo_module_handle_t &handle, power_t &power);
+    
   public:
     energy_introspector_t(void);
     energy_introspector_t(char *input_config);
@@ -143,6 +176,12 @@ namespace EI {
     
     // computational functions -- data-dependent
     void compute_power(double time_tick, double period, string module_name, counters_t counters, bool is_tdp = false);
+    
+    // compute_power() without name lookups; handles are valid after configure()
+    int get_module_handle(string module_name);
+    void compute_power(double time_tick, double period, int module_handle, const counters_t &counters);
+    void compute_power(double time_tick, double period, int num_modules, const int *module_handles, const counters_t *counters);
+    
     void compute_leakage(double time_tick, double period, string module_name);
     void compute_temperature(double time_tick, double period, string package_name);
     void compute_reliability(double time_tick, double period, string partition_name,\
@@ -156,7 +195,10 @@ namespace EI {
       if(module_it != module.end())
       {
         if(module_it->second.energy_library)
+        {
           module_it->second.energy_library->update_variable(updater,&value);
+          update_power_coefficients(module_it->second.handle);
+        }
         else
           EI_WARNING("EI","pseudo module "+name+" does not have a link to the energy library");
       }
@@ -39,6 +39,10 @@ namespace EI {
     virtual double get_leakage_power(double time_tick, double period) = 0;
     virtual double get_area(void) = 0; // returns area (if available)
     virtual void update_variable(string variable, void *value) = 0; // update per-access energy w.r.t the updater
+
+    // returns the coefficients that get_runtime_power() applies to the counters;
+    // false if the runtime power is not linear in the counters
+    virtual bool get_power_coefficients(power_coefficients_t &coefficients) { return false; }
     
   protected:
     class energy_introspector_t *energy_introspector; // back pointer to energy introspector
@@ -70,6 +70,18 @@ namespace EI {
         return true;
     }
     
+    // returns the runtime queue for direct access, or NULL if not found
+    template <typename T>
+    runtime_queue_t<T>* get_runtime_queue(string name)
+    {
+      map<string,queue_wrapper_t>::iterator it = queue_wrapper.find(name);
+
+      if(it == queue_wrapper.end())
+        return NULL;
+      else
+        return dynamic_cast<runtime_queue_t<T>* >(it->second.queue);
+    }
+
     // regular data queue
     template <typename T>
     double begin(string name, bool disregard = false)
@@ -23,6 +23,8 @@ Bank::Bank(const Dsettings* dramSetting) {
 	this->firstAccess = true;
 	this->lastAccessedRow = 0;
 	this->bankAvailableAtTime = 0;
+	this->stats_busy_head = 0;
+	this->stats_busy_count = 0;
 
 	stats = new Bank_stat_engine();
 }
@@ -44,7 +46,7 @@ Bank :: Bank(const Bank& b)
 
 
 
-unsigned long int Bank::processRequest(Dreq* dRequest)
+unsigned long int Bank::processRequest(Dreq* dRequest, unsigned long int actReady)
 {
 #ifdef DBG_CAFFDRAM
 cout << "request originTime= " << dRequest->get_originTime() << "  Bank available time= "
@@ -71,52 +73,118 @@ cout << "request originTime= " << dRequest->get_originTime() << "  Bank availabl
 
 	if (this->dramSetting->memPagePolicy == OPEN_PAGE)
 	{
-		returnLatency = this->processOpenPageRequest(dRequest);
+		returnLatency = this->processOpenPageRequest(dRequest, actReady);
 	}
 	else
 	{
-		returnLatency = this->processClosedPageRequest(dRequest);
+		returnLatency = this->processClosedPageRequest(dRequest, actReady);
 	}
+	if (dRequest->is_read())
+		this->counters.reads++;
+	else
+		this->counters.writes++;
 
 	//info.new_avail = bankAvailableAtTime;
 	//reqs.push_back(info);
 
-	busy.second = bankAvailableAtTime; //bankAvailableAtTime has been updated
+	this->collect_stats(dRequest, busy.first);
 
-	busy.first = bankAvailableAtTime - busy.first; //busy for this number of cycles due to this request
+	return (returnLatency);
+}
 
-	if(stats_busy_cycles.size() > 0)
-	    busy.first += stats_busy_cycles.back().first; //accumulate
+//! Record that the bank is busy from busyFrom to bankAvailableAtTime.
+void Bank::collect_stats(Dreq* dRequest, unsigned long int busyFrom)
+{
+	pair<uint64_t, uint64_t> busy;
+	busy.second = bankAvailableAtTime;
+	busy.first = bankAvailableAtTime - busyFrom; //busy for this number of cycles due to this request
+
+	if(stats_busy_count > 0)
+	    busy.first += busy_cycles_at(stats_busy_count - 1).first; //accumulate
 	assert(busy.first < busy.second);
-        stats_busy_cycles.push_back(busy);
-	if(stats_busy_cycles.size() > 100) //only keep 100 pairs
-	    stats_busy_cycles.pop_front();
+	if(stats_busy_count < BUSY_HISTORY)
+	    stats_busy_count++;
+	else //overwrite the oldest pair
+	    stats_busy_head = (stats_busy_head + 1) % BUSY_HISTORY;
+	busy_cycles_at(stats_busy_count - 1) = busy;
 
         stats->num_requests++;
-	stats->latencies.collect(returnLatency - dRequest->get_originTime());
-
-	return (returnLatency);
+	stats->latencies.collect(dRequest->get_endTime() - dRequest->get_originTime());
 }
 
-unsigned long int Bank::processOpenPageRequest(Dreq* dRequest)
+
+unsigned long int Bank::issueRequest(Dreq* dRequest, bool read, unsigned long int issueTime,
+                                     unsigned long int busAvailableAtTime, unsigned long int actReady)
 {
-	unsigned long int returnLatency = 0;
+	assert(this->bankAvailableAtTime <= issueTime);
+
+	unsigned long int start = issueTime + this->dramSetting->t_CMD;
+	unsigned long int columnT = read ? this->dramSetting->t_CAS : this->dramSetting->t_CWD;
+	unsigned long int dataT;
 
-	if (this->firstAccess == false)
+	if (this->is_rowHit(dRequest->get_rowId()))
+		dataT = start + columnT;
+	else
 	{
-		if (dRequest->get_rowId() == this->lastAccessedRow)
-		{
-			this->bankAvailableAtTime += this->dramSetting->t_CAS;
-		}
-		else
+		unsigned long int actT = start;
+		if (this->is_rowOpen())
 		{
-			this->bankAvailableAtTime += this->dramSetting->t_RP;
-			this->bankAvailableAtTime += (this->dramSetting->t_RCD + this->dramSetting->t_CAS);
+			actT += this->dramSetting->t_RP;
+			this->counters.precharges++;
 		}
+		if (actT < actReady)
+			actT = actReady;
+		dRequest->set_actTime(actT);
+		this->counters.activates++;
+		dataT = actT + this->dramSetting->t_RCD + columnT;
+	}
+
+	unsigned long int busStart = (dataT > busAvailableAtTime) ? dataT : busAvailableAtTime;
+	unsigned long int endT = busStart + this->dramSetting->t_BURST;
+
+	//A read frees the bank for the next column command when its data is on the bus;
+	//a write must also wait for the write recovery.
+	this->bankAvailableAtTime = read ? busStart : endT + this->dramSetting->t_WR;
+	if (this->dramSetting->memPagePolicy == CLOSED_PAGE)
+	{
+		this->bankAvailableAtTime += this->dramSetting->t_RP;
+		this->counters.precharges++;
+	}
+	if (read)
+		this->counters.reads++;
+	else
+		this->counters.writes++;
+
+	this->firstAccess = false;
+	this->lastAccessedRow = dRequest->get_rowId();
+	dRequest->set_endTime(endT);
+
+	this->collect_stats(dRequest, start);
+	return (endT);
+}
+
+
+unsigned long int Bank::processOpenPageRequest(Dreq* dRequest, unsigned long int actReady)
+{
+	unsigned long int returnLatency = 0;
+
+	if (this->firstAccess == false && dRequest->get_rowId() == this->lastAccessedRow)
+	{
+		this->bankAvailableAtTime += this->dramSetting->t_CAS;
 	}
 	else
 	{
-		this->bankAvailableAtTime += (this->dramSetting->t_RCD + this->dramSetting->t_CAS);
+		unsigned long int actT = this->bankAvailableAtTime;
+		if (this->firstAccess == false)
+		{
+			actT += this->dramSetting->t_RP;
+			this->counters.precharges++;
+		}
+		if (actT < actReady)
+			actT = actReady;
+		dRequest->set_actTime(actT);
+		this->counters.activates++;
+		this->bankAvailableAtTime = actT + this->dramSetting->t_RCD + this->dramSetting->t_CAS;
 		this->firstAccess = false;
 	}
 	unsigned long endT = this->bankAvailableAtTime + this->dramSetting->t_BURST;
@@ -126,10 +194,16 @@ unsigned long int Bank::processOpenPageRequest(Dreq* dRequest)
 	return (returnLatency);
 }
 
-unsigned long int Bank::processClosedPageRequest(Dreq* dRequest)
+unsigned long int Bank::processClosedPageRequest(Dreq* dRequest, unsigned long int actReady)
 {
 	unsigned long int returnLatency = 0;
-	this->bankAvailableAtTime += (this->dramSetting->t_RCD + this->dramSetting->t_CAS);
+	unsigned long int actT = this->bankAvailableAtTime;
+	if (actT < actReady)
+		actT = actReady;
+	dRequest->set_actTime(actT);
+	this->counters.activates++;
+	this->counters.precharges++;
+	this->bankAvailableAtTime = actT + this->dramSetting->t_RCD + this->dramSetting->t_CAS;
 	this->bankAvailableAtTime += this->dramSetting->t_RP;
 	unsigned long endT = this->bankAvailableAtTime + this->dramSetting->t_BURST;
 	dRequest->set_endTime(endT);
@@ -138,33 +212,73 @@ unsigned long int Bank::processClosedPageRequest(Dreq* dRequest)
 }
 
 
+void Bank::refresh(unsigned long int endT)
+{
+	assert(endT >= this->bankAvailableAtTime);
+	if (this->firstAccess == false && this->dramSetting->memPagePolicy == OPEN_PAGE)
+		this->counters.precharges++;
+	this->firstAccess = true;
+	this->bankAvailableAtTime = endT;
+	this->counters.refreshes++;
+}
+
+
+void Bank::get_ei_counters(EI::counters_t& c) const
+{
+	c.read = counters.reads;
+	c.write = counters.writes;
+	c.read_tag = counters.activates;
+	c.write_tag = counters.precharges;
+	c.search = counters.refreshes;
+}
+
+
+void Bank::checkpoint (manifold::kernel::CheckpointOut& out)
+{
+    out.write(lastAccessedRow);
+    out.write(firstAccess);
+    out.write(bankAvailableAtTime);
+}
+
+
+void Bank::restore (manifold::kernel::CheckpointIn& in)
+{
+    in.read(lastAccessedRow);
+    in.read(firstAccess);
+    in.read(bankAvailableAtTime);
+}
+
+
 void Bank::print_stats (ostream & out)
 {
     stats->print_stats(out);
+    out << "activates= " << counters.activates << " precharges= " << counters.precharges
+        << " reads= " << counters.reads << " writes= " << counters.writes
+	<< " refreshes= " << counters.refreshes << endl;
     uint64_t endTick = manifold::kernel::Manifold::NowTicks();
 #if 0
 for(list<req_info>::iterator it=reqs.begin(); it != reqs.end(); ++it) {
 out << "(" << it->old_avail << ", " << it->orig << ", " << it->new_avail << ") ";
 }
 out<<endl;
-for(list<pair<uint64_t, uint64_t> >::iterator it=stats_busy_cycles.begin(); it != stats_busy_cycles.end(); ++it) {
-out << "(" << it->first << ", " << it->second << ") ";
+for(unsigned i=0; i < stats_busy_count; i++) {
+out << "(" << busy_cycles_at(i).first << ", " << busy_cycles_at(i).second << ") ";
 }
 out<<endl;
 #endif
-    if(stats_busy_cycles.size() > 0) {
-        if(stats_busy_cycles.back().second > endTick) {
-	    list<pair<uint64_t, uint64_t> >::iterator it = stats_busy_cycles.begin();
-	    for(; it != stats_busy_cycles.end(); ++it) {
-	        if(it->second > endTick)
+    if(stats_busy_count > 0) {
+        if(busy_cycles_at(stats_busy_count - 1).second > endTick) {
+	    unsigned i = 0;
+	    for(; i < stats_busy_count; i++) {
+	        if(busy_cycles_at(i).second > endTick)
 		    break;
 	    }
-	    out << "busy cycles= " << (it->first)/((double)endTick);
-	    if(it == stats_busy_cycles.begin())
+	    out << "busy cycles= " << (busy_cycles_at(i).first)/((double)endTick);
+	    if(i == 0)
 	        out << " **";
 	}
 	else {
-	    out << "busy cycles= " << (stats_busy_cycles.back().first)/((double)endTick);
+	    out << "busy cycles= " << (busy_cycles_at(stats_busy_count - 1).first)/((double)endTick);
 	}
 	out << endl;
     }
@@ -176,7 +290,10 @@ out<<endl;
 
 Bank_stat_engine::Bank_stat_engine () : Stat_engine(),
 num_requests("Number of Requests", ""),
-latencies("Average Memory Latency", "", 1000, 5, 0)
+latencies("Average Memory Latency", "", 1000, 5, 0),
+in_warmup(false),
+warmup_num_requests(0),
+warmup_latencies("Average Memory Latency", "", 1000, 5, 0)
 {
 }
 
@@ -206,10 +323,19 @@ void Bank_stat_engine::clear_stats()
 
 void Bank_stat_engine::start_warmup () 
 {
+    in_warmup = true;
+    warmup_num_requests = num_requests.get_value();
+    warmup_latencies = latencies;
 }
 
+//! Requests completed during the warmup are not counted.
 void Bank_stat_engine::end_warmup () 
 {
+    if(!in_warmup)
+        return;
+    in_warmup = false;
+    num_requests = warmup_num_requests;
+    latencies = warmup_latencies;
 }
 
 void Bank_stat_engine::save_samples () 
@@ -12,6 +12,8 @@
 #include "Dreq.h"
 #include "kernel/stat_engine.h"
 #include "kernel/stat.h"
+#include "kernel/checkpoint.h"
+#include "../../energy_introspector/definitions.h"
 
 #include <iostream>
 #include <list>
@@ -31,7 +33,44 @@ class Bank_stat_engine;
 class Bank {
 public:
 
-	unsigned long int processRequest(Dreq* dRequest);
+	//! If the request opens a row, the activate command is not issued before
+	//! actReady, which is set by the rank to enforce t_RRD and t_FAW.
+	unsigned long int processRequest(Dreq* dRequest, unsigned long int actReady = 0);
+
+	//! Used by the FR_FCFS scheduler: the command is issued at issueTime and its
+	//! data can use the channel's data bus from busAvailableAtTime on. Returns the
+	//! time the data transfer ends.
+	unsigned long int issueRequest(Dreq* dRequest, bool read, unsigned long int issueTime,
+	                               unsigned long int busAvailableAtTime, unsigned long int actReady = 0);
+	bool is_rowHit(unsigned int rowId) const
+	{
+	    return dramSetting->memPagePolicy == OPEN_PAGE && !firstAccess && rowId == lastAccessedRow;
+	}
+	bool is_rowOpen() const { return dramSetting->memPagePolicy == OPEN_PAGE && !firstAccess; }
+	unsigned long int get_availableTime() const { return bankAvailableAtTime; }
+	//! Make the bank unavailable until time t, e.g., while the rank exits power-down.
+	void block_until(unsigned long int t)
+	{
+	    if (bankAvailableAtTime < t)
+		bankAvailableAtTime = t;
+	}
+	//! Precharge the open row, if any, and refresh the bank; the refresh is done at endT.
+	void refresh(unsigned long int endT);
+
+	//! Number of commands executed by the bank.
+	struct Counters {
+	    Counters() : activates(0), precharges(0), reads(0), writes(0), refreshes(0) {}
+	    uint64_t activates;
+	    uint64_t precharges;
+	    uint64_t reads;
+	    uint64_t writes;
+	    uint64_t refreshes;
+	};
+	const Counters& get_counters() const { return counters; }
+	//! The counters in the form used by the energy introspector: read and write are
+	//! column reads and writes, read_tag counts activates, write_tag counts precharges,
+	//! and search counts refreshes.
+	void get_ei_counters(EI::counters_t& c) const;
 
 	Bank(const Dsettings* dramSetting);
 	~Bank();
@@ -40,6 +79,10 @@ public:
 
         void print_stats(ostream& out);
 
+        //! Save/restore the open row and the time the bank becomes available.
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
 #ifdef CAFFDRAM_TEST
 public:
 #else
@@ -49,26 +92,37 @@ private:
 
 	const Dsettings* dramSetting;
 	unsigned int lastAccessedRow;
-	bool firstAccess;
+	bool firstAccess; //no row is open; true before the first access and after a refresh
 	unsigned long int bankAvailableAtTime;
 
-	unsigned long int processOpenPageRequest (Dreq* dRequest);
-	unsigned long int processClosedPageRequest (Dreq* dRequest);
+	unsigned long int processOpenPageRequest (Dreq* dRequest, unsigned long int actReady = 0);
+	unsigned long int processClosedPageRequest (Dreq* dRequest, unsigned long int actReady = 0);
+	void collect_stats (Dreq* dRequest, unsigned long int busyFrom);
 
 
 	//stats
 	friend class Bank_stat_engine;
 	Bank_stat_engine *stats;
+	Counters counters;
 
         //stats on number of cycles the bank is busy; here a pair (x, y) is used: meaning between cycles 0 and y
 	//there are x cycles the bank is busy.
-	//The reason for using a list is as follows: CaffDRAM doesn't register with a clock, so there is not a
+	//The reason for keeping a history is as follows: CaffDRAM doesn't register with a clock, so there is not a
 	//function that is called every cycle. The simulation end time E is likely different from the last pair's
 	//y value. To find out the num of busy cycles between 0 and E, we simply find the first pair whose y value
 	// is greater than or equal to E. Another case is that the y value of the last pair is < E.
-	//The size of the list could be big, so we limit the size to 100. Therefore, if the y value of the very
-	//first pair is greater than E, the computed number of busy cycles is only an approximate.
-	std::list<std::pair<uint64_t, uint64_t> > stats_busy_cycles;
+	//The history is a ring buffer of the last BUSY_HISTORY pairs, so recording a request never allocates.
+	//Therefore, if the y value of the oldest pair is greater than E, the computed number of busy cycles
+	//is only an approximate.
+	enum { BUSY_HISTORY = 100 };
+	std::pair<uint64_t, uint64_t> stats_busy_cycles[BUSY_HISTORY];
+	unsigned stats_busy_head; //index of the oldest pair
+	unsigned stats_busy_count; //number of valid pairs
+
+	std::pair<uint64_t, uint64_t>& busy_cycles_at(unsigned i) //i-th oldest pair
+	{
+	    return stats_busy_cycles[(stats_busy_head + i) % BUSY_HISTORY];
+	}
 
 	#if 0
 	struct req_info {
@@ -100,6 +154,12 @@ class Bank_stat_engine : public manifold::kernel::Stat_engine
         void start_warmup ();
         void end_warmup ();	
         void save_samples ();
+
+    private:
+        //stats when the warmup started; restored when it ends.
+        bool in_warmup;
+        manifold::kernel::counter_t warmup_num_requests;
+        manifold::kernel::Persistent_histogram_stat<manifold::kernel::counter_t> warmup_latencies;
 };
 
 } //namespace caffdram
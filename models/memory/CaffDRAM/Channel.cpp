@@ -22,6 +22,9 @@ Channel::Channel(const Dsettings* dramSetting) {
 	{
 		this->myRank[i] = new Rank(this->dramSetting);
 	}
+	this->busAvailableAtTime = 0;
+	this->lastBusRank = -1;
+	this->lastBusWrite = false;
 }
 
 Channel::~Channel() {
@@ -50,6 +53,53 @@ unsigned long int Channel::processRequest(Dreq* dRequest)
 }
 
 
+unsigned long int Channel::issueRequest(Dreq* dRequest, bool read, unsigned long int now)
+{
+	//Switching ranks and turning the bus around from a write to a read need idle time.
+	unsigned long int busReady = this->busAvailableAtTime;
+	if (this->lastBusRank >= 0)
+	{
+		if ((int)dRequest->get_rankId() != this->lastBusRank)
+			busReady += this->dramSetting->t_RTRS;
+		if (this->lastBusWrite && read)
+			busReady += this->dramSetting->t_WTR;
+	}
+
+	unsigned long int endT = this->myRank[dRequest->get_rankId()]->issueRequest(dRequest, read, now, busReady);
+	this->busAvailableAtTime = endT;
+	this->lastBusRank = dRequest->get_rankId();
+	this->lastBusWrite = !read;
+	return (endT);
+}
+
+
+void Channel::refresh(unsigned long int t)
+{
+	for (int i = 0; i < this->dramSetting->numRanks; i++)
+		this->myRank[i]->refresh(t);
+}
+
+
+void Channel::checkpoint (manifold::kernel::CheckpointOut& out)
+{
+    for (int i = 0; i < dramSetting->numRanks; i++)
+	myRank[i]->checkpoint(out);
+    out.write(busAvailableAtTime);
+    out.write(lastBusRank);
+    out.write(lastBusWrite);
+}
+
+
+void Channel::restore (manifold::kernel::CheckpointIn& in)
+{
+    for (int i = 0; i < dramSetting->numRanks; i++)
+	myRank[i]->restore(in);
+    in.read(busAvailableAtTime);
+    in.read(lastBusRank);
+    in.read(lastBusWrite);
+}
+
+
 void Channel::print_stats (ostream & out)
 {
     for (int i = 0; i < dramSetting->numRanks; i++) {
@@ -28,9 +28,25 @@ public:
 	Channel(const Dsettings* dramSetting);
 	~Channel();
 
+	//! For the FR_FCFS scheduler.
+	bool is_bankReady(Dreq* dRequest, unsigned long int now)
+	{
+	    return get_bank(dRequest)->get_availableTime() <= now;
+	}
+	bool is_rowHit(Dreq* dRequest) { return get_bank(dRequest)->is_rowHit(dRequest->get_rowId()); }
+	//! Issue the request's command to its bank at time now and put its data on the
+	//! data bus after the bus is free. Returns the time the request is complete.
+	unsigned long int issueRequest(Dreq* dRequest, bool read, unsigned long int now);
+	//! Perform the refreshes of all ranks that are due at or before time t.
+	void refresh(unsigned long int t);
+	Rank* get_rank(int i) { return myRank[i]; }
+
 
         void print_stats(ostream& out);
 
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
 #ifdef CAFFDRAM_TEST
 public:
 #else
@@ -39,9 +55,16 @@ private:
 	Channel(const Channel&); //for unit test only
 
 
+	Bank* get_bank(Dreq* dRequest) { return myRank[dRequest->get_rankId()]->get_bank(dRequest->get_bankId()); }
+
 	const Dsettings* dramSetting;
 	Rank** myRank;
 
+	//data bus shared by the ranks; only used by the FR_FCFS scheduler
+	unsigned long int busAvailableAtTime;
+	int lastBusRank; //rank that used the bus last; -1 if none
+	bool lastBusWrite; //whether the last transfer was a write
+
 };
 
 
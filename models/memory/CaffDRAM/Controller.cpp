@@ -10,6 +10,7 @@
 #include "kernel/manifold.h"
 
 #include <iostream>
+#include <stdlib.h>
 
 using namespace std;
 using namespace manifold::kernel;
@@ -30,8 +31,6 @@ Controller::Controller(Clock *clk, int nid, const Dsettings& s, int credits, boo
         assert(Msg_type_set);
         assert(MEM_MSG_TYPE != CREDIT_MSG_TYPE);
 
-        Clock::Register<Controller>(*clock,this,(void(Controller::*)(void))0,(void(Controller::*)(void))0);
-        
 	m_nid = nid;
 	m_downstream_credits = credits;
 
@@ -44,8 +43,32 @@ Controller::Controller(Clock *clk, int nid, const Dsettings& s, int credits, boo
 		this->myChannel[i] = new Channel (this->dramSetting);
 	}
 
+	//The analytic model needs no clock; the FR_FCFS scheduler issues requests every cycle.
+	this->m_queues = 0;
+	if (this->dramSetting->memSchedPolicy == FR_FCFS)
+	{
+		this->m_queues = new Channel_queue[this->dramSetting->numChannels];
+		for (int i = 0; i < this->dramSetting->numChannels; i++)
+		{
+			//a bank queue can hold all the reads and writes of the channel, so it never grows
+			this->m_queues[i].bankQ.resize(this->dramSetting->numRanks * this->dramSetting->numBanks);
+			for (unsigned b = 0; b < this->m_queues[i].bankQ.size(); b++)
+				this->m_queues[i].bankQ[b].reserve(this->dramSetting->readQueueSize + this->dramSetting->writeQueueSize);
+			this->m_queues[i].bypassed.resize(this->dramSetting->numRanks * this->dramSetting->numBanks, 0);
+			this->m_queues[i].numReads = 0;
+			this->m_queues[i].numWrites = 0;
+			this->m_queues[i].drainingWrites = false;
+		}
+		Clock::Register<Controller>(*clock,this,&Controller::tick,(void(Controller::*)(void))0);
+	}
+	else
+		Clock::Register<Controller>(*clock,this,(void(Controller::*)(void))0,(void(Controller::*)(void))0);
+
 	//stats
 	this->stats_max_output_buffer_size = 0;
+	this->stats_row_hits = 0;
+	this->stats_row_misses = 0;
+	this->stats_write_drains = 0;
 
 	stats_requests_count = 0;
 	stats_last_requests_count_change_tick = 0;
@@ -61,21 +84,150 @@ Controller::~Controller() {
 		delete this->myChannel[i];
 	}
 	delete [] this->myChannel;
+	delete [] this->m_queues;
 	delete this->dramSetting;
 }
 
-unsigned long int Controller::processRequest(unsigned long int reqAddr, unsigned long int currentTime)
+unsigned long int Controller::processRequest(unsigned long int reqAddr, unsigned long int currentTime, bool read)
 {
-	Dreq* dRequest = new Dreq (reqAddr, currentTime, this->dramSetting);
-	unsigned long int returnLatency = this->myChannel[dRequest->get_chId()]->processRequest(dRequest);
+	//the request lives only for this call, so it's kept on the stack
+	Dreq dRequest(reqAddr, currentTime, this->dramSetting, read);
+	unsigned long int returnLatency = this->myChannel[dRequest.get_chId()]->processRequest(&dRequest);
 #ifdef DBG_CAFFDRAM
-cout << "ch-rank-bank = " << dRequest->get_chId() << "-" << dRequest->get_rankId() << "-" << dRequest->get_bankId() << "Lat: " << returnLatency << endl;
+cout << "ch-rank-bank = " << dRequest.get_chId() << "-" << dRequest.get_rankId() << "-" << dRequest.get_bankId() << "Lat: " << returnLatency << endl;
 #endif
-	delete dRequest;
 	return (returnLatency);
 }
 
 
+//! Put a request in the queue of its bank; if the read or write queue of the channel
+//! is full, it waits until there is room.
+void Controller::enqueueRequest(NetworkPacket* pkt, unsigned long int reqAddr, bool read)
+{
+	Queued_req r(Dreq(reqAddr, manifold::kernel::Manifold::NowTicks(), this->dramSetting, read), pkt, read);
+	Channel_queue& q = this->m_queues[r.dreq.get_chId()];
+
+	if (q.waitQ.empty() && this->has_room(q, read))
+		this->add_to_bankQ(q, r);
+	else
+		q.waitQ.push_back(r);
+}
+
+
+void Controller::add_to_bankQ(Channel_queue& q, const Queued_req& r)
+{
+	q.bankQ[r.dreq.get_rankId() * this->dramSetting->numBanks + r.dreq.get_bankId()].push_back(r);
+	if (r.read)
+		q.numReads++;
+	else
+		q.numWrites++;
+}
+
+
+void Controller::tick()
+{
+	unsigned long int now = manifold::kernel::Manifold::NowTicks();
+	for (int i = 0; i < this->dramSetting->numChannels; i++)
+	{
+		if (this->m_queues[i].numReads + this->m_queues[i].numWrites > 0)
+			this->scheduleChannel(i, now);
+	}
+}
+
+
+//! Issue at most one request of the channel. Reads are served until the number of
+//! writes reaches the high watermark, or there are no reads; then writes are drained
+//! down to the low watermark. Among the requests of the current type whose banks are
+//! available, the oldest row hit is issued; if there is no row hit, the oldest request.
+//! Once rowHitCap row hits of a bank have gone ahead of its oldest request, only the
+//! oldest request of that bank is considered, so it cannot starve.
+void Controller::scheduleChannel(int ch, unsigned long int now)
+{
+	Channel_queue& q = this->m_queues[ch];
+
+	this->myChannel[ch]->refresh(now);
+
+	if (q.drainingWrites)
+	{
+		if (q.numWrites == 0 || (q.numWrites <= this->dramSetting->writeLowWatermark && q.numReads > 0))
+			q.drainingWrites = false;
+	}
+	else if (q.numWrites >= this->dramSetting->writeHighWatermark || (q.numReads == 0 && q.numWrites > 0))
+	{
+		q.drainingWrites = true;
+		this->stats_write_drains++;
+	}
+	bool read = !q.drainingWrites;
+
+	RingBuffer<Queued_req>* bestQ = 0;
+	unsigned best = 0; //index in bestQ
+	bool bestHit = false;
+	unsigned bestBank = 0;
+	bool bestOldest = false; //best is the oldest request of its type in its bank
+
+	for (unsigned b = 0; b < q.bankQ.size(); b++)
+	{
+		RingBuffer<Queued_req>& bq = q.bankQ[b];
+		if (bq.empty() || !this->myChannel[ch]->is_bankReady(&bq.front().dreq, now))
+			continue;
+
+		bool capped = this->dramSetting->rowHitCap > 0 && q.bypassed[b] >= this->dramSetting->rowHitCap;
+		bool oldest = true;
+		for (unsigned i = 0; i < bq.size(); i++)
+		{
+			Queued_req& r = bq[i];
+			if (r.read != read)
+				continue;
+			bool hit = this->myChannel[ch]->is_rowHit(&r.dreq);
+			if (bestQ == 0 || (hit && !bestHit) ||
+			    (hit == bestHit && r.dreq.get_originTime() < (*bestQ)[best].dreq.get_originTime()))
+			{
+				bestQ = &bq;
+				best = i;
+				bestHit = hit;
+				bestBank = b;
+				bestOldest = oldest;
+			}
+			if (hit || capped)
+				break; //later requests of this bank are younger
+			oldest = false;
+		}
+	}
+
+	if (bestQ == 0)
+		return;
+
+	if (bestOldest)
+		q.bypassed[bestBank] = 0;
+	else
+		q.bypassed[bestBank]++;
+
+	Queued_req r = (*bestQ)[best];
+	bestQ->erase(best);
+	if (r.read)
+		q.numReads--;
+	else
+		q.numWrites--;
+	if (bestHit)
+		this->stats_row_hits++;
+	else
+		this->stats_row_misses++;
+
+	unsigned long int endT = this->myChannel[ch]->issueRequest(&r.dreq, r.read, now);
+#ifdef DBG_CAFFDRAM
+cout << "@" << now << " ch-rank-bank = " << ch << "-" << r.dreq.get_rankId() << "-" << r.dreq.get_bankId()
+     << (r.read ? " RD" : " WR") << (bestHit ? " hit" : " miss") << " end: " << endT << endl;
+#endif
+	manifold::kernel::Manifold::Schedule(endT - now, &Controller::request_complete, this, r.pkt, r.read);
+
+	while (!q.waitQ.empty() && this->has_room(q, q.waitQ.front().read))
+	{
+		this->add_to_bankQ(q, q.waitQ.front());
+		q.waitQ.pop_front();
+	}
+}
+
+
 /*
 //! Event handler for memory requests.
 void Controller :: handle_request(int, mem_req* req)
@@ -85,7 +237,7 @@ void Controller :: handle_request(int, mem_req* req)
 cout << "mc received LD, src= " << req->source_id << " port= " <<req->source_port << " addr= " <<hex<< req->addr <<dec<<endl;
 #endif
 	//stats
-	m_ld_misses[req->source_id]++;
+	count_source(m_ld_misses, req->source_id);
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemLd, req->originator_id, req->source_id, req->addr)));
 
@@ -106,7 +258,7 @@ cout << "mc received LD, src= " << req->source_id << " port= " <<req->source_por
 cout << "mc received ST, src= " << req->source_id << " port= " <<req->source_port << " addr= " <<hex<< req->addr <<dec<<endl;
 #endif
 	//stats
-	m_stores[req->source_id]++;
+	count_source(m_stores, req->source_id);
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemSt, req->originator_id, req->source_id, req->addr)));
 	Ticks_t latency = processRequest(req->addr, Manifold::NowTicks()); //????????????? using default clock here.
@@ -139,7 +291,7 @@ void Controller :: handle_request(int, Coh_mem_req* req)
 cout << "mc received LD, src= " << req->u.mem.source_id << " port= " <<req->u.mem.source_port << " addr= " <<hex<< req->u.mem.addr <<dec<<endl;
 #endif
 	//stats
-	m_ld_misses[req->u.mem.source_id]++;
+	count_source(m_ld_misses, req->u.mem.source_id);
 	/*
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemLd, req->u.mem.originator_id, req->u.mem.source_id, req->u.mem.addr)));
@@ -162,7 +314,7 @@ cout << "mc received LD, src= " << req->u.mem.source_id << " port= " <<req->u.me
 cout << "mc received ST, src= " << req->u.mem.source_id << " port= " <<req->u.mem.source_port << " addr= " <<hex<< req->u.mem.addr <<dec<<endl;
 #endif
 	//stats
-	m_stores[req->u.mem.source_id]++;
+	count_source(m_stores, req->u.mem.source_id);
 	/*
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemSt, req->u.mem.originator_id, req->u.mem.source_id, req->u.mem.addr)));
@@ -197,6 +349,14 @@ void Controller :: print_config(ostream& out)
         << "  num of columns = " << dramSetting->numColumns << endl
         << "  num of columns = " << dramSetting->numColumns << endl
         << "  page policy = " << ((dramSetting->memPagePolicy == OPEN_PAGE) ? "Open page" : "Closed page") << endl
+        << "  scheduler = " << ((dramSetting->memSchedPolicy == FR_FCFS) ? "FR-FCFS" : "Analytic") << endl;
+    if(dramSetting->memSchedPolicy == FR_FCFS) {
+        out << "  read queue size = " << dramSetting->readQueueSize << endl
+            << "  write queue size = " << dramSetting->writeQueueSize << endl
+            << "  write drain watermarks = " << dramSetting->writeHighWatermark << " / " << dramSetting->writeLowWatermark << endl
+            << "  row hit cap = " << dramSetting->rowHitCap << endl;
+    }
+    out
 	<< "  t_RTRS (rank to rank switching time) = " << dramSetting->t_RTRS << endl
 	<< "  t_OST (ODT switching time) = " << dramSetting->t_OST << endl
 	<< "  t_BURST (burst length on mem bus) = " << dramSetting->t_BURST << endl
@@ -214,7 +374,12 @@ void Controller :: print_config(ostream& out)
 	<< "  t_FAW (four bank activation window) = " << dramSetting->t_FAW << endl
 	<< "  t_RRD (row to row activation delay) = " << dramSetting->t_RRD << endl
 	<< "  t_RC (row cycle time) = " << dramSetting->t_RC << endl
-	<< "  t_REF_INT (refresh interval) = " << dramSetting->t_REF_INT << endl;
+	<< "  t_REF_INT (refresh interval) = " << dramSetting->t_REF_INT << endl
+	<< "  t_RFCpb (per-bank refresh cycle time) = " << dramSetting->t_RFCpb << endl
+	<< "  t_XP (power-down exit latency) = " << dramSetting->t_XP << endl
+	<< "  refresh = " << ((dramSetting->memRefreshPolicy == ALL_BANK_REFRESH) ? "All-bank" :
+	                      ((dramSetting->memRefreshPolicy == PER_BANK_REFRESH) ? "Per-bank" : "None")) << endl
+	<< "  power-down idle time = " << dramSetting->powerDownIdleTime << endl;
 }
 
 void Controller :: print_stats(ostream& out)
@@ -222,12 +387,14 @@ void Controller :: print_stats(ostream& out)
     out << "********** CaffDRAM " << m_nid << " stats **********" << endl;
     out << "max output buffer size= " << stats_max_output_buffer_size << endl;
     out << "=== Load misses ===" << endl;
-    for(map<int, int>::iterator it = m_ld_misses.begin(); it != m_ld_misses.end(); ++it) {
-        out << "    " << (*it).first << ": " << (*it).second << endl;
+    for(unsigned i = 0; i < m_ld_misses.size(); i++) {
+        if(m_ld_misses[i] > 0)
+            out << "    " << i << ": " << m_ld_misses[i] << endl;
     }
     out << "=== stores ===" << endl;
-    for(map<int, int>::iterator it = m_stores.begin(); it != m_stores.end(); ++it) {
-        out << "    " << (*it).first << ": " << (*it).second << endl;
+    for(unsigned i = 0; i < m_stores.size(); i++) {
+        if(m_stores[i] > 0)
+            out << "    " << i << ": " << m_stores[i] << endl;
     }
 
     for(multimap<Ticks_t, Req_info>::iterator it = m_req_info.begin(); it != m_req_info.end(); ++it) {
@@ -237,6 +404,13 @@ void Controller :: print_stats(ostream& out)
     }
     out << "Avg requests: " << (double)stats_requests_count_integration / manifold::kernel::Manifold::NowTicks() << endl;
     out << "Avg requests(excluding 0-requests periods): " << (double)stats_requests_count_integration / stats_non_zero_requests_ticks << endl; //average requests calculated over the periods when there was 1 or more request
+    if(m_queues) {
+        out << "Row hits: " << stats_row_hits << "  row misses: " << stats_row_misses;
+	if(stats_row_hits + stats_row_misses > 0)
+	    out << "  hit rate: " << (double)stats_row_hits / (stats_row_hits + stats_row_misses);
+	out << endl;
+        out << "Write drains: " << stats_write_drains << endl;
+    }
 
     for (int i = 0; i < this->dramSetting->numChannels; i++) {
 	out << "Channel " << i << ":" << endl;
@@ -246,6 +420,69 @@ void Controller :: print_stats(ostream& out)
 
 
 
+void Controller :: get_ei_counters(EI::counters_t& c)
+{
+    c.reset();
+    for (int i = 0; i < dramSetting->numChannels; i++) {
+	for (int r = 0; r < dramSetting->numRanks; r++) {
+	    for (int b = 0; b < dramSetting->numBanks; b++) {
+		EI::counters_t bc;
+		myChannel[i]->get_rank(r)->get_bank(b)->get_ei_counters(bc);
+		c.search += bc.search;
+		c.read += bc.read;
+		c.write += bc.write;
+		c.read_tag += bc.read_tag;
+		c.write_tag += bc.write_tag;
+	    }
+	}
+    }
+}
+
+
+
+void Controller :: get_stat_engines(vector<manifold::kernel::Stat_engine*>& engines)
+{
+    for (int i = 0; i < dramSetting->numChannels; i++) {
+	for (int r = 0; r < dramSetting->numRanks; r++) {
+	    for (int b = 0; b < dramSetting->numBanks; b++)
+		engines.push_back(myChannel[i]->get_rank(r)->get_bank(b)->get_stats());
+	}
+    }
+}
+
+
+
+void Controller :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    assert(stats_requests_count == 0 && m_completed_reqs.size() == 0);
+
+    out.write(dramSetting->numChannels);
+    out.write(dramSetting->numRanks);
+    out.write(dramSetting->numBanks);
+    for (int i = 0; i < dramSetting->numChannels; i++)
+	myChannel[i]->checkpoint(out);
+    out.write(m_downstream_credits);
+}
+
+
+void Controller :: restore(manifold::kernel::CheckpointIn& in)
+{
+    int channels, ranks, banks;
+    in.read(channels);
+    in.read(ranks);
+    in.read(banks);
+    if(channels != dramSetting->numChannels || ranks != dramSetting->numRanks || banks != dramSetting->numBanks) {
+        cerr << "Checkpoint: CaffDRAM " << m_nid << " has " << channels << " channels, " << ranks << " ranks, "
+	     << banks << " banks; the restoring configuration is different." << endl;
+	exit(1);
+    }
+    for (int i = 0; i < dramSetting->numChannels; i++)
+	myChannel[i]->restore(in);
+    in.read(m_downstream_credits);
+}
+
+
+
 void Controller :: credit_received(NetworkPacket* pkt)
 {
     delete pkt;
@@ -268,8 +505,7 @@ void Controller :: request_complete(NetworkPacket* pkt, bool read)
 	delete pkt;
 
 	//Send a credit downstream.
-	NetworkPacket* credit_pkt = new NetworkPacket();
-	credit_pkt->type = CREDIT_MSG_TYPE;   
+	NetworkPacket* credit_pkt = NetworkPacket::Create_credit(CREDIT_MSG_TYPE);
 	Send(PORT0, credit_pkt);
     }
 }
@@ -292,8 +528,7 @@ void Controller :: try_send()
         m_downstream_credits--;
 
 	//Send a credit downstream.
-        NetworkPacket* credit_pkt = new NetworkPacket();
-        credit_pkt->type = CREDIT_MSG_TYPE;   
+        NetworkPacket* credit_pkt = NetworkPacket::Create_credit(CREDIT_MSG_TYPE);
         Send(PORT0, credit_pkt);
    }
 }
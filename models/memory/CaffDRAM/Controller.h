@@ -11,6 +11,7 @@
 #include "Channel.h"
 #include "Dsettings.h"
 #include "Dreq.h"
+#include "RingBuffer.h"
 
 #include "kernel/component-decl.h"
 #include "kernel/manifold-decl.h"
@@ -18,6 +19,8 @@
 
 #include <map>
 #include <list>
+#include <deque>
+#include <vector>
 
 //#define DBG_CAFFDRAM 1
 
@@ -40,9 +43,20 @@ public:
 	template<typename T>
 	void handle_request(int, uarch::NetworkPacket* pkt);
 
+        //! Sum of the command counters of all banks; see Bank::get_ei_counters().
+        void get_ei_counters(EI::counters_t&);
+
+        //! Appends the stat engines of all banks; used by sampled simulation.
+        void get_stat_engines(std::vector<manifold::kernel::Stat_engine*>&);
+
         void print_config(std::ostream&);
         void print_stats(std::ostream&);
 
+        //! Save/restore the bank states and credits. Requests in progress
+        //! cannot be saved, so the controller must be idle.
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
 	static void Set_msg_types(int mem, int credit)
 	{
 	    assert(Msg_type_set == false);
@@ -56,7 +70,12 @@ public:
 #else
 private:
 #endif
-	unsigned long int processRequest (unsigned long int reqAddr, unsigned long int currentTime);
+	unsigned long int processRequest (unsigned long int reqAddr, unsigned long int currentTime, bool read = true);
+
+	//FR_FCFS scheduler
+	void enqueueRequest(uarch::NetworkPacket*, unsigned long int reqAddr, bool read);
+	void tick(); //rising edge handler
+	void scheduleChannel(int ch, unsigned long int now);
 
 	//Called when a request is complete.
 	void request_complete(uarch::NetworkPacket*, bool read);
@@ -74,9 +93,35 @@ private:
 
 	int m_downstream_credits;
 	const int m_DOWNSTREAM_FULL_CREDITS; //for debug
-	std::list<uarch::NetworkPacket*> m_completed_reqs; //this is the output buffer holding completed requests.
+	std::deque<uarch::NetworkPacket*> m_completed_reqs; //this is the output buffer holding completed requests.
 
 
+	//A request waiting to be scheduled.
+	struct Queued_req {
+	    Queued_req() {}
+	    Queued_req(const Dreq& d, uarch::NetworkPacket* p, bool r) : dreq(d), pkt(p), read(r) {}
+	    Dreq dreq;
+	    uarch::NetworkPacket* pkt;
+	    bool read;
+	};
+
+	struct Channel_queue {
+	    std::vector<RingBuffer<Queued_req> > bankQ; //per-bank queues in arrival order; indexed by rank*numBanks + bank
+	    RingBuffer<Queued_req> waitQ; //requests that arrived when the read or write queue was full
+	    std::vector<int> bypassed; //per bank: row hits issued ahead of the bank's oldest request
+	    int numReads; //reads in bankQ
+	    int numWrites; //writes in bankQ
+	    bool drainingWrites;
+	};
+
+	bool has_room(const Channel_queue& q, bool read)
+	{
+	    return read ? q.numReads < dramSetting->readQueueSize : q.numWrites < dramSetting->writeQueueSize;
+	}
+	void add_to_bankQ(Channel_queue& q, const Queued_req& r);
+
+	Channel_queue* m_queues; //one per channel; 0 unless the scheduler is FR_FCFS
+
 	//for stats
 	struct Req_info {
 	    Req_info(int t, int oid, int sid, uint64_t a) : type(t), org_id(oid), src_id(sid), addr(a) {}
@@ -86,8 +131,16 @@ private:
 	    uint64_t addr;
 	};
 
-	std::map<int, int> m_ld_misses; //number of ld misses per source
-	std::map<int, int> m_stores;
+	//number of ld misses and stores per source, indexed by source id; grown on demand
+	std::vector<uint64_t> m_ld_misses;
+	std::vector<uint64_t> m_stores;
+	static void count_source(std::vector<uint64_t>& counts, int src)
+	{
+	    assert(src >= 0);
+	    if((unsigned)src >= counts.size())
+		counts.resize(src + 1, 0);
+	    counts[src]++;
+	}
 	std::multimap<manifold::kernel::Ticks_t, Req_info> m_req_info; //request info in time order
 
 	//for calculating average accepted requests
@@ -99,6 +152,9 @@ private:
 
 	//stats
 	unsigned stats_max_output_buffer_size;
+	uint64_t stats_row_hits; //requests issued by the FR_FCFS scheduler that hit the open row
+	uint64_t stats_row_misses;
+	uint64_t stats_write_drains; //number of times the scheduler switched to draining writes
 
         manifold::kernel::Clock *clock;
 
@@ -129,6 +185,7 @@ void Controller :: handle_request(int, uarch::NetworkPacket* pkt)
     stats_last_requests_count_change_tick = manifold::kernel::Manifold::NowTicks();
 
 
+    pkt->unshare_data(); //the request is turned into the reply in place.
     T* req = (T*)(pkt->data);
 
     if(req->is_read()) {
@@ -136,7 +193,7 @@ void Controller :: handle_request(int, uarch::NetworkPacket* pkt)
 cerr << "@" << dec << manifold::kernel::Manifold::NowTicks() << "mc received LD, src= " << pkt->get_src() << " port= " << pkt->get_src_port() << " addr= " <<hex<< req->get_addr() <<dec<<endl;
 #endif
 	//stats
-	m_ld_misses[pkt->get_src()]++;
+	count_source(m_ld_misses, pkt->get_src());
 	/*
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemLd, req->u.mem.originator_id, req->u.mem.source_id, req->u.mem.addr)));
@@ -151,16 +208,22 @@ cerr << "@" << dec << manifold::kernel::Manifold::NowTicks() << "mc received LD,
 	req->set_dst_port(pkt->get_src_port());
 	req->set_src(m_nid);
 	req->set_src_port(0);
-	manifold::kernel::Ticks_t latency = processRequest(req->get_addr(), manifold::kernel::Manifold::NowTicks()); //????????????? using default clock here.
-	//The return value of processRequest() is the actual (or absolute) time of when the request
-	//is completed, but Sendtick requires time relative to now. So we must pass to SendTick
-	//the return value - now.
 
 	//reuse the network packet object.
 	pkt->set_dst(pkt->get_src());
 	pkt->set_dst_port(pkt->get_src_port());
 	pkt->set_src(m_nid);
 	pkt->set_src_port(0);
+
+	if(m_queues) {
+	    enqueueRequest(pkt, req->get_addr(), true);
+	    return;
+	}
+
+	manifold::kernel::Ticks_t latency = processRequest(req->get_addr(), manifold::kernel::Manifold::NowTicks()); //????????????? using default clock here.
+	//The return value of processRequest() is the actual (or absolute) time of when the request
+	//is completed, but Sendtick requires time relative to now. So we must pass to SendTick
+	//the return value - now.
 	//SendTick(PORT0, pkt, latency - manifold::kernel::Manifold::NowTicks());
 	manifold::kernel::Manifold::Schedule(latency - manifold::kernel::Manifold::NowTicks(), &Controller::request_complete, this, pkt, true);
     }
@@ -169,12 +232,11 @@ cerr << "@" << dec << manifold::kernel::Manifold::NowTicks() << "mc received LD,
 cerr << "@" << dec << manifold::kernel::Manifold::NowTicks() << "mc received ST, src= " << pkt->get_src() << " port= " << pkt->get_src_port() << " addr= " <<hex<< req->get_addr() <<dec<<endl;
 #endif
 	//stats
-	m_stores[req->get_src()]++;
+	count_source(m_stores, req->get_src());
 	/*
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemSt, req->u.mem.originator_id, req->u.mem.source_id, req->u.mem.addr)));
 						  */
-	manifold::kernel::Ticks_t latency = processRequest(req->get_addr(), manifold::kernel::Manifold::NowTicks()); //????????????? using default clock here.
         if(m_send_st_response) {
 	    req->set_dst(pkt->get_src());
 	    req->set_dst_port(pkt->get_src_port());
@@ -190,6 +252,13 @@ cerr << "@" << dec << manifold::kernel::Manifold::NowTicks() << "mc received ST,
 	    pkt->set_src_port(0);
 	    //SendTick(PORT0, pkt, latency - manifold::kernel::Manifold::NowTicks());
 	}
+
+	if(m_queues) {
+	    enqueueRequest(pkt, req->get_addr(), false);
+	    return;
+	}
+
+	manifold::kernel::Ticks_t latency = processRequest(req->get_addr(), manifold::kernel::Manifold::NowTicks(), false); //????????????? using default clock here.
 	manifold::kernel::Manifold::Schedule(latency - manifold::kernel::Manifold::NowTicks(), &Controller::request_complete, this, pkt, false);
     }
 }
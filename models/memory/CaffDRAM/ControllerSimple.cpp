@@ -40,14 +40,14 @@ ControllerSimple :: ~ControllerSimple() {
 	delete this->dramSetting;
 }
 
-unsigned long int ControllerSimple::processRequest(unsigned long int reqAddr, unsigned long int currentTime)
+unsigned long int ControllerSimple::processRequest(unsigned long int reqAddr, unsigned long int currentTime, bool read)
 {
-	Dreq* dRequest = new Dreq (reqAddr, currentTime, this->dramSetting);
+	//the request lives only for this call, so it's kept on the stack
+	Dreq dRequest(reqAddr, currentTime, this->dramSetting, read);
 #ifdef DBG_CAFFDRAM
-cout << "ch-rank-bank = " << dRequest->get_chId() << "-" << dRequest->get_rankId() << "-" << dRequest->get_bankId() << endl;
+cout << "ch-rank-bank = " << dRequest.get_chId() << "-" << dRequest.get_rankId() << "-" << dRequest.get_bankId() << endl;
 #endif
-	unsigned long int returnLatency = this->myChannel[dRequest->get_chId()]->processRequest(dRequest);
-	delete dRequest;
+	unsigned long int returnLatency = this->myChannel[dRequest.get_chId()]->processRequest(&dRequest);
 	return (returnLatency);
 }
 
@@ -39,7 +39,7 @@ public:
 #else
 private:
 #endif
-    unsigned long int processRequest (unsigned long int reqAddr, unsigned long int currentTime);
+    unsigned long int processRequest (unsigned long int reqAddr, unsigned long int currentTime, bool read = true);
 
     //Called when a request is complete.
     template<typename T>
@@ -89,7 +89,7 @@ cout << "mc received ST, addr= " <<hex<< req->get_addr() <<dec<<endl;
 #endif
 	//stats
 	stats_stores++;
-	manifold::kernel::Ticks_t latency = processRequest(req->get_addr(), manifold::kernel::Manifold::NowTicks()); //????????????? using default clock here.
+	manifold::kernel::Ticks_t latency = processRequest(req->get_addr(), manifold::kernel::Manifold::NowTicks(), false); //????????????? using default clock here.
         if(m_send_st_response) {
 	    manifold::kernel::Manifold::Schedule(latency - manifold::kernel::Manifold::NowTicks(), &ControllerSimple::request_complete<T>, this, req);
 	}
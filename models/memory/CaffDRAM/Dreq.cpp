@@ -12,36 +12,10 @@ namespace manifold {
 namespace caffdram {
 
 
-Dreq::Dreq(unsigned long int reqAddr, unsigned long int currentTime, const Dsettings* dramSetting) {
-	// TODO Auto-generated constructor stub
-
-	this->generateId(reqAddr, dramSetting);
-	this->originTime = currentTime + dramSetting->t_CMD;
-	this->endTime = currentTime + dramSetting->t_CMD;
-}
-
 Dreq::~Dreq() {
 	// TODO Auto-generated destructor stub
 }
 
-void Dreq::generateId(unsigned long int reqAddr, const Dsettings* dramSetting)
-{
-	//this->rowId = (reqAddr>>(dramSetting->rowShiftBits))&(dramSetting->rowMask);
-	this->rowId = (reqAddr>>12)&(0x3) || (reqAddr>>dramSetting->rowShiftBits)&(dramSetting->rowMask>>2);
-	//this->bankId = (reqAddr>>(dramSetting->bankShiftBits))&(dramSetting->bankMask);
-	this->bankId = (reqAddr>>(dramSetting->bankShiftBits))&(dramSetting->bankMask);
-	this->rankId = (reqAddr>>(dramSetting->rankShiftBits))&(dramSetting->rankMask);
-	if (dramSetting->numChannels == 1)
-	{
-		this->chId = 0;
-	}
-	else
-	{
-		this->chId = (reqAddr>>(dramSetting->channelShiftBits))%(dramSetting->numChannels);
-	}
-}
-
-
 
 } //namespace caffdram
 } //namespace manifold
@@ -19,17 +19,24 @@ namespace caffdram {
 class Dreq {
 public:
 
-	Dreq(unsigned long int reqAddr, unsigned long int currentTime, const Dsettings* dramSetting);
+	Dreq(unsigned long int reqAddr, unsigned long int currentTime, const Dsettings* dramSetting, bool read = true);
+	Dreq() {} //for the slots of the scheduler queues, which are assigned before use
 	~Dreq();
 
-        unsigned long get_originTime() { return originTime; }
-        unsigned long get_endTime() { return endTime; }
+        unsigned long get_originTime() const { return originTime; }
+        unsigned long get_endTime() const { return endTime; }
 	void set_endTime(unsigned long t) { endTime = t; }
 
-	unsigned get_chId() { return chId; }
-	unsigned get_rankId() { return rankId; }
-	unsigned get_bankId() { return bankId; }
-	unsigned get_rowId() { return rowId; }
+	unsigned get_chId() const { return chId; }
+	unsigned get_rankId() const { return rankId; }
+	unsigned get_bankId() const { return bankId; }
+	unsigned get_rowId() const { return rowId; }
+	bool is_read() const { return read; }
+
+	//! Set by the bank if the request opens a row: the time of the activate command.
+	bool is_activated() const { return activated; }
+	unsigned long get_actTime() const { return actTime; }
+	void set_actTime(unsigned long t) { activated = true; actTime = t; }
 
 #ifdef CAFFDRAM_TEST
 public:
@@ -44,9 +51,47 @@ private:
 	unsigned int rankId;
 	unsigned int bankId;
 	unsigned int rowId;
+	bool read;
+	bool activated;
+	unsigned long int actTime;
 
 };
 
+
+//! Requests are created for every memory access, so the constructor and the
+//! address decode are inline.
+inline Dreq::Dreq(unsigned long int reqAddr, unsigned long int currentTime, const Dsettings* dramSetting, bool read) {
+	this->generateId(reqAddr, dramSetting);
+	this->originTime = currentTime + dramSetting->t_CMD;
+	this->endTime = currentTime + dramSetting->t_CMD;
+	this->read = read;
+	this->activated = false;
+	this->actTime = 0;
+}
+
+inline void Dreq::generateId(unsigned long int reqAddr, const Dsettings* dramSetting)
+{
+	if (!dramSetting->addressMapping.empty())
+	{
+		dramSetting->decode(reqAddr, this->chId, this->rankId, this->bankId, this->rowId);
+		return;
+	}
+
+	//this->rowId = (reqAddr>>(dramSetting->rowShiftBits))&(dramSetting->rowMask);
+	this->rowId = (reqAddr>>12)&(0x3) || (reqAddr>>dramSetting->rowShiftBits)&(dramSetting->rowMask>>2);
+	//this->bankId = (reqAddr>>(dramSetting->bankShiftBits))&(dramSetting->bankMask);
+	this->bankId = (reqAddr>>(dramSetting->bankShiftBits))&(dramSetting->bankMask);
+	this->rankId = (reqAddr>>(dramSetting->rankShiftBits))&(dramSetting->rankMask);
+	if (dramSetting->numChannels == 1)
+	{
+		this->chId = 0;
+	}
+	else
+	{
+		this->chId = (reqAddr>>(dramSetting->channelShiftBits))%(dramSetting->numChannels);
+	}
+}
+
 } //namespace caffdram
 } //namespace manifold
 
@@ -9,6 +9,7 @@
 //#include <math.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <iostream>
 
 namespace manifold {
 namespace caffdram {
@@ -57,6 +58,25 @@ Dsettings::Dsettings(
 	this->memPagePolicy = OPEN_PAGE;
 	this->numDatabusPackets = (int) ((this->llcacheLineSizeBytes*8)/this->channelBitWidth);
 
+	/********************** Scheduler Config ****************/
+	this->memSchedPolicy = ANALYTIC;
+	this->readQueueSize = 32;
+	this->writeQueueSize = 32;
+	this->writeHighWatermark = 24;
+	this->writeLowWatermark = 8;
+	this->rowHitCap = 4;
+
+	/********************** Address Mapping *****************/
+	this->bankXor = false;
+	this->channelXor = false;
+	this->numMcs = 1;
+	this->mcInterleaveShift = 12;
+	this->mcXor = false;
+
+	/********************** Refresh and Power Config ********/
+	this->memRefreshPolicy = NO_REFRESH;
+	this->powerDownIdleTime = 0;
+
 	/********************** Timing Parameters ***************/
 	this->t_RTRS = t_RTRS;
 	this->t_OST = t_OST;
@@ -75,7 +95,10 @@ Dsettings::Dsettings(
 	this->t_RC = this->t_RAS + this->t_RP;
 	this->t_RTP = this->t_RAS - this->t_RCD;
 	this->t_CWD = (this->t_CAS - 1);
-	this->t_RFC = this->numRows*(this->t_RC);
+	this->t_RFC = 300;
+	this->t_RFCpb = 130;
+	this->t_REF_INT = 14000;
+	this->t_XP = 10;
 
 	/************** Dreq Helper Variables ********************/
 
@@ -89,6 +112,8 @@ Dsettings::Dsettings(
 	this->rowMask = this->getMask(myLog2(this->numRows));
 	this->bankMask = this->getMask(myLog2(this->numBanks));
 	this->rankMask = this->getMask(myLog2(this->numRanks));
+
+	this->parseAddressMapping();
 }
 
 
@@ -108,10 +133,23 @@ void Dsettings :: update()
 
     this->numDatabusPackets = (int) ((this->llcacheLineSizeBytes*8)/this->channelBitWidth);
 
+    if(this->memSchedPolicy == FR_FCFS) {
+	assert(readQueueSize > 0 && writeQueueSize > 0);
+	assert(writeLowWatermark >= 0 && writeLowWatermark < writeHighWatermark);
+	assert(writeHighWatermark <= writeQueueSize);
+	assert(rowHitCap >= 0);
+    }
+
     this->t_RC = this->t_RAS + this->t_RP;
     this->t_RTP = this->t_RAS - this->t_RCD;
     this->t_CWD = (this->t_CAS - 1);
-    this->t_RFC = this->numRows*(this->t_RC);
+
+    if(this->memRefreshPolicy != NO_REFRESH) {
+	assert(t_REF_INT > 0);
+	assert(t_RFC < t_REF_INT);
+	if(this->memRefreshPolicy == PER_BANK_REFRESH)
+	    assert(t_RFCpb < t_REF_INT / numBanks);
+    }
 
     this->rowShiftBits = (int) (myLog2(this->numColumns)) + 2;
     this->bankShiftBits = ((int) (myLog2(this->numRows))) + this->rowShiftBits;
@@ -124,6 +162,76 @@ void Dsettings :: update()
     this->rowMask = this->getMask(myLog2(this->numRows));
     this->bankMask = this->getMask(myLog2(this->numBanks));
     this->rankMask = this->getMask(myLog2(this->numRanks));
+
+    this->parseAddressMapping();
+}
+
+
+//! Compute the position of each field of addressMapping.
+void Dsettings :: parseAddressMapping()
+{
+    assert(is_powerOf2(numMcs));
+    this->mcSelectBits = myLog2(numMcs);
+
+    int lineColumns = llcacheLineSizeBytes * 8 / channelBitWidth; //columns in a cache line
+
+    this->mapBits[MAP_CH] = myLog2(numChannels);
+    this->mapBits[MAP_RANK] = myLog2(numRanks);
+    this->mapBits[MAP_BANK] = myLog2(numBanks);
+    this->mapBits[MAP_ROW] = myLog2(numRows);
+    this->mapBits[MAP_COL] = (numColumns > lineColumns) ? myLog2(numColumns / lineColumns) : 0;
+
+    if(addressMapping.empty())
+        return;
+
+    static const char* const names[MAP_FIELDS] = { "Ch", "Ra", "Ba", "Ro", "Co" };
+    bool seen[MAP_FIELDS] = { false, false, false, false, false };
+    unsigned shift = myLog2(llcacheLineSizeBytes);
+
+    //fields are listed from the most significant; assign shifts from the least.
+    bool ok = (addressMapping.size() == 2 * MAP_FIELDS);
+    for(int i = MAP_FIELDS - 1; ok && i >= 0; i--) {
+        std::string token = addressMapping.substr(2 * i, 2);
+	int f = 0;
+	while(f < MAP_FIELDS && token != names[f])
+	    f++;
+	if(f == MAP_FIELDS || seen[f]) {
+	    ok = false;
+	    break;
+	}
+	seen[f] = true;
+	this->mapShift[f] = shift;
+	shift += this->mapBits[f];
+    }
+    if(!ok) {
+        std::cerr << "CaffDRAM: invalid address mapping " << addressMapping
+	          << "; it must list each of Ro, Ba, Ra, Co and Ch once, e.g., RoBaRaCoCh." << std::endl;
+	exit(1);
+    }
+}
+
+
+void Dsettings :: decode(uint64_t addr, unsigned& ch, unsigned& rank, unsigned& bank, unsigned& row) const
+{
+    assert(!addressMapping.empty());
+
+    //remove the bits that select the MC
+    if(mcSelectBits > 0) {
+        uint64_t low = addr & (((uint64_t)0x1 << mcInterleaveShift) - 1);
+	addr = ((addr >> (mcInterleaveShift + mcSelectBits)) << mcInterleaveShift) | low;
+    }
+
+    ch = (addr >> mapShift[MAP_CH]) & (((uint64_t)0x1 << mapBits[MAP_CH]) - 1);
+    rank = (addr >> mapShift[MAP_RANK]) & (((uint64_t)0x1 << mapBits[MAP_RANK]) - 1);
+    bank = (addr >> mapShift[MAP_BANK]) & (((uint64_t)0x1 << mapBits[MAP_BANK]) - 1);
+    row = (addr >> mapShift[MAP_ROW]) & (((uint64_t)0x1 << mapBits[MAP_ROW]) - 1);
+
+    //permutation-based interleaving: rows that conflict in the same bank are spread
+    //over different banks (and channels).
+    if(bankXor)
+        bank ^= row & (((uint64_t)0x1 << mapBits[MAP_BANK]) - 1);
+    if(channelXor)
+        ch ^= (row >> mapBits[MAP_BANK]) & (((uint64_t)0x1 << mapBits[MAP_CH]) - 1);
 }
 
 
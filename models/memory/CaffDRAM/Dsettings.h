@@ -8,6 +8,8 @@
 #ifndef MANIFOLD_CAFFDRAM_DSETTINGS_H_
 #define MANIFOLD_CAFFDRAM_DSETTINGS_H_
 
+#include <string>
+#include <stdint.h>
 
 
 namespace manifold {
@@ -20,6 +22,29 @@ typedef enum {
 	CLOSED_PAGE
 } pagePolicy;
 
+//! How the controller schedules requests.
+//! ANALYTIC: each request is timed as soon as it arrives, in arrival order, from the
+//! time its bank becomes available. This is the fast option.
+//! FR_FCFS: requests are held in per-bank queues and issued one per channel each
+//! cycle, row hits first, then oldest first. A bank's oldest request is issued
+//! once rowHitCap younger row hits have gone ahead of it. Writes are buffered and
+//! drained in batches, and the data bus of each channel is shared by its ranks.
+typedef enum {
+
+	ANALYTIC = 0,
+	FR_FCFS
+} schedulerPolicy;
+
+//! How the ranks are refreshed. With ALL_BANK_REFRESH, all banks of a rank are
+//! refreshed together every t_REF_INT for t_RFC. With PER_BANK_REFRESH, one bank
+//! at a time is refreshed for t_RFCpb, in turn, every t_REF_INT/numBanks.
+typedef enum {
+
+	NO_REFRESH = 0,
+	ALL_BANK_REFRESH,
+	PER_BANK_REFRESH
+} refreshPolicy;
+
 /*
  *
  */
@@ -45,6 +70,33 @@ public:
 	int numDatabusPackets;
 	pagePolicy memPagePolicy;
 
+	/******************* Scheduler Config **************/
+	schedulerPolicy memSchedPolicy;
+	int readQueueSize;			// max reads held for scheduling per channel
+	int writeQueueSize;			// max writes held for scheduling per channel
+	int writeHighWatermark;			// start draining writes at this many writes
+	int writeLowWatermark;			// stop draining writes at this many writes
+	int rowHitCap;				// max younger row hits issued ahead of a bank's oldest request; 0 for no cap
+
+	/******************* Refresh and Power Config ******/
+	refreshPolicy memRefreshPolicy;
+	unsigned long int powerDownIdleTime;		// a rank idle this long enters power-down; 0 disables power-down
+
+	/******************* Address Mapping ***************/
+	//! Order of the address fields from the most to the least significant bits; each
+	//! of Ro(w), Ba(nk), Ra(nk), Co(lumn) and Ch(annel) appears once, e.g., "RoBaRaCoCh".
+	//! Below the fields are the byte offset bits of a cache line, so Co selects a cache
+	//! line within a row. If empty, the original fixed mapping is used.
+	std::string addressMapping;
+	bool bankXor;						// bank ^= low bits of row
+	bool channelXor;					// channel ^= the row bits above those used for bankXor
+	int numMcs;							// the MC select bits are removed from an address before it is decoded
+	int mcInterleaveShift;				// lowest MC select bit: 12 interleaves 4KB pages, 6 interleaves 64B lines
+	bool mcXor;							// MC select bits ^= all the address bits above them
+
+	//! Decode an address with addressMapping.
+	void decode(uint64_t addr, unsigned& ch, unsigned& rank, unsigned& bank, unsigned& row) const;
+
 	/******************* Timing Parameters *************/
 
 	unsigned long int t_RTRS;					// t_RTRS  	: Rank to Rank Switching time
@@ -65,6 +117,8 @@ public:
 	unsigned long int t_RRD;					// t_RRD	: Row to Row Activation Delay
 	unsigned long int t_RC;						// t_RC		: Row Cycle time
 	unsigned long int t_REF_INT;				// t_REF_INT: Refresh Interval Period
+	unsigned long int t_RFCpb;					// t_RFCpb	: Per-bank Refresh cycle time
+	unsigned long int t_XP;						// t_XP		: Power-down Exit latency
 
 	/*********** Dreq Helper Variables ****************/
 
@@ -76,6 +130,11 @@ public:
 	unsigned int bankMask;
 	unsigned int rankMask;
 
+	enum { MAP_CH = 0, MAP_RANK, MAP_BANK, MAP_ROW, MAP_COL, MAP_FIELDS };
+	unsigned int mapShift[MAP_FIELDS];		// computed from addressMapping
+	unsigned int mapBits[MAP_FIELDS];
+	unsigned int mcSelectBits;
+
 
 	Dsettings(
 	    int numChannels = 2,//1
@@ -107,6 +166,13 @@ public:
 	~Dsettings();
 
 	void update();
+
+#ifdef CAFFDRAM_TEST
+public:
+#else
+private:
+#endif
+	void parseAddressMapping();
 };
 
 } //namespace caffdram
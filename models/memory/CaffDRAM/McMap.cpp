@@ -11,6 +11,10 @@ namespace caffdram {
 CaffDramMcMap :: CaffDramMcMap(std::vector<int>& nodeIds, const Dsettings& sett) : m_nodeIds(nodeIds)
 {
     assert(nodeIds.size() > 0);
+    //the controllers must remove the same select bits from the addresses.
+    assert(sett.addressMapping.empty() || sett.numMcs == (int)nodeIds.size());
+
+    m_mc_xor = sett.mcXor;
 
     if(nodeIds.size() > 1) {
 	//Determine the number of bits required to select the MC nodes.
@@ -30,7 +34,8 @@ CaffDramMcMap :: CaffDramMcMap(std::vector<int>& nodeIds, const Dsettings& sett)
 	}
 
 	//m_mc_shift_bits = sett.channelShiftBits + ch_bits;
-	m_mc_shift_bits = 12; //4KB page
+	m_mc_shift_bits = sett.mcInterleaveShift; //12 for 4KB page
+	m_mc_selector_bits = mc_selector_bits;
     }
 
 }
@@ -44,6 +49,10 @@ int CaffDramMcMap :: lookup(uint64_t addr)
     }
     else {
 	int idx = ((addr >> m_mc_shift_bits) & m_mc_selector_mask);
+	if(m_mc_xor) {
+	    for(uint64_t upper = addr >> (m_mc_shift_bits + m_mc_selector_bits); upper != 0; upper >>= m_mc_selector_bits)
+		idx ^= (upper & m_mc_selector_mask);
+	}
 	assert(idx < m_nodeIds.size());
 	return m_nodeIds[idx];
     }
@@ -24,7 +24,9 @@ private:
 
     std::vector<int> m_nodeIds;
     int m_mc_shift_bits;
+    int m_mc_selector_bits;
     uint64_t  m_mc_selector_mask;
+    bool m_mc_xor; //fold all the address bits above the selector into it
 };
 
 
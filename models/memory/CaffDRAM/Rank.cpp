@@ -23,7 +23,16 @@ Rank::Rank(const Dsettings* dramSetting) {
 	{
 		this->myBank[i] = new Bank(this->dramSetting);
 	}
-	
+
+	this->nextRefreshTime = (this->dramSetting->memRefreshPolicy == PER_BANK_REFRESH) ?
+	                        this->dramSetting->t_REF_INT / this->dramSetting->numBanks : this->dramSetting->t_REF_INT;
+	this->nextRefreshBank = 0;
+	this->numActs = 0;
+	this->lastAct = 0;
+	this->busyUntil = 0;
+	this->stats_activePowerDownCycles = 0;
+	this->stats_prechargePowerDownCycles = 0;
+	this->stats_powerDownExits = 0;
 }
 
 Rank::~Rank() {
@@ -47,17 +56,176 @@ Rank :: Rank(const Rank& r)
 unsigned long int Rank::processRequest(Dreq* dRequest)
 {
 	unsigned long int returnLatency = 0;
-	returnLatency = this->myBank[dRequest->get_bankId()]->processRequest(dRequest);
+	Bank* bank = this->myBank[dRequest->get_bankId()];
+
+	this->refresh(dRequest->get_originTime());
+	bank->block_until(this->wake_up(dRequest->get_originTime()));
+
+	returnLatency = bank->processRequest(dRequest, this->get_actReady());
+	this->record_activate(dRequest);
+	this->update_busyUntil(dRequest);
 	return (returnLatency);
 }
 
 
+unsigned long int Rank::issueRequest(Dreq* dRequest, bool read, unsigned long int now, unsigned long int busAvailableAtTime)
+{
+	Bank* bank = this->myBank[dRequest->get_bankId()];
+
+	unsigned long int issueTime = this->wake_up(now);
+	unsigned long int endT = bank->issueRequest(dRequest, read, issueTime, busAvailableAtTime, this->get_actReady());
+	this->record_activate(dRequest);
+	this->update_busyUntil(dRequest);
+	return (endT);
+}
+
+
+void Rank::refresh(unsigned long int t)
+{
+	if (this->dramSetting->memRefreshPolicy == NO_REFRESH)
+		return;
+
+	while (this->nextRefreshTime <= t)
+	{
+		unsigned long int start = this->nextRefreshTime;
+		bool rowOpen = false;
+		int first = 0;
+		int last = this->dramSetting->numBanks;
+		if (this->dramSetting->memRefreshPolicy == PER_BANK_REFRESH)
+		{
+			first = this->nextRefreshBank;
+			last = first + 1;
+		}
+
+		for (int i = first; i < last; i++)
+		{
+			if (start < this->myBank[i]->get_availableTime())
+				start = this->myBank[i]->get_availableTime();
+			rowOpen = rowOpen || this->myBank[i]->is_rowOpen();
+		}
+		if (rowOpen)
+			start += this->dramSetting->t_RP;
+
+		unsigned long int endT;
+		if (this->dramSetting->memRefreshPolicy == PER_BANK_REFRESH)
+		{
+			endT = start + this->dramSetting->t_RFCpb;
+			this->nextRefreshBank = (this->nextRefreshBank + 1) % this->dramSetting->numBanks;
+			this->nextRefreshTime += this->dramSetting->t_REF_INT / this->dramSetting->numBanks;
+		}
+		else
+		{
+			endT = start + this->dramSetting->t_RFC;
+			this->nextRefreshTime += this->dramSetting->t_REF_INT;
+		}
+
+		for (int i = first; i < last; i++)
+			this->myBank[i]->refresh(endT);
+		if (this->busyUntil < endT)
+			this->busyUntil = endT;
+	}
+}
+
+
+//! The earliest time an activate can be issued: t_RRD after the last activate and
+//! t_FAW after the 4th last. Either limit is disabled when it is 0.
+unsigned long int Rank::get_actReady() const
+{
+	unsigned long int actReady = 0;
+	if (this->numActs > 0 && this->dramSetting->t_RRD > 0)
+		actReady = this->actTimes[this->lastAct] + this->dramSetting->t_RRD;
+	if (this->numActs == FAW_ACTIVATES && this->dramSetting->t_FAW > 0)
+	{
+		unsigned long int fawT = this->actTimes[(this->lastAct + 1) % FAW_ACTIVATES] + this->dramSetting->t_FAW;
+		if (actReady < fawT)
+			actReady = fawT;
+	}
+	return (actReady);
+}
+
+
+void Rank::record_activate(Dreq* dRequest)
+{
+	if (!dRequest->is_activated())
+		return;
+
+	this->lastAct = (this->lastAct + 1) % FAW_ACTIVATES;
+	this->actTimes[this->lastAct] = dRequest->get_actTime();
+	if (this->numActs < FAW_ACTIVATES)
+		this->numActs++;
+}
+
+
+//! If power-down is enabled and the rank has been idle for powerDownIdleTime before
+//! time t, the rank has been in power-down since then, and the request must wait
+//! for t_XP. Returns the time the rank can accept commands.
+unsigned long int Rank::wake_up(unsigned long int t)
+{
+	if (this->dramSetting->powerDownIdleTime == 0 || t <= this->busyUntil + this->dramSetting->powerDownIdleTime)
+		return (t);
+
+	bool rowOpen = false;
+	for (int i = 0; i < this->dramSetting->numBanks; i++)
+		rowOpen = rowOpen || this->myBank[i]->is_rowOpen();
+
+	unsigned long int pdCycles = t - (this->busyUntil + this->dramSetting->powerDownIdleTime);
+	if (rowOpen)
+		this->stats_activePowerDownCycles += pdCycles;
+	else
+		this->stats_prechargePowerDownCycles += pdCycles;
+	this->stats_powerDownExits++;
+
+	return (t + this->dramSetting->t_XP);
+}
+
+
+void Rank::update_busyUntil(Dreq* dRequest)
+{
+	unsigned long int t = this->myBank[dRequest->get_bankId()]->get_availableTime();
+	if (t < dRequest->get_endTime())
+		t = dRequest->get_endTime();
+	if (this->busyUntil < t)
+		this->busyUntil = t;
+}
+
+
+void Rank::checkpoint (manifold::kernel::CheckpointOut& out)
+{
+    for (int i = 0; i < dramSetting->numBanks; i++)
+	myBank[i]->checkpoint(out);
+    out.write(nextRefreshTime);
+    out.write(nextRefreshBank);
+    out.write(actTimes);
+    out.write(numActs);
+    out.write(lastAct);
+    out.write(busyUntil);
+}
+
+
+void Rank::restore (manifold::kernel::CheckpointIn& in)
+{
+    for (int i = 0; i < dramSetting->numBanks; i++)
+	myBank[i]->restore(in);
+    in.read(nextRefreshTime);
+    in.read(nextRefreshBank);
+    in.read(actTimes);
+    in.read(numActs);
+    in.read(lastAct);
+    in.read(busyUntil);
+}
+
+
 void Rank::print_stats (ostream & out)
 {
      for (int i = 0; i < dramSetting->numBanks; i++) {
 	out << "Bank " << i << ":" << endl;
 	myBank[i]->print_stats(out);
     }
+    if (dramSetting->powerDownIdleTime > 0) {
+	out << "active power-down cycles= " << stats_activePowerDownCycles
+	    << " precharge power-down cycles= " << stats_prechargePowerDownCycles
+	    << " power-down exits= " << stats_powerDownExits << endl;
+    }
 }
 
 
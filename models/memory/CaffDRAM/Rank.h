@@ -22,12 +22,26 @@ namespace caffdram {
 class Rank {
 public:
 	unsigned long int processRequest (Dreq* dRequest);
+	//! For the FR_FCFS scheduler; see Bank::issueRequest().
+	unsigned long int issueRequest (Dreq* dRequest, bool read, unsigned long int now, unsigned long int busAvailableAtTime);
+
+	//! Perform the refreshes that are due at or before time t. Refreshes are done
+	//! lazily, when a request arrives or the scheduler runs, but each one starts at
+	//! its due time or when all the banks it refreshes are available.
+	void refresh(unsigned long int t);
 
 	Rank(const Dsettings* dramSetting);
 	~Rank();
 
+	Bank* get_bank(int i) { return myBank[i]; }
+	uint64_t get_activePowerDownCycles() const { return stats_activePowerDownCycles; }
+	uint64_t get_prechargePowerDownCycles() const { return stats_prechargePowerDownCycles; }
+
         void print_stats(ostream& out);
 
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
 #ifdef CAFFDRAM_TEST
 public:
 #else
@@ -36,9 +50,30 @@ private:
         Rank(const Rank&); //for unit test only
 
 
+	unsigned long int get_actReady() const;
+	void record_activate(Dreq* dRequest);
+	unsigned long int wake_up(unsigned long int t);
+	void update_busyUntil(Dreq* dRequest);
+
 	const Dsettings* dramSetting;
 	Bank** myBank;
 
+	unsigned long int nextRefreshTime;
+	int nextRefreshBank; //for per-bank refresh
+
+	//times of the last 4 activates, for t_RRD and t_FAW
+	enum { FAW_ACTIVATES = 4 };
+	unsigned long int actTimes[FAW_ACTIVATES];
+	int numActs; //number of valid entries in actTimes, up to FAW_ACTIVATES
+	int lastAct; //index of the last activate in actTimes
+
+	unsigned long int busyUntil; //the rank is idle after this time
+
+	//stats
+	uint64_t stats_activePowerDownCycles; //power-down with a row open
+	uint64_t stats_prechargePowerDownCycles; //power-down with all banks precharged
+	uint64_t stats_powerDownExits;
+
 };
 
 
@@ -0,0 +1,99 @@
+/*
+ * RingBuffer.h
+ *
+ * A FIFO stored in a power-of-two array, used for the request queues of the FR_FCFS
+ * scheduler. Unlike std::list, pushing, popping and erasing don't allocate; the array
+ * only grows (doubles) when a push finds it full. Elements can also be accessed and
+ * erased by their position from the front, since the scheduler may issue a request
+ * that is not at the front of its bank queue.
+ */
+
+#ifndef MANIFOLD_CAFFDRAM_RINGBUFFER_H_
+#define MANIFOLD_CAFFDRAM_RINGBUFFER_H_
+
+#include <vector>
+#include <assert.h>
+
+namespace manifold {
+namespace caffdram {
+
+template<typename T>
+class RingBuffer {
+public:
+	//! @param \c capacity  Initial capacity; rounded up to a power of 2.
+	explicit RingBuffer(unsigned capacity = 16) : m_head(0), m_size(0)
+	{
+		this->reserve(capacity);
+	}
+
+	bool empty() const { return m_size == 0; }
+	unsigned size() const { return m_size; }
+	unsigned capacity() const { return m_mask + 1; }
+
+	//! Make room for at least capacity elements; the buffer must be empty.
+	void reserve(unsigned capacity)
+	{
+		assert(m_size == 0);
+		unsigned cap = 1;
+		while (cap < capacity)
+			cap <<= 1;
+		m_buf.resize(cap);
+		m_head = 0;
+		m_mask = cap - 1;
+	}
+
+	//! The i-th element from the front.
+	T& operator[](unsigned i) { assert(i < m_size); return m_buf[(m_head + i) & m_mask]; }
+	const T& operator[](unsigned i) const { assert(i < m_size); return m_buf[(m_head + i) & m_mask]; }
+
+	T& front() { return (*this)[0]; }
+	const T& front() const { return (*this)[0]; }
+
+	void push_back(const T& x)
+	{
+		if (m_size == this->capacity())
+			this->grow();
+		m_buf[(m_head + m_size) & m_mask] = x;
+		m_size++;
+	}
+
+	void pop_front()
+	{
+		assert(m_size > 0);
+		m_head = (m_head + 1) & m_mask;
+		m_size--;
+	}
+
+	//! Remove the i-th element from the front; the elements before it are moved
+	//! back by one, so the order is kept.
+	void erase(unsigned i)
+	{
+		assert(i < m_size);
+		for (; i > 0; i--)
+			(*this)[i] = (*this)[i-1];
+		this->pop_front();
+	}
+
+private:
+	//! Double the capacity; the elements are moved to the start of the new array.
+	void grow()
+	{
+		std::vector<T> nbuf(2 * this->capacity());
+		for (unsigned i = 0; i < m_size; i++)
+			nbuf[i] = (*this)[i];
+		m_buf.swap(nbuf);
+		m_head = 0;
+		m_mask = m_buf.size() - 1;
+	}
+
+	std::vector<T> m_buf;
+	unsigned m_head; //index of the front element
+	unsigned m_size;
+	unsigned m_mask; //capacity - 1
+};
+
+
+} //namespace caffdram
+} //namespace manifold
+
+#endif /* MANIFOLD_CAFFDRAM_RINGBUFFER_H_ */
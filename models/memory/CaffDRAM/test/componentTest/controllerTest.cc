@@ -245,7 +245,7 @@ public:
 	mem_req mreq(m_senderp->get_nid(), addr, mem_req::LOAD);
 	NetworkPacket* pkt = new NetworkPacket;
 	pkt->type = MEM_MSG;
-	*((mem_req*)(pkt->data)) = mreq;
+	pkt->set_data(mreq);
 
 	const int RID = random() % 1024;
 	pkt->src = m_senderp->get_nid();
@@ -306,7 +306,7 @@ public:
 	mem_req mreq(m_senderp->get_nid(), addr, mem_req::STORE);
 	NetworkPacket* pkt = new NetworkPacket;
 	pkt->type = MEM_MSG;
-	*((mem_req*)(pkt->data)) = mreq;
+	pkt->set_data(mreq);
 
 	pkt->src = m_senderp->get_nid();
 	pkt->dst = nid;
@@ -421,7 +421,7 @@ public:
 
 	    pkts[i] = new NetworkPacket;
 	    pkts[i]->type = MEM_MSG;
-	    *((mem_req*)(pkts[i]->data)) = *(reqs[i]);
+	    pkts[i]->set_data(*(reqs[i]));
 
 	    pkts[i]->src = m_senderp->get_nid();
 	    pkts[i]->src_port = i;
@@ -597,7 +597,7 @@ cout<<" req " << i << ": CRB= " << req_crbs[i].ch << "-" << req_crbs[i].rank <<
 	    //reqs_copy[i] = *reqs[i];
 	    pkts[i] = new NetworkPacket;
 	    pkts[i]->type = MEM_MSG;
-	    *((mem_req*)(pkts[i]->data)) = *(reqs[i]);
+	    pkts[i]->set_data(*(reqs[i]));
 
 	    pkts[i]->src = m_senderp->get_nid();
 	    pkts[i]->src_port = i;
@@ -716,7 +716,7 @@ cout<<" req " << i << ": CRB= " << req_crbs[i].ch << "-" << req_crbs[i].rank <<
 
 	NetworkPacket* pkt = new NetworkPacket;
 	pkt->type = MEM_MSG;
-	*((mem_req*)(pkt->data)) = mreq;
+	pkt->set_data(mreq);
 
 	const int RID = 123; //request ID
 	pkt->src = m_senderp->get_nid();
@@ -774,7 +774,7 @@ cout<<" req " << i << ": CRB= " << req_crbs[i].ch << "-" << req_crbs[i].rank <<
 
 	NetworkPacket* pkt = new NetworkPacket;
 	pkt->type = MEM_MSG;
-	*((mem_req*)(pkt->data)) = mreq;
+	pkt->set_data(mreq);
 
 	const int RID = 123; //request ID
 	pkt->src = m_senderp->get_nid();
@@ -894,7 +894,7 @@ cout<<" req " << i << ": CRB= " << req_crbs[i].ch << "-" << req_crbs[i].rank <<
 
 	    pkts[i] = new NetworkPacket;
 	    pkts[i]->type = MEM_MSG;
-	    *((mem_req*)(pkts[i]->data)) = *(reqs[i]);
+	    pkts[i]->set_data(*(reqs[i]));
 
 	    pkts[i]->src = m_senderp->get_nid();
 	    pkts[i]->src_port = i;
@@ -1061,7 +1061,7 @@ for(int i=0; i<Nreqs; i++)
 
 	    pkts[i] = new NetworkPacket;
 	    pkts[i]->type = MEM_MSG;
-	    *((mem_req*)(pkts[i]->data)) = *(reqs[i]);
+	    pkts[i]->set_data(*(reqs[i]));
 
 	    pkts[i]->src = m_senderp->get_nid();
 	    pkts[i]->src_port = i;
@@ -1221,7 +1221,7 @@ for(int i=0; i<Nreqs; i++)
 
 	    pkts[i] = new NetworkPacket;
 	    pkts[i]->type = MEM_MSG;
-	    *((mem_req*)(pkts[i]->data)) = *(reqs[i]);
+	    pkts[i]->set_data(*(reqs[i]));
 
 	    //pkts[i]->src = m_senderp->get_nid(); //m_senderp not created yet.
 	    pkts[i]->src_port = i;
@@ -1395,7 +1395,7 @@ for(int i=0; i<Nreqs; i++)
 
 	    pkts[i] = new NetworkPacket;
 	    pkts[i]->type = MEM_MSG;
-	    *((mem_req*)(pkts[i]->data)) = *(reqs[i]);
+	    pkts[i]->set_data(*(reqs[i]));
 
 	    //pkts[i]->src = m_senderp->get_nid(); //m_senderp not created yet.
 	    pkts[i]->src_port = i;
@@ -1569,7 +1569,7 @@ for(int i=0; i<Nreqs; i++)
 
 	    pkts[i] = new NetworkPacket;
 	    pkts[i]->type = MEM_MSG;
-	    *((mem_req*)(pkts[i]->data)) = *(reqs[i]);
+	    pkts[i]->set_data(*(reqs[i]));
 
 	    //pkts[i]->src = m_senderp->get_nid(); //m_senderp not created yet.
 	    pkts[i]->src_port = i;
@@ -604,6 +604,79 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! @brief Test issueRequest(): read, row hit, data bus free.
+    //!
+    //! Create a Bank whose open row is the row of the request; call issueRequest()
+    //! with a data bus that is already free. Verify the data starts t_CMD + t_CAS
+    //! after the issue time, and the bank is available when the data starts.
+    void test_issueRequest_0()
+    {
+	Dsettings setting;
+
+	Bank* myBank = new Bank(&setting);
+	myBank->firstAccess = false;
+
+	unsigned long addr = random();
+	unsigned long currentSimTime = random(); //current simulation time
+	myBank->bankAvailableAtTime = currentSimTime / 2;
+
+	Dreq dreq(addr, currentSimTime, &setting);
+	myBank->lastAccessedRow = dreq.rowId;
+
+	CPPUNIT_ASSERT_EQUAL(true, myBank->is_rowHit(dreq.rowId));
+
+	unsigned long rv = myBank->issueRequest(&dreq, true, currentSimTime, 0);
+
+	unsigned long dataT = currentSimTime + setting.t_CMD + setting.t_CAS;
+	CPPUNIT_ASSERT_EQUAL(dataT + setting.t_BURST, rv);
+	CPPUNIT_ASSERT_EQUAL(dataT + setting.t_BURST, dreq.endTime);
+	CPPUNIT_ASSERT_EQUAL(dataT, myBank->bankAvailableAtTime);
+	CPPUNIT_ASSERT_EQUAL(dreq.rowId, myBank->lastAccessedRow);
+
+	delete myBank;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test issueRequest(): write, row miss, data bus busy.
+    //!
+    //! Create a Bank with a different open row; call issueRequest() for a write
+    //! while the data bus is busy until well after the row is opened. Verify the
+    //! data waits for the bus, and the bank waits for the write recovery.
+    void test_issueRequest_1()
+    {
+	Dsettings setting;
+
+	Bank* myBank = new Bank(&setting);
+	myBank->firstAccess = false;
+
+	unsigned long addr = random();
+	unsigned long currentSimTime = random(); //current simulation time
+	myBank->bankAvailableAtTime = currentSimTime;
+
+	Dreq dreq(addr, currentSimTime, &setting);
+	myBank->lastAccessedRow = dreq.rowId + 1;
+
+	CPPUNIT_ASSERT_EQUAL(false, myBank->is_rowHit(dreq.rowId));
+
+	unsigned long busAvailableAtTime = currentSimTime + 1000 + random() % 1000;
+	unsigned long rv = myBank->issueRequest(&dreq, false, currentSimTime, busAvailableAtTime);
+
+	CPPUNIT_ASSERT_EQUAL(busAvailableAtTime + setting.t_BURST, rv);
+	CPPUNIT_ASSERT_EQUAL(busAvailableAtTime + setting.t_BURST, dreq.endTime);
+	CPPUNIT_ASSERT_EQUAL(rv + setting.t_WR, myBank->bankAvailableAtTime);
+	CPPUNIT_ASSERT_EQUAL(true, myBank->is_rowHit(dreq.rowId));
+
+	delete myBank;
+    }
+
+
+
+
     //! Build a test suite.
     static CppUnit::Test* suite()
     {
@@ -621,6 +694,8 @@ public:
 	mySuite->addTest(new CppUnit::TestCaller<BankTest>("test_processRequest_3", &BankTest::test_processRequest_3));
 	mySuite->addTest(new CppUnit::TestCaller<BankTest>("test_processRequest_4", &BankTest::test_processRequest_4));
 	mySuite->addTest(new CppUnit::TestCaller<BankTest>("test_processRequest_5", &BankTest::test_processRequest_5));
+	mySuite->addTest(new CppUnit::TestCaller<BankTest>("test_issueRequest_0", &BankTest::test_issueRequest_0));
+	mySuite->addTest(new CppUnit::TestCaller<BankTest>("test_issueRequest_1", &BankTest::test_issueRequest_1));
 /*
 	*/
 
@@ -7,11 +7,15 @@
 
 #include <iostream>
 #include <list>
+#include <set>
 #include <stdlib.h>
 #include "Controller.h"
+#include "kernel/clock.h"
 
 using namespace std;
 
+using namespace manifold::kernel;
+using namespace manifold::uarch;
 using namespace manifold::caffdram;
 
 //####################################################################
@@ -21,6 +25,31 @@ using namespace manifold::caffdram;
 #define MEM_MSG 123
 #define CREDIT_MSG 456
 
+Clock TheClock(1000);
+
+//! Packets of the requests in the bank queues of channel ch.
+static set<NetworkPacket*> queued_pkts(Controller* mc, int ch)
+{
+    set<NetworkPacket*> pkts;
+    Controller::Channel_queue& q = mc->m_queues[ch];
+    for(unsigned b=0; b<q.bankQ.size(); b++)
+	for(unsigned i=0; i<q.bankQ[b].size(); i++)
+	    pkts.insert(q.bankQ[b][i].pkt);
+    return pkts;
+}
+
+//! Call scheduleChannel() and return the packet of the request it issued, or 0.
+static NetworkPacket* schedule(Controller* mc, int ch, unsigned long now)
+{
+    set<NetworkPacket*> before = queued_pkts(mc, ch);
+    mc->scheduleChannel(ch, now);
+    set<NetworkPacket*> after = queued_pkts(mc, ch);
+    for(set<NetworkPacket*>::iterator it = before.begin(); it != before.end(); ++it)
+	if(after.find(*it) == after.end())
+	    return *it;
+    return 0;
+}
+
 //####################################################################
 //! Class ControllerTest is the test class for class Controller. 
 //####################################################################
@@ -58,7 +87,7 @@ public:
 	if(random() / (RAND_MAX + 1.0) < 0.5)
 	    st_resp = true;
 
-	Controller* myController = new Controller(nid, setting, st_resp);
+	Controller* myController = new Controller(&TheClock, nid, setting, 1, st_resp);
 
 
 	CPPUNIT_ASSERT_EQUAL(nid, myController->get_nid());
@@ -105,7 +134,7 @@ public:
 	if(random() / (RAND_MAX + 1.0) < 0.5)
 	    st_resp = true;
 
-	Controller* myController = new Controller(nid, setting, st_resp);
+	Controller* myController = new Controller(&TheClock, nid, setting, 1, st_resp);
 	setting = *(myController->dramSetting);
 
 	const int Nreqs = 10000;
@@ -167,7 +196,7 @@ public:
 	if(random() / (RAND_MAX + 1.0) < 0.5)
 	    st_resp = true;
 
-	Controller* myController = new Controller(nid, setting, st_resp);
+	Controller* myController = new Controller(&TheClock, nid, setting, 1, st_resp);
 	setting = *(myController->dramSetting);
 
 	const int Nreqs = 10000;
@@ -208,6 +237,268 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! Settings of the FR_FCFS tests: 1 channel, 1 rank, 4 banks, and addresses
+    //! decoded as row:bank:column:offset.
+    static Dsettings fr_fcfs_settings()
+    {
+	Dsettings setting;
+	setting.numChannels = 1;
+	setting.numRanks = 1;
+	setting.numBanks = 4;
+	setting.addressMapping = "RoBaRaCoCh";
+	setting.memSchedPolicy = FR_FCFS;
+	return setting;
+    }
+
+    static unsigned long fr_fcfs_addr(Controller* mc, int bank, int row)
+    {
+	return ((unsigned long)row << mc->dramSetting->mapShift[Dsettings::MAP_ROW]) |
+	       ((unsigned long)bank << mc->dramSetting->mapShift[Dsettings::MAP_BANK]);
+    }
+
+    //! Time between two calls of scheduleChannel(); long enough for every bank and
+    //! the data bus to be available again.
+    static const unsigned long GAP = 100000;
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test scheduleChannel(): row hits first.
+    //!
+    //! Open row 1 of bank 0. Queue a read to row 2 of bank 0, a read to row 3 of
+    //! bank 1, then a read to row 1 of bank 0. The younger row hit is issued first,
+    //! then the other two in arrival order.
+    void test_scheduleChannel_0()
+    {
+	Dsettings setting = fr_fcfs_settings();
+	Controller* mc = new Controller(&TheClock, 0, setting, 1);
+	unsigned long now = GAP;
+
+	NetworkPacket* open = new NetworkPacket;
+	mc->enqueueRequest(open, fr_fcfs_addr(mc, 0, 1), true);
+	CPPUNIT_ASSERT(open == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, mc->stats_row_misses);
+
+	NetworkPacket* miss0 = new NetworkPacket;
+	NetworkPacket* miss1 = new NetworkPacket;
+	NetworkPacket* hit = new NetworkPacket;
+	mc->enqueueRequest(miss0, fr_fcfs_addr(mc, 0, 2), true);
+	mc->enqueueRequest(miss1, fr_fcfs_addr(mc, 1, 3), true);
+	mc->enqueueRequest(hit, fr_fcfs_addr(mc, 0, 1), true);
+	CPPUNIT_ASSERT_EQUAL(3, mc->m_queues[0].numReads);
+
+	now += GAP;
+	CPPUNIT_ASSERT(hit == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, mc->stats_row_hits);
+	now += GAP;
+	CPPUNIT_ASSERT(miss0 == schedule(mc, 0, now));
+	now += GAP;
+	CPPUNIT_ASSERT(miss1 == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL((uint64_t)3, mc->stats_row_misses);
+
+	CPPUNIT_ASSERT_EQUAL(0, mc->m_queues[0].numReads);
+	now += GAP;
+	CPPUNIT_ASSERT(0 == schedule(mc, 0, now));
+
+	delete mc;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test scheduleChannel(): the starvation cap.
+    //!
+    //! Open row 1 of bank 0. Queue a read to row 2, then 4 reads to row 1. With
+    //! rowHitCap = 2, two row hits go first, then the read to row 2, then the last
+    //! two reads to row 1.
+    void test_scheduleChannel_1()
+    {
+	Dsettings setting = fr_fcfs_settings();
+	setting.rowHitCap = 2;
+	Controller* mc = new Controller(&TheClock, 0, setting, 1);
+	unsigned long now = GAP;
+
+	mc->enqueueRequest(new NetworkPacket, fr_fcfs_addr(mc, 0, 1), true);
+	schedule(mc, 0, now);
+
+	NetworkPacket* old = new NetworkPacket;
+	mc->enqueueRequest(old, fr_fcfs_addr(mc, 0, 2), true);
+	NetworkPacket* hits[4];
+	for(int i=0; i<4; i++) {
+	    hits[i] = new NetworkPacket;
+	    mc->enqueueRequest(hits[i], fr_fcfs_addr(mc, 0, 1), true);
+	}
+
+	now += GAP;
+	CPPUNIT_ASSERT(hits[0] == schedule(mc, 0, now));
+	now += GAP;
+	CPPUNIT_ASSERT(hits[1] == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL(2, mc->m_queues[0].bypassed[0]);
+	now += GAP;
+	CPPUNIT_ASSERT(old == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL(0, mc->m_queues[0].bypassed[0]);
+	now += GAP;
+	CPPUNIT_ASSERT(hits[2] == schedule(mc, 0, now));
+	now += GAP;
+	CPPUNIT_ASSERT(hits[3] == schedule(mc, 0, now));
+
+	CPPUNIT_ASSERT_EQUAL((uint64_t)3, mc->stats_row_hits); //hits[3] follows hits[2] to row 1
+	CPPUNIT_ASSERT_EQUAL((uint64_t)3, mc->stats_row_misses);
+
+	delete mc;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test scheduleChannel(): no starvation cap.
+    //!
+    //! Same as test_scheduleChannel_1, but with rowHitCap = 0 all the row hits are
+    //! issued before the read to row 2.
+    void test_scheduleChannel_2()
+    {
+	Dsettings setting = fr_fcfs_settings();
+	setting.rowHitCap = 0;
+	Controller* mc = new Controller(&TheClock, 0, setting, 1);
+	unsigned long now = GAP;
+
+	mc->enqueueRequest(new NetworkPacket, fr_fcfs_addr(mc, 0, 1), true);
+	schedule(mc, 0, now);
+
+	NetworkPacket* old = new NetworkPacket;
+	mc->enqueueRequest(old, fr_fcfs_addr(mc, 0, 2), true);
+	NetworkPacket* hits[4];
+	for(int i=0; i<4; i++) {
+	    hits[i] = new NetworkPacket;
+	    mc->enqueueRequest(hits[i], fr_fcfs_addr(mc, 0, 1), true);
+	}
+
+	for(int i=0; i<4; i++) {
+	    now += GAP;
+	    CPPUNIT_ASSERT(hits[i] == schedule(mc, 0, now));
+	}
+	now += GAP;
+	CPPUNIT_ASSERT(old == schedule(mc, 0, now));
+
+	CPPUNIT_ASSERT_EQUAL((uint64_t)4, mc->stats_row_hits);
+
+	delete mc;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test scheduleChannel(): write drain.
+    //!
+    //! With watermarks 3 / 1, queue a read and 2 writes: the read is issued. Queue
+    //! 3 more writes: the scheduler drains writes down to 1 and then serves the
+    //! new read, and drains the last write when no read is left.
+    void test_scheduleChannel_3()
+    {
+	Dsettings setting = fr_fcfs_settings();
+	setting.writeQueueSize = 4;
+	setting.writeHighWatermark = 3;
+	setting.writeLowWatermark = 1;
+	Controller* mc = new Controller(&TheClock, 0, setting, 1);
+	Controller::Channel_queue& q = mc->m_queues[0];
+	unsigned long now = GAP;
+
+	NetworkPacket* rd0 = new NetworkPacket;
+	mc->enqueueRequest(rd0, fr_fcfs_addr(mc, 0, 1), true);
+	mc->enqueueRequest(new NetworkPacket, fr_fcfs_addr(mc, 1, 1), false);
+	mc->enqueueRequest(new NetworkPacket, fr_fcfs_addr(mc, 2, 1), false);
+
+	//2 writes: below the high watermark
+	CPPUNIT_ASSERT(rd0 == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL(false, q.drainingWrites);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)0, mc->stats_write_drains);
+
+	NetworkPacket* rd1 = new NetworkPacket;
+	mc->enqueueRequest(rd1, fr_fcfs_addr(mc, 0, 2), true);
+	mc->enqueueRequest(new NetworkPacket, fr_fcfs_addr(mc, 3, 1), false);
+	CPPUNIT_ASSERT_EQUAL(3, q.numWrites);
+
+	//3 writes: drain down to 1
+	now += GAP;
+	CPPUNIT_ASSERT(schedule(mc, 0, now) != rd1);
+	CPPUNIT_ASSERT_EQUAL(true, q.drainingWrites);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, mc->stats_write_drains);
+	CPPUNIT_ASSERT_EQUAL(2, q.numWrites);
+	now += GAP;
+	CPPUNIT_ASSERT(schedule(mc, 0, now) != rd1);
+	CPPUNIT_ASSERT_EQUAL(1, q.numWrites);
+
+	//at the low watermark with a read pending: back to reads
+	now += GAP;
+	CPPUNIT_ASSERT(rd1 == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL(false, q.drainingWrites);
+	CPPUNIT_ASSERT_EQUAL(1, q.numWrites);
+
+	//no reads: the last write is drained
+	now += GAP;
+	CPPUNIT_ASSERT(schedule(mc, 0, now) != 0);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)2, mc->stats_write_drains);
+	CPPUNIT_ASSERT_EQUAL(0, q.numWrites);
+
+	delete mc;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test enqueueRequest() and scheduleChannel(): the wait queue.
+    //!
+    //! With room for 2 reads, a third read waits, and so does a write that arrives
+    //! after it although there is room for writes. When a read is issued, both
+    //! move into the bank queues in arrival order.
+    void test_scheduleChannel_4()
+    {
+	Dsettings setting = fr_fcfs_settings();
+	setting.readQueueSize = 2;
+	Controller* mc = new Controller(&TheClock, 0, setting, 1);
+	Controller::Channel_queue& q = mc->m_queues[0];
+	unsigned long now = GAP;
+
+	NetworkPacket* rd[3];
+	for(int i=0; i<3; i++) {
+	    rd[i] = new NetworkPacket;
+	    mc->enqueueRequest(rd[i], fr_fcfs_addr(mc, i, 1), true);
+	}
+	NetworkPacket* wr = new NetworkPacket;
+	mc->enqueueRequest(wr, fr_fcfs_addr(mc, 3, 1), false);
+
+	CPPUNIT_ASSERT_EQUAL(2, q.numReads);
+	CPPUNIT_ASSERT_EQUAL(0, q.numWrites);
+	CPPUNIT_ASSERT_EQUAL(2, (int)q.waitQ.size());
+	CPPUNIT_ASSERT(rd[2] == q.waitQ.front().pkt);
+	CPPUNIT_ASSERT(wr == q.waitQ[1].pkt);
+
+	CPPUNIT_ASSERT(rd[0] == schedule(mc, 0, now));
+	CPPUNIT_ASSERT_EQUAL(0, (int)q.waitQ.size());
+	CPPUNIT_ASSERT_EQUAL(2, q.numReads);
+	CPPUNIT_ASSERT_EQUAL(1, q.numWrites);
+	set<NetworkPacket*> pkts = queued_pkts(mc, 0);
+	CPPUNIT_ASSERT(pkts.find(rd[2]) != pkts.end());
+	CPPUNIT_ASSERT(pkts.find(wr) != pkts.end());
+
+	now += GAP;
+	CPPUNIT_ASSERT(rd[1] == schedule(mc, 0, now));
+	now += GAP;
+	CPPUNIT_ASSERT(rd[2] == schedule(mc, 0, now));
+	now += GAP;
+	CPPUNIT_ASSERT(wr == schedule(mc, 0, now));
+
+	delete mc;
+    }
+
+
+
 
     //! Build a test suite.
     static CppUnit::Test* suite()
@@ -217,6 +508,11 @@ public:
 	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_Constructor_0", &ControllerTest::test_Constructor_0));
 	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_processRequest_0", &ControllerTest::test_processRequest_0));
 	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_processRequest_1", &ControllerTest::test_processRequest_1));
+	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_scheduleChannel_0", &ControllerTest::test_scheduleChannel_0));
+	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_scheduleChannel_1", &ControllerTest::test_scheduleChannel_1));
+	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_scheduleChannel_2", &ControllerTest::test_scheduleChannel_2));
+	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_scheduleChannel_3", &ControllerTest::test_scheduleChannel_3));
+	mySuite->addTest(new CppUnit::TestCaller<ControllerTest>("test_scheduleChannel_4", &ControllerTest::test_scheduleChannel_4));
 
 	return mySuite;
     }
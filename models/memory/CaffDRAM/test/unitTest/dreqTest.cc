@@ -136,6 +136,84 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! @brief Test generateId with an address mapping.
+    //!
+    //! Use the mapping RoBaRaCoCh; build addresses from random fields and verify
+    //! the fields are decoded; then enable bankXor and verify the bank is XORed
+    //! with the low bits of the row.
+    void test_generateId_mapping()
+    {
+	Dsettings setting; //2 channels, 4 ranks, 8 banks, 4096 rows, 128 lines per row
+	setting.addressMapping = "RoBaRaCoCh";
+	setting.update();
+
+	CPPUNIT_ASSERT_EQUAL(6u, setting.mapShift[Dsettings::MAP_CH]);
+	CPPUNIT_ASSERT_EQUAL(7u, setting.mapShift[Dsettings::MAP_COL]);
+	CPPUNIT_ASSERT_EQUAL(14u, setting.mapShift[Dsettings::MAP_RANK]);
+	CPPUNIT_ASSERT_EQUAL(16u, setting.mapShift[Dsettings::MAP_BANK]);
+	CPPUNIT_ASSERT_EQUAL(19u, setting.mapShift[Dsettings::MAP_ROW]);
+
+	for(int i=0; i<1000; i++) {
+	    unsigned ch = random() % 2;
+	    unsigned rank = random() % 4;
+	    unsigned bank = random() % 8;
+	    unsigned row = random() % 4096;
+	    unsigned long addr = ((unsigned long)row << 19) | (bank << 16) | (rank << 14) | ((random() % 128) << 7) | (ch << 6) | (random() % 64);
+
+	    setting.bankXor = false;
+	    Dreq r(addr, 0, &setting);
+	    CPPUNIT_ASSERT_EQUAL(ch, r.chId);
+	    CPPUNIT_ASSERT_EQUAL(rank, r.rankId);
+	    CPPUNIT_ASSERT_EQUAL(bank, r.bankId);
+	    CPPUNIT_ASSERT_EQUAL(row, r.rowId);
+
+	    setting.bankXor = true;
+	    Dreq rx(addr, 0, &setting);
+	    CPPUNIT_ASSERT_EQUAL(bank ^ (row & 0x7), rx.bankId);
+	    CPPUNIT_ASSERT_EQUAL(row, rx.rowId);
+	}
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test generateId with an address mapping and multiple MCs.
+    //!
+    //! The MC select bits are removed before the address is decoded: inserting
+    //! them into an address gives the same fields as with a single MC.
+    void test_generateId_mapping_mcs()
+    {
+	Dsettings setting1;
+	setting1.addressMapping = "RoBaRaCoCh";
+	setting1.update();
+
+	Dsettings setting;
+	setting.addressMapping = "RoBaRaCoCh";
+	setting.numMcs = 4;
+	setting.mcInterleaveShift = 12;
+	setting.update();
+
+	for(int i=0; i<1000; i++) {
+	    unsigned long addr = random();
+	    unsigned long mc = random() % 4;
+	    //insert 2 MC bits at bit 12
+	    unsigned long addr_mc = ((addr >> 12) << 14) | (mc << 12) | (addr & 0xfff);
+
+	    Dreq r(addr, 0, &setting1);
+	    Dreq r_mc(addr_mc, 0, &setting);
+	    CPPUNIT_ASSERT_EQUAL(r.chId, r_mc.chId);
+	    CPPUNIT_ASSERT_EQUAL(r.rankId, r_mc.rankId);
+	    CPPUNIT_ASSERT_EQUAL(r.bankId, r_mc.bankId);
+	    CPPUNIT_ASSERT_EQUAL(r.rowId, r_mc.rowId);
+	}
+    }
+
+
+
+
     //! Build a test suite.
     static CppUnit::Test* suite()
     {
@@ -144,6 +222,8 @@ public:
 	mySuite->addTest(new CppUnit::TestCaller<DreqTest>("test_Constructor_0", &DreqTest::test_Constructor_0));
 	mySuite->addTest(new CppUnit::TestCaller<DreqTest>("test_generateId_0", &DreqTest::test_generateId_0));
 	mySuite->addTest(new CppUnit::TestCaller<DreqTest>("test_generateId_1", &DreqTest::test_generateId_1));
+	mySuite->addTest(new CppUnit::TestCaller<DreqTest>("test_generateId_mapping", &DreqTest::test_generateId_mapping));
+	mySuite->addTest(new CppUnit::TestCaller<DreqTest>("test_generateId_mapping_mcs", &DreqTest::test_generateId_mapping_mcs));
 
 	return mySuite;
     }
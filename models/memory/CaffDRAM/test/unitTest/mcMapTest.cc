@@ -182,6 +182,43 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! @brief Test lookup() with cache line interleave and mcXor.
+    //!
+    //! Without mcXor, addresses whose stride is the number of MCs times the line
+    //! size all go to the same MC; with mcXor they are spread evenly.
+    void test_lookup_xor()
+    {
+	Dsettings setting;
+	setting.numMcs = 4;
+	setting.mcInterleaveShift = 6; //64-byte lines
+
+	vector<int> nodes(4);
+	for(unsigned j=0; j<nodes.size(); j++)
+	    nodes[j] = j;
+
+	CaffDramMcMap* myMap = new CaffDramMcMap(nodes, setting);
+	setting.mcXor = true;
+	CaffDramMcMap* xorMap = new CaffDramMcMap(nodes, setting);
+
+	const int N = 64;
+	int count[4] = {0, 0, 0, 0};
+	for(int i=0; i<N; i++) {
+	    unsigned long addr = (unsigned long)i * (4 << 6);
+	    CPPUNIT_ASSERT_EQUAL(0, myMap->lookup(addr));
+	    count[xorMap->lookup(addr)]++;
+	}
+	for(int j=0; j<4; j++)
+	    CPPUNIT_ASSERT_EQUAL(N/4, count[j]);
+
+	delete myMap;
+	delete xorMap;
+    }
+
+
+
+
     //! Build a test suite.
     static CppUnit::Test* suite()
     {
@@ -191,6 +228,7 @@ public:
 	mySuite->addTest(new CppUnit::TestCaller<CaffDramMcMapTest>("test_Constructor_1", &CaffDramMcMapTest::test_Constructor_1));
 	mySuite->addTest(new CppUnit::TestCaller<CaffDramMcMapTest>("test_lookup_0", &CaffDramMcMapTest::test_lookup_0));
 	mySuite->addTest(new CppUnit::TestCaller<CaffDramMcMapTest>("test_lookup_1", &CaffDramMcMapTest::test_lookup_1));
+	mySuite->addTest(new CppUnit::TestCaller<CaffDramMcMapTest>("test_lookup_xor", &CaffDramMcMapTest::test_lookup_xor));
 
 	return mySuite;
     }
@@ -142,6 +142,104 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! @brief Test refresh(): all-bank refresh.
+    //!
+    //! Create a Rank with all-bank refresh; open a row in one bank, then call
+    //! refresh() at the first refresh time. Verify all banks are unavailable
+    //! until t_RP + t_RFC after the refresh time and no row is open.
+    void test_refresh_0()
+    {
+	Dsettings setting;
+	setting.memRefreshPolicy = ALL_BANK_REFRESH;
+	setting.numBanks = 0x1 << (random() % 4 + 1);  //2, 4, 8 or 16 Banks
+
+	Rank* myRank = new Rank(&setting);
+
+	Dreq dreq(random() % 1000, 0, &setting);
+	myRank->processRequest(&dreq);
+	CPPUNIT_ASSERT_EQUAL(true, myRank->myBank[dreq.bankId]->is_rowOpen());
+
+	myRank->refresh(setting.t_REF_INT);
+
+	unsigned long endT = setting.t_REF_INT + setting.t_RP + setting.t_RFC;
+	for(int b=0; b<setting.numBanks; b++) {
+	    CPPUNIT_ASSERT_EQUAL(endT, myRank->myBank[b]->get_availableTime());
+	    CPPUNIT_ASSERT_EQUAL(false, myRank->myBank[b]->is_rowOpen());
+	    CPPUNIT_ASSERT_EQUAL((uint64_t)1, myRank->myBank[b]->get_counters().refreshes);
+	}
+	CPPUNIT_ASSERT_EQUAL(2*setting.t_REF_INT, myRank->nextRefreshTime);
+
+	delete myRank;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test processRequest(): t_FAW.
+    //!
+    //! Create a Rank with t_FAW set; send 5 requests to 5 different banks at the
+    //! same time. Verify the 5th activate is issued t_FAW after the 1st.
+    void test_processRequest_faw()
+    {
+	Dsettings setting;
+	setting.numBanks = 8;
+	setting.t_RRD = 5;
+	setting.t_FAW = 100;
+
+	Rank* myRank = new Rank(&setting);
+
+	unsigned long currentSimTime = random() % 100000;
+	unsigned long actTimes[5];
+	for(int i=0; i<5; i++) {
+	    Dreq dreq(0, currentSimTime, &setting);
+	    dreq.bankId = i;
+	    myRank->processRequest(&dreq);
+	    CPPUNIT_ASSERT_EQUAL(true, dreq.is_activated());
+	    actTimes[i] = dreq.get_actTime();
+	}
+	for(int i=1; i<4; i++)
+	    CPPUNIT_ASSERT_EQUAL(actTimes[i-1] + setting.t_RRD, actTimes[i]);
+	CPPUNIT_ASSERT_EQUAL(actTimes[0] + setting.t_FAW, actTimes[4]);
+
+	delete myRank;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test processRequest(): power-down.
+    //!
+    //! Create a Rank with power-down enabled; send a request after the rank has
+    //! been idle for longer than powerDownIdleTime. Verify the request is delayed
+    //! by t_XP and the power-down cycles are counted.
+    void test_processRequest_powerDown()
+    {
+	Dsettings setting;
+	setting.powerDownIdleTime = 50;
+
+	Rank* myRank = new Rank(&setting);
+
+	Dreq dreq0(0, 0, &setting);
+	myRank->processRequest(&dreq0);
+
+	unsigned long idle = 1000 + random() % 1000;
+	Dreq dreq1(0, dreq0.get_endTime() + idle, &setting); //same row
+	unsigned long rv = myRank->processRequest(&dreq1);
+
+	CPPUNIT_ASSERT_EQUAL(dreq1.get_originTime() + setting.t_XP + setting.t_CAS + setting.t_BURST, rv);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)(idle + setting.t_CMD - setting.powerDownIdleTime), myRank->get_activePowerDownCycles());
+	CPPUNIT_ASSERT_EQUAL((uint64_t)0, myRank->get_prechargePowerDownCycles());
+
+	delete myRank;
+    }
+
+
+
+
     //! Build a test suite.
     static CppUnit::Test* suite()
     {
@@ -150,6 +248,9 @@ public:
 	mySuite->addTest(new CppUnit::TestCaller<RankTest>("test_Constructor_0", &RankTest::test_Constructor_0));
 	mySuite->addTest(new CppUnit::TestCaller<RankTest>("test_processRequest_0", &RankTest::test_processRequest_0));
 	mySuite->addTest(new CppUnit::TestCaller<RankTest>("test_processRequest_1", &RankTest::test_processRequest_1));
+	mySuite->addTest(new CppUnit::TestCaller<RankTest>("test_refresh_0", &RankTest::test_refresh_0));
+	mySuite->addTest(new CppUnit::TestCaller<RankTest>("test_processRequest_faw", &RankTest::test_processRequest_faw));
+	mySuite->addTest(new CppUnit::TestCaller<RankTest>("test_processRequest_powerDown", &RankTest::test_processRequest_powerDown));
 
 	return mySuite;
     }
@@ -0,0 +1,141 @@
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <iostream>
+#include <deque>
+#include <stdlib.h>
+#include "RingBuffer.h"
+
+using namespace std;
+
+using namespace manifold::caffdram;
+
+
+//####################################################################
+//! Class RingBufferTest is the test class for class RingBuffer.
+//####################################################################
+class RingBufferTest : public CppUnit::TestFixture {
+private:
+
+public:
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test the constructor and reserve().
+    //!
+    //! Create a RingBuffer with a random capacity; verify the capacity is the
+    //! smallest power of 2 not less than the requested one, and the buffer is empty.
+    //! Then reserve a random capacity and verify it the same way.
+    void test_constructor_0()
+    {
+	const unsigned CAP = random() % 1000 + 1;
+
+	RingBuffer<int> rb(CAP);
+
+	unsigned expected = 1;
+	while(expected < CAP)
+	    expected *= 2;
+	CPPUNIT_ASSERT_EQUAL(expected, rb.capacity());
+	CPPUNIT_ASSERT_EQUAL(0U, rb.size());
+	CPPUNIT_ASSERT_EQUAL(true, rb.empty());
+
+	const unsigned CAP2 = random() % 1000 + 1;
+	rb.reserve(CAP2);
+	expected = 1;
+	while(expected < CAP2)
+	    expected *= 2;
+	CPPUNIT_ASSERT_EQUAL(expected, rb.capacity());
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test push_back(), pop_front(), erase() and operator[].
+    //!
+    //! Create a small RingBuffer; randomly push, pop and erase at a random position
+    //! N times, with the occupancy wrapping around and growing past the capacity;
+    //! verify the contents are always the same as those of a deque.
+    void test_push_pop_erase_0()
+    {
+	RingBuffer<int> rb(4);
+	deque<int> dq;
+
+	const int N = 100000;
+	for(int i=0; i<N; i++) {
+	    int op = random() % 100;
+	    if(dq.empty() || op < 52) {
+		int x = random();
+		rb.push_back(x);
+		dq.push_back(x);
+	    }
+	    else if(op < 76) {
+		CPPUNIT_ASSERT_EQUAL(dq.front(), rb.front());
+		rb.pop_front();
+		dq.pop_front();
+	    }
+	    else {
+		unsigned idx = random() % dq.size();
+		rb.erase(idx);
+		dq.erase(dq.begin() + idx);
+	    }
+	    CPPUNIT_ASSERT_EQUAL((unsigned)dq.size(), rb.size());
+	    CPPUNIT_ASSERT(rb.size() <= rb.capacity());
+	    for(unsigned j=0; j<dq.size(); j++)
+		CPPUNIT_ASSERT_EQUAL(dq[j], rb[j]);
+	}
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test the capacity doesn't grow when the occupancy is bounded.
+    //!
+    //! Create a RingBuffer of capacity C; push, pop and erase N times while keeping
+    //! at most C elements; verify the capacity is unchanged.
+    void test_push_pop_erase_1()
+    {
+	const unsigned C = 8;
+	RingBuffer<int> rb(C);
+
+	const int N = 10000;
+	for(int i=0; i<N; i++) {
+	    if(rb.size() < C && (rb.empty() || random() % 2 == 0))
+		rb.push_back(i);
+	    else if(random() % 2 == 0)
+		rb.pop_front();
+	    else
+		rb.erase(random() % rb.size());
+	}
+	CPPUNIT_ASSERT_EQUAL(C, rb.capacity());
+    }
+
+
+
+
+    //! Build a test suite.
+    static CppUnit::Test* suite()
+    {
+	CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("RingBufferTest");
+
+	mySuite->addTest(new CppUnit::TestCaller<RingBufferTest>("test_constructor_0", &RingBufferTest::test_constructor_0));
+	mySuite->addTest(new CppUnit::TestCaller<RingBufferTest>("test_push_pop_erase_0", &RingBufferTest::test_push_pop_erase_0));
+	mySuite->addTest(new CppUnit::TestCaller<RingBufferTest>("test_push_pop_erase_1", &RingBufferTest::test_push_pop_erase_1));
+	return mySuite;
+    }
+};
+
+
+int main()
+{
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( RingBufferTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+
+}
@@ -36,6 +36,9 @@ if [ $? -ne 0 ]; then FAIL=1; fi
 eval ./mcMapTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
+eval ./ringBufferTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 
 exit $FAIL
 
@@ -11,9 +11,55 @@ namespace manifold {
 namespace simple_mc {
 
 
+SimpleMC :: SimpleMC(int nid, Ticks_t latency, bool st_resp) :
+    m_nid(nid), m_latency(latency), m_send_st_response(st_resp)
+{
+    init();
+}
+
+
+SimpleMC :: SimpleMC(int nid, Ticks_t latency, const SimpleMC_settings& settings, bool st_resp) :
+    m_nid(nid), m_latency(latency), m_send_st_response(st_resp), m_settings(settings)
+{
+    init();
+}
+
+
+void SimpleMC :: init()
+{
+    m_row_hits = 0;
+    m_row_misses = 0;
+    m_bank_delays.resize(DELAY_BINS, 0);
+    m_channel_delays.resize(DELAY_BINS, 0);
+    m_total_bank_delay = 0;
+    m_total_channel_delay = 0;
+
+    if(m_settings.num_banks == 0)
+        return;
+
+    assert(m_settings.num_channels > 0 && m_settings.num_banks > 0);
+    assert(m_settings.burst_lines > 0);
+
+    m_offset_bits = 0;
+    while((0x1 << m_offset_bits) < m_settings.line_size)
+	m_offset_bits++;
+    assert((0x1 << m_offset_bits) == m_settings.line_size); //line_size must be a power of 2
+
+    assert(m_settings.row_size >= m_settings.line_size && m_settings.row_size % m_settings.line_size == 0);
+    m_lines_per_row = m_settings.row_size / m_settings.line_size;
+
+    m_banks.resize(m_settings.num_channels * m_settings.num_banks);
+    m_token_time.resize(m_settings.num_channels, 0);
+}
+
+
 //! Event handler for incoming memory request.
-void SimpleMC :: handle_incoming(int, mem_req* req)
+void SimpleMC :: handle_incoming(int, Mem_req* req)
 {
+    Ticks_t latency = m_latency;
+    if(m_settings.num_banks > 0)
+	latency += queue_request(req->addr, Manifold::NowTicks());
+
     if(req->op_type == OpMemLd) {
 #ifdef DBG_SIMPLE_MC
 cout << "mc received LD, src= " << req->source_id << " port= " <<req->source_port << " addr= " <<hex<< req->addr <<dec<<endl;
@@ -23,13 +69,11 @@ cout << "mc received LD, src= " << req->source_id << " port= " <<req->source_por
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemLd, req->originator_id, req->source_id, req->addr)));
 
-	req->msg = LD_RESPONSE;
-	req->req_id = req->req_id;
 	req->dest_id = req->source_id;
 	req->dest_port = req->source_port;
 	req->source_id = m_nid;
 	req->source_port = 0;
-	SendTick(OUT, req, m_latency);
+	SendTick(OUT, req, latency);
     }
     else {
 #ifdef DBG_SIMPLE_MC
@@ -40,14 +84,88 @@ cout << "mc received ST, src= " << req->source_id << " port= " <<req->source_por
 	m_req_info.insert(pair<Ticks_t, Req_info>(Manifold::NowTicks(),
 	                                          Req_info(OpMemSt, req->originator_id, req->source_id, req->addr)));
         if(m_send_st_response) {
-	    req->msg = ST_COMPLETE;
-	    req->req_id = req->req_id;
 	    req->dest_id = req->source_id;
 	    req->dest_port = req->source_port;
 	    req->source_id = m_nid;
 	    req->source_port = 0;
-	    SendTick(OUT, req, m_latency);
+	    SendTick(OUT, req, latency);
 	}
+	else
+	    delete req;
+    }
+}
+
+
+//! Bank and channel model; see SimpleMC_settings. Requests are served in arrival
+//! order: a bank is taken in the order requests arrive, and so are channel tokens.
+Ticks_t SimpleMC :: queue_request(paddr_t addr, Ticks_t now)
+{
+    uint64_t line = addr >> m_offset_bits;
+    const int channel = line % m_settings.num_channels;
+    line /= m_settings.num_channels;
+    const int bank_idx = line % m_settings.num_banks;
+    line /= m_settings.num_banks;
+    const uint64_t row = line / m_lines_per_row;
+
+    Bank& bank = m_banks[channel * m_settings.num_banks + bank_idx];
+    Ticks_t start = (bank.busy_until > now) ? bank.busy_until : now;
+
+    if(bank.row_open && bank.open_row == row) {
+	m_row_hits++;
+	bank.busy_until = start + m_settings.t_row_hit;
+    }
+    else {
+	m_row_misses++;
+	bank.busy_until = start + m_settings.t_row_miss;
+	bank.open_row = row;
+	bank.row_open = true;
+    }
+
+    Ticks_t done = bank.busy_until;
+    if(m_settings.ticks_per_line > 0) {
+	Ticks_t& token_time = m_token_time[channel];
+	const Ticks_t slack = (m_settings.burst_lines - 1) * m_settings.ticks_per_line;
+	if(token_time > done + slack)
+	    done = token_time - slack;
+	token_time = ((token_time > done) ? token_time : done) + m_settings.ticks_per_line;
+    }
+
+    collect_delay(m_bank_delays, start - now);
+    collect_delay(m_channel_delays, done - bank.busy_until);
+    m_total_bank_delay += start - now;
+    m_total_channel_delay += done - bank.busy_until;
+
+    return done - now;
+}
+
+
+void SimpleMC :: collect_delay(vector<uint64_t>& bins, Ticks_t delay)
+{
+    unsigned bin = 0;
+    while(delay > 0 && bin < DELAY_BINS - 1) {
+	delay >>= 1;
+	bin++;
+    }
+    bins[bin]++;
+}
+
+
+void SimpleMC :: print_delays(ostream& out, const char* name, const vector<uint64_t>& bins, uint64_t total)
+{
+    uint64_t reqs = 0;
+    for(unsigned i=0; i<bins.size(); i++)
+	reqs += bins[i];
+
+    out << "=== " << name << " queueing delay ===" << endl;
+    out << "    average: " << (reqs > 0 ? (double)total / reqs : 0) << endl;
+    for(unsigned i=0; i<bins.size(); i++) {
+	if(bins[i] == 0)
+	    continue;
+	if(i == 0)
+	    out << "    0: ";
+	else
+	    out << "    " << (0x1ULL << (i-1)) << "-" << (0x1ULL << i) - 1 << ": ";
+	out << bins[i] << " (" << 100.0 * bins[i] / reqs << "%)" << endl;
     }
 }
 
@@ -57,6 +175,16 @@ void SimpleMC :: print_config(ostream& out)
     out << "********** SimpleMC " << m_nid << " config **********" << endl;
     out << "    Latency: " << m_latency << endl;
     out << "    Send STORE response: " << (m_send_st_response ? "yes" : "no") << endl;
+    if(m_settings.num_banks > 0) {
+	out << "    Channels: " << m_settings.num_channels << endl;
+	out << "    Banks per channel: " << m_settings.num_banks << endl;
+	out << "    Line size: " << m_settings.line_size << endl;
+	out << "    Row size: " << m_settings.row_size << endl;
+	out << "    Row hit time: " << m_settings.t_row_hit << endl;
+	out << "    Row miss time: " << m_settings.t_row_miss << endl;
+	out << "    Ticks per line: " << m_settings.ticks_per_line << endl;
+	out << "    Burst lines: " << m_settings.burst_lines << endl;
+    }
 }
 
 
@@ -71,6 +199,13 @@ void SimpleMC :: print_stats(ostream& out)
     for(map<int, int>::iterator it = m_stores.begin(); it != m_stores.end(); ++it) {
         out << "    " << (*it).first << ": " << (*it).second << endl;
     }
+    if(m_settings.num_banks > 0) {
+	out << "=== rows ===" << endl;
+	out << "    hits: " << m_row_hits << endl;
+	out << "    misses: " << m_row_misses << endl;
+	print_delays(out, "bank", m_bank_delays, m_total_bank_delay);
+	print_delays(out, "channel", m_channel_delays, m_total_channel_delay);
+    }
 
     for(multimap<Ticks_t, Req_info>::iterator it = m_req_info.begin(); it != m_req_info.end(); ++it) {
         Req_info& req = (*it).second;
@@ -110,7 +245,7 @@ SimpleMcMap :: SimpleMcMap(std::vector<int>& nodeIds, int line_size) : m_nodeIds
 }
 
 //! Return the node ID of the MC for a given address.
-int SimpleMcMap :: lookup(manifold::simple_cache::paddr_t addr)
+int SimpleMcMap :: lookup(uint64_t addr)
 {
     if(m_nodeIds.size() == 1) { //if there is only one MC
 	return m_nodeIds[0];
@@ -2,8 +2,8 @@
 #define MANIDOLD_SIMPLE_MC_SIMPLE_MC_H
 
 #include "kernel/component-decl.h"
-#include "simple-cache/cache_messages.h"
-#include "simple-cache/MemoryControllerMap.h"
+#include "simple-cache/cache_req.h"
+#include "uarch/DestMap.h"
 #include <map>
 #include <vector>
 #include <iostream>
@@ -12,26 +12,77 @@ namespace manifold {
 namespace simple_mc {
 
 
+//! Parameters of SimpleMC's optional queueing model. With num_banks == 0 (the
+//! default) there is no queueing and every request takes the fixed latency.
+//!
+//! Lines are interleaved across the channels, then across the banks of a channel.
+//! Each bank keeps its last row open; a request waits until the bank is free, then
+//! occupies it for t_row_hit or t_row_miss ticks. Data then leave on the channel,
+//! which is capped by a token bucket: one token per line, one new token every
+//! ticks_per_line ticks, at most burst_lines tokens saved up.
+struct SimpleMC_settings {
+    SimpleMC_settings() : num_channels(1), num_banks(0), line_size(64), row_size(2048),
+                          t_row_hit(0), t_row_miss(0), ticks_per_line(0), burst_lines(1) {}
+
+    int num_channels;
+    int num_banks; //banks per channel; 0 to disable the queueing model
+    int line_size; //bytes; must be a power of 2
+    int row_size; //bytes of a row in one bank; a multiple of line_size
+    manifold::kernel::Ticks_t t_row_hit; //bank busy time when the row is open
+    manifold::kernel::Ticks_t t_row_miss; //bank busy time when another row is open
+    manifold::kernel::Ticks_t ticks_per_line; //channel bandwidth; 0 for unlimited
+    int burst_lines; //token bucket depth
+};
+
+
 //! This class emulates a MC. Upon receiving a request it simply returns a response
-//! after certain delay.
+//! after certain delay. Optionally, the delay also includes the time spent waiting
+//! for a bank and for channel bandwidth; see SimpleMC_settings.
 class SimpleMC : public manifold::kernel::Component {
 public:
     enum {OUT=0};
     enum {IN=0};
 
-    SimpleMC(int nid, manifold::kernel::Ticks_t latency, bool st_resp=false) : m_nid(nid), m_latency(latency), m_send_st_response(st_resp) {}
+    SimpleMC(int nid, manifold::kernel::Ticks_t latency, bool st_resp=false);
+    SimpleMC(int nid, manifold::kernel::Ticks_t latency, const SimpleMC_settings& settings, bool st_resp=false);
 
     int get_nid() { return m_nid; }
 
-    void handle_incoming(int, manifold::simple_cache::mem_req* req);
+    void handle_incoming(int, manifold::simple_cache::Mem_req* req);
 
     void print_config(std::ostream&);
     void print_stats(std::ostream&);
+
+#ifdef SIMPLE_MC_TEST
+public:
+#else
 private:
+#endif
+    void init();
+    //! Return the ticks from now until a request for addr arriving now is done, not
+    //! counting m_latency, and update the banks and channels accordingly.
+    manifold::kernel::Ticks_t queue_request(manifold::simple_cache::paddr_t addr, manifold::kernel::Ticks_t now);
+
     int m_nid;  //node id
     manifold::kernel::Ticks_t m_latency;
     bool m_send_st_response;  //send response for stores
 
+    //queueing model
+    const SimpleMC_settings m_settings;
+    int m_offset_bits;
+    int m_lines_per_row;
+
+    struct Bank {
+        Bank() : busy_until(0), open_row(0), row_open(false) {}
+        manifold::kernel::Ticks_t busy_until;
+        uint64_t open_row;
+        bool row_open;
+    };
+    std::vector<Bank> m_banks; //indexed by channel * num_banks + bank
+    //Token bucket of each channel, kept as the time the next token would be taken if
+    //the bucket were empty; tokens are available from m_token_time - (burst_lines-1)*ticks_per_line.
+    std::vector<manifold::kernel::Ticks_t> m_token_time;
+
     //for stats
     struct Req_info {
         Req_info(int t, int oid, int sid, manifold::simple_cache::paddr_t a) : type(t), org_id(oid), src_id(sid), addr(a) {}
@@ -44,17 +95,29 @@ private:
     std::map<int, int> m_ld_misses; //number of ld misses per source
     std::map<int, int> m_stores;
     std::multimap<manifold::kernel::Ticks_t, Req_info> m_req_info; //request info in time order
+
+    //Queueing delays in power-of-2 bins: bin 0 counts delays of 0; bin i, delays in [2^(i-1), 2^i).
+    enum { DELAY_BINS = 32 };
+    static void collect_delay(std::vector<uint64_t>& bins, manifold::kernel::Ticks_t delay);
+    static void print_delays(std::ostream&, const char* name, const std::vector<uint64_t>& bins, uint64_t total);
+
+    uint64_t m_row_hits;
+    uint64_t m_row_misses;
+    std::vector<uint64_t> m_bank_delays; //waiting for the bank
+    std::vector<uint64_t> m_channel_delays; //waiting for a token after the bank is done
+    uint64_t m_total_bank_delay;
+    uint64_t m_total_channel_delay;
 };
 
 
 //! This memory controller map assumes there is only 1 memory controller, whose ID
 //! is given in the constructor.
-class SimpleMcMap1 : public manifold::simple_cache::MemoryControllerMap {
+class SimpleMcMap1 : public manifold::uarch::DestMap {
 public:
     SimpleMcMap1(int nodeId) : m_nodeId(nodeId)
     {}
 
-    int lookup(manifold::simple_cache::paddr_t addr)
+    int lookup(uint64_t addr)
     {
         return m_nodeId;
     }
@@ -65,11 +128,11 @@ private:
 
 //! This memory controller map distributes the memory lines (based on cache line)
 //! among the controllers.
-class SimpleMcMap : public manifold::simple_cache::MemoryControllerMap {
+class SimpleMcMap : public manifold::uarch::DestMap {
 public:
     SimpleMcMap(std::vector<int>& nodeIds, int line_size);
 
-    int lookup(manifold::simple_cache::paddr_t addr);
+    int lookup(uint64_t addr);
 
 private:
     std::vector<int> m_nodeIds;
@@ -5,9 +5,9 @@
 //!                  | MockSender |
 //!                   ------------
 //!                         |
-//!                  --------------
-//!                 | simple_cache |
-//!                  --------------
+//!                  -----------
+//!                 | simple_mc |
+//!                  -----------
 
 #include <TestFixture.h>
 #include <TestAssert.h>
@@ -40,21 +40,21 @@ public:
     enum {OUT=0};
     enum {IN=0};
 
-    void send_mreq(mem_req* mreq)
+    void send_mreq(Mem_req* mreq)
     {
 	Send(OUT, mreq);
     }
 
-    void handle_incoming(int, mem_req* mresp)
+    void handle_incoming(int, Mem_req* mresp)
     {
         m_mc_resps.push_back(*mresp);
         m_ticks.push_back(Manifold :: NowTicks());
 	delete mresp;
     }
-    vector<mem_req>& get_mc_resps() { return m_mc_resps; }
+    vector<Mem_req>& get_mc_resps() { return m_mc_resps; }
     vector<Ticks_t>& get_ticks() { return m_ticks; }
 private:
-    vector<mem_req> m_mc_resps;
+    vector<Mem_req> m_mc_resps;
     vector<Ticks_t> m_ticks;
 };
 
@@ -69,16 +69,19 @@ private:
     //latencies
     static const Ticks_t SENDER_TO_MC = 1;
 
+    static const int SENDER_ID = 123;
+
     MockSender* m_senderp;
     SimpleMC* m_mcp;
 
-    void mySetup(int nid, Ticks_t lat, bool st_resp)
+    void mySetup(int nid, Ticks_t lat, bool st_resp, const SimpleMC_settings* settings = 0)
     {
         //create a MockSender, and a SimpleMC
 	CompId_t senderId = Component :: Create<MockSender>(0);
 	m_senderp = Component::GetComponent<MockSender>(senderId);
 
-	CompId_t mcId = Component :: Create<SimpleMC>(0, nid, lat, st_resp);
+	CompId_t mcId = settings ? Component :: Create<SimpleMC>(0, nid, lat, *settings, st_resp) :
+	                           Component :: Create<SimpleMC>(0, nid, lat, st_resp);
 	m_mcp = Component::GetComponent<SimpleMC>(mcId);
 
         //connect the components
@@ -117,11 +120,12 @@ public:
 	//create a LOAD request
 	paddr_t addr = random();
 	int req_id = random();
-	mem_req* mreq = new mem_req(req_id, 123, addr, OpMemLd, INITIAL);
+	Mem_req* mreq = new Mem_req(SENDER_ID, addr, OpMemLd);
+	mreq->source_port = req_id; //returned in dest_port
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
-	//schedule for the MockSender to send the mem_req
+	//schedule for the MockSender to send the Mem_req
 	Manifold::Schedule(When, &MockSender::send_mreq, m_senderp, mreq);
 	Ticks_t scheduledAt = When + MasterClock.NowTicks();
 
@@ -131,14 +135,16 @@ public:
 	Manifold::Run();
 
         //verify sender got a response
-	vector<mem_req>& mresps = m_senderp->get_mc_resps();
+	vector<Mem_req>& mresps = m_senderp->get_mc_resps();
         vector<Ticks_t>& ticks = m_senderp->get_ticks();
-	mem_req mresp = mresps[0];
+	Mem_req mresp = mresps[0];
 
 	CPPUNIT_ASSERT_EQUAL(1, (int)mresps.size());
-	CPPUNIT_ASSERT_EQUAL(req_id, mresp.req_id);
+	CPPUNIT_ASSERT_EQUAL(req_id, mresp.dest_port);
+	CPPUNIT_ASSERT_EQUAL(SENDER_ID, mresp.dest_id);
+	CPPUNIT_ASSERT_EQUAL(nid, mresp.source_id);
 	CPPUNIT_ASSERT_EQUAL(addr, mresp.addr);
-	CPPUNIT_ASSERT_EQUAL(LD_RESPONSE, mresp.msg);
+	CPPUNIT_ASSERT_EQUAL(OpMemLd, mresp.op_type);
 	CPPUNIT_ASSERT_EQUAL(scheduledAt+SENDER_TO_MC+mc_latency, ticks[0]);
     }
 
@@ -160,11 +166,12 @@ public:
 	//create a STORE request
 	paddr_t addr = random();
 	int req_id = random();
-	mem_req* mreq = new mem_req(req_id, 123, addr, OpMemSt, INITIAL);
+	Mem_req* mreq = new Mem_req(SENDER_ID, addr, OpMemSt);
+	mreq->source_port = req_id; //returned in dest_port
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
-	//schedule for the MockSender to send the mem_req
+	//schedule for the MockSender to send the Mem_req
 	Manifold::Schedule(When, &MockSender::send_mreq, m_senderp, mreq);
 	Ticks_t scheduledAt = When + MasterClock.NowTicks();
 
@@ -174,7 +181,7 @@ public:
 	Manifold::Run();
 
         //verify sender got no response
-	vector<mem_req>& mresps = m_senderp->get_mc_resps();
+	vector<Mem_req>& mresps = m_senderp->get_mc_resps();
         vector<Ticks_t>& ticks = m_senderp->get_ticks();
 
 	CPPUNIT_ASSERT_EQUAL(0, (int)mresps.size());
@@ -199,19 +206,21 @@ public:
 	//create Nreqs LOAD request
 	const int Nreqs = 1000;
 
-	mem_req* reqs[Nreqs];
-	mem_req reqs_copy[Nreqs]; //make a copy for verification; reqs will be deleted
+	Mem_req* reqs[Nreqs];
+	Mem_req reqs_copy[Nreqs]; //make a copy for verification; reqs will be deleted
 	                          //by sender.
         int num_loads = 0;
         for(int i=0; i<Nreqs; i++) {
 	    paddr_t addr = random();
 	    int req_id = random();
 	    if(random() / (RAND_MAX + 1.0) < 0.5) { // 50% LOADs
-		reqs[i] = new mem_req(req_id, 123, addr, OpMemLd, INITIAL);
+		reqs[i] = new Mem_req(SENDER_ID, addr, OpMemLd);
+		reqs[i]->source_port = req_id;
 		num_loads++;
 	    }
 	    else {
-		reqs[i] = new mem_req(req_id, 123, addr, OpMemSt, INITIAL);
+		reqs[i] = new Mem_req(SENDER_ID, addr, OpMemSt);
+		reqs[i]->source_port = req_id;
 	    }
 	    reqs_copy[i] = *reqs[i];
 	}
@@ -219,7 +228,7 @@ public:
 	Manifold::unhalt();
 	Ticks_t When = 1;
 
-	//schedule for the MockSender to send the mem_reqs
+	//schedule for the MockSender to send the Mem_reqs
 	Ticks_t scheduledAts[Nreqs];
 
 	Ticks_t rtt = SENDER_TO_MC +  mc_latency; //round trip time
@@ -234,7 +243,7 @@ public:
 	Manifold::Run();
 
         //verify sender got a response
-	vector<mem_req>& mresps = m_senderp->get_mc_resps();
+	vector<Mem_req>& mresps = m_senderp->get_mc_resps();
         vector<Ticks_t>& ticks = m_senderp->get_ticks();
 
 	CPPUNIT_ASSERT_EQUAL(num_loads, (int)mresps.size());
@@ -243,7 +252,7 @@ public:
         int idx=0;
         for(int i=0; i<Nreqs; i++) {
 	    if(reqs_copy[i].op_type == OpMemLd) {
-		CPPUNIT_ASSERT_EQUAL(reqs_copy[i].req_id, mresps[idx].req_id);
+		CPPUNIT_ASSERT_EQUAL(reqs_copy[i].source_port, mresps[idx].dest_port);
 		CPPUNIT_ASSERT_EQUAL(reqs_copy[i].addr, mresps[idx].addr);
 		CPPUNIT_ASSERT_EQUAL(scheduledAts[i]+SENDER_TO_MC+mc_latency, ticks[idx]);
 		idx++;
@@ -271,11 +280,12 @@ public:
 	//create a LOAD request
 	paddr_t addr = random();
 	int req_id = random();
-	mem_req* mreq = new mem_req(req_id, 123, addr, OpMemLd, INITIAL);
+	Mem_req* mreq = new Mem_req(SENDER_ID, addr, OpMemLd);
+	mreq->source_port = req_id; //returned in dest_port
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
-	//schedule for the MockSender to send the mem_req
+	//schedule for the MockSender to send the Mem_req
 	Manifold::Schedule(When, &MockSender::send_mreq, m_senderp, mreq);
 	Ticks_t scheduledAt = When + MasterClock.NowTicks();
 
@@ -285,14 +295,16 @@ public:
 	Manifold::Run();
 
         //verify sender got a response
-	vector<mem_req>& mresps = m_senderp->get_mc_resps();
+	vector<Mem_req>& mresps = m_senderp->get_mc_resps();
         vector<Ticks_t>& ticks = m_senderp->get_ticks();
-	mem_req mresp = mresps[0];
+	Mem_req mresp = mresps[0];
 
 	CPPUNIT_ASSERT_EQUAL(1, (int)mresps.size());
-	CPPUNIT_ASSERT_EQUAL(req_id, mresp.req_id);
+	CPPUNIT_ASSERT_EQUAL(req_id, mresp.dest_port);
+	CPPUNIT_ASSERT_EQUAL(SENDER_ID, mresp.dest_id);
+	CPPUNIT_ASSERT_EQUAL(nid, mresp.source_id);
 	CPPUNIT_ASSERT_EQUAL(addr, mresp.addr);
-	CPPUNIT_ASSERT_EQUAL(LD_RESPONSE, mresp.msg);
+	CPPUNIT_ASSERT_EQUAL(OpMemLd, mresp.op_type);
 	CPPUNIT_ASSERT_EQUAL(scheduledAt+SENDER_TO_MC+mc_latency, ticks[0]);
     }
 
@@ -313,11 +325,12 @@ public:
 	//create a STORE request
 	paddr_t addr = random();
 	int req_id = random();
-	mem_req* mreq = new mem_req(req_id, 123, addr, OpMemSt, INITIAL);
+	Mem_req* mreq = new Mem_req(SENDER_ID, addr, OpMemSt);
+	mreq->source_port = req_id; //returned in dest_port
 
 	Manifold::unhalt();
 	Ticks_t When = 1;
-	//schedule for the MockSender to send the mem_req
+	//schedule for the MockSender to send the Mem_req
 	Manifold::Schedule(When, &MockSender::send_mreq, m_senderp, mreq);
 	Ticks_t scheduledAt = When + MasterClock.NowTicks();
 
@@ -327,16 +340,18 @@ public:
 	Manifold::Run();
 
         //verify sender got no response
-	vector<mem_req>& mresps = m_senderp->get_mc_resps();
+	vector<Mem_req>& mresps = m_senderp->get_mc_resps();
         vector<Ticks_t>& ticks = m_senderp->get_ticks();
 
 	CPPUNIT_ASSERT_EQUAL(1, (int)mresps.size());
 	CPPUNIT_ASSERT_EQUAL(1, (int)ticks.size());
-	mem_req mresp = mresps[0];
+	Mem_req mresp = mresps[0];
 
-	CPPUNIT_ASSERT_EQUAL(req_id, mresp.req_id);
+	CPPUNIT_ASSERT_EQUAL(req_id, mresp.dest_port);
+	CPPUNIT_ASSERT_EQUAL(SENDER_ID, mresp.dest_id);
+	CPPUNIT_ASSERT_EQUAL(nid, mresp.source_id);
 	CPPUNIT_ASSERT_EQUAL(addr, mresp.addr);
-	CPPUNIT_ASSERT_EQUAL(ST_COMPLETE, mresp.msg);
+	CPPUNIT_ASSERT_EQUAL(OpMemSt, mresp.op_type);
 	CPPUNIT_ASSERT_EQUAL(scheduledAt+SENDER_TO_MC+mc_latency, ticks[0]);
     }
 
@@ -358,19 +373,21 @@ public:
 	//create Nreqs LOAD request
 	const int Nreqs = 1000;
 
-	mem_req* reqs[Nreqs];
-	mem_req reqs_copy[Nreqs]; //make a copy for verification; reqs will be deleted
+	Mem_req* reqs[Nreqs];
+	Mem_req reqs_copy[Nreqs]; //make a copy for verification; reqs will be deleted
 	                          //by sender.
         int num_loads = 0;
         for(int i=0; i<Nreqs; i++) {
 	    paddr_t addr = random();
 	    int req_id = random();
 	    if(random() / (RAND_MAX + 1.0) < 0.5) { // 50% LOADs
-		reqs[i] = new mem_req(req_id, 123, addr, OpMemLd, INITIAL);
+		reqs[i] = new Mem_req(SENDER_ID, addr, OpMemLd);
+		reqs[i]->source_port = req_id;
 		num_loads++;
 	    }
 	    else {
-		reqs[i] = new mem_req(req_id, 123, addr, OpMemSt, INITIAL);
+		reqs[i] = new Mem_req(SENDER_ID, addr, OpMemSt);
+		reqs[i]->source_port = req_id;
 	    }
 	    reqs_copy[i] = *reqs[i];
 	}
@@ -378,7 +395,7 @@ public:
 	Manifold::unhalt();
 	Ticks_t When = 1;
 
-	//schedule for the MockSender to send the mem_reqs
+	//schedule for the MockSender to send the Mem_reqs
 	Ticks_t scheduledAts[Nreqs];
 
 	Ticks_t rtt = SENDER_TO_MC +  mc_latency; //round trip time
@@ -393,20 +410,20 @@ public:
 	Manifold::Run();
 
         //verify sender got a response
-	vector<mem_req>& mresps = m_senderp->get_mc_resps();
+	vector<Mem_req>& mresps = m_senderp->get_mc_resps();
         vector<Ticks_t>& ticks = m_senderp->get_ticks();
 
 	CPPUNIT_ASSERT_EQUAL(Nreqs, (int)mresps.size());
 	CPPUNIT_ASSERT_EQUAL(Nreqs, (int)ticks.size());
 
         for(int i=0; i<Nreqs; i++) {
-	    CPPUNIT_ASSERT_EQUAL(reqs_copy[i].req_id, mresps[i].req_id);
+	    CPPUNIT_ASSERT_EQUAL(reqs_copy[i].source_port, mresps[i].dest_port);
 	    CPPUNIT_ASSERT_EQUAL(reqs_copy[i].addr, mresps[i].addr);
 	    CPPUNIT_ASSERT_EQUAL(scheduledAts[i]+SENDER_TO_MC+mc_latency, ticks[i]);
 	    if(reqs_copy[i].op_type == OpMemLd)
-		CPPUNIT_ASSERT_EQUAL(LD_RESPONSE, mresps[i].msg);
+		CPPUNIT_ASSERT_EQUAL(OpMemLd, mresps[i].op_type);
 	    else
-		CPPUNIT_ASSERT_EQUAL(ST_COMPLETE, mresps[i].msg);
+		CPPUNIT_ASSERT_EQUAL(OpMemSt, mresps[i].op_type);
 	}
     }
 
@@ -415,6 +432,139 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! @brief Test queue_request(): banks and rows.
+    //!
+    //! Create a SimpleMC with 2 channels, 4 banks per channel and 4 lines per row.
+    //! Send requests that hit and miss the open row of a bank, conflict in a bank,
+    //! and go to another channel. Verify their delays and the stats.
+    void test_queue_request_0()
+    {
+	SimpleMC_settings settings;
+	settings.num_channels = 2;
+	settings.num_banks = 4;
+	settings.line_size = 64;
+	settings.row_size = 256;
+	settings.t_row_hit = 10;
+	settings.t_row_miss = 30;
+
+	CompId_t mcId = Component :: Create<SimpleMC>(0, 1, 50, settings);
+	SimpleMC* mc = Component::GetComponent<SimpleMC>(mcId);
+
+	//line 0: channel 0, bank 0, row 0; row miss
+	CPPUNIT_ASSERT_EQUAL((Ticks_t)30, mc->queue_request(0, 0));
+	//line 8: channel 0, bank 0, row 0; waits for the bank, then row hit
+	CPPUNIT_ASSERT_EQUAL((Ticks_t)40, mc->queue_request(8*64, 0));
+	//line 1: channel 1, bank 0; not affected by channel 0
+	CPPUNIT_ASSERT_EQUAL((Ticks_t)30, mc->queue_request(1*64 + 5, 0));
+	//line 2: channel 0, bank 1
+	CPPUNIT_ASSERT_EQUAL((Ticks_t)30, mc->queue_request(2*64, 3));
+	//line 32: channel 0, bank 0, row 1; waits until 40, then row miss
+	CPPUNIT_ASSERT_EQUAL((Ticks_t)65, mc->queue_request(32*64, 5));
+	//line 0 again after the bank is free: row 0 was closed
+	CPPUNIT_ASSERT_EQUAL((Ticks_t)30, mc->queue_request(0, 100));
+	//line 24: channel 0, bank 0, row 0; row hit
+	CPPUNIT_ASSERT_EQUAL((Ticks_t)10, mc->queue_request(24*64, 130));
+
+	CPPUNIT_ASSERT_EQUAL((uint64_t)2, mc->m_row_hits);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)5, mc->m_row_misses);
+	//bank delays: 0, 30, 0, 0, 35, 0, 0
+	CPPUNIT_ASSERT_EQUAL((uint64_t)5, mc->m_bank_delays[0]);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, mc->m_bank_delays[5]); //16-31
+	CPPUNIT_ASSERT_EQUAL((uint64_t)1, mc->m_bank_delays[6]); //32-63
+	CPPUNIT_ASSERT_EQUAL((uint64_t)65, mc->m_total_bank_delay);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)7, mc->m_channel_delays[0]);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)0, mc->m_total_channel_delay);
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test queue_request(): channel token bucket.
+    //!
+    //! Create a SimpleMC with 1 channel, 16 banks, 0 bank time, one token per 10 ticks
+    //! and a bucket of 3 tokens. Send a burst of requests to different banks; verify
+    //! the first 3 go at once and the rest 10 ticks apart. After a long idle period,
+    //! verify the bucket holds no more than 3 tokens.
+    void test_queue_request_1()
+    {
+	SimpleMC_settings settings;
+	settings.num_channels = 1;
+	settings.num_banks = 16;
+	settings.ticks_per_line = 10;
+	settings.burst_lines = 3;
+
+	CompId_t mcId = Component :: Create<SimpleMC>(0, 1, 50, settings);
+	SimpleMC* mc = Component::GetComponent<SimpleMC>(mcId);
+
+	const Ticks_t expected[] = { 0, 0, 0, 10, 20, 30, 40, 50 };
+	for(int i=0; i<8; i++)
+	    CPPUNIT_ASSERT_EQUAL(expected[i], mc->queue_request(i*64, 0));
+
+	for(int i=0; i<8; i++)
+	    CPPUNIT_ASSERT_EQUAL(expected[i], mc->queue_request(i*64, 1000));
+
+	CPPUNIT_ASSERT_EQUAL((uint64_t)6, mc->m_channel_delays[0]);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)2*(10+20+30+40+50), mc->m_total_channel_delay);
+	CPPUNIT_ASSERT_EQUAL((uint64_t)16, mc->m_bank_delays[0]);
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test handle_incoming with the queueing model.
+    //!
+    //! Create a SimpleMC with banks. Send a LOAD and a STORE to the same bank and row,
+    //! and a LOAD to another bank, at the same time. Verify the response timing.
+    void test_handle_incoming_q0()
+    {
+        int nid = random() % 1024;  //node id for the mc
+	Ticks_t mc_latency = random() % 200 + 50;
+
+	SimpleMC_settings settings;
+	settings.num_channels = 1;
+	settings.num_banks = 2;
+	settings.row_size = 1024;
+	settings.t_row_hit = 10;
+	settings.t_row_miss = 30;
+        mySetup(nid, mc_latency, true, &settings);
+
+	Mem_req* reqs[3];
+	reqs[0] = new Mem_req(SENDER_ID, 0, OpMemLd); //bank 0, row miss
+	reqs[1] = new Mem_req(SENDER_ID, 2*64, OpMemSt); //bank 0, row hit
+	reqs[2] = new Mem_req(SENDER_ID, 1*64, OpMemLd); //bank 1, row miss
+	for(int i=0; i<3; i++)
+	    reqs[i]->source_port = i;
+
+	Manifold::unhalt();
+	Ticks_t When = 1;
+	for(int i=0; i<3; i++)
+	    Manifold::Schedule(When, &MockSender::send_mreq, m_senderp, reqs[i]);
+	Ticks_t scheduledAt = When + MasterClock.NowTicks();
+
+	Manifold::StopAt(scheduledAt + SENDER_TO_MC + mc_latency + 100);
+	Manifold::Run();
+
+	vector<Mem_req>& mresps = m_senderp->get_mc_resps();
+        vector<Ticks_t>& ticks = m_senderp->get_ticks();
+
+	CPPUNIT_ASSERT_EQUAL(3, (int)mresps.size());
+	//responses in time order: the 2 row misses, then the row hit
+	CPPUNIT_ASSERT_EQUAL(0, mresps[0].dest_port);
+	CPPUNIT_ASSERT_EQUAL(2, mresps[1].dest_port);
+	CPPUNIT_ASSERT_EQUAL(1, mresps[2].dest_port);
+	CPPUNIT_ASSERT_EQUAL(scheduledAt + SENDER_TO_MC + mc_latency + 30, ticks[0]);
+	CPPUNIT_ASSERT_EQUAL(scheduledAt + SENDER_TO_MC + mc_latency + 30, ticks[1]);
+	CPPUNIT_ASSERT_EQUAL(scheduledAt + SENDER_TO_MC + mc_latency + 40, ticks[2]);
+    }
+
+
+
+
+
 
     //! Build a test suite.
     static CppUnit::Test* suite()
@@ -427,6 +577,9 @@ public:
 	mySuite->addTest(new CppUnit::TestCaller<simple_mcTest>("test_handle_incoming_r0", &simple_mcTest::test_handle_incoming_r0));
 	mySuite->addTest(new CppUnit::TestCaller<simple_mcTest>("test_handle_incoming_r1", &simple_mcTest::test_handle_incoming_r1));
 	mySuite->addTest(new CppUnit::TestCaller<simple_mcTest>("test_handle_incoming_r2", &simple_mcTest::test_handle_incoming_r2));
+	mySuite->addTest(new CppUnit::TestCaller<simple_mcTest>("test_queue_request_0", &simple_mcTest::test_queue_request_0));
+	mySuite->addTest(new CppUnit::TestCaller<simple_mcTest>("test_queue_request_1", &simple_mcTest::test_queue_request_1));
+	mySuite->addTest(new CppUnit::TestCaller<simple_mcTest>("test_handle_incoming_q0", &simple_mcTest::test_handle_incoming_q0));
 
 	return mySuite;
     }
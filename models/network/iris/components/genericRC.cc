@@ -11,6 +11,10 @@ GenericRC::GenericRC(unsigned vcs, const GenericRCSettings& setting) :
 	no_nodes(setting.no_nodes),
 	grid_size(setting.grid_size),
         rc_method(setting.rc_method),
+	concentration(setting.concentration),
+	port(setting.port),
+	express_hops(setting.express_hops),
+	next_vc_class(0),
 	addresses(vcs)
 {
     for ( uint i = 0 ; i<vcs ; i++ )
@@ -88,8 +92,14 @@ GenericRC::route_torus(HeadFlit* hf)
                 possible_out_ports.push_back(SimpleRouter::PORT_NORTH);
         }
 
+	const uint y_dim = no_nodes/grid_size;
+	if( possible_out_ports[0] == SimpleRouter::PORT_NORTH )
+	    possible_out_ports[0] = take_express(SimpleRouter::PORT_NORTH, (myy + y_dim - desty) % y_dim);
+	else
+	    possible_out_ports[0] = take_express(SimpleRouter::PORT_SOUTH, (desty + y_dim - myy) % y_dim);
+
 	// Decide the vc
-        if( possible_out_ports[0] == SimpleRouter::PORT_NORTH )
+        if( possible_out_ports[0] == SimpleRouter::PORT_NORTH || possible_out_ports[0] == SimpleRouter::PORT_EXPRESS_NORTH )
         {
             desty = (grid_size-desty)%grid_size;
             myy= (grid_size-myy)%grid_size;
@@ -118,8 +128,13 @@ GenericRC::route_torus(HeadFlit* hf)
                 possible_out_ports.push_back(SimpleRouter::PORT_WEST);
         }
 
+	if( possible_out_ports[0] == SimpleRouter::PORT_WEST )
+	    possible_out_ports[0] = take_express(SimpleRouter::PORT_WEST, (myx + grid_size - destx) % grid_size);
+	else
+	    possible_out_ports[0] = take_express(SimpleRouter::PORT_EAST, (destx + grid_size - myx) % grid_size);
+
 	// Decide the vc
-        if( possible_out_ports[0] == SimpleRouter::PORT_WEST)
+        if( possible_out_ports[0] == SimpleRouter::PORT_WEST || possible_out_ports[0] == SimpleRouter::PORT_EXPRESS_WEST )
         {
             destx = (grid_size-destx)%grid_size;
             myx= (grid_size-myx)%grid_size;
@@ -333,8 +348,13 @@ GenericRC::route_ring(HeadFlit* hf)
                 possible_out_ports.push_back(SimpleRouter::PORT_WEST);
         }
 
+	if( possible_out_ports[0] == SimpleRouter::PORT_WEST )
+	    possible_out_ports[0] = take_express(SimpleRouter::PORT_WEST, (myx + grid_size - destx) % grid_size);
+	else
+	    possible_out_ports[0] = take_express(SimpleRouter::PORT_EAST, (destx + grid_size - myx) % grid_size);
+
 	// Decide the vc
-        if( possible_out_ports[0] == SimpleRouter::PORT_WEST)
+        if( possible_out_ports[0] == SimpleRouter::PORT_WEST || possible_out_ports[0] == SimpleRouter::PORT_EXPRESS_WEST )
         {
             destx = (grid_size-destx)%grid_size;
             myx= (grid_size-myx)%grid_size;
@@ -349,6 +369,120 @@ GenericRC::route_ring(HeadFlit* hf)
 }
 
 
+//! Ring and torus: a packet that still has at least express_hops hops to go in the
+//! direction of port takes the express link of that direction, which skips express_hops-1
+//! routers. Both kinds of links use the same dateline VC classes.
+//! @param \c port  PORT_WEST, PORT_EAST, PORT_NORTH, or PORT_SOUTH.
+//! @param \c dist  Hops to the destination in the direction of port.
+uint
+GenericRC::take_express(uint port, uint dist) const
+{
+    if(express_hops > 0 && dist >= express_hops)
+        return port + (SimpleRouter::PORT_EXPRESS_WEST - SimpleRouter::PORT_WEST);
+    return port;
+}
+
+
+//! Minimal routing in a mesh (concentrated if concentration > 1). Terminal t is attached
+//! to router t/concentration: local terminal 0 at PORT_NI, local terminal k>0 at PORT_MC+k-1.
+//! XY, YX and O1TURN return one port; WEST_FIRST and ODD_EVEN return all the productive
+//! ports the turn model allows, in X-first order, and the router picks one by credits.
+//! Packets are split between two VC classes that use disjoint VCs. O1TURN routes class 0
+//! XY and class 1 YX, so each class is deadlock-free on its own; the other algorithms
+//! route both classes the same way.
+//! @param \c ch  The input VC.
+void
+GenericRC::route_mesh(HeadFlit* hf, uint ch)
+{
+    const uint dst_router = hf->dst_id / concentration;
+    const int myx = node_id % grid_size;
+    const int myy = node_id / grid_size;
+    const int destx = dst_router % grid_size;
+    const int desty = dst_router / grid_size;
+    const int e0 = destx - myx; //> 0: go east
+    const int e1 = desty - myy; //> 0: go south
+
+    if ( e0 == 0 && e1 == 0 )
+    {
+        const uint local = hf->dst_id % concentration;
+        if (local == 0)
+            possible_out_ports.push_back(SimpleRouter::PORT_NI);
+        else
+            possible_out_ports.push_back(SimpleRouter::PORT_MC + local - 1);
+	decide_vc_simple(hf);
+        return;
+    }
+
+    const uint xport = (e0 > 0) ? SimpleRouter::PORT_EAST : SimpleRouter::PORT_WEST;
+    const uint yport = (e1 > 0) ? SimpleRouter::PORT_SOUTH : SimpleRouter::PORT_NORTH;
+
+    //The class is picked at the source, alternating between packets, and kept for the
+    //whole route.
+    uint vc_class;
+    if (port == SimpleRouter::PORT_NI || port >= SimpleRouter::PORT_MC) { //packet is injected here
+	vc_class = next_vc_class;
+	next_vc_class = 1 - next_vc_class;
+    }
+    else
+	vc_class = get_mesh_vc_class(ch);
+
+    switch(rc_method) {
+	case XY:
+	    possible_out_ports.push_back(e0 != 0 ? xport : yport);
+	    break;
+	case YX:
+	    possible_out_ports.push_back(e1 != 0 ? yport : xport);
+	    break;
+	case O1TURN:
+	    if (vc_class == 0)
+		possible_out_ports.push_back(e0 != 0 ? xport : yport);
+	    else
+		possible_out_ports.push_back(e1 != 0 ? yport : xport);
+	    break;
+	case WEST_FIRST:
+	    //all west hops are taken first; after that any productive direction
+	    if (e0 < 0)
+		possible_out_ports.push_back(SimpleRouter::PORT_WEST);
+	    else {
+		if (e0 > 0)
+		    possible_out_ports.push_back(SimpleRouter::PORT_EAST);
+		if (e1 != 0)
+		    possible_out_ports.push_back(yport);
+	    }
+	    break;
+	case ODD_EVEN:
+	    //Chiu's odd-even turn model: no east-to-vertical turn in an even column,
+	    //no vertical-to-west turn in an odd column.
+	    {
+		const int srcx = (hf->src_id / concentration) % grid_size;
+		if (e0 == 0)
+		    possible_out_ports.push_back(yport);
+		else if (e0 > 0) {
+		    if (e1 == 0)
+			possible_out_ports.push_back(SimpleRouter::PORT_EAST);
+		    else {
+			if (destx % 2 == 1 || e0 != 1)
+			    possible_out_ports.push_back(SimpleRouter::PORT_EAST);
+			if (myx % 2 == 1 || myx == srcx)
+			    possible_out_ports.push_back(yport);
+		    }
+		}
+		else {
+		    possible_out_ports.push_back(SimpleRouter::PORT_WEST);
+		    if (e1 != 0 && myx % 2 == 0)
+			possible_out_ports.push_back(yport);
+		}
+	    }
+	    break;
+	default:
+	    assert(0);
+    }
+    assert(possible_out_ports.size() > 0);
+
+    decide_vc_for_mesh(vc_class, hf);
+}
+
+
 void
 GenericRC::route_twonode(HeadFlit* hf)
 {
@@ -426,9 +560,12 @@ GenericRC::push (Flit* f, uint ch )
         {
             route_twonode( header );
         }
-        else if( rc_method == XY)
+        else if( rc_method == XY || rc_method == YX || rc_method == O1TURN ||
+	         rc_method == WEST_FIRST || rc_method == ODD_EVEN)
         {
-	    assert(0);  //XY not used
+            route_mesh( header, ch );
+
+            assert ( possible_out_vcs.size() == 1);
         }
 	else {
 	    assert(0);
@@ -436,7 +573,7 @@ GenericRC::push (Flit* f, uint ch )
 
 
 	addresses[ch].out_port = possible_out_ports.at(0);
-	addresses[ch].possible_out_ports.push_back(possible_out_ports.at(0));
+	addresses[ch].possible_out_ports = possible_out_ports;
 
 	addresses[ch].channel = possible_out_vcs[0];
 	addresses[ch].possible_out_vcs.push_back(possible_out_vcs[0]);
@@ -500,6 +637,16 @@ void GenericRC :: decide_vc_for_ring(uint dest, uint my, HeadFlit* hf)
 
 
 
+void GenericRC :: decide_vc_for_mesh(uint vc_class, HeadFlit* hf)
+{
+    possible_out_vcs.push_back(vc_class);
+}
+
+uint GenericRC :: get_mesh_vc_class(uint vc)
+{
+    return vc;
+}
+
 
 
 
@@ -619,6 +766,26 @@ void ReqReplyRC :: decide_vc_for_ring(uint dest, uint my, HeadFlit* hf)
 }
 
 
+//! VCs 0 and 1 are class 0, VCs 2 and 3 are class 1; within a class, the even VC
+//! carries requests and the odd VC replies.
+void ReqReplyRC :: decide_vc_for_mesh(uint vc_class, HeadFlit* hf)
+{
+    if ( hf->mclass == PROC_REQ)
+	possible_out_vcs.push_back(2*vc_class);
+    else if ( hf->mclass == MC_RESP)
+	possible_out_vcs.push_back(2*vc_class + 1);
+    else {
+	assert(0);
+    }
+}
+
+
+uint ReqReplyRC :: get_mesh_vc_class(uint vc)
+{
+    return vc / 2;
+}
+
+
 
 } // namespace iris
 } // namespace manifold
@@ -28,10 +28,15 @@ namespace iris {
 
 
 struct GenericRCSettings {
+    GenericRCSettings() : concentration(1), port(0), express_hops(0) {}
+
     unsigned grid_size;
     unsigned node_id;
     ROUTING_SCHEME rc_method;
     unsigned no_nodes;
+    unsigned concentration; //mesh: no. of terminals per router
+    unsigned port; //the input port the RC serves
+    unsigned express_hops; //ring and torus: length of the express links; 0 for none
 };
 
 class GenericRC
@@ -42,6 +47,8 @@ class GenericRC
         void push( Flit* f, uint vc );
         uint get_output_port ( uint channel);
         uint get_virtual_channel ( uint ch );
+        //! All the output ports the routing algorithm allows; more than one for adaptive routing.
+        const std::vector<uint>& get_possible_output_ports(uint ch) const { return addresses[ch].possible_out_ports; }
         std::string toString() const;
         //uint no_adaptive_ports( uint ch );
         //uint no_adaptive_vcs( uint ch );
@@ -57,6 +64,8 @@ class GenericRC
 
 	virtual void decide_vc_simple(HeadFlit* hf);
 	virtual void decide_vc_for_ring(uint dest, uint my, HeadFlit* hf);
+	virtual void decide_vc_for_mesh(uint vc_class, HeadFlit* hf);
+	virtual uint get_mesh_vc_class(uint vc);
 
         std::vector < uint > possible_out_ports;
         std::vector < uint > possible_out_vcs;
@@ -71,12 +80,18 @@ class GenericRC
         const uint no_nodes;
         uint grid_size;
         const ROUTING_SCHEME rc_method;
+        const uint concentration;
+        const uint port;
+        const uint express_hops;
+        uint next_vc_class; //mesh: VC class of the next packet injected
 
         //std::string name;
         void route_twonode( HeadFlit* hf );
         void route_torus( HeadFlit* hf );
         void route_torus6p( HeadFlit* hf );
         void route_ring( HeadFlit* hf );
+        void route_mesh( HeadFlit* hf, uint ch );
+        uint take_express(uint port, uint dist) const;
         //uint route_x_y( uint addr );
         //void route_ring_uni( HeadFlit* hf );
 
@@ -118,6 +133,8 @@ class ReqReplyRC : public GenericRC {
 #endif
 	virtual void decide_vc_simple(HeadFlit* hf);
 	virtual void decide_vc_for_ring(uint dest, uint my, HeadFlit* hf);
+	virtual void decide_vc_for_mesh(uint vc_class, HeadFlit* hf);
+	virtual uint get_mesh_vc_class(uint vc);
 };
 
 
@@ -67,6 +67,18 @@ GenericSwitchArbiter::clear_requestor( uint oport, uint inport, uint ich)
 }
 
 
+//! @return  True if any input VC is requesting or traversing the output port.
+bool
+GenericSwitchArbiter::has_requestor( uint oport) const
+{
+    for ( uint j=0; j<(ports*vcs); j++) {
+        if(requested[oport][j])
+	    return true;
+    }
+    return false;
+}
+
+
 
 std::string
 GenericSwitchArbiter::toString() const
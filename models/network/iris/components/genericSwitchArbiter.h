@@ -47,6 +47,9 @@ class GenericSwitchArbiter
         ~GenericSwitchArbiter();
         void clear_requestor(uint outp, uint inp, uint ovc);
         virtual void request(uint p, uint op, uint inp, uint iv);
+        //! Give the output port to an input VC without arbitration; used when the port has no requestors.
+        void grant(uint outp, uint inp, uint iv) { requested[outp][inp*vcs+iv] = true; }
+        bool has_requestor(uint outp) const;
         virtual const SA_unit* pick_winner( uint p) = 0;
 
         std::string toString() const;
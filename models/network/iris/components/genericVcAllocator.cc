@@ -66,6 +66,18 @@ GenericVcAllocator::release_output_vc(unsigned port, unsigned ovc)
 }
 
 
+unsigned
+GenericVcAllocator::get_ovc_load(unsigned port, unsigned ovc) const
+{
+    unsigned load = ovc_taken[port][ovc] ? 1 : 0;
+    for ( uint j=0; j<PORTS*VCS; j++ ) {
+        if ( requested[port][j].is_valid && requested[port][j].out_vc == ovc )
+	    load++;
+    }
+    return load;
+}
+
+
 
 
 
@@ -150,6 +162,12 @@ void FCFSVcAllocator :: request( uint op, uint ovc, uint ip, uint invc )
 }
 
 
+unsigned FCFSVcAllocator :: get_ovc_load(unsigned port, unsigned ovc) const
+{
+    return (ovc_taken[port][ovc] ? 1 : 0) + m_requesters[port*VCS + ovc].size();
+}
+
+
 
 //! Allocate output VCs for requesting input VCs. When a VC requesting an output VC, it is in the
 //! state SVA_REQUESTED. After it is allocated an output VC, it changes to SVA_COMPLETE. Then it
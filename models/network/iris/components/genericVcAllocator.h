@@ -54,6 +54,10 @@ class GenericVcAllocator
         virtual void request(uint out_port, uint out_vc, uint in_port, uint in_vc);
         virtual std::vector<VCA_unit>& pick_winner() = 0;
 	void release_output_vc(unsigned port, unsigned ovc);
+	//! Take the output VC without arbitration; used when no one holds or waits for it.
+	void grant(unsigned port, unsigned ovc) { assert(!ovc_taken[port][ovc]); ovc_taken[port][ovc] = true; }
+	//! No. of input VCs holding or waiting for the output VC.
+	virtual unsigned get_ovc_load(unsigned port, unsigned ovc) const;
         std::string toString() const;        
 
 #ifdef IRIS_TEST
@@ -97,6 +101,7 @@ public:
 
     virtual void request(uint out_port, uint out_vc, uint in_port, uint in_vc);
     virtual std::vector<VCA_unit>& pick_winner();
+    virtual unsigned get_ovc_load(unsigned port, unsigned ovc) const;
 
 #ifdef IRIS_TEST
 public:
@@ -11,7 +11,8 @@ namespace iris {
 
 SimpleRouter::SimpleRouter(uint id, router_init_params* i_p) : in_buffers(i_p->no_ports), decoders(i_p->no_ports),
 	node_id(id),
-	ports(i_p->no_ports), vcs(i_p->no_vcs), CREDITS(i_p->credits), rc_method(i_p->rc_method)
+	ports(i_p->no_ports), vcs(i_p->no_vcs), CREDITS(i_p->credits), rc_method(i_p->rc_method),
+	bypass(i_p->bypass)
 {
     assert(vcs == 4);
     port_cross_lp.resize(ports);
@@ -40,8 +41,12 @@ SimpleRouter::SimpleRouter(uint id, router_init_params* i_p) : in_buffers(i_p->n
     rcSetting.node_id = node_id;
     rcSetting.rc_method = rc_method;
     rcSetting.no_nodes = no_nodes;
-    for(unsigned i=0; i<ports; i++) //one RC per port
+    rcSetting.concentration = i_p->concentration;
+    rcSetting.express_hops = i_p->express_hops;
+    for(unsigned i=0; i<ports; i++) { //one RC per port
+        rcSetting.port = i;
         decoders[i] = new ReqReplyRC(vcs, rcSetting);
+    }
 
     // useful when debugging the swa and vca... but not needed for operation
     //swa.node_ip = node_id; 
@@ -84,6 +89,7 @@ SimpleRouter::SimpleRouter(uint id, router_init_params* i_p) : in_buffers(i_p->n
     stat_packets_out = 0;
     stat_packets_in = 0;
     stat_flits_out = 0;
+    stat_packets_bypassed = 0;
     stat_flits_in = 0;
     avg_router_latency = 0;
     stat_last_flit_out_cycle= 0;
@@ -228,7 +234,8 @@ std::cerr << "Router " << node_id << " received head flit: port-vc " << inport <
 
 
 //The actual route computing is done in do_input_buffering(). Here we only change the input
-//VC's state from FULL to VCA_REQUESTED and make a vc allocation request.
+//VC's state from FULL to VCA_REQUESTED and make a vc allocation request, or, if bypass is
+//enabled and the router is idle, straight to SW_TRAVERSAL.
 void SimpleRouter :: do_route_computing()
 {
     unsigned idx = 0;
@@ -239,14 +246,15 @@ void SimpleRouter :: do_route_computing()
 	    // Check new head flits; enter them into VCA_REQUESTED stage.
 	    if(input_buffer_state[idx].pipe_stage == FULL) {
 
-		input_buffer_state[idx].possible_oports.clear();
-		unsigned rc_port = decoders[p]->get_output_port(v);
-		input_buffer_state[idx].possible_oports.push_back(rc_port);
-
 		input_buffer_state[idx].possible_ovcs.clear();
 		unsigned rc_vc = decoders[p]->get_virtual_channel(v);
 		input_buffer_state[idx].possible_ovcs.push_back(rc_vc);
 
+		input_buffer_state[idx].possible_oports.clear();
+		const std::vector<uint>& rc_ports = decoders[p]->get_possible_output_ports(v);
+		unsigned rc_port = (rc_ports.size() == 1) ? rc_ports[0] : select_output_port(rc_ports, rc_vc);
+		input_buffer_state[idx].possible_oports.push_back(rc_port);
+
 		assert ( input_buffer_state[idx].possible_oports.size() != 0);
 		assert ( input_buffer_state[idx].possible_ovcs.size() != 0);
 
@@ -255,6 +263,20 @@ void SimpleRouter :: do_route_computing()
 
 		unsigned op = input_buffer_state[idx].possible_oports[0];
 		unsigned oc = input_buffer_state[idx].possible_ovcs[0];
+
+		if(bypass && can_bypass(op, oc)) {
+		    //VC and switch allocation would both succeed right away, so skip them; the
+		    //head flit goes out in the next tick.
+		    vca->grant(op, oc);
+		    swa->grant(op, p, v);
+		    input_buffer_state[idx].output_port = op;
+		    input_buffer_state[idx].output_channel = oc;
+		    input_buffer_state[idx].sa_head_done = true;
+		    input_buffer_state[idx].pipe_stage = SW_TRAVERSAL;
+		    stat_packets_bypassed++;
+		    continue;
+		}
+
 		input_buffer_state[idx].pipe_stage = VCA_REQUESTED;
 		vca->request(op,oc,p,v);
 
@@ -268,6 +290,42 @@ std::cerr << "Router " << node_id << " vc " << p << "-"<< v <<"-" << op <<"-"<<
 }
 
 
+//! A head flit can bypass VC and switch allocation if no one holds or waits for the output
+//! VC, which has max credits, and no one requests or traverses the output port.
+bool SimpleRouter :: can_bypass(uint oport, uint ovc) const
+{
+    return vca->get_ovc_load(oport, ovc) == 0 && has_max_credits(oport, ovc) && !swa->has_requestor(oport);
+}
+
+
+//! Adaptive routing: of the ports the routing algorithm allows, pick the least congested:
+//! the one whose output VC has the fewest input VCs holding or waiting for it, then the
+//! most downstream credits on the output VC, then the most credits over all VCs. Ties go
+//! to the earlier port.
+uint SimpleRouter :: select_output_port(const std::vector<uint>& oports, uint ovc) const
+{
+    uint best = 0;
+    uint best_load = 0;
+    uint best_total = 0;
+
+    for(unsigned i=0; i<oports.size(); i++) {
+        const uint op = oports[i];
+	const uint load = vca->get_ovc_load(op, ovc);
+	uint total = 0;
+	for(unsigned v=0; v<vcs; v++)
+	    total += downstream_credits[op][v];
+	if(i == 0 || load < best_load ||
+	   (load == best_load && downstream_credits[op][ovc] > downstream_credits[best][ovc]) ||
+	   (load == best_load && downstream_credits[op][ovc] == downstream_credits[best][ovc] && total > best_total)) {
+	    best = op;
+	    best_load = load;
+	    best_total = total;
+	}
+    }
+    return best;
+}
+
+
 //! Do 3 things in the following order:
 //! 1. Allocate output VC for all input VCs in the state VCA_REQUESTED. This arbitration task is designated to
 //! the VC allocator. Winners of the arbitration move to the state VCA_COMPLETE.
@@ -570,10 +628,40 @@ manifold::kernel::Ticks_t SimpleRouter :: earliest_to_NI()
     }
 
     //There are no flits for the NI.
-    return 4; //takes at least 4 cycles for a head flt to arrive at NI
+    return bypass ? 2 : 4; //takes at least 4 cycles (2 with bypass) for a head flt to arrive at NI
+}
+
+
+
+void SimpleRouter::checkpoint (manifold::kernel::CheckpointOut& out)
+{
+    for(uint i=0; i<ports; i++) {
+        for(uint j=0; j<vcs; j++) {
+	    assert(in_buffers[i]->is_empty(j));
+	    assert(input_buffer_state[i*vcs+j].pipe_stage == EMPTY ||
+	           input_buffer_state[i*vcs+j].pipe_stage == PS_INVALID);
+	}
+    }
+
+    out.write(ports);
+    out.write(vcs);
+    for(uint i=0; i<ports; i++)
+        for(uint j=0; j<vcs; j++)
+	    out.write(downstream_credits[i][j]);
 }
 
 
+void SimpleRouter::restore (manifold::kernel::CheckpointIn& in)
+{
+    unsigned p, v;
+    in.read(p);
+    in.read(v);
+    assert(p == ports && v == vcs);
+    for(uint i=0; i<ports; i++)
+        for(uint j=0; j<vcs; j++)
+	    in.read(downstream_credits[i][j]);
+}
+
 
 void SimpleRouter::print_stats (ostream& out ) const
 {
@@ -582,6 +670,7 @@ void SimpleRouter::print_stats (ostream& out ) const
         << "\n SimpleRouter[" << node_id << "] packets_out: " << stat_packets_out
         << "\n SimpleRouter[" << node_id << "] flits_in: " << stat_flits_in
         << "\n SimpleRouter[" << node_id << "] flits_out: " << stat_flits_out
+        << "\n SimpleRouter[" << node_id << "] packets_bypassed: " << stat_packets_bypassed
         << "\n SimpleRouter[" << node_id << "] avg_router_latency: " << (avg_router_latency+0.0)/stat_packets_out
         << "\n SimpleRouter[" << node_id << "] last_pkt_out_cy: " << stat_last_flit_out_cycle
         << "\n SimpleRouter[" << node_id << "] ib_cycles: " << ib_cycles
@@ -696,7 +785,7 @@ void SimpleRouter :: set_port_cross_lp (int port)
 //! This is used as part of the forecast null message algorithm.
 void SimpleRouter :: do_output_to_router_prediction()
 {
-    const int PIPE_DEPTH = 4;
+    const int PIPE_DEPTH = bypass ? 2 : 4; //bypass skips VC and switch allocation
 
     for (unsigned p = 0; p < ports; p++) { //for all ports
 	if (!port_cross_lp[p])
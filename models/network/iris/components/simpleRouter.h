@@ -50,6 +50,7 @@
 #include	"genericSwitchArbiter.h"
 #include	"genericRC.h"
 #include	"genericVcAllocator.h"
+#include	"kernel/checkpoint.h"
 
 namespace manifold {
 namespace iris {
@@ -110,12 +111,17 @@ class InputBufferState
 
 
 struct router_init_params {
+    router_init_params() : concentration(1), express_hops(0), bypass(false) {}
+
     uint no_nodes;
     uint grid_size; 
     uint no_ports;
     uint no_vcs;
     uint credits;
     ROUTING_SCHEME rc_method;
+    uint concentration; //mesh: no. of terminals per router
+    uint express_hops; //ring and torus: length of the express links; 0 for none
+    bool bypass; //let head flits skip VC and switch allocation at an idle router
 };
 
 
@@ -126,6 +132,8 @@ class SimpleRouter : public manifold::kernel::Component
 unsigned npred;
 unsigned tpred;
         enum { PORT_NI=0, PORT_WEST, PORT_EAST, PORT_NORTH, PORT_SOUTH, PORT_MC };
+        //Express links of Ring and Torus, which don't use PORT_MC.
+        enum { PORT_EXPRESS_WEST=PORT_MC, PORT_EXPRESS_EAST, PORT_EXPRESS_NORTH, PORT_EXPRESS_SOUTH };
 
 
         /* ====================  LIFECYCLE     ======================================= */
@@ -142,6 +150,11 @@ unsigned tpred;
         /* ================ Functions Local to this class ====================== */
         void print_stats(std::ostream& out) const;
 
+        //! Save/restore the credits of the output VCs. Flits in the input buffers
+        //! cannot be saved, so the router must be empty.
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
         const std::vector<InputBufferState>& get_input_buffer_state() { return input_buffer_state; }
 
 	//! Check if an output VC has max credits.
@@ -170,6 +183,8 @@ unsigned tpred;
         void do_switch_allocation();
         void do_vc_allocation();
 	void do_route_computing();
+	uint select_output_port(const std::vector<uint>& oports, uint ovc) const;
+	bool can_bypass(uint oport, uint ovc) const;
         void do_input_buffering(HeadFlit*, uint, uint);
 	void dump_input_vc_state();
 	#ifdef IRIS_DBG
@@ -187,6 +202,7 @@ unsigned tpred;
         const unsigned vcs;
         const unsigned CREDITS;
         const ROUTING_SCHEME rc_method;
+        const bool bypass;
         uint no_nodes;
         uint grid_size;
         std::vector< std::vector<uint> > downstream_credits;
@@ -199,6 +215,7 @@ unsigned tpred;
         uint64_t stat_packets_out;
         uint64_t stat_flits_in;
         uint64_t stat_flits_out;
+        uint64_t stat_packets_bypassed; //packets that skipped VC and switch allocation
 
         uint64_t avg_router_latency;
         uint64_t stat_last_flit_out_cycle;
@@ -0,0 +1,199 @@
+#include	"trafficGenerator.h"
+#include	"kernel/manifold.h"
+#include	<assert.h>
+
+using namespace std;
+using namespace manifold::kernel;
+
+namespace manifold {
+namespace iris {
+
+
+//! @param \c id  The terminal id; packets are sent to terminal ids.
+//! @param \c params  The pattern and injection parameters.
+TrafficGenerator::TrafficGenerator(unsigned id, const traffic_gen_init_params* params) :
+    m_id(id), m_nodes(params->x_dim * params->y_dim), m_params(*params),
+    m_rate(params->rate), m_burst_on(false), m_ni_credits(params->ni_credits)
+{
+    assert(m_nodes > 1 && m_id < m_nodes);
+    assert(m_params.pkt_size > 0 && m_params.long_pkt_size > 0);
+    assert(m_params.ni_credit_type != 0); //0 is the type of data packets
+
+    switch(m_params.pattern) {
+	case TP_TRANSPOSE:
+	    if(m_params.x_dim != m_params.y_dim) {
+		cerr << "TrafficGenerator: transpose requires x_dim == y_dim." << endl;
+		exit(1);
+	    }
+	    break;
+	case TP_BIT_COMPLEMENT:
+	    if((m_nodes & (m_nodes - 1)) != 0) {
+		cerr << "TrafficGenerator: bit complement requires a power of 2 terminals." << endl;
+		exit(1);
+	    }
+	    break;
+	case TP_HOTSPOT:
+	    assert(m_params.hotspot >= 0 && m_params.hotspot < (int)m_nodes);
+	    break;
+	default:
+	    break;
+    }
+
+    //each terminal has its own reproducible random sequence
+    m_xsubi[0] = 0x330e;
+    m_xsubi[1] = (unsigned short)m_params.seed;
+    m_xsubi[2] = (unsigned short)m_id;
+
+    reset_stats();
+}
+
+
+void TrafficGenerator::set_rate(double rate)
+{
+    assert(rate >= 0 && rate <= 1);
+    m_rate = rate;
+}
+
+
+void TrafficGenerator::reset_stats()
+{
+    stat_packets_generated = 0;
+    stat_packets_sent = 0;
+    stat_packets_received = 0;
+    stat_bytes_received = 0;
+    stat_total_latency = 0;
+    stat_max_latency = 0;
+    stat_max_src_queue_length = m_src_queue.size();
+}
+
+
+int TrafficGenerator::get_dest()
+{
+    const unsigned X = m_params.x_dim;
+    const unsigned Y = m_params.y_dim;
+    const unsigned x = m_id % X;
+    const unsigned y = m_id / X;
+    unsigned dest = m_id;
+
+    switch(m_params.pattern) {
+	case TP_HOTSPOT:
+	    if((int)m_id != m_params.hotspot && rand01() < m_params.hotspot_fraction) {
+		dest = m_params.hotspot;
+		break;
+	    }
+	    //fall through
+	case TP_UNIFORM:
+	    dest = (unsigned)(rand01() * (m_nodes - 1));
+	    if(dest >= m_id)
+		dest++; //skip the source
+	    break;
+	case TP_TRANSPOSE:
+	    dest = x * X + y;
+	    break;
+	case TP_BIT_COMPLEMENT:
+	    dest = ~m_id & (m_nodes - 1);
+	    break;
+	case TP_TORNADO:
+	    dest = ((y + (Y + 1) / 2 - 1) % Y) * X + (x + (X + 1) / 2 - 1) % X;
+	    break;
+	case TP_NEIGHBOR:
+	    dest = y * X + (x + 1) % X;
+	    break;
+    }
+    assert(dest < m_nodes);
+    return dest == m_id ? -1 : (int)dest;
+}
+
+
+bool TrafficGenerator::inject_this_cycle()
+{
+    if(m_params.injection == INJ_BERNOULLI)
+	return rand01() < m_rate;
+
+    //bursty: with off->on probability a and on->off probability b, the process is on
+    //a/(a+b) of the time, which is made equal to the rate.
+    if(m_rate >= 1)
+	return true;
+    const double b = 1.0 / m_params.burst_len;
+    const double a = m_rate * b / (1 - m_rate);
+    if(m_burst_on) {
+	if(rand01() < b)
+	    m_burst_on = false;
+    }
+    else if(rand01() < a)
+	m_burst_on = true;
+    return m_burst_on;
+}
+
+
+void TrafficGenerator::tick()
+{
+    if(inject_this_cycle()) {
+	int dest = get_dest();
+	if(dest >= 0) {
+	    Synthetic_pkt* pkt = new Synthetic_pkt;
+	    pkt->type = 0;
+	    pkt->src = m_id;
+	    pkt->dst = dest;
+	    pkt->size = (m_params.long_pkt_fraction > 0 && rand01() < m_params.long_pkt_fraction) ?
+	                m_params.long_pkt_size : m_params.pkt_size;
+	    pkt->created = Manifold::NowTicks();
+	    m_src_queue.push_back(pkt);
+	    stat_packets_generated++;
+	    if(m_src_queue.size() > stat_max_src_queue_length)
+		stat_max_src_queue_length = m_src_queue.size();
+	}
+    }
+
+    if(!m_src_queue.empty() && (m_params.ni_credit_type < 0 || m_ni_credits > 0)) {
+	Send(PORT_NI, m_src_queue.front());
+	m_src_queue.pop_front();
+	stat_packets_sent++;
+	if(m_params.ni_credit_type >= 0)
+	    m_ni_credits--;
+    }
+}
+
+
+void TrafficGenerator::handle_incoming(int, Synthetic_pkt* pkt)
+{
+    if(m_params.ni_credit_type >= 0 && pkt->type == m_params.ni_credit_type) {
+	m_ni_credits++;
+	assert(m_ni_credits <= m_params.ni_credits);
+	delete pkt;
+	return;
+    }
+
+    assert(pkt->dst == (int)m_id);
+    Ticks_t latency = Manifold::NowTicks() - pkt->created;
+    stat_packets_received++;
+    stat_bytes_received += pkt->size;
+    stat_total_latency += latency;
+    if(latency > stat_max_latency)
+	stat_max_latency = latency;
+
+    if(m_params.ni_credit_type >= 0) {
+	//the interface needs a credit for its output buffer; reuse the packet
+	pkt->type = m_params.ni_credit_type;
+	Send(PORT_NI, pkt);
+    }
+    else
+	delete pkt;
+}
+
+
+void TrafficGenerator::print_stats(ostream& out)
+{
+    out << "Traffic generator " << m_id << ":\n";
+    out << "  Packets generated: " << stat_packets_generated << "\n";
+    out << "  Packets sent: " << stat_packets_sent << "\n";
+    out << "  Packets received: " << stat_packets_received << "\n";
+    out << "  Bytes received: " << stat_bytes_received << "\n";
+    out << "  Avg latency: " << (stat_packets_received ? (double)stat_total_latency / stat_packets_received : 0) << "\n";
+    out << "  Max latency: " << stat_max_latency << "\n";
+    out << "  Max source queue length: " << stat_max_src_queue_length << "\n";
+}
+
+
+} // namespace iris
+} // namespace manifold
@@ -0,0 +1,162 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  trafficGenerator.h
+ *
+ *    Description:  A network terminal that generates synthetic traffic, for
+ *    evaluating a network without processor or memory models. It can be connected
+ *    to GenNetworkInterface (ring, torus) and to GenOneVcIrisInterface (crossbar).
+ *
+ * =====================================================================================
+ */
+
+#ifndef  MANIFOLD_IRIS_TRAFFICGENERATOR_H
+#define  MANIFOLD_IRIS_TRAFFICGENERATOR_H
+
+#include	"../data_types/flit.h"
+#include	"../interfaces/simulatedLen.h"
+#include	"../interfaces/vnetAssign.h"
+#include	"kernel/component.h"
+#include	<list>
+#include	<stdlib.h>
+#include	<iostream>
+#include	<stdint.h>
+
+namespace manifold {
+namespace iris {
+
+//! The packet sent between traffic generators. It has no pointers, so it can be
+//! sent through either network interface, and across LPs.
+struct Synthetic_pkt {
+    int type;
+    int src;
+    int dst;
+    int size; //simulated size in bytes
+    manifold::kernel::Ticks_t created; //when the packet was generated
+
+    int get_type() { return type; }
+    void set_type(int t) { type = t; }
+    int get_src() { return src; }
+    int get_dst() { return dst; }
+    int get_src_port() { return 0; }
+    int get_dst_port() { return 0; }
+    void set_dst_port(int) {}
+};
+
+//! For GenNetworkInterface; see Get_term_type() there.
+inline term_type Get_term_type(Synthetic_pkt*) { return CACHE; }
+inline uint64_t Get_term_addr(Synthetic_pkt*) { return 0; }
+
+
+//! Simulated length of a Synthetic_pkt; used by GenNetworkInterface.
+//! GenOneVcIrisInterface always sends sizeof(Synthetic_pkt) bytes.
+class Synthetic_simLen : public SimulatedLen<Synthetic_pkt> {
+public:
+    int get_simulated_len(Synthetic_pkt* pkt) { return pkt->size; }
+};
+
+//! All synthetic packets are in virtual network 0.
+class Synthetic_vnet : public VnetAssign<Synthetic_pkt> {
+public:
+    int get_virtual_net(Synthetic_pkt*) { return 0; }
+};
+
+
+//! Destination patterns. The terminals are laid out as an x_dim by y_dim grid, with
+//! id = y * x_dim + x, independent of the network topology. For the permutations,
+//! a terminal whose destination is itself does not send.
+enum traffic_pattern_t {
+    TP_UNIFORM = 0,    //uniformly random, excluding the source
+    TP_TRANSPOSE,      //(x,y) -> (y,x); x_dim must equal y_dim
+    TP_BIT_COMPLEMENT, //id -> ~id; the number of terminals must be a power of 2
+    TP_HOTSPOT,        //hotspot with probability hotspot_fraction, otherwise uniform
+    TP_TORNADO,        //(x,y) -> (x + ceil(x_dim/2) - 1, y + ceil(y_dim/2) - 1), mod the dims
+    TP_NEIGHBOR        //(x,y) -> (x + 1 mod x_dim, y)
+};
+
+//! How packets are injected.
+//! INJ_BERNOULLI: a packet is generated each cycle with probability rate.
+//! INJ_BURSTY: a two-state Markov process; in the on state a packet is generated
+//! every cycle. Bursts are burst_len cycles long on average and the average rate
+//! is rate.
+enum injection_t {
+    INJ_BERNOULLI = 0,
+    INJ_BURSTY
+};
+
+
+struct traffic_gen_init_params {
+    traffic_gen_init_params() : pattern(TP_UNIFORM), x_dim(0), y_dim(1), hotspot(0), hotspot_fraction(0.1),
+                                injection(INJ_BERNOULLI), rate(0.01), burst_len(8),
+                                pkt_size(8), long_pkt_size(72), long_pkt_fraction(0),
+                                ni_credit_type(-1), ni_credits(4), seed(1) {}
+    traffic_pattern_t pattern;
+    unsigned x_dim;
+    unsigned y_dim;
+    int hotspot; //terminal id of the hotspot
+    double hotspot_fraction;
+    injection_t injection;
+    double rate; //packets per terminal per cycle
+    double burst_len; //average cycles in the on state
+    int pkt_size; //bytes
+    int long_pkt_size; //bytes
+    double long_pkt_fraction; //fraction of packets that are long
+    int ni_credit_type; //credit type of GenNetworkInterface; -1 if the interface doesn't use credits
+    int ni_credits; //packets the terminal may have in the interface's input buffer
+    unsigned seed;
+};
+
+
+//! Generates packets to the destinations of a pattern and consumes the packets it
+//! receives. Packets wait in an unbounded source queue until the network interface
+//! can take them, so the latency, from generation to delivery, includes the
+//! source queueing time, as in an open-loop measurement.
+class TrafficGenerator : public manifold::kernel::Component {
+public:
+    enum {PORT_NI = 0};
+
+    TrafficGenerator(unsigned id, const traffic_gen_init_params* params);
+
+    void tick();
+    void handle_incoming(int, Synthetic_pkt*);
+
+    //! Change the injection rate; for sweeping the rate within a simulation.
+    void set_rate(double rate);
+
+    //! Start a new measurement window: clear the stats.
+    void reset_stats();
+
+    void print_stats(std::ostream&);
+
+    //stats
+    uint64_t stat_packets_generated;
+    uint64_t stat_packets_sent; //to the network interface
+    uint64_t stat_packets_received;
+    uint64_t stat_bytes_received;
+    uint64_t stat_total_latency; //of the received packets
+    manifold::kernel::Ticks_t stat_max_latency;
+    unsigned stat_max_src_queue_length;
+
+#ifndef IRIS_TEST
+private:
+#endif
+    //! Destination of the next packet; -1 if the pattern maps this terminal to itself.
+    int get_dest();
+    bool inject_this_cycle();
+    double rand01() { return erand48(m_xsubi); }
+
+    const unsigned m_id;
+    const unsigned m_nodes;
+    const traffic_gen_init_params m_params;
+    double m_rate;
+    bool m_burst_on; //state of the bursty injection process
+    int m_ni_credits;
+    std::list<Synthetic_pkt*> m_src_queue;
+    unsigned short m_xsubi[3]; //random number state
+};
+
+
+} // namespace iris
+} // namespace manifold
+
+#endif   /* ----- #ifndef MANIFOLD_IRIS_TRAFFICGENERATOR_H ----- */
@@ -0,0 +1,82 @@
+/*
+ * =====================================================================================
+ *
+ *       Filename:  ringBuffer.h
+ *
+ *    Description:  A FIFO stored in a power-of-two array. Unlike std::list, pushing
+ *    and popping don't allocate; the array only grows (doubles) when a push finds
+ *    it full, so a buffer whose occupancy is bounded stops allocating once it has
+ *    reached that bound.
+ *
+ * =====================================================================================
+ */
+
+#ifndef  MANIFOLD_IRIS_RINGBUFFER_H
+#define  MANIFOLD_IRIS_RINGBUFFER_H
+
+#include	<vector>
+#include	<assert.h>
+
+namespace manifold {
+namespace iris {
+
+template<typename T>
+class RingBuffer {
+public:
+    //! @param \c capacity  Initial capacity; rounded up to a power of 2.
+    explicit RingBuffer(unsigned capacity = 16) : m_head(0), m_size(0)
+    {
+        unsigned cap = 1;
+	while(cap < capacity)
+	    cap <<= 1;
+	m_buf.resize(cap);
+	m_mask = cap - 1;
+    }
+
+    bool empty() const { return m_size == 0; }
+    unsigned size() const { return m_size; }
+    unsigned capacity() const { return m_mask + 1; }
+
+    T& front() { assert(m_size > 0); return m_buf[m_head]; }
+    const T& front() const { assert(m_size > 0); return m_buf[m_head]; }
+
+    void push_back(const T& x)
+    {
+        if(m_size == capacity())
+	    grow();
+	m_buf[(m_head + m_size) & m_mask] = x;
+	m_size++;
+    }
+
+    void pop_front()
+    {
+        assert(m_size > 0);
+	m_head = (m_head + 1) & m_mask;
+	m_size--;
+    }
+
+    void clear() { m_head = 0; m_size = 0; }
+
+private:
+    //! Double the capacity; the elements are moved to the start of the new array.
+    void grow()
+    {
+        std::vector<T> nbuf(2 * capacity());
+	for(unsigned i=0; i<m_size; i++)
+	    nbuf[i] = m_buf[(m_head + i) & m_mask];
+	m_buf.swap(nbuf);
+	m_head = 0;
+	m_mask = m_buf.size() - 1;
+    }
+
+    std::vector<T> m_buf;
+    unsigned m_head; //index of the front element
+    unsigned m_size;
+    unsigned m_mask; //capacity - 1
+};
+
+
+} // namespace iris
+} // namespace manifold
+
+#endif   /* ----- #ifndef MANIFOLD_IRIS_RINGBUFFER_H ----- */
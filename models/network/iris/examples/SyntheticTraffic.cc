@@ -0,0 +1,380 @@
+//! Open-loop characterization of a network with synthetic traffic.
+//!
+//! The injection rate is swept upward in phases within one simulation. Each phase
+//! has a warmup period followed by a measurement period; for each phase the offered
+//! and accepted throughput and the packet latency are printed. The sweep ends after
+//! the network saturates, i.e., when the average latency exceeds 3 times the
+//! zero-load latency (that of the first phase), or the accepted throughput falls
+//! below 90% of the offered.
+//!
+//! Usage:
+//!   SyntheticTraffic <topology> <pattern> [key=value ...]
+//!     topology: ring:<nodes> | torus:<x>x<y> | mesh:<x>x<y> | cmesh:<x>x<y>:<c> | crossbar:<nodes>
+//!     pattern:  uniform | transpose | bitcomp | hotspot | tornado | neighbor
+//!   keys:
+//!     rates=r1,r2,...     packets/node/cycle; default 0.005,0.01,0.02,...,0.5
+//!     inj=bernoulli|bursty
+//!     burst=<cycles>      average burst length for bursty injection
+//!     size=<bytes>        packet size
+//!     long=<bytes>        size of long packets
+//!     long_frac=<f>       fraction of long packets
+//!     hotspot=<id>        hotspot terminal
+//!     hot_frac=<f>        fraction of packets to the hotspot
+//!     warmup=<cycles>     per phase; default 2000
+//!     measure=<cycles>    per phase; default 10000
+//!     vcs=<n> credits=<n> link_width=<bits>
+//!     routing=xy|yx|o1turn|westfirst|oddeven   mesh routing; default xy
+//!     bypass=0|1          let head flits skip VC and switch allocation at idle routers
+//!     express=<hops>      ring and torus: add express links of the given length
+//! cmesh is a mesh of x by y routers with c terminals per router.
+//! For the pattern, terminals are laid out as x by y for a torus or mesh; for a ring,
+//! cmesh or crossbar of n terminals, x is the largest divisor of n not larger than sqrt(n).
+//! Packet sizes have no effect on the crossbar, whose interface sends packets
+//! as they are.
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "iris/genericTopology/genericTopoCreator.h"
+#include "iris/components/trafficGenerator.h"
+#include "kernel/manifold.h"
+#include "kernel/component.h"
+
+using namespace std;
+using namespace manifold::kernel;
+using namespace manifold::iris;
+
+
+const int MASTER_CLOCK_HZ = 1000000000;
+Clock MasterClock(MASTER_CLOCK_HZ);
+
+const int NI_CREDIT_TYPE = 123; //msg type for network interface upstream credits.
+
+
+//! Switches the injection rate of the generators from phase to phase and prints
+//! the results of each phase.
+class Sweeper : public Component {
+public:
+    Sweeper(vector<TrafficGenerator*>* gens, vector<double>* rates, Ticks_t warmup, Ticks_t measure) :
+        m_gens(*gens), m_rates(*rates), m_WARMUP(warmup), m_MEASURE(measure),
+	m_phase(0), m_cycle(0), m_done(false), m_zero_load_latency(0), m_saturation(-1), m_max_accepted(0)
+    {
+	set_rate(m_rates[0]);
+	printf("%10s %10s %10s %10s %10s\n", "offered", "accepted", "avg_lat", "max_lat", "max_srcq");
+    }
+
+    void tick()
+    {
+	if(m_done)
+	    return;
+	m_cycle++;
+	if(m_cycle == m_WARMUP) {
+	    for(unsigned i=0; i<m_gens.size(); i++)
+		m_gens[i]->reset_stats();
+	}
+	else if(m_cycle == m_WARMUP + m_MEASURE) {
+	    bool saturated = end_phase();
+	    m_phase++;
+	    m_cycle = 0;
+	    if(saturated || m_phase == m_rates.size()) {
+		print_summary();
+		m_done = true;
+		Manifold::StopAt(Manifold::NowTicks() + 1);
+	    }
+	    else
+		set_rate(m_rates[m_phase]);
+	}
+    }
+
+private:
+    void set_rate(double r)
+    {
+	for(unsigned i=0; i<m_gens.size(); i++)
+	    m_gens[i]->set_rate(r);
+    }
+
+    //! Print the results of a phase; returns true if the network is saturated.
+    bool end_phase()
+    {
+	uint64_t generated = 0, received = 0, latency = 0;
+	Ticks_t max_latency = 0;
+	unsigned max_srcq = 0;
+	for(unsigned i=0; i<m_gens.size(); i++) {
+	    TrafficGenerator* g = m_gens[i];
+	    generated += g->stat_packets_generated;
+	    received += g->stat_packets_received;
+	    latency += g->stat_total_latency;
+	    if(g->stat_max_latency > max_latency)
+		max_latency = g->stat_max_latency;
+	    if(g->stat_max_src_queue_length > max_srcq)
+		max_srcq = g->stat_max_src_queue_length;
+	}
+	const double norm = (double)m_gens.size() * m_MEASURE;
+	const double offered = generated / norm;
+	const double accepted = received / norm;
+	const double avg_latency = received ? (double)latency / received : 0;
+	printf("%10.4f %10.4f %10.1f %10lu %10u\n", offered, accepted, avg_latency,
+	       (unsigned long)max_latency, max_srcq);
+
+	if(accepted > m_max_accepted)
+	    m_max_accepted = accepted;
+	if(m_phase == 0)
+	    m_zero_load_latency = avg_latency;
+	else if(avg_latency > 3 * m_zero_load_latency || accepted < 0.9 * offered) {
+	    m_saturation = m_rates[m_phase];
+	    return true;
+	}
+	return false;
+    }
+
+    void print_summary()
+    {
+	printf("zero-load latency: %.1f\n", m_zero_load_latency);
+	if(m_saturation >= 0)
+	    printf("saturation: offered %g, max accepted %.4f packets/node/cycle\n", m_saturation, m_max_accepted);
+	else
+	    printf("not saturated up to %g packets/node/cycle\n", m_rates.back());
+    }
+
+    vector<TrafficGenerator*>& m_gens;
+    vector<double>& m_rates;
+    const Ticks_t m_WARMUP;
+    const Ticks_t m_MEASURE;
+    unsigned m_phase;
+    Ticks_t m_cycle;
+    bool m_done;
+    double m_zero_load_latency;
+    double m_saturation; //offered rate at which the network saturated; -1 if it didn't
+    double m_max_accepted;
+};
+
+
+
+static void usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " <ring:N|torus:XxY|mesh:XxY|cmesh:XxY:C|crossbar:N> <uniform|transpose|bitcomp|hotspot|tornado|neighbor> [key=value ...]" << endl
+         << "   keys: rates=r1,r2,... inj=bernoulli|bursty burst= size= long= long_frac= hotspot= hot_frac=" << endl
+         << "         warmup= measure= vcs= credits= link_width= routing=xy|yx|o1turn|westfirst|oddeven" << endl
+         << "         bypass=0|1 express=<hops>" << endl;
+    exit(1);
+}
+
+
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+	usage(argv[0]);
+
+    //topology
+    string topo = argv[1];
+    string kind = topo.substr(0, topo.find(':'));
+    unsigned x_dim = 0, y_dim = 0;
+    unsigned router_x = 0, router_y = 0, concentration = 1; //mesh and cmesh
+    if(topo.find(':') == string::npos)
+	usage(argv[0]);
+    const char* dims = topo.c_str() + topo.find(':') + 1;
+    if(kind == "torus" || kind == "mesh") {
+	if(sscanf(dims, "%ux%u", &x_dim, &y_dim) != 2)
+	    usage(argv[0]);
+	router_x = x_dim;
+	router_y = y_dim;
+    }
+    else if(kind == "ring" || kind == "crossbar" || kind == "cmesh") {
+	unsigned n = 0;
+	if(kind == "cmesh") {
+	    if(sscanf(dims, "%ux%u:%u", &router_x, &router_y, &concentration) != 3 || concentration < 1)
+		usage(argv[0]);
+	    n = router_x * router_y * concentration;
+	}
+	else
+	    n = atoi(dims);
+	for(x_dim = 1; (x_dim + 1) * (x_dim + 1) <= n; x_dim++);
+	while(n % x_dim != 0)
+	    x_dim--;
+	y_dim = n / x_dim;
+    }
+    else
+	usage(argv[0]);
+    const unsigned NODES = x_dim * y_dim;
+    if(NODES < 2) {
+	cerr << "Need at least 2 nodes." << endl;
+	exit(1);
+    }
+
+    traffic_gen_init_params tp;
+    tp.x_dim = x_dim;
+    tp.y_dim = y_dim;
+
+    string pattern = argv[2];
+    if(pattern == "uniform") tp.pattern = TP_UNIFORM;
+    else if(pattern == "transpose") tp.pattern = TP_TRANSPOSE;
+    else if(pattern == "bitcomp") tp.pattern = TP_BIT_COMPLEMENT;
+    else if(pattern == "hotspot") tp.pattern = TP_HOTSPOT;
+    else if(pattern == "tornado") tp.pattern = TP_TORNADO;
+    else if(pattern == "neighbor") tp.pattern = TP_NEIGHBOR;
+    else usage(argv[0]);
+
+    vector<double> rates;
+    Ticks_t warmup = 2000;
+    Ticks_t measure = 10000;
+    unsigned vcs = 4;
+    unsigned credits = 5;
+    unsigned link_width = 128;
+    ROUTING_SCHEME mesh_routing = XY;
+    bool bypass = false;
+    unsigned express_hops = 0;
+
+    for(int i=3; i<argc; i++) {
+	string arg = argv[i];
+	size_t eq = arg.find('=');
+	if(eq == string::npos)
+	    usage(argv[0]);
+	string key = arg.substr(0, eq);
+	string val = arg.substr(eq + 1);
+	if(key == "rates") {
+	    istringstream in(val);
+	    string r;
+	    while(getline(in, r, ','))
+		rates.push_back(atof(r.c_str()));
+	}
+	else if(key == "inj") {
+	    if(val == "bernoulli") tp.injection = INJ_BERNOULLI;
+	    else if(val == "bursty") tp.injection = INJ_BURSTY;
+	    else usage(argv[0]);
+	}
+	else if(key == "burst") tp.burst_len = atof(val.c_str());
+	else if(key == "size") tp.pkt_size = atoi(val.c_str());
+	else if(key == "long") tp.long_pkt_size = atoi(val.c_str());
+	else if(key == "long_frac") tp.long_pkt_fraction = atof(val.c_str());
+	else if(key == "hotspot") tp.hotspot = atoi(val.c_str());
+	else if(key == "hot_frac") tp.hotspot_fraction = atof(val.c_str());
+	else if(key == "warmup") warmup = strtoul(val.c_str(), 0, 0);
+	else if(key == "measure") measure = strtoul(val.c_str(), 0, 0);
+	else if(key == "vcs") vcs = atoi(val.c_str());
+	else if(key == "credits") credits = atoi(val.c_str());
+	else if(key == "link_width") link_width = atoi(val.c_str());
+	else if(key == "routing") {
+	    if(val == "xy") mesh_routing = XY;
+	    else if(val == "yx") mesh_routing = YX;
+	    else if(val == "o1turn") mesh_routing = O1TURN;
+	    else if(val == "westfirst") mesh_routing = WEST_FIRST;
+	    else if(val == "oddeven") mesh_routing = ODD_EVEN;
+	    else usage(argv[0]);
+	}
+	else if(key == "bypass") bypass = (atoi(val.c_str()) != 0);
+	else if(key == "express") express_hops = atoi(val.c_str());
+	else usage(argv[0]);
+    }
+    if(rates.empty()) {
+	const double DEFAULT_RATES[] = { 0.005, 0.01, 0.02, 0.03, 0.05, 0.07, 0.1, 0.15, 0.2, 0.3, 0.4, 0.5 };
+	rates.assign(DEFAULT_RATES, DEFAULT_RATES + sizeof(DEFAULT_RATES)/sizeof(DEFAULT_RATES[0]));
+    }
+    if(warmup < 1 || measure < 1)
+	usage(argv[0]);
+
+
+    Manifold :: Init(argc, argv);
+
+    Simple_terminal_to_net_mapping* mapping = new Simple_terminal_to_net_mapping();
+    Synthetic_simLen* simLen = new Synthetic_simLen();
+    Synthetic_vnet* vnet = new Synthetic_vnet();
+
+    //create the network; the crossbar's interface doesn't use credits with the terminals
+    vector<CompId_t> inf_ids;
+    int from_terminal_port, to_terminal_port;
+    if(kind == "ring") {
+	ring_init_params rp;
+	rp.no_nodes = NODES;
+	rp.no_vcs = vcs;
+	rp.credits = credits;
+	rp.rc_method = RING_ROUTING;
+	rp.link_width = link_width;
+	rp.ni_up_credits = 10;
+	rp.ni_upstream_buffer_size = 5;
+	rp.express_hops = express_hops;
+	rp.bypass = bypass;
+	Ring<Synthetic_pkt>* ring = topoCreator<Synthetic_pkt>::create_ring(MasterClock, &rp, mapping, simLen, vnet, NI_CREDIT_TYPE, 0, 0);
+	inf_ids = ring->get_interface_id();
+	from_terminal_port = to_terminal_port = GenNetworkInterface<Synthetic_pkt>::TERMINAL_PORT;
+	tp.ni_credit_type = NI_CREDIT_TYPE;
+    }
+    else if(kind == "torus") {
+	torus_init_params tip;
+	tip.x_dim = x_dim;
+	tip.y_dim = y_dim;
+	tip.no_vcs = vcs;
+	tip.credits = credits;
+	tip.link_width = link_width;
+	tip.ni_up_credits = 10;
+	tip.ni_upstream_buffer_size = 5;
+	tip.express_hops = express_hops;
+	tip.bypass = bypass;
+	vector<int> node_lp(NODES, 0);
+	Torus<Synthetic_pkt>* torus = topoCreator<Synthetic_pkt>::create_torus(MasterClock, &tip, mapping, simLen, vnet, NI_CREDIT_TYPE, &node_lp);
+	inf_ids = torus->get_interface_id();
+	from_terminal_port = to_terminal_port = GenNetworkInterface<Synthetic_pkt>::TERMINAL_PORT;
+	tp.ni_credit_type = NI_CREDIT_TYPE;
+    }
+    else if(kind == "mesh" || kind == "cmesh") {
+	mesh_init_params mip;
+	mip.x_dim = router_x;
+	mip.y_dim = router_y;
+	mip.concentration = concentration;
+	mip.no_vcs = vcs;
+	mip.credits = credits;
+	mip.link_width = link_width;
+	mip.ni_up_credits = 10;
+	mip.ni_upstream_buffer_size = 5;
+	mip.rc_method = mesh_routing;
+	mip.bypass = bypass;
+	vector<int> node_lp(router_x * router_y, 0);
+	Mesh<Synthetic_pkt>* mesh = topoCreator<Synthetic_pkt>::create_mesh(MasterClock, &mip, mapping, simLen, vnet, NI_CREDIT_TYPE, &node_lp);
+	inf_ids = mesh->get_interface_id();
+	from_terminal_port = to_terminal_port = GenNetworkInterface<Synthetic_pkt>::TERMINAL_PORT;
+	tp.ni_credit_type = NI_CREDIT_TYPE;
+    }
+    else {
+	CrossBar_init_params cp;
+	cp.no_nodes = NODES;
+	cp.credits = credits;
+	cp.link_width = link_width;
+	CrossBar<Synthetic_pkt>* cb = topoCreator<Synthetic_pkt>::create_CrossBar(MasterClock, &cp, mapping, simLen, 0, 0);
+	inf_ids = cb->get_interface_id();
+	from_terminal_port = GenOneVcIrisInterface<Synthetic_pkt>::DATAFROMTERMINAL;
+	to_terminal_port = GenOneVcIrisInterface<Synthetic_pkt>::DATATOTERMINAL;
+	tp.ni_credit_type = -1;
+    }
+
+    //create the traffic generators
+    vector<TrafficGenerator*> gens(NODES);
+    const Ticks_t LATENCY = 1;
+    for(unsigned i=0; i<NODES; i++) {
+	CompId_t gid = Component :: Create<TrafficGenerator>(0, i, &tp);
+	gens[i] = Component :: GetComponent<TrafficGenerator>(gid);
+	Clock::Register(MasterClock, gens[i], &TrafficGenerator::tick, (void (TrafficGenerator::*)()) 0);
+
+	if(kind == "crossbar")
+	    Manifold::Connect(gid, TrafficGenerator::PORT_NI, inf_ids[i], from_terminal_port,
+			      &GenOneVcIrisInterface<Synthetic_pkt>::handle_new_packet_event, LATENCY);
+	else
+	    Manifold::Connect(gid, TrafficGenerator::PORT_NI, inf_ids[i], from_terminal_port,
+			      &GenNetworkInterface<Synthetic_pkt>::handle_new_packet_event, LATENCY);
+	Manifold::Connect(inf_ids[i], to_terminal_port, gid, TrafficGenerator::PORT_NI,
+			  &TrafficGenerator::handle_incoming, LATENCY);
+    }
+
+    cout << kind << " " << x_dim << "x" << y_dim << ", " << pattern << ", "
+         << (tp.injection == INJ_BURSTY ? "bursty" : "bernoulli") << " injection" << endl;
+    CompId_t sid = Component :: Create<Sweeper>(0, &gens, &rates, warmup, measure);
+    Clock::Register(MasterClock, Component :: GetComponent<Sweeper>(sid), &Sweeper::tick, (void (Sweeper::*)()) 0);
+
+    Manifold::StopAt((warmup + measure) * rates.size() + 1);
+    Manifold::Run();
+
+    Manifold :: Finalize();
+
+    return 0;
+}
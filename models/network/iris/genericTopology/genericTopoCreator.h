@@ -18,6 +18,7 @@
 #include "ring.h"
 #include "torus.h"
 #include "torus6p.h"
+#include "mesh.h"
 #include "CrossBar.h"
 
 /* *********** the class topology creator start here ************ */
@@ -36,6 +37,7 @@ public:
     static Ring<T>* create_ring(manifold::kernel::Clock& clk, ring_init_params* params, const Terminal_to_net_mapping*, SimulatedLen<T>*, VnetAssign<T>*, int ni_credit_type, uint lp_inf, uint lp_rt);
     static Torus<T>* create_torus(manifold::kernel::Clock& clk, torus_init_params* params, const Terminal_to_net_mapping*, SimulatedLen<T>*, VnetAssign<T>*, int ni_credit_type, vector<int>* node_lp);
     static Torus6p<T>* create_torus6p(manifold::kernel::Clock& clk, torus6p_init_params* params, const Terminal_to_net_mapping*, SimulatedLen<T>*, VnetAssign<T>*, int ni_credit_type, vector<int>* node_lp);  
+    static Mesh<T>* create_mesh(manifold::kernel::Clock& clk, mesh_init_params* params, const Terminal_to_net_mapping*, SimulatedLen<T>*, VnetAssign<T>*, int ni_credit_type, vector<int>* node_lp);
     static CrossBar<T>* create_CrossBar(manifold::kernel::Clock& clk, const CrossBar_init_params* params, const Terminal_to_net_mapping*, SimulatedLen<T>*, uint lp_inf, uint lp_rt);    
  
 #ifndef IRIS_TEST
@@ -104,6 +106,17 @@ Torus6p<T>* topoCreator<T>::create_torus6p(manifold::kernel::Clock& clk, torus6p
     return tp;  
 }
 
+//! response for creating the mesh or concentrated mesh topology
+//! @param \c clk  The clock passing from callor
+//! @param \c params  The configure parameters for mesh network
+//! @param \c ni_credit_type  The message type for network interface's credits to terminal.
+//! @param \c node_lp  LP assignment of each router.
+template<typename T>
+Mesh<T>* topoCreator<T>::create_mesh(manifold::kernel::Clock& clk, mesh_init_params* params, const Terminal_to_net_mapping* mapping, SimulatedLen<T>* simLen, VnetAssign<T>* vn, int ni_credit_type, vector<int>* node_lp)
+{
+    return new manifold::iris::Mesh<T>(clk, params, mapping, simLen, vn, ni_credit_type, node_lp);
+}
+
 //! response for creating the Cross-Bar topology 
 //! @param \c clk  The clock passing from callor
 //! @param \c params  The configure parameters for Cross-Bar network
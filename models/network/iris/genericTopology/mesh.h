@@ -0,0 +1,267 @@
+/*
+ * =====================================================================================
+ *    Description:  2-D mesh and concentrated mesh (CMesh). With concentration C, each
+ *    router has C terminals: network address a is on router a/C; local terminal 0
+ *    is connected to PORT_NI and local terminal k>0 to PORT_MC+k-1.
+ *
+ * =====================================================================================
+ */
+
+#ifndef  MANIFOLD_IRIS_MESH_H
+#define  MANIFOLD_IRIS_MESH_H
+
+#include "../interfaces/genericIrisInterface.h"
+#include "../components/simpleRouter.h"
+
+namespace manifold {
+namespace iris {
+
+struct mesh_init_params {
+    mesh_init_params() : x_dim(0), y_dim(0), concentration(1), no_vcs(0), credits(0), link_width(0), ni_up_credits(0),
+                         ni_upstream_buffer_size(0), rc_method(XY), bypass(false) {}
+
+    uint x_dim;
+    uint y_dim;
+    uint concentration; //no. of terminals per router; > 1 for a concentrated mesh
+    uint no_vcs;
+    uint credits;
+    uint link_width; //in bits.
+    unsigned ni_up_credits; //network interface credits for output to terminal.
+    int ni_upstream_buffer_size; //network interface's output buffer (to terminal) size
+    ROUTING_SCHEME rc_method; //XY, YX, O1TURN, WEST_FIRST, or ODD_EVEN
+    bool bypass; //let head flits skip VC and switch allocation at idle routers
+};
+
+
+
+template <typename T>
+class Mesh
+{
+    public:
+	//! @param \c node_lp   router idx to LP mapping
+        Mesh (manifold::kernel::Clock& clk, mesh_init_params* params, const Terminal_to_net_mapping* mapping, SimulatedLen<T>*, VnetAssign<T>*, int ni_credit_type, vector<int>* node_lp);
+        ~Mesh ();
+
+        //connect all components together
+        void connect_interface_routers(void);
+        void connect_routers(void);
+
+	const std::vector <GenNetworkInterface<T>*>& get_interfaces() { return interfaces; }
+	const std::vector <SimpleRouter*>& get_routers() {return routers; }
+
+        //the interfaces' component id
+        const std::vector <manifold::kernel::CompId_t>& get_interface_id() { return interface_ids; }
+
+ 	//the routers' component id
+	const std::vector <manifold::kernel::CompId_t>& get_router_id() { return router_ids; }
+	void print_stats(std::ostream&);
+
+#ifndef IRIS_TEST
+    private:
+#endif
+       //connect two neighboring routers; port1 of r1 faces port2 of r2.
+       void connect_router_pair(uint r1, uint port1, uint r2, uint port2);
+
+       const unsigned x_dim; // x dimension
+       const unsigned y_dim; // y dimension
+       const unsigned concentration; // terminals per router
+       manifold::kernel::Clock& clk_t; //the clock for routers and interfaces
+       std::vector <SimpleRouter*> routers; //the routers
+       std::vector <GenNetworkInterface<T>* > interfaces; //the interfaces
+       std::vector <manifold::kernel::CompId_t> router_ids; //the routers' component ID
+       std::vector <manifold::kernel::CompId_t> interface_ids; //the interfaces' component ID
+
+       //the node to lp map
+       vector<int>* node_lp;
+};
+
+//! @param \c clk  The clock passing from callor
+//! @param \c params  The configure parameters for mesh network
+//! @param \c ni_credit_type  The message type for network interface's credits to terminal.
+//! @param \c node_lp  LP assignment of each router; a router's interfaces are in the same LP.
+template <typename T>
+Mesh<T>::Mesh(manifold::kernel::Clock& clk, mesh_init_params* params, const Terminal_to_net_mapping* mapping, SimulatedLen<T>* slen, VnetAssign<T>* vn, int ni_credit_type, vector<int>* node_lp) :
+    x_dim(params->x_dim),
+    y_dim(params->y_dim),
+    concentration(params->concentration),
+    clk_t(clk),
+    node_lp(node_lp)
+{
+    assert(params->ni_up_credits > 0);
+    assert(ni_credit_type != 0);
+    assert(params->ni_upstream_buffer_size > 0);
+    assert(concentration > 0);
+    assert(params->rc_method == XY || params->rc_method == YX || params->rc_method == O1TURN ||
+           params->rc_method == WEST_FIRST || params->rc_method == ODD_EVEN);
+
+    //parameters for interface
+    inf_init_params i_p_inf;
+
+    i_p_inf.linkWidth = params->link_width;
+    i_p_inf.num_credits = params->credits;
+    i_p_inf.upstream_credits = params->ni_up_credits;
+    i_p_inf.up_credit_msg_type = ni_credit_type;
+    i_p_inf.num_vc = params->no_vcs;
+    i_p_inf.upstream_buffer_size = params->ni_upstream_buffer_size;
+
+
+    //parameters for router
+    router_init_params i_p_rt;
+
+    i_p_rt.no_nodes = params->x_dim * params->y_dim;
+    i_p_rt.grid_size = params->x_dim;
+    i_p_rt.no_ports = 4 + concentration;
+    i_p_rt.no_vcs = params->no_vcs;
+    i_p_rt.credits = params->credits;
+    i_p_rt.rc_method = params->rc_method;
+    i_p_rt.concentration = concentration;
+    i_p_rt.bypass = params->bypass;
+
+    NIInit<T> niInit(mapping, slen, vn);
+
+    const unsigned no_nodes = x_dim * y_dim;
+    //check if the size of node_lp is equal to no_nodes
+    if (node_lp->size() != no_nodes)
+    {
+        cout<<"Bad node to lp mapping!!"<<endl;
+	exit(1);
+    }
+
+    //creat interfaces and routers
+    for ( uint i=0; i< node_lp->size(); i++)
+    {
+        for ( uint j=0; j< concentration; j++)
+	    interface_ids.push_back( manifold::kernel::Component::Create< GenNetworkInterface<T> >(node_lp->at(i), i * concentration + j, niInit, &i_p_inf) );
+        router_ids.push_back( manifold::kernel::Component::Create<SimpleRouter>(node_lp->at(i), i, &i_p_rt) );
+    }
+
+    //register interfaces to clock
+    for ( uint i=0; i< interface_ids.size(); i++)
+    {
+        GenNetworkInterface<T>* interface = manifold::kernel::Component::GetComponent< GenNetworkInterface<T> >(interface_ids.at(i));
+        if ( interface != NULL )
+        {
+            manifold::kernel::Clock::Register< GenNetworkInterface<T> >
+            (clk_t, interface, &GenNetworkInterface<T>::tick, &GenNetworkInterface<T>::tock); //pass clock from out side
+        }
+	interfaces.push_back(interface);
+    }
+
+    //register router to clock
+    for ( uint i=0; i< router_ids.size(); i++)
+    {
+        SimpleRouter* rr= manifold::kernel::Component::GetComponent<SimpleRouter>(router_ids.at(i));
+        if ( rr != NULL )
+        {
+            manifold::kernel::Clock::Register<SimpleRouter>(clk_t, rr, &SimpleRouter::tick, &SimpleRouter::tock);
+        }
+	routers.push_back(rr);
+    }
+
+    for ( uint i=0; i< interface_ids.size(); i++)
+    {
+        GenNetworkInterface<T>* interface = manifold::kernel::Component::GetComponent< GenNetworkInterface<T> >(interface_ids.at(i));
+        if ( interface != NULL ) {
+	    SimpleRouter* rr= manifold::kernel::Component::GetComponent<SimpleRouter>(router_ids.at(i / concentration));
+	    assert(rr);
+	    interface->set_router(rr);
+	}
+    }
+
+
+    //establish the connections
+    connect_interface_routers();
+    connect_routers();
+}
+
+//deconstructor
+template <typename T>
+Mesh<T>::~Mesh()
+{
+    for ( uint i=0 ; i<interfaces.size(); i++ )
+        delete interfaces[i];
+    for ( uint i=0 ; i<routers.size(); i++ )
+        delete routers[i];
+}
+
+//! connect interface to router
+template <typename T>
+void
+Mesh<T>::connect_interface_routers()
+{
+    const manifold::kernel::Ticks_t LATENCY = 1;
+    for( uint i=0; i<interface_ids.size(); i++)
+    {
+        const uint local = i % concentration;
+	const int rport = (local == 0) ? SimpleRouter::PORT_NI : SimpleRouter::PORT_MC + local - 1;
+	const manifold::kernel::CompId_t rid = router_ids.at(i / concentration);
+
+	manifold::kernel::Manifold::Connect(interface_ids.at(i), GenNetworkInterface<T>::ROUTER_PORT,
+					    rid, rport,
+					    &SimpleRouter::handle_link_arrival , LATENCY);
+	manifold::kernel::Manifold::Connect(rid, rport,
+					    interface_ids.at(i), GenNetworkInterface<T>::ROUTER_PORT,
+					    &GenNetworkInterface<T>::handle_router , LATENCY);
+    }
+}
+
+
+template <typename T>
+void
+Mesh<T>::connect_router_pair(uint r1, uint port1, uint r2, uint port2)
+{
+    const manifold::kernel::Ticks_t LATENCY = 1;
+
+    //check if this connection go across lp
+    if (node_lp->at(r1) != node_lp->at(r2)) {
+	if (routers[r1])
+	    routers[r1]->set_port_cross_lp(port1);
+	if (routers[r2])
+	    routers[r2]->set_port_cross_lp(port2);
+    }
+
+    manifold::kernel::Manifold::Connect(router_ids.at(r1), port1,
+					router_ids.at(r2), port2,
+					&SimpleRouter::handle_link_arrival, LATENCY);
+    manifold::kernel::Manifold::Connect(router_ids.at(r2), port2,
+					router_ids.at(r1), port1,
+					&SimpleRouter::handle_link_arrival, LATENCY);
+}
+
+
+//! connect routers together; unlike the torus there are no wrap-around links.
+template <typename T>
+void
+Mesh<T>::connect_routers()
+{
+    //east - west
+    for ( uint i=0; i<y_dim; i++) //for all rows
+        for ( uint j=1; j<x_dim; j++) //for all columns except the left-most
+	    connect_router_pair(i*x_dim + j, SimpleRouter::PORT_WEST, i*x_dim + j-1, SimpleRouter::PORT_EAST);
+
+    //north - south; row 0 is the north-most
+    for ( uint i=1; i<y_dim; i++) //starting from 2nd row
+        for ( uint j=0; j<x_dim; j++) //for all columns
+	    connect_router_pair(i*x_dim + j, SimpleRouter::PORT_NORTH, (i-1)*x_dim + j, SimpleRouter::PORT_SOUTH);
+}
+
+
+template <typename T>
+void Mesh<T> :: print_stats(std::ostream& out)
+{
+    for(unsigned i=0; i<interfaces.size(); i++) {
+	if(interfaces[i])
+	    interfaces[i]->print_stats(out);
+    }
+
+    for(unsigned i=0; i<routers.size(); i++) {
+	if(routers[i])
+	    routers[i]->print_stats(out);
+    }
+}
+
+
+} // namespace iris
+} // namespace manifold
+
+#endif   /* ----- #ifndef MANIFOLD_IRIS_MESH_H ----- */
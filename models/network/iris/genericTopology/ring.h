@@ -22,7 +22,8 @@ namespace manifold {
 namespace iris {
 
 struct ring_init_params {
-    ring_init_params() : no_nodes(0), no_vcs(0), credits(0), link_width(0), ni_up_credits(0), ni_upstream_buffer_size(0) {}
+    ring_init_params() : no_nodes(0), no_vcs(0), credits(0), link_width(0), ni_up_credits(0), ni_upstream_buffer_size(0),
+                         express_hops(0), bypass(false) {}
     uint no_nodes;
     uint no_vcs;
     uint credits;
@@ -30,6 +31,8 @@ struct ring_init_params {
     uint link_width;
     unsigned ni_up_credits; //network interface credits for output to terminal.
     int ni_upstream_buffer_size; //network interface's output buffer (to terminal) size
+    uint express_hops; //if > 0, router i also has express links to i+express_hops and i-express_hops
+    bool bypass; //let head flits skip VC and switch allocation at idle routers
 };
 
 
@@ -58,6 +61,7 @@ class Ring
 #endif
        // variables
        const unsigned no_nodes; //# of routers
+       const unsigned express_hops; //length of the express links; 0 for none
        manifold::kernel::Clock& clk_r; //the clock for routers and interfaces 
        std::vector <SimpleRouter*> routers; //the routers
        std::vector <GenNetworkInterface<T>*> interfaces; //the interfaces
@@ -82,6 +86,7 @@ class Ring
 template <typename T>
 Ring<T>::Ring(manifold::kernel::Clock& clk, ring_init_params* params, const Terminal_to_net_mapping* mapping, SimulatedLen<T>* slen, VnetAssign<T>* vn, int ni_credit_type, uint lp_inf, uint lp_rt) :
     no_nodes(params->no_nodes),
+    express_hops(params->express_hops),
     clk_r(clk)
 {
 #ifdef IRIS_TEST
@@ -103,6 +108,7 @@ Ring<T>::Ring(manifold::kernel::Clock& clk, ring_init_params* params, const Term
     assert(params->ni_up_credits > 0);
     assert(ni_credit_type != 0);
     assert(params->ni_upstream_buffer_size > 0);
+    assert(express_hops == 0 || (express_hops >= 2 && express_hops <= no_nodes/2));
 
     //parameters for interface
     inf_init_params i_p_inf;
@@ -122,10 +128,12 @@ Ring<T>::Ring(manifold::kernel::Clock& clk, ring_init_params* params, const Term
     //parameters for router
     i_p_rt.no_nodes = params->no_nodes;
     i_p_rt.grid_size = params->no_nodes; //defualt in simplerouter
-    i_p_rt.no_ports = 3;
+    i_p_rt.no_ports = (express_hops > 0) ? 7 : 3; //express ports follow the 5 regular ports
     i_p_rt.no_vcs = params->no_vcs;
     i_p_rt.credits = params->credits;
     i_p_rt.rc_method = RING_ROUTING;
+    i_p_rt.express_hops = express_hops;
+    i_p_rt.bypass = params->bypass;
     
     NIInit<T> niInit(mapping, slen, vn);
 
@@ -281,7 +289,19 @@ Ring<T>::connect_routers()
         outFile_data<< "0.0 L " << routers.at(0)->node_id + no_nodes<< " " << routers.at(no_nodes-1)->node_id + no_nodes<< std::endl;
 #endif
                                         
-
+    // express links: i's express east port faces (i+express_hops)'s express west port
+    if (express_hops > 0) {
+        for ( uint i=0; i<no_nodes; i++)
+        {
+            const uint j = (i + express_hops) % no_nodes;
+            manifold::kernel::Manifold::Connect(router_ids.at(i), SimpleRouter::PORT_EXPRESS_EAST,
+                                                router_ids.at(j), SimpleRouter::PORT_EXPRESS_WEST,
+                                                &SimpleRouter::handle_link_arrival, LATENCY);
+            manifold::kernel::Manifold::Connect(router_ids.at(j), SimpleRouter::PORT_EXPRESS_WEST,
+                                                router_ids.at(i), SimpleRouter::PORT_EXPRESS_EAST,
+                                                &SimpleRouter::handle_link_arrival, LATENCY);
+        }
+    }
 }
 
 
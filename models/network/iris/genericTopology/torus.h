@@ -21,7 +21,8 @@ namespace manifold {
 namespace iris {
 
 struct torus_init_params {
-    torus_init_params() : x_dim(0), y_dim(0), no_vcs(0), credits(0), link_width(0), ni_up_credits(0), ni_upstream_buffer_size(0) {}
+    torus_init_params() : x_dim(0), y_dim(0), no_vcs(0), credits(0), link_width(0), ni_up_credits(0), ni_upstream_buffer_size(0),
+                          express_hops(0), bypass(false) {}
 
     uint x_dim;
     uint y_dim;
@@ -31,6 +32,8 @@ struct torus_init_params {
     unsigned ni_up_credits; //network interface credits for output to terminal.
     int ni_upstream_buffer_size; //network interface's output buffer (to terminal) size
     //ROUTING_SCHEME rc_method;
+    uint express_hops; //if > 0, each router also has express links to the routers express_hops away in each direction
+    bool bypass; //let head flits skip VC and switch allocation at idle routers
 };
 
 
@@ -62,9 +65,13 @@ class Torus
 #ifndef IRIS_TEST
     private:
 #endif
+       //connect the express ports of two routers; port1 of r1 faces port2 of r2.
+       void connect_express_pair(uint r1, uint port1, uint r2, uint port2);
+
        // variables
        const unsigned x_dim; // x dimension
        const unsigned y_dim; // y dimension
+       const unsigned express_hops; //length of the express links; 0 for none
        manifold::kernel::Clock& clk_t; //the clock for routers and interfaces 
        std::vector <SimpleRouter*> routers; //the routers
        std::vector <GenNetworkInterface<T>* > interfaces; //the interfaces
@@ -91,6 +98,7 @@ template <typename T>
 Torus<T>::Torus(manifold::kernel::Clock& clk, torus_init_params* params, const Terminal_to_net_mapping* mapping, SimulatedLen<T>* slen, VnetAssign<T>* vn, int ni_credit_type, vector<int>* node_lp) :
     x_dim(params->x_dim),
     y_dim(params->y_dim),
+    express_hops(params->express_hops),
     clk_t(clk),
     node_lp(node_lp)
 {
@@ -115,6 +123,7 @@ Torus<T>::Torus(manifold::kernel::Clock& clk, torus_init_params* params, const T
     assert(params->ni_up_credits > 0);
     assert(ni_credit_type != 0);
     assert(params->ni_upstream_buffer_size > 0);
+    assert(express_hops == 0 || (express_hops >= 2 && express_hops <= x_dim/2 && express_hops <= y_dim/2));
     
     //parameters for interface
     inf_init_params i_p_inf;
@@ -132,10 +141,12 @@ Torus<T>::Torus(manifold::kernel::Clock& clk, torus_init_params* params, const T
 
     i_p_rt.no_nodes = params->x_dim * params->y_dim;
     i_p_rt.grid_size = params->x_dim;
-    i_p_rt.no_ports = 5;
+    i_p_rt.no_ports = (express_hops > 0) ? 9 : 5;
     i_p_rt.no_vcs = params->no_vcs;
     i_p_rt.credits = params->credits;
     i_p_rt.rc_method = TORUS_ROUTING; 
+    i_p_rt.express_hops = express_hops;
+    i_p_rt.bypass = params->bypass;
     
     NIInit<T> niInit(mapping, slen, vn);
 
@@ -435,6 +446,40 @@ Torus<T>::connect_routers()
 	#endif
     }
 
+    // express links
+    if (express_hops > 0) {
+	for ( uint i=0; i<y_dim; i++) //for all rows
+	    for ( uint j=0; j<x_dim; j++) //for all columns
+	    {
+		connect_express_pair(i*x_dim + j, SimpleRouter::PORT_EXPRESS_EAST,
+		                     i*x_dim + (j + express_hops) % x_dim, SimpleRouter::PORT_EXPRESS_WEST);
+		connect_express_pair(i*x_dim + j, SimpleRouter::PORT_EXPRESS_SOUTH,
+		                     ((i + express_hops) % y_dim)*x_dim + j, SimpleRouter::PORT_EXPRESS_NORTH);
+	    }
+    }
+}
+
+
+template <typename T>
+void
+Torus<T>::connect_express_pair(uint r1, uint port1, uint r2, uint port2)
+{
+    const manifold::kernel::Ticks_t LATENCY = 1;
+
+    //check if this connection go across lp
+    if (node_lp->at(r1) != node_lp->at(r2)) {
+	if (routers[r1])
+	    routers[r1]->set_port_cross_lp(port1);
+	if (routers[r2])
+	    routers[r2]->set_port_cross_lp(port2);
+    }
+
+    manifold::kernel::Manifold::Connect(router_ids.at(r1), port1,
+					router_ids.at(r2), port2,
+					&SimpleRouter::handle_link_arrival, LATENCY);
+    manifold::kernel::Manifold::Connect(router_ids.at(r2), port2,
+					router_ids.at(r1), port1,
+					&SimpleRouter::handle_link_arrival, LATENCY);
 }
 
 template <typename T>
@@ -24,7 +24,7 @@ namespace manifold {
 namespace iris {
 
 struct torus6p_init_params {
-    torus6p_init_params() : x_dim(0), y_dim(0), no_vcs(0), credits(0), link_width(0), ni_up_credits(0), ni_upstream_buffer_size(0) {}
+    torus6p_init_params() : x_dim(0), y_dim(0), no_vcs(0), credits(0), link_width(0), ni_up_credits(0), ni_upstream_buffer_size(0), bypass(false) {}
 
     uint x_dim;
     uint y_dim;
@@ -33,6 +33,7 @@ struct torus6p_init_params {
     uint link_width; //in bits.
     unsigned ni_up_credits; //network interface credits for output to terminal.
     int ni_upstream_buffer_size; //network interface's output buffer (to terminal) size
+    bool bypass; //let head flits skip VC and switch allocation at idle routers
     //ROUTING_SCHEME rc_method;
 };
 
@@ -142,6 +143,7 @@ Torus6p<T>::Torus6p(manifold::kernel::Clock& clk, torus6p_init_params* params, c
     i_p_rt.no_vcs = params->no_vcs;
     i_p_rt.credits = params->credits;
     i_p_rt.rc_method = TORUS6P_ROUTING; 
+    i_p_rt.bypass = params->bypass;
     
     NIInit<T> niInit(mapping, slen, vn);
 
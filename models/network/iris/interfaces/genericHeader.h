@@ -87,7 +87,7 @@ enum topology_type {TWO_NODE,RING, TORUS, TORUS6P};
 enum { SEND_DATA, RECV_DATA, SEND_SIG, RECV_SIG };
 enum message_class { INVALID_PKT, PROC_REQ, MC_RESP };
 enum SW_ARBITRATION { ROUND_ROBIN, FCFS, ROUND_ROBIN_PRIORITY };
-enum ROUTING_SCHEME { TWONODE_ROUTING, XY, TORUS_ROUTING, RING_ROUTING, TORUS6P_ROUTING };
+enum ROUTING_SCHEME { TWONODE_ROUTING, XY, TORUS_ROUTING, RING_ROUTING, TORUS6P_ROUTING, YX, O1TURN, WEST_FIRST, ODD_EVEN };
 enum DEST_DISTRIBUTION_TYPE { HALF, USE_MC, BIT_REVERSAL, SIMPLE};
 
 
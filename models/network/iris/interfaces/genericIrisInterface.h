@@ -20,6 +20,7 @@
 #include        "vnetAssign.h"
 #include        "../data_types/linkData.h"
 #include	"../data_types/flit.h"
+#include	"../data_types/ringBuffer.h"
 #include	"../components/genericBuffer.h"
 #include	"../components/simpleArbiter.h"
 #include	"../components/simpleRouter.h"
@@ -27,6 +28,7 @@
 #include        "kernel/manifold.h"
 #include        <iostream>
 #include        <assert.h>
+#include        <string.h>
 
 #include  "../../../cache/mcp-cache/coh_mem_req.h"
 
@@ -34,6 +36,38 @@ namespace manifold {
 namespace iris {
 
 
+//! The kind of terminal a packet goes to, which the torus6p routing uses, and the
+//! address the packet carries, for debugging. Both are put in the head flit. These
+//! defaults are for the NetworkPackets of the MCP caches; other terminal data types
+//! can provide overloads in their own namespace.
+template<typename T>
+inline term_type Get_term_type(T* pkt)
+{
+    if (pkt->get_dst_port() == 234 || pkt->get_dst_port() == 567) { //LLP::LLP_ID, LLP::LLS_ID
+        return CACHE;
+    } else if (pkt->get_type() == 456) { //MEM
+        return MEMORY;
+    } else {
+        std::cerr << "Invalid terminal distination" << std::endl;
+        exit(1);
+    }
+}
+
+template<typename T>
+inline uint64_t Get_term_addr(T* pkt)
+{
+    return ((manifold::mcp_cache_namespace::Mem_msg*)(pkt->data))->get_addr();
+}
+
+
+//! Index of the lowest set bit of a non-zero VC mask.
+inline unsigned Lowest_bit(uint64_t mask)
+{
+    assert(mask != 0);
+    return __builtin_ctzll(mask);
+}
+
+
 //Network interface initialization parameters
 struct inf_init_params{
     unsigned num_vc;
@@ -94,6 +128,7 @@ public:
 //!       |-----------|  input_pkt_buffer; no size limit;     output_pkt_buffer holds packets going out
 //!       |-----------|  holds packets from terminal          to terminal; its size is limited by
 //!                                                           UPSTREAM_BUFFER_SIZE
+//!  Both are RingBuffers, so moving packets through them doesn't allocate.
 //!
 //!      -----------  proc_out_buffer: a vector;
 //!     |  |  |  |  | one element for a VC; each               proc_in_buffer is similar.
@@ -109,6 +144,8 @@ public:
 //!     |  |  |  |  | element for a VC; each a GenericBuffer   router_in_buffer is similar.
 //!      -----------  holding flits.
 //!
+//! Which slots of proc_out_buffer are free or hold flits, and which slots of proc_in_buffer
+//! hold a whole packet, are kept in bitmasks with one bit per VC, so at most 64 VCs are supported.
 //!
 template<typename T>
 class GenNetworkInterface : public NetworkInterfaceBase
@@ -134,6 +171,11 @@ class GenNetworkInterface : public NetworkInterfaceBase
 
 	virtual void print_stats(std::ostream& out);
 
+        //! Save/restore credits. Packets and flits in the buffers cannot be saved,
+	//! so the interface must be empty.
+        void checkpoint(manifold::kernel::CheckpointOut&);
+        void restore(manifold::kernel::CheckpointIn&);
+
         void set_router(SimpleRouter* s) { m_router = s; }
 
 #ifndef IRIS_TEST
@@ -158,6 +200,8 @@ class GenNetworkInterface : public NetworkInterfaceBase
 
 	void process_incoming_credit();
 
+	bool is_proc_out_buffer_free(unsigned vc) const { return proc_out_free_mask & (uint64_t(1) << vc); }
+
         const unsigned no_vcs; //# of virtual channel
         const unsigned credits; //# credits for each channel
 	const int UPSTREAM_FULL_CREDITS; //credits for output link to terminal
@@ -169,16 +213,17 @@ class GenNetworkInterface : public NetworkInterfaceBase
         #ifdef IRIS_STATS_T2T_DELAY
 	//if collect terminal-to-terminal delay
 	struct PktWrapper {
+	    PktWrapper() : pkt(0), enter_network_time(0) {}
 	    PktWrapper(T* p, manifold::kernel::Ticks_t t) : pkt(p), enter_network_time(t) {}
             T* pkt;
 	    manifold::kernel::Ticks_t enter_network_time; //time when the packet enters the network
 	};
-        std::list<PktWrapper> input_pkt_buffer;
-        std::list<PktWrapper> output_pkt_buffer; //size limit of this buffer is UPSTREAM_BUFFER_SIZE
+        RingBuffer<PktWrapper> input_pkt_buffer;
+        RingBuffer<PktWrapper> output_pkt_buffer; //size limit of this buffer is UPSTREAM_BUFFER_SIZE
 	#else
         //the infinite input buffer for the input from terminal
-        std::list<T*> input_pkt_buffer;
-        std::list<T*> output_pkt_buffer; //size limit of this buffer is UPSTREAM_BUFFER_SIZE
+        RingBuffer<T*> input_pkt_buffer;
+        RingBuffer<T*> output_pkt_buffer; //size limit of this buffer is UPSTREAM_BUFFER_SIZE
 	#endif
 
 	int upstream_credits; //credits for output link to terminal
@@ -187,10 +232,11 @@ class GenNetworkInterface : public NetworkInterfaceBase
 
         GenericBuffer router_out_buffer; //Buffer for outgoing flits; from here flits enter the router.
 
-        std::vector<bool> is_proc_out_buffer_free; //whether a slot of the proc_out_buffer is available.
-	                                           //Note this is set to true when the whole packet has left the
-						   //interface, NOT when the whole packet has been moved from
-						   //proc_out_buffer to router_out_buffer.
+        uint64_t proc_out_free_mask; //bit i is set if slot i of the proc_out_buffer is available.
+	                             //Note this is set when the whole packet has left the
+				     //interface, NOT when the whole packet has been moved from
+				     //proc_out_buffer to router_out_buffer.
+        uint64_t proc_out_busy_mask; //bit i is set if slot i of the proc_out_buffer has flits.
 
         std::vector < int > downstream_credits; //the credit correspond for link to network
 
@@ -198,19 +244,22 @@ class GenNetworkInterface : public NetworkInterfaceBase
 
         std::vector<FlitLevelPacket> proc_in_buffer; //A buffer where flits for the same packet are assembled.
 	                                             //One per VC.
+        uint64_t proc_in_ready_mask; //bit i is set if slot i of the proc_in_buffer has a whole packet.
         
         //the arbiter used in interface
         SimpleArbiter* arbiter; 
 
 	SimulatedLen<T>* simLen; //this object has a function that gives us the simulated length of a nework packet.
 	VnetAssign<T>* vnet; //this object has a function that gives us the virtual network ID for a nework packet.
+
+	std::vector<unsigned char> m_serial_buf; //a packet is serialized here before it's copied to flits, and vice versa.
     
 
 	#ifdef FORECAST_NULL
-        std::list<manifold::kernel::Ticks_t> m_send_credit_tick; //record when we are going to send credit to terminal
-        std::list<manifold::kernel::Ticks_t> m_recv_credit_tick; //record when a received credit is going to be processed
+        RingBuffer<manifold::kernel::Ticks_t> m_send_credit_tick; //record when we are going to send credit to terminal
+        RingBuffer<manifold::kernel::Ticks_t> m_recv_credit_tick; //record when a received credit is going to be processed
 
-        std::list<manifold::kernel::Ticks_t> m_input_msg_ticks;
+        RingBuffer<manifold::kernel::Ticks_t> m_input_msg_ticks;
 	#endif
 
 
@@ -242,6 +291,8 @@ GenNetworkInterface<T>::GenNetworkInterface (unsigned ifid, const NIInit<T>& niI
 	CREDIT_PKT(i_p->up_credit_msg_type),
         no_vcs(i_p->num_vc), credits(i_p->num_credits), UPSTREAM_FULL_CREDITS(i_p->upstream_credits), LINK_WIDTH(i_p->linkWidth),
 	UPSTREAM_BUFFER_SIZE(i_p->upstream_buffer_size),
+	input_pkt_buffer(2*i_p->num_vc),
+	output_pkt_buffer(i_p->upstream_buffer_size),
 	router_out_buffer(i_p->num_vc, 6*i_p->num_credits),
 	router_in_buffer(i_p->num_vc, 6*i_p->num_credits),
 	simLen(niInit.slen),
@@ -252,10 +303,10 @@ GenNetworkInterface<T>::GenNetworkInterface (unsigned ifid, const NIInit<T>& niI
     assert(i_p->upstream_credits > 0);
     assert(i_p->up_credit_msg_type != 0);
     assert(UPSTREAM_BUFFER_SIZE > 0);
+    assert(no_vcs > 0 && no_vcs <= 64); //VCs are kept in 64-bit masks
 
     //initializing vectors to given size 
     proc_out_buffer.resize ( no_vcs );
-    is_proc_out_buffer_free.resize(no_vcs);
     proc_in_buffer.resize(no_vcs);
     downstream_credits.resize( no_vcs );
     //router_ob_packet_complete.resize(no_vcs);
@@ -267,10 +318,12 @@ GenNetworkInterface<T>::GenNetworkInterface (unsigned ifid, const NIInit<T>& niI
     //initializing the values for each vector
     for ( uint i=0; i<no_vcs; i++)
     {
-        is_proc_out_buffer_free[i] = true;
         //router_ob_packet_complete[i] = false;
         downstream_credits[i] = credits;
     }
+    proc_out_free_mask = (no_vcs == 64) ? ~uint64_t(0) : (uint64_t(1) << no_vcs) - 1;
+    proc_out_busy_mask = 0;
+    proc_in_ready_mask = 0;
     upstream_credits = UPSTREAM_FULL_CREDITS;
 
 
@@ -405,6 +458,10 @@ void GenNetworkInterface<T>::process_incoming_credit()
 {  
     upstream_credits++;
     assert(upstream_credits <= UPSTREAM_FULL_CREDITS);
+    #ifdef FORECAST_NULL
+    while(!m_recv_credit_tick.empty() && m_recv_credit_tick.front() <= manifold::kernel::Manifold::NowTicks())
+        m_recv_credit_tick.pop_front();
+    #endif
 }
 
 
@@ -415,36 +472,25 @@ template<typename T>
 T*
 GenNetworkInterface<T>::from_flit_level_packet(FlitLevelPacket* flp)
 {
-    T* message = new T;
-    uint8_t* ptr = (uint8_t*) message;
-    unsigned byte_count = 0;
+    m_serial_buf.clear();
     
     while(flp->size() > 0)
     {
         Flit* f = flp->pop_next_flit ();
-        if (f->type == HEAD || f->type == BODY)
+        if (f->type == HEAD)
         {   
-	    uint8_t* data = 0;
-	    if(f->type == HEAD)
-	        data = static_cast<HeadFlit*>(f)->data;
-	    else
-	        data = static_cast<BodyFlit*>(f)->data;
-            for (int j = 0; j < HeadFlit::MAX_DATA_SIZE; j++)
-            {
-                if(byte_count < sizeof(T)) {
-		    *ptr = *data;
-		    ptr++;
-		    data++;
-		    byte_count++;
-		}
-		else
-		    break;
-            }
+	    HeadFlit* hf = static_cast<HeadFlit*>(f);
+	    m_serial_buf.insert(m_serial_buf.end(), hf->data, hf->data + hf->data_len);
+        } 
+	else if (f->type == BODY)
+        {   
+	    BodyFlit* bf = static_cast<BodyFlit*>(f);
+	    m_serial_buf.insert(m_serial_buf.end(), bf->data, bf->data + HeadFlit::MAX_DATA_SIZE);
         } 
 	delete f;
     }
     
-    return message;
+    return manifold::kernel::Deserialize<T>(&m_serial_buf[0]);
 }
 
 
@@ -459,15 +505,15 @@ GenNetworkInterface<T>::tick ( void )
 {
     // For each VC, move one flit from the proc_out_buffer (which holds FlitLevelPkt) to the
     // router_out_buffer (which holds individual flits)
-    for ( uint i=0 ; i<no_vcs ; i++ )
+    for (uint64_t busy = proc_out_busy_mask; busy != 0; busy &= busy - 1)
     {
-        if ( proc_out_buffer[i].size()>0 )
-        {
-            //router_out_buffer is flit level buffer
-            Flit* f = proc_out_buffer[i].pop_next_flit();
-            f->virtual_channel = i;
-            router_out_buffer.push(i, f);
-        }
+        const unsigned i = Lowest_bit(busy);
+        //router_out_buffer is flit level buffer
+        Flit* f = proc_out_buffer[i].pop_next_flit();
+        f->virtual_channel = i;
+        router_out_buffer.push(i, f);
+        if (proc_out_buffer[i].size() == 0)
+            proc_out_busy_mask &= ~(uint64_t(1) << i);
     }
     
     //Arbitration request. Only make a request when there's credit for sending.
@@ -499,7 +545,7 @@ GenNetworkInterface<T>::tick ( void )
         {
             //router_ob_packet_complete[winner] = false;
 	    //mark the proc_out_buffer slot as free
-            is_proc_out_buffer_free[winner] = true;
+            proc_out_free_mask |= uint64_t(1) << winner;
 	    #ifdef STATS
 	    stat_packets_out_to_router++;
 	    if(f->pkt_length == 1)
@@ -538,27 +584,22 @@ cerr << std::endl;
     //first try to send a packet from the output buffer
     bool sent_one = try_send_to_terminal();
 
-    //Pull entire packets from proc_in_buffer in a round-robin manner.
+    //Pull entire packets from proc_in_buffer in a round-robin manner: the winner is the first
+    //VC with a whole packet after the last winner.
     bool found = false;
-    //decide which vc to use under the FIFO principal
-    const unsigned start_ch = last_inpkt_winner + 1;
-    for ( uint i=0; i<no_vcs ; i++) {
-        unsigned ch = start_ch + i;
-	if(ch >= no_vcs) //wrap around
-	    ch -= no_vcs;
-	if(proc_in_buffer[ch].has_whole_packet())
-	{
-	    //a whole packet has been received.
-            last_inpkt_winner= ch;
-            found = true;
-            break;
-        }
+    if (proc_in_ready_mask != 0)
+    {
+        const unsigned start_ch = last_inpkt_winner + 1 < no_vcs ? last_inpkt_winner + 1 : 0;
+        const uint64_t after = proc_in_ready_mask & (~uint64_t(0) << start_ch);
+        last_inpkt_winner = Lowest_bit(after != 0 ? after : proc_in_ready_mask);
+        found = true;
     }
 
     //find the finished flit level pkt convert the filts to packet
     if ( found && (output_pkt_buffer.size() < UPSTREAM_BUFFER_SIZE) )
     {
         T* np = from_flit_level_packet(&proc_in_buffer[last_inpkt_winner]);
+        proc_in_ready_mask &= ~(uint64_t(1) << last_inpkt_winner);
         #ifdef IRIS_STATS_T2T_DELAY
 	output_pkt_buffer.push_back(PktWrapper(np, proc_in_buffer[last_inpkt_winner].enter_network_time));
 	#else
@@ -601,12 +642,14 @@ std::cerr << "@" << dec << manifold::kernel::Manifold::NowTicks() << " Interface
     //handle receiving flits: push flits coming in from router in buffer to the in buffer
     for ( uint i=0; i<no_vcs ; i++ )
     {
-        if( router_in_buffer.get_occupancy(i) > 0 &&  proc_in_buffer[i].has_whole_packet() == false)
+        if( router_in_buffer.get_occupancy(i) > 0 && (proc_in_ready_mask & (uint64_t(1) << i)) == 0)
         { 
             Flit* ptr = router_in_buffer.pull(i);
             proc_in_buffer[i].add(ptr);         
 	    if(ptr->type == HEAD)
 	        proc_in_buffer[i].enter_network_time = (static_cast<HeadFlit*>(ptr))->enter_network_time;
+	    if(proc_in_buffer[i].has_whole_packet())
+	        proc_in_ready_mask |= uint64_t(1) << i;
         }
     }
 }
@@ -617,61 +660,73 @@ template<typename T>
 void
 GenNetworkInterface<T>::tock ( void )
 {
-    // Take packets from input_pkt_buffer, convert them into flits, and store in free slots of proc_out_buffer
-    for ( uint i=0; i < no_vcs; i++ )
+    // Take packets from input_pkt_buffer, convert them into flits, and store in free slots of proc_out_buffer.
+    // A slot can take a packet if all its credits have returned.
+    uint64_t avail = 0;
+    if (!input_pkt_buffer.empty())
     {
-        if (is_proc_out_buffer_free[i] && downstream_credits[i] == (int)credits && !input_pkt_buffer.empty())
-        {  
-            //convert the mem_req to flits and copy it to out buffer
-            manifold::kernel::Ticks_t enter_net_time = 0;
-
-	    #ifdef IRIS_STATS_T2T_DELAY
-	    T* pkt = input_pkt_buffer.front().pkt;
-	    enter_net_time = input_pkt_buffer.front().enter_network_time;
-	    #else
-	    T* pkt = input_pkt_buffer.front();
-	    #endif
+        for (uint64_t m = proc_out_free_mask; m != 0; m &= m - 1)
+        {
+            const unsigned i = Lowest_bit(m);
+            if (downstream_credits[i] == (int)credits)
+                avail |= uint64_t(1) << i;
+        }
+    }
 
-	    //current supports 2 virtual networks; packets for virtual network 0 will be moved to even-numbered
-	    //proc_out_buffer location and packets for virtual net 1 will be moved to odd-numbered proc_out_buffer
-	    //location.
-	    if(vnet->get_virtual_net(pkt) == 0)
-	    {
-	        if(i%2 == 1)
-	            continue;
-	    }
-	    else
-	    {
-	        assert(vnet->get_virtual_net(pkt) == 1);
+    //Packets are placed in increasing VC order, each in a VC after that of the previous one.
+    while (avail != 0 && !input_pkt_buffer.empty())
+    {
+        //convert the mem_req to flits and copy it to out buffer
+        manifold::kernel::Ticks_t enter_net_time = 0;
 
-	        if(i%2 == 0)
-	            continue;
-	    }
+	#ifdef IRIS_STATS_T2T_DELAY
+	T* pkt = input_pkt_buffer.front().pkt;
+	enter_net_time = input_pkt_buffer.front().enter_network_time;
+	#else
+	T* pkt = input_pkt_buffer.front();
+	#endif
 
-            to_flit_level_packet( &proc_out_buffer[i], pkt, enter_net_time);
+	//current supports 2 virtual networks; packets for virtual network 0 will be moved to even-numbered
+	//proc_out_buffer location and packets for virtual net 1 will be moved to odd-numbered proc_out_buffer
+	//location.
+	const uint64_t EVEN_VCS = 0x5555555555555555ULL;
+	uint64_t cand;
+	if(vnet->get_virtual_net(pkt) == 0)
+	    cand = avail & EVEN_VCS;
+	else
+	{
+	    assert(vnet->get_virtual_net(pkt) == 1);
+	    cand = avail & ~EVEN_VCS;
+	}
+	if(cand == 0)
+	    break;
+	const unsigned i = Lowest_bit(cand);
+	avail &= ~uint64_t(0) << i << 1; //only VCs after i are left
 
-            //assign virtual channel
-            proc_out_buffer[i].virtual_channel = i;
-               
-            is_proc_out_buffer_free[i] = false;
-            assert( proc_out_buffer[i].size() != 0 );
-            
-            //remove the element in pkt buffer
-	    int src_port = pkt->get_src_port();
-	    delete pkt;
-            input_pkt_buffer.pop_front();
-
-	    //send a credit back
-	    T* credit = new T;
-	    credit->set_type(CREDIT_PKT);
-	    credit->set_dst_port(src_port);
-	    //Send(TERMINAL_PORT, credit);
-	    //use schedule Half to ensure credit is sent on rising edge.
-	    manifold::kernel::Manifold::ScheduleHalf(1, &GenNetworkInterface::send_credit_to_terminal, this, credit);
-	    #ifdef FORECAST_NULL
-	    m_send_credit_tick.push_back(manifold::kernel::Manifold::NowTicks() + 1);
-	    #endif
-        }
+        to_flit_level_packet( &proc_out_buffer[i], pkt, enter_net_time);
+
+        //assign virtual channel
+        proc_out_buffer[i].virtual_channel = i;
+           
+        proc_out_free_mask &= ~(uint64_t(1) << i);
+        proc_out_busy_mask |= uint64_t(1) << i;
+        assert( proc_out_buffer[i].size() != 0 );
+        
+        //remove the element in pkt buffer
+	int src_port = pkt->get_src_port();
+	delete pkt;
+        input_pkt_buffer.pop_front();
+
+	//send a credit back
+	T* credit = new T;
+	credit->set_type(CREDIT_PKT);
+	credit->set_dst_port(src_port);
+	//Send(TERMINAL_PORT, credit);
+	//use schedule Half to ensure credit is sent on rising edge.
+	manifold::kernel::Manifold::ScheduleHalf(1, &GenNetworkInterface::send_credit_to_terminal, this, credit);
+	#ifdef FORECAST_NULL
+	m_send_credit_tick.push_back(manifold::kernel::Manifold::NowTicks() + 1);
+	#endif
     }
 }
 
@@ -713,8 +768,14 @@ GenNetworkInterface<T>::to_flit_level_packet(FlitLevelPacket* flp, T* pkt, manif
     if(num_bytes * 8 % LINK_WIDTH != 0)
         num_flits++;
 
+    //Only the serialized form of the packet is carried in the flits, which for packets
+    //with out-of-line payload is much smaller than sizeof(T).
+    const unsigned serial_size = manifold::kernel::Get_serialize_size<T>((const T*)pkt);
+    m_serial_buf.resize(serial_size);
+    manifold::kernel::Serialize<T>((const T*)pkt, &m_serial_buf[0]);
+
     //ensure the actual packet fits in the number of flits allocated.
-    assert((int)(sizeof(T)/num_flits) <= HeadFlit :: MAX_DATA_SIZE);
+    assert((int)(serial_size/num_flits) <= HeadFlit :: MAX_DATA_SIZE);
 
 
 
@@ -745,36 +806,12 @@ GenNetworkInterface<T>::to_flit_level_packet(FlitLevelPacket* flp, T* pkt, manif
 
     //cerr << "*@" << dec << manifold::kernel::Manifold::NowTicks() << " pkt type: " << pkt->get_type() << ", dst: " << pkt->get_dst() << " port: " << pkt->get_dst_port() << ", src: " << pkt->get_src() << " port: " << pkt->get_src_port() << ", src id: " << hf->src_id << ", dst id: " << hf->dst_id << " (Addr: " << hex << ((manifold::mcp_cache_namespace::Mem_msg*)(pkt->data))->get_addr()  << ")";
 
-    if (pkt->get_dst_port() == 234 || pkt->get_dst_port() == 567) { //LLP::LLP_ID, LLP::LLS_ID
-        hf->term = CACHE;
-        //cerr << " CACHE" << std::endl;
-    } else if (pkt->get_type() == 456) { //MEM
-        hf->term = MEMORY;
-        //cerr << " MEMORY" << std::endl;
-    } else {
-        cerr << "Invalid terminal distination" << endl;
-        exit(1);
-    }
-
-    hf->addr =  ((manifold::mcp_cache_namespace::Mem_msg*)(pkt->data))->get_addr();
+    hf->term = Get_term_type(pkt);
+    hf->addr = Get_term_addr(pkt);
 
     //copy data to head flit
-    unsigned byte_count = 0;
-
-    uint8_t* ptr = (uint8_t*)pkt;
-
-    for (int j = 0; j < HeadFlit::MAX_DATA_SIZE; j++)
-    {
-	if (byte_count < sizeof(T))
-	{
-	    hf->data[j] = *ptr;
-	    ptr++;
-	    byte_count++;
-	}
-	else {
-	    break;
-        }
-    }
+    unsigned byte_count = serial_size < (unsigned)HeadFlit::MAX_DATA_SIZE ? serial_size : HeadFlit::MAX_DATA_SIZE;
+    memcpy(hf->data, &m_serial_buf[0], byte_count);
     
     hf->data_len = byte_count;
     flp->add(hf);
@@ -791,17 +828,11 @@ GenNetworkInterface<T>::to_flit_level_packet(FlitLevelPacket* flp, T* pkt, manif
         bf->term = hf->term;
         flp->add(bf);
         
-        for (int j = 0; j < HeadFlit::MAX_DATA_SIZE; j++)
-        {
-            if (byte_count < sizeof(T))
-            {
-                bf->data[j] = *ptr;
-                ptr++;
-                byte_count++;
-            }
-	    else
-	       break;
-        }
+        unsigned n = serial_size - byte_count;
+        if(n > (unsigned)HeadFlit::MAX_DATA_SIZE)
+            n = HeadFlit::MAX_DATA_SIZE;
+        memcpy(bf->data, &m_serial_buf[byte_count], n);
+        byte_count += n;
     }
 
     //generate tail flits
@@ -850,6 +881,36 @@ bool GenNetworkInterface<T> :: try_send_to_terminal()
 }
 
 
+template<typename T>
+void GenNetworkInterface<T> :: checkpoint(manifold::kernel::CheckpointOut& out)
+{
+    assert(input_pkt_buffer.size() == 0 && output_pkt_buffer.size() == 0);
+    for(unsigned i=0; i<no_vcs; i++) {
+        assert(is_proc_out_buffer_free(i));
+        assert(router_out_buffer.is_empty(i) && router_in_buffer.is_empty(i));
+    }
+
+    out.write(no_vcs);
+    out.write(upstream_credits);
+    for(unsigned i=0; i<no_vcs; i++)
+        out.write(downstream_credits[i]);
+    out.write(last_inpkt_winner);
+}
+
+
+template<typename T>
+void GenNetworkInterface<T> :: restore(manifold::kernel::CheckpointIn& in)
+{
+    unsigned v;
+    in.read(v);
+    assert(v == no_vcs);
+    in.read(upstream_credits);
+    for(unsigned i=0; i<no_vcs; i++)
+        in.read(downstream_credits[i]);
+    in.read(last_inpkt_winner);
+}
+
+
 template<typename T>
 void GenNetworkInterface<T> :: print_stats(std::ostream& out)
 {
@@ -935,23 +996,8 @@ void GenNetworkInterface<T> :: do_output_to_terminal_prediction()
 #endif
     }
 
-    //Pull entire packets from proc_in_buffer in a round-robin manner.
-    bool found = false;
-    const unsigned start_ch = last_inpkt_winner + 1;
-    for ( unsigned i=0; i<no_vcs ; i++) {
-        unsigned ch = start_ch + i;
-	if(ch >= no_vcs) //wrap around
-	    ch -= no_vcs;
-	if(proc_in_buffer[ch].has_whole_packet())
-	{
-	    //a whole packet has been received.
-            found = true;
-            break;
-        }
-    }
-
-    //if ( found && (output_pkt_buffer.size() < UPSTREAM_BUFFER_SIZE) ) {
-    if (found) {
+    //if a whole packet has been received, no prediction
+    if (proc_in_ready_mask != 0) {
 //cerr << "@ " << manifold::kernel::Manifold::NowTicks() << " NI " << get_id() << " no pred - whole packet\n";
 	bp->update_output_tick(now);
         return;
@@ -760,6 +760,123 @@ public:
 
 
 
+    //======================================================================
+    //======================================================================
+    //! @brief Test do_route_computing() with bypass: state change; FULL->SW_TRAVERSAL
+    //!
+    //! Create a SimpleRouter with bypass in a 4-node ring network. The router's id is 1.
+    //! Enter a head flit from its interface and one from the West port, both destined
+    //! to East. Call do_route_computing(); verify the first flit skips VC and switch
+    //! allocation and goes to SW_TRAVERSAL with its output VC and the switch granted, and
+    //! the second, which finds the output port requested, goes to VCA_REQUESTED.
+    //! Call do_switch_traversal(); verify the first flit is sent.
+    void test_do_route_computing_bypass_0()
+    {
+	const unsigned VCS = 4; //must be 4
+
+	router_init_params router_params;
+	router_params.no_nodes = 4;
+	router_params.grid_size = 2; 
+	router_params.no_ports = 5;
+	router_params.no_vcs = VCS;
+	router_params.credits = 4;
+	router_params.rc_method= RING_ROUTING;
+	router_params.bypass = true;
+
+	unsigned NODE_ID = 1;
+
+	//do_switch_traversal() calls Send(), so must connect components.
+
+	//create a SimpleRouter, a Sink as interface, and a Sink as another router.
+	CompId_t if_id = Component :: Create<SinkRouter> (0);
+	SinkRouter* iface = Component :: GetComponent<SinkRouter>(if_id);
+
+	CompId_t router_id = Component :: Create<SimpleRouter> (0, NODE_ID, &router_params);
+	SimpleRouter* router = Component :: GetComponent<SimpleRouter>(router_id);
+
+	CompId_t sink_id = Component :: Create<SinkRouter> (0);
+	SinkRouter* sink = Component :: GetComponent<SinkRouter>(sink_id);
+
+	//connect the router to the other components
+	Manifold::Connect(router_id, SimpleRouter::PORT_NI, if_id, SinkRouter::IN,
+                          &SinkRouter::handle_input,1);
+
+	Manifold::Connect(router_id, SimpleRouter::PORT_EAST, sink_id, SinkRouter::IN,
+                          &SinkRouter::handle_input,1);
+
+
+	HeadFlit* hflit0 = new HeadFlit();
+	hflit0->src_id = NODE_ID;  //from interface
+	hflit0->dst_id = NODE_ID + 1;  //to East
+	hflit0->mclass = PROC_REQ;
+	hflit0->pkt_length = 1;
+
+	LinkData* lkdata0 = new LinkData();
+	lkdata0->type = FLIT;
+	lkdata0->f = hflit0;
+	const unsigned VC0 = random() % VCS;
+	lkdata0->vc = VC0;
+
+	HeadFlit* hflit1 = new HeadFlit();
+	hflit1->src_id = NODE_ID - 1;  //from West
+	hflit1->dst_id = NODE_ID + 1;  //to East
+	hflit1->mclass = PROC_REQ;
+
+	LinkData* lkdata1 = new LinkData();
+	lkdata1->type = FLIT;
+	lkdata1->f = hflit1;
+	const unsigned VC1 = random() % VCS;
+	lkdata1->vc = VC1;
+
+
+	//enter the flits into the router
+	router->handle_link_arrival(SimpleRouter::PORT_NI, lkdata0);
+	router->handle_link_arrival(SimpleRouter::PORT_WEST, lkdata1);
+
+	CPPUNIT_ASSERT_EQUAL(FULL, router->input_buffer_state[SimpleRouter::PORT_NI*VCS + VC0].pipe_stage);
+	CPPUNIT_ASSERT_EQUAL(FULL, router->input_buffer_state[SimpleRouter::PORT_WEST*VCS + VC1].pipe_stage);
+
+	//############################
+	router->do_route_computing();
+	//############################
+
+	//the first flit skips VCA and SA
+	const InputBufferState& ibs = router->input_buffer_state[SimpleRouter::PORT_NI*VCS + VC0];
+	CPPUNIT_ASSERT_EQUAL(SW_TRAVERSAL, ibs.pipe_stage);
+	CPPUNIT_ASSERT_EQUAL((unsigned)SimpleRouter::PORT_EAST, ibs.output_port);
+	CPPUNIT_ASSERT_EQUAL(true, ibs.sa_head_done);
+	CPPUNIT_ASSERT_EQUAL(true, (bool)router->vca->ovc_taken[ibs.output_port][ibs.output_channel]);
+	CPPUNIT_ASSERT_EQUAL(true, (bool)router->swa->requested[ibs.output_port][SimpleRouter::PORT_NI*VCS + VC0]);
+	CPPUNIT_ASSERT_EQUAL(1, (int)router->stat_packets_bypassed);
+
+	//the second doesn't
+	CPPUNIT_ASSERT_EQUAL(VCA_REQUESTED, router->input_buffer_state[SimpleRouter::PORT_WEST*VCS + VC1].pipe_stage);
+
+	//############################
+        router->do_switch_traversal();
+	//############################
+
+	CPPUNIT_ASSERT_EQUAL(0, (int)router->in_buffers[SimpleRouter::PORT_NI]->get_occupancy(VC0));
+
+	Manifold::unhalt();
+	Manifold::StopAt(Manifold::NowTicks() + 2); //ensure stop at time is > link delay
+	Manifold::Run();
+
+	//verify delivery of flit
+	vector<LinkData*> ldata = sink->get_data();
+	CPPUNIT_ASSERT_EQUAL(1, (int)ldata.size());
+	CPPUNIT_ASSERT_EQUAL(FLIT, ldata[0]->type);
+	CPPUNIT_ASSERT_EQUAL((Flit*)hflit0, ldata[0]->f);
+
+	delete router;
+	delete iface;
+	delete sink;
+    } 
+
+    
+
+
+
     //======================================================================
     //======================================================================
     //! @brief Test do_switch_traversal(): state change; FULL->VCA_REQUESTED->
@@ -1300,6 +1417,7 @@ public:
 	mySuite->addTest(new CppUnit::TestCaller<SimpleRouterTest>("test_do_switch_allocation_0", &SimpleRouterTest::test_do_switch_allocation_0));
 	mySuite->addTest(new CppUnit::TestCaller<SimpleRouterTest>("test_do_switch_allocation_1", &SimpleRouterTest::test_do_switch_allocation_1));
 	mySuite->addTest(new CppUnit::TestCaller<SimpleRouterTest>("test_do_switch_traversal_0", &SimpleRouterTest::test_do_switch_traversal_0));
+	mySuite->addTest(new CppUnit::TestCaller<SimpleRouterTest>("test_do_route_computing_bypass_0", &SimpleRouterTest::test_do_route_computing_bypass_0));
 	mySuite->addTest(new CppUnit::TestCaller<SimpleRouterTest>("test_do_switch_traversal_1", &SimpleRouterTest::test_do_switch_traversal_1));
 	mySuite->addTest(new CppUnit::TestCaller<SimpleRouterTest>("test_do_switch_traversal_2", &SimpleRouterTest::test_do_switch_traversal_2));
 	mySuite->addTest(new CppUnit::TestCaller<SimpleRouterTest>("test_do_switch_traversal_3", &SimpleRouterTest::test_do_switch_traversal_3));
@@ -218,14 +218,16 @@ public:
         CPPUNIT_ASSERT_EQUAL(uint(GnI->router_out_buffer.get_buffers().size()), GnI->no_vcs);
         CPPUNIT_ASSERT_EQUAL(uint(GnI->proc_out_buffer.size()), GnI->no_vcs);
         CPPUNIT_ASSERT_EQUAL(uint(GnI->proc_in_buffer.size()), GnI->no_vcs);
-        CPPUNIT_ASSERT_EQUAL(uint(GnI->is_proc_out_buffer_free.size()), GnI->no_vcs);
+        CPPUNIT_ASSERT_EQUAL(uint(__builtin_popcountll(GnI->proc_out_free_mask)), GnI->no_vcs); //one bit per VC
+        CPPUNIT_ASSERT_EQUAL(uint64_t(0), GnI->proc_out_busy_mask);
+        CPPUNIT_ASSERT_EQUAL(uint64_t(0), GnI->proc_in_ready_mask);
         CPPUNIT_ASSERT_EQUAL(uint(GnI->downstream_credits.size()), GnI->no_vcs);
         //CPPUNIT_ASSERT_EQUAL(uint(GnI->router_ob_packet_complete.size()), GnI->no_vcs);
         
         //test whether the inital value are correct
         for (unsigned i = 0; i < GnI->no_vcs; i++)
         {
-            CPPUNIT_ASSERT_EQUAL(bool(GnI->is_proc_out_buffer_free[i]), true);
+            CPPUNIT_ASSERT_EQUAL(bool(GnI->is_proc_out_buffer_free(i)), true);
             //CPPUNIT_ASSERT_EQUAL(bool(GnI->router_ob_packet_complete[i]), false); 
             CPPUNIT_ASSERT_EQUAL(uint(GnI->downstream_credits[i]), GnI->credits); 
         }
@@ -1232,7 +1234,7 @@ public:
         for (unsigned i = 0; i < GnI->no_vcs; i++)
         {
 	    if(i % 2 == 0) {
-		CPPUNIT_ASSERT_EQUAL(false, bool(GnI->is_proc_out_buffer_free[i]));
+		CPPUNIT_ASSERT_EQUAL(false, bool(GnI->is_proc_out_buffer_free(i)));
 		CPPUNIT_ASSERT_EQUAL(total_flits, GnI->proc_out_buffer[i].size());
 		count++;
 	    }
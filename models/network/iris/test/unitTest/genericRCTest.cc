@@ -178,6 +178,326 @@ public:
 
     
 
+    //! The direction from my to dest in a ring of n routers, the same way route_ring()
+    //! picks it: down_port towards smaller indices, up_port towards larger ones.
+    //! @param \c dist  Set to the hops to go in that direction.
+    static unsigned ring_direction(unsigned my, unsigned dest, unsigned n, unsigned down_port, unsigned up_port, unsigned& dist)
+    {
+	const unsigned up = (dest + n - my) % n; //hops going up
+	bool go_up;
+	if(dest > my)
+	    go_up = !(dest - my > n/2);
+	else
+	    go_up = (my - dest > n/2);
+	dist = go_up ? up : n - up;
+	return go_up ? up_port : down_port;
+    }
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test route_ring() and route_torus() with express links
+    //!
+    //! Create a GenericRC for RING_ROUTING and one for TORUS_ROUTING with a random express
+    //! link length K; generate N HeadFlits with random destinations; verify a packet takes
+    //! the express port of its direction if and only if it has at least K hops to go in
+    //! that direction.
+    void test_route_express_0()
+    {
+	const unsigned VCS = random() % 5 + 1; //1 to 5 virtual channels
+	const unsigned X = random() % 13 + 4; //4 to 16
+	const unsigned Y = random() % 13 + 4; //4 to 16
+	const unsigned K = random() % ((X < Y ? X : Y)/2 - 1) + 2; //2 to min(X,Y)/2
+
+	GenericRCSettings ring_setting;
+	ring_setting.grid_size = X;
+	ring_setting.no_nodes = X;
+	ring_setting.node_id = random() % X;
+	ring_setting.rc_method = RING_ROUTING;
+	ring_setting.express_hops = K;
+
+	GenericRCSettings torus_setting;
+	torus_setting.grid_size = X;
+	torus_setting.no_nodes = X * Y;
+	torus_setting.node_id = random() % (X * Y);
+	torus_setting.rc_method = TORUS_ROUTING;
+	torus_setting.express_hops = K;
+
+	GenericRC* ring_rc = new GenericRC(VCS, ring_setting);
+	GenericRC* torus_rc = new GenericRC(VCS, torus_setting);
+
+	const unsigned NODE_X = torus_setting.node_id % X; // the torus router's X-Y coordinates
+	const unsigned NODE_Y = torus_setting.node_id / X;
+
+	const int N = 1000;
+
+	for(int i=0; i<N; i++) {
+	    HeadFlit* hflit = new HeadFlit;
+	    while((hflit->dst_id = random() % X) == ring_setting.node_id); //not self
+
+	    ring_rc->possible_out_ports.clear(); //as push() does
+	    ring_rc->possible_out_vcs.clear();
+            ring_rc->route_ring(hflit);
+
+	    unsigned dist;
+	    unsigned port = ring_direction(ring_setting.node_id, hflit->dst_id, X, SimpleRouter::PORT_WEST, SimpleRouter::PORT_EAST, dist);
+	    if(dist >= K)
+		port += SimpleRouter::PORT_EXPRESS_WEST - SimpleRouter::PORT_WEST;
+	    CPPUNIT_ASSERT_EQUAL(port, (unsigned)ring_rc->possible_out_ports.back());
+
+	    while((hflit->dst_id = random() % (X * Y)) == torus_setting.node_id); //not self
+
+	    torus_rc->possible_out_ports.clear(); //as push() does
+	    torus_rc->possible_out_vcs.clear();
+            torus_rc->route_torus(hflit);
+
+	    unsigned destx = hflit->dst_id % X; //destination's x-y coordinates
+	    unsigned desty = hflit->dst_id / X;
+	    if(NODE_X != destx) //route X first
+		port = ring_direction(NODE_X, destx, X, SimpleRouter::PORT_WEST, SimpleRouter::PORT_EAST, dist);
+	    else
+		port = ring_direction(NODE_Y, desty, Y, SimpleRouter::PORT_NORTH, SimpleRouter::PORT_SOUTH, dist);
+	    if(dist >= K)
+		port += SimpleRouter::PORT_EXPRESS_WEST - SimpleRouter::PORT_WEST;
+	    CPPUNIT_ASSERT_EQUAL(port, (unsigned)torus_rc->possible_out_ports.back());
+
+	    delete hflit;
+	}
+
+	delete ring_rc;
+	delete torus_rc;
+    }
+
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test route_mesh() for XY and YX
+    //!
+    //! Create a GenericRC for XY and one for YX in a random concentrated mesh; generate N
+    //! HeadFlits with random destinations; verify the selected output port is correct,
+    //! including the local port for a terminal on the same router.
+    void test_route_mesh_0()
+    {
+	const unsigned X = random() % 9 + 2; //2 to 10
+	const unsigned Y = random() % 9 + 2; //2 to 10
+	const unsigned C = random() % 4 + 1; //concentration: 1 to 4
+
+	GenericRCSettings setting;
+	setting.grid_size = X;
+	setting.no_nodes = X * Y;
+	setting.node_id = random() % (X * Y);
+	setting.concentration = C;
+	setting.port = SimpleRouter::PORT_NI;
+
+	setting.rc_method = XY;
+	GenericRC* rc_xy = new GenericRC(2, setting);
+	setting.rc_method = YX;
+	GenericRC* rc_yx = new GenericRC(2, setting);
+
+	const int NODE_X = setting.node_id % X; // the router's X-Y coordinates
+	const int NODE_Y = setting.node_id / X;
+
+	const int N = 1000;
+
+	for(int i=0; i<N; i++) {
+	    HeadFlit* hflit = new HeadFlit;
+	    hflit->src_id = setting.node_id * C;
+	    hflit->dst_id = random() % (X * Y * C);
+
+	    rc_xy->push(hflit, 0);
+	    rc_yx->push(hflit, 0);
+	    CPPUNIT_ASSERT_EQUAL(1, (int)rc_xy->get_possible_output_ports(0).size());
+	    CPPUNIT_ASSERT_EQUAL(1, (int)rc_yx->get_possible_output_ports(0).size());
+	    const int xy_port = rc_xy->get_possible_output_ports(0)[0];
+	    const int yx_port = rc_yx->get_possible_output_ports(0)[0];
+
+	    const int destx = (hflit->dst_id / C) % X; //destination router's x-y coordinates
+	    const int desty = (hflit->dst_id / C) / X;
+	    const int xport = (destx > NODE_X) ? SimpleRouter::PORT_EAST : SimpleRouter::PORT_WEST;
+	    const int yport = (desty > NODE_Y) ? SimpleRouter::PORT_SOUTH : SimpleRouter::PORT_NORTH;
+
+	    if(destx == NODE_X && desty == NODE_Y) { //local terminal
+		const unsigned local = hflit->dst_id % C;
+		const int expected = (local == 0) ? (int)SimpleRouter::PORT_NI : (int)(SimpleRouter::PORT_MC + local - 1);
+		CPPUNIT_ASSERT_EQUAL(expected, xy_port);
+		CPPUNIT_ASSERT_EQUAL(expected, yx_port);
+	    }
+	    else {
+		CPPUNIT_ASSERT_EQUAL((destx != NODE_X) ? xport : yport, xy_port);
+		CPPUNIT_ASSERT_EQUAL((desty != NODE_Y) ? yport : xport, yx_port);
+	    }
+
+	    delete hflit;
+	}
+
+	delete rc_xy;
+	delete rc_yx;
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test route_mesh() for WEST_FIRST and ODD_EVEN
+    //!
+    //! Create a GenericRC for every input port of every router of a random mesh; route N
+    //! packets between random terminals, at each hop randomly picking one of the
+    //! candidate ports; verify every candidate is productive, the packet arrives in the
+    //! minimal number of hops, and no turn forbidden by the turn model is taken.
+    void test_route_mesh_1()
+    {
+	const unsigned X = random() % 9 + 2; //2 to 10
+	const unsigned Y = random() % 9 + 2; //2 to 10
+	const unsigned PORTS = 5;
+
+	const ROUTING_SCHEME methods[] = { WEST_FIRST, ODD_EVEN };
+	for(int m=0; m<2; m++) {
+	    vector<GenericRC*> rcs(X * Y * PORTS); //router r, port p: rcs[r*PORTS + p]
+	    for(unsigned r=0; r<X*Y; r++) {
+		for(unsigned p=0; p<PORTS; p++) {
+		    GenericRCSettings setting;
+		    setting.grid_size = X;
+		    setting.no_nodes = X * Y;
+		    setting.node_id = r;
+		    setting.rc_method = methods[m];
+		    setting.port = p;
+		    rcs[r*PORTS + p] = new GenericRC(2, setting);
+		}
+	    }
+
+	    const int N = 1000;
+	    for(int i=0; i<N; i++) {
+		HeadFlit* hflit = new HeadFlit;
+		hflit->src_id = random() % (X * Y);
+		hflit->dst_id = random() % (X * Y);
+
+		int x = hflit->src_id % X;
+		int y = hflit->src_id / X;
+		const int destx = hflit->dst_id % X;
+		const int desty = hflit->dst_id / X;
+		const int min_hops = abs(destx - x) + abs(desty - y);
+
+		unsigned inport = SimpleRouter::PORT_NI;
+		int prev_dir = -1; //the direction of the last hop
+		int hops = 0;
+		while(true) {
+		    GenericRC* rc = rcs[(y * X + x) * PORTS + inport];
+		    rc->push(hflit, 0);
+		    const vector<uint>& ports = rc->get_possible_output_ports(0);
+		    CPPUNIT_ASSERT(ports.size() > 0);
+
+		    if(x == destx && y == desty) {
+			CPPUNIT_ASSERT_EQUAL(1, (int)ports.size());
+			CPPUNIT_ASSERT_EQUAL((int)SimpleRouter::PORT_NI, (int)ports[0]);
+			break;
+		    }
+
+		    for(unsigned j=0; j<ports.size(); j++) { //all productive
+			switch(ports[j]) {
+			    case SimpleRouter::PORT_EAST: CPPUNIT_ASSERT(destx > x); break;
+			    case SimpleRouter::PORT_WEST: CPPUNIT_ASSERT(destx < x); break;
+			    case SimpleRouter::PORT_SOUTH: CPPUNIT_ASSERT(desty > y); break;
+			    case SimpleRouter::PORT_NORTH: CPPUNIT_ASSERT(desty < y); break;
+			    default: CPPUNIT_ASSERT(0);
+			}
+		    }
+
+		    const int dir = ports[random() % ports.size()];
+		    const bool vertical = (dir == SimpleRouter::PORT_NORTH || dir == SimpleRouter::PORT_SOUTH);
+		    const bool prev_vertical = (prev_dir == SimpleRouter::PORT_NORTH || prev_dir == SimpleRouter::PORT_SOUTH);
+		    if(methods[m] == WEST_FIRST) {
+			//no turn into west
+			if(dir == SimpleRouter::PORT_WEST)
+			    CPPUNIT_ASSERT(prev_dir == -1 || prev_dir == SimpleRouter::PORT_WEST);
+		    }
+		    else {
+			//no east-to-vertical turn in an even column
+			if(prev_dir == SimpleRouter::PORT_EAST && vertical)
+			    CPPUNIT_ASSERT(x % 2 == 1);
+			//no vertical-to-west turn in an odd column
+			if(prev_vertical && dir == SimpleRouter::PORT_WEST)
+			    CPPUNIT_ASSERT(x % 2 == 0);
+		    }
+
+		    switch(dir) {
+			case SimpleRouter::PORT_EAST: x++; inport = SimpleRouter::PORT_WEST; break;
+			case SimpleRouter::PORT_WEST: x--; inport = SimpleRouter::PORT_EAST; break;
+			case SimpleRouter::PORT_SOUTH: y++; inport = SimpleRouter::PORT_NORTH; break;
+			case SimpleRouter::PORT_NORTH: y--; inport = SimpleRouter::PORT_SOUTH; break;
+		    }
+		    prev_dir = dir;
+		    hops++;
+		}
+		CPPUNIT_ASSERT_EQUAL(min_hops, hops);
+
+		delete hflit;
+	    }
+
+	    for(unsigned j=0; j<rcs.size(); j++)
+		delete rcs[j];
+	}
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test route_mesh() for O1TURN
+    //!
+    //! Create a ReqReplyRC for O1TURN at the local port; route packets that need both X
+    //! and Y hops; verify they alternate between XY on VC 0 and YX on VC 2. Then create
+    //! one at a router-to-router port; verify the VC class of the input VC is kept.
+    void test_route_mesh_2()
+    {
+	const unsigned X = 4;
+	const unsigned Y = 4;
+
+	GenericRCSettings setting;
+	setting.grid_size = X;
+	setting.no_nodes = X * Y;
+	setting.node_id = 5; //(1, 1)
+	setting.rc_method = O1TURN;
+	setting.port = SimpleRouter::PORT_NI;
+
+	ReqReplyRC* rc = new ReqReplyRC(4, setting);
+
+	HeadFlit* hflit = new HeadFlit;
+	hflit->src_id = 5;
+	hflit->dst_id = 15; //(3, 3)
+	hflit->mclass = PROC_REQ;
+
+	for(int i=0; i<10; i++) {
+	    rc->push(hflit, 0);
+	    if(i % 2 == 0) {
+		CPPUNIT_ASSERT_EQUAL((int)SimpleRouter::PORT_EAST, (int)rc->get_output_port(0));
+		CPPUNIT_ASSERT_EQUAL(0, (int)rc->get_virtual_channel(0));
+	    }
+	    else {
+		CPPUNIT_ASSERT_EQUAL((int)SimpleRouter::PORT_SOUTH, (int)rc->get_output_port(0));
+		CPPUNIT_ASSERT_EQUAL(2, (int)rc->get_virtual_channel(0));
+	    }
+	}
+	delete rc;
+
+	setting.port = SimpleRouter::PORT_WEST;
+	rc = new ReqReplyRC(4, setting);
+
+	//class 1 (YX), request
+	rc->push(hflit, 2);
+	CPPUNIT_ASSERT_EQUAL((int)SimpleRouter::PORT_SOUTH, (int)rc->get_output_port(2));
+	CPPUNIT_ASSERT_EQUAL(2, (int)rc->get_virtual_channel(2));
+
+	//class 0 (XY), reply
+	hflit->mclass = MC_RESP;
+	rc->push(hflit, 1);
+	CPPUNIT_ASSERT_EQUAL((int)SimpleRouter::PORT_EAST, (int)rc->get_output_port(1));
+	CPPUNIT_ASSERT_EQUAL(1, (int)rc->get_virtual_channel(1));
+
+	delete hflit;
+	delete rc;
+    }
+
+
+
+
     //! Build a test suite.
     static CppUnit::Test* suite()
     {
@@ -185,6 +505,10 @@ public:
 
 	mySuite->addTest(new CppUnit::TestCaller<GenericRCTest>("test_route_ring_0", &GenericRCTest::test_route_ring_0));
 	mySuite->addTest(new CppUnit::TestCaller<GenericRCTest>("test_route_torus_0", &GenericRCTest::test_route_torus_0));
+	mySuite->addTest(new CppUnit::TestCaller<GenericRCTest>("test_route_express_0", &GenericRCTest::test_route_express_0));
+	mySuite->addTest(new CppUnit::TestCaller<GenericRCTest>("test_route_mesh_0", &GenericRCTest::test_route_mesh_0));
+	mySuite->addTest(new CppUnit::TestCaller<GenericRCTest>("test_route_mesh_1", &GenericRCTest::test_route_mesh_1));
+	mySuite->addTest(new CppUnit::TestCaller<GenericRCTest>("test_route_mesh_2", &GenericRCTest::test_route_mesh_2));
 	return mySuite;
     }
 };
@@ -203,11 +203,12 @@ public:
 	    NetworkPacket* pkt = new NetworkPacket;
 	    pkt->type = MY_COH_TYPE;
 
-	    Coh_msg& msg = *((Coh_msg*)(pkt->data));
+	    Coh_msg msg;
 	    msg.addr = random();
 	    msg.forward_id = random() % 1024;
 	    msg.msg = mt;
 	    msg.rw = random() % 2;
+	    pkt->set_data(msg);
 
 	    pkt->src = random() % 1024;
 	    pkt->src_port = random() % 1024;
@@ -246,13 +247,15 @@ public:
 		   CPPUNIT_ASSERT_EQUAL(flp->flits[i]->type, BODY);
 	    }
 
-	    //verify data in the flits are correct
-	    char buf[sizeof(NetworkPacket)];
+	    //verify data in the flits are correct: the flits carry the serialized packet.
+	    const unsigned serial_size = manifold::kernel::Get_serialize_size<NetworkPacket>(pkt);
+	    unsigned char buf[HeadFlit::MAX_DATA_SIZE * 2];
+	    CPPUNIT_ASSERT(serial_size <= sizeof(buf));
 
-	    int count = 0;
+	    unsigned count = 0;
 
 	    for(int j=0; j<HeadFlit::MAX_DATA_SIZE; j++) {
-	       if(count < sizeof(NetworkPacket)) {
+	       if(count < serial_size) {
 		   buf[count] = static_cast<HeadFlit*>(flp->flits[0])->data[j];
 		   count++;
 	       }
@@ -262,19 +265,19 @@ public:
 
 	    for(int i=0; i<n_flits-1; i++) {
 	       for(int j=0; j<HeadFlit::MAX_DATA_SIZE; j++) {
-		   if(count < sizeof(NetworkPacket)) {
+		   if(count < serial_size) {
 		       buf[count] = static_cast<BodyFlit*>(flp->flits[i+1])->data[j];
 		       count++;
 		   }
 		   else
 		       break;
 	       }
-	       if(count >= sizeof(NetworkPacket))
+	       if(count >= serial_size)
 		   break;
 	    }
 
-	    //reconstruct a Coh_msg object from the body flits.
-	    NetworkPacket* recv_pkt1 = (NetworkPacket*)buf;
+	    //reconstruct a Coh_msg object from the flit data.
+	    NetworkPacket* recv_pkt1 = manifold::kernel::Deserialize<NetworkPacket>(buf);
 	    Coh_msg* td1 = (Coh_msg*)(recv_pkt1->data);
 
 	    //also test from_flit_level_packet
@@ -303,6 +306,7 @@ public:
 	    CPPUNIT_ASSERT_EQUAL(msg.rw, td2->rw);
 
 	    delete pkt;
+	    delete recv_pkt1;
 	    delete recv_pkt2;
 	    delete flp;
 	}//for
@@ -355,7 +359,7 @@ public:
 	    pkt->dst = random() % 1024;
 	    pkt->dst_port = random() % 1024;
 
-	    Mem_msg& msg = *((Mem_msg*)(pkt->data));
+	    Mem_msg msg;
 	    msg.addr = random();
 
             switch(i) {
@@ -375,7 +379,7 @@ public:
 		    assert(0);
 		    break;
 	    }
-
+	    pkt->set_data(msg);
 
 
 	    unsigned n_bytes = HeadFlit::HEAD_FLIT_OVERHEAD + slen->get_simulated_len(pkt);
@@ -408,13 +412,15 @@ public:
 		   CPPUNIT_ASSERT_EQUAL(flp->flits[i]->type, BODY);
 	    }
 
-	    //verify data in the flits are correct
-	    char buf[sizeof(NetworkPacket)];
+	    //verify data in the flits are correct: the flits carry the serialized packet.
+	    const unsigned serial_size = manifold::kernel::Get_serialize_size<NetworkPacket>(pkt);
+	    unsigned char buf[HeadFlit::MAX_DATA_SIZE * 2];
+	    CPPUNIT_ASSERT(serial_size <= sizeof(buf));
 
-	    int count = 0;
+	    unsigned count = 0;
 
 	    for(int j=0; j<HeadFlit::MAX_DATA_SIZE; j++) {
-	       if(count < sizeof(NetworkPacket)) {
+	       if(count < serial_size) {
 		   buf[count] = static_cast<HeadFlit*>(flp->flits[0])->data[j];
 		   count++;
 	       }
@@ -424,19 +430,19 @@ public:
 
 	    for(int i=0; i<n_flits-1; i++) {
 	       for(int j=0; j<HeadFlit::MAX_DATA_SIZE; j++) {
-		   if(count < sizeof(NetworkPacket)) {
+		   if(count < serial_size) {
 		       buf[count] = static_cast<BodyFlit*>(flp->flits[i+1])->data[j];
 		       count++;
 		   }
 		   else
 		       break;
 	       }
-	       if(count >= sizeof(NetworkPacket))
+	       if(count >= serial_size)
 		   break;
 	    }
 
-	    //reconstruct a Coh_msg object from the body flits.
-	    NetworkPacket* recv_pkt1 = (NetworkPacket*)buf;
+	    //reconstruct a Mem_msg object from the flit data.
+	    NetworkPacket* recv_pkt1 = manifold::kernel::Deserialize<NetworkPacket>(buf);
 	    Mem_msg* td1 = (Mem_msg*)(recv_pkt1->data);
 
 	    //also test from_flit_level_packet
@@ -461,6 +467,7 @@ public:
 	    CPPUNIT_ASSERT_EQUAL(msg.op_type, td2->op_type);
 
 	    delete pkt;
+	    delete recv_pkt1;
 	    delete recv_pkt2;
 	    delete flp;
 	}//for
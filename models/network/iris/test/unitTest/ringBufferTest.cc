@@ -0,0 +1,130 @@
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <iostream>
+#include <deque>
+#include <stdlib.h>
+#include "../../data_types/ringBuffer.h"
+
+using namespace std;
+using namespace manifold::iris;
+
+
+//####################################################################
+//! Class RingBufferTest is the test class for class RingBuffer.
+//####################################################################
+class RingBufferTest : public CppUnit::TestFixture {
+private:
+
+public:
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test the constructor.
+    //!
+    //! Create a RingBuffer with a random capacity; verify the capacity is the
+    //! smallest power of 2 not less than the requested one, and the buffer is empty.
+    void test_constructor_0()
+    {
+	const unsigned CAP = random() % 1000 + 1;
+
+	RingBuffer<int> rb(CAP);
+
+	unsigned expected = 1;
+	while(expected < CAP)
+	    expected *= 2;
+	CPPUNIT_ASSERT_EQUAL(expected, rb.capacity());
+	CPPUNIT_ASSERT_EQUAL(0U, rb.size());
+	CPPUNIT_ASSERT_EQUAL(true, rb.empty());
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test push_back() and pop_front().
+    //!
+    //! Create a small RingBuffer; randomly push and pop N times, with the occupancy
+    //! wrapping around and growing past the capacity; verify the elements come out
+    //! in the same order as from a deque.
+    void test_push_pop_0()
+    {
+	RingBuffer<int> rb(4);
+	deque<int> dq;
+
+	const int N = 100000;
+	for(int i=0; i<N; i++) {
+	    if(dq.empty() || random() % 100 < 52) {
+		int x = random();
+		rb.push_back(x);
+		dq.push_back(x);
+	    }
+	    else {
+		CPPUNIT_ASSERT_EQUAL(dq.front(), rb.front());
+		rb.pop_front();
+		dq.pop_front();
+	    }
+	    CPPUNIT_ASSERT_EQUAL((unsigned)dq.size(), rb.size());
+	    CPPUNIT_ASSERT(rb.size() <= rb.capacity());
+	}
+
+	while(!dq.empty()) {
+	    CPPUNIT_ASSERT_EQUAL(dq.front(), rb.front());
+	    rb.pop_front();
+	    dq.pop_front();
+	}
+	CPPUNIT_ASSERT_EQUAL(true, rb.empty());
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test the capacity doesn't grow when the occupancy is bounded.
+    //!
+    //! Create a RingBuffer of capacity C; push and pop N times while keeping at
+    //! most C elements; verify the capacity is unchanged.
+    void test_push_pop_1()
+    {
+	const unsigned C = 8;
+	RingBuffer<int> rb(C);
+
+	const int N = 10000;
+	for(int i=0; i<N; i++) {
+	    if(rb.size() < C && (rb.empty() || random() % 2 == 0))
+		rb.push_back(i);
+	    else
+		rb.pop_front();
+	}
+	CPPUNIT_ASSERT_EQUAL(C, rb.capacity());
+    }
+
+
+
+
+    //! Build a test suite.
+    static CppUnit::Test* suite()
+    {
+	CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("RingBufferTest");
+
+	mySuite->addTest(new CppUnit::TestCaller<RingBufferTest>("test_constructor_0", &RingBufferTest::test_constructor_0));
+	mySuite->addTest(new CppUnit::TestCaller<RingBufferTest>("test_push_pop_0", &RingBufferTest::test_push_pop_0));
+	mySuite->addTest(new CppUnit::TestCaller<RingBufferTest>("test_push_pop_1", &RingBufferTest::test_push_pop_1));
+	return mySuite;
+    }
+};
+
+
+int main()
+{
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( RingBufferTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+
+}
+
@@ -42,6 +42,9 @@ if [ $? -ne 0 ]; then FAIL=1; fi
 eval ./ringTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
+eval ./ringBufferTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 eval ./RRSimpleRouterTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
@@ -63,6 +66,9 @@ if [ $? -ne 0 ]; then FAIL=1; fi
 eval ./mcpCacheTest $OUT
 if [ $? -ne 0 ]; then FAIL=1; fi
 
+eval ./trafficGeneratorTest $OUT
+if [ $? -ne 0 ]; then FAIL=1; fi
+
 
 exit $FAIL
 
@@ -0,0 +1,212 @@
+#include <TestFixture.h>
+#include <TestAssert.h>
+#include <TestSuite.h>
+#include <Test.h>
+#include <TestCaller.h>
+#include <cppunit/ui/text/TestRunner.h>
+
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include "../../components/trafficGenerator.h"
+
+#include "kernel/manifold.h"
+#include "kernel/component.h"
+
+using namespace manifold::kernel;
+using namespace std;
+using namespace manifold::iris;
+
+
+//####################################################################
+//! Class TrafficGeneratorTest is the test class for class TrafficGenerator.
+//####################################################################
+class TrafficGeneratorTest : public CppUnit::TestFixture {
+private:
+
+public:
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test get_dest() for uniform traffic.
+    //!
+    //! Create a TrafficGenerator for uniform traffic; call get_dest() N times;
+    //! verify the source is never picked and every other terminal is picked.
+    void test_get_dest_uniform_0()
+    {
+	traffic_gen_init_params params;
+	params.pattern = TP_UNIFORM;
+	params.x_dim = random() % 8 + 2;
+	params.y_dim = random() % 8 + 1;
+	const unsigned NODES = params.x_dim * params.y_dim;
+	const unsigned ID = random() % NODES;
+
+	TrafficGenerator* gen = new TrafficGenerator(ID, &params);
+
+	vector<unsigned> count(NODES, 0);
+	const int N = 100 * NODES;
+	for(int i=0; i<N; i++) {
+	    int dest = gen->get_dest();
+	    CPPUNIT_ASSERT(dest >= 0 && dest < (int)NODES);
+	    count[dest]++;
+	}
+
+	for(unsigned i=0; i<NODES; i++) {
+	    if(i == ID)
+		CPPUNIT_ASSERT_EQUAL(0U, count[i]);
+	    else
+		CPPUNIT_ASSERT(count[i] > 0);
+	}
+	delete gen;
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test get_dest() for the permutation patterns.
+    //!
+    //! For each terminal of a grid, verify get_dest() returns the destination of
+    //! transpose, bit complement, tornado and neighbor, or -1 if the destination
+    //! is the terminal itself.
+    void test_get_dest_permutations_0()
+    {
+	const unsigned X = 4;
+	const unsigned Y = 4;
+
+	traffic_gen_init_params params;
+	params.x_dim = X;
+	params.y_dim = Y;
+
+	for(unsigned id=0; id<X*Y; id++) {
+	    const unsigned x = id % X;
+	    const unsigned y = id / X;
+
+	    params.pattern = TP_TRANSPOSE;
+	    TrafficGenerator gen0(id, &params);
+	    int expected = (x == y) ? -1 : (int)(x * X + y);
+	    CPPUNIT_ASSERT_EQUAL(expected, gen0.get_dest());
+
+	    params.pattern = TP_BIT_COMPLEMENT;
+	    TrafficGenerator gen1(id, &params);
+	    CPPUNIT_ASSERT_EQUAL((int)(X*Y - 1 - id), gen1.get_dest());
+
+	    params.pattern = TP_TORNADO;
+	    TrafficGenerator gen2(id, &params);
+	    CPPUNIT_ASSERT_EQUAL((int)(((y + 1) % Y) * X + (x + 1) % X), gen2.get_dest());
+
+	    params.pattern = TP_NEIGHBOR;
+	    TrafficGenerator gen3(id, &params);
+	    CPPUNIT_ASSERT_EQUAL((int)(y * X + (x + 1) % X), gen3.get_dest());
+	}
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test get_dest() for hotspot traffic.
+    //!
+    //! Create a TrafficGenerator for hotspot traffic; call get_dest() N times;
+    //! verify the fraction of packets to the hotspot is about hotspot_fraction
+    //! plus its share of the uniform traffic.
+    void test_get_dest_hotspot_0()
+    {
+	traffic_gen_init_params params;
+	params.pattern = TP_HOTSPOT;
+	params.x_dim = 4;
+	params.y_dim = 4;
+	params.hotspot = 5;
+	params.hotspot_fraction = 0.3;
+	const unsigned NODES = params.x_dim * params.y_dim;
+
+	TrafficGenerator* gen = new TrafficGenerator(0, &params);
+
+	const int N = 100000;
+	int hot = 0;
+	for(int i=0; i<N; i++) {
+	    if(gen->get_dest() == params.hotspot)
+		hot++;
+	}
+	double expected = 0.3 + 0.7 / (NODES - 1);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, (double)hot / N, 0.01);
+
+	//the hotspot itself sends uniform traffic
+	TrafficGenerator* gen1 = new TrafficGenerator(params.hotspot, &params);
+	for(int i=0; i<1000; i++) {
+	    CPPUNIT_ASSERT(gen1->get_dest() != params.hotspot);
+	}
+	delete gen;
+	delete gen1;
+    }
+
+
+    //======================================================================
+    //======================================================================
+    //! @brief Test inject_this_cycle() for Bernoulli and bursty injection.
+    //!
+    //! Verify the fraction of cycles with a packet equals the rate for both;
+    //! verify bursty injection produces runs of the average burst length.
+    void test_inject_this_cycle_0()
+    {
+	traffic_gen_init_params params;
+	params.x_dim = 4;
+	params.y_dim = 4;
+	params.rate = 0.2;
+
+	const int N = 200000;
+
+	params.injection = INJ_BERNOULLI;
+	TrafficGenerator gen0(3, &params);
+	int injected = 0;
+	for(int i=0; i<N; i++) {
+	    if(gen0.inject_this_cycle())
+		injected++;
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, (double)injected / N, 0.01);
+
+	params.injection = INJ_BURSTY;
+	params.burst_len = 10;
+	TrafficGenerator gen1(3, &params);
+	injected = 0;
+	int bursts = 0;
+	bool prev = false;
+	for(int i=0; i<N; i++) {
+	    bool inj = gen1.inject_this_cycle();
+	    if(inj) {
+		injected++;
+		if(!prev)
+		    bursts++;
+	    }
+	    prev = inj;
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, (double)injected / N, 0.02);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, (double)injected / bursts, 1.0);
+    }
+
+
+
+
+    //! Build a test suite.
+    static CppUnit::Test* suite()
+    {
+	CppUnit::TestSuite* mySuite = new CppUnit::TestSuite("TrafficGeneratorTest");
+
+	mySuite->addTest(new CppUnit::TestCaller<TrafficGeneratorTest>("test_get_dest_uniform_0", &TrafficGeneratorTest::test_get_dest_uniform_0));
+	mySuite->addTest(new CppUnit::TestCaller<TrafficGeneratorTest>("test_get_dest_permutations_0", &TrafficGeneratorTest::test_get_dest_permutations_0));
+	mySuite->addTest(new CppUnit::TestCaller<TrafficGeneratorTest>("test_get_dest_hotspot_0", &TrafficGeneratorTest::test_get_dest_hotspot_0));
+	mySuite->addTest(new CppUnit::TestCaller<TrafficGeneratorTest>("test_inject_this_cycle_0", &TrafficGeneratorTest::test_inject_this_cycle_0));
+	return mySuite;
+    }
+};
+
+
+int main()
+{
+    CppUnit::TextUi::TestRunner runner;
+    runner.addTest( TrafficGeneratorTest::suite() );
+    if(runner.run("", false))
+	return 0; //all is well
+    else
+	return 1;
+
+}
+
@@ -54,8 +54,8 @@ void instQ_t::push_back(inst_t *inst)
     if(src_flag_mask&0x01)
       fprintf(stderr,"SPX_QSIM_DEBUG (core %d) | %lu:       src flag %d\n",inst->core->core_id,inst->core->clock_cycle,i);
   }
-  for(map<uint64_t,inst_t*>::iterator it = inst->src_dep.begin(); it != inst->src_dep.end(); it++)
-    fprintf(stderr,"SPX_QSIM_DEBUG (core %d) | %lu:       mem dep 0x%x\n",inst->core->core_id,inst->core->clock_cycle,it->second->data.paddr);
+  for(size_t i = 0; i < inst->src_dep.size(); i++)
+    fprintf(stderr,"SPX_QSIM_DEBUG (core %d) | %lu:       mem dep 0x%x\n",inst->core->core_id,inst->core->clock_cycle,inst->src_dep[i]->data.paddr);
   if(inst->memcode != SPX_MEM_NONE)
     fprintf(stderr,"SPX_QSIM_DEBUG (core %d) | %lu:       mem %s 0x%x\n",inst->core->core_id,inst->core->clock_cycle,(inst->memcode==SPX_MEM_ST)?"STORE":"LOAD",inst->data.paddr);
   uint64_t dest_reg_mask = inst->dest_reg;
@@ -102,8 +102,8 @@ void instQ_t::push_back(inst_t *inst)
     if(src_flag_mask&0x01)
       fprintf(stderr,"SPX_DEBUG (core %d) | %lu:       src flag %d\n",inst->core->core_id,inst->core->clock_cycle,i);
   }
-  for(map<uint64_t,inst_t*>::iterator it = inst->src_dep.begin(); it != inst->src_dep.end(); it++)
-    fprintf(stderr,"SPX_DEBUG (core %d) | %lu:       mem dep 0x%x\n",inst->core->core_id,inst->core->clock_cycle,it->second->data.paddr);
+  for(size_t i = 0; i < inst->src_dep.size(); i++)
+    fprintf(stderr,"SPX_DEBUG (core %d) | %lu:       mem dep 0x%x\n",inst->core->core_id,inst->core->clock_cycle,inst->src_dep[i]->data.paddr);
   if(inst->memcode != SPX_MEM_NONE)
     fprintf(stderr,"SPX_DEBUG (core %d) | %lu:       mem %s 0x%x\n",inst->core->core_id,inst->core->clock_cycle,(inst->memcode==SPX_MEM_ST)?"STORE":"LOAD",inst->data.paddr);
   uint64_t dest_reg_mask = inst->dest_reg;
@@ -379,10 +379,10 @@ void RS_t::pop_front(int port) // It must be called after get_front().
 
 void RS_t::update(inst_t *inst)
 {
-  for(map<uint64_t,inst_t*>::iterator it = inst->dest_dep.begin(); it != inst->dest_dep.end(); it++)
+  for(size_t i = 0; i < inst->dest_dep.size(); i++)
   {
-    inst_t *dep_inst = it->second; // Dependent inst
-    dep_inst->src_dep.erase(dep_inst->src_dep.find(inst->uop_sequence)); // Remove dependency.
+    inst_t *dep_inst = inst->dest_dep[i]; // Dependent inst
+    dep_inst->src_dep.erase(inst); // Remove dependency.
 
     if((dep_inst->src_dep.size() == 0)&&(dep_inst->port > -1)) // Dependent inst is now ready to execute.
     {
@@ -502,9 +502,9 @@ void RF_t::resolve_dependency(inst_t *inst)
 #endif
 
       // Source inst knows which subsequent insts are dependent on its dest regs.
-      regs[i]->dest_dep.insert(pair<int,inst_t*>(inst->uop_sequence,inst));
+      regs[i]->dest_dep.insert(inst);
       // Depenedent inst know which precendent insts it is dependent on.
-      inst->src_dep.insert(pair<int,inst_t*>(regs[i]->uop_sequence,regs[i]));
+      inst->src_dep.insert(regs[i]);
     }
   }
 
@@ -520,9 +520,9 @@ void RF_t::resolve_dependency(inst_t *inst)
 #endif
 
       // Source inst knows which subsequent insts are dependent on its dest regs.
-      flags[i]->dest_dep.insert(pair<int,inst_t*>(inst->uop_sequence,inst));
+      flags[i]->dest_dep.insert(inst);
       // Depenedent inst know which precendent insts it is dependent on.
-      inst->src_dep.insert(pair<int,inst_t*>(flags[i]->uop_sequence,flags[i]));
+      inst->src_dep.insert(flags[i]);
     }
   }
 
@@ -584,8 +584,8 @@ void RF_t::resolve_dependency(inst_t *inst)
 #endif
         if(fregs[fregs_stack_ptr]&&fregs[fregs_stack_ptr]->inflight)
         {
-          fregs[fregs_stack_ptr]->dest_dep.insert(pair<uint64_t,inst_t*>(inst->uop_sequence,inst));
-          inst->src_dep.insert(pair<uint64_t,inst_t*>(fregs[fregs_stack_ptr]->uop_sequence,fregs[fregs_stack_ptr]));
+          fregs[fregs_stack_ptr]->dest_dep.insert(inst);
+          inst->src_dep.insert(fregs[fregs_stack_ptr]);
         }
         fregs[fregs_stack_ptr] = NULL;
         inst->src_freg |= (0x01<<fregs_stack_ptr); // ST0
@@ -619,8 +619,8 @@ void RF_t::resolve_dependency(inst_t *inst)
 
         if(fregs[fregs_stack_ptr]&&fregs[fregs_stack_ptr]->inflight)
         {
-          fregs[fregs_stack_ptr]->dest_dep.insert(pair<uint64_t,inst_t*>(inst->uop_sequence,inst));
-          inst->src_dep.insert(pair<uint64_t,inst_t*>(fregs[fregs_stack_ptr]->uop_sequence,fregs[fregs_stack_ptr]));
+          fregs[fregs_stack_ptr]->dest_dep.insert(inst);
+          inst->src_dep.insert(fregs[fregs_stack_ptr]);
         }
         inst->src_freg |= (0x01<<fregs_stack_ptr); // ST0
 
@@ -646,8 +646,8 @@ void RF_t::resolve_dependency(inst_t *inst)
 #endif
         if(fregs[ST1]&&fregs[ST1]->inflight)
         {
-          fregs[ST1]->dest_dep.insert(pair<uint64_t,inst_t*>(inst->uop_sequence,inst));
-          inst->src_dep.insert(pair<uint64_t,inst_t*>(fregs[ST1]->uop_sequence,fregs[ST1]));
+          fregs[ST1]->dest_dep.insert(inst);
+          inst->src_dep.insert(fregs[ST1]);
         }
         inst->src_freg |= (0x01<<ST1); // ST0
 
@@ -1026,6 +1026,19 @@ STQ_t::STQ_t(pipeline_t *pl, int STQ_size) :
 size(STQ_size), occupancy(0), pipeline(pl)
 {
   outgoing.reserve(size);
+  mem_disamb.reserve(size);
+}
+
+// There is at most one entry per store in STQ, so a linear search is cheaper than a tree.
+vector<pair<uint64_t,inst_t*> >::iterator STQ_t::mem_disamb_find(uint64_t paddr)
+{
+  vector<pair<uint64_t,inst_t*> >::iterator it = mem_disamb.begin();
+  for(; it != mem_disamb.end(); it++)
+  {
+    if(it->first == paddr)
+      break;
+  }
+  return it;
 }
 
 STQ_t::~STQ_t()
@@ -1043,11 +1056,11 @@ void STQ_t::push_back(inst_t *inst)
 
   // Memory disambiguation map for store forwarding.
   // Since store inst is not yet executed, it is like a perfect prediction for memory disambiguation.
-  map<uint64_t,inst_t*>::iterator it = mem_disamb.find(inst->data.paddr);
+  vector<pair<uint64_t,inst_t*> >::iterator it = mem_disamb_find(inst->data.paddr);
   if(it != mem_disamb.end())
     it->second = inst; // Replace the latest producer of this address.
   else
-    mem_disamb.insert(pair<uint64_t,inst_t*>(inst->data.paddr,inst));
+    mem_disamb.push_back(pair<uint64_t,inst_t*>(inst->data.paddr,inst));
 
 #ifdef LIBEI
   // Search an empty entry
@@ -1093,9 +1106,12 @@ void STQ_t::handle_cache()
 #endif
 
     // Since store is written back when the ROB commits, clear memory disambiguation map.
-    map<uint64_t,inst_t*>::iterator mem_disamb_it = mem_disamb.find(inst->data.paddr);
+    vector<pair<uint64_t,inst_t*> >::iterator mem_disamb_it = mem_disamb_find(inst->data.paddr);
     if((mem_disamb_it != mem_disamb.end())&&(mem_disamb_it->second == inst))
-      mem_disamb.erase(mem_disamb_it);
+    {
+      *mem_disamb_it = mem_disamb.back();
+      mem_disamb.pop_back();
+    }
 
     // Send cache request.
     cache_request_t *cache_request = new cache_request_t(inst,inst->core->core_id,inst->core->node_id,inst->data.paddr,SPX_MEM_ST);
@@ -1105,7 +1121,7 @@ void STQ_t::handle_cache()
     
     // Remove from STQ
     pop(inst);
-    delete inst;
+    pipeline->inst_pool.release(inst);
 #ifdef LIBEI
     pipeline->counters->stq.read++;
 #endif
@@ -1148,7 +1164,7 @@ void STQ_t::store_forward(inst_t *inst)
 void STQ_t::mem_disamb_check(inst_t *inst)
 {
   // Check if memory disambiguation exists; perfect prediction for memory disambiguation.
-  map<uint64_t,inst_t*>::iterator it = mem_disamb.find(inst->data.paddr);
+  vector<pair<uint64_t,inst_t*> >::iterator it = mem_disamb_find(inst->data.paddr);
   if(it != mem_disamb.end())
   {
 #ifdef SPX_DEBUG
@@ -191,7 +191,9 @@ class STQ_t
   int size;
   int occupancy;
  private:
-  std::map<uint64_t,inst_t*> mem_disamb;
+  std::vector<std::pair<uint64_t,inst_t*> >::iterator mem_disamb_find(uint64_t paddr);
+
+  std::vector<std::pair<uint64_t,inst_t*> > mem_disamb; // latest store to each address
   std::vector<inst_t*> outgoing;
 //  int size;
 //  int occupancy;
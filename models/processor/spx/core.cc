@@ -70,8 +70,31 @@ clock(clk)
       pipeline->Qsim_osd->set_mem_cb(pipeline,&pipeline_t::Qsim_mem_cb);
       pipeline->Qsim_osd->set_reg_cb(pipeline,&pipeline_t::Qsim_reg_cb);
       pipeline->Qsim_osd->set_app_end_cb(pipeline,&pipeline_t::Qsim_app_end_cb);
+
+      // Optionally record the Qsim callbacks into a per-core trace file.
+      if(parser.exists("trace_record"))
+      {
+        const char *prefix = parser.lookup("trace_record");
+        char trace_file[1024];
+        snprintf(trace_file,sizeof(trace_file),"%s.%d",prefix,core_id);
+        pipeline->trace_out = new trace_writer_t(trace_file,core_id);
+      }
       fprintf(stdout,"=== core %d with qsim_lib : ",core_id);
     }
+    else if(parser.exists("trace")) // Replay per-core trace files without Qsim.
+    {
+      pipeline->config.qsim = SPX_QSIM_TRACE;
+
+#ifdef IPA_CTRL
+      ipa = new ipa_t();
+#endif
+
+      const char *prefix = parser.lookup("trace");
+      char trace_file[1024];
+      snprintf(trace_file,sizeof(trace_file),"%s.%d",prefix,core_id);
+      pipeline->trace = new trace_reader_t(trace_file,core_id);
+      fprintf(stdout,"=== core %d with trace %s : ",core_id,trace_file);
+    }
     else // Otherwise, assume Qsim client.
     {
 #if 0
@@ -88,12 +111,18 @@ clock(clk)
 #endif
     }
 
+    // Mops retired per cycle in functional mode of sampled simulation
+    if(parser.exists("functional_width"))
+      pipeline->config.functional_width = parser.lookup("functional_width");
+
     // Fastforward instructions.
     uint64_t fastfwd = parser.lookup("fastfwd");
     while(fastfwd-- > 0)
     {
       if(pipeline->config.qsim == SPX_QSIM_LIB)
         pipeline->Qsim_osd->run(core_id,1);
+      else if(pipeline->config.qsim == SPX_QSIM_TRACE)
+        pipeline->trace->run(NULL);
       else {} // SPX_QSIM_CLIENT
         //pipeline->Qsim_client->run(core_id,1);
     }
@@ -216,6 +245,11 @@ void spx_core_t::tick()
 
 void spx_core_t::handle_cache_response(int temp, cache_request_t *cache_request)
 {
+  if(!cache_request->inst) // response to a request sent in functional mode
+  {
+    delete cache_request;
+    return;
+  }
   pipeline->handle_cache_response(temp,cache_request);
 }
 
@@ -4,6 +4,7 @@
 #include "qsim.h"
 #include "kernel/component.h"
 #include "kernel/clock.h"
+#include "kernel/sampler.h"
 #include "pipeline.h"
 
 //#define SPX_QSIM_DEBUG_ 1
@@ -29,7 +30,7 @@ class ipa_t
 };
 #endif
 
-class spx_core_t : public manifold::kernel::Component
+class spx_core_t : public manifold::kernel::Component, public manifold::kernel::Sampled_core
 {
 public:
   spx_core_t(manifold::kernel::Clock *clk, const int nodeID, Qsim::OSDomain *osd, const char *configFileName, const int coreID);
@@ -42,6 +43,12 @@ public:
   void tick();
   void handle_cache_response(int temp, cache_request_t *cache_request);
 
+  // sampled simulation
+  void set_functional(bool functional) { pipeline->functional = functional; }
+  bool is_drained() { return pipeline->is_drained(); }
+  uint64_t get_retired() { return pipeline->stats.uop_count; }
+  void set_fetch_stalled(bool stalled) { pipeline->fetch_stalled = stalled; }
+
   int node_id; // manifold node ID
   int core_id; // processor ID
   uint64_t clock_cycle;
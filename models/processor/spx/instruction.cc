@@ -6,77 +6,63 @@ using namespace std;
 using namespace manifold;
 using namespace manifold::spx;
 
-inst_t::inst_t(spx_core_t *spx_core, int Mop_seq, int uop_seq) :
-core(spx_core),
-Mop_sequence(Mop_seq),
-uop_sequence(uop_seq),
-split_store(false),
-split_load(false),
-is_idle(false),
-is_head(true),
-is_tail(true),
-opcode(QSIM_INST_INTBASIC),
-memcode(SPX_MEM_NONE),
-excode(-1),
-port(-1),
-inflight(false),
-completed_cycle(0),
-src_reg(0),
-src_flag(0),
-src_freg(0),
-dest_reg(0),
-dest_flag(0),
-dest_freg(0),
-mem_disamb_status(SPX_MEM_DISAMB_NONE),
-prev_inst(NULL),
-next_inst(NULL),
-Mop_head(this),
-Mop_length(1),
-is_long_inst(false)
+void inst_t::init(spx_core_t *spx_core, int Mop_seq, int uop_seq)
 {
+  core = spx_core;
+  Mop_sequence = Mop_seq;
+  uop_sequence = uop_seq;
+  split_store = false;
+  split_load = false;
+  is_idle = false;
+  is_head = true;
+  is_tail = true;
+  opcode = QSIM_INST_INTBASIC;
+  memcode = SPX_MEM_NONE;
+  excode = -1;
+  port = -1;
+  inflight = false;
+  completed_cycle = 0;
+  src_reg = 0;
+  src_flag = 0;
+  src_freg = 0;
+  dest_reg = 0;
+  dest_flag = 0;
+  dest_freg = 0;
+  mem_disamb_status = SPX_MEM_DISAMB_NONE;
+  prev_inst = NULL;
+  next_inst = NULL;
+  Mop_head = this;
+  Mop_length = 1;
+  is_long_inst = false;
+
   op.vaddr = 0;
   op.paddr = 0;
   data.vaddr = 0;
   data.paddr = 0;
+  ipa = ipa_inst();
+
+  dest_dep.clear();
+  src_dep.clear();
+  mem_disamb.clear();
 }
 
-inst_t::inst_t(inst_t *inst, spx_core_t *spx_core, int Mop_seq, int uop_seq, int mem_code) :
-core(spx_core),
-Mop_sequence(Mop_seq),
-uop_sequence(uop_seq),
-split_store(false),
-split_load(false),
-is_idle(false),
-is_head(false),
-is_tail(true),
-opcode(inst->opcode),
-memcode(mem_code),
-excode(-1),
-port(-1),
-inflight(false),
-completed_cycle(0),
-src_reg(0),
-src_flag(0),
-src_freg(0),
-dest_reg(0),
-dest_flag(0),
-dest_freg(0),
-mem_disamb_status(SPX_MEM_DISAMB_NONE),
-prev_inst(inst),
-next_inst(NULL),
-Mop_head(inst->Mop_head),
-Mop_length(0),
-is_long_inst(false)
+void inst_t::init(inst_t *inst, spx_core_t *spx_core, int Mop_seq, int uop_seq, int mem_code)
 {
+  init(spx_core,Mop_seq,uop_seq);
+  is_head = false;
+  opcode = inst->opcode;
+  memcode = mem_code;
+  prev_inst = inst;
+  Mop_head = inst->Mop_head;
+  Mop_length = 0;
+
   op.vaddr = inst->op.vaddr;
   op.paddr = inst->op.paddr;
-  data.vaddr = 0;
-  data.paddr = 0;
 
   if(inst->memcode == SPX_MEM_LD)
   {
-    inst->dest_dep.insert(pair<uint64_t,inst_t*>(uop_sequence,this));
-    src_dep.insert(pair<uint64_t,inst_t*>(inst->uop_sequence,inst));
+    inst->dest_dep.insert(this);
+    src_dep.insert(inst);
   }
   
   inst->next_inst = this;
@@ -90,12 +76,80 @@ inst_t::~inst_t()
   src_dep.clear();
 }
 
+void inst_dep_t::insert(inst_t *inst)
+{
+  // Insts are mostly inserted in program order, so search from the back.
+  size_t i = deps.size();
+  while((i > 0)&&(deps[i-1]->uop_sequence >= inst->uop_sequence))
+  {
+    if(deps[i-1]->uop_sequence == inst->uop_sequence)
+      return;
+    i--;
+  }
+  deps.insert(deps.begin()+i,inst);
+}
+
+void inst_dep_t::erase(inst_t *inst)
+{
+  for(vector<inst_t*>::iterator it = deps.begin(); it != deps.end(); it++)
+  {
+    if((*it)->uop_sequence == inst->uop_sequence)
+    {
+      deps.erase(it);
+      return;
+    }
+  }
+}
+
+inst_pool_t::~inst_pool_t()
+{
+  for(vector<inst_t*>::iterator it = chunks.begin(); it != chunks.end(); it++)
+    delete [] *it;
+}
+
+void inst_pool_t::reserve(int insts)
+{
+  if(num_insts < (size_t)insts)
+    grow(insts-num_insts);
+}
+
+void inst_pool_t::grow(int insts)
+{
+  inst_t *chunk = new inst_t[insts];
+  chunks.push_back(chunk);
+  num_insts += insts;
+  free_insts.reserve(num_insts);
+  for(int i = insts-1; i >= 0; i--)
+    free_insts.push_back(&chunk[i]);
+}
+
+inst_t* inst_pool_t::alloc(spx_core_t *spx_core, int Mop_seq, int uop_seq)
+{
+  if(free_insts.empty())
+    grow(num_insts ? num_insts : 64);
+  inst_t *inst = free_insts.back();
+  free_insts.pop_back();
+  inst->init(spx_core,Mop_seq,uop_seq);
+  return inst;
+}
+
+inst_t* inst_pool_t::alloc(inst_t *prev, spx_core_t *spx_core, int Mop_seq, int uop_seq, int mem_code)
+{
+  if(free_insts.empty())
+    grow(num_insts ? num_insts : 64);
+  inst_t *inst = free_insts.back();
+  free_insts.pop_back();
+  inst->init(prev,spx_core,Mop_seq,uop_seq,mem_code);
+  return inst;
+}
+
 cache_request_t::cache_request_t(inst_t *instruction, int rid, int sid, uint64_t paddr, int type) :
 inst(instruction),
 req_id(rid),
 source_id(sid),
 addr(paddr),
-op_type(type)
+op_type(type),
+pc(instruction ? instruction->op.vaddr : 0)
 {
 }
 
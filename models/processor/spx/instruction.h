@@ -43,13 +43,41 @@ class ipa_inst
 };
 
 
+class inst_t;
+
+// List of insts that an inst depends on or that depend on an inst, kept in
+// the order of uop_sequence. The list is a flat array; insts are recycled by
+// inst_pool_t, so its capacity is retained and no memory is allocated once
+// the pool is warmed up.
+class inst_dep_t
+{
+ public:
+  inst_dep_t() { deps.reserve(SPX_INST_DEP_RESERVE); }
+
+  enum { SPX_INST_DEP_RESERVE = 8 };
+
+  void insert(inst_t *inst); // no duplicates
+  void erase(inst_t *inst);
+  void clear() { deps.clear(); }
+  size_t size() const { return deps.size(); }
+  inst_t* operator[](size_t i) const { return deps[i]; }
+
+ private:
+  std::vector<inst_t*> deps;
+};
+
 class inst_t
 {
  public:
-  inst_t(spx_core_t *spx_core, int Mop_seq, int uop_seq);
-  inst_t(inst_t *inst, spx_core_t *spx_core, int Mop_seq, int uop_seq, int mem_code);
+  inst_t() {}
+  inst_t(spx_core_t *spx_core, int Mop_seq, int uop_seq) { init(spx_core,Mop_seq,uop_seq); }
+  inst_t(inst_t *inst, spx_core_t *spx_core, int Mop_seq, int uop_seq, int mem_code) { init(inst,spx_core,Mop_seq,uop_seq,mem_code); }
   ~inst_t();
 
+  // (Re)initialize a new Mop or the next uop of inst's Mop.
+  void init(spx_core_t *spx_core, int Mop_seq, int uop_seq);
+  void init(inst_t *inst, spx_core_t *spx_core, int Mop_seq, int uop_seq, int mem_code);
+
   // IDs
   spx_core_t *core;
   uint64_t Mop_sequence;
@@ -96,8 +124,8 @@ class inst_t
   uint8_t dest_flag;
   uint8_t dest_freg;
 
-  std::map<uint64_t,inst_t*> dest_dep; // dest dep; insts that depend on this inst
-  std::map<uint64_t,inst_t*> src_dep; // src dep; insts that this inst depends on
+  inst_dep_t dest_dep; // dest dep; insts that depend on this inst
+  inst_dep_t src_dep; // src dep; insts that this inst depends on
 
   // memory order control
   std::vector<inst_t*> mem_disamb;
@@ -112,6 +140,29 @@ class inst_t
   bool is_long_inst;
 };
 
+// Free list of insts. A pipeline reserves as many insts as can be in flight
+// (instQ, ROB, and STQ), so fetch and commit do not allocate memory. If the
+// pool runs out, it grows by another chunk.
+class inst_pool_t
+{
+ public:
+  inst_pool_t() : num_insts(0) {}
+  ~inst_pool_t();
+
+  void reserve(int num_insts);
+  inst_t* alloc(spx_core_t *spx_core, int Mop_seq, int uop_seq);
+  inst_t* alloc(inst_t *inst, spx_core_t *spx_core, int Mop_seq, int uop_seq, int mem_code);
+  void release(inst_t *inst) { free_insts.push_back(inst); }
+  size_t in_use() const { return num_insts-free_insts.size(); } // insts allocated and not released
+
+ private:
+  void grow(int num_insts);
+
+  std::vector<inst_t*> chunks; // arrays of insts
+  std::vector<inst_t*> free_insts;
+  size_t num_insts;
+};
+
 class cache_request_t
 {
 public:
@@ -127,8 +178,12 @@ public:
   int source_id;
   uint64_t addr;
   int op_type;
+  uint64_t pc; // vaddr of the instruction; used by cache prefetchers
 };
 
+// Found by the caches through argument-dependent lookup.
+inline uint64_t Get_pc(const cache_request_t *request) { return request->pc; }
+
 } // namespace spx
 } // namespace manifold
 
@@ -15,7 +15,11 @@ Mop_count(0),
 finished(0),
 runout_flag(0),
 trans_flag(0),
-uop_count(0)
+functional(false),
+fetch_stalled(false),
+uop_count(0),
+trace(NULL),
+trace_out(NULL)
 //EI_client(NULL)
 {
 }
@@ -94,6 +98,9 @@ void pipeline_t::Qsim_inst_cb(int core_id, uint64_t vaddr, uint64_t paddr, uint8
   fprintf(stderr,"\n");
   #endif
   
+  if(trace_out)
+    trace_out->inst(vaddr,paddr,type,Qsim_osd->get_prot(core_id) == Qsim::OSDomain::PROT_KERN);
+
   next_inst->opcode = type;
   next_inst->memcode = SPX_MEM_NONE;
   Qsim_cb_status = SPX_QSIM_INST_CB;
@@ -124,6 +131,9 @@ int pipeline_t::Qsim_mem_cb(int core_id, uint64_t vaddr, uint64_t paddr, uint8_t
   }
   fprintf(stderr,"\n");
   #endif
+
+  if(trace_out)
+    trace_out->mem(vaddr,paddr,size,type);
   
   if(type) // store
   {
@@ -136,7 +146,7 @@ int pipeline_t::Qsim_mem_cb(int core_id, uint64_t vaddr, uint64_t paddr, uint8_t
       //stats.uop_count++;
       stats.interval.uop_count++;
       //stats.interval.eff_uop_count++;
-      next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_ST);
+      next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_ST);
       
       #ifdef SPX_QSIM_DEBUG
       fprintf(stderr,"SPX_QSIM_DEBUG mem_cb (core %d): uop %lu (Mop %lu) | ",core_id,next_inst->uop_sequence,next_inst->Mop_sequence);
@@ -181,7 +191,7 @@ int pipeline_t::Qsim_mem_cb(int core_id, uint64_t vaddr, uint64_t paddr, uint8_t
       //stats.uop_count++;
       stats.interval.uop_count++;
       //stats.interval.eff_uop_count++;
-      next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_LD);
+      next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_LD);
       
       #ifdef SPX_QSIM_DEBUG
       fprintf(stderr,"SPX_QSIM_DEBUG mem_cb (core %d): uop %lu (Mop %lu) | ",core_id,next_inst->uop_sequence,next_inst->Mop_sequence);
@@ -244,6 +254,9 @@ void pipeline_t::Qsim_reg_cb(int core_id, int reg, uint8_t size, int type)
   }
   fprintf(stderr,"\n");
   #endif
+
+  if(trace_out)
+    trace_out->reg(reg,size,type);
   
   if(type) // dest
   {
@@ -258,7 +271,7 @@ void pipeline_t::Qsim_reg_cb(int core_id, int reg, uint8_t size, int type)
         //stats.uop_count++;
         stats.interval.uop_count++;
         //stats.interval.eff_uop_count++;
-        next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
+        next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
         
         #ifdef SPX_QSIM_DEBUG_
         fprintf(stderr,"SPX_QSIM_DEBUG reg_cb (core %d): uop %lu (Mop %lu) | ",core_id,next_inst->uop_sequence,next_inst->Mop_sequence);
@@ -304,7 +317,7 @@ void pipeline_t::Qsim_reg_cb(int core_id, int reg, uint8_t size, int type)
         //stats.uop_count++;
         stats.interval.uop_count++;
 	//stats.interval.eff_uop_count++;
-        next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
+        next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
         
         #ifdef SPX_QSIM_DEBUG_
         fprintf(stderr,"SPX_QSIM_DEBUG reg_cb (core %d): uop %lu (Mop %lu) | ",core_id,next_inst->uop_sequence,next_inst->Mop_sequence);
@@ -349,7 +362,7 @@ void pipeline_t::Qsim_reg_cb(int core_id, int reg, uint8_t size, int type)
         //stats.uop_count++;
         stats.interval.uop_count++;
 	//stats.interval.eff_uop_count++;
-        next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
+        next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
 
         #ifdef SPX_QSIM_DEBUG_
         fprintf(stderr,"SPX_QSIM_DEBUG reg_cb (core %d): uop %lu (Mop %lu) | ",core_id,next_inst->uop_sequence,next_inst->Mop_sequence);
@@ -390,7 +403,7 @@ void pipeline_t::Qsim_reg_cb(int core_id, int reg, uint8_t size, int type)
         //stats.uop_count++;
         stats.interval.uop_count++;
 	//stats.interval.eff_uop_count++;
-        next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
+        next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
         
         #ifdef SPX_QSIM_DEBUG_
         fprintf(stderr,"SPX_QSIM_DEBUG reg_cb (core %d): uop %lu (Mop %lu) | ",core_id,next_inst->uop_sequence,next_inst->Mop_sequence);
@@ -508,15 +521,15 @@ void pipeline_t::Qsim_post_cb(inst_t* inst)
   fprintf(stderr,"SPX_QSIM_DEBUG (core %d): uop %lu (Mop %lu) LS| ",inst->core->core_id,inst->uop_sequence,inst->Mop_sequence);
 #endif
         // create another inst that computes with a memory operand
-        next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
+        next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_NONE);
         next_inst->excode = inst->excode;
-        next_inst->src_dep.insert(pair<uint64_t,inst_t*>(inst->uop_sequence,inst));
+        next_inst->src_dep.insert(inst);
         next_inst->data.vaddr = 0;
         next_inst->data.paddr = 0;
 
         // previous inst is a load inst
         inst->excode = SPX_FU_LD;
-        inst->dest_dep.insert(pair<uint64_t,inst_t*>(next_inst->uop_sequence,next_inst));
+        inst->dest_dep.insert(next_inst);
         fetch(inst);
       }
       else
@@ -529,13 +542,13 @@ void pipeline_t::Qsim_post_cb(inst_t* inst)
   fprintf(stderr,"SPX_QSIM_DEBUG (core %d): uop %lu (Mop %lu) SS| ",inst->core->core_id,inst->uop_sequence,inst->Mop_sequence);
 #endif
         // create another inst that stores the result
-        next_inst = new inst_t(next_inst,core,Mop_count,++uop_count,SPX_MEM_ST);
+        next_inst = inst_pool.alloc(next_inst,core,Mop_count,++uop_count,SPX_MEM_ST);
         next_inst->excode = SPX_FU_ST;
-        next_inst->src_dep.insert(pair<uint64_t,inst_t*>(inst->uop_sequence,inst));
+        next_inst->src_dep.insert(inst);
         next_inst->src_reg |= inst->dest_reg; // this store depends on the result of a previous inst
         // previous inst is a compute inst
         inst->memcode = SPX_MEM_NONE;
-        inst->dest_dep.insert(pair<uint64_t,inst_t*>(next_inst->uop_sequence,next_inst));
+        inst->dest_dep.insert(next_inst);
         inst->data.vaddr = 0;
         inst->data.paddr = 0;
         fetch(inst);
@@ -548,6 +561,85 @@ void pipeline_t::Qsim_post_cb(inst_t* inst)
   }
 }
 
+// In functional mode, Mops are retired as soon as they are fetched, up to
+// functional_width Mops per cycle. Loads and stores are still sent to the cache
+// so that caches are warmed up; their responses are dropped by the core.
+void pipeline_t::functional_frontend()
+{
+  for(int fetched = 0; fetched < config.functional_width; fetched++)
+  {
+    if((config.qsim == SPX_QSIM_TRACE)&&trace->done()) {
+      if(runout_flag == 0) {
+        cerr << "@ " << dec << core->clock_cycle << " Core " << core->core_id << " : run out of insts" << endl;
+        runout_flag = 1;
+        finished = 1; // end of trace is the end of the application
+      }
+      break;
+    }
+
+    stats.Mop_count++;
+    stats.interval.Mop_count++;
+
+    if(config.qsim == SPX_QSIM_TRACE) {} // counted after the inst is read
+    else if(Qsim_osd->get_prot(core->core_id) == Qsim::OSDomain::PROT_KERN)
+      stats.KERN_count++;
+    else
+      stats.USER_count++;
+
+    next_inst = inst_pool.alloc(core,++Mop_count,++uop_count);
+
+    bool idle = false;
+    if(config.qsim == SPX_QSIM_LIB) {
+      int rc = Qsim_osd->run(core->core_id,1);
+      if (!rc&&!Qsim_osd->booted(core->core_id)) {
+        if(runout_flag == 0) {
+          cerr << "@ " << dec << core->clock_cycle << " Core " << core->core_id << " : run out of insts" << endl;
+          runout_flag = 1;
+        }
+      } else if(Qsim_osd->idle(core->core_id))
+        idle = true;
+    }
+    else if(config.qsim == SPX_QSIM_TRACE) {
+      trace->run(this);
+      if(trace->in_kernel())
+        stats.KERN_count++;
+      else
+        stats.USER_count++;
+    }
+
+    if(!next_inst->inflight)
+    {
+      Qsim_post_cb(next_inst);
+      fetch(next_inst);
+    }
+    next_inst = NULL;
+
+    // All uops of the Mop are retired; they can't be released earlier because
+    // the Qsim callbacks link each uop to the previous one.
+    for(vector<inst_t*>::iterator it = functional_insts.begin(); it != functional_insts.end(); it++)
+      inst_pool.release(*it);
+    functional_insts.clear();
+
+    if(idle) // let the idle loop advance with the clock
+      break;
+  }
+}
+
+void pipeline_t::functional_retire(inst_t *inst)
+{
+  stats.uop_count++;
+  stats.last_commit_cycle = core->clock_cycle;
+
+  if((inst->memcode == SPX_MEM_LD)||(inst->memcode == SPX_MEM_ST))
+  {
+    cache_request_t *cache_request = new cache_request_t(inst,core->core_id,core->node_id,inst->data.paddr,inst->memcode);
+    cache_request->inst = NULL; // no inst waits for the response
+    core->Send(core->OUT_TO_CACHE,cache_request);
+  }
+
+  functional_insts.push_back(inst);
+}
+
 int pipeline_t::Qsim_app_end_cb(int core_id)
 {
   finished = 1;
@@ -6,6 +6,7 @@
 //#include "qsim-client.h"
 #include "instruction.h"
 #include "component.h"
+#include "trace.h"
 
 #ifdef LIBEI
 //#include "ei-client.h"
@@ -41,16 +42,18 @@ enum SPX_QSIM_FRONTEND_TYPES
 {
   SPX_QSIM_LIB = 0,
   SPX_QSIM_CLIENT,
+  SPX_QSIM_TRACE, // replay of per-core trace files; Qsim is not used
   NUM_SPX_QSIM_FRONTEND_TYPES
 };
 
 class pipeline_config_t
 {
 public:
-  pipeline_config_t() {}
+  pipeline_config_t() : functional_width(1000) {}
   ~pipeline_config_t() {}
 
   int qsim;
+  int functional_width; // Mops retired per cycle in functional mode (sampled simulation)
   
   int fetch_width;
   int alloc_width;
@@ -226,7 +229,7 @@ class pipeline_t
 public:
   pipeline_t();
   //virtual ~pipeline_t() { delete Qsim_client; }
-  virtual ~pipeline_t() {  }
+  virtual ~pipeline_t() { delete trace; delete trace_out; }
   
   // pipeline functions
   virtual void commit() = 0;
@@ -241,6 +244,11 @@ public:
   void handle_idle_inst(inst_t *inst);
   bool is_nop(inst_t *inst);
 
+  // sampled simulation
+  void functional_frontend(); // retires Mops without timing
+  void functional_retire(inst_t *inst);
+  bool is_drained() { return inst_pool.in_use() == 0; } // no insts in flight
+
   // Qsim callback functions
   void Qsim_inst_cb(int core_id, uint64_t vaddr, uint64_t paddr, uint8_t len, const uint8_t *bytes, enum inst_type type);
   int Qsim_mem_cb(int core_id, uint64_t vaddr, uint64_t paddr, uint8_t size, int type);
@@ -249,12 +257,17 @@ public:
   int Qsim_app_end_cb(int core_id);
   Qsim::OSDomain *Qsim_osd; // Qsim OS domain
   //Qsim::Client *Qsim_client; // Qsim client
+  trace_reader_t *trace; // trace frontend (SPX_QSIM_TRACE)
+  trace_writer_t *trace_out; // records Qsim callbacks into a trace if not NULL
 
   pipeline_config_t config;
   pipeline_stats_t stats;
+  inst_pool_t inst_pool; // all insts of this pipeline are allocated from the pool
   int finished;
   int runout_flag;
   int trans_flag;
+  bool functional; // functional mode of sampled simulation
+  bool fetch_stalled; // stops fetching to drain the pipeline
 #ifdef LIBEI
   //libEI::client_t *EI_client;
   pipeline_counter_t *counters;
@@ -269,6 +282,7 @@ protected:
   uint64_t uop_count;
   int Qsim_cb_status;
   bool idle_loop; // Qsim is in idle loop
+  std::vector<inst_t*> functional_insts; // uops of the Mop being retired in functional mode
 };
 
 } //namespace manifold
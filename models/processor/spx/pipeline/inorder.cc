@@ -20,6 +20,9 @@ inorder_t::inorder_t(spx_core_t *spx_core, libconfig::Config *parser)
   RF = new RF_t((pipeline_t*)this);
   for(int i = 0; i < config.exec_width; i++)
     EX.push_back(new EX_t((pipeline_t*)this,i,config.FU_port,config.FU_delay,config.FU_issue_rate));
+
+  // Insts in flight: instQ, threadQ, EX, and stores waiting for cache responses.
+  inst_pool.reserve(config.instQ_size+config.exec_width+64);
 }
 
 inorder_t::~inorder_t()
@@ -174,7 +177,7 @@ void inorder_t::execute()
         {
           threadQ->update(inst); // wake up all dependent insts
           RF->writeback(inst); // commit result
-          delete inst;
+          inst_pool.release(inst);
           stats.last_commit_cycle = core->clock_cycle;
           break;
         }
@@ -246,17 +249,40 @@ void inorder_t::allocate()
 
 void inorder_t::frontend()
 {
-  if(instQ->is_available())
+  if(fetch_stalled) // draining the pipeline for sampled simulation
+  {
+    if(is_drained()) // an empty pipeline is not deadlocked
+      stats.last_commit_cycle = core->clock_cycle;
+    return;
+  }
+  if(functional)
+  {
+    functional_frontend();
+    return;
+  }
+
+  if((config.qsim == SPX_QSIM_TRACE)&&trace->done())
+  {
+    if(runout_flag == 0)
+    {
+      cerr << "@ " << dec << core->clock_cycle << " Core " << core->core_id << " : run out of insts" << endl;
+      runout_flag = 1;
+      finished = 1; // end of trace is the end of the application
+    }
+  }
+  else if(instQ->is_available())
   {
     stats.Mop_count++;
     stats.uop_count++;
     stats.interval.Mop_count++;
     stats.interval.uop_count++;
       
-    next_inst = new inst_t(core,++Mop_count,++uop_count);
+    next_inst = inst_pool.alloc(core,++Mop_count,++uop_count);
     
     if(config.qsim == SPX_QSIM_LIB)
       Qsim_osd->run(core->core_id,1);
+    else if(config.qsim == SPX_QSIM_TRACE)
+      trace->run(this);
     else {}// SPX_QSIM_CLIENT
       //Qsim_client->run(core->core_id,1);
       
@@ -289,6 +315,11 @@ void inorder_t::frontend()
 
 void inorder_t::fetch(inst_t *inst)
 {
+  if(functional)
+  {
+    functional_retire(inst);
+    return;
+  }
   instQ->push_back(inst);
 }
 
@@ -314,7 +345,7 @@ void inorder_t::handle_cache_response(int temp, cache_request_t *cache_request)
   }
 
   stats.last_commit_cycle = core->clock_cycle;
-  delete inst;
+  inst_pool.release(inst);
   delete cache_request;
 }
 
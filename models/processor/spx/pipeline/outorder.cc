@@ -23,6 +23,9 @@ outorder_t::outorder_t(spx_core_t *spx_core, libconfig::Config *parser)
   RF = new RF_t((pipeline_t*)this);
   for(int i = 0; i < config.exec_width; i++)
     EX.push_back(new EX_t((pipeline_t*)this,i,config.FU_port,config.FU_delay,config.FU_issue_rate));
+
+  // Insts in flight: instQ, ROB, committed stores in STQ, and the uops of Mops being fetched.
+  inst_pool.reserve(config.instQ_size+config.ROB_size+config.STQ_size+config.fetch_width*8);
 }
 
 outorder_t::~outorder_t()
@@ -199,7 +202,7 @@ void outorder_t::commit()
          //STQ->pop(inst);
          //delete inst;          
       } else
-        delete inst;
+        inst_pool.release(inst);
     }
     else // empty ROB or ROB head not completed
       break;
@@ -376,7 +379,13 @@ void outorder_t::frontend()
     core->clock_cycle,stats.last_commit_cycle = core->clock_cycle;
   }
 
-  if(idle_loop) {
+  if(idle_loop&&(config.qsim == SPX_QSIM_TRACE)) {
+    if(trace->idle()) // replay the recorded idle-loop cycles
+      return;
+    idle_loop = false;
+    stats.last_commit_cycle = core->clock_cycle;
+  }
+  else if(idle_loop) {
     int rc = Qsim_osd->run(core->core_id,1);
     if (!rc&&!Qsim_osd->booted(core->core_id)) {
       if(runout_flag == 0) {
@@ -385,6 +394,8 @@ void outorder_t::frontend()
       }
 		  //manifold :: kernel :: Manifold :: Terminate();      
     } else if(Qsim_osd->idle(core->core_id)) {
+      if(trace_out)
+        trace_out->idle();
       return ;
     } else { 
       //cerr << "@ " << dec << core->clock_cycle << " Core " << core->core_id << " : recover from idle" << endl;
@@ -394,6 +405,18 @@ void outorder_t::frontend()
     }
   }
 
+  if(fetch_stalled) // draining the pipeline for sampled simulation
+  {
+    if(is_drained()) // an empty pipeline is not deadlocked
+      stats.last_commit_cycle = core->clock_cycle;
+    return;
+  }
+  if(functional)
+  {
+    functional_frontend();
+    return;
+  }
+
 //#ifdef SPX_QSIM_DEBUG_
 #if 0
 if (core->core_id == 1) {
@@ -408,10 +431,20 @@ if (core->core_id == 1) {
   {
     if(instQ->is_available())
     {
+      if((config.qsim == SPX_QSIM_TRACE)&&trace->done()) {
+        if(runout_flag == 0) {
+          cerr << "@ " << dec << core->clock_cycle << " Core " << core->core_id << " : run out of insts" << endl;
+          runout_flag = 1;
+          finished = 1; // end of trace is the end of the application
+        }
+        break;
+      }
+
       stats.Mop_count++;
       stats.interval.Mop_count++;
       
-      if(Qsim_osd->get_prot(core->core_id) == Qsim::OSDomain::PROT_KERN) {
+      if(config.qsim == SPX_QSIM_TRACE) {} // counted after the inst is read
+      else if(Qsim_osd->get_prot(core->core_id) == Qsim::OSDomain::PROT_KERN) {
         stats.KERN_count++;
         //cerr << "@ " << dec << core->clock_cycle << " Core " << core->core_id << " : in KERN state" << endl;
       } else {
@@ -419,7 +452,7 @@ if (core->core_id == 1) {
         //cerr << "@ " << dec << core->clock_cycle << " Core " << core->core_id << " : in USER state" << endl;
      }
 
-      next_inst = new inst_t(core,++Mop_count,++uop_count);
+      next_inst = inst_pool.alloc(core,++Mop_count,++uop_count);
 
       if(config.qsim == SPX_QSIM_LIB) {
         int rc = Qsim_osd->run(core->core_id,1);
@@ -434,6 +467,15 @@ if (core->core_id == 1) {
           idle_loop = true;
         }
       } 
+      else if(config.qsim == SPX_QSIM_TRACE) {
+        trace->run(this);
+        if(trace->in_kernel())
+          stats.KERN_count++;
+        else
+          stats.USER_count++;
+        if(trace->get_idle_cycles()) // the instruction entered the idle loop
+          idle_loop = true;
+      }
       else {} // SPX_QSIM_CLIENT
         //Qsim_client->run(core->core_id,1);
       
@@ -472,6 +514,12 @@ if (core->core_id == 1) {
 
 void outorder_t::fetch(inst_t *inst)
 {
+  if(functional)
+  {
+    functional_retire(inst);
+    return;
+  }
+
 //#ifdef SPX_QSIM_DEBUG_
 #if 0
 if (inst->core->core_id == 1) {
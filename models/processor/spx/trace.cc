@@ -0,0 +1,287 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "trace.h"
+#include "pipeline.h"
+
+using namespace std;
+using namespace manifold;
+using namespace manifold::spx;
+
+static inline uint64_t zigzag(uint64_t delta) { return (delta<<1)^(uint64_t)((int64_t)delta>>63); }
+static inline uint64_t unzigzag(uint64_t value) { return (value>>1)^(0-(value&0x1)); }
+
+trace_writer_t::trace_writer_t(const char *file_name, int core_id) :
+last_inst_vaddr(0),
+last_inst_paddr(0),
+last_mem_vaddr(0),
+last_mem_paddr(0),
+inst_count(0),
+idle_cycles(0)
+{
+  file = fopen(file_name,"wb");
+  if(!file)
+  {
+    fprintf(stdout,"SPX_ERROR (core %d): cannot open trace file %s\n",core_id,file_name);
+    exit(1);
+  }
+
+  trace_header_t header;
+  header.magic = SPX_TRACE_MAGIC;
+  header.version = SPX_TRACE_VERSION;
+  header.core_id = core_id;
+  header.reserved = 0;
+  fwrite(&header,sizeof(header),1,file);
+
+  buffer.reserve(1<<16);
+}
+
+trace_writer_t::~trace_writer_t()
+{
+  close();
+}
+
+void trace_writer_t::put_byte(uint8_t byte)
+{
+  buffer.push_back(byte);
+}
+
+void trace_writer_t::put_varint(uint64_t value)
+{
+  while(value >= 0x80)
+  {
+    buffer.push_back((uint8_t)(value|0x80));
+    value >>= 7;
+  }
+  buffer.push_back((uint8_t)value);
+}
+
+void trace_writer_t::flush()
+{
+  if(buffer.size())
+    fwrite(&buffer[0],1,buffer.size(),file);
+  buffer.clear();
+}
+
+void trace_writer_t::put_idle()
+{
+  if(!idle_cycles)
+    return;
+  put_byte(SPX_TRACE_IDLE);
+  put_varint(idle_cycles);
+  idle_cycles = 0;
+}
+
+void trace_writer_t::inst(uint64_t vaddr, uint64_t paddr, int type, bool kernel)
+{
+  put_idle();
+  put_byte(SPX_TRACE_INST|((type&0x1f)<<2)|(kernel?0x80:0));
+  put_varint(zigzag(vaddr-last_inst_vaddr));
+  put_varint(zigzag(paddr-last_inst_paddr));
+  last_inst_vaddr = vaddr;
+  last_inst_paddr = paddr;
+  inst_count++;
+
+  if(buffer.size() >= (1<<16)-64)
+    flush();
+}
+
+void trace_writer_t::mem(uint64_t vaddr, uint64_t paddr, uint8_t size, int type)
+{
+  put_byte(SPX_TRACE_MEM|(type?0x4:0));
+  put_byte(size);
+  put_varint(zigzag(vaddr-last_mem_vaddr));
+  put_varint(zigzag(paddr-last_mem_paddr));
+  last_mem_vaddr = vaddr;
+  last_mem_paddr = paddr;
+}
+
+void trace_writer_t::reg(int reg, uint8_t size, int type)
+{
+  put_byte(SPX_TRACE_REG|(type?0x4:0));
+  put_byte((uint8_t)reg);
+  put_byte(size);
+}
+
+void trace_writer_t::idle()
+{
+  idle_cycles++;
+}
+
+void trace_writer_t::close()
+{
+  if(!file)
+    return;
+
+  put_idle();
+  put_byte(SPX_TRACE_END);
+  flush();
+  fclose(file);
+  file = NULL;
+}
+
+
+
+trace_reader_t::trace_reader_t(const char *file_name, int coreID, size_t window) :
+core_id(coreID),
+base(NULL),
+size(0),
+pos(sizeof(trace_header_t)),
+last_inst_vaddr(0),
+last_inst_paddr(0),
+last_mem_vaddr(0),
+last_mem_paddr(0),
+kernel(false),
+inst_count(0),
+idle_cycles(0)
+{
+  fd = open(file_name,O_RDONLY);
+  if(fd < 0)
+  {
+    fprintf(stdout,"SPX_ERROR (core %d): cannot open trace file %s\n",core_id,file_name);
+    exit(1);
+  }
+
+  struct stat st;
+  fstat(fd,&st);
+  size = st.st_size;
+  if(size < sizeof(trace_header_t))
+  {
+    fprintf(stdout,"SPX_ERROR (core %d): %s is not a trace file\n",core_id,file_name);
+    exit(1);
+  }
+
+  base = (const uint8_t*)mmap(NULL,size,PROT_READ,MAP_PRIVATE,fd,0);
+  if(base == MAP_FAILED)
+  {
+    fprintf(stdout,"SPX_ERROR (core %d): cannot map trace file %s\n",core_id,file_name);
+    exit(1);
+  }
+
+  const trace_header_t *header = (const trace_header_t*)base;
+  if((header->magic != SPX_TRACE_MAGIC)||(header->version != SPX_TRACE_VERSION))
+  {
+    fprintf(stdout,"SPX_ERROR (core %d): %s is not a trace file of version %u\n",core_id,file_name,SPX_TRACE_VERSION);
+    exit(1);
+  }
+  if((int)header->core_id != core_id)
+    fprintf(stdout,"SPX_WARNING (core %d): trace file %s was recorded by core %u\n",core_id,file_name,header->core_id);
+
+  // windows must be page aligned for madvise
+  size_t page_size = sysconf(_SC_PAGESIZE);
+  window_size = ((window+page_size-1)/page_size)*page_size;
+  window_end = 0;
+
+  madvise((void*)base,size,MADV_SEQUENTIAL);
+  next_window();
+}
+
+trace_reader_t::~trace_reader_t()
+{
+  munmap((void*)base,size);
+  ::close(fd);
+}
+
+// Called when the read position enters the window that has been prefetched.
+void trace_reader_t::next_window()
+{
+  if(window_end >= 2*window_size) // release the window that has been consumed
+    madvise((void*)(base+window_end-2*window_size),window_size,MADV_DONTNEED);
+
+  window_end += window_size;
+  if(window_end < size) // prefetch the following window
+    madvise((void*)(base+window_end),(size-window_end < window_size)?size-window_end:window_size,MADV_WILLNEED);
+}
+
+uint8_t trace_reader_t::get_byte()
+{
+  if(pos >= size)
+  {
+    fprintf(stdout,"SPX_ERROR (core %d): trace file truncated\n",core_id);
+    exit(1);
+  }
+  if(pos >= window_end)
+    next_window();
+  return base[pos++];
+}
+
+uint64_t trace_reader_t::get_varint()
+{
+  uint64_t value = 0;
+  int shift = 0;
+  uint8_t byte;
+  do
+  {
+    byte = get_byte();
+    value |= (uint64_t)(byte&0x7f)<<shift;
+    shift += 7;
+  } while(byte&0x80);
+  return value;
+}
+
+bool trace_reader_t::run(pipeline_t *pipeline)
+{
+  if(done())
+    return false;
+
+  uint8_t tag = get_byte();
+  if((tag&0x3) != SPX_TRACE_INST)
+  {
+    fprintf(stdout,"SPX_ERROR (core %d): corrupted trace at offset %lu\n",core_id,(unsigned long)pos-1);
+    exit(1);
+  }
+
+  last_inst_vaddr += unzigzag(get_varint());
+  last_inst_paddr += unzigzag(get_varint());
+  kernel = tag&0x80;
+  inst_count++;
+  idle_cycles = 0;
+  if(pipeline)
+    pipeline->Qsim_inst_cb(core_id,last_inst_vaddr,last_inst_paddr,0,NULL,(enum inst_type)((tag>>2)&0x1f));
+
+  // mem, reg and idle records up to the next inst
+  while(pos < size)
+  {
+    if(pos >= window_end)
+      next_window();
+
+    tag = base[pos];
+    switch(tag&0x3)
+    {
+      case SPX_TRACE_MEM:
+      {
+        pos++;
+        uint8_t mem_size = get_byte();
+        last_mem_vaddr += unzigzag(get_varint());
+        last_mem_paddr += unzigzag(get_varint());
+        if(pipeline)
+          pipeline->Qsim_mem_cb(core_id,last_mem_vaddr,last_mem_paddr,mem_size,(tag&0x4)?1:0);
+        break;
+      }
+      case SPX_TRACE_REG:
+      {
+        pos++;
+        int reg = get_byte();
+        uint8_t reg_size = get_byte();
+        if(pipeline)
+          pipeline->Qsim_reg_cb(core_id,reg,reg_size,(tag&0x4)?1:0);
+        break;
+      }
+      case SPX_TRACE_END:
+      {
+        if(tag != SPX_TRACE_IDLE)
+          return true;
+        pos++;
+        idle_cycles += get_varint();
+        break;
+      }
+      default: // SPX_TRACE_INST
+        return true;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,140 @@
+#ifndef __SPX_TRACE_H__
+#define __SPX_TRACE_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <cstddef>
+#include <vector>
+
+namespace manifold {
+namespace spx {
+
+// forward declaration
+class pipeline_t;
+
+/*
+  Per-core instruction trace.
+
+  A trace is the sequence of Qsim callbacks (inst, mem, reg) of one core, so
+  replaying it through pipeline_t::Qsim_*_cb produces exactly the same uops as
+  running Qsim. Each core reads its own file; no Qsim instance is needed, so
+  unlike with Qsim the cores can be placed in different LPs.
+
+  While Qsim is in its idle loop, the outorder pipeline fetches nothing and runs
+  one Qsim instruction per cycle; those instructions are not recorded. Instead,
+  the number of such cycles is recorded after the instruction that entered the
+  idle loop, so the replay stalls for the same number of cycles.
+
+  File layout: a header (magic, version, core ID) followed by records. Every
+  record starts with a tag byte whose low 2 bits are the record type.
+    INST: tag[2:6] = Qsim inst_type, tag[7] = kernel mode,
+          varint(zigzag(vaddr - prev inst vaddr)), varint(zigzag(paddr - prev inst paddr))
+    MEM:  tag[2] = store, size byte,
+          varint(zigzag(vaddr - prev mem vaddr)), varint(zigzag(paddr - prev mem paddr))
+    REG:  tag[2] = dest, reg byte, size byte
+    END:  tag[2:7] = 0, end of trace
+    IDLE: tag[0:1] = END type, tag[2:7] = 1, varint(cycles in the idle loop)
+*/
+
+enum SPX_TRACE_RECORD_TYPES
+{
+  SPX_TRACE_INST = 0,
+  SPX_TRACE_MEM,
+  SPX_TRACE_REG,
+  SPX_TRACE_END,
+  SPX_NUM_TRACE_RECORD_TYPES
+};
+
+static const uint32_t SPX_TRACE_MAGIC = 0x54585053; // "SPXT"
+static const uint32_t SPX_TRACE_VERSION = 2;
+static const uint8_t SPX_TRACE_IDLE = SPX_TRACE_END|(1<<2);
+
+class trace_header_t
+{
+public:
+  uint32_t magic;
+  uint32_t version;
+  uint32_t core_id;
+  uint32_t reserved;
+};
+
+// Records the Qsim callbacks of a core into a trace file.
+class trace_writer_t
+{
+public:
+  trace_writer_t(const char *file_name, int core_id);
+  ~trace_writer_t();
+
+  void inst(uint64_t vaddr, uint64_t paddr, int type, bool kernel);
+  void mem(uint64_t vaddr, uint64_t paddr, uint8_t size, int type);
+  void reg(int reg, uint8_t size, int type);
+  void idle(); // one cycle in the Qsim idle loop
+  void close(); // write END record and flush
+
+  uint64_t get_inst_count() const { return inst_count; }
+
+private:
+  void put_byte(uint8_t byte);
+  void put_varint(uint64_t value);
+  void put_idle();
+  void flush();
+
+  FILE *file;
+  std::vector<uint8_t> buffer;
+  uint64_t last_inst_vaddr;
+  uint64_t last_inst_paddr;
+  uint64_t last_mem_vaddr;
+  uint64_t last_mem_paddr;
+  uint64_t inst_count;
+  uint64_t idle_cycles; // not yet written
+};
+
+// Replays a trace file into a pipeline. The file is memory-mapped and read
+// through two windows: while records are decoded from the current window, the
+// kernel is asked to read ahead the next one (MADV_WILLNEED), and the pages of
+// the consumed window are released (MADV_DONTNEED), so the resident size stays
+// at about two windows regardless of the trace length.
+class trace_reader_t
+{
+public:
+  trace_reader_t(const char *file_name, int core_id, size_t window = 4<<20);
+  ~trace_reader_t();
+
+  // Feed the callbacks of the next instruction into the pipeline.
+  // If pipeline is NULL, the instruction is skipped (e.g., fastfwd).
+  // Returns false if there are no more instructions.
+  bool run(pipeline_t *pipeline);
+  bool done() const { return (pos >= size)||(base[pos] == SPX_TRACE_END); }
+  bool in_kernel() const { return kernel; }
+  // Idle-loop cycles recorded after the last instruction.
+  uint64_t get_idle_cycles() const { return idle_cycles; }
+  // Returns true and counts down if idle-loop cycles remain.
+  bool idle() { if(!idle_cycles) return false; idle_cycles--; return true; }
+  uint64_t get_inst_count() const { return inst_count; }
+
+private:
+  uint8_t get_byte();
+  uint64_t get_varint();
+  void next_window();
+
+  int core_id;
+  int fd;
+  const uint8_t *base; // mapped file
+  size_t size; // file size
+  size_t pos; // read position
+  size_t window_size;
+  size_t window_end; // end of the current window
+
+  uint64_t last_inst_vaddr;
+  uint64_t last_inst_paddr;
+  uint64_t last_mem_vaddr;
+  uint64_t last_mem_paddr;
+  bool kernel;
+  uint64_t inst_count;
+  uint64_t idle_cycles; // idle-loop cycles after the last instruction
+};
+
+} // namespace spx
+} // namespace manifold
+
+#endif
@@ -0,0 +1,99 @@
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ei_worker.h"
+#include "ei_wrapper.h"
+
+using namespace manifold::ei_wrapper;
+
+ei_worker_t::ei_worker_t(unsigned queue_size) :
+  head(0), tail(0), sleeping(false), stop(false)
+{
+  size = 1;
+  while(size < queue_size)
+    size <<= 1;
+  jobs = new ei_job_t[size];
+
+  pthread_mutex_init(&mutex, NULL);
+  pthread_cond_init(&cond, NULL);
+  if(pthread_create(&thread, NULL, &ei_worker_t::run, this) != 0) {
+    fprintf(stderr, "ei_worker: cannot create the worker thread\n");
+    exit(1);
+  }
+}
+
+ei_worker_t::~ei_worker_t()
+{
+  drain();
+
+  pthread_mutex_lock(&mutex);
+  stop = true;
+  pthread_cond_signal(&cond);
+  pthread_mutex_unlock(&mutex);
+  pthread_join(thread, NULL);
+
+  pthread_cond_destroy(&cond);
+  pthread_mutex_destroy(&mutex);
+  delete[] jobs;
+}
+
+ei_job_t* ei_worker_t::reserve()
+{
+  // the worker is a full queue behind; wait for it
+  while(tail - head == size)
+    sched_yield();
+  __sync_synchronize();
+  return &jobs[tail & (size - 1)];
+}
+
+void ei_worker_t::submit()
+{
+  __sync_synchronize(); // the job is written before it is published
+  tail = tail + 1;
+  __sync_synchronize(); // tail is published before sleeping is read
+
+  if(sleeping) {
+    pthread_mutex_lock(&mutex);
+    pthread_cond_signal(&cond);
+    pthread_mutex_unlock(&mutex);
+  }
+}
+
+void ei_worker_t::drain()
+{
+  while(head != tail)
+    sched_yield();
+  __sync_synchronize();
+}
+
+void* ei_worker_t::run(void *arg)
+{
+  ((ei_worker_t*)arg)->loop();
+  return NULL;
+}
+
+void ei_worker_t::loop()
+{
+  while(true) {
+    if(head == tail) {
+      pthread_mutex_lock(&mutex);
+      sleeping = true;
+      __sync_synchronize(); // sleeping is published before tail is read
+      while(head == tail && !stop)
+        pthread_cond_wait(&cond, &mutex);
+      sleeping = false;
+      bool done = (head == tail);
+      pthread_mutex_unlock(&mutex);
+      if(done)
+        return;
+    }
+    __sync_synchronize(); // the job is read after tail
+
+    ei_job_t &job = jobs[head & (size - 1)];
+    job.wrapper->run_job(job);
+
+    __sync_synchronize(); // the job is done before its slot is released
+    head = head + 1;
+  }
+}
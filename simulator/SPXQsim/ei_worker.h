@@ -0,0 +1,70 @@
+#ifndef __EI_WORKER_H__
+#define __EI_WORKER_H__
+
+#include <pthread.h>
+
+#include "../../models/energy_introspector/energy_introspector.h"
+
+namespace manifold {
+namespace ei_wrapper {
+
+class ei_wrapper_t;
+
+// A unit of EI work of an ei_wrapper. The counters are snapshots, so the
+// simulation can reset its counters as soon as the job is created.
+struct ei_job_t
+{
+  enum { MAX_MODULES = 48 };
+  enum job_type_t { VDD, POWER, REPORT };
+
+  job_type_t type;
+  ei_wrapper_t *wrapper; // the wrapper that runs the job
+  double time_tick;
+  double period;
+  double value; // new vdd for VDD; simulated time for REPORT
+  int num_modules; // POWER
+  const int *module_handle; // POWER; owned by the wrapper
+  EI::counters_t counters[MAX_MODULES]; // POWER
+};
+
+
+// Runs the EI jobs of all ei_wrappers in a background thread, in the order
+// they are submitted, so the simulation doesn't wait for the EI. The EI is not
+// thread-safe, so there is only one worker, and only the simulation thread may
+// submit jobs.
+//
+// The jobs are kept in a single-producer/single-consumer ring; the worker only
+// sleeps when the ring is empty.
+class ei_worker_t
+{
+public:
+  ei_worker_t(unsigned queue_size);
+  ~ei_worker_t(); // drains the queue and stops the worker
+
+  // returns the slot of the next job; blocks while the queue is full
+  ei_job_t* reserve();
+  // hands the reserved job to the worker
+  void submit();
+  // blocks until all submitted jobs are done
+  void drain();
+
+private:
+  static void* run(void *arg);
+  void loop();
+
+  ei_job_t *jobs;
+  unsigned size; // power of 2
+  volatile unsigned head; // next job to run; written by the worker only
+  volatile unsigned tail; // next free slot; written by the simulation only
+  volatile bool sleeping; // worker is waiting for jobs
+  volatile bool stop;
+
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+};
+
+} // namespace ei_wrapper
+} // namespace manifold
+
+#endif
@@ -22,9 +22,28 @@ int synced = 0;
 int NUM_CORES;
 tick_t SAMPLING_CYCLE;
 
-ei_wrapper_t::ei_wrapper_t(manifold::kernel::Clock* clk, EI::energy_introspector_t *energy_introspector, manifold::spx::pipeline_counter_t* proc_cnt, manifold::spx::ipa_t* proc_ipa, manifold::mcp_cache_namespace::L1_counter_t* c1_cnt, manifold::mcp_cache_namespace::L2_counter_t* c2_cnt, double sampling_period, int num_nodes, int uid)
+// EI modules, in the order of the counters of the POWER jobs
+static const char *core_module_name[] = {
+  "core:instruction_buffer:%d", "core:BTB:%d", "core:chooser:%d",
+  "core:global_predictor:%d", "core:L1_local_predictor:%d", "core:L2_local_predictor:%d",
+  "core:ITLB:%d", "core:IL1:%d", "core:IL1:MissBuffer:%d", "core:IL1:PrefetchBuffer:%d",
+  "core:instruction_decoder:%d", "core:operand_decoder:%d", "core:uop_sequencer:%d",
+  "core:uop_queue:%d", "core:RAS:%d", "core:RS:%d", "core:ROB:%d",
+  "core:issue_select:%d", "core:GPREG:%d", "core:FPREG:%d", "core:RAT:%d",
+  "core:freelist:%d", "core:dependency_check:%d", "core:ALU:%d", "core:ALU_bypass:%d",
+  "core:FPU:%d", "core:MUL:%d", "core:FPU_bypass:%d", "core:StoreQueue:%d",
+  "core:LoadQueue:%d", "core:PC:%d", "core:pipe:IB2ID:%d", "core:pipe:ID2uQ:%d",
+  "core:pipe:uQ2RR:%d", "core:pipe:RR2SCH:%d", "core:pipe:SCH2EXP:%d",
+  "core:pipe:EXP2ALU:%d", "core:pipe:EXP2FPU:%d", "core:pipe:ALU2ROB:%d",
+  "core:pipe:FPU2ROB:%d", "core:pipe:ROB2CM:%d"};
+static const char *mem_module_name[] = {
+  "core:DTLB:%d", "core:DL1:%d", "core:DL2:%d", "core:DL1:MissBuffer:%d",
+  "core:DL1:FillBuffer:%d", "core:DL1:PrefetchBuffer:%d", "core:DL1:WBB:%d"};
+
+ei_wrapper_t::ei_wrapper_t(manifold::kernel::Clock* clk, EI::energy_introspector_t *energy_introspector, manifold::spx::pipeline_counter_t* proc_cnt, manifold::spx::ipa_t* proc_ipa, manifold::mcp_cache_namespace::L1_counter_t* c1_cnt, manifold::mcp_cache_namespace::L2_counter_t* c2_cnt, double sampling_period, int num_nodes, int uid, ei_worker_t *ei_worker)
 {
   clock = clk;
+  worker = ei_worker;
   id = uid; 
   char ModuleID[64];
   manifold::kernel::Clock::Register<ei_wrapper_t>(manifold::kernel::Clock::Master(),this,&ei_wrapper_t::tick, (void(ei_wrapper_t::*)(void))0);
@@ -54,6 +73,15 @@ ei_wrapper_t::ei_wrapper_t(manifold::kernel::Clock* clk, EI::energy_introspector
   ei->update_variable_partition(string(ModuleID),string("vdd"),0.8);
   ei->update_variable_partition(string(ModuleID),string("temperature"),300.0);
 
+  for(int i = 0; i < NUM_CORE_EI_MODULES; i++) {
+    sprintf(ModuleID,core_module_name[i],id);
+    core_module_handle[i] = ei->get_module_handle(string(ModuleID));
+  }
+  for(int i = 0; i < NUM_MEM_EI_MODULES; i++) {
+    sprintf(ModuleID,mem_module_name[i],id);
+    mem_module_handle[i] = ei->get_module_handle(string(ModuleID));
+  }
+
   SAMPLING_CYCLE = (tick_t)(sampling_period * manifold::kernel::Clock::Master().freq); 
 
   p_cnt = proc_cnt;
@@ -109,59 +137,42 @@ void ei_wrapper_t::tick()
     clock->set_frequency(p_ipa->new_freq);
     next_frq = p_ipa->new_freq;
 
-    char ModuleID[64];
-
-    sprintf(ModuleID,"CORE_DIE:FRT%d",id);
-    ei->update_variable_partition(string(ModuleID),string("vdd"),vdd);
-
-    sprintf(ModuleID,"CORE_DIE:SCH%d",id);
-    ei->update_variable_partition(string(ModuleID),string("vdd"),vdd);
- 
-    sprintf(ModuleID,"CORE_DIE:INT%d",id);
-    ei->update_variable_partition(string(ModuleID),string("vdd"),vdd);
-  
-    sprintf(ModuleID,"CORE_DIE:FPU%d",id);
-    ei->update_variable_partition(string(ModuleID),string("vdd"),vdd);
-  
-    sprintf(ModuleID,"CORE_DIE:MEM%d",id);
-    ei->update_variable_partition(string(ModuleID),string("vdd"),vdd);
-
+    ei_job_t *job = new_job();
+    job->type = ei_job_t::VDD;
+    job->value = vdd;
+    submit_job(job);
   }
 
 
 
 #ifdef EI_COMPUTE
   if(sam_cycle == (SAMPLING_CYCLE + 1)){
-    char ModuleID[64];
     clock->SetNowTime(p_cnt->time_tick);
 
     //***Nehalem:Memory***
+    ei_job_t *job = new_job();
+    EI::counters_t *counters = job->counters;
     //core:DTLB
-    sprintf(ModuleID,"core:DTLB:%d",id);
-    ei->compute_power(p_cnt->time_tick, p_cnt->period,string(ModuleID),l1_cnt->DTLB * factor);
+    counters[0] = l1_cnt->DTLB * factor;
     //core:DL1
-    sprintf(ModuleID,"core:DL1:%d",id);
-    ei->compute_power(p_cnt->time_tick, p_cnt->period,string(ModuleID),l1_cnt->DL1 * factor);
-
+    counters[1] = l1_cnt->DL1 * factor;
     //core:DL2
-    sprintf(ModuleID,"core:DL2:%d",id);
-    ei->compute_power(p_cnt->time_tick, p_cnt->period,string(ModuleID),l2_cnt->DL2 * 2.2 * factor);
-
+    counters[2] = l2_cnt->DL2 * 2.2 * factor;
     //core:DL1:MissBuffer
-    sprintf(ModuleID,"core:DL1:MissBuffer:%d",id);
-    ei->compute_power(p_cnt->time_tick, p_cnt->period,string(ModuleID),l1_cnt->DL1.missbuf * factor);
-  
+    counters[3] = l1_cnt->DL1.missbuf * factor;
     //core:DL1:FillBuffer
-    sprintf(ModuleID,"core:DL1:FillBuffer:%d",id);
-    ei->compute_power(p_cnt->time_tick, p_cnt->period,string(ModuleID),l1_cnt->DL1.linefill * factor);
-
+    counters[4] = l1_cnt->DL1.linefill * factor;
     //core:DL1:PrefetchBuffer
-    sprintf(ModuleID,"core:DL1:PrefetchBuffer:%d",id);
-    ei->compute_power(p_cnt->time_tick, p_cnt->period,string(ModuleID),l1_cnt->DL1.prefetch * factor);
-
+    counters[5] = l1_cnt->DL1.prefetch * factor;
     //core:DL1:WBB
-    sprintf(ModuleID,"core:DL1:WBB:%d",id);
-    ei->compute_power(p_cnt->time_tick, p_cnt->period,string(ModuleID),l1_cnt->DL1.writeback * factor);
+    counters[6] = l1_cnt->DL1.writeback * factor;
+
+    job->type = ei_job_t::POWER;
+    job->time_tick = p_cnt->time_tick;
+    job->period = p_cnt->period;
+    job->num_modules = NUM_MEM_EI_MODULES;
+    job->module_handle = mem_module_handle;
+    submit_job(job);
 
     l1_cnt->reset();
     l2_cnt->reset();
@@ -172,211 +183,49 @@ void ei_wrapper_t::tick()
 
       synced = 0;
 
-      double ip = 0.0;
-      double il = 0.0;
-
-      double ipp = 0.0;
-      double ilp = 0.0;
-
-      double ips = 0.0;
-      double ils = 0.0;
-      double T_MAX = 298.0;
-
-      for(int i=0;i<NUM_CORES;i++) {
-        EI::power_t P;
- 
-	    sprintf(ModuleID,"CORE_DIE:FRT%d",i);
-	    P = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-	    ad[i] = P.get_total() - P.leakage;
-        P.leakage = P.leakage * factor2;
-        P.total = P.leakage + ad[i];
-		ei->push_data<EI::power_t>(p_cnt->time_tick,p_cnt->period,string("partition"),string(ModuleID),string("power"),P);
-	  
-	    sprintf(ModuleID,"CORE_DIE:SCH%d",i);
-	    P = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-	    bd[i] = P.get_total() - P.leakage;
-	    P.leakage = P.leakage * factor2;
-        P.total = P.leakage + bd[i];
-		ei->push_data<EI::power_t>(p_cnt->time_tick,p_cnt->period,string("partition"),string(ModuleID),string("power"),P);
-	 
-	    sprintf(ModuleID,"CORE_DIE:INT%d",i);
-	    P = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-	    cd[i] = P.get_total() - P.leakage;
-	    P.leakage = P.leakage * factor2;
-        P.total = P.leakage + cd[i];
-		ei->push_data<EI::power_t>(p_cnt->time_tick,p_cnt->period,string("partition"),string(ModuleID),string("power"),P);
-	 
-	    sprintf(ModuleID,"CORE_DIE:FPU%d",i);
-	    P = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-	    dd[i] = P.get_total() - P.leakage;
-	    P.leakage = P.leakage * factor2;
-        P.total = P.leakage + dd[i];
-		ei->push_data<EI::power_t>(p_cnt->time_tick,p_cnt->period,string("partition"),string(ModuleID),string("power"),P);
-	  
-	    sprintf(ModuleID,"CORE_DIE:MEM%d",i);
-	    P = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-	    ed[i] = P.get_total() - P.leakage;
-	    P.leakage = P.leakage * factor2;
-        P.total = P.leakage + ed[i];
-		ei->push_data<EI::power_t>(p_cnt->time_tick,p_cnt->period,string("partition"),string(ModuleID),string("power"),P);
-	
-	    sprintf(ModuleID,"DL2_DIE:SPOT%d",i);
-	    P = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-	    fd[i] = P.get_total() - P.leakage;
-        P.leakage = P.leakage / factor3;
-        P.total = P.leakage + fd[i];
-		ei->push_data<EI::power_t>(p_cnt->time_tick,p_cnt->period,string("partition"),string(ModuleID),string("power"),P);
-	  }
-
-      double T;
-      ei->compute_temperature(p_cnt->time_tick, p_cnt->period, "16CORE");
-
-      for(int i=0;i<NUM_CORES;i++) {
-        double s = 0.0;
-        double t = 0.0;
-        double a,b,c,d,e,f;
-        double al, bl, cl, dl, el, fl;
- 
-        EI::power_t update_p;
-
-        sprintf(ModuleID,"CORE_DIE:FRT%d",i);
-	      update_p = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-        al = update_p.leakage * factor2;
-        a = al + ad[i];
-        s += a;
-        t += al;
-
-		sprintf(ModuleID,"CORE_DIE:SCH%d",i);
-	    update_p = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-        bl = update_p.leakage * factor2;
-        b = bl + bd[i];
-        s += b;
-        t += bl;
-
-		sprintf(ModuleID,"CORE_DIE:SCH%d",i);
-	    update_p = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-        cl = update_p.leakage * factor2;
-        c = cl + cd[i];
-        s += c;
-        t += cl;
-
-		sprintf(ModuleID,"CORE_DIE:FPU%d",i);
-    	update_p = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-        dl = update_p.leakage * factor2;
-        d = dl + dd[i];
-        s += d;
-        t += dl;
-
-		sprintf(ModuleID,"CORE_DIE:MEM%d",i);
-	    update_p = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-        el = update_p.leakage * factor2;
-	    e = el + ed[i];
-        s += e;
-        t += el;
-			
-		sprintf(ModuleID,"DL2_DIE:SPOT%d",i);
-		update_p = ei->pull_data<EI::power_t>(p_cnt->time_tick,string("partition"),string(ModuleID),string("power"));
-        fl = update_p.leakage / factor3;
-        f = fl + fd[i];
-        T = ei->pull_data<double>(p_cnt->time_tick,string("partition"),string(ModuleID),string("temperature"));
-
-        total_energy += (s + f) * p_cnt->period;
-        core_energy += s * p_cnt->period;
-        sram_energy += f * p_cnt->period;
-  
-        total_leakage += (t + fl) * p_cnt->period;
-        core_leakage += t * p_cnt->period;
-        sram_leakage += fl * p_cnt->period;
-
-        ip += s + f;
-        il += t + fl;
-        ipp += s;
-        ilp += t;
-        ips += f;
-        ils += fl;
-
-        cerr<<i<<"(power)  \t"<<a<<","<<b<<","<<c<<","<<d<<","<<e<<", "<<f<<"\t"<<s<<"+"<<f<<"="<<s+f<<": "<<T<<endl<<flush;
-        cerr<<i<<"(leakage)\t"<<al<<","<<bl<<","<<cl<<","<<dl<<","<<el<<", "<<fl<<"\t"<<t<<"+"<<fl<<"="<<t+fl<<endl<<flush;
-         //cerr<<i<<"(dynamic)\t"<<ad[i]<<","<<bd[i]<<","<<cd[i]<<","<<dd[i]<<","<<ed[i]<<", "<<fd[i]<<endl<<flush;
-      }
-            
-#if 0
-      EI::grid_t<double> thermal_grid = ei->pull_data<EI::grid_t<double> >(p_cnt->time_tick,"package","16CORE","thermal_grid");
-      for(int col_index = 0; col_index < 50; col_index++) {
-        for(int row_index = 0; row_index < 50; row_index++)
-          cerr << thermal_grid.pull(row_index,col_index,0) << ",";
-          cerr << endl;
-         }
-      cerr << "**************************************************" << endl;
-#endif
-#if 0
-      EI::grid_t<double> thermal_grid = ei->pull_data<EI::grid_t<double> >(p_cnt->time_tick,"package","16CORE","thermal_grid");
-      for(int col_index = 0; col_index < 50; col_index++) {
-        for(int row_index = 0; row_index < 50; row_index++)
-          cerr << thermal_grid.pull(row_index,col_index,1) << ",";
-          cerr << endl;
-        }
-      cerr << "**************************************************" << endl;
-#endif
-      double time = manifold::kernel::Clock::Master().NowTime();
-
-      cerr<<"instantaneous power: "<<ip<<", instantaneous leakage: "<<il<<endl<<flush;
-      cerr<<"instantaneous power(core): "<<ipp<<", instantaneous leakage(core): "<<ilp<<endl<<flush;
-      cerr<<"instantaneous power(sram): "<<ips<<", instantaneous leakage(sram): "<<ils<<endl<<flush;
-
-      cerr<<"total energy: "<<total_energy<<", total leakage energy: "<<total_leakage<<endl<<flush;
-      cerr<<"total energy(core): "<<core_energy<<", total leakage energy(core): "<<core_leakage<<endl<<flush;
-      cerr<<"total energy(sram): "<<sram_energy<<", total leakage energy(sram): "<<sram_leakage<<endl<<flush;
-
-      cerr<<"average power: "<<total_energy/time<<", average leakage: "<<total_leakage/time<<endl<<flush;
-      cerr<<"average power(core): "<<core_energy/time<<", average leakage(core): "<<core_leakage/time<<endl<<flush;
-      cerr<<"average power(sram): "<<sram_energy/time<<", average leakage(sram): "<<sram_leakage/time<<endl<<flush;
+      ei_job_t *job = new_job();
+      job->type = ei_job_t::REPORT;
+      job->time_tick = p_cnt->time_tick;
+      job->period = p_cnt->period;
+      job->value = manifold::kernel::Clock::Master().NowTime();
+      submit_job(job);
     } 
   }
 #endif
   
   if(sam_cycle == SAMPLING_CYCLE)
   {
-    char ModuleID[64];
-
     p_cnt->time_tick += p_cnt->period; // update time_tick
 #ifdef EI_COMPUTE
     //***Nehalem:Frontend***
+    ei_job_t *job = new_job();
+    EI::counters_t *counters = job->counters;
     //core:instruction_buffer
-    sprintf(ModuleID,"core:instruction_buffer:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->inst_buffer * factor);
+    counters[0] = p_cnt->inst_buffer * factor;
 
     //core:BTB
-    sprintf(ModuleID,"core:BTB:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),(p_cnt->l1_btb + p_cnt->l2_btb) * factor);
+    counters[1] = (p_cnt->l1_btb + p_cnt->l2_btb) * factor;
 
     //core:chooser
-    sprintf(ModuleID,"core:chooser:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->predictor_chooser * factor);
+    counters[2] = p_cnt->predictor_chooser * factor;
 
     //core:global_predictor
-    sprintf(ModuleID,"core:global_predictor:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->global_predictor * factor);
+    counters[3] = p_cnt->global_predictor * factor;
 
     //core:L1_local_predictor
-    sprintf(ModuleID,"core:L1_local_predictor:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->l1_local_predictor * factor);
+    counters[4] = p_cnt->l1_local_predictor * factor;
 
     //core:L2_local_predictor
-    sprintf(ModuleID,"core:L2_local_predictor:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->l2_local_predictor * factor);
+    counters[5] = p_cnt->l2_local_predictor * factor;
 
     //core:ITLB
-    sprintf(ModuleID,"core:ITLB:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->inst_tlb * factor);
+    counters[6] = p_cnt->inst_tlb * factor;
 
     //core:IL1
-    sprintf(ModuleID,"core:IL1:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->inst_cache * factor);
+    counters[7] = p_cnt->inst_cache * factor;
 
     //core:IL1:MissBuffer
-    sprintf(ModuleID,"core:IL1:MissBuffer:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->inst_cache_miss_buffer * factor);
+    counters[8] = p_cnt->inst_cache_miss_buffer * factor;
 
     //core:IL1:FillBuffer //FIXME
     //sprintf(ModuleID,"core:IL1:FillBuffer:%d",id);
@@ -384,45 +233,35 @@ void ei_wrapper_t::tick()
     //ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->IL1.linefill * factor);
 
     //core:IL1:PrefetchBuffer
-    sprintf(ModuleID,"core:IL1:PrefetchBuffer:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->inst_cache_prefetch_buffer * factor);
+    counters[9] = p_cnt->inst_cache_prefetch_buffer * factor;
  
     //core:instruction_decoder
-    sprintf(ModuleID,"core:instruction_decoder:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->inst_decoder * factor);
+    counters[10] = p_cnt->inst_decoder * factor;
 
     //core:operand_decoder
-    sprintf(ModuleID,"core:operand_decoder:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->operand_decoder * factor);
+    counters[11] = p_cnt->operand_decoder * factor;
 
     //core:uop_sequencer
-    sprintf(ModuleID,"core:uop_sequencer:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->uop_sequencer * factor);
+    counters[12] = p_cnt->uop_sequencer * factor;
 
     //core:uop_queue
-    sprintf(ModuleID,"core:uop_queue:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->uop_queue * factor);
+    counters[13] = p_cnt->uop_queue * factor;
 
     //core:RAS
-    sprintf(ModuleID,"core:RAS:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->ras * factor);
+    counters[14] = p_cnt->ras * factor;
 
     //***Nehalem:Schedule***
     //core:RS
-    sprintf(ModuleID,"core:RS:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->rs * factor);
+    counters[15] = p_cnt->rs * factor;
 
     //core:ROB
-    sprintf(ModuleID,"core:ROB:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->rob * factor);
+    counters[16] = p_cnt->rob * factor;
 
     //core:issue_select
-    sprintf(ModuleID,"core:issue_select:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->issue_select * factor);
+    counters[17] = p_cnt->issue_select * factor;
 
     //core:GPREG
-    sprintf(ModuleID,"core:GPREG:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->reg_int * factor);
+    counters[18] = p_cnt->reg_int * factor;
 
     //core:SCFREG //FIXME
     //sprintf(ModuleID,"core:SCFREG:%d",id);
@@ -430,42 +269,33 @@ void ei_wrapper_t::tick()
       //                 + p_cnt->registers.control);
 
     //core:FPREG
-    sprintf(ModuleID,"core:FPREG:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->reg_fp * factor);
+    counters[19] = p_cnt->reg_fp * factor;
 
     //core:RAT
-    sprintf(ModuleID,"core:RAT:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->rat * factor);
+    counters[20] = p_cnt->rat * factor;
 
     //core:freelist
-    sprintf(ModuleID,"core:freelist:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->freelist * factor);
+    counters[21] = p_cnt->freelist * factor;
 
     //core:dependency_check
-    sprintf(ModuleID,"core:dependency_check:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->dependency_check * factor);
+    counters[22] = p_cnt->dependency_check * factor;
 
     //***Nehalem:Execute:INT***
     //core:ALU
-    sprintf(ModuleID,"core:ALU:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->alu * factor);
+    counters[23] = p_cnt->alu * factor;
 
     //core:ALU_bypass
-    sprintf(ModuleID,"core:ALU_bypass:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->int_bypass * factor);
+    counters[24] = p_cnt->int_bypass * factor;
 
     //***Nehalem:Execute:FP***
     //core:FPU
-    sprintf(ModuleID,"core:FPU:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->fpu * factor);
+    counters[25] = p_cnt->fpu * factor;
 
     //core:MUL
-    sprintf(ModuleID,"core:MUL:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->mul * factor);
+    counters[26] = p_cnt->mul * factor;
 
     //core:FPU_bypass
-    sprintf(ModuleID,"core:FPU_bypass:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->fp_bypass * factor);
+    counters[27] = p_cnt->fp_bypass * factor;
 
     //core:MUL_bypass //FIXME
     //sprintf(ModuleID,"core:MUL_bypass:%d",id);
@@ -473,12 +303,10 @@ void ei_wrapper_t::tick()
     //ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->mul_bypass);
 
     //core:StoreQueue
-    sprintf(ModuleID,"core:StoreQueue:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->stq * factor);
+    counters[28] = p_cnt->stq * factor;
 
     //core:LoadQueue
-    sprintf(ModuleID,"core:LoadQueue:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->ldq * factor);
+    counters[29] = p_cnt->ldq * factor;
 
     //core:LD_bypass //FIXME
     //sprintf(ModuleID,"core:LD_bypass:%d",id);
@@ -487,48 +315,44 @@ void ei_wrapper_t::tick()
 
     //***Wiring & Latch
     //core:PC
-    sprintf(ModuleID,"core:PC:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->pc * factor);
+    counters[30] = p_cnt->pc * factor;
 
     //core:pipe:IB2ID
-    sprintf(ModuleID,"core:pipe:IB2ID:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->latch_ib2id * factor);
+    counters[31] = p_cnt->latch_ib2id * factor;
 
     //core:pipe:ID2uQ
-    sprintf(ModuleID,"core:pipe:ID2uQ:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->latch_id2uq * factor);
+    counters[32] = p_cnt->latch_id2uq * factor;
 
     //core:pipe:uQ2RR
-    sprintf(ModuleID,"core:pipe:uQ2RR:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->latch_uq2rat * factor);
+    counters[33] = p_cnt->latch_uq2rat * factor;
 
     //core:pipe:RR2SCH
-    sprintf(ModuleID,"core:pipe:RR2SCH:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->latch_rat2rs * factor);
+    counters[34] = p_cnt->latch_rat2rs * factor;
 
     //core:pipe:SCH2EXP
-    sprintf(ModuleID,"core:pipe:SCH2EXP:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->latch_rs2ex * factor);
+    counters[35] = p_cnt->latch_rs2ex * factor;
 
     //core:pipe:EXP2ALU
-    sprintf(ModuleID,"core:pipe:EXP2ALU:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->latch_ex_int* factor);
+    counters[36] = p_cnt->latch_ex_int* factor;
 
     //core:pipe:EXP2FPU
-    sprintf(ModuleID,"core:pipe:EXP2FPU:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->latch_ex_fp * factor);
+    counters[37] = p_cnt->latch_ex_fp * factor;
 
     //core:pipe:ALU2ROB
-    sprintf(ModuleID,"core:pipe:ALU2ROB:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),p_cnt->alu * factor);
+    counters[38] = p_cnt->alu * factor;
 
     //core:pipe:FPU2ROB
-    sprintf(ModuleID,"core:pipe:FPU2ROB:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),(p_cnt->fpu + p_cnt->mul)* factor);
+    counters[39] = (p_cnt->fpu + p_cnt->mul)* factor;
 
     //core:pipe:ROB2CM
-    sprintf(ModuleID,"core:pipe:ROB2CM:%d",id);
-    ei->compute_power(p_cnt->time_tick,p_cnt->period,string(ModuleID),(p_cnt->latch_rob2rs + p_cnt->latch_rob2arf + p_cnt->latch_ldq2rs) * factor);
+    counters[40] = (p_cnt->latch_rob2rs + p_cnt->latch_rob2arf + p_cnt->latch_ldq2rs) * factor;
+
+    job->type = ei_job_t::POWER;
+    job->time_tick = p_cnt->time_tick;
+    job->period = p_cnt->period;
+    job->num_modules = NUM_CORE_EI_MODULES;
+    job->module_handle = core_module_handle;
+    submit_job(job);
 #endif
     total_mips += p_cnt->retire_inst.read/p_cnt->period/1e6;
     cerr << "id: " << id <<" cycle: "<<clock->NowTicks()<<"|| fetched inst: "<<p_cnt->fetch_inst.read<<" committed inst: "<<p_cnt->retire_inst.read<<", IPC_inst: "<<((float)p_cnt->retire_inst.read)/SAMPLING_CYCLE<<", MIPS: "<<p_cnt->retire_inst.read/p_cnt->period/1e6<<" total_MIPS: "<<total_mips<<endl<<flush;
@@ -538,3 +362,213 @@ void ei_wrapper_t::tick()
   }
 }
 
+ei_job_t* ei_wrapper_t::new_job()
+{
+  ei_job_t *job = worker ? worker->reserve() : &sync_job;
+  job->wrapper = this;
+  return job;
+}
+
+void ei_wrapper_t::submit_job(ei_job_t *job)
+{
+  if(worker)
+    worker->submit();
+  else
+    run_job(*job);
+}
+
+// runs in the worker thread in asynchronous mode
+void ei_wrapper_t::run_job(ei_job_t &job)
+{
+  char ModuleID[64];
+
+  switch(job.type) {
+  case ei_job_t::VDD:
+    sprintf(ModuleID,"CORE_DIE:FRT%d",id);
+    ei->update_variable_partition(string(ModuleID),string("vdd"),job.value);
+
+    sprintf(ModuleID,"CORE_DIE:SCH%d",id);
+    ei->update_variable_partition(string(ModuleID),string("vdd"),job.value);
+
+    sprintf(ModuleID,"CORE_DIE:INT%d",id);
+    ei->update_variable_partition(string(ModuleID),string("vdd"),job.value);
+
+    sprintf(ModuleID,"CORE_DIE:FPU%d",id);
+    ei->update_variable_partition(string(ModuleID),string("vdd"),job.value);
+
+    sprintf(ModuleID,"CORE_DIE:MEM%d",id);
+    ei->update_variable_partition(string(ModuleID),string("vdd"),job.value);
+    break;
+
+  case ei_job_t::POWER:
+    ei->compute_power(job.time_tick, job.period, job.num_modules, job.module_handle, job.counters);
+    break;
+
+  case ei_job_t::REPORT:
+    report(job.time_tick, job.period, job.value);
+    break;
+  }
+}
+
+void ei_wrapper_t::report(double time_tick, double period, double time)
+{
+  char ModuleID[64];
+
+  double ip = 0.0;
+  double il = 0.0;
+
+  double ipp = 0.0;
+  double ilp = 0.0;
+
+  double ips = 0.0;
+  double ils = 0.0;
+  double T_MAX = 298.0;
+
+  for(int i=0;i<NUM_CORES;i++) {
+    EI::power_t P;
+
+    sprintf(ModuleID,"CORE_DIE:FRT%d",i);
+    P = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    ad[i] = P.get_total() - P.leakage;
+    P.leakage = P.leakage * factor2;
+    P.total = P.leakage + ad[i];
+    ei->push_data<EI::power_t>(time_tick,period,string("partition"),string(ModuleID),string("power"),P);
+
+    sprintf(ModuleID,"CORE_DIE:SCH%d",i);
+    P = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    bd[i] = P.get_total() - P.leakage;
+    P.leakage = P.leakage * factor2;
+    P.total = P.leakage + bd[i];
+    ei->push_data<EI::power_t>(time_tick,period,string("partition"),string(ModuleID),string("power"),P);
+
+    sprintf(ModuleID,"CORE_DIE:INT%d",i);
+    P = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    cd[i] = P.get_total() - P.leakage;
+    P.leakage = P.leakage * factor2;
+    P.total = P.leakage + cd[i];
+    ei->push_data<EI::power_t>(time_tick,period,string("partition"),string(ModuleID),string("power"),P);
+
+    sprintf(ModuleID,"CORE_DIE:FPU%d",i);
+    P = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    dd[i] = P.get_total() - P.leakage;
+    P.leakage = P.leakage * factor2;
+    P.total = P.leakage + dd[i];
+    ei->push_data<EI::power_t>(time_tick,period,string("partition"),string(ModuleID),string("power"),P);
+
+    sprintf(ModuleID,"CORE_DIE:MEM%d",i);
+    P = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    ed[i] = P.get_total() - P.leakage;
+    P.leakage = P.leakage * factor2;
+    P.total = P.leakage + ed[i];
+    ei->push_data<EI::power_t>(time_tick,period,string("partition"),string(ModuleID),string("power"),P);
+
+    sprintf(ModuleID,"DL2_DIE:SPOT%d",i);
+    P = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    fd[i] = P.get_total() - P.leakage;
+    P.leakage = P.leakage / factor3;
+    P.total = P.leakage + fd[i];
+    ei->push_data<EI::power_t>(time_tick,period,string("partition"),string(ModuleID),string("power"),P);
+  }
+
+  double T;
+  ei->compute_temperature(time_tick, period, "16CORE");
+
+  for(int i=0;i<NUM_CORES;i++) {
+    double s = 0.0;
+    double t = 0.0;
+    double a,b,c,d,e,f;
+    double al, bl, cl, dl, el, fl;
+
+    EI::power_t update_p;
+
+    sprintf(ModuleID,"CORE_DIE:FRT%d",i);
+      update_p = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    al = update_p.leakage * factor2;
+    a = al + ad[i];
+    s += a;
+    t += al;
+
+    sprintf(ModuleID,"CORE_DIE:SCH%d",i);
+    update_p = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    bl = update_p.leakage * factor2;
+    b = bl + bd[i];
+    s += b;
+    t += bl;
+
+    sprintf(ModuleID,"CORE_DIE:SCH%d",i);
+    update_p = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    cl = update_p.leakage * factor2;
+    c = cl + cd[i];
+    s += c;
+    t += cl;
+
+    sprintf(ModuleID,"CORE_DIE:FPU%d",i);
+    update_p = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    dl = update_p.leakage * factor2;
+    d = dl + dd[i];
+    s += d;
+    t += dl;
+
+    sprintf(ModuleID,"CORE_DIE:MEM%d",i);
+    update_p = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    el = update_p.leakage * factor2;
+    e = el + ed[i];
+    s += e;
+    t += el;
+
+    sprintf(ModuleID,"DL2_DIE:SPOT%d",i);
+    update_p = ei->pull_data<EI::power_t>(time_tick,string("partition"),string(ModuleID),string("power"));
+    fl = update_p.leakage / factor3;
+    f = fl + fd[i];
+    T = ei->pull_data<double>(time_tick,string("partition"),string(ModuleID),string("temperature"));
+
+    total_energy += (s + f) * period;
+    core_energy += s * period;
+    sram_energy += f * period;
+
+    total_leakage += (t + fl) * period;
+    core_leakage += t * period;
+    sram_leakage += fl * period;
+
+    ip += s + f;
+    il += t + fl;
+    ipp += s;
+    ilp += t;
+    ips += f;
+    ils += fl;
+
+    cerr<<i<<"(power)  \t"<<a<<","<<b<<","<<c<<","<<d<<","<<e<<", "<<f<<"\t"<<s<<"+"<<f<<"="<<s+f<<": "<<T<<endl<<flush;
+    cerr<<i<<"(leakage)\t"<<al<<","<<bl<<","<<cl<<","<<dl<<","<<el<<", "<<fl<<"\t"<<t<<"+"<<fl<<"="<<t+fl<<endl<<flush;
+     //cerr<<i<<"(dynamic)\t"<<ad[i]<<","<<bd[i]<<","<<cd[i]<<","<<dd[i]<<","<<ed[i]<<", "<<fd[i]<<endl<<flush;
+  }
+
+#if 0
+  EI::grid_t<double> thermal_grid = ei->pull_data<EI::grid_t<double> >(time_tick,"package","16CORE","thermal_grid");
+  for(int col_index = 0; col_index < 50; col_index++) {
+    for(int row_index = 0; row_index < 50; row_index++)
+      cerr << thermal_grid.pull(row_index,col_index,0) << ",";
+      cerr << endl;
+     }
+  cerr << "**************************************************" << endl;
+#endif
+#if 0
+  EI::grid_t<double> thermal_grid = ei->pull_data<EI::grid_t<double> >(time_tick,"package","16CORE","thermal_grid");
+  for(int col_index = 0; col_index < 50; col_index++) {
+    for(int row_index = 0; row_index < 50; row_index++)
+      cerr << thermal_grid.pull(row_index,col_index,1) << ",";
+      cerr << endl;
+    }
+  cerr << "**************************************************" << endl;
+#endif
+  cerr<<"instantaneous power: "<<ip<<", instantaneous leakage: "<<il<<endl<<flush;
+  cerr<<"instantaneous power(core): "<<ipp<<", instantaneous leakage(core): "<<ilp<<endl<<flush;
+  cerr<<"instantaneous power(sram): "<<ips<<", instantaneous leakage(sram): "<<ils<<endl<<flush;
+
+  cerr<<"total energy: "<<total_energy<<", total leakage energy: "<<total_leakage<<endl<<flush;
+  cerr<<"total energy(core): "<<core_energy<<", total leakage energy(core): "<<core_leakage<<endl<<flush;
+  cerr<<"total energy(sram): "<<sram_energy<<", total leakage energy(sram): "<<sram_leakage<<endl<<flush;
+
+  cerr<<"average power: "<<total_energy/time<<", average leakage: "<<total_leakage/time<<endl<<flush;
+  cerr<<"average power(core): "<<core_energy/time<<", average leakage(core): "<<core_leakage/time<<endl<<flush;
+  cerr<<"average power(sram): "<<sram_energy/time<<", average leakage(sram): "<<sram_leakage/time<<endl<<flush;
+}
@@ -10,6 +10,7 @@
 #include "../../models/cache/mcp-cache/cache-counters.h"
 #include "../../models/processor/spx/pipeline.h"
 #include "../../models/processor/spx/core.h"
+#include "ei_worker.h"
 
 namespace manifold {
 namespace ei_wrapper {
@@ -18,12 +19,15 @@ typedef unsigned int tick_t;
 class ei_wrapper_t : public manifold::kernel::Component
 {
 public:
-  ei_wrapper_t(manifold::kernel::Clock* clk, EI::energy_introspector_t *energy_introspector, manifold::spx::pipeline_counter_t* proc_cnt, manifold::spx::ipa_t* proc_ipa, manifold::mcp_cache_namespace::L1_counter_t* c1_cnt, manifold::mcp_cache_namespace::L2_counter_t* c2_cnt, double sampling_period, int num_nodes, int uid);
+  ei_wrapper_t(manifold::kernel::Clock* clk, EI::energy_introspector_t *energy_introspector, manifold::spx::pipeline_counter_t* proc_cnt, manifold::spx::ipa_t* proc_ipa, manifold::mcp_cache_namespace::L1_counter_t* c1_cnt, manifold::mcp_cache_namespace::L2_counter_t* c2_cnt, double sampling_period, int num_nodes, int uid, ei_worker_t *ei_worker = NULL);
 
   ~ei_wrapper_t();
 
   // manifold component functions
   void tick();
+
+  // runs the EI computation of a job; called by the worker in asynchronous mode
+  void run_job(ei_job_t &job);
   uint64_t sam_cycle;
   tick_t slack_cycle;
   double last_vdd;
@@ -40,6 +44,18 @@ private:
 
 //  void TL_feedback(int core_id);
 
+  // EI module handles, in the order of the counters of the POWER jobs
+  enum { NUM_CORE_EI_MODULES = 41, NUM_MEM_EI_MODULES = 7 };
+  int core_module_handle[NUM_CORE_EI_MODULES];
+  int mem_module_handle[NUM_MEM_EI_MODULES];
+
+  // the EI runs in the worker if there is one, otherwise in tick()
+  ei_worker_t *worker;
+  ei_job_t sync_job;
+  ei_job_t* new_job();
+  void submit_job(ei_job_t *job);
+  void report(double time_tick, double period, double time);
+
   int id;
 };
 
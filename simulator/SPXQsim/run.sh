@@ -14,3 +14,11 @@ for testcase in $TESTBENCH; do
   echo $testcase
   ./smp_llp_con_dvfs conf_llp.cfg.bst.ss outorder.config.ss qsim_lib state.16 16core_ooo.config.ss ./benchmarks/$testcase >./results/$testcase.best.log 2>&1
 done
+
+# Replay the traces recorded with trace_record = "traces/app" in the spx config
+# file. Without Qsim the nodes are split across LPs the same way as the torus:
+# 2 LPs, or y_dimension LPs for one row of the torus per LP.
+if [ -n "$TRACE_CONFIG" ]; then
+  echo trace
+  mpirun -np ${TRACE_LPS:-2} ./smp_llp_con_dvfs conf_llp.cfg.bst.ss $TRACE_CONFIG trace none 16core_ooo.config.ss none >./results/trace.lp${TRACE_LPS:-2}.log 2>&1
+fi
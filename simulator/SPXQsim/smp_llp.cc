@@ -41,13 +41,18 @@
 //! Since the processor model is built with the Qsim library, and all processors should
 //! share the same Qsim OS domain object, in this program all the processors must be
 //! in the same LP. In fact, we only allow this program to be run with 1 LP.
+//! With qsim_type "trace", each spx_core_t reads its own trace file instead and
+//! Qsim is not used, so the program can be run with more than 1 LP. The nodes are
+//! placed in the LPs the same way as the network routers: with 2 LPs the first half
+//! of the nodes is in LP 0 and the rest in LP 1; with y_dimension LPs each row of
+//! the torus is in its own LP. Sampled simulation still requires 1 LP.
 //!
 //! In this program the configuration for the components is provided by a configuration
 //! file which is parsed with libconfig++. An example can be found in conf4x1.cfg.
 //! 
 //! To run this program, type:
 //! @code
-//! mpirun -np 1 spx_llp <conf_file>  <spx_conf_file>  <state_file>  <benchmark_tar_file>
+//! mpirun -np <NP> spx_llp <conf_file>  <spx_conf_file>  <state_file>  <benchmark_tar_file>
 //! @endcode
 //! <conf_file>: the name of the configuration file.
 //! <sepx_conf_file>: the name of the spx configuration file.
@@ -62,6 +67,7 @@
 #include "kernel/clock.h"
 #include "kernel/component.h"
 #include "kernel/manifold.h"
+#include "kernel/sampler.h"
 #include "spx/core.h"
 #include "spx/interrupt_handler.h"
 //#include "iris/genericTopology/genericTopoCreator.h"
@@ -147,6 +153,9 @@ int main(int argc, char** argv)
     //==========================================================================
     Manifold::Init(argc, argv);
 
+    int n_lps;
+    MPI_Comm_size(MPI_COMM_WORLD, &n_lps);
+
     //==========================================================================
     // Initialize Qsim library.
     //==========================================================================
@@ -161,13 +170,25 @@ int main(int argc, char** argv)
         std::cout << "        Finished loading app" << endl;
 
     }
+    else if(!strcasecmp(argv[3],"trace"))
+    {
+        // Each core replays its own trace file given by "trace" in the spx config file;
+        // state_file and benchmark_tar_file are not used.
+        std::cout << "Trace frontend; Qsim is not used" << endl;
+    }
     else
     {
-      std::cout << "unknown qsim_type " << argv[3] << "(qsim_lib or qsim_client)" << endl;
+      std::cout << "unknown qsim_type " << argv[3] << "(qsim_lib, qsim_client or trace)" << endl;
       exit(1);
     }
 
+    if(n_lps > 1 && (qsim_osd || sysBuilder.sampling)) {
+        cerr << "Qsim and sampled simulation require 1 LP; only the trace frontend can be run with more." << endl;
+        exit(1);
+    }
+
 #if 1
+    if(qsim_osd)
     {
       int fastfwd_cores = 0;
       uint64_t fastfwd_count = 0;
@@ -244,7 +265,9 @@ int main(int argc, char** argv)
     }
 
     Clock *interrupt_handler_clock = new Clock(1000.0);
-    interrupt_handler_t *interrupt_handler = Component :: GetComponent<interrupt_handler_t>(Component::Create<interrupt_handler_t>(0, interrupt_handler_clock, qsim_osd));
+    interrupt_handler_t *interrupt_handler = NULL;
+    if(qsim_osd) // timer interrupts are already in the traces
+        interrupt_handler = Component :: GetComponent<interrupt_handler_t>(Component::Create<interrupt_handler_t>(0, interrupt_handler_clock, qsim_osd));
     //interrupt_handler_clock->Register<interrupt_handler_t>(*interrupt_handler_clock,interrupt_handler,&interrupt_handler_t::tick,(void(interrupt_handler_t::*)(void))0);
 
     // need storage for component IDs for connecting components
@@ -259,7 +282,7 @@ int main(int argc, char** argv)
     MySimLen* simLen = new MySimLen(sysBuilder.l1_cache_parameters.block_size, sysBuilder.COH_MSG_TYPE, sysBuilder.MEM_MSG_TYPE, sysBuilder.CREDIT_MSG_TYPE);
     MyVnet* vnet = new MyVnet(sysBuilder.COH_MSG_TYPE, sysBuilder.MEM_MSG_TYPE, sysBuilder.CREDIT_MSG_TYPE);
 
-    sysBuilder.create_network(network_clock, mapping, simLen, vnet);
+    sysBuilder.create_network(network_clock, mapping, simLen, vnet, sysBuilder.get_partition(n_lps));
 
 
     CaffDramMcMap* mc_map = new CaffDramMcMap(sysBuilder.mc_node_idx_vec, sysBuilder.dram_settings);
@@ -291,10 +314,9 @@ int main(int argc, char** argv)
 
     Clock dram_clock(3000000000);	        
     
-    LpId_t node_lp = 0;
-
     int cpuid=0;
     for(int i=0; i<sysBuilder.MAX_NODES; i++) {
+      LpId_t node_lp = sysBuilder.node_lp[i];
       if(sysBuilder.proc_node_idx_set.find(i) != sysBuilder.proc_node_idx_set.end()) { //proc & MC node
         node_cids[i].type = CORE_MC_NODE;
         node_cids[i].proc_cid = Component :: Create<spx_core_t>(node_lp, node_clock[i], i, qsim_osd, argv[2], cpuid++);
@@ -340,15 +362,19 @@ int main(int argc, char** argv)
     sysBuilder.connect_components(node_cids);
 
 #ifdef USE_EI
+    ei_worker_t* ei_worker = 0;
+    if(sysBuilder.ei_async)
+        ei_worker = new ei_worker_t(sysBuilder.ei_queue_size);
+
     vector<ei_wrapper_t*> ei_device;
     ei_device.reserve(sysBuilder.MAX_NODES);
     for(int i=0; i<sysBuilder.MAX_NODES; i++) 
-        if((node_cids[i].type == CORE_MC_NODE) || (node_cids[i].type == CORE_NODE)) {
+        if(((node_cids[i].type == CORE_MC_NODE) || (node_cids[i].type == CORE_NODE)) && sysBuilder.node_lp[i] == Manifold::GetRank()) {
 	    manifold::spx::spx_core_t* proc_global = (spx_core_t*) Component :: GetComponent<spx_core_t>(node_cids[i].proc_cid);
 	    //manifold::mcp_cache_namespace::MESI_LLP_cache* l1_global = (MESI_LLP_cache*) Component :: GetComponent<MESI_LLP_cache>(node_cids[i].l1_cache_cid);
 	    //manifold::mcp_cache_namespace::MESI_LLS_cache* l2_global = (MESI_LLS_cache*) Component :: GetComponent<MESI_LLS_cache>(node_cids[i].l2_cache_cid);
 	    if(proc_global && l1_global && l2_global) {
-                ei_device[i] = new ei_wrapper_t(node_clock[i], energy_introspector, proc_global->pipeline->counters, proc_global->ipa, l1_global->cache_counter, l2_global->cache_counter, sampling_period, sysBuilder.MAX_NODES, i); 
+                ei_device[i] = new ei_wrapper_t(node_clock[i], energy_introspector, proc_global->pipeline->counters, proc_global->ipa, l1_global->cache_counter, l2_global->cache_counter, sampling_period, sysBuilder.MAX_NODES, i, ei_worker);
             } else {
                 cerr << "parsing sim hierachy fails" << endl;
                 exit(1);
@@ -361,9 +387,26 @@ int main(int argc, char** argv)
     //==========================================================================
     // Manifold runs.
     //==========================================================================
+    //the sampler counts cycles on the clock of the first node; with sampling all components are in LP 0.
+    Sampler* sampler = 0;
+    if(sysBuilder.sampling) {
+        sampler = sysBuilder.create_sampler(*node_clock[*sysBuilder.proc_node_idx_set.begin()], node_cids);
+	for(int i=0; i<sysBuilder.MAX_NODES; i++)
+	    sampler->add_stat_engine(node_clock[i]->get_stats());
+	sampler->add_stat_engine(network_clock.get_stats());
+	sampler->add_stat_engine(dram_clock.get_stats());
+    }
+
     Manifold::StopAt(sysBuilder.STOP);
     Manifold::Run();
 
+#ifdef USE_EI
+    delete ei_worker; //finishes the queued EI jobs
+#endif
+
+    if(sampler)
+        sampler->print_stats(cout);
+
 #ifdef REDIRECT_COUT
     sysBuilder.print_stats(node_cids);
     std::cout.rdbuf(cout_sbuf);
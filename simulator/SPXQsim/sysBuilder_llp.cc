@@ -7,6 +7,8 @@
 #include "kernel/clock.h"
 #include "kernel/component.h"
 #include "kernel/manifold.h"
+#include "kernel/sampler.h"
+#include "kernel/stat_engine.h"
 #include "mcp-cache/mux_demux.h"
 #include "CaffDRAM/Controller.h"
 #include "CaffDRAM/McMap.h"
@@ -71,6 +73,30 @@ void SysBuilder_llp :: config_network_topology(Config& config)
 
 
 
+//====================================================================
+//====================================================================
+//! Read an optional cache prefetcher group, e.g.,
+//! prefetch = { type = "stream"; degree = 2; distance = 8; };
+static void read_prefetch_settings(Setting& pf, manifold::mcp_cache_namespace::prefetch_settings& settings)
+{
+    using manifold::mcp_cache_namespace::Prefetcher;
+
+    if(pf.exists("type"))
+	settings.type = Prefetcher :: Parse_type((const char*)pf["type"]);
+    if(pf.exists("degree"))
+	settings.degree = pf["degree"];
+    if(pf.exists("distance"))
+	settings.distance = pf["distance"];
+    if(pf.exists("table_size"))
+	settings.table_size = pf["table_size"];
+    if(pf.exists("mshr_reserve"))
+	settings.mshr_reserve = pf["mshr_reserve"];
+    if(pf.exists("buffer_size"))
+	settings.buffer_size = pf["buffer_size"];
+}
+
+
+
 //====================================================================
 //====================================================================
 void SysBuilder_llp :: config_components(Config& config)
@@ -108,6 +134,12 @@ void SysBuilder_llp :: config_components(Config& config)
 
 	L2_downstream_credits = config.lookup("lls_cache.downstream_credits");
 
+	//optional prefetchers; buffer_size only applies to lls_cache.
+	if(config.exists("llp_cache.prefetch"))
+	    read_prefetch_settings(config.lookup("llp_cache.prefetch"), l1_settings.prefetch);
+	if(config.exists("lls_cache.prefetch"))
+	    read_prefetch_settings(config.lookup("lls_cache.prefetch"), l2_settings.prefetch);
+
 
 
 	//network parameters
@@ -193,6 +225,97 @@ void SysBuilder_llp :: config_components(Config& config)
 #endif
 	MC_DOWNSTREAM_CREDITS = config.lookup("mc.downstream_credits");
 
+	//optional: "analytic" (default) or "fr_fcfs"
+	if(config.exists("mc.scheduler")) {
+	    string sched = (const char*)config.lookup("mc.scheduler");
+	    if(sched == "fr_fcfs") {
+	        dram_settings.memSchedPolicy = manifold::caffdram::FR_FCFS;
+		if(config.exists("mc.read_queue_size"))
+		    dram_settings.readQueueSize = config.lookup("mc.read_queue_size");
+		if(config.exists("mc.write_queue_size"))
+		    dram_settings.writeQueueSize = config.lookup("mc.write_queue_size");
+		if(config.exists("mc.write_high_watermark"))
+		    dram_settings.writeHighWatermark = config.lookup("mc.write_high_watermark");
+		if(config.exists("mc.write_low_watermark"))
+		    dram_settings.writeLowWatermark = config.lookup("mc.write_low_watermark");
+		if(config.exists("mc.row_hit_cap"))
+		    dram_settings.rowHitCap = config.lookup("mc.row_hit_cap");
+	    }
+	    else if(sched != "analytic") {
+	        cout << "mc.scheduler must be \"analytic\" or \"fr_fcfs\"." << endl;
+		exit(1);
+	    }
+	}
+
+	//optional: "none" (default), "all_bank" or "per_bank"
+	if(config.exists("mc.refresh")) {
+	    string ref = (const char*)config.lookup("mc.refresh");
+	    if(ref == "all_bank")
+	        dram_settings.memRefreshPolicy = manifold::caffdram::ALL_BANK_REFRESH;
+	    else if(ref == "per_bank")
+	        dram_settings.memRefreshPolicy = manifold::caffdram::PER_BANK_REFRESH;
+	    else if(ref != "none") {
+	        cout << "mc.refresh must be \"none\", \"all_bank\" or \"per_bank\"." << endl;
+		exit(1);
+	    }
+	}
+	if(config.exists("mc.power_down_idle_time"))
+	    dram_settings.powerDownIdleTime = (int)config.lookup("mc.power_down_idle_time");
+
+	//optional address mapping; see CaffDRAM Dsettings.
+	dram_settings.numMcs = num_mc;
+	if(config.exists("mc.address_map")) {
+	    Setting& map = config.lookup("mc.address_map");
+	    if(map.exists("mapping"))
+	        dram_settings.addressMapping = (const char*)map["mapping"];
+	    if(map.exists("bank_xor"))
+	        dram_settings.bankXor = (bool)map["bank_xor"];
+	    if(map.exists("channel_xor"))
+	        dram_settings.channelXor = (bool)map["channel_xor"];
+	    if(map.exists("mc_xor"))
+	        dram_settings.mcXor = (bool)map["mc_xor"];
+	    if(map.exists("interleave")) {
+	        string il = (const char*)map["interleave"];
+		if(il == "line") {
+		    int bits = 0;
+		    while((0x1 << bits) < dram_settings.llcacheLineSizeBytes)
+		        bits++;
+		    dram_settings.mcInterleaveShift = bits;
+		}
+		else if(il == "page")
+		    dram_settings.mcInterleaveShift = 12;
+		else {
+		    cout << "mc.address_map.interleave must be \"line\" or \"page\"." << endl;
+		    exit(1);
+		}
+	    }
+	}
+
+	//optional sampled simulation; lengths are in instructions.
+	sampling = config.exists("sampling");
+	if(sampling) {
+	    Setting& smp = config.lookup("sampling");
+	    sampler_settings.functional_len = (int)smp["functional"];
+	    sampler_settings.warmup_len = (int)smp["warmup"];
+	    sampler_settings.measure_len = (int)smp["measure"];
+	    if(smp.exists("samples"))
+	        sampler_settings.max_samples = (int)smp["samples"];
+	    if(smp.exists("confidence"))
+	        sampler_settings.confidence = (double)smp["confidence"];
+	    if(smp.exists("drain_quiet"))
+	        sampler_settings.drain_quiet = (int)smp["drain_quiet"];
+	}
+
+	//optional: the energy introspector runs in a background thread; the
+	//queue holds the EI jobs the simulation may be ahead of the worker.
+	ei_async = config.exists("ei_async");
+	ei_queue_size = 64;
+	if(ei_async) {
+	    Setting& eia = config.lookup("ei_async");
+	    if(eia.exists("queue_size"))
+	        ei_queue_size = (int)eia["queue_size"];
+	}
+
     }
     catch (SettingNotFoundException e) {
 	cout << e.getPath() << " not set." << endl;
@@ -214,66 +337,63 @@ void SysBuilder_llp :: create_network(Clock& clock, Terminal_to_net_mapping* map
     myTorus = 0;
     myTorus6p = 0;
 
+    //LP of each node; the components of a node are created in the same LP as its router.
+    //The ring is always in LP 0.
+    assert(this->net_topology != TOPO_RING || part == PART_1);
+    node_lp.resize(x_dimension*y_dimension);
+    switch(part) {
+	case PART_1:
+	    for (int i = 0; i < x_dimension*y_dimension; i++) {
+		node_lp[i] = 0;
+	    }
+	    break;
+	case PART_2:
+	    for (int i = 0; i < x_dimension*y_dimension; i++) {
+		if(i < x_dimension*y_dimension/2)
+		    node_lp[i] = 0;
+		else
+		    node_lp[i] = 1;
+	    }
+	    break;
+	case PART_Y:
+	    for (int i = 0; i < x_dimension*y_dimension; i++) {
+		node_lp[i] = i / x_dimension;
+	    }
+	    break;
+	default:
+	    assert(0);
+    }//switch
+
     if(this->net_topology == TOPO_RING) {
 	myRing = topoCreator<NetworkPacket>::create_ring(clock, &(this->ring_params), mapping, simLen, vn, this->CREDIT_MSG_TYPE, 0, 0); //network on LP 0
     } else if (this->net_topology == TOPO_TORUS) {
-	vector<int> node_lp;
-	node_lp.resize(x_dimension*y_dimension);
-	switch(part) {
-	    case PART_1:
-		for (int i = 0; i < x_dimension*y_dimension; i++) {
-		    node_lp[i] = 0;
-		}
-		break;
-	    case PART_2:
-		for (int i = 0; i < x_dimension*y_dimension; i++) {
-		    if(i < x_dimension*y_dimension/2)
-			node_lp[i] = 0;
-		    else
-			node_lp[i] = 1;
-		}
-		break;
-	    case PART_Y:
-		for (int i = 0; i < x_dimension*y_dimension; i++) {
-		    node_lp[i] = i / x_dimension;
-		}
-		break;
-	    default:
-		assert(0);
-	}//switch
-	myTorus = topoCreator<NetworkPacket>::create_torus(clock, &(this->torus_params), mapping, simLen, vn, this->CREDIT_MSG_TYPE, &node_lp); //network on LP 0
+	myTorus = topoCreator<NetworkPacket>::create_torus(clock, &(this->torus_params), mapping, simLen, vn, this->CREDIT_MSG_TYPE, &node_lp);
     } else {
-	vector<int> node_lp;
-	node_lp.resize(x_dimension*y_dimension);
-	switch(part) {
-	    case PART_1:
-		for (int i = 0; i < x_dimension*y_dimension; i++) {
-		    node_lp[i] = 0;
-		}
-		break;
-	    case PART_2:
-		for (int i = 0; i < x_dimension*y_dimension; i++) {
-		    if(i < x_dimension*y_dimension/2)
-			node_lp[i] = 0;
-		    else
-			node_lp[i] = 1;
-		}
-		break;
-	    case PART_Y:
-		for (int i = 0; i < x_dimension*y_dimension; i++) {
-		    node_lp[i] = i / x_dimension;
-		}
-		break;
-	    default:
-		assert(0);
-	}//switch
-	myTorus6p = topoCreator<NetworkPacket>::create_torus6p(clock, &(this->torus6p_params), mapping, simLen, vn, this->CREDIT_MSG_TYPE, &node_lp); //network on LP 0
+	myTorus6p = topoCreator<NetworkPacket>::create_torus6p(clock, &(this->torus6p_params), mapping, simLen, vn, this->CREDIT_MSG_TYPE, &node_lp);
     }
 
 }
 
 
 
+//====================================================================
+//====================================================================
+int SysBuilder_llp :: get_partition(int n_lps)
+{
+    if(n_lps == 1)
+	return PART_1;
+    if(this->net_topology != TOPO_RING) {
+	if(n_lps == 2)
+	    return PART_2;
+	if(n_lps == y_dimension)
+	    return PART_Y;
+    }
+    cerr << "The network cannot be partitioned into " << n_lps << " LPs; use 1, 2, or y_dimension LPs with a torus." << endl;
+    exit(1);
+}
+
+
+
 //====================================================================
 //====================================================================
 void SysBuilder_llp :: connect_components(const Node_cid_llp node_cids[])
@@ -459,6 +579,44 @@ void SysBuilder_llp :: register_components_with_clock(const Node_cid_llp node_ci
 
 #endif
 
+//====================================================================
+//====================================================================
+Sampler* SysBuilder_llp :: create_sampler(Clock& clock, const Node_cid_llp node_cids[])
+{
+    CompId_t sampler_cid = Component :: Create<Sampler>(0, &clock, sampler_settings);
+    Sampler* sampler = Component :: GetComponent<Sampler>(sampler_cid);
+
+    for(int i=0; i<this->MAX_NODES; i++) {
+        if(node_cids[i].type == CORE_MC_NODE) {
+	    spx_core_t* proc = Component :: GetComponent<spx_core_t>(node_cids[i].proc_cid);
+	    if(proc)
+		sampler->add_core(proc);
+
+            MESI_LLP_cache* l1 = Component :: GetComponent<MESI_LLP_cache>(node_cids[i].l1_cache_cid);
+	    if(l1) {
+		sampler->add_component(l1);
+		sampler->add_stat_engine(l1->get_stat_engine());
+	    }
+	    MESI_LLS_cache* l2 = Component :: GetComponent<MESI_LLS_cache>(node_cids[i].l2_cache_cid);
+	    if(l2) {
+		sampler->add_component(l2);
+		sampler->add_stat_engine(l2->get_stat_engine());
+	    }
+
+	    Controller* mc = Component :: GetComponent<Controller>(node_cids[i].mc_cid);
+	    if(mc) {
+		vector<Stat_engine*> engines;
+		mc->get_stat_engines(engines);
+		for(unsigned j=0; j<engines.size(); j++)
+		    sampler->add_stat_engine(engines[j]);
+	    }
+	}
+    }
+
+    return sampler;
+}
+
+
 //====================================================================
 //====================================================================
 void SysBuilder_llp :: print_stats(const Node_cid_llp node_cids[])
@@ -4,6 +4,7 @@
 #include <libconfig.h++>
 #include "kernel/manifold.h"
 #include "kernel/component.h"
+#include "kernel/sampler.h"
 #include "iris/interfaces/simulatedLen.h"
 #include "iris/interfaces/vnetAssign.h"
 #include "iris/interfaces/genericIrisInterface.h"
@@ -50,6 +51,8 @@ public:
     void config_components(libconfig::Config& config);
     void create_network(manifold::kernel::Clock& clock, manifold::iris::Terminal_to_net_mapping* mapping,
                         MySimLen* simLen, MyVnet* vn, int p=PART_1);
+    //return the partitioning of the network for the given number of LPs.
+    int get_partition(int n_lps);
     void connect_components(const Node_cid_llp cids[]);
     void config_cache_settings(manifold::uarch::DestMap* l2_map,
                                manifold::uarch::DestMap* mc_map);
@@ -58,6 +61,10 @@ public:
     //template<typename CORE>
     void print_stats(const Node_cid_llp node_cids[]);
 
+    //create the sampler on the given clock and register the cores, caches and
+    //memory controllers with it.
+    manifold::kernel::Sampler* create_sampler(manifold::kernel::Clock& clock, const Node_cid_llp node_cids[]);
+
 
     int net_topology;
 
@@ -68,6 +75,10 @@ public:
     //kernel
     int FREQ; //clock frequency
     manifold::kernel::Ticks_t STOP; //simulation stop time
+    bool sampling; //sampled simulation
+    manifold::kernel::Sampler_settings sampler_settings;
+    bool ei_async; //EI runs in a background thread
+    unsigned ei_queue_size; //EI jobs queued for the background thread
 
     //proc
     vector<int> proc_node_idx_vec;
@@ -95,6 +106,7 @@ public:
     manifold::iris::Ring<manifold::uarch::NetworkPacket>* myRing;
     manifold::iris::Torus<manifold::uarch::NetworkPacket>* myTorus;
     manifold::iris::Torus6p<manifold::uarch::NetworkPacket>* myTorus6p;
+    vector<int> node_lp; //LP of each node; set by create_network()
 
     //mc
     int MC_DOWNSTREAM_CREDITS;
@@ -1,14 +1,148 @@
 #ifndef MANIFOLD_UARCH_NETWORKPACKET_H
 #define MANIFOLD_UARCH_NETWORKPACKET_H
 
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "kernel/serialize.h"
+
 namespace manifold {
 namespace uarch {
 
 //enum TERM_TYPE { NIL = 0, CACHE, MEMORY };
 
+//! Free lists for NetworkPacket objects and their payloads.
+//! Packets and payloads are recycled instead of being returned to the heap, since
+//! millions of them are created and destroyed during a simulation. A payload has a
+//! reference count so that packets can share it instead of copying it.
+//! The pools are per process; the kernel runs each LP in a single thread.
+class NetworkPacketPool {
+public:
+    //! Payload capacities are 16, 32, 64, 128 and 256 bytes.
+    enum { MIN_PAYLOAD_SHIFT = 4, NUM_PAYLOAD_CLASSES = 5 };
+
+    static void* alloc_packet(size_t size)
+    {
+	void*& head = packet_free_list();
+	if(head) {
+	    void* p = head;
+	    head = *((void**)p);
+	    return p;
+	}
+	return malloc(size);
+    }
+
+    static void free_packet(void* p)
+    {
+	void*& head = packet_free_list();
+	*((void**)p) = head;
+	head = p;
+    }
+
+    //! Return a payload of at least size bytes with a reference count of 1.
+    static char* alloc_payload(int size)
+    {
+	int c = 0;
+	while((1 << (c + MIN_PAYLOAD_SHIFT)) < size)
+	    c++;
+	assert(c < NUM_PAYLOAD_CLASSES);
+
+	void*& head = payload_free_list(c);
+	Payload_header* h;
+	if(head) {
+	    h = (Payload_header*)head;
+	    head = *((void**)head);
+	}
+	else
+	    h = (Payload_header*)malloc(sizeof(Payload_header) + (1 << (c + MIN_PAYLOAD_SHIFT)));
+	h->refs = 1;
+	h->size_class = c;
+	return (char*)(h + 1);
+    }
+
+    static void ref_payload(char* data) { header(data)->refs++; }
+
+    static void unref_payload(char* data)
+    {
+	Payload_header* h = header(data);
+	assert(h->refs > 0);
+	if(--h->refs == 0) {
+	    void*& head = payload_free_list(h->size_class);
+	    *((void**)h) = head;
+	    head = h;
+	}
+    }
+
+    static int payload_refs(const char* data) { return header(data)->refs; }
+
+private:
+    //! Placed in front of the payload bytes; the size keeps the payload 8-byte aligned.
+    struct Payload_header {
+	int refs;
+	int size_class;
+    };
+
+    static Payload_header* header(const char* data) { return (Payload_header*)data - 1; }
+
+    static void*& packet_free_list()
+    {
+	static void* head = 0;
+	return head;
+    }
+
+    static void*& payload_free_list(int c)
+    {
+	static void* heads[NUM_PAYLOAD_CLASSES] = { 0 };
+	return heads[c];
+    }
+};
+
+
+
+//! A packet is a small header plus an optional payload. The payload is allocated
+//! out of line from NetworkPacketPool and is reference counted: copying a packet
+//! shares the payload instead of copying it. Credits carry no payload at all.
 class NetworkPacket {
 public:
-    static const int MAX_SIZE = 256;
+    static const int MAX_SIZE = 256; //max payload size
+
+    NetworkPacket() : type(0), src(0), src_port(0), dst(0), dst_port(0), data(0), data_size(0) {}
+
+    NetworkPacket(const NetworkPacket& p) :
+        type(p.type), src(p.src), src_port(p.src_port), dst(p.dst), dst_port(p.dst_port),
+	data(p.data), data_size(p.data_size)
+    {
+	if(data)
+	    NetworkPacketPool::ref_payload(data);
+    }
+
+    ~NetworkPacket() { release_data(); }
+
+    NetworkPacket& operator=(const NetworkPacket& p)
+    {
+	if(p.data)
+	    NetworkPacketPool::ref_payload(p.data);
+	release_data();
+	type = p.type;
+	src = p.src;
+	src_port = p.src_port;
+	dst = p.dst;
+	dst_port = p.dst_port;
+	data = p.data;
+	data_size = p.data_size;
+	return *this;
+    }
+
+    static void* operator new(size_t size) { return NetworkPacketPool::alloc_packet(size); }
+    static void operator delete(void* p) { NetworkPacketPool::free_packet(p); }
+
+    //! Create a credit message: a packet of the given type without payload.
+    static NetworkPacket* Create_credit(int t)
+    {
+	NetworkPacket* pkt = new NetworkPacket;
+	pkt->type = t;
+	return pkt;
+    }
 
     int get_type() { return type; }
     void set_type(int t) { type = t; }
@@ -23,12 +157,54 @@ public:
 //    int get_term() { return term; }
 //    int set_term() {}
 
+    //! Replace the payload with a new one of the given size; the content is undefined.
+    char* alloc_data(int size)
+    {
+	assert(size > 0 && size <= MAX_SIZE);
+	release_data();
+	data = NetworkPacketPool::alloc_payload(size);
+	data_size = size;
+	return data;
+    }
+
+    //! Copy an object into a new payload.
+    template<typename T>
+    void set_data(const T& obj)
+    {
+	*((T*)alloc_data(sizeof(T))) = obj;
+    }
+
+    //! Drop this packet's reference to the payload.
+    void release_data()
+    {
+	if(data)
+	    NetworkPacketPool::unref_payload(data);
+	data = 0;
+	data_size = 0;
+    }
+
+    //! True if the payload is shared with another packet; it should then be treated
+    //! as read-only.
+    bool is_data_shared() const { return data && NetworkPacketPool::payload_refs(data) > 1; }
+
+    //! Give this packet its own copy of the payload if it's shared, so that it can be
+    //! modified in place.
+    void unshare_data()
+    {
+	if(is_data_shared()) {
+	    char* old = data;
+	    data = NetworkPacketPool::alloc_payload(data_size);
+	    memcpy(data, old, data_size);
+	    NetworkPacketPool::unref_payload(old);
+	}
+    }
+
     int type;
     int src;
     int src_port;
     int dst;
     int dst_port;
-    char data[MAX_SIZE];
+    char* data; //payload; 0 if the packet has none
     int data_size;
 
 //    int term;
@@ -38,4 +214,58 @@ public:
 } // namespace uarch
 } //namespace manifold
 
+
+
+//! Only the header fields and data_size bytes of payload are serialized.
+namespace manifold {
+namespace kernel {
+
+template<>
+inline size_t
+Get_serialize_size<manifold::uarch::NetworkPacket>(const manifold::uarch::NetworkPacket* pkt)
+{
+    return sizeof(int) * 6 + pkt->data_size;
+}
+
+template<>
+inline size_t
+Serialize<manifold::uarch::NetworkPacket>(const manifold::uarch::NetworkPacket* pkt, unsigned char* buf)
+{
+    int hdr[6] = { pkt->type, pkt->src, pkt->src_port, pkt->dst, pkt->dst_port, pkt->data_size };
+    memcpy(buf, hdr, sizeof(hdr));
+    if(pkt->data_size > 0)
+	memcpy(buf + sizeof(hdr), pkt->data, pkt->data_size);
+    return sizeof(hdr) + pkt->data_size;
+}
+
+template<>
+inline size_t
+Serialize<manifold::uarch::NetworkPacket>(manifold::uarch::NetworkPacket* pkt, unsigned char* buf)
+{
+    size_t len = Serialize<manifold::uarch::NetworkPacket>((const manifold::uarch::NetworkPacket*)pkt, buf);
+    delete pkt;
+    return len;
+}
+
+template<>
+inline manifold::uarch::NetworkPacket*
+Deserialize<manifold::uarch::NetworkPacket>(unsigned char* buf)
+{
+    int hdr[6];
+    memcpy(hdr, buf, sizeof(hdr));
+
+    manifold::uarch::NetworkPacket* pkt = new manifold::uarch::NetworkPacket;
+    pkt->type = hdr[0];
+    pkt->src = hdr[1];
+    pkt->src_port = hdr[2];
+    pkt->dst = hdr[3];
+    pkt->dst_port = hdr[4];
+    if(hdr[5] > 0)
+	memcpy(pkt->alloc_data(hdr[5]), buf + sizeof(hdr), hdr[5]);
+    return pkt;
+}
+
+} //namespace kernel
+} //namespace manifold
+
 #endif // MANIFOLD_UARCH_NETWORKPACKET_H
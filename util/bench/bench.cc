@@ -0,0 +1,93 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+
+namespace manifold {
+namespace bench {
+
+double Now()
+{
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+
+static volatile uint64_t Sink;
+
+//! A mix of integer arithmetic and random accesses to a 1 MB table, roughly
+//! what a simulator spends its time on.
+static double Calibrate_once()
+{
+    const unsigned SIZE = 1 << 18;
+    const unsigned ITERS = 1 << 24;
+    std::vector<uint32_t> table(SIZE);
+    for(unsigned i=0; i<SIZE; i++)
+        table[i] = i * 2654435761U;
+
+    double start = Now();
+    uint64_t x = 1, acc = 0;
+    for(unsigned i=0; i<ITERS; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+	unsigned idx = (x >> 40) & (SIZE - 1);
+	acc += table[idx];
+	table[idx] ^= (uint32_t)x;
+    }
+    double secs = Now() - start;
+    Sink = acc;
+    return ITERS / secs / 1e6;
+}
+
+
+double Host_score()
+{
+    static double score = 0;
+    if(score == 0) {
+        //best of 3, to filter out interference
+        for(int i=0; i<3; i++) {
+	    double s = Calibrate_once();
+	    if(s > score)
+	        score = s;
+	}
+    }
+    return score;
+}
+
+
+void Print_header()
+{
+    printf("suite,bench,params,ops,unit,sim_ticks,seconds,ops_per_sec,host_score,norm,extra\n");
+}
+
+
+void Report(const char* suite, const char* bench, const std::string& params,
+            uint64_t ops, const char* unit, uint64_t sim_ticks, double secs,
+            const std::string& extra)
+{
+    double rate = secs > 0 ? ops / secs : 0;
+    double score = Host_score();
+    printf("%s,%s,%s,%llu,%s,%llu,%.6f,%.1f,%.2f,%.2f,%s\n", suite, bench, params.c_str(),
+           (unsigned long long)ops, unit, (unsigned long long)sim_ticks, secs, rate, score,
+	   rate / score, extra.c_str());
+    fflush(stdout);
+}
+
+
+int Parse_options(int argc, char** argv)
+{
+    int n = 1;
+    for(int i=1; i<argc; i++) {
+        if(strcmp(argv[i], "-H") == 0)
+	    Print_header();
+	else
+	    argv[n++] = argv[i];
+    }
+    argv[n] = 0;
+    return n;
+}
+
+} //namespace bench
+} //namespace manifold
@@ -0,0 +1,61 @@
+//! Common code of the benchmarks: timing, host calibration and result output.
+//!
+//! Each benchmark prints one CSV row per run:
+//!   suite,bench,params,ops,unit,sim_ticks,seconds,ops_per_sec,host_score,norm,extra
+//! where seconds is the wall-clock time of Manifold::Run() only, host_score is the
+//! speed of this host in million iterations/s of a fixed calibration loop, and norm
+//! is ops_per_sec / host_score, i.e., operations per million calibration
+//! iterations, which can be compared across hosts. params and extra are lists of
+//! key=value separated by ';'.
+#ifndef MANIFOLD_BENCH_H
+#define MANIFOLD_BENCH_H
+
+#include <stdint.h>
+#include <string>
+
+namespace manifold {
+namespace bench {
+
+//! Wall-clock time in seconds.
+double Now();
+
+//! Million iterations/s of the calibration loop; measured on the first call.
+double Host_score();
+
+//! Print the CSV header.
+void Print_header();
+
+//! Print the result of a run.
+void Report(const char* suite, const char* bench, const std::string& params,
+            uint64_t ops, const char* unit, uint64_t sim_ticks, double secs,
+            const std::string& extra = "");
+
+//! Handle the common command-line options. Removes -H (print the header first)
+//! from argv and returns the new argc.
+int Parse_options(int argc, char** argv);
+
+//! Deterministic pseudo-random numbers, so runs are reproducible on any host.
+class Rng {
+public:
+    Rng(uint64_t seed) : m_x(seed * 0x9e3779b97f4a7c15ULL + 1) {}
+
+    uint64_t next()
+    {
+        m_x = m_x * 6364136223846793005ULL + 1442695040888963407ULL;
+	return m_x >> 16;
+    }
+
+    //! Uniform in [0, n).
+    uint64_t next(uint64_t n) { return next() % n; }
+
+    //! True with probability p.
+    bool chance(double p) { return (next() & 0xffffff) < p * 0x1000000; }
+
+private:
+    uint64_t m_x;
+};
+
+} //namespace bench
+} //namespace manifold
+
+#endif //MANIFOLD_BENCH_H
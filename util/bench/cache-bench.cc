@@ -0,0 +1,321 @@
+//! mcp-cache benchmark: MESI L1/L2 caches driven by synthetic processors.
+//!
+//! Usage:
+//!   cache-bench [-H] <seq|random|mix> <cores> <accesses_per_core>
+//! Each core has a private L1 and a slice of the shared L2, interleaved by cache
+//! line. The caches are connected by an ideal crossbar and backed by two fixed
+//! latency memory controllers, so the run time is spent in the cache models.
+//!   seq     each core streams through its own region; 1 in 4 accesses is a store.
+//!   random  uniformly random lines in a region shared by all cores, 4 times the
+//!           total L2 size; 1 in 4 accesses is a store.
+//!   mix     80% of the accesses go to a small private hot set, the rest are random
+//!           in the shared region; 30% stores.
+//! Each core keeps up to 4 requests outstanding. ops are completed processor requests.
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "MESI_L1_cache.h"
+#include "MESI_L2_cache.h"
+#include "uarch/DestMap.h"
+#include "uarch/networkPacket.h"
+#include "kernel/manifold.h"
+#include "kernel/component.h"
+#include "bench.h"
+
+using namespace std;
+using namespace manifold::kernel;
+using namespace manifold::uarch;
+using namespace manifold::mcp_cache_namespace;
+using namespace manifold::bench;
+
+static Clock MasterClock(1000000000);
+
+static const int COH_TYPE = 123;
+static const int MEM_TYPE = 456;
+static const int CREDIT_TYPE = 789;
+
+static const int LINE_SIZE = 64;
+static const int L2_SIZE = 256 * 1024; //per core
+static const int NUM_MCS = 2;
+static const Ticks_t NET_LATENCY = 5;
+static const Ticks_t MEM_LATENCY = 100;
+static const unsigned MAX_OUTSTANDING = 4;
+
+enum Pattern_t { PAT_SEQ, PAT_RANDOM, PAT_MIX };
+
+
+struct Proc_req {
+    Proc_req(paddr_t a, bool r) : addr(a), read(r) {}
+    paddr_t get_addr() { return addr; }
+    bool is_read() { return read; }
+
+    paddr_t addr;
+    bool read;
+};
+
+
+//! Interleaves cache lines over a set of node ids.
+class Line_map : public DestMap {
+public:
+    Line_map(int first, int n) : m_first(first), m_n(n) {}
+    int lookup(uint64_t addr) { return m_first + (addr / LINE_SIZE) % m_n; }
+private:
+    const int m_first;
+    const int m_n;
+};
+
+
+//! Issues requests of a pattern, keeping up to MAX_OUTSTANDING in flight.
+class Proc : public Component {
+public:
+    enum { PORT_L1 = 0 };
+
+    Proc(int id, int pattern, int cores, uint64_t accesses) :
+        m_issued(0), m_completed(0), m_id(id), m_pattern((Pattern_t)pattern), m_cores(cores),
+        m_total(accesses), m_rng(id + 1), m_outstanding(0)
+    {}
+
+    void tick()
+    {
+        while(m_outstanding < MAX_OUTSTANDING && m_issued < m_total) {
+	    Send(PORT_L1, next_req());
+	    m_issued++;
+	    m_outstanding++;
+	}
+    }
+
+    void handle_incoming(int, Proc_req* req)
+    {
+        delete req;
+	m_outstanding--;
+	m_completed++;
+	if(m_completed == m_total)
+	    Done++;
+    }
+
+    uint64_t m_issued;
+    uint64_t m_completed;
+
+    static int Done; //number of processors that completed all requests
+
+private:
+    Proc_req* next_req()
+    {
+	const paddr_t PRIVATE_REGION = 64 << 20;
+	const paddr_t SHARED_BASE = (paddr_t)m_cores * PRIVATE_REGION;
+	const uint64_t SHARED_LINES = 4 * (uint64_t)m_cores * L2_SIZE / LINE_SIZE;
+	const uint64_t HOT_LINES = 256;
+
+        paddr_t addr = 0;
+	bool read = true;
+	switch(m_pattern) {
+	    case PAT_SEQ:
+	        addr = m_id * PRIVATE_REGION + (m_issued * LINE_SIZE) % PRIVATE_REGION;
+		read = m_rng.next(4) != 0;
+		break;
+	    case PAT_RANDOM:
+	        addr = SHARED_BASE + m_rng.next(SHARED_LINES) * LINE_SIZE;
+		read = m_rng.next(4) != 0;
+		break;
+	    case PAT_MIX:
+	        if(m_rng.next(10) < 8)
+		    addr = m_id * PRIVATE_REGION + m_rng.next(HOT_LINES) * LINE_SIZE;
+		else
+		    addr = SHARED_BASE + m_rng.next(SHARED_LINES) * LINE_SIZE;
+		read = m_rng.next(10) >= 3;
+		break;
+	}
+	return new Proc_req(addr, read);
+    }
+
+    const int m_id;
+    const Pattern_t m_pattern;
+    const int m_cores;
+    const uint64_t m_total;
+    Rng m_rng;
+    unsigned m_outstanding;
+};
+
+int Proc::Done = 0;
+
+
+//! Ideal crossbar: a port per node id, fixed latency, unlimited buffering. Credits
+//! are returned to the sender at once; credits from the nodes are dropped.
+class Crossbar : public Component {
+public:
+    void handle_incoming(int port, NetworkPacket* pkt)
+    {
+        if(pkt->type == CREDIT_TYPE) {
+	    delete pkt;
+	    return;
+	}
+	Send(port, NetworkPacket::Create_credit(CREDIT_TYPE));
+	SendTick(pkt->dst, pkt, NET_LATENCY);
+    }
+};
+
+
+//! Answers every request after a fixed latency.
+class Mem_ctrl : public Component {
+public:
+    enum { PORT_NET = 0 };
+
+    Mem_ctrl(int nid) : m_nid(nid) {}
+
+    void handle_incoming(int, NetworkPacket* pkt)
+    {
+        if(pkt->type == CREDIT_TYPE) {
+	    delete pkt;
+	    return;
+	}
+	assert(pkt->type == MEM_TYPE);
+	pkt->dst = pkt->src;
+	pkt->dst_port = pkt->src_port;
+	pkt->src = m_nid;
+	SendTick(PORT_NET, pkt, MEM_LATENCY);
+    }
+
+private:
+    const int m_nid;
+};
+
+
+//! Stop the simulation once all processors are done.
+class Terminator : public Component {
+public:
+    Terminator(int cores) : m_cores(cores) {}
+    void tick()
+    {
+        if(Proc::Done == m_cores)
+	    Manifold::StopAt(Manifold::NowTicks());
+    }
+private:
+    const int m_cores;
+};
+
+
+
+static void Usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " [-H] <seq|random|mix> <cores> <accesses_per_core>" << endl;
+    exit(1);
+}
+
+
+int main(int argc, char** argv)
+{
+    argc = Parse_options(argc, argv);
+    if(argc != 4)
+        Usage(argv[0]);
+
+    string pat = argv[1];
+    Pattern_t pattern = PAT_SEQ;
+    if(pat == "seq")
+        pattern = PAT_SEQ;
+    else if(pat == "random")
+        pattern = PAT_RANDOM;
+    else if(pat == "mix")
+        pattern = PAT_MIX;
+    else
+        Usage(argv[0]);
+    const int cores = atoi(argv[2]);
+    const uint64_t accesses = strtoull(argv[3], 0, 0);
+    if(cores < 1 || accesses < 1)
+        Usage(argv[0]);
+
+    Manifold::Init(Manifold::TICKED);
+
+    //node ids: L1s are 0 to cores-1, L2s are cores to 2*cores-1, then the MCs.
+    const int L2_BASE = cores;
+    const int MC_BASE = 2 * cores;
+
+    cache_settings l1_parameters;
+    l1_parameters.name = "L1";
+    l1_parameters.size = 32 * 1024;
+    l1_parameters.assoc = 4;
+    l1_parameters.block_size = LINE_SIZE;
+    l1_parameters.hit_time = 2;
+    l1_parameters.lookup_time = 2;
+    l1_parameters.replacement_policy = RP_LRU;
+
+    cache_settings l2_parameters;
+    l2_parameters.name = "L2";
+    l2_parameters.size = L2_SIZE;
+    l2_parameters.assoc = 8;
+    l2_parameters.block_size = LINE_SIZE;
+    l2_parameters.hit_time = 10;
+    l2_parameters.lookup_time = 10;
+    l2_parameters.replacement_policy = RP_LRU;
+
+    L1_cache::Set_msg_types(COH_TYPE, CREDIT_TYPE);
+    L2_cache::Set_msg_types(COH_TYPE, MEM_TYPE, CREDIT_TYPE);
+
+    L1_cache_settings l1_settings;
+    l1_settings.l2_map = new Line_map(L2_BASE, cores);
+    l1_settings.mshr_sz = 8;
+    l1_settings.downstream_credits = 10;
+
+    L2_cache_settings l2_settings;
+    l2_settings.mc_map = new Line_map(MC_BASE, NUM_MCS);
+    l2_settings.mshr_sz = 16;
+    l2_settings.downstream_credits = 10;
+
+    CompId_t net_id = Component::Create<Crossbar>(0);
+
+    vector<Proc*> procs(cores);
+    for(int i=0; i<cores; i++) {
+	CompId_t proc_id = Component::Create<Proc>(0, i, (int)pattern, cores, accesses);
+	procs[i] = Component::GetComponent<Proc>(proc_id);
+	CompId_t l1_id = Component::Create<MESI_L1_cache>(0, i, l1_parameters, l1_settings);
+	MESI_L1_cache* l1 = Component::GetComponent<MESI_L1_cache>(l1_id);
+
+	Manifold::Connect(proc_id, Proc::PORT_L1, &Proc::handle_incoming,
+	                  l1_id, MESI_L1_cache::PORT_PROC, &MESI_L1_cache::handle_processor_request<Proc_req>,
+			  MasterClock, MasterClock, 1, 1);
+	Manifold::Connect(l1_id, MESI_L1_cache::PORT_L2, &MESI_L1_cache::handle_peer_and_manager_request,
+	                  net_id, i, &Crossbar::handle_incoming,
+			  MasterClock, MasterClock, 1, 1);
+	Clock::Register(MasterClock, procs[i], &Proc::tick, (void(Proc::*)(void))0);
+	Clock::Register(MasterClock, (L1_cache*)l1, &L1_cache::tick, (void(L1_cache::*)(void))0);
+    }
+
+    for(int i=0; i<cores; i++) {
+	CompId_t l2_id = Component::Create<MESI_L2_cache>(0, L2_BASE + i, l2_parameters, l2_settings);
+	Manifold::Connect(l2_id, MESI_L2_cache::PORT_L1, &MESI_L2_cache::handle_incoming<Mem_msg>,
+	                  net_id, L2_BASE + i, &Crossbar::handle_incoming,
+			  MasterClock, MasterClock, 1, 1);
+    }
+
+    for(int i=0; i<NUM_MCS; i++) {
+	CompId_t mc_id = Component::Create<Mem_ctrl>(0, MC_BASE + i);
+	Manifold::Connect(mc_id, Mem_ctrl::PORT_NET, &Mem_ctrl::handle_incoming,
+	                  net_id, MC_BASE + i, &Crossbar::handle_incoming,
+			  MasterClock, MasterClock, 1, 1);
+    }
+
+    CompId_t term_id = Component::Create<Terminator>(0, cores);
+    Clock::Register(MasterClock, Component::GetComponent<Terminator>(term_id), &Terminator::tick,
+                    (void(Terminator::*)(void))0);
+
+    double start = Now();
+    Manifold::Run();
+    double secs = Now() - start;
+
+    uint64_t completed = 0;
+    for(int i=0; i<cores; i++)
+        completed += procs[i]->m_completed;
+    if(Proc::Done != cores) {
+        cerr << "Only " << Proc::Done << " of " << cores << " processors completed." << endl;
+	exit(1);
+    }
+
+    ostringstream params, extra;
+    params << "pattern=" << pat << ";cores=" << cores << ";accesses=" << accesses;
+    extra << "sim_cycles_per_access=" << (double)MasterClock.NowTicks() / accesses;
+    Report("cache", "mesi", params.str(), completed, "accesses", MasterClock.NowTicks(), secs, extra.str());
+
+    Manifold::Finalize();
+    return 0;
+}
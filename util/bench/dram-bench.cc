@@ -0,0 +1,244 @@
+//! CaffDRAM benchmark: one controller driven by a synthetic request stream.
+//!
+//! Usage:
+//!   dram-bench [-H] <analytic|frfcfs|simple|simple-q> <stream_pct> <read_pct> <requests> <outstanding>
+//! stream_pct% of the requests continue a sequential stream of cache lines, the rest
+//! go to random lines; read_pct% are loads. Up to outstanding requests are in the
+//! controller at a time. analytic and frfcfs use CaffDRAM with the default Dsettings
+//! and the given scheduler. simple uses SimpleMC with the unloaded row-miss latency
+//! of those settings; simple-q adds SimpleMC's bank and channel model with matching
+//! parameters. ops are completed requests.
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+
+#include "Controller.h"
+#include "Dsettings.h"
+#include "simple-mc/simple_mc.h"
+#include "uarch/networkPacket.h"
+#include "kernel/manifold.h"
+#include "kernel/component.h"
+#include "bench.h"
+
+using namespace std;
+using namespace manifold::kernel;
+using namespace manifold::uarch;
+using namespace manifold::caffdram;
+using namespace manifold::simple_mc;
+using namespace manifold::bench;
+
+static Clock MasterClock(1000000000);
+
+static const int MEM_TYPE = 11;
+static const int CREDIT_TYPE = 22;
+static const int LINE_SIZE = 64;
+static const int MC_NID = 0;
+static const int SENDER_NID = 1;
+
+
+struct Mem_req {
+    int src;
+    int src_port;
+    int dst;
+    int dst_port;
+    uint64_t addr;
+    bool read;
+
+    int get_src() { return src; }
+    void set_src(int s) { src = s; }
+    int get_src_port() { return src_port; }
+    void set_src_port(int sp) { src_port = sp; }
+    int get_dst() { return dst; }
+    void set_dst(int d) { dst = d; }
+    int get_dst_port() { return dst_port; }
+    void set_dst_port(int dp) { dst_port = dp; }
+    uint64_t get_addr() { return addr; }
+    bool is_read() { return read; }
+    void set_mem_response() {}
+};
+
+
+//! Issues one request per cycle while fewer than outstanding are in the controller.
+//! CaffDRAM returns a credit for every request, loads or stores, so credits tell
+//! when a request is done. SimpleMC is told to respond to stores for the same reason.
+class Sender : public Component {
+public:
+    enum { PORT_MC = 0 };
+
+    Sender(int stream_pct, int read_pct, uint64_t total, int outstanding, bool simple_mc) :
+        m_issued(0), m_completed(0), m_reads(0),
+        m_stream_pct(stream_pct), m_read_pct(read_pct), m_total(total), m_credits(outstanding),
+        m_simple_mc(simple_mc), m_rng(1), m_stream_addr(0)
+    {}
+
+    void tick()
+    {
+        if(m_completed == m_total) {
+	    Manifold::StopAt(Manifold::NowTicks());
+	    return;
+	}
+        if(m_credits == 0 || m_issued == m_total)
+	    return;
+
+	Mem_req req;
+	if((int)m_rng.next(100) < m_stream_pct) {
+	    m_stream_addr += LINE_SIZE;
+	    req.addr = m_stream_addr;
+	}
+	else
+	    req.addr = m_rng.next(1ULL << 26) * LINE_SIZE; //4GB
+	req.read = (int)m_rng.next(100) < m_read_pct;
+	m_issued++;
+	m_credits--;
+
+	if(m_simple_mc) {
+	    manifold::simple_cache::Mem_req* mreq = new manifold::simple_cache::Mem_req(SENDER_NID, req.addr,
+	                           req.read ? manifold::simple_cache::OpMemLd : manifold::simple_cache::OpMemSt);
+	    mreq->source_port = 0;
+	    mreq->dest_id = MC_NID;
+	    mreq->dest_port = 0;
+	    Send(PORT_MC, mreq);
+	    return;
+	}
+
+	req.src = SENDER_NID;
+	req.src_port = 0;
+	req.dst = MC_NID;
+	req.dst_port = 0;
+
+	NetworkPacket* pkt = new NetworkPacket;
+	pkt->type = MEM_TYPE;
+	pkt->src = SENDER_NID;
+	pkt->dst = MC_NID;
+	pkt->set_data(req);
+	Send(PORT_MC, pkt);
+    }
+
+    void handle_incoming(int, NetworkPacket* pkt)
+    {
+        if(pkt->type == CREDIT_TYPE) {
+	    m_credits++;
+	    m_completed++;
+	    delete pkt;
+	}
+	else {
+	    m_reads++;
+	    delete pkt;
+	    Send(PORT_MC, NetworkPacket::Create_credit(CREDIT_TYPE));
+	}
+    }
+
+    void handle_simple_mc(int, manifold::simple_cache::Mem_req* mreq)
+    {
+        if(mreq->op_type == manifold::simple_cache::OpMemLd)
+	    m_reads++;
+	m_credits++;
+	m_completed++;
+	delete mreq;
+    }
+
+    uint64_t m_issued;
+    uint64_t m_completed;
+    uint64_t m_reads;
+
+private:
+    const int m_stream_pct;
+    const int m_read_pct;
+    const uint64_t m_total;
+    int m_credits;
+    const bool m_simple_mc;
+    Rng m_rng;
+    uint64_t m_stream_addr;
+};
+
+
+
+static void Usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " [-H] <analytic|frfcfs|simple|simple-q> <stream_pct> <read_pct> <requests> <outstanding>" << endl;
+    exit(1);
+}
+
+
+int main(int argc, char** argv)
+{
+    argc = Parse_options(argc, argv);
+    if(argc != 6)
+        Usage(argv[0]);
+
+    string sched = argv[1];
+    Dsettings settings;
+    if(sched == "analytic")
+        settings.memSchedPolicy = ANALYTIC;
+    else if(sched == "frfcfs")
+        settings.memSchedPolicy = FR_FCFS;
+    else if(sched != "simple" && sched != "simple-q")
+        Usage(argv[0]);
+    const bool simple_mc = sched == "simple" || sched == "simple-q";
+    const int stream_pct = atoi(argv[2]);
+    const int read_pct = atoi(argv[3]);
+    const uint64_t requests = strtoull(argv[4], 0, 0);
+    const int outstanding = atoi(argv[5]);
+    if(requests < 1 || outstanding < 1)
+        Usage(argv[0]);
+
+    Manifold::Init(Manifold::TICKED);
+
+    CompId_t sender_id = Component::Create<Sender>(0, stream_pct, read_pct, requests, outstanding, simple_mc);
+    Sender* sender = Component::GetComponent<Sender>(sender_id);
+    Clock::Register(MasterClock, sender, &Sender::tick, (void(Sender::*)(void))0);
+
+    if(simple_mc) {
+        //SimpleMC timing from the CaffDRAM settings: a row hit is a column access and
+	//a burst, a row miss adds precharge and activate.
+        SimpleMC_settings mc_settings;
+	mc_settings.num_channels = settings.numChannels;
+	mc_settings.num_banks = settings.numRanks * settings.numBanks;
+	mc_settings.line_size = LINE_SIZE;
+	mc_settings.row_size = settings.numColumns * settings.channelBitWidth / 8;
+	mc_settings.t_row_hit = settings.t_CAS + settings.t_BURST;
+	mc_settings.t_row_miss = settings.t_RP + settings.t_RCD + settings.t_CAS + settings.t_BURST;
+	mc_settings.ticks_per_line = settings.t_BURST;
+	mc_settings.burst_lines = 2;
+
+	CompId_t mc_id;
+	if(sched == "simple")
+	    mc_id = Component::Create<SimpleMC>(0, MC_NID, settings.t_CMD + mc_settings.t_row_miss, true);
+	else
+	    mc_id = Component::Create<SimpleMC>(0, MC_NID, settings.t_CMD, mc_settings, true);
+
+	Manifold::Connect(sender_id, Sender::PORT_MC, mc_id, SimpleMC::IN,
+	                  &SimpleMC::handle_incoming, 1);
+	Manifold::Connect(mc_id, SimpleMC::OUT, sender_id, Sender::PORT_MC,
+	                  &Sender::handle_simple_mc, 1);
+    }
+    else {
+	Controller::Set_msg_types(MEM_TYPE, CREDIT_TYPE);
+	CompId_t mc_id = Component::Create<Controller>(0, &MasterClock, MC_NID, settings, outstanding, false);
+
+	Manifold::Connect(sender_id, Sender::PORT_MC, mc_id, Controller::PORT0,
+	                  &Controller::handle_request<Mem_req>, 1);
+	Manifold::Connect(mc_id, Controller::PORT0, sender_id, Sender::PORT_MC,
+	                  &Sender::handle_incoming, 1);
+    }
+
+    double start = Now();
+    Manifold::Run();
+    double secs = Now() - start;
+
+    if(sender->m_completed != requests) {
+        cerr << "Only " << sender->m_completed << " of " << requests << " requests completed." << endl;
+	exit(1);
+    }
+
+    ostringstream params, extra;
+    params << "sched=" << sched << ";stream_pct=" << stream_pct << ";read_pct=" << read_pct
+           << ";requests=" << requests << ";outstanding=" << outstanding;
+    extra << "reads=" << sender->m_reads
+          << ";sim_cycles_per_req=" << (double)MasterClock.NowTicks() / requests;
+    Report("dram", "controller", params.str(), sender->m_completed, "requests", MasterClock.NowTicks(), secs,
+           extra.str());
+
+    Manifold::Finalize();
+    return 0;
+}
@@ -0,0 +1,226 @@
+//! Iris benchmark: uniform random traffic on a torus or a ring.
+//!
+//! Usage:
+//!   iris-bench [-H] torus <x_dim> <y_dim> <injection_rate> <cycles>
+//!   iris-bench [-H] ring <nodes> <injection_rate> <cycles>
+//! injection_rate is in packets per node per cycle; each packet is 56 bytes plus the
+//! head flit overhead, i.e., 5 flits on 128-bit links. ops are flits delivered to the terminals.
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <list>
+#include <vector>
+
+#include "mcp-cache/coh_mem_req.h"
+#include "iris/genericTopology/genericTopoCreator.h"
+#include "iris/interfaces/genericIrisInterface.h"
+#include "uarch/networkPacket.h"
+#include "kernel/manifold.h"
+#include "kernel/component.h"
+#include "bench.h"
+
+using namespace std;
+using namespace manifold::kernel;
+using namespace manifold::iris;
+using namespace manifold::uarch;
+using namespace manifold::bench;
+using manifold::mcp_cache_namespace::Mem_msg;
+
+static Clock MasterClock(1000000000);
+
+static const int NI_CREDIT_TYPE = 123;
+static const int PKT_TYPE = 456; //the network interface treats this type as memory traffic
+static const int PKT_BYTES = 56;
+static const unsigned LINK_WIDTH = 128;
+static const int NI_INPUT_PKTS = 4; //packets a terminal may have in its interface's input buffer
+
+
+class Bench_simlen : public SimulatedLen<NetworkPacket> {
+public:
+    int get_simulated_len(NetworkPacket*) { return PKT_BYTES; }
+};
+
+class Bench_vnet : public VnetAssign<NetworkPacket> {
+public:
+    int get_virtual_net(NetworkPacket*) { return 0; }
+};
+
+
+//! Flits of a packet, as computed by GenNetworkInterface.
+static unsigned Flits_per_pkt()
+{
+    unsigned bits = (HeadFlit::HEAD_FLIT_OVERHEAD + PKT_BYTES) * 8;
+    unsigned flits = (bits + LINK_WIDTH - 1) / LINK_WIDTH;
+    return flits > 1 ? flits + 1 : flits; //plus a tail flit
+}
+
+
+//! Generates packets to random destinations with the given probability per cycle.
+//! Packets wait in an unbounded source queue until the network interface has room,
+//! so latency includes the source queueing delay as in an open-loop measurement.
+class Terminal : public Component {
+public:
+    enum { PORT_NI = 0 };
+
+    Terminal(unsigned id, unsigned nodes, double rate) :
+        m_sent(0), m_received(0), m_latency(0),
+        m_id(id), m_nodes(nodes), m_rate(rate), m_rng(id + 1), m_credits(NI_INPUT_PKTS)
+    {}
+
+    void tick()
+    {
+        if(m_rng.chance(m_rate)) {
+	    Mem_msg msg;
+	    msg.type = Mem_msg::MEM_REQ;
+	    msg.addr = Manifold::NowTicks(); //not used by the network; carries the generation time
+	    msg.op_type = manifold::mcp_cache_namespace::OpMemLd;
+	    msg.src_id = m_id;
+	    msg.src_port = 0;
+	    do {
+	        msg.dst_id = m_rng.next(m_nodes);
+	    } while(msg.dst_id == (int)m_id);
+	    msg.dst_port = 0;
+
+	    NetworkPacket* pkt = new NetworkPacket;
+	    pkt->type = PKT_TYPE;
+	    pkt->src = m_id;
+	    pkt->dst = msg.dst_id;
+	    pkt->set_data(msg);
+	    m_src_queue.push_back(pkt);
+	    m_sent++;
+	}
+
+	if(m_credits > 0 && !m_src_queue.empty()) {
+	    Send(PORT_NI, m_src_queue.front());
+	    m_src_queue.pop_front();
+	    m_credits--;
+	}
+    }
+
+    void handle_incoming(int, NetworkPacket* pkt)
+    {
+        if(pkt->type == PKT_TYPE) {
+	    m_received++;
+	    m_latency += Manifold::NowTicks() - ((Mem_msg*)pkt->data)->addr;
+	    delete pkt;
+	    Send(PORT_NI, NetworkPacket::Create_credit(NI_CREDIT_TYPE));
+	}
+	else {
+	    assert(pkt->type == NI_CREDIT_TYPE);
+	    m_credits++;
+	    delete pkt;
+	}
+    }
+
+    uint64_t m_sent;
+    uint64_t m_received;
+    uint64_t m_latency;
+
+private:
+    const unsigned m_id;
+    const unsigned m_nodes;
+    const double m_rate;
+    Rng m_rng;
+    int m_credits; //credits for the network interface's input buffer
+    list<NetworkPacket*> m_src_queue;
+};
+
+
+static void Run_traffic(const char* topo, const string& params, const vector<CompId_t>& inf_ids,
+                        double rate, Ticks_t cycles)
+{
+    unsigned nodes = inf_ids.size();
+    vector<Terminal*> terms(nodes);
+    for(unsigned i=0; i<nodes; i++) {
+        CompId_t tid = Component::Create<Terminal>(0, i, nodes, rate);
+	terms[i] = Component::GetComponent<Terminal>(tid);
+	Clock::Register(MasterClock, terms[i], &Terminal::tick, (void(Terminal::*)(void))0);
+	Manifold::Connect(tid, Terminal::PORT_NI, inf_ids[i], GenNetworkInterface<NetworkPacket>::TERMINAL_PORT,
+	                  &GenNetworkInterface<NetworkPacket>::handle_new_packet_event, 1);
+	Manifold::Connect(inf_ids[i], GenNetworkInterface<NetworkPacket>::TERMINAL_PORT, tid, Terminal::PORT_NI,
+	                  &Terminal::handle_incoming, 1);
+    }
+
+    Manifold::StopAt(cycles);
+    double start = Now();
+    Manifold::Run();
+    double secs = Now() - start;
+
+    uint64_t sent = 0, received = 0, latency = 0;
+    for(unsigned i=0; i<nodes; i++) {
+        sent += terms[i]->m_sent;
+	received += terms[i]->m_received;
+	latency += terms[i]->m_latency;
+    }
+
+    ostringstream extra;
+    extra << "sent=" << sent << ";received=" << received
+          << ";accepted_rate=" << (double)received / nodes / cycles
+          << ";avg_latency=" << (received ? (double)latency / received : 0);
+    Report("iris", topo, params, received * Flits_per_pkt(), "flits", cycles, secs, extra.str());
+}
+
+
+static void Usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " [-H] torus <x_dim> <y_dim> <injection_rate> <cycles>" << endl
+         << "       " << prog << " [-H] ring <nodes> <injection_rate> <cycles>" << endl;
+    exit(1);
+}
+
+
+int main(int argc, char** argv)
+{
+    argc = Parse_options(argc, argv);
+    if(argc < 2)
+        Usage(argv[0]);
+
+    string topo = argv[1];
+    Manifold::Init(Manifold::TICKED);
+
+    Simple_terminal_to_net_mapping* mapping = new Simple_terminal_to_net_mapping();
+    Bench_simlen* simlen = new Bench_simlen();
+    Bench_vnet* vnet = new Bench_vnet();
+    ostringstream params;
+
+    if(topo == "torus" && argc == 6) {
+        torus_init_params tp;
+	tp.x_dim = atoi(argv[2]);
+	tp.y_dim = atoi(argv[3]);
+	tp.no_vcs = 4;
+	tp.credits = 5;
+	tp.link_width = LINK_WIDTH;
+	tp.ni_up_credits = 10;
+	tp.ni_upstream_buffer_size = 5;
+	double rate = atof(argv[4]);
+	Ticks_t cycles = strtoull(argv[5], 0, 0);
+
+	vector<int> node_lp(tp.x_dim * tp.y_dim, 0);
+	Torus<NetworkPacket>* torus = topoCreator<NetworkPacket>::create_torus(MasterClock, &tp, mapping, simlen, vnet,
+	                                                               NI_CREDIT_TYPE, &node_lp);
+	params << "x=" << tp.x_dim << ";y=" << tp.y_dim << ";rate=" << rate << ";cycles=" << cycles;
+	Run_traffic("torus", params.str(), torus->get_interface_id(), rate, cycles);
+    }
+    else if(topo == "ring" && argc == 5) {
+        ring_init_params rp;
+	rp.no_nodes = atoi(argv[2]);
+	rp.no_vcs = 4;
+	rp.credits = 5;
+	rp.rc_method = RING_ROUTING;
+	rp.link_width = LINK_WIDTH;
+	rp.ni_up_credits = 10;
+	rp.ni_upstream_buffer_size = 5;
+	double rate = atof(argv[3]);
+	Ticks_t cycles = strtoull(argv[4], 0, 0);
+
+	Ring<NetworkPacket>* ring = topoCreator<NetworkPacket>::create_ring(MasterClock, &rp, mapping, simlen, vnet,
+	                                                            NI_CREDIT_TYPE, 0, 0);
+	params << "nodes=" << rp.no_nodes << ";rate=" << rate << ";cycles=" << cycles;
+	Run_traffic("ring", params.str(), ring->get_interface_id(), rate, cycles);
+    }
+    else
+        Usage(argv[0]);
+
+    Manifold::Finalize();
+    return 0;
+}
@@ -0,0 +1,264 @@
+//! Kernel benchmarks.
+//!
+//! Usage:
+//!   kernel-bench [-H] clock <tickers> <ticks>
+//!       tickers components registered with one clock; ops are tick handler calls.
+//!   kernel-bench [-H] timed <in_flight> <events>
+//!       in_flight components each keeping one timed event pending, with pseudo-random
+//!       delays; ops are events.
+//!   kernel-bench [-H] link <pairs> <ticks> <ptr|value|serial>
+//!       pairs of components; every tick each sender sends a 64-byte payload over a
+//!       link with latency 1, by pointer, by value, or by pointer after a round trip
+//!       through Serialize()/Deserialize() as on a link between LPs. ops are messages.
+#include <stdlib.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "kernel/manifold.h"
+#include "kernel/component.h"
+#include "kernel/serialize.h"
+#include "bench.h"
+
+using namespace std;
+using namespace manifold::kernel;
+using namespace manifold::bench;
+
+static Clock MasterClock(1000000000);
+
+
+//####################################################################
+// clock
+//####################################################################
+
+class Ticker : public Component {
+public:
+    Ticker() : m_count(0) {}
+    void rising() { m_count++; }
+    uint64_t m_count;
+};
+
+
+static void Bench_clock(unsigned n_tickers, Ticks_t ticks)
+{
+    Manifold::Init(Manifold::TICKED);
+
+    vector<Ticker*> tickers(n_tickers);
+    for(unsigned i=0; i<n_tickers; i++) {
+        CompId_t id = Component::Create<Ticker>(0);
+	tickers[i] = Component::GetComponent<Ticker>(id);
+	Clock::Register(MasterClock, tickers[i], &Ticker::rising, (void(Ticker::*)(void))0);
+    }
+
+    Manifold::StopAt(ticks);
+    double start = Now();
+    Manifold::Run();
+    double secs = Now() - start;
+
+    uint64_t calls = 0;
+    for(unsigned i=0; i<n_tickers; i++)
+        calls += tickers[i]->m_count;
+
+    ostringstream params;
+    params << "tickers=" << n_tickers << ";ticks=" << ticks;
+    Report("kernel", "clock", params.str(), calls, "tick_calls", MasterClock.NowTicks(), secs);
+}
+
+
+//####################################################################
+// timed events
+//####################################################################
+
+class Event_source : public Component {
+public:
+    Event_source(unsigned id) : m_rng(id) {}
+
+    void fire()
+    {
+        Fired++;
+	if(Scheduled < Total) {
+	    Scheduled++;
+	    Manifold::ScheduleTime(1e-9 * (1 + m_rng.next(1000)), &Event_source::fire, this);
+	}
+    }
+
+    static uint64_t Fired;
+    static uint64_t Scheduled;
+    static uint64_t Total;
+
+private:
+    Rng m_rng;
+};
+
+uint64_t Event_source::Fired = 0;
+uint64_t Event_source::Scheduled = 0;
+uint64_t Event_source::Total = 0;
+
+
+static void Bench_timed(unsigned in_flight, uint64_t events)
+{
+    Manifold::Init(Manifold::TIMED);
+
+    Event_source::Total = events;
+    Event_source::Scheduled = in_flight;
+    Rng rng(1);
+    for(unsigned i=0; i<in_flight; i++) {
+        CompId_t id = Component::Create<Event_source>(0, i);
+	Event_source* src = Component::GetComponent<Event_source>(id);
+	Manifold::ScheduleTime(1e-9 * (1 + rng.next(1000)), &Event_source::fire, src);
+    }
+
+    double start = Now();
+    Manifold::Run();
+    double secs = Now() - start;
+
+    ostringstream params;
+    params << "in_flight=" << in_flight << ";events=" << events;
+    Report("kernel", "timed", params.str(), Event_source::Fired, "events", 0, secs);
+}
+
+
+//####################################################################
+// link
+//####################################################################
+
+struct Payload {
+    uint64_t w[8];
+};
+
+enum Link_mode_t { LINK_PTR, LINK_VALUE, LINK_SERIAL };
+
+
+class Receiver : public Component {
+public:
+    enum { IN = 0 };
+    Receiver() : m_count(0), m_sum(0) {}
+
+    void handle_ptr(int, Payload* p)
+    {
+        m_count++;
+	m_sum += p->w[0];
+	delete p;
+    }
+
+    void handle_value(int, Payload p)
+    {
+        m_count++;
+	m_sum += p.w[0];
+    }
+
+    uint64_t m_count;
+    uint64_t m_sum;
+};
+
+
+class Sender : public Component {
+public:
+    enum { OUT = 0 };
+    Sender(int mode) : m_mode((Link_mode_t)mode), m_seq(0) {}
+
+    void rising()
+    {
+        Payload p;
+	for(int i=0; i<8; i++)
+	    p.w[i] = m_seq + i;
+	m_seq++;
+
+	switch(m_mode) {
+	    case LINK_PTR:
+	        Send(OUT, new Payload(p));
+		break;
+	    case LINK_VALUE:
+	        Send(OUT, p);
+		break;
+	    case LINK_SERIAL: {
+		//what a link between LPs does: serialize into the send buffer and
+		//re-create the object on the other side
+		m_buf.resize(Get_serialize_size(p));
+		Serialize(p, &m_buf[0]);
+	        Send(OUT, Deserialize<Payload>(&m_buf[0]));
+		break;
+	    }
+	}
+    }
+
+private:
+    const Link_mode_t m_mode;
+    uint64_t m_seq;
+    vector<unsigned char> m_buf;
+};
+
+
+static void Bench_link(unsigned pairs, Ticks_t ticks, Link_mode_t mode)
+{
+    Manifold::Init(Manifold::TICKED);
+
+    vector<Receiver*> receivers(pairs);
+    for(unsigned i=0; i<pairs; i++) {
+        CompId_t sid = Component::Create<Sender>(0, (int)mode);
+        CompId_t rid = Component::Create<Receiver>(0);
+	Sender* s = Component::GetComponent<Sender>(sid);
+	receivers[i] = Component::GetComponent<Receiver>(rid);
+	Clock::Register(MasterClock, s, &Sender::rising, (void(Sender::*)(void))0);
+	if(mode == LINK_VALUE)
+	    Manifold::Connect(sid, Sender::OUT, rid, Receiver::IN, &Receiver::handle_value, 1);
+	else
+	    Manifold::Connect(sid, Sender::OUT, rid, Receiver::IN, &Receiver::handle_ptr, 1);
+    }
+
+    Manifold::StopAt(ticks);
+    double start = Now();
+    Manifold::Run();
+    double secs = Now() - start;
+
+    uint64_t msgs = 0;
+    for(unsigned i=0; i<pairs; i++)
+        msgs += receivers[i]->m_count;
+
+    static const char* const Names[] = { "ptr", "value", "serial" };
+    ostringstream params;
+    params << "pairs=" << pairs << ";ticks=" << ticks << ";mode=" << Names[mode];
+    Report("kernel", "link", params.str(), msgs, "messages", MasterClock.NowTicks(), secs);
+}
+
+
+
+static void Usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " [-H] clock <tickers> <ticks>" << endl
+         << "       " << prog << " [-H] timed <in_flight> <events>" << endl
+         << "       " << prog << " [-H] link <pairs> <ticks> <ptr|value|serial>" << endl;
+    exit(1);
+}
+
+
+int main(int argc, char** argv)
+{
+    argc = Parse_options(argc, argv);
+    if(argc < 4)
+        Usage(argv[0]);
+
+    string bench = argv[1];
+    if(bench == "clock" && argc == 4)
+        Bench_clock(atoi(argv[2]), strtoull(argv[3], 0, 0));
+    else if(bench == "timed" && argc == 4)
+        Bench_timed(atoi(argv[2]), strtoull(argv[3], 0, 0));
+    else if(bench == "link" && argc == 5) {
+        string m = argv[4];
+	Link_mode_t mode = LINK_PTR;
+	if(m == "ptr")
+	    mode = LINK_PTR;
+	else if(m == "value")
+	    mode = LINK_VALUE;
+	else if(m == "serial")
+	    mode = LINK_SERIAL;
+	else
+	    Usage(argv[0]);
+        Bench_link(atoi(argv[2]), strtoull(argv[3], 0, 0), mode);
+    }
+    else
+        Usage(argv[0]);
+
+    Manifold::Finalize();
+    return 0;
+}
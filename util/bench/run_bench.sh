@@ -0,0 +1,30 @@
+#!/bin/sh
+# Runs the standard benchmark set and writes the results as CSV to stdout.
+# The set is fixed so that results are comparable between versions and hosts;
+# add new entries at the end.
+
+./kernel-bench -H clock 1000 10000
+./kernel-bench timed 1000 5000000
+./kernel-bench link 1000 5000 ptr
+./kernel-bench link 1000 5000 value
+./kernel-bench link 1000 5000 serial
+
+for rate in 0.005 0.01 0.02 0.05 0.1; do
+    ./iris-bench torus 4 4 $rate 20000
+done
+for rate in 0.005 0.01 0.02 0.05 0.1; do
+    ./iris-bench ring 16 $rate 20000
+done
+
+./cache-bench seq 4 50000
+./cache-bench random 4 50000
+./cache-bench mix 4 50000
+./cache-bench mix 16 10000
+
+./dram-bench analytic 0 70 200000 16
+./dram-bench analytic 90 70 200000 16
+./dram-bench frfcfs 0 70 200000 16
+./dram-bench frfcfs 90 70 200000 16
+./dram-bench simple 0 70 200000 16
+./dram-bench simple-q 0 70 200000 16
+./dram-bench simple-q 90 70 200000 16
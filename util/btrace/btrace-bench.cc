@@ -0,0 +1,81 @@
+//! Measures the read throughput of a binary trace and, if given, of the same trace
+//! in text format.
+//!
+//! Usage: btrace-bench <binary_trace> [<text_trace>]
+#include "btrace.h"
+
+#include <stdlib.h>
+#include <sys/time.h>
+#include <iostream>
+
+using namespace std;
+using namespace manifold::btrace;
+
+static double now()
+{
+    timeval t;
+    gettimeofday(&t, 0);
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+static void report(const char* what, uint64_t insts, uint64_t memops, uint64_t checksum, double secs)
+{
+    cout << what << ": " << insts << " instructions, " << memops << " memory operands in "
+         << secs << " s; " << insts / secs / 1e6 << " M instructions/s (checksum "
+	 << hex << checksum << dec << ")" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    if(argc != 2 && argc != 3) {
+        cerr << "Usage: " << argv[0] << " <binary_trace> [<text_trace>]" << endl;
+	exit(1);
+    }
+
+    btrace_inst_t inst;
+
+    {
+	double start = now();
+	Btrace_reader reader(argv[1]);
+	uint64_t insts = 0, memops = 0, checksum = 0;
+	while(reader.next(inst)) {
+	    insts++;
+	    memops += inst.n_memops;
+	    checksum += inst.pc;
+	    for(int i=0; i<inst.n_memops; i++)
+		checksum ^= inst.memops[i].addr;
+	}
+	report("binary", insts, memops, checksum, now() - start);
+
+	//random seeks
+	start = now();
+	const int N_SEEKS = 1000;
+	for(int i=0; i<N_SEEKS && reader.get_num_insts() > 0; i++) {
+	    reader.seek(random() % reader.get_num_insts());
+	    reader.next(inst);
+	}
+	cout << "binary: " << (now() - start) / N_SEEKS * 1e6 << " us/seek" << endl;
+    }
+
+    if(argc == 3) {
+	FILE* in = fopen(argv[2], "r");
+	if(in == 0) {
+	    cerr << "Cannot open " << argv[2] << endl;
+	    exit(1);
+	}
+	double start = now();
+	Text_trace_reader reader(in);
+	uint64_t insts = 0, memops = 0, checksum = 0;
+	while(reader.next(inst)) {
+	    insts++;
+	    memops += inst.n_memops;
+	    checksum += inst.pc;
+	    for(int i=0; i<inst.n_memops; i++)
+		checksum ^= inst.memops[i].addr;
+	}
+	report("text", insts, memops, checksum, now() - start);
+	fclose(in);
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+//! Converts a text trace written by itrace or traceGen to a binary trace, or,
+//! with -d, a binary trace back to text.
+//!
+//! Usage: btrace-convert [-b <block_insts>] <text_trace> <binary_trace>
+//!        btrace-convert -d <binary_trace> <text_trace>
+#include "btrace.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+using namespace std;
+using namespace manifold::btrace;
+
+static void usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " [-b <block_insts>] <text_trace> <binary_trace>" << endl;
+    cerr << "       " << prog << " -d <binary_trace> <text_trace>" << endl;
+    exit(1);
+}
+
+int main(int argc, char** argv)
+{
+    bool decode = false;
+    unsigned block_insts = BTRACE_DEFAULT_BLOCK_INSTS;
+
+    int arg = 1;
+    for(; arg < argc && argv[arg][0] == '-'; arg++) {
+        if(strcmp(argv[arg], "-d") == 0)
+	    decode = true;
+	else if(strcmp(argv[arg], "-b") == 0 && arg+1 < argc)
+	    block_insts = atoi(argv[++arg]);
+	else
+	    usage(argv[0]);
+    }
+    if(argc - arg != 2 || block_insts == 0)
+        usage(argv[0]);
+
+    btrace_inst_t inst;
+
+    if(decode) {
+	FILE* out = fopen(argv[arg+1], "w");
+	if(out == 0) {
+	    cerr << "Cannot open " << argv[arg+1] << endl;
+	    exit(1);
+	}
+	Btrace_reader reader(argv[arg]);
+	while(reader.next(inst))
+	    Write_text_inst(out, inst);
+	fclose(out);
+	cout << reader.get_num_insts() << " instructions" << endl;
+    }
+    else {
+	FILE* in = fopen(argv[arg], "r");
+	if(in == 0) {
+	    cerr << "Cannot open " << argv[arg] << endl;
+	    exit(1);
+	}
+	Text_trace_reader reader(in);
+	Btrace_writer writer(argv[arg+1], block_insts);
+	while(reader.next(inst))
+	    writer.add(inst);
+	writer.close();
+
+	long text_size = ftell(in);
+	fclose(in);
+
+	FILE* out = fopen(argv[arg+1], "r");
+	fseek(out, 0, SEEK_END);
+	long bin_size = ftell(out);
+	fclose(out);
+
+	cout << writer.get_num_insts() << " instructions; text " << text_size << " bytes, encoded "
+	     << writer.get_raw_bytes() << " bytes, compressed " << bin_size << " bytes ("
+	     << (double)bin_size / (writer.get_num_insts() ? writer.get_num_insts() : 1) << " bytes/instruction)" << endl;
+    }
+
+    return 0;
+}
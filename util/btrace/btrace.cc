@@ -0,0 +1,453 @@
+#include "btrace.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include <iostream>
+
+using namespace std;
+
+namespace manifold {
+namespace btrace {
+
+
+//====================================================================
+//====================================================================
+static inline uint64_t zigzag(uint64_t delta) { return (delta << 1) ^ (uint64_t)((int64_t)delta >> 63); }
+static inline uint64_t unzigzag(uint64_t v) { return (v >> 1) ^ (0 - (v & 0x1)); }
+
+static inline void put_varint(vector<uint8_t>& buf, uint64_t v)
+{
+    while(v >= 0x80) {
+        buf.push_back((uint8_t)(v | 0x80));
+	v >>= 7;
+    }
+    buf.push_back((uint8_t)v);
+}
+
+static inline uint64_t get_varint(const vector<uint8_t>& buf, size_t& pos)
+{
+    uint64_t v = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        assert(pos < buf.size());
+        byte = buf[pos++];
+	v |= (uint64_t)(byte & 0x7f) << shift;
+	shift += 7;
+    } while(byte & 0x80);
+    return v;
+}
+
+static inline unsigned code_table_idx(uint64_t pc)
+{
+    return (unsigned)(pc ^ (pc >> 12)) & (Btrace_state::CODE_TABLE_SIZE - 1);
+}
+
+template<typename T>
+static void write_value(FILE* f, const T& v)
+{
+    if(fwrite(&v, sizeof(T), 1, f) != 1) {
+        cerr << "btrace: write error." << endl;
+	exit(1);
+    }
+}
+
+template<typename T>
+static void read_value(FILE* f, T& v)
+{
+    if(fread(&v, sizeof(T), 1, f) != 1) {
+        cerr << "btrace: unexpected end of file." << endl;
+	exit(1);
+    }
+}
+
+
+// Instruction header byte:
+//   bits 0-3: instruction length
+//   bit 4: pc is the fall-through address of the previous instruction
+//   bit 5: instruction bytes are in the code table
+//   bits 6-7: number of memory operands; 3 means the number follows in the next byte.
+// Memory operand:
+//   byte: bit 7 = store, bits 0-6 = size; followed by zigzag varint address delta.
+enum {
+    HDR_LEN_MASK = 0xf,
+    HDR_SEQ = 0x10,
+    HDR_CACHED = 0x20,
+    HDR_MEMOPS_SHIFT = 6,
+};
+
+
+void Btrace_state :: reset()
+{
+    next_pc = 0;
+    last_addr[0] = last_addr[1] = 0;
+    for(int i=0; i<CODE_TABLE_SIZE; i++) {
+        code_table[i].pc = ~(uint64_t)0;
+        code_table[i].len = 0;
+    }
+}
+
+
+
+//====================================================================
+//====================================================================
+Btrace_writer :: Btrace_writer(const char* fname, unsigned block_insts) :
+    m_block_insts(block_insts), m_block_count(0), m_num_insts(0), m_raw_bytes(0)
+{
+    assert(block_insts > 0);
+    m_file = fopen(fname, "wb");
+    if(m_file == 0) {
+        cerr << "btrace: cannot open " << fname << " for writing." << endl;
+	exit(1);
+    }
+    write_value(m_file, BTRACE_MAGIC);
+    write_value(m_file, BTRACE_VERSION);
+    write_value(m_file, (uint32_t)m_block_insts);
+    write_value(m_file, (uint32_t)0); //reserved
+}
+
+
+Btrace_writer :: ~Btrace_writer()
+{
+    close();
+}
+
+
+void Btrace_writer :: add(const btrace_inst_t& inst)
+{
+    assert(inst.len <= BTRACE_MAX_INST_LEN);
+    assert(inst.n_memops <= BTRACE_MAX_MEMOPS);
+
+    const bool seq = (inst.pc == m_state.next_pc);
+    unsigned idx = code_table_idx(inst.pc);
+    const bool cached = (m_state.code_table[idx].pc == inst.pc && m_state.code_table[idx].len == inst.len &&
+                         memcmp(m_state.code_table[idx].code, inst.code, inst.len) == 0);
+
+    uint8_t hdr = inst.len | (seq ? HDR_SEQ : 0) | (cached ? HDR_CACHED : 0) |
+                  ((inst.n_memops < 3 ? inst.n_memops : 3) << HDR_MEMOPS_SHIFT);
+    m_raw.push_back(hdr);
+    if(inst.n_memops >= 3)
+        m_raw.push_back(inst.n_memops);
+    if(!seq)
+	put_varint(m_raw, zigzag(inst.pc - m_state.next_pc));
+    if(!cached) {
+        m_raw.insert(m_raw.end(), inst.code, inst.code + inst.len);
+	m_state.code_table[idx].pc = inst.pc;
+	m_state.code_table[idx].len = inst.len;
+	memcpy(m_state.code_table[idx].code, inst.code, inst.len);
+    }
+    m_state.next_pc = inst.pc + inst.len;
+
+    for(int i=0; i<inst.n_memops; i++) {
+        const btrace_mem_t& m = inst.memops[i];
+	assert(m.size < 0x80);
+        m_raw.push_back((m.is_write ? 0x80 : 0) | m.size);
+	put_varint(m_raw, zigzag(m.addr - m_state.last_addr[m.is_write]));
+	m_state.last_addr[m.is_write] = m.addr;
+    }
+
+    m_num_insts++;
+    if(++m_block_count == m_block_insts)
+        flush_block();
+}
+
+
+//! Block layout: number of instructions, raw size, compressed size (all uint32_t),
+//! followed by the compressed data.
+void Btrace_writer :: flush_block()
+{
+    if(m_block_count == 0)
+        return;
+
+    uLongf comp_size = compressBound(m_raw.size());
+    m_compressed.resize(comp_size);
+    if(compress2(&m_compressed[0], &comp_size, &m_raw[0], m_raw.size(), Z_BEST_SPEED) != Z_OK) {
+        cerr << "btrace: compression failed." << endl;
+	exit(1);
+    }
+
+    m_index_inst.push_back(m_num_insts - m_block_count);
+    m_index_offset.push_back(ftell(m_file));
+
+    write_value(m_file, (uint32_t)m_block_count);
+    write_value(m_file, (uint32_t)m_raw.size());
+    write_value(m_file, (uint32_t)comp_size);
+    if(fwrite(&m_compressed[0], 1, comp_size, m_file) != comp_size) {
+        cerr << "btrace: write error." << endl;
+	exit(1);
+    }
+
+    m_raw_bytes += m_raw.size();
+    m_raw.clear();
+    m_block_count = 0;
+    m_state.reset();
+}
+
+
+//! The index is written after the last block, followed by a footer: index offset,
+//! number of blocks, number of instructions (uint64_t) and the magic number.
+void Btrace_writer :: close()
+{
+    if(m_file == 0)
+        return;
+
+    flush_block();
+
+    uint64_t index_offset = ftell(m_file);
+    for(size_t i=0; i<m_index_inst.size(); i++) {
+        write_value(m_file, m_index_inst[i]);
+        write_value(m_file, m_index_offset[i]);
+    }
+    write_value(m_file, index_offset);
+    write_value(m_file, (uint64_t)m_index_inst.size());
+    write_value(m_file, m_num_insts);
+    write_value(m_file, BTRACE_MAGIC);
+
+    fclose(m_file);
+    m_file = 0;
+}
+
+
+
+//====================================================================
+//====================================================================
+Btrace_reader :: Btrace_reader(const char* fname) : m_block(0), m_pos(0), m_next_inst(0)
+{
+    m_file = fopen(fname, "rb");
+    if(m_file == 0) {
+        cerr << "btrace: cannot open " << fname << " for reading." << endl;
+	exit(1);
+    }
+
+    uint32_t magic, version, block_insts, reserved;
+    read_value(m_file, magic);
+    read_value(m_file, version);
+    read_value(m_file, block_insts);
+    read_value(m_file, reserved);
+    if(magic != BTRACE_MAGIC) {
+        cerr << "btrace: " << fname << " is not a binary trace." << endl;
+	exit(1);
+    }
+    if(version != BTRACE_VERSION) {
+        cerr << "btrace: " << fname << " has version " << version << "; version " << BTRACE_VERSION << " expected." << endl;
+	exit(1);
+    }
+
+    //footer
+    const long FOOTER_SIZE = 3*sizeof(uint64_t) + sizeof(uint32_t);
+    uint64_t index_offset, n_blocks;
+    fseek(m_file, -FOOTER_SIZE, SEEK_END);
+    read_value(m_file, index_offset);
+    read_value(m_file, n_blocks);
+    read_value(m_file, m_num_insts);
+    read_value(m_file, magic);
+    if(magic != BTRACE_MAGIC) {
+        cerr << "btrace: " << fname << " is incomplete; the writer was not closed." << endl;
+	exit(1);
+    }
+
+    fseek(m_file, index_offset, SEEK_SET);
+    m_index_inst.resize(n_blocks);
+    m_index_offset.resize(n_blocks);
+    for(uint64_t i=0; i<n_blocks; i++) {
+        read_value(m_file, m_index_inst[i]);
+        read_value(m_file, m_index_offset[i]);
+    }
+
+    if(n_blocks > 0)
+	load_block(0);
+}
+
+
+Btrace_reader :: ~Btrace_reader()
+{
+    fclose(m_file);
+}
+
+
+bool Btrace_reader :: load_block(unsigned b)
+{
+    if(b >= m_index_offset.size())
+        return false;
+
+    fseek(m_file, m_index_offset[b], SEEK_SET);
+    uint32_t n_insts, raw_size, comp_size;
+    read_value(m_file, n_insts);
+    read_value(m_file, raw_size);
+    read_value(m_file, comp_size);
+
+    m_compressed.resize(comp_size);
+    if(fread(&m_compressed[0], 1, comp_size, m_file) != comp_size) {
+        cerr << "btrace: unexpected end of file." << endl;
+	exit(1);
+    }
+    m_raw.resize(raw_size);
+    uLongf size = raw_size;
+    if(uncompress(&m_raw[0], &size, &m_compressed[0], comp_size) != Z_OK || size != raw_size) {
+        cerr << "btrace: corrupted block " << b << "." << endl;
+	exit(1);
+    }
+
+    m_block = b;
+    m_pos = 0;
+    m_next_inst = m_index_inst[b];
+    m_state.reset();
+    return true;
+}
+
+
+bool Btrace_reader :: next(btrace_inst_t& inst)
+{
+    if(m_next_inst >= m_num_insts)
+        return false;
+    if(m_pos == m_raw.size()) {
+        if(!load_block(m_block + 1))
+	    return false;
+    }
+
+    uint8_t hdr = m_raw[m_pos++];
+    inst.len = hdr & HDR_LEN_MASK;
+    inst.n_memops = hdr >> HDR_MEMOPS_SHIFT;
+    if(inst.n_memops == 3)
+        inst.n_memops = m_raw[m_pos++];
+    assert(inst.n_memops <= BTRACE_MAX_MEMOPS);
+
+    inst.pc = m_state.next_pc;
+    if(!(hdr & HDR_SEQ))
+        inst.pc += unzigzag(get_varint(m_raw, m_pos));
+
+    unsigned idx = code_table_idx(inst.pc);
+    if(hdr & HDR_CACHED) {
+        memcpy(inst.code, m_state.code_table[idx].code, inst.len);
+    }
+    else {
+        assert(m_pos + inst.len <= m_raw.size());
+        memcpy(inst.code, &m_raw[m_pos], inst.len);
+	m_pos += inst.len;
+	m_state.code_table[idx].pc = inst.pc;
+	m_state.code_table[idx].len = inst.len;
+	memcpy(m_state.code_table[idx].code, inst.code, inst.len);
+    }
+    m_state.next_pc = inst.pc + inst.len;
+
+    for(int i=0; i<inst.n_memops; i++) {
+        btrace_mem_t& m = inst.memops[i];
+	uint8_t b = m_raw[m_pos++];
+	m.is_write = b & 0x80;
+	m.size = b & 0x7f;
+	m.addr = m_state.last_addr[m.is_write] + unzigzag(get_varint(m_raw, m_pos));
+	m_state.last_addr[m.is_write] = m.addr;
+    }
+
+    m_next_inst++;
+    return true;
+}
+
+
+bool Btrace_reader :: seek(uint64_t n)
+{
+    if(n >= m_num_insts)
+        return false;
+
+    //find the last block whose first instruction is <= n
+    unsigned lo = 0, hi = m_index_inst.size() - 1;
+    while(lo < hi) {
+        unsigned mid = (lo + hi + 1) / 2;
+	if(m_index_inst[mid] <= n)
+	    lo = mid;
+	else
+	    hi = mid - 1;
+    }
+
+    if(lo != m_block || n < m_next_inst)
+        load_block(lo);
+
+    btrace_inst_t inst;
+    while(m_next_inst < n)
+        next(inst);
+    return true;
+}
+
+
+
+//====================================================================
+//====================================================================
+bool Text_trace_reader :: get_line()
+{
+    if(m_have_line)
+        return true;
+    while(fgets(m_line, sizeof(m_line), m_in)) {
+        m_line_no++;
+	if(m_line[0] != '\n' && m_line[0] != 0) {
+	    m_have_line = true;
+	    return true;
+	}
+    }
+    return false;
+}
+
+
+bool Text_trace_reader :: next(btrace_inst_t& inst)
+{
+    while(get_line()) {
+        m_have_line = false;
+
+	//instruction line: pc len memops byte...
+	char* p = m_line;
+	char* end;
+	inst.pc = strtoull(p, &end, 16);
+	unsigned long len = strtoul(end, &p, 10);
+	strtoul(p, &end, 10); //number of memory operands; the lines that follow are counted instead
+	if(p == end || len > BTRACE_MAX_INST_LEN) {
+	    cerr << "btrace: line " << m_line_no << " is not an instruction; skipped." << endl;
+	    continue;
+	}
+	inst.len = len;
+	p = end;
+	for(unsigned i=0; i<len; i++) {
+	    inst.code[i] = strtoul(p, &end, 16);
+	    p = end;
+	}
+
+	//memory operand lines: type addr size
+	inst.n_memops = 0;
+	while(get_line()) {
+	    unsigned long type = strtoul(m_line, &end, 16);
+	    uint64_t addr = strtoull(end, &p, 16);
+	    unsigned long size = strtoul(p, &end, 10);
+	    //an instruction line has more than 3 fields
+	    while(*end == ' ' || *end == '\t')
+	        end++;
+	    if(p == end || (*end != '\n' && *end != 0) || type > 1)
+	        break;
+	    m_have_line = false;
+	    if(inst.n_memops == BTRACE_MAX_MEMOPS) {
+		cerr << "btrace: line " << m_line_no << ": more than " << BTRACE_MAX_MEMOPS << " memory operands; ignored." << endl;
+		continue;
+	    }
+	    btrace_mem_t& m = inst.memops[inst.n_memops++];
+	    m.is_write = (type == 1);
+	    m.size = size;
+	    m.addr = addr;
+	}
+	return true;
+    }
+    return false;
+}
+
+
+void Write_text_inst(FILE* out, const btrace_inst_t& inst)
+{
+    fprintf(out, "0x%llx %d %d ", (unsigned long long)inst.pc, inst.len, inst.n_memops);
+    for(int i=0; i<inst.len; i++)
+        fprintf(out, "%x ", inst.code[i]);
+    fprintf(out, "\n");
+    for(int i=0; i<inst.n_memops; i++)
+        fprintf(out, "0x%d 0x%llx %d\n", inst.memops[i].is_write ? 1 : 0, (unsigned long long)inst.memops[i].addr, inst.memops[i].size);
+}
+
+
+} //namespace btrace
+} //namespace manifold
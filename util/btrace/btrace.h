@@ -0,0 +1,164 @@
+#ifndef MANIFOLD_BTRACE_H
+#define MANIFOLD_BTRACE_H
+
+//! Compact binary instruction trace.
+//!
+//! This is the binary counterpart of the text traces written by util/itrace and
+//! util/traceGen ("<pc> <len> <memops> <bytes>..." followed by "0x0/0x1 <addr> <size>"
+//! lines for each memory operand).
+//!
+//! The file is a sequence of blocks, each holding up to block_insts instructions:
+//! - PCs are delta-encoded against the fall-through address of the previous
+//!   instruction, so sequential instructions need no PC at all.
+//! - Memory addresses are delta-encoded against the previous address of the same
+//!   type (load or store). Deltas are zigzag varints.
+//! - Instruction bytes are stored once per block for each PC (looked up in a small
+//!   direct-mapped table), since the same static instruction repeats many times.
+//! - Each block is compressed with zlib. Encoder state is reset at each block, so
+//!   blocks are decoded independently.
+//! An index of (first instruction, file offset) for all blocks is written at the end
+//! of the file, so that a reader can skip to any instruction without decoding the
+//! blocks before it.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+namespace manifold {
+namespace btrace {
+
+static const uint32_t BTRACE_MAGIC = 0x5254424d; // "MBTR"
+static const uint32_t BTRACE_VERSION = 1;
+
+enum { BTRACE_MAX_INST_LEN = 15 };
+enum { BTRACE_MAX_MEMOPS = 8 };
+enum { BTRACE_DEFAULT_BLOCK_INSTS = 1 << 16 };
+
+
+struct btrace_mem_t {
+    bool is_write;
+    uint8_t size;
+    uint64_t addr;
+};
+
+struct btrace_inst_t {
+    btrace_inst_t() : pc(0), len(0), n_memops(0) {}
+
+    uint64_t pc;
+    uint8_t len; //number of bytes in code[]
+    uint8_t code[BTRACE_MAX_INST_LEN];
+    uint8_t n_memops;
+    btrace_mem_t memops[BTRACE_MAX_MEMOPS];
+};
+
+
+//! Per-block encoder/decoder state. Both sides update it in the same way.
+class Btrace_state {
+public:
+    Btrace_state() { reset(); }
+    void reset();
+
+    enum { CODE_TABLE_SIZE = 4096 };
+
+    uint64_t next_pc; //fall-through address of the previous instruction
+    uint64_t last_addr[2]; //last load and store address
+    //! Instruction bytes seen in this block, indexed by PC.
+    struct {
+        uint64_t pc;
+	uint8_t len;
+	uint8_t code[BTRACE_MAX_INST_LEN];
+    } code_table[CODE_TABLE_SIZE];
+};
+
+
+//! Writes a binary trace. Instructions are buffered and one block is compressed
+//! and written whenever block_insts instructions have been added.
+class Btrace_writer {
+public:
+    Btrace_writer(const char* fname, unsigned block_insts = BTRACE_DEFAULT_BLOCK_INSTS);
+    ~Btrace_writer();
+
+    void add(const btrace_inst_t& inst);
+    //! Write the last block and the index. Called by the destructor if not called before.
+    void close();
+
+    uint64_t get_num_insts() const { return m_num_insts; }
+    uint64_t get_raw_bytes() const { return m_raw_bytes; }
+
+private:
+    void flush_block();
+
+    FILE* m_file;
+    const unsigned m_block_insts;
+    Btrace_state m_state;
+    std::vector<uint8_t> m_raw; //encoded, uncompressed block
+    std::vector<uint8_t> m_compressed;
+    unsigned m_block_count; //instructions in current block
+    uint64_t m_num_insts;
+    uint64_t m_raw_bytes;
+    std::vector<uint64_t> m_index_inst; //first instruction of each block
+    std::vector<uint64_t> m_index_offset; //file offset of each block
+};
+
+
+//! Reads a binary trace.
+class Btrace_reader {
+public:
+    Btrace_reader(const char* fname);
+    ~Btrace_reader();
+
+    //! Read the next instruction. Returns false at the end of the trace.
+    bool next(btrace_inst_t& inst);
+    //! Position the reader so that next() returns instruction n (counting from 0).
+    //! Returns false if n is beyond the end of the trace.
+    bool seek(uint64_t n);
+
+    uint64_t get_num_insts() const { return m_num_insts; }
+    //! Index of the instruction that the next call to next() returns.
+    uint64_t tell() const { return m_next_inst; }
+
+private:
+    bool load_block(unsigned b);
+
+    FILE* m_file;
+    uint64_t m_num_insts;
+    std::vector<uint64_t> m_index_inst;
+    std::vector<uint64_t> m_index_offset;
+
+    Btrace_state m_state;
+    std::vector<uint8_t> m_raw;
+    std::vector<uint8_t> m_compressed;
+    unsigned m_block; //current block
+    size_t m_pos; //read position in m_raw
+    uint64_t m_next_inst;
+};
+
+
+//! Reads a text trace written by itrace or traceGen: an instruction line
+//! "<pc> <len> <memops> <byte> ..." followed by one "0x0 <addr> <size>" (load) or
+//! "0x1 <addr> <size>" (store) line for each memory operand.
+class Text_trace_reader {
+public:
+    Text_trace_reader(FILE* in) : m_in(in), m_have_line(false), m_line_no(0) {}
+
+    //! Returns false at the end of the file. Lines that cannot be parsed are
+    //! reported and skipped.
+    bool next(btrace_inst_t& inst);
+
+private:
+    bool get_line();
+
+    FILE* m_in;
+    char m_line[512];
+    bool m_have_line; //m_line holds a line that has not been used
+    unsigned long m_line_no;
+};
+
+//! Write one instruction in the itrace/traceGen text format.
+void Write_text_inst(FILE* out, const btrace_inst_t& inst);
+
+
+} //namespace btrace
+} //namespace manifold
+
+#endif //MANIFOLD_BTRACE_H
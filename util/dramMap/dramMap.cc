@@ -0,0 +1,204 @@
+//! Replays an address trace through the CaffDRAM address mapping and reports how
+//! the accesses are spread over the memory controllers, channels and banks.
+//!
+//! Usage: dramMap [options] <trace>
+//! The trace is a text file with one address per line (hex with 0x, or decimal),
+//! or, with -b, a binary trace written by util/btrace, whose load and store
+//! addresses are used.
+#include "Dsettings.h"
+#include "Dreq.h"
+#include "McMap.h"
+#include "btrace.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace manifold::caffdram;
+using namespace manifold::btrace;
+
+static void usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " [options] <trace>" << endl
+         << "  -b           the trace is a binary trace (util/btrace)" << endl
+         << "  -c <n>       channels per MC (default 2)" << endl
+         << "  -r <n>       ranks per channel (default 4)" << endl
+         << "  -k <n>       banks per rank (default 8)" << endl
+         << "  -R <n>       rows per bank (default 4096)" << endl
+         << "  -C <n>       columns per row (default 1024)" << endl
+         << "  -L <n>       cache line size in bytes (default 64)" << endl
+         << "  -m <map>     address mapping, e.g., RoBaRaCoCh (default: original mapping)" << endl
+         << "  -x           XOR the bank with the row" << endl
+         << "  -X           XOR the channel with the row" << endl
+         << "  -M <n>       number of MCs (default 1)" << endl
+         << "  -i <bit>     lowest MC select bit: 6 for cache lines, 12 for 4KB pages (default 12)" << endl
+         << "  -f           XOR the MC select bits with the upper address bits" << endl
+         << "  -v           print the count of every bank" << endl;
+    exit(1);
+}
+
+
+//! Print the distribution of counts: min, max, max/mean and coefficient of variation.
+static void print_balance(const char* what, const vector<uint64_t>& counts)
+{
+    uint64_t total = 0, minc = counts[0], maxc = counts[0];
+    for(unsigned i=0; i<counts.size(); i++) {
+        total += counts[i];
+	if(counts[i] < minc) minc = counts[i];
+	if(counts[i] > maxc) maxc = counts[i];
+    }
+    double mean = (double)total / counts.size();
+    double var = 0;
+    for(unsigned i=0; i<counts.size(); i++)
+        var += (counts[i] - mean) * (counts[i] - mean);
+    var /= counts.size();
+
+    printf("%-9s n= %-5u min= %-10lu max= %-10lu max/mean= %-8.3f cv= %.3f\n", what, (unsigned)counts.size(),
+           (unsigned long)minc, (unsigned long)maxc, (mean > 0) ? maxc / mean : 0.0, (mean > 0) ? sqrt(var) / mean : 0.0);
+}
+
+
+int main(int argc, char** argv)
+{
+    bool binary = false;
+    bool verbose = false;
+    int channels = 2, ranks = 4, banks = 8, rows = 4096, columns = 1024, line = 64;
+    int mcs = 1;
+    int interleave = 12;
+    bool mcXor = false, bankXor = false, channelXor = false;
+    string mapping;
+
+    int arg = 1;
+    for(; arg < argc && argv[arg][0] == '-'; arg++) {
+        char opt = argv[arg][1];
+        if(opt == 'b')
+	    binary = true;
+	else if(opt == 'x')
+	    bankXor = true;
+	else if(opt == 'X')
+	    channelXor = true;
+	else if(opt == 'f')
+	    mcXor = true;
+	else if(opt == 'v')
+	    verbose = true;
+	else if(arg+1 < argc) {
+	    const char* val = argv[++arg];
+	    switch(opt) {
+	        case 'c': channels = atoi(val); break;
+	        case 'r': ranks = atoi(val); break;
+	        case 'k': banks = atoi(val); break;
+	        case 'R': rows = atoi(val); break;
+	        case 'C': columns = atoi(val); break;
+	        case 'L': line = atoi(val); break;
+	        case 'm': mapping = val; break;
+	        case 'M': mcs = atoi(val); break;
+	        case 'i': interleave = atoi(val); break;
+		default: usage(argv[0]);
+	    }
+	}
+	else
+	    usage(argv[0]);
+    }
+    if(argc - arg != 1)
+        usage(argv[0]);
+
+    Dsettings setting(channels, ranks, banks, rows, columns, 64, line);
+    setting.addressMapping = mapping;
+    setting.bankXor = bankXor;
+    setting.channelXor = channelXor;
+    setting.numMcs = mcs;
+    setting.mcInterleaveShift = interleave;
+    setting.mcXor = mcXor;
+    setting.update();
+
+    vector<int> mcIds(mcs);
+    for(int i=0; i<mcs; i++)
+        mcIds[i] = i;
+    CaffDramMcMap mcMap(mcIds, setting);
+
+    const int banksPerMc = channels * ranks * banks;
+    vector<uint64_t> mcCount(mcs, 0);
+    vector<uint64_t> chCount(mcs * channels, 0);
+    vector<uint64_t> bankCount(mcs * banksPerMc, 0);
+    vector<uint64_t> rowHits(mcs * banksPerMc, 0);
+    vector<long> openRow(mcs * banksPerMc, -1);
+    uint64_t total = 0;
+
+    FILE* in = 0;
+    Btrace_reader* reader = 0;
+    if(binary)
+        reader = new Btrace_reader(argv[arg]);
+    else {
+        in = fopen(argv[arg], "r");
+	if(in == 0) {
+	    cerr << "Cannot open " << argv[arg] << endl;
+	    exit(1);
+	}
+    }
+
+    btrace_inst_t inst;
+    vector<uint64_t> addrs;
+    char buf[256];
+    while(true) {
+        addrs.clear();
+        if(binary) {
+	    if(!reader->next(inst))
+	        break;
+	    for(int i=0; i<inst.n_memops; i++)
+	        addrs.push_back(inst.memops[i].addr);
+	}
+	else {
+	    if(fgets(buf, sizeof(buf), in) == 0)
+	        break;
+	    char* end;
+	    uint64_t addr = strtoull(buf, &end, 0);
+	    if(end == buf)
+	        continue; //not an address
+	    addrs.push_back(addr);
+	}
+
+	for(unsigned i=0; i<addrs.size(); i++) {
+	    int mc = mcMap.lookup(addrs[i]);
+	    Dreq dreq(addrs[i], 0, &setting);
+	    int ch = mc * channels + dreq.get_chId();
+	    int b = mc * banksPerMc + (dreq.get_chId() * ranks + dreq.get_rankId()) * banks + dreq.get_bankId();
+
+	    mcCount[mc]++;
+	    chCount[ch]++;
+	    bankCount[b]++;
+	    if(openRow[b] == (long)dreq.get_rowId())
+	        rowHits[b]++;
+	    openRow[b] = dreq.get_rowId();
+	    total++;
+	}
+    }
+    delete reader;
+    if(in)
+        fclose(in);
+
+    uint64_t hits = 0;
+    for(unsigned i=0; i<rowHits.size(); i++)
+        hits += rowHits[i];
+
+    printf("accesses= %lu  mapping= %s%s%s  MCs= %d interleave bit= %d%s\n", (unsigned long)total,
+           mapping.empty() ? "original" : mapping.c_str(), bankXor ? " bank-xor" : "", channelXor ? " channel-xor" : "",
+	   mcs, interleave, mcXor ? " mc-xor" : "");
+    print_balance("MC", mcCount);
+    print_balance("channel", chCount);
+    print_balance("bank", bankCount);
+    printf("row hit rate (open page, trace order)= %.3f\n", total ? (double)hits / total : 0.0);
+
+    if(verbose) {
+        for(unsigned b=0; b<bankCount.size(); b++) {
+	    int mc = b / banksPerMc;
+	    int rem = b % banksPerMc;
+	    printf("mc %d ch %d rank %d bank %d: %lu accesses, %lu row hits\n", mc, rem / (ranks * banks),
+	           (rem / banks) % ranks, rem % banks, (unsigned long)bankCount[b], (unsigned long)rowHits[b]);
+	}
+    }
+    return 0;
+}
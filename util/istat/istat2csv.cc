@@ -0,0 +1,68 @@
+//! Converts a file written by manifold::kernel::Interval_stat to CSV.
+//!
+//! Usage: istat2csv [-d] <istat_file> [<csv_file>]
+//! With -d, integer counters are printed as the increment over each interval
+//! instead of the cumulative value. The CSV is written to stdout if no output
+//! file is given.
+#include "kernel/interval_stat.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+using namespace std;
+using namespace manifold::kernel;
+
+static void usage(const char* prog)
+{
+    cerr << "Usage: " << prog << " [-d] <istat_file> [<csv_file>]" << endl;
+    exit(1);
+}
+
+int main(int argc, char** argv)
+{
+    bool delta = false;
+
+    int arg = 1;
+    for(; arg < argc && argv[arg][0] == '-'; arg++) {
+        if(strcmp(argv[arg], "-d") == 0)
+	    delta = true;
+	else
+	    usage(argv[0]);
+    }
+    if(argc - arg != 1 && argc - arg != 2)
+        usage(argv[0]);
+
+    Interval_stat_reader reader(argv[arg]);
+
+    FILE* out = stdout;
+    if(argc - arg == 2) {
+	out = fopen(argv[arg+1], "w");
+	if(out == 0) {
+	    cerr << "Cannot open " << argv[arg+1] << endl;
+	    exit(1);
+	}
+    }
+
+    unsigned cols = reader.get_num_columns();
+    for(unsigned c=0; c<cols; c++)
+        fprintf(out, "%s%s", c ? "," : "", reader.get_name(c).c_str());
+    fprintf(out, "\n");
+
+    vector<double> row;
+    while(reader.next(row, delta)) {
+	for(unsigned c=0; c<cols; c++) {
+	    if(c)
+	        fputc(',', out);
+	    if(reader.get_type(c) == ISTAT_DOUBLE)
+	        fprintf(out, "%.15g", row[c]);
+	    else
+	        fprintf(out, "%.0f", row[c]);
+	}
+	fputc('\n', out);
+    }
+
+    if(out != stdout)
+	fclose(out);
+    return 0;
+}
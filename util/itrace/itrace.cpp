@@ -40,6 +40,7 @@ END_LEGAL */
 #include <stdio.h>
 
 #include "portability.H"
+#include "btrace.h"
 
 FILE * trace;
 uint64_t trace_ins_cnt=0,ins_count=0;
@@ -51,6 +52,12 @@ uint64_t start=0LLU;
 bool log_trace=false;
 
 using namespace std;
+using namespace manifold::btrace;
+
+// If PIN_ITRACE_BINARY is set, a binary trace (see util/btrace) is written instead of text.
+Btrace_writer * btrace = NULL;
+btrace_inst_t btrace_inst;
+bool btrace_have_inst = false;
 
 #define MAX_INSTRUCTIONS  1000000000 // 1G
 // This function is called before every instruction is executed
@@ -60,6 +67,12 @@ VOID printip(VOID *ip, USIZE size, UINT32 memOperands)
 	if(trace_ins_cnt > MAX_INSTRUCTIONS)
 	{
 		fprintf(stdout,"\nTrace_ins_cnt = %llu\n",trace_ins_cnt-1);
+		if(btrace)
+		{
+			if(btrace_have_inst)
+				btrace->add(btrace_inst);
+			btrace->close();
+		}
 		exit(1);
 		return;
 	}
@@ -73,6 +86,17 @@ VOID printip(VOID *ip, USIZE size, UINT32 memOperands)
 	{
 		//fprintf(stdout,"\nStill logging %lld\n",trace_ins_cnt);
 		trace_ins_cnt++;
+		if(btrace)
+		{
+			if(btrace_have_inst)
+				btrace->add(btrace_inst);
+			btrace_inst.pc = (uint64_t)(ADDRINT)ip;
+			btrace_inst.len = 0;
+			btrace_inst.n_memops = 0;
+			btrace_have_inst = true;
+			ins_count++;
+			return;
+		}
 		int ch;
 		ch=fprintf(trace, "%p  %d  %d  ", ip, size, memOperands );
 		if(ch<0)
@@ -110,6 +134,13 @@ VOID dumpInstruction64Binary(VOID *ip, USIZE size)
         if(log_trace==true)
 	{
 		unsigned char i = 0;
+		if(btrace)
+		{
+			for (i=0; i<size && i<BTRACE_MAX_INST_LEN; i++)
+				btrace_inst.code[i] = *((unsigned char *)ip+i);
+			btrace_inst.len = i;
+			return;
+		}
 		//USIZE size = (unsigned char*)next_ip-(unsigned char*)ip;
 		for (i=0; i<size; i++)
 		{
@@ -126,7 +157,20 @@ VOID RecordMemRead(VOID * ip, VOID * addr, USIZE size)
 		return;
     
     if(log_trace==true)
-    	fprintf(trace,"0x00 %p %d\n", addr,size);
+    {
+	if(btrace)
+	{
+	    if(btrace_inst.n_memops < BTRACE_MAX_MEMOPS)
+	    {
+		btrace_mem_t& m = btrace_inst.memops[btrace_inst.n_memops++];
+		m.is_write = false;
+		m.addr = (uint64_t)(ADDRINT)addr;
+		m.size = size;
+	    }
+	}
+	else
+    	    fprintf(trace,"0x00 %p %d\n", addr,size);
+    }
 }
 
 // Print a memory write record
@@ -135,7 +179,20 @@ VOID RecordMemWrite(VOID * ip, VOID * addr, USIZE size)
     if(trace_ins_cnt > MAX_INSTRUCTIONS)
 		return;
     if(log_trace==true)
-    	fprintf(trace,"0x01 %p %d\n", addr, size);
+    {
+	if(btrace)
+	{
+	    if(btrace_inst.n_memops < BTRACE_MAX_MEMOPS)
+	    {
+		btrace_mem_t& m = btrace_inst.memops[btrace_inst.n_memops++];
+		m.is_write = true;
+		m.addr = (uint64_t)(ADDRINT)addr;
+		m.size = size;
+	    }
+	}
+	else
+    	    fprintf(trace,"0x01 %p %d\n", addr, size);
+    }
 }
 
 
@@ -182,7 +239,16 @@ VOID Instruction(INS ins, VOID *v)
 // This function is called when the application exits
 VOID Fini(INT32 code, VOID *v)
 {
-    fclose(trace);
+    if(btrace)
+    {
+	if(btrace_have_inst)
+	    btrace->add(btrace_inst);
+	btrace->close();
+	delete btrace;
+	btrace = NULL;
+    }
+    else
+	fclose(trace);
     fprintf(stdout,"\nend of program");
 }
 
@@ -210,13 +276,21 @@ int main(int argc, char * argv[])
     if (pin_itrace_out == NULL)
       pin_itrace_out = "itrace";
 
-    sprintf(filename,"%s_%u.out",pin_itrace_out,subtrace_cnt);
-    trace = fopen(filename,"w");
-
-    if(!trace)
+    if (getenv ("PIN_ITRACE_BINARY") != NULL)
+    {
+      sprintf(filename,"%s_%u.btr",pin_itrace_out,subtrace_cnt);
+      btrace = new Btrace_writer(filename);
+    }
+    else
     {
-      fprintf(stdout,"ERROR: Cannot open PIN Itrace output file\n");
-      exit(1);
+      sprintf(filename,"%s_%u.out",pin_itrace_out,subtrace_cnt);
+      trace = fopen(filename,"w");
+
+      if(!trace)
+      {
+        fprintf(stdout,"ERROR: Cannot open PIN Itrace output file\n");
+        exit(1);
+      }
     }
 
     printf("\n%s\n",filename);
@@ -31,14 +31,22 @@ qsimclient_core_t::qsimclient_core_t(const int core_id, char * config, int cpuid
 
     stringstream ss;
     ss << cpuid;
+#ifdef BTRACE
+    btrace_file = new manifold::btrace::Btrace_writer((FILENAME + ss.str() + ".btr").c_str());
+#else
     trace_file.open((FILENAME + ss.str()).c_str());
+#endif
 }
 
 
 
 qsimclient_core_t:: ~qsimclient_core_t()
 {
+#ifdef BTRACE
+    delete btrace_file; //the destructor writes the index
+#else
     trace_file.close();
+#endif
     delete m_Qsim_queue;
     delete m_Qsim_client;
 }
@@ -215,6 +223,29 @@ fprintf(stdout,"\n[%lld][Core%d]Trace DequeuedPC: 0x%llx   ",core->sim_cycle,cor
 		    core->m_Qsim_client->run(core->m_Qsim_cpuid, 1);
 	    }//while MEM ops
 	    
+#ifdef BTRACE
+	    manifold::btrace::btrace_inst_t binst;
+	    binst.pc = inst->paddr;
+	    binst.len = inst->qemu_len;
+	    for (unsigned i = 0; i < inst->qemu_len; i++)
+		binst.code[i] = inst->code[i];
+	    for (unsigned i = 0; i < 2; i++)
+	    {
+		if (inst->mem_ops.mem_paddr_ld[i] != 0) {
+		    manifold::btrace::btrace_mem_t& m = binst.memops[binst.n_memops++];
+		    m.is_write = false;
+		    m.addr = inst->mem_ops.mem_paddr_ld[i];
+		    m.size = inst->mem_ops.ld_size[i];
+		}
+		if (inst->mem_ops.mem_paddr_str[i] != 0) {
+		    manifold::btrace::btrace_mem_t& m = binst.memops[binst.n_memops++];
+		    m.is_write = true;
+		    m.addr = inst->mem_ops.mem_paddr_str[i];
+		    m.size = inst->mem_ops.str_size[i];
+		}
+	    }
+	    btrace_file->add(binst);
+#else
             trace_file <<"0x"<<hex<<inst->paddr<<" ";
 	    trace_file <<dec<< int(inst->qemu_len)<<" "<<inst->mem_ops.memops<<" ";
 	    for (unsigned i = 0; i < inst->qemu_len; i++) {
@@ -229,6 +260,7 @@ fprintf(stdout,"\n[%lld][Core%d]Trace DequeuedPC: 0x%llx   ",core->sim_cycle,cor
 		if (inst->mem_ops.mem_paddr_str[i] != 0)
 		    trace_file<<"0x1"<<hex<<" 0x"<<inst->mem_ops.mem_paddr_str[i]<<dec<<" " << int(inst->mem_ops.str_size[i]) << endl;
 	    }
+#endif
 
 	    break; //got one complete instruction
 	}
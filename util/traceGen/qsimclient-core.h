@@ -6,6 +6,9 @@
 #include "zesto-core.h"
 #include "qsim-client.h"
 #include <fstream>
+#ifdef BTRACE
+#include "btrace.h"
+#endif
 
 namespace manifold {
 namespace zesto {
@@ -33,7 +36,11 @@ private:
     Qsim::Client* m_Qsim_client;
     Qsim::ClientQueue* m_Qsim_queue;
     const int m_Qsim_cpuid; //QSim cpu ID. In general this is different from core_id.
+#ifdef BTRACE
+    manifold::btrace::Btrace_writer* btrace_file; //binary trace; see util/btrace
+#else
     ofstream trace_file;
+#endif
 
 };
 